@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Benchmarks of the inline PDU field accessors from avtp_inline.h. */
+
+#include <stdint.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+#include "avtp_inline.h"
+#include "bench.h"
+
+#define PDU_BUF_SIZE		256
+
+/* All inline accessors, as (format, PDU type, field) tuples. */
+#define INLINE_FIELDS(X)						\
+	X(common, struct avtp_common_pdu, subtype)			\
+	X(common, struct avtp_common_pdu, version)			\
+	X(stream, struct avtp_stream_pdu, sv)				\
+	X(stream, struct avtp_stream_pdu, mr)				\
+	X(stream, struct avtp_stream_pdu, tv)				\
+	X(stream, struct avtp_stream_pdu, seq_num)			\
+	X(stream, struct avtp_stream_pdu, tu)				\
+	X(stream, struct avtp_stream_pdu, stream_data_len)		\
+	X(stream, struct avtp_stream_pdu, stream_id)			\
+	X(stream, struct avtp_stream_pdu, timestamp)			\
+	X(aaf, struct avtp_stream_pdu, format)				\
+	X(aaf, struct avtp_stream_pdu, nsr)				\
+	X(aaf, struct avtp_stream_pdu, chan_per_frame)			\
+	X(aaf, struct avtp_stream_pdu, bit_depth)			\
+	X(aaf, struct avtp_stream_pdu, sp)				\
+	X(aaf, struct avtp_stream_pdu, evt)				\
+	X(cvf, struct avtp_stream_pdu, format)				\
+	X(cvf, struct avtp_stream_pdu, format_subtype)			\
+	X(cvf, struct avtp_stream_pdu, h264_ptv)			\
+	X(cvf, struct avtp_stream_pdu, m)				\
+	X(cvf, struct avtp_stream_pdu, evt)				\
+	X(rvf, struct avtp_stream_pdu, active_pixels)			\
+	X(rvf, struct avtp_stream_pdu, total_lines)			\
+	X(rvf, struct avtp_stream_pdu, ap)				\
+	X(rvf, struct avtp_stream_pdu, f)				\
+	X(rvf, struct avtp_stream_pdu, ef)				\
+	X(rvf, struct avtp_stream_pdu, evt)				\
+	X(rvf, struct avtp_stream_pdu, pd)				\
+	X(rvf, struct avtp_stream_pdu, i)				\
+	X(ieciidc, struct avtp_stream_pdu, gv)				\
+	X(ieciidc, struct avtp_stream_pdu, tag)				\
+	X(ieciidc, struct avtp_stream_pdu, channel)			\
+	X(ieciidc, struct avtp_stream_pdu, tcode)			\
+	X(ieciidc, struct avtp_stream_pdu, sy)				\
+	X(ieciidc, struct avtp_stream_pdu, gateway_info)		\
+	X(crf, struct avtp_crf_pdu, sv)					\
+	X(crf, struct avtp_crf_pdu, mr)					\
+	X(crf, struct avtp_crf_pdu, fs)					\
+	X(crf, struct avtp_crf_pdu, tu)					\
+	X(crf, struct avtp_crf_pdu, seq_num)				\
+	X(crf, struct avtp_crf_pdu, type)				\
+	X(crf, struct avtp_crf_pdu, pull)				\
+	X(crf, struct avtp_crf_pdu, base_freq)				\
+	X(crf, struct avtp_crf_pdu, crf_data_len)			\
+	X(crf, struct avtp_crf_pdu, timestamp_interval)			\
+	X(crf, struct avtp_crf_pdu, stream_id)
+
+/* Getters reload the PDU on every iteration since the compiler would hoist
+ * the load out of the loop otherwise.
+ */
+#define DEFINE_INLINE_BENCH(fmt, type, field)				\
+static void bench_##fmt##_get_##field(void *arg, uint64_t iters)	\
+{									\
+	const type *pdu = arg;						\
+	uint64_t i;							\
+									\
+	for (i = 0; i < iters; i++) {					\
+		bench_keep(avtp_##fmt##_get_##field(pdu));		\
+		bench_clobber();					\
+	}								\
+}									\
+									\
+static void bench_##fmt##_set_##field(void *arg, uint64_t iters)	\
+{									\
+	type *pdu = arg;						\
+	uint64_t i;							\
+									\
+	for (i = 0; i < iters; i++) {					\
+		avtp_##fmt##_set_##field(pdu, i);			\
+		bench_clobber();					\
+	}								\
+}
+
+INLINE_FIELDS(DEFINE_INLINE_BENCH)
+
+#define RUN_INLINE_BENCH(fmt, type, field)				\
+	bench_run("avtp_" #fmt "_get_" #field,				\
+				bench_##fmt##_get_##field, pdu);	\
+	bench_run("avtp_" #fmt "_set_" #field,				\
+				bench_##fmt##_set_##field, pdu);
+
+void bench_inline(void)
+{
+	static uint8_t pdu[PDU_BUF_SIZE];
+
+	INLINE_FIELDS(RUN_INLINE_BENCH)
+}
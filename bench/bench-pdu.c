@@ -0,0 +1,628 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Benchmarks of the PDU field accessors and of the functions handling whole
+ * headers at once.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_ieciidc.h"
+#include "avtp_inline.h"
+#include "avtp_pdu_view.h"
+#include "avtp_rvf.h"
+#include "avtp_stream_ctx.h"
+#include "bench.h"
+
+#define PDU_BUF_SIZE		256
+#define BURST_SIZE		32
+/* Streams handled by a single thread. */
+#define NUM_STREAMS		256
+
+struct field_arg {
+	void *pdu;
+	int field;
+	uint64_t val;
+};
+
+static const char *const common_fields[AVTP_FIELD_MAX] = {
+	[AVTP_FIELD_SUBTYPE] = "subtype",
+	[AVTP_FIELD_VERSION] = "version",
+};
+
+static const char *const aaf_fields[AVTP_AAF_FIELD_MAX] = {
+	[AVTP_AAF_FIELD_SV] = "sv",
+	[AVTP_AAF_FIELD_MR] = "mr",
+	[AVTP_AAF_FIELD_TV] = "tv",
+	[AVTP_AAF_FIELD_SEQ_NUM] = "seq_num",
+	[AVTP_AAF_FIELD_TU] = "tu",
+	[AVTP_AAF_FIELD_STREAM_ID] = "stream_id",
+	[AVTP_AAF_FIELD_TIMESTAMP] = "timestamp",
+	[AVTP_AAF_FIELD_STREAM_DATA_LEN] = "stream_data_len",
+	[AVTP_AAF_FIELD_FORMAT] = "format",
+	[AVTP_AAF_FIELD_NSR] = "nsr",
+	[AVTP_AAF_FIELD_CHAN_PER_FRAME] = "chan_per_frame",
+	[AVTP_AAF_FIELD_BIT_DEPTH] = "bit_depth",
+	[AVTP_AAF_FIELD_SP] = "sp",
+	[AVTP_AAF_FIELD_EVT] = "evt",
+};
+
+static const char *const crf_fields[AVTP_CRF_FIELD_MAX] = {
+	[AVTP_CRF_FIELD_SV] = "sv",
+	[AVTP_CRF_FIELD_MR] = "mr",
+	[AVTP_CRF_FIELD_FS] = "fs",
+	[AVTP_CRF_FIELD_TU] = "tu",
+	[AVTP_CRF_FIELD_SEQ_NUM] = "seq_num",
+	[AVTP_CRF_FIELD_TYPE] = "type",
+	[AVTP_CRF_FIELD_STREAM_ID] = "stream_id",
+	[AVTP_CRF_FIELD_PULL] = "pull",
+	[AVTP_CRF_FIELD_BASE_FREQ] = "base_freq",
+	[AVTP_CRF_FIELD_CRF_DATA_LEN] = "crf_data_len",
+	[AVTP_CRF_FIELD_TIMESTAMP_INTERVAL] = "timestamp_interval",
+};
+
+static const char *const cvf_fields[AVTP_CVF_FIELD_MAX] = {
+	[AVTP_CVF_FIELD_SV] = "sv",
+	[AVTP_CVF_FIELD_MR] = "mr",
+	[AVTP_CVF_FIELD_TV] = "tv",
+	[AVTP_CVF_FIELD_SEQ_NUM] = "seq_num",
+	[AVTP_CVF_FIELD_TU] = "tu",
+	[AVTP_CVF_FIELD_STREAM_ID] = "stream_id",
+	[AVTP_CVF_FIELD_TIMESTAMP] = "timestamp",
+	[AVTP_CVF_FIELD_STREAM_DATA_LEN] = "stream_data_len",
+	[AVTP_CVF_FIELD_FORMAT] = "format",
+	[AVTP_CVF_FIELD_FORMAT_SUBTYPE] = "format_subtype",
+	[AVTP_CVF_FIELD_M] = "m",
+	[AVTP_CVF_FIELD_EVT] = "evt",
+	[AVTP_CVF_FIELD_H264_PTV] = "h264_ptv",
+	[AVTP_CVF_FIELD_H264_TIMESTAMP] = "h264_timestamp",
+};
+
+static const char *const rvf_fields[AVTP_RVF_FIELD_MAX] = {
+	[AVTP_RVF_FIELD_SV] = "sv",
+	[AVTP_RVF_FIELD_MR] = "mr",
+	[AVTP_RVF_FIELD_TV] = "tv",
+	[AVTP_RVF_FIELD_SEQ_NUM] = "seq_num",
+	[AVTP_RVF_FIELD_TU] = "tu",
+	[AVTP_RVF_FIELD_STREAM_ID] = "stream_id",
+	[AVTP_RVF_FIELD_TIMESTAMP] = "timestamp",
+	[AVTP_RVF_FIELD_STREAM_DATA_LEN] = "stream_data_len",
+	[AVTP_RVF_FIELD_ACTIVE_PIXELS] = "active_pixels",
+	[AVTP_RVF_FIELD_TOTAL_LINES] = "total_lines",
+	[AVTP_RVF_FIELD_AP] = "ap",
+	[AVTP_RVF_FIELD_F] = "f",
+	[AVTP_RVF_FIELD_EF] = "ef",
+	[AVTP_RVF_FIELD_EVT] = "evt",
+	[AVTP_RVF_FIELD_PD] = "pd",
+	[AVTP_RVF_FIELD_I] = "i",
+	[AVTP_RVF_FIELD_RAW_PIXEL_DEPTH] = "raw_pixel_depth",
+	[AVTP_RVF_FIELD_RAW_PIXEL_FORMAT] = "raw_pixel_format",
+	[AVTP_RVF_FIELD_RAW_FRAME_RATE] = "raw_frame_rate",
+	[AVTP_RVF_FIELD_RAW_COLORSPACE] = "raw_colorspace",
+	[AVTP_RVF_FIELD_RAW_NUM_LINES] = "raw_num_lines",
+	[AVTP_RVF_FIELD_RAW_I_SEQ_NUM] = "raw_i_seq_num",
+	[AVTP_RVF_FIELD_RAW_LINE_NUMBER] = "raw_line_number",
+};
+
+static const char *const ieciidc_fields[AVTP_IECIIDC_FIELD_MAX] = {
+	[AVTP_IECIIDC_FIELD_SV] = "sv",
+	[AVTP_IECIIDC_FIELD_MR] = "mr",
+	[AVTP_IECIIDC_FIELD_TV] = "tv",
+	[AVTP_IECIIDC_FIELD_SEQ_NUM] = "seq_num",
+	[AVTP_IECIIDC_FIELD_TU] = "tu",
+	[AVTP_IECIIDC_FIELD_STREAM_ID] = "stream_id",
+	[AVTP_IECIIDC_FIELD_TIMESTAMP] = "timestamp",
+	[AVTP_IECIIDC_FIELD_STREAM_DATA_LEN] = "stream_data_len",
+	[AVTP_IECIIDC_FIELD_GV] = "gv",
+	[AVTP_IECIIDC_FIELD_GATEWAY_INFO] = "gateway_info",
+	[AVTP_IECIIDC_FIELD_TAG] = "tag",
+	[AVTP_IECIIDC_FIELD_CHANNEL] = "channel",
+	[AVTP_IECIIDC_FIELD_TCODE] = "tcode",
+	[AVTP_IECIIDC_FIELD_SY] = "sy",
+	[AVTP_IECIIDC_FIELD_CIP_QI_1] = "cip_qi_1",
+	[AVTP_IECIIDC_FIELD_CIP_QI_2] = "cip_qi_2",
+	[AVTP_IECIIDC_FIELD_CIP_SID] = "cip_sid",
+	[AVTP_IECIIDC_FIELD_CIP_DBS] = "cip_dbs",
+	[AVTP_IECIIDC_FIELD_CIP_FN] = "cip_fn",
+	[AVTP_IECIIDC_FIELD_CIP_QPC] = "cip_qpc",
+	[AVTP_IECIIDC_FIELD_CIP_SPH] = "cip_sph",
+	[AVTP_IECIIDC_FIELD_CIP_DBC] = "cip_dbc",
+	[AVTP_IECIIDC_FIELD_CIP_FMT] = "cip_fmt",
+	[AVTP_IECIIDC_FIELD_CIP_SYT] = "cip_syt",
+	[AVTP_IECIIDC_FIELD_CIP_TSF] = "cip_tsf",
+	[AVTP_IECIIDC_FIELD_CIP_EVT] = "cip_evt",
+	[AVTP_IECIIDC_FIELD_CIP_SFC] = "cip_sfc",
+	[AVTP_IECIIDC_FIELD_CIP_N] = "cip_n",
+	[AVTP_IECIIDC_FIELD_CIP_ND] = "cip_nd",
+	[AVTP_IECIIDC_FIELD_CIP_NO_DATA] = "cip_no_data",
+};
+
+/* Define the getter and setter benchmarks of a format. Setters write back the
+ * value read from the PDU, so it is always valid for the field.
+ */
+#define BENCH_FIELD_FNS(fmt, pdu_type, field_type, val_type)		\
+static int fmt##_get(void *pdu, int field, uint64_t *val)		\
+{									\
+	val_type v;							\
+	int res;							\
+									\
+	res = avtp_##fmt##_get(pdu, (field_type) field, &v);		\
+	*val = v;							\
+	return res;							\
+}									\
+									\
+static int fmt##_set(void *pdu, int field, uint64_t val)		\
+{									\
+	return avtp_##fmt##_set(pdu, (field_type) field, val);		\
+}									\
+									\
+static void bench_##fmt##_get(void *arg, uint64_t iters)		\
+{									\
+	struct field_arg *a = arg;					\
+	const pdu_type *pdu = a->pdu;					\
+	val_type val;							\
+	uint64_t i;							\
+									\
+	for (i = 0; i < iters; i++) {					\
+		avtp_##fmt##_get(pdu, (field_type) a->field, &val);	\
+		bench_keep(val);					\
+	}								\
+}									\
+									\
+static void bench_##fmt##_set(void *arg, uint64_t iters)		\
+{									\
+	struct field_arg *a = arg;					\
+	pdu_type *pdu = a->pdu;						\
+	uint64_t i;							\
+									\
+	for (i = 0; i < iters; i++) {					\
+		avtp_##fmt##_set(pdu, (field_type) a->field, a->val);	\
+		bench_clobber();					\
+	}								\
+}
+
+BENCH_FIELD_FNS(pdu, struct avtp_common_pdu, enum avtp_field, uint32_t)
+BENCH_FIELD_FNS(aaf_pdu, struct avtp_stream_pdu, enum avtp_aaf_field,
+								uint64_t)
+BENCH_FIELD_FNS(crf_pdu, struct avtp_crf_pdu, enum avtp_crf_field, uint64_t)
+BENCH_FIELD_FNS(cvf_pdu, struct avtp_stream_pdu, enum avtp_cvf_field,
+								uint64_t)
+BENCH_FIELD_FNS(rvf_pdu, struct avtp_stream_pdu, enum avtp_rvf_field,
+								uint64_t)
+BENCH_FIELD_FNS(ieciidc_pdu, struct avtp_stream_pdu,
+					enum avtp_ieciidc_field, uint64_t)
+
+struct field_suite {
+	const char *name;
+	const char *const *fields;
+	int count;
+	int (*get)(void *pdu, int field, uint64_t *val);
+	int (*set)(void *pdu, int field, uint64_t val);
+	bench_fn bench_get;
+	bench_fn bench_set;
+};
+
+#define FIELD_SUITE(fmt, names)						\
+	{ #fmt, names, sizeof(names) / sizeof(names[0]),		\
+	  fmt##_get, fmt##_set, bench_##fmt##_get, bench_##fmt##_set }
+
+static void run_field_suite(const struct field_suite *suite, void *pdu)
+{
+	struct field_arg arg = { .pdu = pdu };
+	char name[128];
+	int res;
+
+	for (arg.field = 0; arg.field < suite->count; arg.field++) {
+		snprintf(name, sizeof(name), "avtp_%s_get/%s", suite->name,
+						suite->fields[arg.field]);
+		res = suite->get(pdu, arg.field, &arg.val);
+		if (res < 0) {
+			bench_skip(name, res);
+			continue;
+		}
+		bench_run(name, suite->bench_get, &arg);
+
+		snprintf(name, sizeof(name), "avtp_%s_set/%s", suite->name,
+						suite->fields[arg.field]);
+		res = suite->set(pdu, arg.field, arg.val);
+		if (res < 0) {
+			bench_skip(name, res);
+			continue;
+		}
+		bench_run(name, suite->bench_set, &arg);
+	}
+}
+
+static void bench_aaf_pdu_init(void *arg, uint64_t iters)
+{
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_aaf_pdu_init(arg);
+		bench_clobber();
+	}
+}
+
+static void bench_crf_pdu_init(void *arg, uint64_t iters)
+{
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_crf_pdu_init(arg);
+		bench_clobber();
+	}
+}
+
+static void bench_cvf_pdu_init(void *arg, uint64_t iters)
+{
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_cvf_pdu_init(arg, AVTP_CVF_FORMAT_SUBTYPE_H264);
+		bench_clobber();
+	}
+}
+
+static void bench_rvf_pdu_init(void *arg, uint64_t iters)
+{
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_rvf_pdu_init(arg);
+		bench_clobber();
+	}
+}
+
+static void bench_ieciidc_pdu_init(void *arg, uint64_t iters)
+{
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_ieciidc_pdu_init(arg, AVTP_IECIIDC_TAG_CIP);
+		bench_clobber();
+	}
+}
+
+/* Define the pack and unpack benchmarks of a format. The header struct is
+ * unpacked from the PDU the benchmarks run on before they are run.
+ */
+#define BENCH_PACK_FNS(fmt, pdu_type)					\
+struct fmt##_arg {							\
+	pdu_type *pdu;							\
+	struct avtp_##fmt##_hdr hdr;					\
+};									\
+									\
+static void bench_##fmt##_pdu_unpack(void *arg, uint64_t iters)	\
+{									\
+	struct fmt##_arg *a = arg;					\
+	uint64_t i;							\
+									\
+	for (i = 0; i < iters; i++) {					\
+		avtp_##fmt##_pdu_unpack(a->pdu, &a->hdr);		\
+		bench_clobber();					\
+	}								\
+}									\
+									\
+static void bench_##fmt##_pdu_pack(void *arg, uint64_t iters)		\
+{									\
+	struct fmt##_arg *a = arg;					\
+	uint64_t i;							\
+									\
+	for (i = 0; i < iters; i++) {					\
+		avtp_##fmt##_pdu_pack(a->pdu, &a->hdr);			\
+		bench_clobber();					\
+	}								\
+}									\
+									\
+static void run_##fmt##_pack(pdu_type *pdu)				\
+{									\
+	struct fmt##_arg arg = { .pdu = pdu };				\
+	int res;							\
+									\
+	res = avtp_##fmt##_pdu_unpack(pdu, &arg.hdr);			\
+	if (res < 0) {							\
+		bench_skip("avtp_" #fmt "_pdu_unpack", res);		\
+		bench_skip("avtp_" #fmt "_pdu_pack", res);		\
+		return;							\
+	}								\
+									\
+	bench_run("avtp_" #fmt "_pdu_unpack", bench_##fmt##_pdu_unpack,	\
+									&arg); \
+	bench_run("avtp_" #fmt "_pdu_pack", bench_##fmt##_pdu_pack, &arg); \
+}
+
+BENCH_PACK_FNS(aaf, struct avtp_stream_pdu)
+BENCH_PACK_FNS(crf, struct avtp_crf_pdu)
+BENCH_PACK_FNS(cvf, struct avtp_stream_pdu)
+BENCH_PACK_FNS(rvf, struct avtp_stream_pdu)
+BENCH_PACK_FNS(ieciidc, struct avtp_stream_pdu)
+
+struct emit_arg {
+	void *pdu;
+	const void *tmpl;
+};
+
+static void bench_stream_pdu_emit(void *arg, uint64_t iters)
+{
+	struct emit_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_stream_pdu_emit(a->pdu, a->tmpl, i, i, 24);
+		bench_clobber();
+	}
+}
+
+static void bench_crf_pdu_emit(void *arg, uint64_t iters)
+{
+	struct emit_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_crf_pdu_emit(a->pdu, a->tmpl, i);
+		bench_clobber();
+	}
+}
+
+struct ctx_arg {
+	struct avtp_stream_ctx ctx;
+	void *pdus[BURST_SIZE];
+};
+
+static void bench_stream_ctx_emit(void *arg, uint64_t iters)
+{
+	struct ctx_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_stream_ctx_emit(&a->ctx, a->pdus[0], 6);
+		bench_clobber();
+	}
+}
+
+static void bench_stream_ctx_advance(void *arg, uint64_t iters)
+{
+	struct ctx_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_stream_ctx_advance(&a->ctx, a->pdus[0], 6);
+		bench_clobber();
+	}
+}
+
+/* Cost is reported per burst of BURST_SIZE PDUs. */
+static void bench_stream_ctx_emit_burst(void *arg, uint64_t iters)
+{
+	struct ctx_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_stream_ctx_emit_burst(&a->ctx, a->pdus, BURST_SIZE, 6);
+		bench_clobber();
+	}
+}
+
+struct ctx_array_arg {
+	struct avtp_stream_ctx *ctxs;
+	struct avtp_stream_pdu pdus[NUM_STREAMS];
+};
+
+/* PDUs from many streams received round-robin, each stream with its own
+ * context from a single array.
+ */
+static void bench_stream_ctx_receive(void *arg, uint64_t iters)
+{
+	struct ctx_array_arg *a = arg;
+	uint64_t i, time;
+
+	for (i = 0; i < iters; i++) {
+		unsigned int s = i % NUM_STREAMS;
+
+		avtp_stream_ctx_receive(&a->ctxs[s], &a->pdus[s], i + 1,
+									&time);
+		bench_clobber();
+	}
+}
+
+static void run_stream_ctx_array(const void *tmpl)
+{
+	static struct ctx_array_arg arg;
+	int i, res;
+
+	res = avtp_stream_ctx_array_create(&arg.ctxs, NUM_STREAMS);
+	if (res < 0) {
+		bench_skip("avtp_stream_ctx_receive", res);
+		return;
+	}
+
+	for (i = 0; i < NUM_STREAMS; i++) {
+		avtp_stream_ctx_init(&arg.ctxs[i], tmpl, 48000);
+		avtp_stream_ctx_emit(&arg.ctxs[i], &arg.pdus[i], 6);
+	}
+
+	bench_run("avtp_stream_ctx_receive/256", bench_stream_ctx_receive,
+									&arg);
+
+	avtp_stream_ctx_array_destroy(arg.ctxs);
+}
+
+static void run_stream_ctx(const void *tmpl)
+{
+	static uint8_t ring[BURST_SIZE][PDU_BUF_SIZE];
+	static struct ctx_arg arg;
+	int i, res;
+
+	res = avtp_stream_ctx_init(&arg.ctx, tmpl, 48000);
+	if (res < 0) {
+		bench_skip("avtp_stream_ctx", res);
+		return;
+	}
+
+	for (i = 0; i < BURST_SIZE; i++)
+		arg.pdus[i] = ring[i];
+
+	bench_run("avtp_stream_ctx_emit", bench_stream_ctx_emit, &arg);
+	bench_run("avtp_stream_ctx_advance", bench_stream_ctx_advance, &arg);
+	bench_run("avtp_stream_ctx_emit_burst/32",
+					bench_stream_ctx_emit_burst, &arg);
+
+	run_stream_ctx_array(tmpl);
+}
+
+/* CRF timestamps filling a 1500 bytes MTU. */
+#define CRF_DATA_COUNT		((1500 - sizeof(struct avtp_crf_pdu)) / \
+							sizeof(uint64_t))
+
+struct crf_data_arg {
+	struct avtp_crf_hdr hdr;
+	uint64_t data[CRF_DATA_COUNT];
+	uint64_t ts[CRF_DATA_COUNT];
+};
+
+static void bench_crf_data_encode(void *arg, uint64_t iters)
+{
+	struct crf_data_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_crf_data_encode(a->data, CRF_DATA_COUNT, i, &a->hdr);
+		bench_clobber();
+	}
+}
+
+static void bench_crf_data_decode(void *arg, uint64_t iters)
+{
+	struct crf_data_arg *a = arg;
+	unsigned int outliers[4];
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		bench_keep(avtp_crf_data_decode(a->ts, a->data, CRF_DATA_COUNT,
+							&a->hdr, outliers, 4));
+		bench_clobber();
+	}
+}
+
+static void run_crf_data(void)
+{
+	static struct crf_data_arg arg = {
+		.hdr = {
+			.type = AVTP_CRF_TYPE_VIDEO_LINE,
+			.pull = AVTP_CRF_PULL_MULT_BY_1_OVER_1_001,
+			.base_freq = 67500,
+			.timestamp_interval = 1,
+		},
+	};
+
+	bench_run("avtp_crf_data_encode/185", bench_crf_data_encode, &arg);
+	bench_run("avtp_crf_data_decode/185", bench_crf_data_decode, &arg);
+}
+
+/* Validate a received PDU once and read a field through the view. */
+static void bench_pdu_view_init(void *arg, uint64_t iters)
+{
+	struct avtp_pdu_view view;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		avtp_pdu_view_init(&view, arg, PDU_BUF_SIZE, AVTP_SUBTYPE_AAF);
+		bench_keep(avtp_stream_get_seq_num(
+					avtp_pdu_view_stream(&view)));
+		bench_clobber();
+	}
+}
+
+static void run_pdu_view(void)
+{
+	static uint8_t pdu[PDU_BUF_SIZE];
+	struct avtp_pdu_view view;
+	int res;
+
+	/* Field benchmarks leave garbage in the other PDUs, so this one is
+	 * set up from scratch.
+	 */
+	res = avtp_aaf_pdu_init((struct avtp_stream_pdu *) pdu);
+	if (res == 0)
+		res = avtp_pdu_view_init(&view, pdu, sizeof(pdu),
+							AVTP_SUBTYPE_AAF);
+	if (res < 0) {
+		bench_skip("avtp_pdu_view_init", res);
+		return;
+	}
+
+	bench_run("avtp_pdu_view_init", bench_pdu_view_init, pdu);
+}
+
+void bench_pdu(void)
+{
+	static uint8_t aaf[PDU_BUF_SIZE], crf[PDU_BUF_SIZE], cvf[PDU_BUF_SIZE],
+			rvf[PDU_BUF_SIZE], ieciidc[PDU_BUF_SIZE],
+			out[PDU_BUF_SIZE];
+	const struct field_suite suites[] = {
+		FIELD_SUITE(pdu, common_fields),
+		FIELD_SUITE(aaf_pdu, aaf_fields),
+		FIELD_SUITE(crf_pdu, crf_fields),
+		FIELD_SUITE(cvf_pdu, cvf_fields),
+		FIELD_SUITE(rvf_pdu, rvf_fields),
+		FIELD_SUITE(ieciidc_pdu, ieciidc_fields),
+	};
+	void *const pdus[] = { aaf, aaf, crf, cvf, rvf, ieciidc };
+	struct emit_arg emit = { .pdu = out };
+	size_t i;
+
+	bench_run("avtp_aaf_pdu_init", bench_aaf_pdu_init, aaf);
+	bench_run("avtp_crf_pdu_init", bench_crf_pdu_init, crf);
+	bench_run("avtp_cvf_pdu_init", bench_cvf_pdu_init, cvf);
+	bench_run("avtp_rvf_pdu_init", bench_rvf_pdu_init, rvf);
+	bench_run("avtp_ieciidc_pdu_init", bench_ieciidc_pdu_init, ieciidc);
+
+	for (i = 0; i < sizeof(suites) / sizeof(suites[0]); i++)
+		run_field_suite(&suites[i], pdus[i]);
+
+	run_aaf_pack((struct avtp_stream_pdu *) aaf);
+	run_crf_pack((struct avtp_crf_pdu *) crf);
+	run_cvf_pack((struct avtp_stream_pdu *) cvf);
+	run_rvf_pack((struct avtp_stream_pdu *) rvf);
+	run_ieciidc_pack((struct avtp_stream_pdu *) ieciidc);
+
+	emit.tmpl = aaf;
+	bench_run("avtp_stream_pdu_emit", bench_stream_pdu_emit, &emit);
+	emit.tmpl = crf;
+	bench_run("avtp_crf_pdu_emit", bench_crf_pdu_emit, &emit);
+
+	run_pdu_view();
+	run_stream_ctx(aaf);
+	run_crf_data();
+}
@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Benchmarks of talker and listener pipelines. PDUs are built into and
+ * parsed from in-memory buffers instead of being sent to the network, so
+ * what is measured is the packetization cost per packet.
+ */
+
+#include <endian.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_classifier.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_inline.h"
+#include "bench.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define MTU			1500
+/* Number of PDU buffers, enough for a full 'sequence_num' cycle. */
+#define RING_SIZE		256
+#define BATCH_SIZE		32
+
+/* AAF stream: 48 kHz, stereo, 16-bit samples, 6 frames per PDU. */
+#define AAF_FRAMES		6
+#define AAF_CHANNELS		2
+#define AAF_DATA_LEN		(AAF_FRAMES * AAF_CHANNELS * sizeof(int16_t))
+#define AAF_PDU_SIZE		(sizeof(struct avtp_stream_pdu) + AAF_DATA_LEN)
+
+/* CRF stream: 48 kHz audio sample clock, 6 timestamps per PDU. */
+#define CRF_TIMESTAMPS		6
+#define CRF_INTERVAL		160
+#define CRF_PERIOD		(1000000000.0 * CRF_INTERVAL / 48000)
+#define CRF_PDU_SIZE		(sizeof(struct avtp_crf_pdu) + \
+					CRF_TIMESTAMPS * sizeof(uint64_t))
+
+/* CVF stream: access unit with a single 64 KiB IDR slice. */
+#define CVF_AU_SIZE		(64 * 1024)
+#define CVF_MAX_PDUS		64
+
+struct aaf_arg {
+	struct avtp_aaf_hdr hdr;
+	struct avtp_stream_pdu *tmpl;
+	uint8_t *ring;
+	struct avtp_classifier *cls;
+	int16_t samples[AAF_FRAMES * AAF_CHANNELS];
+};
+
+static void init_aaf_hdr(struct avtp_aaf_hdr *hdr)
+{
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->stream.sv = 1;
+	hdr->stream.tv = 1;
+	hdr->stream.stream_id = STREAM_ID;
+	hdr->stream.stream_data_len = AAF_DATA_LEN;
+	hdr->format = AVTP_AAF_FORMAT_INT_16BIT;
+	hdr->nsr = AVTP_AAF_PCM_NSR_48KHZ;
+	hdr->chan_per_frame = AAF_CHANNELS;
+	hdr->bit_depth = 16;
+}
+
+static void bench_aaf_talker(void *arg, uint64_t iters)
+{
+	struct aaf_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *)
+				(a->ring + (i % RING_SIZE) * AAF_PDU_SIZE);
+
+		avtp_stream_pdu_emit(pdu, a->tmpl, i, i * 125000,
+							AAF_DATA_LEN);
+		avtp_aaf_pcm_encode(&a->hdr, pdu->avtp_payload, a->samples,
+					AVTP_AAF_PCM_SAMPLE_S16, AAF_FRAMES);
+		bench_clobber();
+	}
+}
+
+static void bench_aaf_listener(void *arg, uint64_t iters)
+{
+	const struct avtp_stream_pdu *pdus[BATCH_SIZE];
+	struct avtp_classifier_result results[BATCH_SIZE];
+	size_t lens[BATCH_SIZE];
+	struct aaf_arg *a = arg;
+	uint64_t done = 0;
+	unsigned int i;
+
+	for (i = 0; i < BATCH_SIZE; i++)
+		lens[i] = AAF_PDU_SIZE;
+
+	while (done < iters) {
+		unsigned int pos = done % RING_SIZE;
+		unsigned int n = BATCH_SIZE;
+
+		if (n > RING_SIZE - pos)
+			n = RING_SIZE - pos;
+		if (n > iters - done)
+			n = iters - done;
+
+		for (i = 0; i < n; i++)
+			pdus[i] = (const struct avtp_stream_pdu *)
+				(a->ring + (pos + i) * AAF_PDU_SIZE);
+
+		avtp_classifier_classify(a->cls, pdus, lens, n, results);
+
+		for (i = 0; i < n; i++) {
+			if (results[i].verdict != AVTP_CLASSIFIER_PASS &&
+				results[i].verdict != AVTP_CLASSIFIER_SEQ_GAP)
+				continue;
+
+			bench_keep(avtp_stream_get_timestamp(pdus[i]));
+			avtp_aaf_pcm_decode(&a->hdr, pdus[i]->avtp_payload,
+						a->samples,
+						AVTP_AAF_PCM_SAMPLE_S16,
+						AAF_FRAMES);
+			bench_clobber();
+		}
+
+		done += n;
+	}
+}
+
+static void run_aaf(void)
+{
+	struct aaf_arg arg = { 0 };
+	int i, res;
+
+	init_aaf_hdr(&arg.hdr);
+
+	for (i = 0; i < AAF_FRAMES * AAF_CHANNELS; i++)
+		arg.samples[i] = i * 1000;
+
+	arg.tmpl = calloc(1, AAF_PDU_SIZE);
+	arg.ring = calloc(RING_SIZE, AAF_PDU_SIZE);
+	if (!arg.tmpl || !arg.ring) {
+		res = -ENOMEM;
+		goto err;
+	}
+
+	res = avtp_aaf_pdu_pack(arg.tmpl, &arg.hdr);
+	if (res < 0)
+		goto err;
+
+	bench_run("pipeline/aaf_talker", bench_aaf_talker, &arg);
+
+	/* Fill the ring with a full 'sequence_num' cycle of PDUs for the
+	 * listener, in case the talker benchmark was filtered out.
+	 */
+	bench_aaf_talker(&arg, RING_SIZE);
+
+	res = avtp_classifier_create(&arg.cls, 1);
+	if (res < 0)
+		goto err;
+
+	res = avtp_classifier_add(arg.cls, arg.tmpl, NULL);
+	if (res < 0)
+		goto err_cls;
+
+	bench_run("pipeline/aaf_listener", bench_aaf_listener, &arg);
+
+	avtp_classifier_destroy(arg.cls);
+	free(arg.ring);
+	free(arg.tmpl);
+	return;
+
+err_cls:
+	avtp_classifier_destroy(arg.cls);
+err:
+	bench_skip("pipeline/aaf", res);
+	free(arg.ring);
+	free(arg.tmpl);
+}
+
+struct crf_arg {
+	struct avtp_crf_pdu *tmpl;
+	struct avtp_crf_pdu *pdu;
+	struct avtp_crf_clock *clk;
+	uint64_t start;
+};
+
+/* Feed the media clock with PDUs carrying the timestamps a talker would
+ * send, as a CRF listener does.
+ */
+static void bench_crf_listener(void *arg, uint64_t iters)
+{
+	struct crf_arg *a = arg;
+	uint64_t i;
+	int j;
+
+	for (i = 0; i < iters; i++) {
+		uint64_t index = (a->start + i) * CRF_TIMESTAMPS;
+
+		for (j = 0; j < CRF_TIMESTAMPS; j++)
+			a->pdu->crf_data[j] = htobe64((uint64_t)
+					((index + j) * CRF_PERIOD));
+
+		avtp_crf_pdu_emit(a->pdu, a->tmpl, a->start + i);
+		avtp_crf_clock_update(a->clk, a->pdu, CRF_PDU_SIZE);
+	}
+
+	a->start += iters;
+}
+
+static void run_crf(void)
+{
+	struct avtp_crf_hdr hdr = {
+		.sv = 1,
+		.type = AVTP_CRF_TYPE_AUDIO_SAMPLE,
+		.stream_id = STREAM_ID,
+		.pull = AVTP_CRF_PULL_MULT_BY_1,
+		.base_freq = 48000,
+		.timestamp_interval = CRF_INTERVAL,
+		.crf_data_len = CRF_TIMESTAMPS * sizeof(uint64_t),
+	};
+	struct crf_arg arg = { 0 };
+	int res;
+
+	arg.tmpl = calloc(1, CRF_PDU_SIZE);
+	arg.pdu = calloc(1, CRF_PDU_SIZE);
+	if (!arg.tmpl || !arg.pdu) {
+		res = -ENOMEM;
+		goto err;
+	}
+
+	res = avtp_crf_pdu_pack(arg.tmpl, &hdr);
+	if (res < 0)
+		goto err;
+
+	res = avtp_crf_clock_create(&arg.clk, 300);
+	if (res < 0)
+		goto err;
+
+	bench_run("pipeline/crf_listener", bench_crf_listener, &arg);
+
+	avtp_crf_clock_destroy(arg.clk);
+	free(arg.pdu);
+	free(arg.tmpl);
+	return;
+
+err:
+	bench_skip("pipeline/crf_listener", res);
+	free(arg.pdu);
+	free(arg.tmpl);
+}
+
+struct cvf_arg {
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_depacketizer *depkt;
+	uint8_t *au;
+	uint8_t *pdus[CVF_MAX_PDUS];
+	size_t lens[CVF_MAX_PDUS];
+	int count;
+};
+
+static void bench_cvf_talker(void *arg, uint64_t iters)
+{
+	struct avtp_cvf_h264_packet packet;
+	struct cvf_arg *a = arg;
+	uint64_t i = 0;
+
+	while (i < iters) {
+		if (avtp_cvf_h264_packetizer_next(&a->pkt, &packet) == 1) {
+			bench_clobber();
+			i++;
+			continue;
+		}
+
+		avtp_cvf_h264_packetizer_start(&a->pkt, a->au, CVF_AU_SIZE,
+									i, i);
+	}
+}
+
+/* PDUs from the same access unit are pushed over and over, so their
+ * sequence numbers are rewritten to look like a continuous stream.
+ */
+static void bench_cvf_listener(void *arg, uint64_t iters)
+{
+	struct avtp_cvf_h264_frame frame;
+	struct cvf_arg *a = arg;
+	uint64_t i;
+
+	for (i = 0; i < iters; i++) {
+		struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *)
+							a->pdus[i % a->count];
+
+		avtp_stream_set_seq_num(pdu, i);
+		if (avtp_cvf_h264_depacketizer_push(a->depkt, pdu,
+					a->lens[i % a->count], &frame) == 1)
+			avtp_cvf_h264_depacketizer_release(a->depkt, &frame);
+	}
+}
+
+static int init_cvf(struct cvf_arg *arg)
+{
+	uint8_t tmpl[sizeof(struct avtp_stream_pdu) +
+				sizeof(struct avtp_cvf_h264_payload)] = { 0 };
+	struct avtp_cvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = STREAM_ID,
+		},
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_H264,
+	};
+	struct avtp_cvf_h264_packet packet;
+	int i, res;
+
+	arg->au = malloc(CVF_AU_SIZE);
+	if (!arg->au)
+		return -ENOMEM;
+
+	/* Start code followed by an IDR slice NAL unit. */
+	for (i = 4; i < CVF_AU_SIZE; i++)
+		arg->au[i] = i;
+	memcpy(arg->au, "\x00\x00\x00\x01\x65", 5);
+
+	res = avtp_cvf_pdu_pack((struct avtp_stream_pdu *) tmpl, &hdr);
+	if (res < 0)
+		return res;
+
+	res = avtp_cvf_h264_packetizer_init(&arg->pkt,
+				(struct avtp_stream_pdu *) tmpl, MTU);
+	if (res < 0)
+		return res;
+
+	res = avtp_cvf_h264_packetizer_start(&arg->pkt, arg->au, CVF_AU_SIZE,
+									0, 0);
+	if (res < 0)
+		return res;
+
+	/* Flatten the PDUs from one access unit for the listener. */
+	while (avtp_cvf_h264_packetizer_next(&arg->pkt, &packet) == 1) {
+		uint8_t *pdu;
+
+		if (arg->count == CVF_MAX_PDUS)
+			return -ENOSPC;
+
+		pdu = malloc(packet.iov[0].iov_len + packet.iov[1].iov_len);
+		if (!pdu)
+			return -ENOMEM;
+
+		memcpy(pdu, packet.iov[0].iov_base, packet.iov[0].iov_len);
+		memcpy(pdu + packet.iov[0].iov_len, packet.iov[1].iov_base,
+							packet.iov[1].iov_len);
+
+		arg->pdus[arg->count] = pdu;
+		arg->lens[arg->count] = packet.iov[0].iov_len +
+							packet.iov[1].iov_len;
+		arg->count++;
+	}
+
+	return avtp_cvf_h264_depacketizer_create(&arg->depkt,
+							4 * CVF_AU_SIZE);
+}
+
+static void run_cvf(void)
+{
+	struct cvf_arg arg = { 0 };
+	int i, res;
+
+	res = init_cvf(&arg);
+	if (res < 0) {
+		bench_skip("pipeline/cvf_h264_talker", res);
+		bench_skip("pipeline/cvf_h264_listener", res);
+	} else {
+		bench_run("pipeline/cvf_h264_talker", bench_cvf_talker, &arg);
+		bench_run("pipeline/cvf_h264_listener", bench_cvf_listener,
+									&arg);
+	}
+
+	if (arg.depkt)
+		avtp_cvf_h264_depacketizer_destroy(arg.depkt);
+	for (i = 0; i < arg.count; i++)
+		free(arg.pdus[i]);
+	free(arg.au);
+}
+
+void bench_pipeline(void)
+{
+	run_aaf();
+	run_crf();
+	run_cvf();
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Benchmarks of the listener pipeline fed by a capture replay. A capture of
+ * an AAF stream is recorded into a temporary file and replayed as fast as
+ * possible, over and over, so what is measured is the cost per packet of
+ * the replay on top of the listener pipeline.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_classifier.h"
+#include "avtp_inline.h"
+#include "avtp_net.h"
+#include "bench.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+/* Number of recorded PDUs, a full 'sequence_num' cycle. */
+#define CAPTURE_SIZE		256
+#define BATCH_SIZE		32
+/* Capture times of PDUs, 125 us apart as for a class A stream. */
+#define PDU_INTERVAL		125000
+
+/* AAF stream: 48 kHz, stereo, 16-bit samples, 6 frames per PDU. */
+#define AAF_FRAMES		6
+#define AAF_CHANNELS		2
+#define AAF_DATA_LEN		(AAF_FRAMES * AAF_CHANNELS * sizeof(int16_t))
+#define AAF_PDU_SIZE		(sizeof(struct avtp_stream_pdu) + AAF_DATA_LEN)
+
+struct replay_arg {
+	struct avtp_aaf_hdr hdr;
+	struct avtp_net_replay *rp;
+	struct avtp_classifier *cls;
+	int16_t samples[AAF_FRAMES * AAF_CHANNELS];
+};
+
+static void bench_aaf_replay(void *arg, uint64_t iters)
+{
+	const struct avtp_stream_pdu *pdus[BATCH_SIZE];
+	struct avtp_classifier_result results[BATCH_SIZE];
+	size_t lens[BATCH_SIZE];
+	struct replay_arg *a = arg;
+	uint64_t done = 0;
+	int i, n;
+
+	while (done < iters) {
+		unsigned int batch = BATCH_SIZE;
+
+		if (batch > iters - done)
+			batch = iters - done;
+
+		n = avtp_net_replay_classify(a->rp, a->cls, pdus, lens, NULL,
+								results, batch);
+		if (n <= 0)
+			return;
+
+		for (i = 0; i < n; i++) {
+			if (results[i].verdict != AVTP_CLASSIFIER_PASS &&
+				results[i].verdict != AVTP_CLASSIFIER_SEQ_GAP)
+				continue;
+
+			bench_keep(avtp_stream_get_timestamp(pdus[i]));
+			avtp_aaf_pcm_decode(&a->hdr, pdus[i]->avtp_payload,
+						a->samples,
+						AVTP_AAF_PCM_SAMPLE_S16,
+						AAF_FRAMES);
+			bench_clobber();
+		}
+
+		done += n;
+	}
+}
+
+/* Record CAPTURE_SIZE PDUs from an AAF talker into 'path'. */
+static int record_aaf(const char *path, struct replay_arg *a,
+					struct avtp_stream_pdu *tmpl)
+{
+	struct avtp_net_capture_config cfg = { .path = path };
+	const struct avtp_stream_pdu *pdus[CAPTURE_SIZE];
+	uint64_t times[CAPTURE_SIZE];
+	size_t lens[CAPTURE_SIZE];
+	struct avtp_net_capture *cap;
+	uint8_t *ring;
+	int i, res;
+
+	ring = calloc(CAPTURE_SIZE, AAF_PDU_SIZE);
+	if (!ring)
+		return -ENOMEM;
+
+	for (i = 0; i < CAPTURE_SIZE; i++) {
+		struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *)
+						(ring + i * AAF_PDU_SIZE);
+
+		avtp_stream_pdu_emit(pdu, tmpl, i, i * PDU_INTERVAL,
+							AAF_DATA_LEN);
+		avtp_aaf_pcm_encode(&a->hdr, pdu->avtp_payload, a->samples,
+					AVTP_AAF_PCM_SAMPLE_S16, AAF_FRAMES);
+
+		pdus[i] = pdu;
+		lens[i] = AAF_PDU_SIZE;
+		times[i] = (uint64_t) i * PDU_INTERVAL;
+	}
+
+	res = avtp_net_capture_create(&cap, &cfg);
+	if (res < 0)
+		goto out;
+
+	res = avtp_net_capture_write(cap, pdus, lens, times, CAPTURE_SIZE);
+	if (res == CAPTURE_SIZE)
+		res = avtp_net_capture_flush(cap);
+	else if (res >= 0)
+		res = -ENOSPC;
+
+	avtp_net_capture_destroy(cap);
+out:
+	free(ring);
+	return res;
+}
+
+static void run_aaf(void)
+{
+	struct avtp_net_replay_config cfg = { .loop = true };
+	char path[] = "/tmp/avtp-bench-XXXXXX";
+	struct replay_arg arg = { 0 };
+	struct avtp_stream_pdu tmpl;
+	int i, fd, res;
+
+	fd = mkstemp(path);
+	if (fd < 0) {
+		bench_skip("replay/aaf_listener", -errno);
+		return;
+	}
+	close(fd);
+
+	memset(&arg.hdr, 0, sizeof(arg.hdr));
+	arg.hdr.stream.sv = 1;
+	arg.hdr.stream.tv = 1;
+	arg.hdr.stream.stream_id = STREAM_ID;
+	arg.hdr.stream.stream_data_len = AAF_DATA_LEN;
+	arg.hdr.format = AVTP_AAF_FORMAT_INT_16BIT;
+	arg.hdr.nsr = AVTP_AAF_PCM_NSR_48KHZ;
+	arg.hdr.chan_per_frame = AAF_CHANNELS;
+	arg.hdr.bit_depth = 16;
+
+	for (i = 0; i < AAF_FRAMES * AAF_CHANNELS; i++)
+		arg.samples[i] = i * 1000;
+
+	res = avtp_aaf_pdu_pack(&tmpl, &arg.hdr);
+	if (res < 0)
+		goto err;
+
+	res = record_aaf(path, &arg, &tmpl);
+	if (res < 0)
+		goto err;
+
+	cfg.path = path;
+	res = avtp_net_replay_create(&arg.rp, &cfg);
+	if (res < 0)
+		goto err;
+
+	res = avtp_classifier_create(&arg.cls, 1);
+	if (res < 0)
+		goto err_rp;
+
+	res = avtp_classifier_add(arg.cls, &tmpl, NULL);
+	if (res < 0)
+		goto err_cls;
+
+	bench_run("replay/aaf_listener", bench_aaf_replay, &arg);
+
+	avtp_classifier_destroy(arg.cls);
+	avtp_net_replay_destroy(arg.rp);
+	unlink(path);
+	return;
+
+err_cls:
+	avtp_classifier_destroy(arg.cls);
+err_rp:
+	avtp_net_replay_destroy(arg.rp);
+err:
+	bench_skip("replay/aaf_listener", res);
+	unlink(path);
+}
+
+void bench_replay(void)
+{
+	run_aaf();
+}
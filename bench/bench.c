@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* libavtp microbenchmarks.
+ *
+ * Measures the cost of PDU field accessors, header pack/unpack functions and
+ * inline accessors, as well as the throughput of talker and listener
+ * pipelines running over in-memory buffers, so no network is needed. If
+ * libavtp-net is available, the listener pipeline is also fed by a capture
+ * replay.
+ *
+ * Results are written to stdout in CSV format, one benchmark per line:
+ *
+ *	benchmark,iterations,ns_per_op,ops_per_sec
+ *
+ * For pipeline benchmarks an operation is one packet, so 'ops_per_sec' is
+ * the packet rate. Setup failures are reported to stderr.
+ *
+ * Usage: avtp-bench [-t MIN_TIME_MS] [FILTER]
+ *
+ * Only benchmarks whose name contains FILTER are run. Each benchmark runs
+ * for at least MIN_TIME_MS milliseconds (default 10).
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+#define NSEC_PER_MSEC		1000000ULL
+#define RUNS			3
+
+static uint64_t min_time = 10 * NSEC_PER_MSEC;
+static const char *filter;
+
+static uint64_t now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static uint64_t measure(bench_fn fn, void *arg, uint64_t iters)
+{
+	uint64_t start = now();
+
+	fn(arg, iters);
+
+	return now() - start;
+}
+
+void bench_run(const char *name, bench_fn fn, void *arg)
+{
+	uint64_t iters = 1, elapsed, best;
+	double ns_per_op;
+	int i;
+
+	if (filter && !strstr(name, filter))
+		return;
+
+	/* Grow the number of iterations until a run is long enough, aiming
+	 * slightly above the minimum time so the next run gets there.
+	 */
+	while ((elapsed = measure(fn, arg, iters)) < min_time) {
+		uint64_t next;
+
+		if (elapsed == 0)
+			next = iters * 100;
+		else
+			next = iters * min_time * 6 / 5 / elapsed;
+
+		if (next > iters * 100)
+			next = iters * 100;
+		if (next <= iters)
+			next = iters + 1;
+
+		iters = next;
+	}
+
+	best = elapsed;
+	for (i = 1; i < RUNS; i++) {
+		elapsed = measure(fn, arg, iters);
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	ns_per_op = (double) best / iters;
+
+	printf("%s,%" PRIu64 ",%.2f,%.0f\n", name, iters, ns_per_op,
+							1e9 / ns_per_op);
+	fflush(stdout);
+}
+
+void bench_skip(const char *name, int err)
+{
+	if (filter && !strstr(name, filter))
+		return;
+
+	fprintf(stderr, "%s: skipped, setup failed: %s\n", name,
+							strerror(-err));
+}
+
+int main(int argc, char *argv[])
+{
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:")) != -1) {
+		switch (opt) {
+		case 't':
+			min_time = strtoull(optarg, NULL, 0) * NSEC_PER_MSEC;
+			break;
+		default:
+			fprintf(stderr, "Usage: %s [-t MIN_TIME_MS] [FILTER]\n",
+								argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind < argc)
+		filter = argv[optind];
+
+	printf("benchmark,iterations,ns_per_op,ops_per_sec\n");
+
+	bench_pdu();
+	bench_inline();
+	bench_pipeline();
+#ifdef HAVE_AVTP_NET
+	bench_replay();
+#endif
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+/* Benchmarked operation. It should run the operation 'iters' times on
+ * 'arg'.
+ */
+typedef void (*bench_fn)(void *arg, uint64_t iters);
+
+/* Measure the cost of an operation and report it. 'fn' is run with an
+ * increasing number of iterations until a run takes at least the minimum
+ * benchmark time, so fixed costs are amortized, and the best of a few runs
+ * with that number of iterations is reported. Benchmarks whose name doesn't
+ * match the filter given in command line are skipped.
+ * @name: Benchmark name, in '<group>/<operation>' form.
+ * @fn: Operation to be measured.
+ * @arg: Argument passed to 'fn'.
+ */
+void bench_run(const char *name, bench_fn fn, void *arg);
+
+/* Report a benchmark setup failure, so missing results are accounted for. */
+void bench_skip(const char *name, int err);
+
+/* Keep the compiler from optimizing away the computation of 'val'. */
+static inline void bench_keep(uint64_t val)
+{
+	__asm__ volatile("" : : "r" (val));
+}
+
+/* Keep the compiler from caching memory contents across this point, so
+ * loads and stores from benchmarked operations are redone on every
+ * iteration.
+ */
+static inline void bench_clobber(void)
+{
+	__asm__ volatile("" : : : "memory");
+}
+
+/* Benchmark suites. */
+void bench_pdu(void);
+void bench_inline(void);
+void bench_pipeline(void);
+void bench_replay(void);
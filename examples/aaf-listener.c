@@ -40,6 +40,35 @@
  * TSN stream parameters such as destination mac address are passed via
  * command-line arguments. Run 'aaf-listener --help' for more information.
  *
+ * Packets are received through the zero-copy RX ring from libavtp-net, so
+ * each wakeup processes all packets received since the previous one.
+ *
+ * Received packets can also be recorded into a pcapng file, e.g. to be
+ * replayed offline later on, with the '--capture' option.
+ *
+ * Lost, duplicated, reordered and late packets are accounted by the stream
+ * statistics, which are reported to stderr once per second instead of
+ * logging each event from the receive path.
+ *
+ * Each packet is timestamped by the kernel as it arrives, or by the NIC itself
+ * with the '--hw-tstamp' option, so lateness is judged against the actual
+ * arrival time rather than the time the packet is processed at.
+ *
+ * Streams in sparse timestamp mode are received with the '--sparse' option.
+ * In that mode, only one out of every 8 packets carries a timestamp and the
+ * presentation time of the others is interpolated from the sample rate.
+ *
+ * Samples are held by a jitter buffer, which reorders them by presentation
+ * time and plays them out in blocks of 1 ms worth of samples through the
+ * presentation scheduler, so a single timer is armed per block. Samples from
+ * lost or late packets are concealed with silence or, with the '--conceal
+ * repeat' option, with the samples from the previous block. Blocks are
+ * played out after their presentation time plus a delay, which is adapted
+ * once per second from the stream statistics: it grows in steps of a block
+ * when packets come too late for their block, and shrinks back as long as
+ * packets arrive early enough, so playout latency stays low. The delay and
+ * the number of concealed samples are reported along with the statistics.
+ *
  * This example relies on the system clock to schedule PCM samples for
  * playback. So make sure the system clock is synchronized with the PTP
  * Hardware Clock (PHC) from your NIC and that the PHC is synchronized with
@@ -54,9 +83,9 @@
  * $ aaf-listener <args> | aplay -f dat -t raw -D <playback-device>
  */
 
-#include <assert.h>
 #include <argp.h>
 #include <arpa/inet.h>
+#include <inttypes.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
@@ -64,13 +93,18 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/queue.h>
 #include <sys/timerfd.h>
+#include <time.h>
 #include <unistd.h>
-#include <inttypes.h>
 
 #include "avtp.h"
 #include "avtp_aaf.h"
+#include "avtp_classifier.h"
+#include "avtp_inline.h"
+#include "avtp_jbuf.h"
+#include "avtp_net.h"
+#include "avtp_sched.h"
+#include "avtp_stream_ctx.h"
 #include "examples/common.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -79,22 +113,44 @@
 #define DATA_LEN		(SAMPLE_SIZE * NUM_CHANNELS)
 #define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
 #define NSEC_PER_SEC		1000000000ULL
-
-struct sample_entry {
-	STAILQ_ENTRY(sample_entry) entries;
-
-	struct timespec tspec;
-	uint8_t pcm_sample[DATA_LEN];
-};
-
-static STAILQ_HEAD(sample_queue, sample_entry) samples;
+#define SAMPLE_RATE		48000
+#define BATCH_SIZE		32
+/* Default max transit time of SR class A streams. */
+#define MAX_TRANSIT_TIME	2000000
+
+/* Samples are played out in blocks of 1 ms. */
+#define BLOCK_SAMPLES		48
+/* The jitter buffer holds samples from their arrival, up to max transit time
+ * before presentation, until they are played out, up to MAX_DELAY after it.
+ */
+#define MAX_DELAY		4000000
+#define JBUF_BLOCKS		8
+
+static struct avtp_sched *sched;
+static struct avtp_jbuf *jbuf;
+static bool playout_scheduled;
+static enum avtp_jbuf_conceal conceal = AVTP_JBUF_CONCEAL_ZERO;
+static bool present_failed;
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
-static uint8_t expected_seq;
+static struct avtp_classifier *classifier;
+static struct avtp_net_rx *rx;
+static struct avtp_stats *stats;
+static uint64_t last_report;
+static char *capture_path;
+static struct avtp_net_capture *capture;
+static bool hw_tstamp;
+static bool sparse;
+static struct avtp_stream_ctx stream_ctx;
+static int64_t tai_offset;
 
 static struct argp_option options[] = {
 	{"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
 	{"ifname", 'i', "IFNAME", 0, "Network Interface" },
+	{"capture", 'c', "FILE", 0, "Record received packets into FILE" },
+	{"hw-tstamp", 'H', 0, 0, "Timestamp packets in the NIC" },
+	{"sparse", 's', 0, 0, "Receive stream in sparse timestamp mode" },
+	{"conceal", 'C', "zero|repeat", 0, "How lost samples are concealed" },
 	{ 0 }
 };
 
@@ -103,6 +159,19 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 	int res;
 
 	switch (key) {
+	case 'c':
+		capture_path = arg;
+		break;
+	case 'C':
+		if (strcmp(arg, "zero") == 0) {
+			conceal = AVTP_JBUF_CONCEAL_ZERO;
+		} else if (strcmp(arg, "repeat") == 0) {
+			conceal = AVTP_JBUF_CONCEAL_REPEAT;
+		} else {
+			fprintf(stderr, "Invalid concealment\n");
+			exit(EXIT_FAILURE);
+		}
+		break;
 	case 'd':
 		res = sscanf(arg, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
 					&macaddr[0], &macaddr[1], &macaddr[2],
@@ -116,6 +185,12 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 	case 'i':
 		strncpy(ifname, arg, sizeof(ifname) - 1);
 		break;
+	case 'H':
+		hw_tstamp = true;
+		break;
+	case 's':
+		sparse = true;
+		break;
 	}
 
 	return 0;
@@ -123,212 +198,266 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser };
 
-/* Schedule 'pcm_sample' to be presented at time specified by 'tspec'. */
-static int schedule_sample(int fd, struct timespec *tspec, uint8_t *pcm_sample)
+/* Schedule the next block from the jitter buffer to be played out. */
+static int schedule_block(int fd)
 {
-	struct sample_entry *entry;
+	struct timespec tspec;
+	uint64_t time;
+	int res;
+
+	res = avtp_jbuf_next(jbuf, &time);
+	if (res < 0)
+		return 0;
+
+	tspec.tv_sec = time / NSEC_PER_SEC;
+	tspec.tv_nsec = time % NSEC_PER_SEC;
 
-	entry = malloc(sizeof(*entry));
-	if (!entry) {
-		fprintf(stderr, "Failed to allocate memory\n");
+	res = schedule_payload(sched, fd, &tspec, jbuf);
+	if (res < 0)
 		return -1;
+
+	playout_scheduled = true;
+	return 0;
+}
+
+/* Dispatch callback from the scheduler, called once the next block from the
+ * jitter buffer is due. If the delay shrank meanwhile, the following blocks
+ * may be due as well, so they are played out right away. The next block is
+ * then scheduled again, even if the delay grew and this one isn't due yet.
+ */
+static void present_samples(void *const payloads[], const uint64_t times[],
+					unsigned int count, void *arg)
+{
+	int16_t block[BLOCK_SAMPLES * NUM_CHANNELS];
+	uint64_t time;
+
+	while (avtp_jbuf_get(jbuf, times[0], block) == 0) {
+		if (present_data((uint8_t *) block, sizeof(block)) < 0)
+			present_failed = true;
 	}
 
-	entry->tspec.tv_sec = tspec->tv_sec;
-	entry->tspec.tv_nsec = tspec->tv_nsec;
-	memcpy(entry->pcm_sample, pcm_sample, DATA_LEN);
+	/* The timer is re-armed by dispatch_payloads() once we return. */
+	if (avtp_jbuf_next(jbuf, &time) < 0 ||
+				avtp_sched_add(sched, time, jbuf) < 0)
+		present_failed = true;
+}
 
-	STAILQ_INSERT_TAIL(&samples, entry, entries);
+/* Stream format shared by header packing and PCM sample encoding. */
+static const struct avtp_aaf_hdr aaf_hdr = {
+	.stream = {
+		.sv = 1,
+		.tv = 1,
+		.stream_id = STREAM_ID,
+		.stream_data_len = DATA_LEN,
+	},
+	.format = AVTP_AAF_FORMAT_INT_16BIT,
+	.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+	.chan_per_frame = NUM_CHANNELS,
+	.bit_depth = 16,
+	.sp = AVTP_AAF_PCM_SP_NORMAL,
+};
 
-	/* If this was the first entry inserted onto the queue, we need to arm
-	 * the timer.
-	 */
-	if (STAILQ_FIRST(&samples) == entry) {
-		int res;
+/* Header expected from PDUs of our stream. */
+static int pack_template(struct avtp_stream_pdu *pdu)
+{
+	struct avtp_aaf_hdr hdr = aaf_hdr;
 
-		res = arm_timer(fd, tspec);
-		if (res < 0) {
-			STAILQ_REMOVE(&samples, entry, sample_entry, entries);
-			free(entry);
-			return -1;
-		}
-	}
+	if (sparse)
+		hdr.sp = AVTP_AAF_PCM_SP_SPARSE;
 
-	return 0;
+	return avtp_aaf_pdu_pack(pdu, &hdr) < 0 ? -1 : 0;
 }
 
-static bool is_valid_packet(struct avtp_stream_pdu *pdu)
+/* Register our stream with the classifier. Every field which is fixed for the
+ * stream is set in 'mask' so the classifier checks it for each PDU received.
+ */
+static int init_classifier(void)
 {
-	struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-	uint64_t val64;
-	uint32_t val32;
+	struct avtp_stream_pdu expected, mask;
 	int res;
 
-	res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get subtype field: %d\n", res);
-		return false;
-	}
-	if (val32 != AVTP_SUBTYPE_AAF) {
-		fprintf(stderr, "Subtype mismatch: expected %u, got %u\n",
-						AVTP_SUBTYPE_AAF, val32);
-		return false;
-	}
+	res = pack_template(&expected);
+	if (res < 0)
+		return -1;
 
-	res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
+	memset(&mask, 0, sizeof(mask));
+	avtp_common_set_subtype((struct avtp_common_pdu *) &mask, 0xFF);
+	avtp_common_set_version((struct avtp_common_pdu *) &mask, 0x7);
+	avtp_stream_set_sv(&mask, 1);
+	/* In sparse timestamp mode, 'tv' is only set on some PDUs. */
+	if (!sparse)
+		avtp_stream_set_tv(&mask, 1);
+	avtp_stream_set_stream_data_len(&mask, 0xFFFF);
+	avtp_aaf_set_format(&mask, 0xFF);
+	avtp_aaf_set_nsr(&mask, 0xF);
+	avtp_aaf_set_chan_per_frame(&mask, 0x3FF);
+	avtp_aaf_set_bit_depth(&mask, 0xFF);
+	avtp_aaf_set_sp(&mask, 1);
+
+	res = avtp_classifier_create(&classifier, 1);
 	if (res < 0) {
-		fprintf(stderr, "Failed to get version field: %d\n", res);
-		return false;
-	}
-	if (val32 != 0) {
-		fprintf(stderr, "Version mismatch: expected %u, got %u\n",
-								0, val32);
-		return false;
+		fprintf(stderr, "Failed to create classifier: %d\n", res);
+		return -1;
 	}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TV, &val64);
+	res = avtp_classifier_add(classifier, &expected, &mask);
 	if (res < 0) {
-		fprintf(stderr, "Failed to get tv field: %d\n", res);
-		return false;
-	}
-	if (val64 != 1) {
-		fprintf(stderr, "tv mismatch: expected %u, got %" PRIu64 "\n",
-								1, val64);
-		return false;
+		fprintf(stderr, "Failed to register stream: %d\n", res);
+		avtp_classifier_destroy(classifier);
+		return -1;
 	}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SP, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get sp field: %d\n", res);
-		return false;
-	}
-	if (val64 != AVTP_AAF_PCM_SP_NORMAL) {
-		fprintf(stderr, "sp mismatch: expected %u, got %" PRIu64 "\n",
-						AVTP_AAF_PCM_SP_NORMAL, val64);
-		return false;
-	}
+	return 0;
+}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_ID, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get stream ID field: %d\n", res);
+static bool is_valid_packet(const struct avtp_classifier_result *result)
+{
+	switch (result->verdict) {
+	case AVTP_CLASSIFIER_PASS:
+		return true;
+	case AVTP_CLASSIFIER_SEQ_GAP:
+		/* A sequence number mismatch doesn't invalidate the packet.
+		 * Lost packets are accounted by the stream statistics.
+		 */
+		return true;
+	case AVTP_CLASSIFIER_SEQ_OLD:
+		/* Duplicate or reordered packets are placed by the jitter
+		 * buffer from their presentation time.
+		 */
+		return true;
+	case AVTP_CLASSIFIER_UNKNOWN:
+		fprintf(stderr, "Stream ID mismatch\n");
 		return false;
-	}
-	if (val64 != STREAM_ID) {
-		fprintf(stderr, "Stream ID mismatch: expected %" PRIu64 ", got %" PRIu64 "\n",
-							STREAM_ID, val64);
+	default:
+		fprintf(stderr, "Header mismatch\n");
 		return false;
 	}
+}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SEQ_NUM, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get sequence num field: %d\n", res);
-		return false;
-	}
+static int new_packet(const struct avtp_stream_pdu *pdu, uint64_t ptime,
+								int timer_fd)
+{
+	int res;
+	int16_t samples[NUM_CHANNELS];
 
-	if (val64 != expected_seq) {
-		/* If we have a sequence number mismatch, we simply log the
-		 * issue and continue to process the packet. We don't want to
-		 * invalidate it since it is a valid packet after all.
-		 */
-		fprintf(stderr, "Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-							expected_seq, val64);
-		expected_seq = val64;
-	}
+	/* Samples are presented to stdout in host byte order. */
+	res = avtp_aaf_pcm_decode(&aaf_hdr, pdu->avtp_payload, samples,
+						AVTP_AAF_PCM_SAMPLE_S16, 1);
+	if (res < 0)
+		return -1;
 
-	expected_seq++;
+	/* Late samples and samples not fitting in the jitter buffer are
+	 * accounted by the jitter buffer itself.
+	 */
+	res = avtp_jbuf_put(jbuf, ptime, avtp_stream_get_seq_num(pdu),
+								samples, 1);
+	if (res < 0)
+		return -1;
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_FORMAT, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get format field: %d\n", res);
-		return false;
-	}
-	if (val64 != AVTP_AAF_FORMAT_INT_16BIT) {
-		fprintf(stderr, "Format mismatch: expected %u, got %" PRIu64 "\n",
-					AVTP_AAF_FORMAT_INT_16BIT, val64);
-		return false;
-	}
+	/* Playout starts once the first block can be placed. */
+	if (!playout_scheduled)
+		return schedule_block(timer_fd);
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_NSR, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get sample rate field: %d\n", res);
-		return false;
-	}
-	if (val64 != AVTP_AAF_PCM_NSR_48KHZ) {
-		fprintf(stderr, "Sample rate mismatch: expected %u, got %" PRIu64 "\n",
-						AVTP_AAF_PCM_NSR_48KHZ, val64);
-		return false;
-	}
-
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_CHAN_PER_FRAME, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get channels field: %d\n", res);
-		return false;
-	}
-	if (val64 != NUM_CHANNELS) {
-		fprintf(stderr, "Channels mismatch: expected %u, got %" PRIu64 "\n",
-							NUM_CHANNELS, val64);
-		return false;
-	}
+	return 0;
+}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_BIT_DEPTH, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get depth field: %d\n", res);
-		return false;
-	}
-	if (val64 != 16) {
-		fprintf(stderr, "Depth mismatch: expected %u, got %" PRIu64 "\n",
-								16, val64);
-		return false;
-	}
+static void report_jbuf_stats(void)
+{
+	struct avtp_jbuf_stats jstats;
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_STREAM_DATA_LEN, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get data_len field: %d\n", res);
-		return false;
-	}
-	if (val64 != DATA_LEN) {
-		fprintf(stderr, "Data len mismatch: expected %u, got %" PRIu64 "\n",
-							DATA_LEN, val64);
-		return false;
-	}
+	if (avtp_jbuf_get_stats(jbuf, &jstats) < 0)
+		return;
 
-	return true;
+	fprintf(stderr, "AAF: delay %" PRIu64 " us played %" PRIu64
+			" concealed %" PRIu64 " late %" PRIu64
+			" overflows %" PRIu64 "\n", jstats.delay / 1000,
+			jstats.played, jstats.concealed, jstats.late,
+			jstats.overflows);
 }
 
-static int new_packet(int sk_fd, int timer_fd)
+/* Process every PDU the kernel has handed over to the RX ring. PDUs are
+ * accessed directly in the ring and classified in batches.
+ */
+static int new_packets(int timer_fd)
 {
-	int res;
-	ssize_t n;
-	uint64_t avtp_time;
+	const struct avtp_stream_pdu *pdus[BATCH_SIZE];
+	struct avtp_classifier_result results[BATCH_SIZE];
+	size_t lens[BATCH_SIZE];
+	uint64_t times[BATCH_SIZE];
 	struct timespec tspec;
-	struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
+	uint64_t now, ptime;
+	int i, n, res;
 
-	memset(pdu, 0, PDU_SIZE);
-
-	n = recv(sk_fd, pdu, PDU_SIZE, 0);
-	if (n < 0 || n != PDU_SIZE) {
-		perror("Failed to receive data");
+	/* The clock is read once per wakeup, only for PDUs which couldn't be
+	 * timestamped on arrival and for reporting stats.
+	 */
+	res = clock_gettime(CLOCK_REALTIME, &tspec);
+	if (res < 0) {
+		perror("Failed to get time");
 		return -1;
 	}
+	now = tspec.tv_sec * NSEC_PER_SEC + tspec.tv_nsec;
 
-	if (!is_valid_packet(pdu)) {
-		fprintf(stderr, "Dropping packet\n");
-		return 0;
+	while ((n = avtp_net_rx_classify_ts(rx, classifier, pdus, lens, times,
+						results, BATCH_SIZE)) > 0) {
+		/* Hardware timestamps are taken from the PHC, which runs on
+		 * TAI, while the system clock is used everywhere else.
+		 */
+		for (i = 0; i < n; i++) {
+			if (!times[i])
+				times[i] = now;
+			else if (hw_tstamp)
+				times[i] -= tai_offset;
+		}
+
+		/* Packets are recorded as they were received, valid or not.
+		 * PDUs the capture can't keep up with are just dropped.
+		 */
+		if (capture)
+			avtp_net_capture_write(capture, pdus, lens, times, n);
+
+		for (i = 0; i < n; i++) {
+			if (!is_valid_packet(&results[i])) {
+				fprintf(stderr, "Dropping packet\n");
+				continue;
+			}
+
+			/* The presentation time is the closest one to the
+			 * arrival time, so no clock needs to be read for each
+			 * PDU.
+			 */
+			res = avtp_stream_ctx_receive(&stream_ctx, pdus[i],
+							times[i], &ptime);
+			if (res == AVTP_STATS_SEQ_DUPLICATE)
+				continue;
+
+			/* Sparse streams can't tell when samples following a
+			 * lost PDU are due until the next timestamp, so the
+			 * jitter buffer places them by sequence number.
+			 */
+			res = new_packet(pdus[i], ptime, timer_fd);
+			if (res < 0)
+				return -1;
+		}
 	}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TIMESTAMP, &avtp_time);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get AVTP time from PDU\n");
+	if (n < 0) {
+		fprintf(stderr, "Failed to receive packets: %d\n", n);
 		return -1;
 	}
 
-	res = get_presentation_time(avtp_time, &tspec);
-	if (res < 0)
-		return -1;
+	if (now - last_report >= NSEC_PER_SEC) {
+		report_stats("AAF", stats);
+		report_jbuf_stats();
+		last_report = now;
 
-	res = schedule_sample(timer_fd, &tspec, pdu->avtp_payload);
-	if (res < 0)
-		return -1;
+		/* Blocks due earlier are played out along with the next
+		 * one, and blocks due later are scheduled again once the
+		 * next one is dispatched.
+		 */
+		if (avtp_jbuf_adapt(jbuf, stats) < 0)
+			return -1;
+	}
 
 	return 0;
 }
@@ -336,59 +465,132 @@ static int new_packet(int sk_fd, int timer_fd)
 static int timeout(int fd)
 {
 	int res;
-	ssize_t n;
-	uint64_t expirations;
-	struct sample_entry *entry;
 
-	n = read(fd, &expirations, sizeof(uint64_t));
-	if (n < 0) {
-		perror("Failed to read timerfd");
+	res = dispatch_payloads(sched, fd);
+	if (res < 0 || present_failed)
 		return -1;
-	}
-
-	assert(expirations == 1);
-
-	entry = STAILQ_FIRST(&samples);
-	assert(entry != NULL);
-
-	res = present_data(entry->pcm_sample, DATA_LEN);
-	if (res < 0)
-		return -1;
-
-	STAILQ_REMOVE_HEAD(&samples, entries);
-	free(entry);
-
-	if (!STAILQ_EMPTY(&samples)) {
-		entry = STAILQ_FIRST(&samples);
-
-		res = arm_timer(fd, &entry->tspec);
-		if (res < 0)
-			return -1;
-	}
 
 	return 0;
 }
 
 int main(int argc, char *argv[])
 {
-	int sk_fd, timer_fd, res;
+	int timer_fd, res;
 	struct pollfd fds[2];
+	struct avtp_stream_pdu tmpl;
+	struct avtp_net_rx_config cfg = {
+		.ifname = ifname,
+		.protocol = ETH_P_TSN,
+		/* Hand blocks over every millisecond at least so samples are
+		 * not held back in the ring.
+		 */
+		.block_timeout = 1,
+	};
+	struct avtp_jbuf_config jbuf_cfg = {
+		.frame_size = DATA_LEN,
+		.block_frames = BLOCK_SAMPLES,
+		.blocks = JBUF_BLOCKS,
+		.sample_rate = SAMPLE_RATE,
+		.max_delay = MAX_DELAY,
+	};
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	STAILQ_INIT(&samples);
+	jbuf_cfg.conceal = conceal;
+	cfg.tstamp = hw_tstamp ? AVTP_NET_TSTAMP_HARDWARE :
+						AVTP_NET_TSTAMP_SOFTWARE;
+	if (hw_tstamp && get_tai_offset(&tai_offset) < 0)
+		return 1;
 
-	sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
-	if (sk_fd < 0)
+	res = pack_template(&tmpl);
+	if (res < 0)
 		return 1;
 
+	res = avtp_stream_ctx_init(&stream_ctx, &tmpl, SAMPLE_RATE);
+	if (res < 0)
+		return 1;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create RX ring: %d\n", res);
+		return 1;
+	}
+
+	res = avtp_net_rx_add_membership(rx, macaddr);
+	if (res < 0) {
+		fprintf(stderr, "Failed to add membership: %d\n", res);
+		avtp_net_rx_destroy(rx);
+		return 1;
+	}
+
+	if (capture_path) {
+		struct avtp_net_capture_config cap_cfg = {
+			.path = capture_path,
+			.protocol = ETH_P_TSN,
+		};
+
+		memcpy(cap_cfg.dst_addr, macaddr, ETH_ALEN);
+
+		res = avtp_net_capture_create(&capture, &cap_cfg);
+		if (res < 0) {
+			fprintf(stderr, "Failed to create capture: %d\n", res);
+			avtp_net_rx_destroy(rx);
+			return 1;
+		}
+	}
+
 	timer_fd = timerfd_create(CLOCK_REALTIME, 0);
 	if (timer_fd < 0) {
-		close(sk_fd);
+		avtp_net_capture_destroy(capture);
+		avtp_net_rx_destroy(rx);
+		return 1;
+	}
+
+	res = init_classifier();
+	if (res < 0) {
+		avtp_net_capture_destroy(capture);
+		avtp_net_rx_destroy(rx);
+		close(timer_fd);
+		return 1;
+	}
+
+	res = avtp_stats_create(&stats, MAX_TRANSIT_TIME);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create stats: %d\n", res);
+		avtp_classifier_destroy(classifier);
+		avtp_net_capture_destroy(capture);
+		avtp_net_rx_destroy(rx);
+		close(timer_fd);
+		return 1;
+	}
+
+	stream_ctx.stats = stats;
+
+	res = avtp_jbuf_create(&jbuf, &jbuf_cfg);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create jitter buffer: %d\n", res);
+		avtp_stats_destroy(stats);
+		avtp_classifier_destroy(classifier);
+		avtp_net_capture_destroy(capture);
+		avtp_net_rx_destroy(rx);
+		close(timer_fd);
+		return 1;
+	}
+
+	/* The scheduler only holds the next block from the jitter buffer. */
+	res = avtp_sched_create(&sched, 1, present_samples, NULL);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create scheduler: %d\n", res);
+		avtp_jbuf_destroy(jbuf);
+		avtp_stats_destroy(stats);
+		avtp_classifier_destroy(classifier);
+		avtp_net_capture_destroy(capture);
+		avtp_net_rx_destroy(rx);
+		close(timer_fd);
 		return 1;
 	}
 
-	fds[0].fd = sk_fd;
+	fds[0].fd = avtp_net_rx_get_fd(rx);
 	fds[0].events = POLLIN;
 	fds[1].fd = timer_fd;
 	fds[1].events = POLLIN;
@@ -401,7 +603,7 @@ int main(int argc, char *argv[])
 		}
 
 		if (fds[0].revents & POLLIN) {
-			res = new_packet(sk_fd, timer_fd);
+			res = new_packets(timer_fd);
 			if (res < 0)
 				goto err;
 		}
@@ -416,7 +618,12 @@ int main(int argc, char *argv[])
 	return 0;
 
 err:
-	close(sk_fd);
+	avtp_sched_destroy(sched);
+	avtp_jbuf_destroy(jbuf);
+	avtp_stats_destroy(stats);
+	avtp_classifier_destroy(classifier);
+	avtp_net_capture_destroy(capture);
+	avtp_net_rx_destroy(rx);
 	close(timer_fd);
 	return 1;
 }
@@ -42,10 +42,18 @@
  *
  * In order to have this example working properly, make sure you have
  * configured FQTSS feature from your NIC according (for further information
- * see tc-cbs(8)). Also, this example relies on system clock to set the AVTP
- * timestamp so make sure it is synchronized with the PTP Hardware Clock (PHC)
- * from your NIC and that the PHC is synchronized with the network clock. For
- * further information see ptp4l(8) and phc2sys(8).
+ * see tc-cbs(8)) and the ETF qdisc, with CLOCK_TAI, on the traffic class the
+ * stream is transmitted (see tc-etf(8)). PDUs are transmitted in batches, one
+ * batch per window of PCM frames read from stdin, and carry launch times so the
+ * ETF qdisc paces them. Also, this example relies on system clock to set the
+ * AVTP timestamp so make sure it is synchronized with the PTP Hardware Clock
+ * (PHC) from your NIC and that the PHC is synchronized with the network clock.
+ * For further information see ptp4l(8) and phc2sys(8).
+ *
+ * PCM frames read from stdin are split into PDUs by the AAF aggregator, so the
+ * clock is read and the presentation time is computed only once per window.
+ * With the '--sparse' option, the stream is transmitted in sparse timestamp
+ * mode, where only one out of every 8 PDUs carries a timestamp.
  *
  * The easiest way to use this example is combining it with 'arecord' tool
  * provided by alsa-utils. 'arecord' reads the PCM stream from a capture ALSA
@@ -60,12 +68,16 @@
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "avtp.h"
 #include "avtp_aaf.h"
+#include "avtp_net.h"
+#include "avtp_stream_ctx.h"
 #include "examples/common.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -75,17 +87,26 @@
 #define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
 #define NSEC_PER_SEC		1000000000ULL
 #define NSEC_PER_MSEC		1000000ULL
+#define SAMPLE_RATE		48000
+/* Frames read from stdin and transmitted at once. One frame is sent per PDU
+ * so a 1 ms window holds 48 PDUs.
+ */
+#define FRAMES_PER_WINDOW	48
+/* How far in the future the first PDU from a window is launched. */
+#define TX_LEAD_TIME		(2 * NSEC_PER_MSEC)
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
-static int priority = -1;
+static int priority;
 static int max_transit_time;
+static bool sparse;
 
 static struct argp_option options[] = {
 	{"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
 	{"ifname", 'i', "IFNAME", 0, "Network Interface" },
 	{"max-transit-time", 'm', "MSEC", 0, "Maximum Transit Time in ms" },
 	{"prio", 'p', "NUM", 0, "SO_PRIORITY to be set in socket" },
+	{"sparse", 's', 0, 0, "Transmit in sparse timestamp mode" },
 	{ 0 }
 };
 
@@ -113,6 +134,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 	case 'p':
 		priority = atoi(arg);
 		break;
+	case 's':
+		sparse = true;
+		break;
 	}
 
 	return 0;
@@ -120,120 +144,159 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser };
 
-static int init_pdu(struct avtp_stream_pdu *pdu)
+/* Stream format shared by header packing and PCM sample encoding. */
+static const struct avtp_aaf_hdr aaf_hdr = {
+	.stream = {
+		.sv = 1,
+		.tv = 1,
+		.stream_id = STREAM_ID,
+		.stream_data_len = DATA_LEN,
+	},
+	.format = AVTP_AAF_FORMAT_INT_16BIT,
+	.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+	.chan_per_frame = NUM_CHANNELS,
+	.bit_depth = 16,
+	.sp = AVTP_AAF_PCM_SP_NORMAL,
+};
+
+/* Build the stream context which is used to emit every AAF PDU sent by this
+ * talker. Only sequence number and timestamp change from PDU to PDU so all
+ * other fields are packed at once into its header template here.
+ */
+static int init_stream_ctx(struct avtp_stream_ctx *ctx)
 {
+	struct avtp_aaf_hdr hdr = aaf_hdr;
+	struct avtp_stream_pdu tmpl;
 	int res;
 
-	res = avtp_aaf_pdu_init(pdu);
-	if (res < 0)
-		return -1;
-
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_TV, 1);
-	if (res < 0)
-		return -1;
+	if (sparse)
+		hdr.sp = AVTP_AAF_PCM_SP_SPARSE;
 
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_STREAM_ID, STREAM_ID);
+	res = avtp_aaf_pdu_pack(&tmpl, &hdr);
 	if (res < 0)
 		return -1;
 
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_FORMAT,
-						AVTP_AAF_FORMAT_INT_16BIT);
-	if (res < 0)
-		return -1;
-
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_NSR,
-						AVTP_AAF_PCM_NSR_48KHZ);
-	if (res < 0)
-		return -1;
-
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_CHAN_PER_FRAME,
-								NUM_CHANNELS);
-	if (res < 0)
-		return -1;
-
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_BIT_DEPTH, 16);
-	if (res < 0)
-		return -1;
-
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_STREAM_DATA_LEN, DATA_LEN);
-	if (res < 0)
-		return -1;
-
-	res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_SP, AVTP_AAF_PCM_SP_NORMAL);
-	if (res < 0)
-		return -1;
-
-	return 0;
+	return avtp_stream_ctx_init(ctx, &tmpl, SAMPLE_RATE) < 0 ? -1 : 0;
 }
 
 int main(int argc, char *argv[])
 {
-	int fd, res;
-	struct sockaddr_ll sk_addr;
-	struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
-	uint8_t seq_num = 0;
+	int res;
+	struct avtp_net_tx *tx;
+	struct avtp_stream_ctx ctx;
+	struct avtp_aaf_aggregator agg;
+	int64_t tai_offset;
+	struct avtp_net_tx_config cfg = {
+		.ifname = ifname,
+		.protocol = ETH_P_TSN,
+		.txtime = true,
+		.clockid = CLOCK_TAI,
+		.queue_size = FRAMES_PER_WINDOW,
+		.max_pdu_size = PDU_SIZE,
+	};
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	fd = create_talker_socket(priority);
-	if (fd < 0)
+	cfg.priority = priority;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create TX queue: %d\n", res);
 		return 1;
+	}
+
+	res = init_stream_ctx(&ctx);
+	if (res < 0)
+		goto err;
 
-	res = setup_socket_address(fd, ifname, macaddr, ETH_P_TSN, &sk_addr);
+	res = avtp_aaf_aggregator_init(&agg, &ctx, AVTP_AAF_PCM_SAMPLE_S16);
 	if (res < 0)
 		goto err;
 
-	res = init_pdu(pdu);
+	res = get_tai_offset(&tai_offset);
 	if (res < 0)
 		goto err;
 
 	while (1) {
 		ssize_t n;
-		uint32_t avtp_time;
+		int i, frames;
+		struct timespec now;
+		uint64_t tx_time;
+		int16_t samples[FRAMES_PER_WINDOW][NUM_CHANNELS];
 
-		memset(pdu->avtp_payload, 0, DATA_LEN);
-
-		n = read(STDIN_FILENO, pdu->avtp_payload, DATA_LEN);
-		if (n == 0)
+		n = read(STDIN_FILENO, samples, sizeof(samples));
+		if (n <= 0)
 			break;
 
-		if (n != DATA_LEN) {
-			fprintf(stderr, "read %zd bytes, expected %d\n",
-								n, DATA_LEN);
+		frames = n / DATA_LEN;
+		if (n % DATA_LEN) {
+			fprintf(stderr, "read %zd bytes, expected multiple of "
+							"%d\n", n, DATA_LEN);
 		}
 
-		res = calculate_avtp_time(&avtp_time, max_transit_time);
+		res = clock_gettime(CLOCK_REALTIME, &now);
 		if (res < 0) {
-			fprintf(stderr, "Failed to calculate avtp time\n");
+			perror("Failed to get time");
 			goto err;
 		}
 
-		res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_TIMESTAMP,
-								avtp_time);
-		if (res < 0)
-			goto err;
+		tx_time = now.tv_sec * NSEC_PER_SEC + now.tv_nsec +
+							TX_LEAD_TIME;
 
-		res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_SEQ_NUM, seq_num++);
+		/* The clock is read once per window. Within the window, the
+		 * stream context advances the AVTP timestamp by one sample
+		 * period per PDU, matching the launch time spacing.
+		 */
+		avtp_stream_ctx_set_time(&ctx, calculate_avtp_time_at(tx_time,
+							max_transit_time));
+
+		/* Samples are read in host byte order from stdin and the
+		 * aggregator encodes them in network byte order.
+		 */
+		res = avtp_aaf_aggregator_start(&agg, samples, frames);
 		if (res < 0)
 			goto err;
 
-		n = sendto(fd, pdu, PDU_SIZE, 0,
-				(struct sockaddr *) &sk_addr, sizeof(sk_addr));
-		if (n < 0) {
-			perror("Failed to send data");
-			goto err;
+		/* Queue one PDU per frame from the window, spaced by the
+		 * sample period. Launch times are handed to the ETF qdisc so
+		 * it paces the transmission.
+		 */
+		for (i = 0; ; i++) {
+			struct avtp_stream_pdu *pdu;
+			uint64_t launch_time;
+
+			launch_time = tx_time + i * NSEC_PER_SEC / SAMPLE_RATE;
+
+			res = avtp_net_tx_reserve(tx, (void **) &pdu);
+			if (res < 0)
+				goto err;
+
+			res = avtp_aaf_aggregator_next(&agg, pdu);
+			if (res < 0)
+				goto err;
+			if (res == 0)
+				break;
+
+			res = avtp_net_tx_commit(tx, macaddr, PDU_SIZE,
+						launch_time + tai_offset);
+			if (res < 0)
+				goto err;
 		}
 
-		if (n != PDU_SIZE) {
-			fprintf(stderr, "wrote %zd bytes, expected %zd\n",
-								n, PDU_SIZE);
+		while (avtp_net_tx_get_pending(tx) > 0) {
+			res = avtp_net_tx_flush(tx);
+			if (res < 0) {
+				fprintf(stderr, "Failed to send data: %d\n",
+									res);
+				goto err;
+			}
 		}
 	}
 
-	close(fd);
+	avtp_net_tx_destroy(tx);
 	return 0;
 
 err:
-	close(fd);
+	avtp_net_tx_destroy(tx);
 	return 1;
 }
@@ -26,6 +26,7 @@
  */
 
 #include <arpa/inet.h>
+#include <inttypes.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
@@ -38,56 +39,105 @@
 #include <time.h>
 #include <unistd.h>
 
+#include "avtp_clock.h"
 #include "examples/common.h"
 
 #define NSEC_PER_SEC		1000000000ULL
 #define NSEC_PER_MSEC		1000000ULL
+#define RESYNC_INTERVAL		(100 * NSEC_PER_MSEC)
+
+/* Examples rely on CLOCK_REALTIME being synchronized with PTP time, so it is
+ * the reference clock presentation times are computed from. It is only read
+ * once every RESYNC_INTERVAL and extrapolated in between.
+ */
+static struct avtp_clock *get_clock(void)
+{
+	static struct avtp_clock *clk;
+	int res;
+
+	if (clk)
+		return clk;
+
+	res = avtp_clock_create(&clk, CLOCK_REALTIME, RESYNC_INTERVAL);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create clock: %d\n", res);
+		return NULL;
+	}
+
+	return clk;
+}
 
 int calculate_avtp_time(uint32_t *avtp_time, uint32_t max_transit_time)
 {
 	int res;
-	struct timespec tspec;
 	uint64_t ptime;
+	struct avtp_clock *clk = get_clock();
 
-	res = clock_gettime(CLOCK_REALTIME, &tspec);
+	if (!clk)
+		return -1;
+
+	res = avtp_clock_now(clk, &ptime);
 	if (res < 0) {
-		perror("Failed to get time");
+		fprintf(stderr, "Failed to get time: %d\n", res);
 		return -1;
 	}
 
-	ptime = (tspec.tv_sec * NSEC_PER_SEC) +
-			(max_transit_time * NSEC_PER_MSEC) + tspec.tv_nsec;
+	*avtp_time = calculate_avtp_time_at(ptime, max_transit_time);
 
-	*avtp_time = ptime % (1ULL << 32);
+	return 0;
+}
 
+uint32_t calculate_avtp_time_at(uint64_t tx_time, uint32_t max_transit_time)
+{
+	uint64_t ptime;
+
+	ptime = tx_time + (max_transit_time * NSEC_PER_MSEC);
+
+	return ptime % (1ULL << 32);
+}
+
+int get_tai_offset(int64_t *offset)
+{
+	int res;
+	struct timespec real, tai;
+
+	res = clock_gettime(CLOCK_REALTIME, &real);
+	if (res < 0)
+		goto err;
+
+	res = clock_gettime(CLOCK_TAI, &tai);
+	if (res < 0)
+		goto err;
+
+	*offset = (int64_t) (tai.tv_sec - real.tv_sec) * NSEC_PER_SEC +
+						(tai.tv_nsec - real.tv_nsec);
 	return 0;
+
+err:
+	perror("Failed to get time");
+	return -1;
 }
 
 int get_presentation_time(uint64_t avtp_time, struct timespec *tspec)
 {
 	int res;
-	uint64_t ptime, now;
+	uint64_t ptime;
+	uint32_t ts = avtp_time;
+	struct avtp_clock *clk = get_clock();
 
-	res = clock_gettime(CLOCK_REALTIME, tspec);
-	if (res < 0) {
-		perror("Failed to get time from PHC");
+	if (!clk)
 		return -1;
-	}
-
-	now = (tspec->tv_sec * NSEC_PER_SEC) + tspec->tv_nsec;
 
 	/* The avtp_timestamp within AAF packet is the lower part (32
 	 * less-significant bits) from presentation time calculated by the
-	 * talker.
-	 */
-	ptime = (now & 0xFFFFFFFF00000000ULL) | avtp_time;
-
-	/* If 'ptime' is less than the 'now', it means the higher part
-	 * from 'ptime' needs to be incremented by 1 in order to recover the
-	 * presentation time set by the talker.
+	 * talker. The full time is the closest one to the current time, so
+	 * both late and early packets are handled.
 	 */
-	if (ptime < now)
-		ptime += (1ULL << 32);
+	res = avtp_clock_unwrap_burst(clk, &ts, &ptime, 1);
+	if (res < 0) {
+		fprintf(stderr, "Failed to get time: %d\n", res);
+		return -1;
+	}
 
 	tspec->tv_sec = ptime / NSEC_PER_SEC;
 	tspec->tv_nsec = ptime % NSEC_PER_SEC;
@@ -214,3 +264,94 @@ int present_data(uint8_t *data, size_t len)
 
 	return 0;
 }
+
+int schedule_payload(struct avtp_sched *sched, int fd, struct timespec *tspec,
+								void *payload)
+{
+	int res;
+
+	res = avtp_sched_add(sched, tspec->tv_sec * NSEC_PER_SEC +
+						tspec->tv_nsec, payload);
+	if (res < 0) {
+		fprintf(stderr, "Failed to schedule payload: %d\n", res);
+		return -1;
+	}
+
+	if (res == 1)
+		return arm_timer(fd, tspec);
+
+	return 0;
+}
+
+int dispatch_payloads(struct avtp_sched *sched, int fd)
+{
+	int res;
+	ssize_t n;
+	uint64_t expirations, now, next;
+	struct timespec tspec;
+
+	n = read(fd, &expirations, sizeof(uint64_t));
+	if (n < 0) {
+		perror("Failed to read timerfd");
+		return -1;
+	}
+
+	res = clock_gettime(CLOCK_REALTIME, &tspec);
+	if (res < 0) {
+		perror("Failed to get time");
+		return -1;
+	}
+
+	now = tspec.tv_sec * NSEC_PER_SEC + tspec.tv_nsec;
+
+	avtp_sched_dispatch(sched, now, &next);
+	if (next == UINT64_MAX)
+		return 0;
+
+	tspec.tv_sec = next / NSEC_PER_SEC;
+	tspec.tv_nsec = next % NSEC_PER_SEC;
+
+	return arm_timer(fd, &tspec);
+}
+
+/* Return upper bound, in nanoseconds, of the histogram bucket where the
+ * informed percentile of the PDUs falls into.
+ */
+static uint64_t latency_percentile(const struct avtp_stats_snapshot *snap,
+							int percentile)
+{
+	int i;
+	uint64_t total = 0, count = 0, target;
+
+	for (i = 0; i < AVTP_STATS_LATENCY_BUCKETS; i++)
+		total += snap->latency[i];
+
+	if (total == 0)
+		return 0;
+
+	target = (total * percentile + 99) / 100;
+	for (i = 0; i < AVTP_STATS_LATENCY_BUCKETS; i++) {
+		count += snap->latency[i];
+		if (count >= target)
+			break;
+	}
+
+	return 1ULL << i;
+}
+
+void report_stats(const char *name, const struct avtp_stats *stats)
+{
+	struct avtp_stats_snapshot snap;
+
+	if (avtp_stats_read(stats, &snap) < 0)
+		return;
+
+	fprintf(stderr, "%s: received %" PRIu64 " lost %" PRIu64
+			" duplicated %" PRIu64 " reordered %" PRIu64
+			" late %" PRIu64 " early %" PRIu64
+			" latency p50 < %" PRIu64 " ns p99 < %" PRIu64 " ns\n",
+			name, snap.received, snap.lost, snap.duplicated,
+			snap.reordered, snap.late, snap.early,
+			latency_percentile(&snap, 50),
+			latency_percentile(&snap, 99));
+}
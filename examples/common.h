@@ -27,6 +27,9 @@
 
 #include <stdint.h>
 
+#include "avtp_sched.h"
+#include "avtp_stats.h"
+
 /* Calculate AVTP presentation time based on current time and informed
  * max_transit_time.
  * @avtp_time: Pointer to variable which the calculated time should be saved.
@@ -38,6 +41,27 @@
  */
 int calculate_avtp_time(uint32_t *avtp_time, uint32_t max_transit_time);
 
+/* Calculate AVTP presentation time of a PDU transmitted at informed time.
+ * @tx_time: Transmission time, in nanoseconds, on CLOCK_REALTIME.
+ * @max_transit_time: Max transit time for the network, in milliseconds.
+ *
+ * Returns:
+ *    AVTP presentation time.
+ */
+uint32_t calculate_avtp_time_at(uint64_t tx_time, uint32_t max_transit_time);
+
+/* Get the offset of CLOCK_TAI from CLOCK_REALTIME, so launch times on
+ * CLOCK_TAI, as required by the ETF qdisc, can be derived from times on
+ * CLOCK_REALTIME.
+ * @offset: Pointer to variable which the offset, in nanoseconds, should be
+ *          saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: If could not get current time.
+ */
+int get_tai_offset(int64_t *offset);
+
 /* Given an AVTP presentation time, retrieve correspondent time on
  * CLOCK_REALTIME.
  * @avtp_time: AVTP presentation time to be converted.
@@ -103,3 +127,36 @@ int present_data(uint8_t *data, size_t len);
  *    -1: Could not arm timer.
  */
 int arm_timer(int fd, struct timespec *tspec);
+
+/* Add a payload to a presentation scheduler driven by a timerfd. The timer is
+ * only re-armed if the payload is due before all others.
+ * @sched: Pointer to scheduler.
+ * @fd: File descriptor of the timer driving the scheduler.
+ * @tspec: Presentation time of the payload, on CLOCK_REALTIME.
+ * @payload: Payload to be scheduled.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not schedule payload or arm timer.
+ */
+int schedule_payload(struct avtp_sched *sched, int fd, struct timespec *tspec,
+								void *payload);
+
+/* Handle expiration of the timerfd driving a presentation scheduler: all
+ * payloads due are dispatched and the timer is re-armed for the next one.
+ * @sched: Pointer to scheduler.
+ * @fd: File descriptor of the timer driving the scheduler.
+ *
+ * Returns:
+ *    0: Success.
+ *    -1: Could not read timer or current time, or arm timer.
+ */
+int dispatch_payloads(struct avtp_sched *sched, int fd);
+
+/* Print a one-line summary of the statistics from a stream to stderr: packet
+ * counters plus the median and 99th percentile of the time left until
+ * presentation, as upper bounds of the latency histogram buckets.
+ * @name: Stream name, used as prefix of the summary.
+ * @stats: Pointer to stats object.
+ */
+void report_stats(const char *name, const struct avtp_stats *stats);
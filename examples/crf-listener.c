@@ -73,6 +73,15 @@
  *	$ tc qdisc replace dev $IFNAME parent $HANDLE_ID:1 cbs idleslope 5760 \
  *			sendslope -994240 hicredit 9 locredit -89 offload 1
  *
+ * In AAF talker mode, the AAF stream is scheduled by the libavtp-net transmit
+ * scheduler (see avtp_net_mux_create()), and the class A idleslope the stream
+ * reserves, in kbps, is printed so the cbs qdisc can be set up accordingly.
+ * Transmission windows where the stream exceeds its reservation are reported
+ * as overruns once per second.
+ *
+ * Lost, duplicated and late PDUs from both streams are accounted by stream
+ * statistics, which are reported to stderr once per second.
+ *
  * Finally, the AAF listener mode implemented by this example application is
  * limited and doesn't work with multiple AAF talkers.
  */
@@ -91,8 +100,8 @@
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/param.h>
-#include <sys/queue.h>
 #include <sys/timerfd.h>
+#include <time.h>
 #include <unistd.h>
 #include <math.h>
 #include <inttypes.h>
@@ -100,6 +109,9 @@
 #include "avtp.h"
 #include "avtp_crf.h"
 #include "avtp_aaf.h"
+#include "avtp_net.h"
+#include "avtp_stats.h"
+#include "avtp_stream_ctx.h"
 #include "examples/common.h"
 
 #define AAF_STREAM_ID		0xAABBCCDDEEFF0001
@@ -122,16 +134,12 @@
 #define TIME_PERIOD_NS		((double)NSEC_PER_SEC / CRF_SAMPLE_RATE)
 #define AAF_PERIOD		(NSEC_PER_SEC * AAF_NUM_SAMPLES / AAF_SAMPLE_RATE)
 #define MCLK_PERIOD		AAF_PERIOD
-#define MCLKLIST_TS_PER_CRF	(CRF_SAMPLE_RATE / CRF_TIMESTAMPS_PER_SEC)
+/* CRF timestamps the media clock is recovered from, 1 second worth. */
+#define MCLK_TIMESTAMPS		CRF_TIMESTAMPS_PER_SEC
 
 #define NSEC_PER_SEC		1000000000ULL
 #define NSEC_PER_MSEC		1000000ULL
 
-struct media_clock_entry {
-	STAILQ_ENTRY(media_clock_entry) mclk_entries;
-	uint64_t timestamp;
-};
-
 static enum {
 	MODE_TALKER,
 	MODE_LISTENER,
@@ -144,11 +152,16 @@ static int priority = -1;
 static int mtt;
 static bool prev_state;
 static bool first_aaf_pdu = true;
-static bool need_mclk_lookup = true;
-static uint8_t crf_seq_num;
-static uint8_t aaf_seq_num;
-static uint64_t prev_mclk_timestamp, rounded_mtt;
-static STAILQ_HEAD(timestamp_queue, media_clock_entry) mclk_timestamps;
+static uint64_t rounded_mtt;
+static struct avtp_crf_clock *mclk;
+static struct avtp_stats *crf_stats;
+/* Sequence number and stats from the AAF stream, transmitted or received. */
+static struct avtp_stream_ctx aaf_ctx;
+static uint64_t last_report;
+/* Transmit scheduler and AAF stream handle, AAF talker mode only. */
+static struct avtp_net_mux *mux;
+static int aaf_stream = -1;
+static uint64_t aaf_overruns;
 
 static struct argp_option options[] = {
 	{"crf-addr", 'c', "MACADDR", 0, "CRF Stream Destination MAC address" },
@@ -211,61 +224,6 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser };
 
-static uint64_t mclk_dequeue_ts(void)
-{
-	uint64_t mclk_timestamp;
-	struct media_clock_entry *mclk_entry;
-
-	mclk_entry = STAILQ_FIRST(&mclk_timestamps);
-	mclk_timestamp = mclk_entry->timestamp;
-	STAILQ_REMOVE_HEAD(&mclk_timestamps, mclk_entries);
-	free(mclk_entry);
-
-	return mclk_timestamp;
-}
-
-static int mclk_enqueue_ts(uint64_t ts)
-{
-	struct media_clock_entry *mclk_entry;
-
-	mclk_entry = malloc(sizeof(*mclk_entry));
-	if (!mclk_entry) {
-		fprintf(stderr, "Failed to allocate memory\n");
-		return -1;
-	}
-
-	mclk_entry->timestamp = ts;
-	STAILQ_INSERT_TAIL(&mclk_timestamps, mclk_entry, mclk_entries);
-
-	return 0;
-}
-
-static uint64_t get_next_mclk_timestamp(void)
-{
-	uint64_t mclk_timestamp;
-
-	if (STAILQ_EMPTY(&mclk_timestamps)) {
-		mclk_timestamp = prev_mclk_timestamp + MCLK_PERIOD;
-		need_mclk_lookup = true;
-	} else {
-		mclk_timestamp = mclk_dequeue_ts();
-	}
-
-	prev_mclk_timestamp = mclk_timestamp;
-
-	return mclk_timestamp;
-}
-
-static uint64_t mclk_lookup(uint32_t avtp_time)
-{
-	uint64_t mclk_timestamp = get_next_mclk_timestamp();
-
-	while (mclk_timestamp % (1ULL << 32) != avtp_time)
-		mclk_timestamp = get_next_mclk_timestamp();
-
-	return mclk_timestamp;
-}
-
 static bool is_valid_crf_pdu(struct avtp_crf_pdu *pdu)
 {
 	int res;
@@ -320,18 +278,12 @@ static bool is_valid_crf_pdu(struct avtp_crf_pdu *pdu)
 									res);
 		return false;
 	}
-	if (val64 != crf_seq_num) {
-		/* If we have a sequence number mismatch, we simply log the
-		 * issue and continue to process the packet. We don't want to
-		 * invalidate it since it is a valid packet after all.
-		 */
-		fprintf(stderr, "CRF: Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-							crf_seq_num, val64);
-
-		crf_seq_num = val64;
-	}
-
-	crf_seq_num++;
+	/* A sequence number mismatch doesn't invalidate the PDU, it is only
+	 * accounted by the stream statistics. Duplicated PDUs are dropped.
+	 */
+	res = avtp_stats_track_seq(crf_stats, val64);
+	if (res == AVTP_STATS_SEQ_DUPLICATE)
+		return false;
 
 	res = avtp_crf_pdu_get(pdu, AVTP_CRF_FIELD_TYPE, &val64);
 	if (res < 0) {
@@ -447,26 +399,6 @@ static bool is_valid_aaf_pdu(struct avtp_stream_pdu *pdu)
 		return false;
 	}
 
-	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_SEQ_NUM, &val64);
-	if (res < 0) {
-		fprintf(stderr, "AAF: Failed to get sequence num field: %d\n",
-									res);
-		return false;
-	}
-
-	if (val64 != aaf_seq_num) {
-		/* If we have a sequence number mismatch, we simply log the
-		 * issue and continue to process the packet. We don't want to
-		 * invalidate it since it is a valid packet after all.
-		 */
-		fprintf(stderr, "AAF Sequence number mismatch: expected %u, got %" PRIu64 "\n",
-							aaf_seq_num, val64);
-
-		aaf_seq_num = val64;
-	}
-
-	aaf_seq_num++;
-
 	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_FORMAT, &val64);
 	if (res < 0) {
 		fprintf(stderr, "AAF: Failed to get format field: %d\n", res);
@@ -576,14 +508,53 @@ static int init_aaf_pdu(struct avtp_stream_pdu *pdu)
 	return 0;
 }
 
-static int aaf_talker_tx_timeout(int fd_timer, int fd_sk,
-						const struct sockaddr_ll *addr,
-						struct avtp_stream_pdu *pdu)
+static int get_time(uint64_t *now)
+{
+	int res;
+	struct timespec tspec;
+
+	res = clock_gettime(CLOCK_REALTIME, &tspec);
+	if (res < 0) {
+		perror("Failed to get time");
+		return -1;
+	}
+
+	*now = tspec.tv_sec * NSEC_PER_SEC + tspec.tv_nsec;
+	return 0;
+}
+
+static int aaf_fill(void *buf, size_t size, uint64_t *launch_time, void *arg)
+{
+	int res;
+	uint64_t ts;
+	struct avtp_stream_pdu *pdu = buf;
+
+	/* Presentation time is the media clock sample nearest to when the PDU
+	 * is transmitted plus max transit time.
+	 */
+	res = avtp_crf_clock_lookup(mclk, *launch_time + rounded_mtt, &ts);
+	if (res < 0)
+		return res;
+
+	res = avtp_stream_ctx_set_time(&aaf_ctx, ts);
+	if (res < 0)
+		return res;
+
+	res = avtp_stream_ctx_emit(&aaf_ctx, pdu, AAF_NUM_SAMPLES);
+	if (res < 0)
+		return res;
+
+	memset(pdu->avtp_payload, 0, AAF_DATA_LEN);
+
+	*launch_time += AAF_PERIOD;
+	return AAF_PDU_SIZE;
+}
+
+static int aaf_talker_tx_timeout(int fd_timer)
 {
 	int res;
 	ssize_t n;
-	uint64_t expirations;
-	uint32_t avtp_time = 0;
+	uint64_t expirations, now;
 
 	n = read(fd_timer, &expirations, sizeof(uint64_t));
 	if (n < 0) {
@@ -591,74 +562,39 @@ static int aaf_talker_tx_timeout(int fd_timer, int fd_sk,
 		return -1;
 	}
 
-	while (expirations--) {
-		avtp_time = get_next_mclk_timestamp();
-
-		res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_TIMESTAMP,
-								avtp_time);
-		if (res < 0)
-			return res;
-
-		res = avtp_aaf_pdu_set(pdu, AVTP_AAF_FIELD_SEQ_NUM,
-								aaf_seq_num++);
-		if (res < 0)
-			return res;
+	res = get_time(&now);
+	if (res < 0)
+		return res;
 
-		n = sendto(fd_sk, pdu, AAF_PDU_SIZE, 0,
-					(struct sockaddr *) addr,
-					sizeof(*addr));
-		if (n < 0) {
-			perror("Failed to send data");
-			return -1;
-		}
-		if (n != AAF_PDU_SIZE) {
-			fprintf(stderr, "AAF: wrote %zd bytes, expected %zd\n",
-							n, AAF_PDU_SIZE);
-		}
+	/* The scheduler catches up with any missed expiration, sending every
+	 * PDU due by now.
+	 */
+	res = avtp_net_mux_run(mux, now);
+	if (res < 0) {
+		fprintf(stderr, "Failed to send AAF PDUs: %d\n", res);
+		return res;
 	}
 
 	return 0;
 }
 
-/* This routine generates media clock timestamps using timestamps from CRF
- * stream.
- */
-static int recover_mclk(struct avtp_crf_pdu *pdu)
+static void report_mux_stats(void)
 {
-	int res, idx;
-	uint64_t ts_mclk, ts_crf;
-
-	/* For simplicity's sake, we consider only the first timestamp from
-	 * CRF PDU to recover the media clock.
-	 */
-	ts_crf = be64toh(pdu->crf_data[0]);
-
-	for (idx = 0; idx < MCLKLIST_TS_PER_CRF; idx++) {
-		ts_mclk = ts_crf + (idx * MCLK_PERIOD);
+	int res;
+	struct avtp_net_mux_stats stats;
 
-		if (mode == MODE_TALKER) {
-			/* If we are operating in talker mode, the max transit
-			 * time is added to the recovered timestamp, rounding
-			 * it up to the nearest multiple fo the media clock.
-			 */
-			ts_mclk += rounded_mtt;
-		}
+	if (aaf_stream < 0)
+		return;
 
-		if (ts_mclk <= prev_mclk_timestamp)
-			/* If the recovered timestamp is less than the
-			 * timestamp from the last AAF pdu received, we discard
-			 * it. This situation happens when the CRF pdu is
-			 * received late and the media clock has already
-			 * freewheeled.
-			 */
-			continue;
+	res = avtp_net_mux_get_stats(mux, aaf_stream, &stats);
+	if (res < 0)
+		return;
 
-		res = mclk_enqueue_ts(ts_mclk);
-		if (res < 0)
-			return res;
+	if (stats.overruns != aaf_overruns) {
+		fprintf(stderr, "AAF: %" PRIu64 " reservation overruns\n",
+						stats.overruns - aaf_overruns);
+		aaf_overruns = stats.overruns;
 	}
-
-	return 0;
 }
 
 static int is_ts_aligned(uint32_t mclk_ts, uint32_t avtp_ts)
@@ -685,12 +621,45 @@ static int is_ts_aligned(uint32_t mclk_ts, uint32_t avtp_ts)
 	return true;
 }
 
-static int handle_crf_pdu(struct avtp_crf_pdu *pdu)
+static int handle_crf_pdu(struct avtp_crf_pdu *pdu, size_t len)
 {
+	int res;
+	uint64_t now;
+
 	if (!is_valid_crf_pdu(pdu))
 		return 0;
 
-	return recover_mclk(pdu);
+	res = get_time(&now);
+	if (res < 0)
+		return res;
+
+	/* CRF timestamps are presentation times as well, so the first one
+	 * tells how early the PDU arrived.
+	 */
+	avtp_stats_track_time(crf_stats, be64toh(pdu->crf_data[0]), now);
+
+	/* CRF PDUs are received in both modes, so statistics are reported from
+	 * here.
+	 */
+	if (now - last_report >= NSEC_PER_SEC) {
+		report_stats("CRF", crf_stats);
+		if (mode == MODE_LISTENER)
+			report_stats("AAF", aaf_ctx.stats);
+		else
+			report_mux_stats();
+		last_report = now;
+	}
+
+	/* Timestamps from the CRF stream are fed into the media clock, which
+	 * keeps track of its rate and phase.
+	 */
+	res = avtp_crf_clock_update(mclk, pdu, len);
+	if (res < 0) {
+		fprintf(stderr, "Failed to recover media clock: %d\n", res);
+		return res;
+	}
+
+	return 0;
 }
 
 static int handle_aaf_pdu(struct avtp_stream_pdu *pdu)
@@ -698,11 +667,20 @@ static int handle_aaf_pdu(struct avtp_stream_pdu *pdu)
 	int res;
 	bool state;
 	uint64_t val;
-	uint32_t avtp_time, mclk_time;
+	uint32_t avtp_time;
+	uint64_t mclk_time, now;
 
 	if (!is_valid_aaf_pdu(pdu))
 		return 0;
 
+	res = get_time(&now);
+	if (res < 0)
+		return res;
+
+	res = avtp_stream_ctx_receive(&aaf_ctx, pdu, now, NULL);
+	if (res == AVTP_STATS_SEQ_DUPLICATE)
+		return 0;
+
 	res = avtp_aaf_pdu_get(pdu, AVTP_AAF_FIELD_TIMESTAMP, &val);
 	if (res < 0) {
 		fprintf(stderr, "Failed to get AVTP time from PDU\n");
@@ -710,12 +688,12 @@ static int handle_aaf_pdu(struct avtp_stream_pdu *pdu)
 	}
 	avtp_time = val;
 
-	if (need_mclk_lookup) {
-		mclk_time = mclk_lookup(avtp_time);
-		need_mclk_lookup = false;
-	} else {
-		mclk_time = get_next_mclk_timestamp();
-	}
+	res = avtp_crf_clock_lookup(mclk, avtp_time, &mclk_time);
+	if (res == -EAGAIN)
+		/* No CRF PDU received yet, so nothing to be aligned with. */
+		return 0;
+	if (res < 0)
+		return res;
 
 	state = is_ts_aligned(mclk_time, avtp_time);
 	if (prev_state != state) {
@@ -751,19 +729,45 @@ static int aaf_talker_recv_pdu(int fd_sk, int fd_timer)
 	if (n != CRF_PDU_SIZE)
 		return 0;
 
-	res = handle_crf_pdu(pdu);
+	res = handle_crf_pdu(pdu, n);
 	if (res < 0)
 		return -1;
 
-	/* Arm the timer for the first time to start sending AAF stream. */
+	/* Arm the timer for the first time to start sending AAF stream, at
+	 * the first timestamp from the CRF stream.
+	 */
 	if (first_aaf_pdu) {
 		struct itimerspec itspec = { 0 };
-		uint64_t ts = mclk_dequeue_ts();
+		struct avtp_net_mux_stream_config cfg = {
+			.sr_class = AVTP_NET_MUX_CLASS_A,
+			.max_frame_size = AAF_PDU_SIZE,
+			.max_interval_frames = 1,
+			.fill = aaf_fill,
+		};
+		uint64_t idleslope, tx_time = be64toh(pdu->crf_data[0]);
 
 		first_aaf_pdu = false;
 
-		itspec.it_value.tv_sec = ts / NSEC_PER_SEC;
-		itspec.it_value.tv_nsec = ts % NSEC_PER_SEC;
+		memcpy(cfg.macaddr, aaf_macaddr, ETH_ALEN);
+		cfg.start_time = tx_time;
+		aaf_stream = avtp_net_mux_add_stream(mux, &cfg);
+		if (aaf_stream < 0) {
+			fprintf(stderr, "Failed to add AAF stream: %d\n",
+								aaf_stream);
+			return -1;
+		}
+
+		res = avtp_net_mux_get_idleslope(mux, AVTP_NET_MUX_CLASS_A,
+								&idleslope);
+		if (res < 0)
+			return -1;
+
+		/* tc-cbs(8) takes the idleslope in kbps. */
+		printf("AAF stream requires class A idleslope %" PRIu64
+					" kbps\n", idleslope / 1000);
+
+		itspec.it_value.tv_sec = tx_time / NSEC_PER_SEC;
+		itspec.it_value.tv_nsec = tx_time % NSEC_PER_SEC;
 		itspec.it_interval.tv_sec = 0;
 		itspec.it_interval.tv_nsec = AAF_PERIOD;
 		res = timerfd_settime(fd_timer, TFD_TIMER_ABSTIME, &itspec,
@@ -808,7 +812,7 @@ static int aaf_listener_recv_pdu(int fd)
 
 	switch (val) {
 	case AVTP_SUBTYPE_CRF:
-		res = handle_crf_pdu(pdu);
+		res = handle_crf_pdu(pdu, n);
 		break;
 	case AVTP_SUBTYPE_AAF:
 		res = handle_aaf_pdu(pdu);
@@ -864,49 +868,31 @@ err:
 
 static int aaf_talker(int fd_rx)
 {
-	int res, fd_tx, fd_timer;
+	int res, fd_timer;
 	struct pollfd poll_fd[2];
-	struct sockaddr_ll sk_addr = {0};
-	struct ifreq req = {0};
-	struct avtp_stream_pdu *pdu;
-
-	fd_tx = socket(AF_PACKET, SOCK_DGRAM, htons(ETH_P_TSN));
-	if (fd_tx < 0) {
-		perror("Failed to open socket");
+	struct avtp_net_tx *tx;
+	struct avtp_net_tx_config cfg = {
+		.ifname = ifname,
+		.protocol = ETH_P_TSN,
+		.priority = priority == -1 ? 0 : priority,
+		.max_pdu_size = AAF_PDU_SIZE,
+	};
+
+	res = avtp_net_tx_create(&tx, &cfg);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create TX queue: %d\n", res);
 		return -1;
 	}
 
-	if (priority != -1) {
-		res = setsockopt(fd_tx, SOL_SOCKET, SO_PRIORITY, &priority,
-							sizeof(priority));
-		if (res < 0) {
-			perror("Failed to set priority");
-			goto fd_tx_close;
-		}
-	}
-
-	snprintf(req.ifr_name, sizeof(req.ifr_name), "%s", ifname);
-	res = ioctl(fd_tx, SIOCGIFINDEX, &req);
+	res = avtp_net_mux_create(&mux, tx, 1);
 	if (res < 0) {
-		perror("Failed to get interface index");
-		goto fd_tx_close;
+		fprintf(stderr, "Failed to create scheduler: %d\n", res);
+		goto err_tx;
 	}
 
-	sk_addr.sll_family = AF_PACKET;
-	sk_addr.sll_protocol = htons(ETH_P_TSN);
-	sk_addr.sll_halen = ETH_ALEN;
-	sk_addr.sll_ifindex = req.ifr_ifindex;
-	memcpy(&sk_addr.sll_addr, aaf_macaddr, ETH_ALEN);
-
 	fd_timer = timerfd_create(CLOCK_REALTIME, 0);
 	if (fd_timer < 0)
-		goto fd_tx_close;
-
-	pdu = alloca(AAF_PDU_SIZE);
-	res = init_aaf_pdu(pdu);
-	if (res < 0)
-		goto fd_timer_close;
-	memset(pdu->avtp_payload, 0, AAF_DATA_LEN);
+		goto err_mux;
 
 	poll_fd[0].fd = fd_rx;
 	poll_fd[0].events = POLLIN;
@@ -917,31 +903,33 @@ static int aaf_talker(int fd_rx)
 		res = poll(poll_fd, 2, -1);
 		if (res < 0) {
 			perror("Failed to poll() fds");
-			goto fd_timer_close;
+			goto err_timer;
 		}
 
 		if (poll_fd[0].revents & POLLIN) {
 			res = aaf_talker_recv_pdu(fd_rx, fd_timer);
 			if (res < 0)
-				goto fd_timer_close;
+				goto err_timer;
 		}
 
 		if (poll_fd[1].revents & POLLIN) {
-			res = aaf_talker_tx_timeout(fd_timer, fd_tx, &sk_addr,
-									pdu);
+			res = aaf_talker_tx_timeout(fd_timer);
 			if (res < 0)
-				goto fd_timer_close;
+				goto err_timer;
 		}
 	}
 
 	close(fd_timer);
-	close(fd_tx);
+	avtp_net_mux_destroy(mux);
+	avtp_net_tx_destroy(tx);
 	return 0;
 
-fd_timer_close:
+err_timer:
 	close(fd_timer);
-fd_tx_close:
-	close(fd_tx);
+err_mux:
+	avtp_net_mux_destroy(mux);
+err_tx:
+	avtp_net_tx_destroy(tx);
 	return 1;
 }
 
@@ -958,16 +946,38 @@ static int aaf_listener(int fd_rx)
 
 int main(int argc, char *argv[])
 {
-	int fd_rx;
+	int res, fd_rx;
+	struct avtp_stream_pdu tmpl;
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	STAILQ_INIT(&mclk_timestamps);
 	rounded_mtt = ceil((double)mtt / MCLK_PERIOD) * MCLK_PERIOD;
 
+	res = avtp_crf_clock_create(&mclk, MCLK_TIMESTAMPS);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create media clock: %d\n", res);
+		return 1;
+	}
+
+	res = avtp_stats_create(&crf_stats, mtt);
+	if (res < 0)
+		goto err_clock;
+
+	res = init_aaf_pdu(&tmpl);
+	if (res < 0)
+		goto err_crf_stats;
+
+	res = avtp_stream_ctx_init(&aaf_ctx, &tmpl, AAF_SAMPLE_RATE);
+	if (res < 0)
+		goto err_crf_stats;
+
+	res = avtp_stats_create(&aaf_ctx.stats, mtt);
+	if (res < 0)
+		goto err_crf_stats;
+
 	fd_rx = setup_rx_socket();
 	if (fd_rx < 0)
-		return 1;
+		goto err_aaf_stats;
 
 	switch (mode) {
 	case MODE_LISTENER:
@@ -979,5 +989,16 @@ int main(int argc, char *argv[])
 	}
 
 	close(fd_rx);
+	avtp_stats_destroy(aaf_ctx.stats);
+	avtp_stats_destroy(crf_stats);
+	avtp_crf_clock_destroy(mclk);
 	return 0;
+
+err_aaf_stats:
+	avtp_stats_destroy(aaf_ctx.stats);
+err_crf_stats:
+	avtp_stats_destroy(crf_stats);
+err_clock:
+	avtp_crf_clock_destroy(mclk);
+	return 1;
 }
@@ -35,10 +35,20 @@
  * time) are passed via command-line arguments. Run 'crf-talker --help' for
  * more information.
  *
- * This example relies on system clock to generate CRF timestamps and to keep
- * transmission rate. So make sure the system clock is synchronized with the
- * PTP Hardware Clock (PHC) from your NIC and that the PHC is synchronized with
- * the PTP time from the network. For further information on how to synchronize
+ * PDUs are queued in windows of PDUS_PER_WINDOW PDUs, each one carrying its
+ * launch time, and transmitted at once. So make sure the ETF qdisc, with
+ * CLOCK_TAI, is configured on the traffic class the stream is transmitted
+ * (see tc-etf(8)) since it is the qdisc which keeps the transmission rate.
+ *
+ * With the '--hw-tstamp' option, PDUs are timestamped by the NIC as they are
+ * transmitted and the delay from their launch times is reported to stderr once
+ * per second, along with the number of PDUs transmitted so late they can't
+ * make it within the maximum transit time.
+ *
+ * This example relies on system clock to generate CRF timestamps and launch
+ * times. So make sure the system clock is synchronized with the PTP Hardware
+ * Clock (PHC) from your NIC and that the PHC is synchronized with the PTP time
+ * from the network. For further information on how to synchronize
  * those clocks see ptp4l(8) and phc2sys(8) man pages.
  *
  * Here is an example to setup ptp4l and phc2sys on PTP master host. Replace
@@ -48,9 +58,9 @@
  *	$ phc2sys -f gPTP.cfg -c $IFNAME -s CLOCK_REALTIME -w
  */
 
-#include <alloca.h>
 #include <argp.h>
 #include <arpa/inet.h>
+#include <inttypes.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
@@ -61,9 +71,11 @@
 #include <time.h>
 #include <unistd.h>
 #include <math.h>
+#include <stdbool.h>
 
 #include "avtp.h"
 #include "avtp_crf.h"
+#include "avtp_net.h"
 #include "examples/common.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0002
@@ -80,16 +92,24 @@
 #define DATA_LEN		(sizeof(uint64_t) * TIMESTAMPS_PER_PKT)
 #define PDU_SIZE		(sizeof(struct avtp_crf_pdu) + DATA_LEN)
 #define PDUS_PER_SEC		(TIMESTAMPS_PER_SEC / TIMESTAMPS_PER_PKT)
-#define CRF_PERIOD		(NSEC_PER_SEC / TIMESTAMPS_PER_SEC)
 #define NOMINAL_PERIOD		(1.0 / SAMPLE_RATE)
 #define TX_INTERVAL		(NSEC_PER_SEC / PDUS_PER_SEC)
+/* PDUs transmitted at once, on each wakeup. */
+#define PDUS_PER_WINDOW		10
+/* How far in the future the first PDU from a window is launched. */
+#define TX_LEAD_TIME		(5 * NSEC_PER_MSEC)
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static int mtt;
+static bool hw_tstamp;
+
+/* Transmission delays accounted since the last report. */
+static uint64_t tx_count, tx_late, tx_max_delay, last_report;
 
 static struct argp_option options[] = {
 	{"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
+	{"hw-tstamp", 'H', 0, 0, "Report transmission times from the NIC" },
 	{"ifname", 'i', "IFNAME", 0, "Network Interface" },
 	{"max-transit-time", 'm', "MSEC", 0, "Maximum Transit Time in ms" },
 	{ 0 }
@@ -109,6 +129,9 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 			exit(EXIT_FAILURE);
 		}
 
+		break;
+	case 'H':
+		hw_tstamp = true;
 		break;
 	case 'i':
 		strncpy(ifname, arg, sizeof(ifname) - 1);
@@ -149,70 +172,104 @@ static uint64_t calculate_crf_timestamp(struct timespec tspec, uint64_t rounded_
 	return crf_time;
 }
 
-static int init_pdu(struct avtp_crf_pdu *pdu)
-{
-	int res;
-
-	res = avtp_crf_pdu_init(pdu);
-	if (res < 0)
-		return -1;
-
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_FS, 0);
-	if (res < 0)
-		return -1;
-
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_TYPE,
-						AVTP_CRF_TYPE_AUDIO_SAMPLE);
-	if (res < 0)
-		return -1;
-
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_STREAM_ID, STREAM_ID);
-	if (res < 0)
-		return -1;
+/* Stream format shared by header packing and CRF timestamps encoding. */
+static const struct avtp_crf_hdr crf_hdr = {
+	.sv = 1,
+	.fs = 0,
+	.type = AVTP_CRF_TYPE_AUDIO_SAMPLE,
+	.stream_id = STREAM_ID,
+	.pull = AVTP_CRF_PULL_MULT_BY_1,
+	.base_freq = SAMPLE_RATE,
+	.timestamp_interval = TIMESTAMP_INTERVAL,
+	.crf_data_len = DATA_LEN,
+};
 
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_PULL,
-						AVTP_CRF_PULL_MULT_BY_1);
-	if (res < 0)
-		return -1;
+/* Build the header template which is used to emit every CRF PDU sent by this
+ * talker. Only sequence number changes from PDU to PDU so all other fields are
+ * packed at once here.
+ */
+static int init_pdu_template(struct avtp_crf_pdu *tmpl)
+{
+	return avtp_crf_pdu_pack(tmpl, &crf_hdr) < 0 ? -1 : 0;
+}
 
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_BASE_FREQ,
-							SAMPLE_RATE);
-	if (res < 0)
-		return -1;
+/* Account the transmission reports available so far. Both launch times and
+ * hardware timestamps are on CLOCK_TAI. Reports are retrieved without blocking
+ * so the ones not available yet are accounted on the next window.
+ */
+static int account_tx_reports(struct avtp_net_tx *tx, uint64_t now)
+{
+	struct avtp_net_tx_report reports[AVTP_NET_TX_REPORT_BATCH];
+	int i, n;
+
+	while ((n = avtp_net_tx_get_reports(tx, reports,
+					AVTP_NET_TX_REPORT_BATCH)) > 0) {
+		for (i = 0; i < n; i++) {
+			uint64_t delay;
+
+			if (!reports[i].launch_time || !reports[i].tx_time ||
+				reports[i].tx_time < reports[i].launch_time)
+				continue;
+
+			delay = reports[i].tx_time - reports[i].launch_time;
+			if (delay > tx_max_delay)
+				tx_max_delay = delay;
+			if (delay > (uint64_t) mtt)
+				tx_late++;
+			tx_count++;
+		}
+	}
 
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_TIMESTAMP_INTERVAL,
-							TIMESTAMP_INTERVAL);
-	if (res < 0)
+	if (n < 0) {
+		fprintf(stderr, "Failed to get TX reports: %d\n", n);
 		return -1;
+	}
 
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_CRF_DATA_LEN, DATA_LEN);
-	if (res < 0)
-		return -1;
+	if (now - last_report >= NSEC_PER_SEC) {
+		fprintf(stderr, "TX: %" PRIu64 " PDUs, max delay %" PRIu64
+				" ns, %" PRIu64 " exceeded max transit time\n",
+				tx_count, tx_max_delay, tx_late);
+		tx_count = tx_late = tx_max_delay = 0;
+		last_report = now;
+	}
 
 	return 0;
 }
 
 int main(int argc, char *argv[])
 {
-	int sk_fd, res, idx;
+	int res, i;
 	uint8_t seq_num = 0;
 	uint64_t crf_time, rounded_mtt;
+	int64_t tai_offset;
 	struct timespec clksrc_ts = {0};
-	struct sockaddr_ll sk_addr = {0};
-	struct avtp_crf_pdu *pdu = alloca(PDU_SIZE);
+	struct avtp_crf_pdu tmpl;
+	struct avtp_net_tx *tx;
+	struct avtp_net_tx_config cfg = {
+		.ifname = ifname,
+		.protocol = ETH_P_TSN,
+		.txtime = true,
+		.clockid = CLOCK_TAI,
+		.queue_size = PDUS_PER_WINDOW,
+		.max_pdu_size = PDU_SIZE,
+	};
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	sk_fd = create_talker_socket(-1);
-	if (sk_fd < 0) {
+	if (hw_tstamp)
+		cfg.tstamp = AVTP_NET_TSTAMP_HARDWARE;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create TX queue: %d\n", res);
 		return 1;
 	}
 
-	res = setup_socket_address(sk_fd, ifname, macaddr, ETH_P_TSN, &sk_addr);
+	res = init_pdu_template(&tmpl);
 	if (res < 0)
 		goto err;
 
-	res = init_pdu(pdu);
+	res = get_tai_offset(&tai_offset);
 	if (res < 0)
 		goto err;
 
@@ -224,41 +281,78 @@ int main(int argc, char *argv[])
 
 	rounded_mtt = ceil(mtt / NOMINAL_PERIOD) * NOMINAL_PERIOD;
 
-	while (1) {
-		ssize_t n;
-
-		crf_time = calculate_crf_timestamp(clksrc_ts, rounded_mtt);
-		for (idx = 0; idx < TIMESTAMPS_PER_PKT; idx++)
-			pdu->crf_data[idx] = htobe64(crf_time + (CRF_PERIOD * idx));
-
-		res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_SEQ_NUM, seq_num++);
-		if (res < 0)
-			goto err;
+	/* The first window is launched TX_LEAD_TIME from now. */
+	clksrc_ts.tv_nsec += TX_LEAD_TIME;
 
-		n = sendto(sk_fd, pdu, PDU_SIZE, 0,
-				(struct sockaddr *) &sk_addr, sizeof(sk_addr));
-		if (n < 0) {
-			perror("Failed to send data");
-			goto err;
+	while (1) {
+		uint64_t launch_time;
+
+		launch_time = clksrc_ts.tv_sec * NSEC_PER_SEC +
+							clksrc_ts.tv_nsec;
+
+		/* Queue a whole window of PDUs at once. Each PDU carries its
+		 * launch time so the ETF qdisc paces them every TX_INTERVAL,
+		 * and its CRF timestamps are derived from that launch time.
+		 */
+		for (i = 0; i < PDUS_PER_WINDOW; i++) {
+			struct timespec ts = {
+				.tv_sec = launch_time / NSEC_PER_SEC,
+				.tv_nsec = launch_time % NSEC_PER_SEC,
+			};
+			struct avtp_crf_pdu *pdu;
+
+			res = avtp_net_tx_reserve(tx, (void **) &pdu);
+			if (res < 0)
+				goto err;
+
+			/* Timestamps are TIMESTAMP_INTERVAL samples apart. */
+			crf_time = calculate_crf_timestamp(ts, rounded_mtt);
+			res = avtp_crf_data_encode(pdu->crf_data,
+						TIMESTAMPS_PER_PKT, crf_time,
+						&crf_hdr);
+			if (res < 0)
+				goto err;
+
+			res = avtp_crf_pdu_emit(pdu, &tmpl, seq_num++);
+			if (res < 0)
+				goto err;
+
+			res = avtp_net_tx_commit(tx, macaddr, PDU_SIZE,
+						launch_time + tai_offset);
+			if (res < 0)
+				goto err;
+
+			launch_time += TX_INTERVAL;
 		}
 
-		if (n != PDU_SIZE) {
-			fprintf(stderr, "wrote %zd bytes, expected %zd\n",
-								n, PDU_SIZE);
+		while (avtp_net_tx_get_pending(tx) > 0) {
+			res = avtp_net_tx_flush(tx);
+			if (res < 0) {
+				fprintf(stderr, "Failed to send data: %d\n",
+									res);
+				goto err;
+			}
 		}
 
-		clksrc_ts.tv_nsec += TX_INTERVAL;
-		if (clksrc_ts.tv_nsec >= NSEC_PER_SEC) {
-			clksrc_ts.tv_sec++;
-			clksrc_ts.tv_nsec -= NSEC_PER_SEC;
+		if (hw_tstamp) {
+			res = account_tx_reports(tx, launch_time);
+			if (res < 0)
+				goto err;
 		}
+
+		/* Wake up TX_LEAD_TIME before the next window is due. */
+		launch_time -= TX_LEAD_TIME;
+		clksrc_ts.tv_sec = launch_time / NSEC_PER_SEC;
+		clksrc_ts.tv_nsec = launch_time % NSEC_PER_SEC;
 		clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &clksrc_ts, NULL);
+
+		clksrc_ts.tv_nsec += TX_LEAD_TIME;
 	}
 
-	close(sk_fd);
+	avtp_net_tx_destroy(tx);
 	return 0;
 
 err:
-	close(sk_fd);
+	avtp_net_tx_destroy(tx);
 	return 1;
 }
@@ -31,10 +31,14 @@
  * receives CVF packets from the network, retrieves video data and writes
  * them to stdout once the presentation time is reached.
  *
- * For simplicity, this examples accepts only CVF H.264 packets, and the H.264
- * data must be composed of NAL and each NAL unit can not exceed 1400 bytes.
+ * For simplicity, this examples accepts only CVF H.264 packets, and packets
+ * can not exceed 1400 bytes of H.264 data.
  *
- * The H.264 data sent to output is in H.264 byte-stream format.
+ * Packets are gathered into complete frames (i.e. access units) by the
+ * libavtp H.264 depacketizer, which rebuilds them in H.264 byte-stream format
+ * inside a preallocated arena. Frames with missing packets are dropped. Each
+ * frame is written to stdout at once, straight from the arena, when its
+ * presentation time is reached.
  *
  * TSN stream parameters such as destination mac address are passed via
  * command-line arguments. Run 'cvf-listener --help' for more information.
@@ -64,12 +68,13 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/queue.h>
 #include <sys/timerfd.h>
 #include <unistd.h>
 
 #include "avtp.h"
 #include "avtp_cvf.h"
+#include "avtp_inline.h"
+#include "avtp_pdu_view.h"
 #include "examples/common.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -77,19 +82,22 @@
 #define AVTP_H264_HEADER_LEN	(sizeof(uint32_t))
 #define AVTP_FULL_HEADER_LEN	(sizeof(struct avtp_stream_pdu) + AVTP_H264_HEADER_LEN)
 #define MAX_PDU_SIZE		(AVTP_FULL_HEADER_LEN + DATA_LEN)
+#define ARENA_SIZE		(4 * 1024 * 1024)
+#define MAX_FRAMES		64
 
-struct nal_entry {
-	STAILQ_ENTRY(nal_entry) entries;
-
-	uint16_t len;
+/* Frames waiting for their presentation time, oldest first. */
+struct frame_entry {
+	struct avtp_cvf_h264_frame frame;
 	struct timespec tspec;
-	uint8_t nal[DATA_LEN];
 };
 
-static STAILQ_HEAD(nal_queue, nal_entry) nals;
+static struct frame_entry frames[MAX_FRAMES];
+static unsigned int frames_head;
+static unsigned int frames_count;
+static struct avtp_cvf_h264_depacketizer *depkt;
+
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
-static uint8_t expected_seq;
 
 static struct argp_option options[] = {
 	{"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
@@ -122,197 +130,120 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser };
 
-static int schedule_nal(int fd, struct timespec *tspec, uint8_t *nal,
-								ssize_t len)
+static int schedule_frame(int fd, struct avtp_cvf_h264_frame *frame)
 {
-	struct nal_entry *entry;
+	struct frame_entry *entry;
+	int res;
 
-	entry = malloc(sizeof(*entry));
-	if (!entry) {
-		fprintf(stderr, "Failed to allocate memory\n");
+	if (frames_count == MAX_FRAMES) {
+		fprintf(stderr, "Too many frames queued\n");
 		return -1;
 	}
 
-	entry->len = len;
-	entry->tspec.tv_sec = tspec->tv_sec;
-	entry->tspec.tv_nsec = tspec->tv_nsec;
-	memcpy(entry->nal, nal, entry->len);
+	entry = &frames[(frames_head + frames_count) % MAX_FRAMES];
+	entry->frame = *frame;
+
+	res = get_presentation_time(frame->avtp_time, &entry->tspec);
+	if (res < 0)
+		return -1;
 
-	STAILQ_INSERT_TAIL(&nals, entry, entries);
+	frames_count++;
 
 	/* If this was the first entry inserted onto the queue, we need to arm
 	 * the timer.
 	 */
-	if (STAILQ_FIRST(&nals) == entry) {
-		int res;
-
-		res = arm_timer(fd, tspec);
-		if (res < 0) {
-			STAILQ_REMOVE(&nals, entry, nal_entry, entries);
-			free(entry);
+	if (frames_count == 1) {
+		res = arm_timer(fd, &entry->tspec);
+		if (res < 0)
 			return -1;
-		}
 	}
 
 	return 0;
 }
 
-static bool is_valid_packet(struct avtp_stream_pdu *pdu)
+/* Check the fields fixed for our stream, decoded all at once by the view. */
+static bool is_valid_packet(struct avtp_pdu_view *view)
 {
-	struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-	uint64_t val64;
-	uint32_t val32;
-	int res;
+	const struct avtp_cvf_hdr *hdr = avtp_pdu_view_cvf_hdr(view);
+	uint32_t version;
 
-	res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get subtype field: %d\n", res);
-		return false;
-	}
-	if (val32 != AVTP_SUBTYPE_CVF) {
-		fprintf(stderr, "Subtype mismatch: expected %u, got %u\n",
-						AVTP_SUBTYPE_CVF, val32);
-		return false;
-	}
-
-	res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get version field: %d\n", res);
-		return false;
-	}
-	if (val32 != 0) {
+	version = avtp_common_get_version(
+			(const struct avtp_common_pdu *) view->buf);
+	if (version != 0) {
 		fprintf(stderr, "Version mismatch: expected %u, got %u\n",
-								0, val32);
+								0, version);
 		return false;
 	}
 
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_TV, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get tv field: %d\n", res);
-		return false;
-	}
-	if (val64 != 1) {
-		fprintf(stderr, "tv mismatch: expected %u, got %lu\n",
-								1, val64);
+	if (hdr->stream.tv != 1) {
+		fprintf(stderr, "tv mismatch: expected %u, got %u\n",
+							1, hdr->stream.tv);
 		return false;
 	}
 
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_STREAM_ID, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get stream ID field: %d\n", res);
-		return false;
-	}
-	if (val64 != STREAM_ID) {
+	if (hdr->stream.stream_id != STREAM_ID) {
 		fprintf(stderr, "Stream ID mismatch: expected %lu, got %lu\n",
-							STREAM_ID, val64);
+					STREAM_ID, hdr->stream.stream_id);
 		return false;
 	}
 
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_SEQ_NUM, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get sequence num field: %d\n", res);
+	if (hdr->format != AVTP_CVF_FORMAT_RFC) {
+		fprintf(stderr, "Format mismatch: expected %u, got %u\n",
+					AVTP_CVF_FORMAT_RFC, hdr->format);
 		return false;
 	}
 
-	if (val64 != expected_seq) {
-		/* If we have a sequence number mismatch, we simply log the
-		 * issue and continue to process the packet. We don't want to
-		 * invalidate it since it is a valid packet after all.
-		 */
-		fprintf(stderr,
-			"Sequence number mismatch: expected %u, got %lu\n",
-							expected_seq, val64);
-		expected_seq = val64;
-	}
-
-	expected_seq++;
-
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_FORMAT, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get format field: %d\n", res);
-		return false;
-	}
-	if (val64 != AVTP_CVF_FORMAT_RFC) {
-		fprintf(stderr, "Format mismatch: expected %u, got %lu\n",
-					AVTP_CVF_FORMAT_RFC, val64);
-		return false;
-	}
-
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_FORMAT_SUBTYPE, &val64);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get format subtype field: %d\n",
-									res);
-		return false;
-	}
-	if (val64 != AVTP_CVF_FORMAT_SUBTYPE_H264) {
-		fprintf(stderr, "Format mismatch: expected %u, got %lu\n",
-					AVTP_CVF_FORMAT_SUBTYPE_H264, val64);
+	if (hdr->format_subtype != AVTP_CVF_FORMAT_SUBTYPE_H264) {
+		fprintf(stderr, "Format mismatch: expected %u, got %u\n",
+					AVTP_CVF_FORMAT_SUBTYPE_H264,
+					hdr->format_subtype);
 		return false;
 	}
 
 	return true;
 }
 
-static int get_h264_data_len(struct avtp_stream_pdu *pdu,
-						uint16_t *stream_data_len)
-{
-	int res;
-	uint64_t val;
-
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_STREAM_DATA_LEN, &val);
-	if (res < 0) {
-		fprintf(stderr, "Failed to get data_len field\n");
-		return -1;
-	}
-	*stream_data_len = val - AVTP_H264_HEADER_LEN;
-
-	return 0;
-}
-
 static int new_packet(int sk_fd, int timer_fd)
 {
 	int res;
 	ssize_t n;
-	uint16_t h264_data_len;
-	uint64_t avtp_time;
-	struct timespec tspec;
-	struct avtp_stream_pdu *pdu = alloca(MAX_PDU_SIZE);
-	struct avtp_cvf_h264_payload *h264_pay =
-			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
-
-	memset(pdu, 1, MAX_PDU_SIZE);
+	struct avtp_cvf_h264_frame frame;
+	struct avtp_pdu_view view;
+	uint8_t pdu[MAX_PDU_SIZE];
 
 	n = recv(sk_fd, pdu, MAX_PDU_SIZE, 0);
-	if (n < 0 || n > MAX_PDU_SIZE) {
+	if (n < 0) {
 		perror("Failed to receive data");
 		return -1;
 	}
 
-	if (!is_valid_packet(pdu)) {
+	/* The view checks once that the whole PDU, H.264 header included,
+	 * was received, so fields can be read with no further checks.
+	 */
+	res = avtp_pdu_view_init(&view, pdu, n, AVTP_SUBTYPE_CVF);
+	if (res < 0 || !is_valid_packet(&view)) {
 		fprintf(stderr, "Dropping packet\n");
 		return 0;
 	}
 
-	res = avtp_cvf_pdu_get(pdu, AVTP_CVF_FIELD_TIMESTAMP, &avtp_time);
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+				avtp_pdu_view_stream(&view), n, &frame);
+	if (res == -ENOSPC) {
+		fprintf(stderr, "Frame doesn't fit in arena, dropping it\n");
+		return 0;
+	}
 	if (res < 0) {
-		fprintf(stderr, "Failed to get AVTP time from PDU\n");
-		return -1;
+		fprintf(stderr, "Dropping packet: %d\n", res);
+		return 0;
 	}
+	if (res == 0)
+		return 0;
 
-	res = get_presentation_time(avtp_time, &tspec);
-	if (res < 0)
-		return -1;
-
-	res = get_h264_data_len(pdu, &h264_data_len);
-	if (res < 0)
-		return -1;
-
-	res = schedule_nal(timer_fd, &tspec, h264_pay->h264_data,
-							h264_data_len);
-	if (res < 0)
-		return -1;
+	if (frame.lost_pdus)
+		fprintf(stderr, "Lost %u packets, dropped %u frames\n",
+				frame.lost_pdus, frame.dropped_frames);
 
-	return 0;
+	return schedule_frame(timer_fd, &frame);
 }
 
 static int timeout(int fd)
@@ -320,7 +251,7 @@ static int timeout(int fd)
 	int res;
 	ssize_t n;
 	uint64_t expirations;
-	struct nal_entry *entry;
+	struct frame_entry *entry;
 
 	n = read(fd, &expirations, sizeof(uint64_t));
 	if (n < 0) {
@@ -329,19 +260,23 @@ static int timeout(int fd)
 	}
 
 	assert(expirations == 1);
+	assert(frames_count > 0);
 
-	entry = STAILQ_FIRST(&nals);
-	assert(entry != NULL);
+	entry = &frames[frames_head];
 
-	res = present_data(entry->nal, entry->len);
+	res = present_data((uint8_t *) entry->frame.data, entry->frame.len);
 	if (res < 0)
 		return -1;
 
-	STAILQ_REMOVE_HEAD(&nals, entries);
-	free(entry);
+	res = avtp_cvf_h264_depacketizer_release(depkt, &entry->frame);
+	if (res < 0)
+		return -1;
 
-	if (!STAILQ_EMPTY(&nals)) {
-		entry = STAILQ_FIRST(&nals);
+	frames_head = (frames_head + 1) % MAX_FRAMES;
+	frames_count--;
+
+	if (frames_count > 0) {
+		entry = &frames[frames_head];
 
 		res = arm_timer(fd, &entry->tspec);
 		if (res < 0)
@@ -358,16 +293,20 @@ int main(int argc, char *argv[])
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	STAILQ_INIT(&nals);
+	res = avtp_cvf_h264_depacketizer_create(&depkt, ARENA_SIZE);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create depacketizer: %d\n", res);
+		return 1;
+	}
 
 	sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
 	if (sk_fd < 0)
-		return 1;
+		goto err_depkt;
 
 	timer_fd = timerfd_create(CLOCK_REALTIME, 0);
 	if (timer_fd < 0) {
 		close(sk_fd);
-		return 1;
+		goto err_depkt;
 	}
 
 	fds[0].fd = sk_fd;
@@ -400,5 +339,7 @@ int main(int argc, char *argv[])
 err:
 	close(sk_fd);
 	close(timer_fd);
+err_depkt:
+	avtp_cvf_h264_depacketizer_destroy(depkt);
 	return 1;
 }
@@ -32,7 +32,13 @@
  * network.
  *
  * For simplicity, this example supports only NAL units in byte-stream format,
- * and each NAL unit can not exceed 1400 bytes.
+ * and access units can not exceed BUFFER_SIZE bytes. NAL units which don't
+ * fit in a single packet are fragmented into FU-A packets.
+ *
+ * Packets are built by the main thread in buffers from a PDU pool and handed
+ * over, without locks or memory allocation, to a network thread which
+ * transmits them. Packet buffers only hold headers: NAL unit data is sent
+ * straight from the stdin buffer via scatter-gather I/O so it is never copied.
  *
  * TSN stream parameters (e.g. destination mac address, traffic priority) are
  * passed via command-line arguments. Run 'cvf-talker --help' for more
@@ -56,24 +62,27 @@
  *  | cvf-talker <args>
  *
  * Note that the `x264enc` may be changed by any other H.264 encoder
- * available, as long as it generates a byte-stream with NAL units no longer
- * than 1400 bytes.
+ * available, as long as it generates a byte-stream.
  */
 
-#include <alloca.h>
 #include <argp.h>
 #include <arpa/inet.h>
 #include <assert.h>
 #include <linux/if.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 #include "avtp.h"
 #include "avtp_cvf.h"
+#include "avtp_pool.h"
 #include "examples/common.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -81,18 +90,37 @@
 #define AVTP_H264_HEADER_LEN	(sizeof(uint32_t))
 #define AVTP_FULL_HEADER_LEN	(sizeof(struct avtp_stream_pdu) + AVTP_H264_HEADER_LEN)
 #define MAX_PDU_SIZE		(AVTP_FULL_HEADER_LEN + DATA_LEN)
+#define BUFFER_SIZE		(1024 * 1024)
+#define POOL_SIZE		16
+#define BURST_SIZE		8
+
+/* H.264 NAL unit types (see Table 7-1 from H.264 spec). */
+#define NAL_TYPE_SLICE		1
+#define NAL_TYPE_IDR		5
+#define NAL_TYPE_SEI		6
+#define NAL_TYPE_SPS		7
+#define NAL_TYPE_PPS		8
+#define NAL_TYPE_AUD		9
 
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static int priority = -1;
 static int max_transit_time;
 
-static char buffer[MAX_PDU_SIZE * 2];
+static uint8_t buffer[BUFFER_SIZE];
 static size_t buffer_level;
 
-static uint8_t seq_num;
+static struct avtp_cvf_h264_packetizer packetizer;
 
-enum process_result {PROCESS_OK, PROCESS_NONE, PROCESS_ERROR};
+/* Packets are built by the main thread in buffers from 'pool' and handed over
+ * to the network thread, which transmits them. 'in_flight' counts packets
+ * which still reference data from 'buffer'.
+ */
+static struct avtp_pool *pool;
+static struct avtp_cvf_h264_packet *spare;
+static atomic_uint in_flight;
+static atomic_bool end_of_stream;
+static atomic_bool network_error;
 
 static struct argp_option options[] = {
 	{"dst-addr", 'd', "MACADDR", 0, "Stream Destination MAC address" },
@@ -133,38 +161,24 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 
 static struct argp argp = { options, parser };
 
-static int init_pdu(struct avtp_stream_pdu *pdu)
+/* Build the header template which is used by the packetizer to emit every
+ * PDU sent by this talker.
+ */
+static int init_pdu_template(struct avtp_stream_pdu *tmpl)
 {
-	int res;
-
-	res = avtp_cvf_pdu_init(pdu, AVTP_CVF_FORMAT_SUBTYPE_H264);
-	if (res < 0)
-		return -1;
-
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_TV, 1);
-	if (res < 0)
-		return -1;
-
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_STREAM_ID, STREAM_ID);
-	if (res < 0)
-		return -1;
-
-	/* Just state that all data is part of the frame (M=1) */
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_M, 1);
-	if (res < 0)
-		return -1;
-
-	/* No H.264 timestamp now */
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_H264_TIMESTAMP, 0);
-	if (res < 0)
-		return -1;
-
-	/* No H.264 timestamp means no PTV */
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_H264_PTV, 0);
-	if (res < 0)
-		return -1;
-
-	return 0;
+	struct avtp_cvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = STREAM_ID,
+		},
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_H264,
+		/* No H.264 timestamp means no PTV */
+		.h264_ptv = 0,
+	};
+
+	return avtp_cvf_pdu_pack(tmpl, &hdr) < 0 ? -1 : 0;
 }
 
 static ssize_t fill_buffer(void)
@@ -175,6 +189,7 @@ static ssize_t fill_buffer(void)
 					sizeof(buffer) - buffer_level);
 	if (n < 0) {
 		perror("Could not read from standard input");
+		return n;
 	}
 
 	buffer_level += n;
@@ -187,7 +202,7 @@ static ssize_t start_code_position(size_t offset)
 	assert(offset < buffer_level);
 
 	/* Simplified Boyer-Moore, inspired by gstreamer */
-	while (offset < buffer_level - 2) {
+	while (offset + 2 < buffer_level) {
 		if (buffer[offset + 2] == 0x1) {
 			if (buffer[offset] == 0x0 && buffer[offset + 1] == 0x0)
 				return offset;
@@ -202,140 +217,279 @@ static ssize_t start_code_position(size_t offset)
 	return -1;
 }
 
-static int prepare_packet(struct avtp_stream_pdu *pdu, char *nal_data,
-							size_t nal_data_len)
+/* Check if a NAL unit following a slice starts a new access unit. Only the
+ * usual cases from section 7.4.1.2.3 of H.264 spec are handled: AUD, SEI, SPS
+ * and PPS NAL units, and slices starting a picture, i.e. with
+ * first_mb_in_slice 0, which is coded as a single '1' bit.
+ */
+static bool starts_access_unit(const uint8_t *nal)
 {
-	int res;
-	uint32_t avtp_time;
-	struct avtp_cvf_h264_payload *h264_pay =
-			(struct avtp_cvf_h264_payload *) pdu->avtp_payload;
-
-	res = calculate_avtp_time(&avtp_time, max_transit_time);
-	if (res < 0) {
-		fprintf(stderr, "Failed to calculate avtp time\n");
-		return -1;
+	switch (nal[0] & 0x1F) {
+	case NAL_TYPE_SEI:
+	case NAL_TYPE_SPS:
+	case NAL_TYPE_PPS:
+	case NAL_TYPE_AUD:
+		return true;
+	case NAL_TYPE_SLICE:
+	case NAL_TYPE_IDR:
+		return nal[1] & 0x80;
+	default:
+		return false;
 	}
+}
 
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_TIMESTAMP,
-							avtp_time);
-	if (res < 0)
-		return -1;
+/* Find the length of the access unit starting at 'offset' from 'buffer'.
+ * Returns 0 if more data is needed to find where the access unit ends. If
+ * 'last' is true, the access unit spans up to the end of 'buffer'.
+ */
+static size_t access_unit_length(size_t offset, bool last)
+{
+	bool slice = false;
+	ssize_t pos;
 
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_SEQ_NUM, seq_num++);
-	if (res < 0)
-		return -1;
+	if (offset >= buffer_level)
+		return 0;
 
-	/* Stream data len includes AVTP H264 header, as this is part
-	 * of the payload too*/
-	res = avtp_cvf_pdu_set(pdu, AVTP_CVF_FIELD_STREAM_DATA_LEN,
-					nal_data_len + AVTP_H264_HEADER_LEN);
-	if (res < 0)
-		return -1;
+	pos = start_code_position(offset);
+	if (pos == -1)
+		return 0;
 
-	memcpy(h264_pay->h264_data, nal_data, nal_data_len);
+	while (pos != -1) {
+		const uint8_t *nal = &buffer[pos + 3];
 
-	return 0;
+		/* The first two bytes of the NAL unit are inspected. */
+		if (pos + 5 > buffer_level)
+			break;
+
+		if (slice && starts_access_unit(nal))
+			return pos - offset;
+
+		if ((nal[0] & 0x1F) == NAL_TYPE_SLICE ||
+					(nal[0] & 0x1F) == NAL_TYPE_IDR)
+			slice = true;
+
+		pos = start_code_position(pos + 3);
+	}
+
+	return last ? buffer_level - offset : 0;
 }
 
-static int process_nal(struct avtp_stream_pdu *pdu, bool process_last,
-							size_t *nal_len)
+struct network_ctx {
+	int fd;
+	struct sockaddr_ll sk_addr;
+};
+
+/* Transmit packets handed over through the pool until the end of the
+ * stream.
+ */
+static void *network_thread(void *arg)
 {
-	int res;
-	ssize_t start, end;
+	struct network_ctx *ctx = arg;
 
-	*nal_len = 0;
+	while (1) {
+		void *pdus[BURST_SIZE];
+		size_t lens[BURST_SIZE];
+		bool end;
+		int i, n;
+
+		/* Checked before receiving so no PDU submitted before the end
+		 * of the stream is missed.
+		 */
+		end = atomic_load(&end_of_stream);
+
+		n = avtp_pool_receive_burst(pool, pdus, lens, BURST_SIZE);
+		if (n == 0) {
+			if (end)
+				break;
 
-	start = start_code_position(0);
-	if (start == -1) {
-		fprintf(stderr, "Unable to find NAL start\n");
-		return PROCESS_NONE;
-	}
-	/* Now, let's find where the next starts. This is where current ends */
-	end = start_code_position(start + 1);
-	if (end == -1) {
-		if (process_last == false) {
-			return PROCESS_NONE;
-		} else {
-			end = buffer_level;
+			sched_yield();
+			continue;
+		}
+
+		for (i = 0; i < n; i++) {
+			struct avtp_cvf_h264_packet *packet = pdus[i];
+			struct msghdr msg = {
+				.msg_name = &ctx->sk_addr,
+				.msg_namelen = sizeof(ctx->sk_addr),
+				.msg_iov = packet->iov,
+				.msg_iovlen = 2,
+			};
+			ssize_t res;
+
+			/* Headers and NAL unit data are gathered by the
+			 * kernel.
+			 */
+			res = sendmsg(ctx->fd, &msg, 0);
+			avtp_pool_release(pool, packet);
+			atomic_fetch_sub(&in_flight, 1);
+
+			if (res < 0) {
+				perror("Failed to send data");
+				atomic_store(&network_error, true);
+				return NULL;
+			}
 		}
 	}
 
-	*nal_len = end - start;
-	if (*nal_len > DATA_LEN) {
-		fprintf(stderr, "NAL length bigger than expected. Expected %u, "
-					"found %zd\n", DATA_LEN, *nal_len);
-		goto err;
+	return NULL;
+}
+
+/* Get a buffer from the pool, waiting for the network thread to release one
+ * if all of them are in use.
+ */
+static int get_packet_buffer(struct avtp_cvf_h264_packet **packet)
+{
+	while (avtp_pool_alloc(pool, (void **) packet) == -ENOBUFS) {
+		if (atomic_load(&network_error))
+			return -1;
+
+		sched_yield();
+	}
+
+	return 0;
+}
+
+/* Wait until all packets referencing data from 'buffer' are sent. */
+static int wait_packets_sent(void)
+{
+	while (atomic_load(&in_flight) > 0) {
+		if (atomic_load(&network_error))
+			return -1;
+
+		sched_yield();
 	}
 
-	/* Sets AVTP packet headers and content - the NAL unit */
-	res = prepare_packet(pdu, &buffer[start], *nal_len);
+	return 0;
+}
+
+static int send_access_unit(const uint8_t *au, size_t len)
+{
+	int res;
+	uint32_t avtp_time;
+
+	res = calculate_avtp_time(&avtp_time, max_transit_time);
 	if (res < 0) {
-		goto err;
+		fprintf(stderr, "Failed to calculate avtp time\n");
+		return -1;
+	}
+
+	res = avtp_cvf_h264_packetizer_start(&packetizer, au, len, avtp_time,
+									0);
+	if (res < 0) {
+		fprintf(stderr, "Unable to find NAL start\n");
+		return -1;
 	}
 
-	/* Finally, let's offset any remaining data on the buffer to the
-	 * beginning. Not really efficient, but keep things simple */
-	memmove(buffer, buffer + end, buffer_level - end);
-	buffer_level -= end;
+	while (1) {
+		/* A buffer is always held in 'spare' since there is no way to
+		 * know whether the access unit has packets left other than
+		 * trying to emit one.
+		 */
+		if (!spare && get_packet_buffer(&spare) < 0)
+			return -1;
+
+		res = avtp_cvf_h264_packetizer_next(&packetizer, spare);
+		if (res < 0)
+			return -1;
+		if (res == 0)
+			break;
 
-	return PROCESS_OK;
+		atomic_fetch_add(&in_flight, 1);
+		avtp_pool_submit(pool, spare, sizeof(*spare));
+		spare = NULL;
+	}
 
-err:
-	return PROCESS_ERROR;
+	return 0;
 }
 
 int main(int argc, char *argv[])
 {
-	int fd, res;
-	struct sockaddr_ll sk_addr;
-	struct avtp_stream_pdu *pdu = alloca(MAX_PDU_SIZE);
+	int res;
+	pthread_t thread;
+	struct network_ctx ctx;
+	uint8_t tmpl[AVTP_FULL_HEADER_LEN];
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	fd = create_talker_socket(priority);
-	if (fd < 0)
+	ctx.fd = create_talker_socket(priority);
+	if (ctx.fd < 0)
 		return 1;
 
-	res = setup_socket_address(fd, ifname, macaddr, ETH_P_TSN, &sk_addr);
+	res = setup_socket_address(ctx.fd, ifname, macaddr, ETH_P_TSN,
+								&ctx.sk_addr);
 	if (res < 0)
 		goto err;
 
-	res = init_pdu(pdu);
+	res = init_pdu_template((struct avtp_stream_pdu *) tmpl);
 	if (res < 0)
 		goto err;
 
-	while (1) {
+	res = avtp_cvf_h264_packetizer_init(&packetizer,
+			(struct avtp_stream_pdu *) tmpl, MAX_PDU_SIZE);
+	if (res < 0)
+		goto err;
+
+	res = avtp_pool_create(&pool, POOL_SIZE,
+					sizeof(struct avtp_cvf_h264_packet));
+	if (res < 0)
+		goto err;
+
+	res = pthread_create(&thread, NULL, network_thread, &ctx);
+	if (res != 0) {
+		avtp_pool_destroy(pool);
+		goto err;
+	}
+
+	while (!atomic_load(&network_error)) {
+		size_t offset = 0, len;
 		ssize_t n;
-		bool end = false;
+		bool end;
 
 		n = fill_buffer();
-		if (n == 0)
-			end = true;
-
-		while (buffer_level > 0) {
-			enum process_result pr =
-					process_nal(pdu, end, (size_t *)&n);
-			if (pr == PROCESS_ERROR)
-				goto err;
-			if (pr == PROCESS_NONE)
-				break;
+		if (n < 0)
+			goto err_thread;
 
-			n = sendto(fd, pdu, AVTP_FULL_HEADER_LEN + n, 0,
-				(struct sockaddr *) &sk_addr, sizeof(sk_addr));
-			if (n < 0) {
-				perror("Failed to send data");
-				goto err;
-			}
+		end = (n == 0);
+
+		while ((len = access_unit_length(offset, end)) > 0) {
+			res = send_access_unit(&buffer[offset], len);
+			if (res < 0)
+				goto err_thread;
+
+			offset += len;
 		}
 
 		if (end)
 			break;
+
+		if (offset == 0 && buffer_level == sizeof(buffer)) {
+			fprintf(stderr, "Access unit bigger than %d bytes\n",
+								BUFFER_SIZE);
+			goto err_thread;
+		}
+
+		/* NAL unit data is sent straight from 'buffer' so it can only
+		 * be compacted once all packets are sent.
+		 */
+		if (wait_packets_sent() < 0)
+			break;
+
+		memmove(buffer, buffer + offset, buffer_level - offset);
+		buffer_level -= offset;
 	}
 
-	close(fd);
-	return 0;
+	atomic_store(&end_of_stream, true);
+	pthread_join(thread, NULL);
+
+	avtp_pool_destroy(pool);
+	close(ctx.fd);
+	return atomic_load(&network_error) ? 1 : 0;
 
+err_thread:
+	atomic_store(&end_of_stream, true);
+	pthread_join(thread, NULL);
+	avtp_pool_destroy(pool);
 err:
-	close(fd);
+	close(ctx.fd);
 	return 1;
 }
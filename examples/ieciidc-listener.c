@@ -37,6 +37,12 @@
  * TSN stream parameters such as destination mac address are passed via
  * command-line arguments. Run 'ieciidc-listener --help' for more information.
  *
+ * Received packets are wrapped in a PDU view, which checks once that the whole
+ * packet was received before any field is read from it.
+ *
+ * Packets are held by a presentation scheduler until their presentation time,
+ * so a single timer is only re-armed when the earliest deadline changes.
+ *
  * This example relies on the system clock to schedule MPEG-TS packets for
  * playback. So make sure the system clock is synchronized with the PTP
  * Hardware Clock (PHC) from your NIC and that the PHC is synchronized with
@@ -52,7 +58,6 @@
  *  ! tsdemux ! decodebin ! videoconvert ! autovideosink
  */
 
-#include <assert.h>
 #include <argp.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
@@ -65,13 +70,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/ioctl.h>
-#include <sys/queue.h>
 #include <sys/timerfd.h>
 #include <unistd.h>
 #include <inttypes.h>
 
 #include "avtp.h"
 #include "avtp_ieciidc.h"
+#include "avtp_inline.h"
+#include "avtp_pdu_view.h"
+#include "avtp_sched.h"
 #include "examples/common.h"
 
 #define STREAM_ID		0xAABBCCDDEEFF0001
@@ -82,14 +89,15 @@
 #define STREAM_DATA_LEN		DATA_LEN + CIP_HEADER_LEN
 #define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + CIP_HEADER_LEN + DATA_LEN)
 
-struct packet_entry {
-	STAILQ_ENTRY(packet_entry) entries;
+/* MPEG-TS packets held by the scheduler until their presentation time. */
+#define MAX_PACKETS		4096
 
-	struct timespec tspec;
+struct packet_entry {
 	uint8_t mpegts_packet[MPEG_TS_PACKET_LEN];
 };
 
-static STAILQ_HEAD(packet_queue, packet_entry) packets;
+static struct avtp_sched *sched;
+static bool present_failed;
 static char ifname[IFNAMSIZ];
 static uint8_t macaddr[ETH_ALEN];
 static uint8_t expected_seq;
@@ -127,9 +135,11 @@ static error_t parser(int key, char *arg, struct argp_state *state)
 static struct argp argp = { options, parser };
 
 /* Schedule 'MPEG-TS packet' to be presented at time specified by 'tspec'. */
-static int schedule_packet(int fd, struct timespec *tspec, uint8_t *mpeg_tsp)
+static int schedule_packet(int fd, struct timespec *tspec,
+						const uint8_t *mpeg_tsp)
 {
 	struct packet_entry *entry;
+	int res;
 
 	entry = malloc(sizeof(*entry));
 	if (!entry) {
@@ -137,171 +147,135 @@ static int schedule_packet(int fd, struct timespec *tspec, uint8_t *mpeg_tsp)
 		return -1;
 	}
 
-	entry->tspec.tv_sec = tspec->tv_sec;
-	entry->tspec.tv_nsec = tspec->tv_nsec;
 	memcpy(entry->mpegts_packet, mpeg_tsp, MPEG_TS_PACKET_LEN);
 
-	STAILQ_INSERT_TAIL(&packets, entry, entries);
-
-	/* If this was the first entry inserted onto the queue, we need to arm
-	 * the timer.
-	 */
-	if (STAILQ_FIRST(&packets) == entry) {
-		int res;
-
-		res = arm_timer(fd, tspec);
-		if (res < 0) {
-			STAILQ_REMOVE(&packets, entry, packet_entry, entries);
-			free(entry);
-			return -1;
-		}
-	}
+	res = schedule_payload(sched, fd, tspec, entry);
+	if (res < 0)
+		free(entry);
 
-	return 0;
+	return res;
 }
 
-static bool is_valid_packet(struct avtp_stream_pdu *pdu)
+/* Dispatch callback from the scheduler, called with packets due. */
+static void present_packets(void *const payloads[], const uint64_t times[],
+					unsigned int count, void *arg)
 {
-	struct avtp_common_pdu *common = (struct avtp_common_pdu *) pdu;
-	uint64_t val64;
-	uint32_t val32;
-	int res;
+	unsigned int i;
 
-	res = avtp_pdu_get(common, AVTP_FIELD_SUBTYPE, &val32);
-	assert(res == 0);
-	if (val32 != AVTP_SUBTYPE_61883_IIDC) {
-		fprintf(stderr, "Subtype mismatch: expected %u, got %u\n",
-						AVTP_SUBTYPE_61883_IIDC, val32);
-		return false;
+	for (i = 0; i < count; i++) {
+		struct packet_entry *entry = payloads[i];
+
+		if (present_data(entry->mpegts_packet, MPEG_TS_PACKET_LEN) < 0)
+			present_failed = true;
+
+		free(entry);
 	}
+}
+
+/* Check the fields fixed for our stream, decoded all at once by the view. */
+static bool is_valid_packet(struct avtp_pdu_view *view)
+{
+	const struct avtp_ieciidc_hdr *hdr = avtp_pdu_view_ieciidc_hdr(view);
+	uint32_t version;
 
-	res = avtp_pdu_get(common, AVTP_FIELD_VERSION, &val32);
-	assert(res == 0);
-	if (val32 != 0) {
+	version = avtp_common_get_version(
+			(const struct avtp_common_pdu *) view->buf);
+	if (version != 0) {
 		fprintf(stderr, "Version mismatch: expected %u, got %u\n",
-								0, val32);
+								0, version);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_TV, &val64);
-	assert(res == 0);
-	if (val64 != 0) {
-		fprintf(stderr, "tv mismatch: expected %u, got %" PRIu64 "\n",
-								0, val64);
+	if (hdr->stream.tv != 0) {
+		fprintf(stderr, "tv mismatch: expected %u, got %u\n",
+							0, hdr->stream.tv);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_STREAM_ID, &val64);
-	assert(res == 0);
-	if (val64 != STREAM_ID) {
+	if (hdr->stream.stream_id != STREAM_ID) {
 		fprintf(stderr, "Stream ID mismatch: expected %" PRIu64
-				", got %" PRIu64 "\n", STREAM_ID, val64);
+				", got %" PRIu64 "\n", STREAM_ID,
+				hdr->stream.stream_id);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_SEQ_NUM, &val64);
-	assert(res == 0);
-
-	if (val64 != expected_seq) {
+	if (hdr->stream.seq_num != expected_seq) {
 		/* If we have a sequence number mismatch, we simply log the
 		 * issue and continue to process the packet. We don't want to
 		 * invalidate it since it is a valid packet after all.
 		 */
-		fprintf(stderr, "Sequence number mismatch: expected %u, got %"
-				PRIu64 "\n", expected_seq, val64);
-		expected_seq = val64;
+		fprintf(stderr, "Sequence number mismatch: expected %u, got "
+				"%u\n", expected_seq, hdr->stream.seq_num);
+		expected_seq = hdr->stream.seq_num;
 	}
 
 	expected_seq++;
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_STREAM_DATA_LEN,
-									&val64);
-	assert(res == 0);
-	if (val64 != STREAM_DATA_LEN) {
-		fprintf(stderr, "Data len mismatch: expected %lu, got %"
-					PRIu64 "\n", STREAM_DATA_LEN, val64);
+	if (hdr->stream.stream_data_len != STREAM_DATA_LEN) {
+		fprintf(stderr, "Data len mismatch: expected %lu, got %u\n",
+				STREAM_DATA_LEN, hdr->stream.stream_data_len);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_TAG, &val64);
-	assert(res == 0);
-	if (val64 != AVTP_IECIIDC_TAG_CIP) {
-		fprintf(stderr, "tag mismatch: expected %u, got %" PRIu64 "\n",
-						AVTP_IECIIDC_TAG_CIP, val64);
+	if (hdr->tag != AVTP_IECIIDC_TAG_CIP) {
+		fprintf(stderr, "tag mismatch: expected %u, got %u\n",
+						AVTP_IECIIDC_TAG_CIP, hdr->tag);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CHANNEL, &val64);
-	assert(res == 0);
-	if (val64 != 31) {
-		fprintf(stderr, "channel mismatch: expected %u, got %" PRIu64
-							"\n", 31, val64);
+	if (hdr->channel != 31) {
+		fprintf(stderr, "channel mismatch: expected %u, got %u\n",
+							31, hdr->channel);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_SID, &val64);
-	assert(res == 0);
-	if (val64 != 63) {
-		fprintf(stderr, "sid mismatch: expected %u, got %" PRIu64 "\n",
-								63, val64);
+	if (hdr->cip_sid != 63) {
+		fprintf(stderr, "sid mismatch: expected %u, got %u\n",
+							63, hdr->cip_sid);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_DBS, &val64);
-	assert(res == 0);
-	if (val64 != 6) {
-		fprintf(stderr, "dbs mismatch: expected %u, got %" PRIu64 "\n",
-								6, val64);
+	if (hdr->cip_dbs != 6) {
+		fprintf(stderr, "dbs mismatch: expected %u, got %u\n",
+							6, hdr->cip_dbs);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_FN, &val64);
-	assert(res == 0);
-	if (val64 != 3) {
-		fprintf(stderr, "fn mismatch: expected %u, got %" PRIu64 "\n",
-								3, val64);
+	if (hdr->cip_fn != 3) {
+		fprintf(stderr, "fn mismatch: expected %u, got %u\n",
+							3, hdr->cip_fn);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_QPC, &val64);
-	assert(res == 0);
-	if (val64 != 0) {
-		fprintf(stderr, "GV mismatch: expected %u, got %" PRIu64 "\n",
-								0, val64);
+	if (hdr->cip_qpc != 0) {
+		fprintf(stderr, "qpc mismatch: expected %u, got %u\n",
+							0, hdr->cip_qpc);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_SPH, &val64);
-	assert(res == 0);
-	if (val64 != 1) {
-		fprintf(stderr, "sph mismatch: expected %u, got %" PRIu64 "\n",
-								1, val64);
+	if (hdr->cip_sph != 1) {
+		fprintf(stderr, "sph mismatch: expected %u, got %u\n",
+							1, hdr->cip_sph);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_FMT, &val64);
-	assert(res == 0);
-	if (val64 != 32) {
-		fprintf(stderr, "fmt mismatch: expected %u, got %" PRIu64 "\n",
-								32, val64);
+	if (hdr->cip_fmt != 32) {
+		fprintf(stderr, "fmt mismatch: expected %u, got %u\n",
+							32, hdr->cip_fmt);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_TSF, &val64);
-	assert(res == 0);
-	if (val64 != 0) {
-		fprintf(stderr, "tsf mismatch: expected %u, got %" PRIu64 "\n",
-								0, val64);
+	if (hdr->cip_tsf != 0) {
+		fprintf(stderr, "tsf mismatch: expected %u, got %u\n",
+							0, hdr->cip_tsf);
 		return false;
 	}
 
-	res = avtp_ieciidc_pdu_get(pdu, AVTP_IECIIDC_FIELD_CIP_DBC, &val64);
-	assert(res == 0);
-	if (val64 != expected_dbc) {
+	if (hdr->cip_dbc != expected_dbc) {
 		/* As with sequence mismatch, we'll not discard this packet,
 		 * only log that the mismatch happened */
-		fprintf(stderr, "dbc mismatch: expected %u, got %" PRIu64 "\n",
-							expected_dbc, val64);
+		fprintf(stderr, "dbc mismatch: expected %u, got %u\n",
+						expected_dbc, hdr->cip_dbc);
 	}
 	expected_dbc += 8;
 
@@ -312,27 +286,31 @@ static int new_packet(int sk_fd, int timer_fd)
 {
 	int res;
 	ssize_t n;
+	size_t len;
 	uint32_t avtp_time;
 	struct timespec tspec;
-	struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
-	struct avtp_ieciidc_cip_payload *pay =
-			(struct avtp_ieciidc_cip_payload *) pdu->avtp_payload;
-	struct avtp_ieciidc_cip_source_packet *sp =
-		(struct avtp_ieciidc_cip_source_packet *) pay->cip_data_payload;
-
-	memset(pdu, 0, PDU_SIZE);
+	struct avtp_pdu_view view;
+	const struct avtp_ieciidc_cip_source_packet *sp;
+	uint8_t pdu[PDU_SIZE];
 
 	n = recv(sk_fd, pdu, PDU_SIZE, 0);
-	if (n < 0 || n != PDU_SIZE) {
+	if (n < 0) {
 		perror("Failed to receive data");
 		return -1;
 	}
 
-	if (!is_valid_packet(pdu)) {
+	/* The view checks once that the whole PDU, CIP header included, was
+	 * received, so fields and payload can be read with no further checks.
+	 */
+	res = avtp_pdu_view_init(&view, pdu, n, AVTP_SUBTYPE_61883_IIDC);
+	if (res < 0 || !is_valid_packet(&view)) {
 		fprintf(stderr, "Dropping packet\n");
 		return 0;
 	}
 
+	sp = (const struct avtp_ieciidc_cip_source_packet *)
+					avtp_pdu_view_data(&view, &len);
+
 	/* There are no helpers for payload fields, so one must remember
 	 * of byte ordering */
 	avtp_time = ntohl(sp->avtp_source_packet_header_timestamp);
@@ -351,35 +329,10 @@ static int new_packet(int sk_fd, int timer_fd)
 static int timeout(int fd)
 {
 	int res;
-	ssize_t n;
-	uint64_t expirations;
-	struct packet_entry *entry;
 
-	n = read(fd, &expirations, sizeof(uint64_t));
-	if (n < 0) {
-		perror("Failed to read timerfd");
+	res = dispatch_payloads(sched, fd);
+	if (res < 0 || present_failed)
 		return -1;
-	}
-
-	assert(expirations == 1);
-
-	entry = STAILQ_FIRST(&packets);
-	assert(entry != NULL);
-
-	res = present_data(entry->mpegts_packet, MPEG_TS_PACKET_LEN);
-	if (res < 0)
-		return -1;
-
-	STAILQ_REMOVE_HEAD(&packets, entries);
-	free(entry);
-
-	if (!STAILQ_EMPTY(&packets)) {
-		entry = STAILQ_FIRST(&packets);
-
-		res = arm_timer(fd, &entry->tspec);
-		if (res < 0)
-			return -1;
-	}
 
 	return 0;
 }
@@ -391,15 +344,22 @@ int main(int argc, char *argv[])
 
 	argp_parse(&argp, argc, argv, 0, NULL, NULL);
 
-	STAILQ_INIT(&packets);
+	res = avtp_sched_create(&sched, MAX_PACKETS, present_packets, NULL);
+	if (res < 0) {
+		fprintf(stderr, "Failed to create scheduler: %d\n", res);
+		return 1;
+	}
 
 	sk_fd = create_listener_socket(ifname, macaddr, ETH_P_TSN);
-	if (sk_fd < 0)
+	if (sk_fd < 0) {
+		avtp_sched_destroy(sched);
 		return 1;
+	}
 
 	timer_fd = timerfd_create(CLOCK_REALTIME, 0);
 	if (timer_fd < 0) {
 		close(sk_fd);
+		avtp_sched_destroy(sched);
 		return 1;
 	}
 
@@ -433,5 +393,6 @@ int main(int argc, char *argv[])
 err:
 	close(sk_fd);
 	close(timer_fd);
+	avtp_sched_destroy(sched);
 	return 1;
 }
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Fuzz target for the ACF message iterator and message unpack functions.
+ *
+ * The input is a received TSCF or NTSCF PDU. Its ACF messages are walked
+ * with the iterator and each one is unpacked as a CAN or LIN message, and
+ * its fields are read, depending on its type. Seeds are PDUs bundling
+ * several messages, built by the ACF aggregator.
+ */
+
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_acf.h"
+#include "avtp_tscf.h"
+
+#include "fuzz.h"
+
+#define MAX_PDU_SIZE	512
+
+static uint64_t read_can(const struct avtp_acf_msg *msg, size_t len)
+{
+	struct avtp_acf_can_hdr hdr;
+	const uint8_t *data;
+	uint64_t val, sum = 0;
+	size_t data_len, i;
+	int f;
+
+	if (avtp_acf_can_unpack(msg, len, &hdr, &data, &data_len) < 0)
+		return 0;
+
+	for (i = 0; i < data_len; i++)
+		sum += data[i];
+
+	/* Field getters read the fixed part of the header, which unpack
+	 * checked to be there.
+	 */
+	for (f = 0; f <= AVTP_ACF_CAN_FIELD_MAX; f++) {
+		if (avtp_acf_can_get(msg, (enum avtp_acf_can_field) f,
+								&val) == 0)
+			sum += val;
+	}
+
+	return sum + hdr.can_identifier + hdr.message_timestamp;
+}
+
+static uint64_t read_lin(const struct avtp_acf_msg *msg, size_t len)
+{
+	struct avtp_acf_lin_hdr hdr;
+	const uint8_t *data;
+	uint64_t val, sum = 0;
+	size_t data_len, i;
+	int f;
+
+	if (avtp_acf_lin_unpack(msg, len, &hdr, &data, &data_len) < 0)
+		return 0;
+
+	for (i = 0; i < data_len; i++)
+		sum += data[i];
+
+	for (f = 0; f <= AVTP_ACF_LIN_FIELD_MAX; f++) {
+		if (avtp_acf_lin_get(msg, (enum avtp_acf_lin_field) f,
+								&val) == 0)
+			sum += val;
+	}
+
+	return sum + hdr.lin_identifier + hdr.message_timestamp;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	const struct avtp_acf_msg *msg;
+	struct avtp_acf_iter iter;
+	uint64_t type, sum = 0;
+	size_t len;
+
+	if (avtp_acf_iter_init(&iter, data, size) < 0)
+		return 0;
+
+	while (avtp_acf_iter_next(&iter, &msg, &len) == 1) {
+		if (avtp_acf_msg_get(msg, AVTP_ACF_FIELD_MSG_TYPE, &type) < 0)
+			__builtin_trap();
+
+		switch (type) {
+		case AVTP_ACF_TYPE_CAN:
+		case AVTP_ACF_TYPE_CAN_BRIEF:
+			sum += read_can(msg, len);
+			break;
+		case AVTP_ACF_TYPE_LIN:
+			sum += read_lin(msg, len);
+			break;
+		}
+	}
+
+	fuzz_keep(sum);
+
+	return 0;
+}
+
+static void add_pdu(fuzz_add_fn add, void *arg, const void *tmpl)
+{
+	static const uint8_t data[AVTP_ACF_CAN_FD_MAX_DATA_LEN] = {
+		0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02, 0x03, 0x04, 0x05,
+	};
+	const struct avtp_acf_can_hdr can = {
+		.message_timestamp = 0x0102030405060708,
+		.can_identifier = 0x123,
+		.mtv = 1,
+		.can_bus_id = 1,
+	};
+	const struct avtp_acf_can_hdr can_brief = {
+		.can_identifier = 0x1ABCDEF,
+		.brief = 1,
+		.eff = 1,
+		.can_bus_id = 2,
+	};
+	const struct avtp_acf_can_hdr can_fd = {
+		.can_identifier = 0x456,
+		.fdf = 1,
+		.brs = 1,
+		.can_bus_id = 3,
+	};
+	const struct avtp_acf_lin_hdr lin = {
+		.message_timestamp = 0x0102030405060708,
+		.mtv = 1,
+		.lin_bus_id = 1,
+		.lin_identifier = 0x10,
+	};
+	uint8_t pdu[MAX_PDU_SIZE];
+	struct avtp_acf_agg agg;
+	int len;
+
+	if (avtp_acf_agg_init(&agg, tmpl, sizeof(pdu), 1000) < 0 ||
+			avtp_acf_agg_start(&agg, pdu, sizeof(pdu)) < 0)
+		return;
+
+	avtp_acf_agg_add_can(&agg, &can, data, 8, 0);
+	avtp_acf_agg_add_can(&agg, &can_brief, data, 3, 0);
+	avtp_acf_agg_add_can(&agg, &can_fd, data, 64, 0);
+	avtp_acf_agg_add_lin(&agg, &lin, data, 5, 0);
+	avtp_acf_agg_add_can(&agg, &can, data, 0, 0);
+
+	len = avtp_acf_agg_finish(&agg, 0x80C0FFEE);
+	if (len > 0)
+		add(pdu, len, arg);
+}
+
+void fuzz_seeds(fuzz_add_fn add, void *arg)
+{
+	const struct avtp_tscf_hdr tscf = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = 0xAABBCCDDEEFF0001,
+		},
+	};
+	const struct avtp_ntscf_hdr ntscf = {
+		.sv = 1,
+		.stream_id = 0xAABBCCDDEEFF0001,
+	};
+	struct avtp_stream_pdu tscf_tmpl;
+	struct avtp_ntscf_pdu ntscf_tmpl;
+
+	if (avtp_tscf_pdu_pack(&tscf_tmpl, &tscf) == 0)
+		add_pdu(add, arg, &tscf_tmpl);
+
+	if (avtp_ntscf_pdu_pack(&ntscf_tmpl, &ntscf) == 0)
+		add_pdu(add, arg, &ntscf_tmpl);
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Fuzz target for the H.264 depacketizer.
+ *
+ * The input is a sequence of records (see fuzz_next_record()), each one a
+ * received CVF H.264 PDU, pushed in order into a depacketizer with a small
+ * arena so running out of room is exercised too. Every frame completed is
+ * read as a whole and released right away. Seeds are access units split by
+ * the H.264 packetizer into Single NAL Unit and FU-A packets, plus a STAP-A
+ * packet.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_cvf.h"
+
+#include "fuzz.h"
+
+#define ARENA_SIZE	4096
+#define TMPL_LEN	(sizeof(struct avtp_stream_pdu) + \
+					sizeof(struct avtp_cvf_h264_payload))
+/* Small PDUs so NAL units from seeds are fragmented. */
+#define MAX_PDU_SIZE	(TMPL_LEN + 64)
+#define MAX_SEED_LEN	4096
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_frame frame;
+	const uint8_t *rec;
+	uint64_t sum = 0;
+	int len;
+
+	if (avtp_cvf_h264_depacketizer_create(&depkt, ARENA_SIZE) < 0)
+		return 0;
+
+	while ((len = fuzz_next_record(&data, &size, &rec)) >= 0) {
+		/* Copy the PDU to a buffer of its exact size so sanitizers
+		 * catch reads past its end.
+		 */
+		uint8_t *pdu = malloc(len ? len : 1);
+		size_t i;
+
+		if (!pdu)
+			break;
+
+		memcpy(pdu, rec, len);
+
+		if (avtp_cvf_h264_depacketizer_push(depkt,
+				(struct avtp_stream_pdu *) pdu, len,
+				&frame) == 1) {
+			for (i = 0; i < frame.len; i++)
+				sum += frame.data[i];
+			sum += frame.lost_pdus + frame.dropped_frames;
+
+			if (avtp_cvf_h264_depacketizer_release(depkt,
+							&frame) < 0)
+				__builtin_trap();
+		}
+
+		free(pdu);
+	}
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+	fuzz_keep(sum);
+
+	return 0;
+}
+
+static int init_tmpl(uint8_t *tmpl)
+{
+	const struct avtp_cvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = 0xAABBCCDDEEFF0001,
+		},
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_H264,
+		.h264_ptv = 1,
+	};
+
+	return avtp_cvf_pdu_pack((struct avtp_stream_pdu *) tmpl, &hdr);
+}
+
+/* Split 'count' access units into PDUs, one record each. */
+static void add_aus(fuzz_add_fn add, void *arg,
+			const uint8_t *const aus[], const size_t lens[],
+			unsigned int count)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	uint8_t tmpl[TMPL_LEN];
+	uint8_t seed[MAX_SEED_LEN];
+	uint8_t pdu[MAX_PDU_SIZE];
+	size_t len = 0;
+	unsigned int i;
+
+	if (init_tmpl(tmpl) < 0 ||
+			avtp_cvf_h264_packetizer_init(&pkt,
+				(struct avtp_stream_pdu *) tmpl,
+				MAX_PDU_SIZE) < 0)
+		return;
+
+	for (i = 0; i < count; i++) {
+		if (avtp_cvf_h264_packetizer_start(&pkt, aus[i], lens[i],
+					i * 3000000, i * 3000) < 0)
+			return;
+
+		while (avtp_cvf_h264_packetizer_next(&pkt, &packet) == 1) {
+			size_t hdr_len = packet.iov[0].iov_len;
+			size_t data_len = packet.iov[1].iov_len;
+
+			if (len + 2 + hdr_len + data_len > sizeof(seed))
+				return;
+
+			memcpy(pdu, packet.iov[0].iov_base, hdr_len);
+			memcpy(pdu + hdr_len, packet.iov[1].iov_base,
+								data_len);
+			fuzz_add_record(seed, &len, pdu, hdr_len + data_len);
+		}
+	}
+
+	add(seed, len, arg);
+}
+
+void fuzz_seeds(fuzz_add_fn add, void *arg)
+{
+	/* SPS (4-byte start code), PPS and a small IDR slice. */
+	static const uint8_t small_au[] = {
+		0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1F,
+		0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C, 0x80,
+		0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00, 0x33,
+	};
+	static const uint8_t stap[] = {
+		0x78, 0x00, 0x02, 0x67, 0x42, 0x00, 0x03, 0x68, 0xCE, 0x3C,
+	};
+	uint8_t large_au[3 + 200];
+	const uint8_t *aus[] = { small_au, large_au, small_au };
+	const size_t lens[] = {
+		sizeof(small_au), sizeof(large_au), sizeof(small_au),
+	};
+	uint8_t pdu[TMPL_LEN + sizeof(stap)];
+	uint8_t seed[2 + sizeof(pdu)];
+	size_t len = 0;
+	unsigned int i;
+
+	/* Non-IDR slice fragmented into several FU-A packets. */
+	large_au[0] = 0x00;
+	large_au[1] = 0x00;
+	large_au[2] = 0x01;
+	large_au[3] = 0x41;
+	for (i = 4; i < sizeof(large_au); i++)
+		large_au[i] = i;
+
+	add_aus(add, arg, aus, lens, 1);
+	add_aus(add, arg, aus, lens, 3);
+
+	if (init_tmpl(pdu) < 0)
+		return;
+
+	avtp_cvf_pdu_set((struct avtp_stream_pdu *) pdu,
+			AVTP_CVF_FIELD_STREAM_DATA_LEN,
+			sizeof(struct avtp_cvf_h264_payload) + sizeof(stap));
+	avtp_cvf_pdu_set((struct avtp_stream_pdu *) pdu, AVTP_CVF_FIELD_M, 1);
+	memcpy(pdu + TMPL_LEN, stap, sizeof(stap));
+	fuzz_add_record(seed, &len, pdu, sizeof(pdu));
+	add(seed, len, arg);
+}
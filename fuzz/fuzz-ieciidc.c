@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Fuzz target for the IEC 61883/IIDC CIP header parser and the AM824
+ * decoder.
+ *
+ * The input is a received IEC 61883/IIDC PDU. Once the view accepts it, its
+ * CIP header is decoded both through the view and by the unpack function,
+ * and the data blocks are decoded into samples as AM824, with the data block
+ * size from the CIP header, once with every quadlet carrying a channel and
+ * once with a single channel per block. Seeds are AM824 packets built by the
+ * AM824 encoder, NO-DATA packets included.
+ */
+
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_ieciidc.h"
+#include "avtp_pdu_view.h"
+
+#include "fuzz.h"
+
+#define MAX_SAMPLES	1024
+#define SEED_CHANNELS	2
+#define SEED_FRAMES	8
+
+static uint64_t decode(const struct avtp_ieciidc_hdr *hdr,
+				const uint8_t *data, uint8_t channels)
+{
+	int32_t samples[MAX_SAMPLES];
+	struct avtp_ieciidc_am824 am;
+	int frames;
+
+	if (avtp_ieciidc_am824_init(&am, hdr->cip_sfc, hdr->cip_dbs,
+							channels) < 0)
+		return 0;
+
+	frames = avtp_ieciidc_am824_decode(&am, hdr, data, samples,
+						MAX_SAMPLES / channels);
+	if (frames <= 0)
+		return 0;
+
+	return (uint32_t) samples[0] +
+			(uint32_t) samples[frames * channels - 1];
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	const struct avtp_ieciidc_hdr *hdr;
+	struct avtp_ieciidc_hdr unpacked;
+	struct avtp_pdu_view view;
+	const uint8_t *payload;
+	uint64_t sum = 0;
+	size_t len;
+
+	if (avtp_pdu_view_init(&view, data, size,
+					AVTP_SUBTYPE_61883_IIDC) < 0)
+		return 0;
+
+	hdr = avtp_pdu_view_ieciidc_hdr(&view);
+	if (!hdr)
+		__builtin_trap();
+
+	/* The view decodes the same fields as the unpack function. */
+	if (avtp_ieciidc_pdu_unpack(avtp_pdu_view_stream(&view),
+							&unpacked) < 0 ||
+			unpacked.stream.stream_data_len !=
+					hdr->stream.stream_data_len ||
+			unpacked.cip_dbs != hdr->cip_dbs ||
+			unpacked.cip_syt != hdr->cip_syt)
+		__builtin_trap();
+
+	payload = avtp_pdu_view_data(&view, &len);
+
+	/* The view only checked the header and the data length, the AM824
+	 * decoder checks everything else.
+	 */
+	sum += decode(hdr, payload, hdr->cip_dbs ? hdr->cip_dbs : 1);
+	sum += decode(hdr, payload, 1);
+	sum += hdr->cip_syt + hdr->cip_dbc;
+
+	fuzz_keep(sum);
+
+	return 0;
+}
+
+static void add_packet(fuzz_add_fn add, void *arg,
+				struct avtp_ieciidc_am824 *am,
+				const int32_t *samples, unsigned int frames)
+{
+	uint8_t pdu[sizeof(struct avtp_stream_pdu) +
+			sizeof(struct avtp_ieciidc_cip_payload) +
+			SEED_FRAMES * SEED_CHANNELS * 4 * 2];
+	struct avtp_ieciidc_hdr hdr = {
+		.stream = {
+			.stream_id = 0xAABBCCDDEEFF0001,
+			.sv = 1,
+			.tv = 1,
+		},
+		.tag = AVTP_IECIIDC_TAG_CIP,
+		.tcode = 0x0A,
+		.cip_qi_2 = 2,
+	};
+	struct avtp_ieciidc_cip_payload *cip;
+
+	memset(pdu, 0, sizeof(pdu));
+	cip = (struct avtp_ieciidc_cip_payload *)
+			((struct avtp_stream_pdu *) pdu)->avtp_payload;
+
+	if (avtp_ieciidc_am824_encode(am, &hdr, cip->cip_data_payload,
+				samples, frames, 1000000000) < 0 ||
+			avtp_ieciidc_pdu_pack((struct avtp_stream_pdu *) pdu,
+								&hdr) < 0)
+		return;
+
+	add(pdu, sizeof(struct avtp_stream_pdu) + hdr.stream.stream_data_len,
+									arg);
+}
+
+void fuzz_seeds(fuzz_add_fn add, void *arg)
+{
+	int32_t samples[SEED_FRAMES * SEED_CHANNELS];
+	struct avtp_ieciidc_am824 am;
+	unsigned int i;
+
+	for (i = 0; i < SEED_FRAMES * SEED_CHANNELS; i++)
+		samples[i] = (int32_t) (i * 0x12345678);
+
+	/* Data blocks carrying only audio channels. */
+	if (avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ,
+					SEED_CHANNELS, SEED_CHANNELS) == 0) {
+		add_packet(add, arg, &am, samples, SEED_FRAMES);
+		add_packet(add, arg, &am, samples, 0);
+	}
+
+	/* Data blocks with room for other quadlets past the channels. */
+	if (avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_96KHZ,
+				SEED_CHANNELS * 2, SEED_CHANNELS) == 0)
+		add_packet(add, arg, &am, samples, SEED_FRAMES);
+}
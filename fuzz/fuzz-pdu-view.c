@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Fuzz target for PDU views and the format data decoders relying on them.
+ *
+ * The input is a received PDU, viewed with the subtype from its first byte.
+ * Once the view accepts it, everything the view API allows to be read
+ * without further checks is read: inline accessors, lazily decoded headers
+ * and every byte of the format data. AAF samples and CRF timestamps are
+ * decoded from the format data as well, bounded by its length.
+ */
+
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_crf.h"
+#include "avtp_inline.h"
+#include "avtp_pdu_view.h"
+
+#include "fuzz.h"
+
+/* Frames decoded per call and CRF timestamps decoded per PDU. */
+#define MAX_SAMPLES	1024
+#define MAX_TIMESTAMPS	64
+#define MAX_OUTLIERS	4
+/* CRF timestamps carried by the seed. */
+#define CRF_TIMESTAMPS	6
+
+static uint64_t decode_aaf(const struct avtp_stream_pdu *pdu,
+					const uint8_t *data, size_t len)
+{
+	int32_t samples[MAX_SAMPLES];
+	struct avtp_aaf_hdr hdr;
+	unsigned int width, frames, last;
+	int res;
+
+	if (avtp_aaf_pdu_unpack(pdu, &hdr) < 0 || hdr.chan_per_frame == 0)
+		return 0;
+
+	switch (hdr.format) {
+	case AVTP_AAF_FORMAT_INT_16BIT:
+		width = 2;
+		break;
+	case AVTP_AAF_FORMAT_INT_24BIT:
+		width = 3;
+		break;
+	case AVTP_AAF_FORMAT_INT_32BIT:
+	case AVTP_AAF_FORMAT_FLOAT_32BIT:
+		width = 4;
+		break;
+	default:
+		return 0;
+	}
+
+	if (hdr.chan_per_frame > MAX_SAMPLES)
+		return 0;
+
+	frames = len / (width * hdr.chan_per_frame);
+	if (frames > MAX_SAMPLES / hdr.chan_per_frame)
+		frames = MAX_SAMPLES / hdr.chan_per_frame;
+
+	res = avtp_aaf_pcm_decode(&hdr, data, samples, AVTP_AAF_PCM_SAMPLE_S32,
+									frames);
+	if (res <= 0)
+		return 0;
+
+	last = frames * hdr.chan_per_frame - 1;
+
+	return (uint32_t) samples[0] + (uint32_t) samples[last];
+}
+
+static uint64_t decode_crf(const struct avtp_crf_pdu *pdu, size_t len)
+{
+	unsigned int outliers[MAX_OUTLIERS];
+	uint64_t ts[MAX_TIMESTAMPS];
+	struct avtp_crf_hdr hdr;
+	unsigned int count;
+	int res;
+
+	if (avtp_crf_pdu_unpack(pdu, &hdr) < 0)
+		return 0;
+
+	count = len / sizeof(uint64_t);
+	if (count > MAX_TIMESTAMPS)
+		count = MAX_TIMESTAMPS;
+	if (count == 0)
+		return 0;
+
+	res = avtp_crf_data_decode(ts, pdu->crf_data, count, &hdr, outliers,
+								MAX_OUTLIERS);
+	if (res < 0)
+		return 0;
+
+	return ts[0] + ts[count - 1] + res;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	const struct avtp_ieciidc_hdr *ieciidc;
+	const struct avtp_stream_pdu *pdu;
+	const struct avtp_cvf_hdr *cvf;
+	const struct avtp_rvf_hdr *rvf;
+	struct avtp_pdu_view view;
+	const uint8_t *payload;
+	uint64_t sum = 0;
+	size_t len, i;
+
+	if (size == 0)
+		return 0;
+
+	if (avtp_pdu_view_init(&view, data, size, data[0]) < 0)
+		return 0;
+
+	payload = avtp_pdu_view_data(&view, &len);
+	for (i = 0; i < len; i++)
+		sum += payload[i];
+
+	pdu = avtp_pdu_view_stream(&view);
+
+	switch (data[0]) {
+	case AVTP_SUBTYPE_CRF:
+		sum += avtp_crf_get_stream_id(avtp_pdu_view_crf(&view));
+		sum += avtp_crf_get_base_freq(avtp_pdu_view_crf(&view));
+		sum += decode_crf(avtp_pdu_view_crf(&view), len);
+		break;
+	case AVTP_SUBTYPE_NTSCF:
+		sum += avtp_ntscf_get_stream_id(avtp_pdu_view_ntscf(&view));
+		sum += avtp_ntscf_get_data_len(avtp_pdu_view_ntscf(&view));
+		break;
+	case AVTP_SUBTYPE_AAF:
+		sum += avtp_aaf_get_format(pdu);
+		sum += decode_aaf(pdu, payload, len);
+		break;
+	case AVTP_SUBTYPE_CVF:
+		cvf = avtp_pdu_view_cvf_hdr(&view);
+		if (cvf)
+			sum += cvf->h264_timestamp + cvf->format_subtype;
+		/* Second call returns the cached header. */
+		if (avtp_pdu_view_cvf_hdr(&view) != cvf)
+			__builtin_trap();
+		break;
+	case AVTP_SUBTYPE_RVF:
+		rvf = avtp_pdu_view_rvf_hdr(&view);
+		if (rvf)
+			sum += rvf->raw_line_number + rvf->raw_num_lines;
+		break;
+	case AVTP_SUBTYPE_61883_IIDC:
+		ieciidc = avtp_pdu_view_ieciidc_hdr(&view);
+		if (ieciidc)
+			sum += ieciidc->cip_syt + ieciidc->cip_dbs;
+		break;
+	}
+
+	if (data[0] != AVTP_SUBTYPE_CRF && data[0] != AVTP_SUBTYPE_NTSCF) {
+		sum += avtp_stream_get_stream_id(pdu);
+		sum += avtp_stream_get_timestamp(pdu);
+		sum += avtp_stream_get_seq_num(pdu);
+		sum += avtp_stream_get_stream_data_len(pdu);
+	}
+
+	fuzz_keep(sum);
+
+	return 0;
+}
+
+void fuzz_seeds(fuzz_add_fn add, void *arg)
+{
+	const struct avtp_stream_hdr stream = {
+		.stream_id = 0xAABBCCDDEEFF0001,
+		.timestamp = 0x80C0FFEE,
+		.sv = 1,
+		.tv = 1,
+		.seq_num = 0x55,
+	};
+	struct avtp_aaf_hdr aaf = {
+		.stream = stream,
+		.format = AVTP_AAF_FORMAT_INT_24BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 24,
+	};
+	struct avtp_cvf_hdr cvf = {
+		.stream = stream,
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_H264,
+		.m = 1,
+		.h264_ptv = 1,
+		.h264_timestamp = 0x12345678,
+	};
+	struct avtp_rvf_hdr rvf = {
+		.stream = stream,
+		.active_pixels = 8,
+		.total_lines = 4,
+		.ap = 1,
+		.raw_pixel_depth = 8,
+		.raw_num_lines = 1,
+		.raw_line_number = 1,
+	};
+	struct avtp_ieciidc_hdr ieciidc = {
+		.stream = stream,
+		.tag = AVTP_IECIIDC_TAG_CIP,
+		.tcode = 0x0A,
+		.cip_qi_2 = 2,
+		.cip_dbs = 2,
+		.cip_fmt = 0x10,
+		.cip_sfc = AVTP_IECIIDC_SFC_48KHZ,
+		.cip_syt = 0x1234,
+	};
+	struct avtp_crf_hdr crf = {
+		.stream_id = stream.stream_id,
+		.base_freq = 48000,
+		.timestamp_interval = 160,
+		.sv = 1,
+	};
+	struct avtp_ntscf_hdr ntscf = {
+		.stream_id = stream.stream_id,
+		.sv = 1,
+	};
+	struct avtp_tscf_hdr tscf = { .stream = stream };
+	const int32_t frames[] = { 0x7FFFFF00, -0x100, 0x12345600, 0 };
+	uint8_t buf[128];
+
+	memset(buf, 0, sizeof(buf));
+	aaf.stream.stream_data_len = avtp_aaf_pcm_encode(&aaf,
+			buf + sizeof(struct avtp_stream_pdu), frames,
+			AVTP_AAF_PCM_SAMPLE_S32, 2);
+	avtp_aaf_pdu_pack((struct avtp_stream_pdu *) buf, &aaf);
+	add(buf, sizeof(struct avtp_stream_pdu) + aaf.stream.stream_data_len,
+									arg);
+
+	/* H.264 header plus a small IDR slice NAL unit. */
+	memset(buf, 0, sizeof(buf));
+	cvf.stream.stream_data_len = sizeof(struct avtp_cvf_h264_payload) + 4;
+	avtp_cvf_pdu_pack((struct avtp_stream_pdu *) buf, &cvf);
+	memcpy(buf + sizeof(struct avtp_stream_pdu) +
+			sizeof(struct avtp_cvf_h264_payload),
+			"\x65\x88\x84\x00", 4);
+	add(buf, sizeof(struct avtp_stream_pdu) + cvf.stream.stream_data_len,
+									arg);
+
+	/* One line of 8 monochrome pixels. */
+	memset(buf, 0, sizeof(buf));
+	rvf.stream.stream_data_len = sizeof(struct avtp_rvf_payload) + 8;
+	avtp_rvf_pdu_pack((struct avtp_stream_pdu *) buf, &rvf);
+	add(buf, sizeof(struct avtp_stream_pdu) + rvf.stream.stream_data_len,
+									arg);
+
+	/* CIP header plus two AM824 data blocks. */
+	memset(buf, 0, sizeof(buf));
+	ieciidc.stream.stream_data_len =
+			sizeof(struct avtp_ieciidc_cip_payload) + 16;
+	avtp_ieciidc_pdu_pack((struct avtp_stream_pdu *) buf, &ieciidc);
+	add(buf, sizeof(struct avtp_stream_pdu) +
+				ieciidc.stream.stream_data_len, arg);
+
+	memset(buf, 0, sizeof(buf));
+	crf.crf_data_len = CRF_TIMESTAMPS * sizeof(uint64_t);
+	avtp_crf_pdu_pack((struct avtp_crf_pdu *) buf, &crf);
+	avtp_crf_data_encode(buf + sizeof(struct avtp_crf_pdu), CRF_TIMESTAMPS,
+							1000000000, &crf);
+	add(buf, sizeof(struct avtp_crf_pdu) + crf.crf_data_len, arg);
+
+	memset(buf, 0, sizeof(buf));
+	ntscf.data_len = 16;
+	avtp_ntscf_pdu_pack((struct avtp_ntscf_pdu *) buf, &ntscf);
+	add(buf, sizeof(struct avtp_ntscf_pdu) + 16, arg);
+
+	memset(buf, 0, sizeof(buf));
+	tscf.stream.stream_data_len = 16;
+	avtp_tscf_pdu_pack((struct avtp_stream_pdu *) buf, &tscf);
+	add(buf, sizeof(struct avtp_stream_pdu) + 16, arg);
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Fuzz target for the PDU field getters and unpack functions of all formats.
+ *
+ * These functions read a fixed size header and never look at data lengths,
+ * so the input is copied to a zero-padded buffer covering the largest header
+ * (see avtp_pdu_view.h for checking received lengths first). Every getter is
+ * called for every field, including invalid field values, along with the
+ * unpack functions, no matter the subtype.
+ */
+
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_ieciidc.h"
+#include "avtp_rvf.h"
+#include "avtp_tscf.h"
+
+#include "fuzz.h"
+
+/* Largest header read by any getter: RVF RAW and CIP headers live in the
+ * first 8 bytes of the AVTPDU payload.
+ */
+#define HDR_LEN		(sizeof(struct avtp_stream_pdu) + sizeof(uint64_t))
+
+/* Call 'get' for fields 0 to 'max', 'max' included to cover invalid fields,
+ * summing up the values retrieved.
+ */
+#define GET_ALL(get, type, pdu, max)					\
+	do {								\
+		uint64_t val;						\
+		int f;							\
+									\
+		for (f = 0; f <= (max); f++) {				\
+			if (get((pdu), (type) f, &val) == 0)		\
+				sum += val;				\
+		}							\
+	} while (0)
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	uint8_t buf[HDR_LEN] = { 0 };
+	const struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) buf;
+	const struct avtp_common_pdu *common = (struct avtp_common_pdu *) buf;
+	const struct avtp_crf_pdu *crf = (struct avtp_crf_pdu *) buf;
+	const struct avtp_ntscf_pdu *ntscf = (struct avtp_ntscf_pdu *) buf;
+	struct avtp_ieciidc_hdr ieciidc_hdr;
+	struct avtp_ntscf_hdr ntscf_hdr;
+	struct avtp_tscf_hdr tscf_hdr;
+	struct avtp_aaf_hdr aaf_hdr;
+	struct avtp_cvf_hdr cvf_hdr;
+	struct avtp_rvf_hdr rvf_hdr;
+	struct avtp_crf_hdr crf_hdr;
+	uint64_t sum = 0;
+	uint32_t val;
+	int f;
+
+	memcpy(buf, data, size < sizeof(buf) ? size : sizeof(buf));
+
+	for (f = 0; f <= AVTP_FIELD_MAX; f++) {
+		if (avtp_pdu_get(common, (enum avtp_field) f, &val) == 0)
+			sum += val;
+	}
+
+	GET_ALL(avtp_aaf_pdu_get, enum avtp_aaf_field, pdu,
+							AVTP_AAF_FIELD_MAX);
+	GET_ALL(avtp_cvf_pdu_get, enum avtp_cvf_field, pdu,
+							AVTP_CVF_FIELD_MAX);
+	GET_ALL(avtp_rvf_pdu_get, enum avtp_rvf_field, pdu,
+							AVTP_RVF_FIELD_MAX);
+	GET_ALL(avtp_ieciidc_pdu_get, enum avtp_ieciidc_field, pdu,
+						AVTP_IECIIDC_FIELD_MAX);
+	GET_ALL(avtp_tscf_pdu_get, enum avtp_tscf_field, pdu,
+							AVTP_TSCF_FIELD_MAX);
+	GET_ALL(avtp_ntscf_pdu_get, enum avtp_ntscf_field, ntscf,
+							AVTP_NTSCF_FIELD_MAX);
+	GET_ALL(avtp_crf_pdu_get, enum avtp_crf_field, crf,
+							AVTP_CRF_FIELD_MAX);
+
+	if (avtp_aaf_pdu_unpack(pdu, &aaf_hdr) == 0)
+		sum += aaf_hdr.stream.stream_data_len + aaf_hdr.format;
+	if (avtp_cvf_pdu_unpack(pdu, &cvf_hdr) == 0)
+		sum += cvf_hdr.stream.stream_data_len + cvf_hdr.h264_timestamp;
+	if (avtp_rvf_pdu_unpack(pdu, &rvf_hdr) == 0)
+		sum += rvf_hdr.stream.stream_data_len + rvf_hdr.raw_num_lines;
+	if (avtp_ieciidc_pdu_unpack(pdu, &ieciidc_hdr) == 0)
+		sum += ieciidc_hdr.stream.stream_data_len + ieciidc_hdr.cip_syt;
+	if (avtp_tscf_pdu_unpack(pdu, &tscf_hdr) == 0)
+		sum += tscf_hdr.stream.stream_data_len;
+	if (avtp_ntscf_pdu_unpack(ntscf, &ntscf_hdr) == 0)
+		sum += ntscf_hdr.data_len;
+	if (avtp_crf_pdu_unpack(crf, &crf_hdr) == 0)
+		sum += crf_hdr.crf_data_len + crf_hdr.base_freq;
+
+	fuzz_keep(sum);
+
+	return 0;
+}
+
+void fuzz_seeds(fuzz_add_fn add, void *arg)
+{
+	const struct avtp_stream_hdr stream = {
+		.stream_id = 0xAABBCCDDEEFF0001,
+		.timestamp = 0x80C0FFEE,
+		.stream_data_len = 24,
+		.sv = 1,
+		.tv = 1,
+		.seq_num = 0x55,
+	};
+	const struct avtp_aaf_hdr aaf = {
+		.stream = stream,
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+	};
+	const struct avtp_cvf_hdr cvf = {
+		.stream = stream,
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_H264,
+		.m = 1,
+		.h264_ptv = 1,
+		.h264_timestamp = 0x12345678,
+	};
+	const struct avtp_rvf_hdr rvf = {
+		.stream = stream,
+		.active_pixels = 640,
+		.total_lines = 480,
+		.ap = 1,
+		.raw_pixel_depth = 8,
+		.raw_num_lines = 1,
+		.raw_line_number = 1,
+	};
+	const struct avtp_ieciidc_hdr ieciidc = {
+		.stream = stream,
+		.tag = AVTP_IECIIDC_TAG_CIP,
+		.tcode = 0x0A,
+		.cip_qi_2 = 2,
+		.cip_dbs = 2,
+		.cip_fmt = 0x10,
+		.cip_sfc = AVTP_IECIIDC_SFC_48KHZ,
+		.cip_syt = 0x1234,
+	};
+	const struct avtp_tscf_hdr tscf = { .stream = stream };
+	const struct avtp_ntscf_hdr ntscf = {
+		.stream_id = stream.stream_id,
+		.data_len = 16,
+		.sv = 1,
+		.seq_num = 0x55,
+	};
+	const struct avtp_crf_hdr crf = {
+		.stream_id = stream.stream_id,
+		.base_freq = 48000,
+		.crf_data_len = 48,
+		.timestamp_interval = 160,
+		.sv = 1,
+		.seq_num = 0x55,
+	};
+	uint8_t buf[HDR_LEN];
+
+	memset(buf, 0, sizeof(buf));
+	avtp_aaf_pdu_pack((struct avtp_stream_pdu *) buf, &aaf);
+	add(buf, sizeof(struct avtp_stream_pdu), arg);
+
+	memset(buf, 0, sizeof(buf));
+	avtp_cvf_pdu_pack((struct avtp_stream_pdu *) buf, &cvf);
+	add(buf, sizeof(struct avtp_stream_pdu) +
+			sizeof(struct avtp_cvf_h264_payload), arg);
+
+	memset(buf, 0, sizeof(buf));
+	avtp_rvf_pdu_pack((struct avtp_stream_pdu *) buf, &rvf);
+	add(buf, AVTP_RVF_RAW_HDR_LEN, arg);
+
+	memset(buf, 0, sizeof(buf));
+	avtp_ieciidc_pdu_pack((struct avtp_stream_pdu *) buf, &ieciidc);
+	add(buf, sizeof(struct avtp_stream_pdu) +
+			sizeof(struct avtp_ieciidc_cip_payload), arg);
+
+	memset(buf, 0, sizeof(buf));
+	avtp_tscf_pdu_pack((struct avtp_stream_pdu *) buf, &tscf);
+	add(buf, sizeof(struct avtp_stream_pdu), arg);
+
+	memset(buf, 0, sizeof(buf));
+	avtp_ntscf_pdu_pack((struct avtp_ntscf_pdu *) buf, &ntscf);
+	add(buf, sizeof(struct avtp_ntscf_pdu), arg);
+
+	memset(buf, 0, sizeof(buf));
+	avtp_crf_pdu_pack((struct avtp_crf_pdu *) buf, &crf);
+	add(buf, sizeof(struct avtp_crf_pdu), arg);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Fuzz targets.
+ *
+ * Each fuzz-<target>.c file feeds arbitrary input to one parsing path from
+ * libavtp through the libFuzzer entry point below, and builds seed inputs,
+ * i.e. valid PDUs, with libavtp itself so no corpus files need to be kept in
+ * the tree. Targets are either linked with libFuzzer or with replay.c, which
+ * replays a corpus for regression testing, benchmarking and AFL.
+ *
+ * Inputs made of several PDUs (e.g. for reassemblers) are a sequence of
+ * records, each one a 16-bit big endian length followed by as many bytes,
+ * see fuzz_next_record().
+ */
+
+/* Called by fuzz_seeds() for each seed input. */
+typedef void (*fuzz_add_fn)(const void *data, size_t size, void *arg);
+
+/* Run the target on one input. Always returns 0, as libFuzzer expects. */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/* Build the seed inputs of the target and hand each one over to 'add'. */
+void fuzz_seeds(fuzz_add_fn add, void *arg);
+
+/* Split the next record from an input. The record is not copied.
+ * @data: Pointer to the unread part of the input, advanced past the record.
+ * @size: Pointer to the size of the unread part, updated accordingly.
+ * @rec: Pointer to variable which the record address is saved.
+ *
+ * Returns:
+ *    Record length (>= 0), truncated to the bytes left in the input.
+ *    -1: If no record is left.
+ */
+static inline int fuzz_next_record(const uint8_t **data, size_t *size,
+							const uint8_t **rec)
+{
+	size_t len;
+
+	if (*size < 2)
+		return -1;
+
+	len = (*data)[0] << 8 | (*data)[1];
+	if (len > *size - 2)
+		len = *size - 2;
+
+	*rec = *data + 2;
+	*data += 2 + len;
+	*size -= 2 + len;
+
+	return len;
+}
+
+/* Append a record to a seed input being built.
+ * @buf: Seed buffer.
+ * @len: Current length of the seed, updated accordingly.
+ * @rec: Record to be appended.
+ * @rec_len: Record length, below 64 KiB.
+ */
+static inline void fuzz_add_record(uint8_t *buf, size_t *len,
+					const void *rec, size_t rec_len)
+{
+	const uint8_t *src = rec;
+	size_t i;
+
+	buf[(*len)++] = rec_len >> 8;
+	buf[(*len)++] = rec_len & 0xFF;
+	for (i = 0; i < rec_len; i++)
+		buf[(*len)++] = src[i];
+}
+
+/* Keep the compiler from optimizing away reads whose result is unused, so
+ * every byte the target looks at is actually read.
+ */
+static inline void fuzz_keep(uint64_t val)
+{
+	__asm__ volatile("" : : "r" (val));
+}
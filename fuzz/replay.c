@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Fuzz corpus replay.
+ *
+ * Driver linked with a fuzz target instead of libFuzzer. It runs the target
+ * on every input from a corpus, so it serves as:
+ *
+ *  - Regression test: with no FILE given, the corpus is made of the seeds of
+ *    the target plus MUTATIONS deterministic mutations of each one (bit
+ *    flips, byte overwrites, truncations and extensions), so parsing paths
+ *    are exercised with malformed input on every test run. Build with
+ *    sanitizers (e.g. -Db_sanitize=address,undefined) to catch out of bounds
+ *    accesses.
+ *  - Throughput benchmark: with '-t', the corpus is replayed over and over
+ *    for at least MIN_TIME_MS milliseconds and the cost per input is
+ *    reported in the same CSV format as avtp-bench:
+ *
+ *	benchmark,iterations,ns_per_op,ops_per_sec
+ *
+ *  - AFL entry point: inputs are read from the FILEs given, or from all
+ *    files in the directories given, e.g. 'afl-fuzz -i seeds -o out --
+ *    replay-pdu @@'.
+ *
+ * With '-w', the corpus is written to DIR, one file per input, e.g. to seed
+ * libFuzzer or AFL, and nothing else is done.
+ *
+ * Usage: replay-<target> [-t MIN_TIME_MS] [-m MUTATIONS] [-w DIR] [FILE]...
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fuzz.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+#define NSEC_PER_MSEC		1000000ULL
+/* Mutations per seed if none is given in command line. */
+#define DEFAULT_MUTATIONS	256
+/* Maximum number of bytes appended to a seed by a mutation. */
+#define MAX_EXTENSION		16
+
+#ifndef FUZZ_TARGET
+#define FUZZ_TARGET		"target"
+#endif
+
+struct input {
+	uint8_t *data;
+	size_t size;
+};
+
+struct corpus {
+	struct input *inputs;
+	size_t count;
+	size_t capacity;
+	uint64_t bytes;
+};
+
+static uint64_t now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/* Each input lives in its own allocation of its exact size, so sanitizers
+ * catch the target reading past its end.
+ */
+static void corpus_add(const void *data, size_t size, void *arg)
+{
+	struct corpus *c = arg;
+	struct input *in;
+
+	if (c->count == c->capacity) {
+		size_t capacity = c->capacity ? c->capacity * 2 : 64;
+
+		in = realloc(c->inputs, capacity * sizeof(*in));
+		if (!in) {
+			fprintf(stderr, "Failed to allocate memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		c->inputs = in;
+		c->capacity = capacity;
+	}
+
+	in = &c->inputs[c->count];
+	in->data = malloc(size ? size : 1);
+	if (!in->data) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memcpy(in->data, data, size);
+	in->size = size;
+	c->count++;
+	c->bytes += size;
+}
+
+static int load_file(struct corpus *c, const char *path)
+{
+	struct stat st;
+	uint8_t *buf;
+	FILE *f;
+	size_t n;
+
+	f = fopen(path, "rb");
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+
+	if (fstat(fileno(f), &st) < 0) {
+		perror(path);
+		fclose(f);
+		return -1;
+	}
+
+	buf = malloc(st.st_size ? st.st_size : 1);
+	if (!buf) {
+		fclose(f);
+		return -1;
+	}
+
+	n = fread(buf, 1, st.st_size, f);
+	fclose(f);
+
+	corpus_add(buf, n, c);
+	free(buf);
+	return 0;
+}
+
+static int load_path(struct corpus *c, const char *path)
+{
+	struct dirent *entry;
+	struct stat st;
+	char file[4096];
+	DIR *dir;
+	int res = 0;
+
+	if (stat(path, &st) < 0) {
+		perror(path);
+		return -1;
+	}
+
+	if (!S_ISDIR(st.st_mode))
+		return load_file(c, path);
+
+	dir = opendir(path);
+	if (!dir) {
+		perror(path);
+		return -1;
+	}
+
+	while (res == 0 && (entry = readdir(dir))) {
+		snprintf(file, sizeof(file), "%s/%s", path, entry->d_name);
+		if (stat(file, &st) == 0 && S_ISREG(st.st_mode))
+			res = load_file(c, file);
+	}
+
+	closedir(dir);
+	return res;
+}
+
+/* xorshift64, so mutations are the same on every run. */
+static uint64_t rand_next(uint64_t *state)
+{
+	uint64_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+
+	return x;
+}
+
+static void mutate(struct corpus *c, const struct input *seed,
+							uint64_t *state)
+{
+	static const uint8_t values[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+	uint8_t buf[UINT16_MAX + MAX_EXTENSION];
+	size_t size = seed->size;
+	unsigned int ops, i;
+
+	if (size > UINT16_MAX)
+		size = UINT16_MAX;
+
+	memcpy(buf, seed->data, size);
+
+	ops = 1 + rand_next(state) % 4;
+	for (i = 0; i < ops; i++) {
+		uint64_t r = rand_next(state);
+		size_t pos = size ? (r >> 8) % size : 0;
+
+		switch (r % 5) {
+		case 0:
+			if (size)
+				buf[pos] ^= 1 << (r >> 32) % 8;
+			break;
+		case 1:
+			if (size)
+				buf[pos] = values[(r >> 32) % sizeof(values)];
+			break;
+		case 2:
+			if (size)
+				buf[pos] = r >> 32;
+			break;
+		case 3:
+			size = pos;
+			break;
+		case 4:
+			if (size + MAX_EXTENSION <= sizeof(buf)) {
+				unsigned int n = 1 + (r >> 32) % MAX_EXTENSION;
+
+				while (n--)
+					buf[size++] = rand_next(state);
+			}
+			break;
+		}
+	}
+
+	corpus_add(buf, size, c);
+}
+
+static int write_corpus(const struct corpus *c, const char *dir)
+{
+	char path[4096];
+	size_t i;
+
+	for (i = 0; i < c->count; i++) {
+		FILE *f;
+
+		snprintf(path, sizeof(path), "%s/%s-%06zu", dir, FUZZ_TARGET,
+									i);
+		f = fopen(path, "wb");
+		if (!f) {
+			perror(path);
+			return -1;
+		}
+
+		if (fwrite(c->inputs[i].data, 1, c->inputs[i].size, f) !=
+							c->inputs[i].size) {
+			perror(path);
+			fclose(f);
+			return -1;
+		}
+
+		fclose(f);
+	}
+
+	return 0;
+}
+
+static void replay(const struct corpus *c)
+{
+	size_t i;
+
+	for (i = 0; i < c->count; i++)
+		LLVMFuzzerTestOneInput(c->inputs[i].data, c->inputs[i].size);
+}
+
+static void bench(const struct corpus *c, uint64_t min_time)
+{
+	uint64_t start, elapsed, iters = 0;
+
+	start = now();
+	do {
+		replay(c);
+		iters += c->count;
+		elapsed = now() - start;
+	} while (elapsed < min_time);
+
+	printf("fuzz/%s,%" PRIu64 ",%.2f,%.0f\n", FUZZ_TARGET, iters,
+				(double) elapsed / iters,
+				(double) iters * NSEC_PER_SEC / elapsed);
+}
+
+int main(int argc, char *argv[])
+{
+	struct corpus c = { 0 };
+	unsigned int mutations = DEFAULT_MUTATIONS;
+	uint64_t min_time = 0;
+	const char *out_dir = NULL;
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	size_t seeds, i;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:m:w:")) != -1) {
+		switch (opt) {
+		case 't':
+			min_time = strtoull(optarg, NULL, 10) * NSEC_PER_MSEC;
+			break;
+		case 'm':
+			mutations = strtoul(optarg, NULL, 10);
+			break;
+		case 'w':
+			out_dir = optarg;
+			break;
+		default:
+			fprintf(stderr, "Usage: %s [-t MIN_TIME_MS] "
+					"[-m MUTATIONS] [-w DIR] [FILE]...\n",
+					argv[0]);
+			return 1;
+		}
+	}
+
+	if (optind < argc) {
+		for (; optind < argc; optind++) {
+			if (load_path(&c, argv[optind]) < 0)
+				return 1;
+		}
+	} else {
+		fuzz_seeds(corpus_add, &c);
+
+		seeds = c.count;
+		for (i = 0; i < seeds * mutations; i++)
+			mutate(&c, &c.inputs[i % seeds], &state);
+	}
+
+	if (out_dir)
+		return write_corpus(&c, out_dir) < 0 ? 1 : 0;
+
+	replay(&c);
+	fprintf(stderr, "%s: %zu inputs, %" PRIu64 " bytes replayed\n",
+						FUZZ_TARGET, c.count, c.bytes);
+
+	if (min_time)
+		bench(&c, min_time);
+
+	for (i = 0; i < c.count; i++)
+		free(c.inputs[i].data);
+	free(c.inputs);
+
+	return 0;
+}
@@ -79,6 +79,22 @@ struct avtp_stream_pdu {
 	uint8_t avtp_payload[0];
 } __attribute__ ((__packed__));
 
+/* Host order representation of the Stream AVTPDU header fields shared by all
+ * stream formats (AAF, CVF, RVF, IEC 61883/IIDC). Format specific header
+ * structs (e.g. struct avtp_aaf_hdr) embed it as their first member. Unlike
+ * PDU structs, these structs can be read and written directly.
+ */
+struct avtp_stream_hdr {
+	uint64_t stream_id;
+	uint32_t timestamp;
+	uint16_t stream_data_len;
+	uint8_t sv;
+	uint8_t mr;
+	uint8_t tv;
+	uint8_t seq_num;
+	uint8_t tu;
+};
+
 enum avtp_field {
 	AVTP_FIELD_SUBTYPE,
 	AVTP_FIELD_VERSION,
@@ -109,6 +125,27 @@ int avtp_pdu_get(const struct avtp_common_pdu *pdu, enum avtp_field field,
 int avtp_pdu_set(struct avtp_common_pdu *pdu, enum avtp_field field,
 								uint32_t val);
 
+/* Emit Stream AVTPDU header from a template. The template is a Stream AVTPDU
+ * header previously built by some format pack function (e.g.
+ * avtp_aaf_pdu_pack()) which is copied to 'pdu', patching only the fields
+ * which change from PDU to PDU in a stream. The AVTPDU payload, including
+ * format specific headers living there (e.g. H.264 or CIP headers), is not
+ * touched.
+ * @pdu: Pointer to PDU struct to be emitted.
+ * @tmpl: Pointer to template PDU struct.
+ * @seq_num: Value of 'sequence_num' field.
+ * @timestamp: Value of 'avtp_timestamp' field.
+ * @data_len: Value of 'stream_data_length' field.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_pdu_emit(struct avtp_stream_pdu *pdu,
+				const struct avtp_stream_pdu *tmpl,
+				uint8_t seq_num, uint32_t timestamp,
+				uint16_t data_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -59,6 +60,21 @@ extern "C" {
 #define AVTP_AAF_PCM_SP_NORMAL			0x00
 #define AVTP_AAF_PCM_SP_SPARSE			0x01
 
+/* In sparse timestamp mode, only PDUs whose 'sequence_num' is a multiple of
+ * this value carry a valid 'avtp_timestamp'.
+ */
+#define AVTP_AAF_PCM_SPARSE_INTERVAL		8
+
+/* Host order sample types handled by PCM encode and decode functions. */
+enum avtp_aaf_pcm_sample {
+	/* Signed 16-bit integer. */
+	AVTP_AAF_PCM_SAMPLE_S16,
+	/* Signed 32-bit integer. */
+	AVTP_AAF_PCM_SAMPLE_S32,
+	/* 32-bit float, full scale from -1.0 to 1.0. */
+	AVTP_AAF_PCM_SAMPLE_FLOAT,
+};
+
 enum avtp_aaf_field {
 	AVTP_AAF_FIELD_SV,
 	AVTP_AAF_FIELD_MR,
@@ -77,6 +93,17 @@ enum avtp_aaf_field {
 	AVTP_AAF_FIELD_MAX,
 };
 
+/* Host order representation of all AAF AVTPDU header fields. */
+struct avtp_aaf_hdr {
+	struct avtp_stream_hdr stream;
+	uint16_t chan_per_frame;
+	uint8_t format;
+	uint8_t nsr;
+	uint8_t bit_depth;
+	uint8_t sp;
+	uint8_t evt;
+};
+
 /* Get value from AAF AVTPDU field.
  * @pdu: Pointer to PDU struct.
  * @field: PDU field to be retrieved.
@@ -111,6 +138,163 @@ int avtp_aaf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_aaf_field field,
  */
 int avtp_aaf_pdu_init(struct avtp_stream_pdu *pdu);
 
+/* Retrieve all AAF AVTPDU header fields at once. This is cheaper than calling
+ * avtp_aaf_pdu_get() for each field since every PDU word is converted to host
+ * order only once.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+						struct avtp_aaf_hdr *hdr);
+
+/* Set all AAF AVTPDU header fields at once from host order struct. This is
+ * cheaper than calling avtp_aaf_pdu_set() for each field since every PDU word
+ * is written only once. The 'subtype' field is set to AVTP_SUBTYPE_AAF and
+ * 'version' is set to 0.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_aaf_hdr *hdr);
+
+/* Encode host order PCM samples into AAF AVTPDU payload. Samples are converted
+ * to the sample format from 'hdr->format' (AVTP_AAF_FORMAT_INT_16BIT,
+ * AVTP_AAF_FORMAT_INT_24BIT, AVTP_AAF_FORMAT_INT_32BIT or
+ * AVTP_AAF_FORMAT_FLOAT_32BIT) in network order. Integer samples are scaled
+ * to the sample format width keeping the most significant bits, and bits
+ * below 'hdr->bit_depth' are zeroed. Float samples out of range are clipped
+ * when converted to integer.
+ * @hdr: Pointer to header struct with 'format', 'bit_depth' and
+ *       'chan_per_frame' fields from the AAF stream.
+ * @payload: Pointer to AVTPDU payload (e.g. 'avtp_payload' field from
+ *           struct avtp_stream_pdu).
+ * @samples: Pointer to interleaved samples buffer.
+ * @type: Type of samples from 'samples' buffer.
+ * @frames: Number of frames to be encoded.
+ *
+ * Returns:
+ *    Number of payload bytes written (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_pcm_encode(const struct avtp_aaf_hdr *hdr, void *payload,
+				const void *samples,
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames);
+
+/* Same as avtp_aaf_pcm_encode() but samples are read from planar buffers.
+ * @planes: Array with 'hdr->chan_per_frame' pointers, one per channel.
+ */
+int avtp_aaf_pcm_encode_planar(const struct avtp_aaf_hdr *hdr, void *payload,
+				const void *const planes[],
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames);
+
+/* Decode PCM samples from AAF AVTPDU payload into host order samples. This is
+ * the reverse operation of avtp_aaf_pcm_encode().
+ * @hdr: Pointer to header struct with 'format', 'bit_depth' and
+ *       'chan_per_frame' fields from the AAF stream.
+ * @payload: Pointer to AVTPDU payload.
+ * @samples: Pointer to interleaved samples buffer.
+ * @type: Type of samples from 'samples' buffer.
+ * @frames: Number of frames to be decoded.
+ *
+ * Returns:
+ *    Number of payload bytes read (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_pcm_decode(const struct avtp_aaf_hdr *hdr, const void *payload,
+				void *samples, enum avtp_aaf_pcm_sample type,
+				unsigned int frames);
+
+/* Same as avtp_aaf_pcm_decode() but samples are written to planar buffers.
+ * @planes: Array with 'hdr->chan_per_frame' pointers, one per channel.
+ */
+int avtp_aaf_pcm_decode_planar(const struct avtp_aaf_hdr *hdr,
+				const void *payload, void *const planes[],
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames);
+
+/* Largest AAF AVTPDU payload fitting in a 1500 bytes MTU. */
+#define AVTP_AAF_AGGREGATOR_MAX_DATA_LEN	(1500 - \
+						sizeof(struct avtp_stream_pdu))
+
+struct avtp_stream_ctx;
+
+/* AAF PCM aggregator. Splits blocks of host order samples of any size into
+ * AAF PDUs carrying the number of frames set by the stream data length from
+ * the stream template. PDU headers are emitted by the stream context, so
+ * presentation times only need to be set once per block (or once per stream)
+ * and advance by the sample period on each PDU, and sparse timestamp mode is
+ * handled as well. Frames left over at the end of a block are kept by the
+ * aggregator and carried by the first PDU from the next one. Fields are
+ * private, use the avtp_aaf_aggregator_*() functions to handle them.
+ */
+struct avtp_aaf_aggregator {
+	struct avtp_stream_ctx *ctx;
+	struct avtp_aaf_hdr hdr;
+	enum avtp_aaf_pcm_sample type;
+	unsigned int frames_per_pdu;
+	size_t frame_size;
+	size_t payload_frame_size;
+	const uint8_t *next;
+	unsigned int frames;
+	unsigned int pending;
+	uint8_t partial[AVTP_AAF_AGGREGATOR_MAX_DATA_LEN];
+};
+
+/* Initialize AAF PCM aggregator.
+ * @agg: Pointer to aggregator.
+ * @ctx: Pointer to stream context the PDUs are emitted from, initialized
+ *       with an AAF PCM template. Its 'stream_data_length' field must be a
+ *       whole number of frames. The context must outlive the aggregator.
+ * @type: Type of samples from blocks handed over to the aggregator.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_aggregator_init(struct avtp_aaf_aggregator *agg,
+				struct avtp_stream_ctx *ctx,
+				enum avtp_aaf_pcm_sample type);
+
+/* Start splitting a block of interleaved samples into PDUs. Frames from the
+ * previous block which weren't emitted by avtp_aaf_aggregator_next() yet,
+ * other than the leftover ones, are discarded. The block must not be changed
+ * until avtp_aaf_aggregator_next() returns 0.
+ * @agg: Pointer to aggregator.
+ * @samples: Pointer to interleaved samples buffer.
+ * @frames: Number of frames from 'samples'.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_aggregator_start(struct avtp_aaf_aggregator *agg,
+				const void *samples, unsigned int frames);
+
+/* Emit next PDU from current block, header and payload. Once the frames left
+ * in the block don't fill a whole PDU, they are kept for the next block and
+ * no PDU is emitted.
+ * @agg: Pointer to aggregator.
+ * @pdu: Pointer to PDU struct to be emitted, large enough for the stream
+ *       data length from the stream template.
+ *
+ * Returns:
+ *    1: PDU emitted.
+ *    0: No whole PDU left in block.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_aaf_aggregator_next(struct avtp_aaf_aggregator *agg,
+				struct avtp_stream_pdu *pdu);
+
 #ifdef __cplusplus
 }
 #endif
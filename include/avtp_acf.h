@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* AVTP Control Format (ACF) messages.
+ *
+ * ACF messages are carried back to back in TSCF and NTSCF AVTPDUs (see
+ * avtp_tscf.h). Every message starts with a 16-bit header carrying its type
+ * and its length in quadlets, header included, so a single PDU can bundle
+ * messages of any type. For further information refer to section 9.4 from
+ * IEEE 1722-2016 spec.
+ *
+ * ACF messages are not aligned within received frames, all functions below
+ * handle them as byte streams.
+ */
+
+/* ACF 'acf_msg_type' field values. */
+#define AVTP_ACF_TYPE_FLEXRAY			0x00
+#define AVTP_ACF_TYPE_CAN			0x01
+#define AVTP_ACF_TYPE_CAN_BRIEF			0x02
+#define AVTP_ACF_TYPE_LIN			0x03
+#define AVTP_ACF_TYPE_MOST			0x04
+#define AVTP_ACF_TYPE_GPC			0x05
+#define AVTP_ACF_TYPE_SERIAL			0x06
+#define AVTP_ACF_TYPE_PARALLEL			0x07
+#define AVTP_ACF_TYPE_SENSOR			0x08
+#define AVTP_ACF_TYPE_SENSOR_BRIEF		0x09
+#define AVTP_ACF_TYPE_AECP			0x0A
+#define AVTP_ACF_TYPE_ANCILLARY			0x0B
+
+/* Maximum payload length of ACF CAN, CAN FD and LIN messages, in bytes. */
+#define AVTP_ACF_CAN_MAX_DATA_LEN		8
+#define AVTP_ACF_CAN_FD_MAX_DATA_LEN		64
+#define AVTP_ACF_LIN_MAX_DATA_LEN		8
+
+/* Maximum length of an ACF message, header included, in bytes. */
+#define AVTP_ACF_MAX_MSG_LEN			(511 * 4)
+
+/* Any ACF message. 'acf_msg_info' carries the 'acf_msg_type' and
+ * 'acf_msg_length' fields in its upper 16 bits, the lower 16 bits are message
+ * type specific.
+ */
+struct avtp_acf_msg {
+	uint32_t acf_msg_info;
+	uint8_t acf_msg_payload[0];
+} __attribute__ ((__packed__));
+
+struct avtp_acf_can_msg {
+	uint32_t acf_msg_info;
+	uint64_t message_timestamp;
+	uint32_t can_identifier;
+	uint8_t can_msg_payload[0];
+} __attribute__ ((__packed__));
+
+struct avtp_acf_can_brief_msg {
+	uint32_t acf_msg_info;
+	uint32_t can_identifier;
+	uint8_t can_msg_payload[0];
+} __attribute__ ((__packed__));
+
+struct avtp_acf_lin_msg {
+	uint32_t acf_msg_info;
+	uint64_t message_timestamp;
+	uint8_t lin_msg_payload[0];
+} __attribute__ ((__packed__));
+
+/* Fields shared by all ACF messages. Message type specific enums start with
+ * these fields in the same order.
+ */
+enum avtp_acf_field {
+	AVTP_ACF_FIELD_MSG_TYPE,
+	AVTP_ACF_FIELD_MSG_LENGTH,
+	AVTP_ACF_FIELD_MAX,
+};
+
+enum avtp_acf_can_field {
+	AVTP_ACF_CAN_FIELD_MSG_TYPE,
+	AVTP_ACF_CAN_FIELD_MSG_LENGTH,
+	AVTP_ACF_CAN_FIELD_PAD,
+	AVTP_ACF_CAN_FIELD_MTV,
+	AVTP_ACF_CAN_FIELD_RTR,
+	AVTP_ACF_CAN_FIELD_EFF,
+	AVTP_ACF_CAN_FIELD_BRS,
+	AVTP_ACF_CAN_FIELD_FDF,
+	AVTP_ACF_CAN_FIELD_ESI,
+	AVTP_ACF_CAN_FIELD_CAN_BUS_ID,
+	/* Not available on ACF CAN Brief messages. */
+	AVTP_ACF_CAN_FIELD_MESSAGE_TIMESTAMP,
+	AVTP_ACF_CAN_FIELD_CAN_IDENTIFIER,
+	AVTP_ACF_CAN_FIELD_MAX,
+};
+
+enum avtp_acf_lin_field {
+	AVTP_ACF_LIN_FIELD_MSG_TYPE,
+	AVTP_ACF_LIN_FIELD_MSG_LENGTH,
+	AVTP_ACF_LIN_FIELD_PAD,
+	AVTP_ACF_LIN_FIELD_MTV,
+	AVTP_ACF_LIN_FIELD_LIN_BUS_ID,
+	AVTP_ACF_LIN_FIELD_LIN_IDENTIFIER,
+	AVTP_ACF_LIN_FIELD_MESSAGE_TIMESTAMP,
+	AVTP_ACF_LIN_FIELD_MAX,
+};
+
+/* Host order representation of ACF CAN and CAN Brief message header fields.
+ * 'brief' selects ACF CAN Brief messages, which carry no 'message_timestamp'.
+ * CAN FD frames have 'fdf' set. 'pad' and the message length are derived
+ * from the payload length.
+ */
+struct avtp_acf_can_hdr {
+	uint64_t message_timestamp;
+	uint32_t can_identifier;
+	uint8_t brief;
+	uint8_t mtv;
+	uint8_t rtr;
+	uint8_t eff;
+	uint8_t brs;
+	uint8_t fdf;
+	uint8_t esi;
+	uint8_t can_bus_id;
+};
+
+/* Host order representation of ACF LIN message header fields. 'pad' and the
+ * message length are derived from the payload length.
+ */
+struct avtp_acf_lin_hdr {
+	uint64_t message_timestamp;
+	uint8_t mtv;
+	uint8_t lin_bus_id;
+	uint8_t lin_identifier;
+};
+
+/* Get value from ACF message field shared by all message types.
+ * @msg: Pointer to message.
+ * @field: Message field to be retrieved.
+ * @val: Pointer to variable which the retrieved value should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_acf_msg_get(const struct avtp_acf_msg *msg, enum avtp_acf_field field,
+								uint64_t *val);
+
+/* Set value from ACF message field shared by all message types.
+ * @msg: Pointer to message.
+ * @field: Message field to be set.
+ * @val: Value to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_acf_msg_set(struct avtp_acf_msg *msg, enum avtp_acf_field field,
+								uint64_t val);
+
+/* Get value from ACF CAN or CAN Brief message field. The message layout is
+ * selected by its 'acf_msg_type' field.
+ * @msg: Pointer to message.
+ * @field: Message field to be retrieved.
+ * @val: Pointer to variable which the retrieved value should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, 'msg' is neither a CAN nor a CAN
+ *             Brief message or 'field' is not available on 'msg'.
+ */
+int avtp_acf_can_get(const struct avtp_acf_msg *msg,
+				enum avtp_acf_can_field field, uint64_t *val);
+
+/* Set value from ACF CAN or CAN Brief message field. The message layout is
+ * selected by its 'acf_msg_type' field, which must be set beforehand.
+ * @msg: Pointer to message.
+ * @field: Message field to be set.
+ * @val: Value to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, 'msg' is neither a CAN nor a CAN
+ *             Brief message or 'field' is not available on 'msg'.
+ */
+int avtp_acf_can_set(struct avtp_acf_msg *msg, enum avtp_acf_can_field field,
+								uint64_t val);
+
+/* Get value from ACF LIN message field.
+ * @msg: Pointer to message.
+ * @field: Message field to be retrieved.
+ * @val: Pointer to variable which the retrieved value should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'msg' is not a LIN message.
+ */
+int avtp_acf_lin_get(const struct avtp_acf_msg *msg,
+				enum avtp_acf_lin_field field, uint64_t *val);
+
+/* Set value from ACF LIN message field. The 'acf_msg_type' field must be set
+ * beforehand.
+ * @msg: Pointer to message.
+ * @field: Message field to be set.
+ * @val: Value to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'msg' is not a LIN message.
+ */
+int avtp_acf_lin_set(struct avtp_acf_msg *msg, enum avtp_acf_lin_field field,
+								uint64_t val);
+
+/* Build an ACF CAN, CAN Brief or CAN FD message at once, payload included.
+ * The payload is padded to a quadlet boundary with zeros.
+ * @msg: Pointer to buffer where the message is built.
+ * @size: Size of 'msg' buffer, in bytes.
+ * @hdr: Pointer to struct with the header fields to be set.
+ * @data: Pointer to CAN frame payload.
+ * @len: Length of CAN frame payload, in bytes. Up to
+ *       AVTP_ACF_CAN_MAX_DATA_LEN for CAN frames. CAN FD frames ('fdf' set)
+ *       carry up to AVTP_ACF_CAN_FD_MAX_DATA_LEN bytes and only lengths
+ *       valid for CAN FD frames (0 to 8, 12, 16, 20, 24, 32, 48 or 64) are
+ *       accepted.
+ *
+ * Returns:
+ *    Length of message, in bytes (> 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOSPC: If the message doesn't fit in 'size' bytes.
+ */
+int avtp_acf_can_pack(struct avtp_acf_msg *msg, size_t size,
+				const struct avtp_acf_can_hdr *hdr,
+				const void *data, size_t len);
+
+/* Retrieve all ACF CAN or CAN Brief message fields at once. The payload is
+ * not copied, '*data' points to it within 'msg'.
+ * @msg: Pointer to message.
+ * @len: Length of message, in bytes (e.g. as returned by
+ *       avtp_acf_iter_next()).
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ * @data: Pointer to variable which the payload address should be saved.
+ * @data_len: Pointer to variable which the payload length should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, 'msg' is neither a CAN nor a CAN
+ *             Brief message or its length fields are inconsistent.
+ */
+int avtp_acf_can_unpack(const struct avtp_acf_msg *msg, size_t len,
+				struct avtp_acf_can_hdr *hdr,
+				const uint8_t **data, size_t *data_len);
+
+/* Build an ACF LIN message at once, payload included. The payload is padded
+ * to a quadlet boundary with zeros.
+ * @msg: Pointer to buffer where the message is built.
+ * @size: Size of 'msg' buffer, in bytes.
+ * @hdr: Pointer to struct with the header fields to be set.
+ * @data: Pointer to LIN frame payload.
+ * @len: Length of LIN frame payload, up to AVTP_ACF_LIN_MAX_DATA_LEN bytes.
+ *
+ * Returns:
+ *    Length of message, in bytes (> 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOSPC: If the message doesn't fit in 'size' bytes.
+ */
+int avtp_acf_lin_pack(struct avtp_acf_msg *msg, size_t size,
+				const struct avtp_acf_lin_hdr *hdr,
+				const void *data, size_t len);
+
+/* Retrieve all ACF LIN message fields at once. The payload is not copied,
+ * '*data' points to it within 'msg'.
+ * @msg: Pointer to message.
+ * @len: Length of message, in bytes.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ * @data: Pointer to variable which the payload address should be saved.
+ * @data_len: Pointer to variable which the payload length should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, 'msg' is not a LIN message or its
+ *             length fields are inconsistent.
+ */
+int avtp_acf_lin_unpack(const struct avtp_acf_msg *msg, size_t len,
+				struct avtp_acf_lin_hdr *hdr,
+				const uint8_t **data, size_t *data_len);
+
+/* ACF message iterator. Walks the ACF messages carried by a received TSCF or
+ * NTSCF AVTPDU in place, without copying them. Fields are private, use the
+ * avtp_acf_iter_*() functions to handle them.
+ */
+struct avtp_acf_iter {
+	const uint8_t *next;
+	const uint8_t *end;
+};
+
+/* Initialize iterator on the ACF messages from a TSCF or NTSCF AVTPDU. The
+ * PDU buffer must not be changed while the iterator is in use.
+ * @iter: Pointer to iterator.
+ * @pdu: Pointer to PDU.
+ * @len: Length of PDU, in bytes.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, 'pdu' is neither a TSCF nor a NTSCF
+ *             AVTPDU or its data length field is larger than 'len'.
+ */
+int avtp_acf_iter_init(struct avtp_acf_iter *iter, const void *pdu,
+								size_t len);
+
+/* Get next ACF message. Once a malformed message is found, the iterator
+ * stops and no further messages are returned.
+ * @iter: Pointer to iterator.
+ * @msg: Pointer to variable which the message address should be saved.
+ * @len: Pointer to variable which the message length, in bytes, should be
+ *       saved.
+ *
+ * Returns:
+ *    1: Message returned.
+ *    0: No messages left.
+ *    -EINVAL: If any argument is invalid or the next message length is 0 or
+ *             goes beyond the data length of the PDU.
+ */
+int avtp_acf_iter_next(struct avtp_acf_iter *iter,
+				const struct avtp_acf_msg **msg, size_t *len);
+
+/* ACF message aggregator. Builds TSCF or NTSCF AVTPDUs bundling as many ACF
+ * messages as fit in a byte budget, so talkers bridging bus traffic (e.g. CAN
+ * frames) don't pay the per packet overhead for every message. A PDU is due
+ * once it is full or its oldest message has waited for the latency budget.
+ * Messages are built in place in the PDU buffer. Fields are private, use the
+ * avtp_acf_agg_*() functions to handle them.
+ *
+ * Typical use, with time taken from the same clock on every call:
+ *
+ *	avtp_acf_agg_start(agg, pdu, size);
+ *	for each message:
+ *		if (avtp_acf_agg_add_can(agg, &hdr, data, len, now) == -ENOSPC)
+ *			send avtp_acf_agg_finish(), start and add again;
+ *		if (avtp_acf_agg_due(agg, now))
+ *			send avtp_acf_agg_finish() and start again;
+ */
+struct avtp_acf_agg {
+	uint8_t tmpl[sizeof(struct avtp_stream_pdu)];
+	size_t hdr_len;
+	size_t max_pdu_size;
+	uint64_t max_latency;
+	uint8_t *pdu;
+	size_t limit;
+	size_t len;
+	uint64_t deadline;
+	bool full;
+	uint8_t seq_num;
+};
+
+/* Initialize aggregator.
+ * @agg: Pointer to aggregator.
+ * @tmpl: Pointer to TSCF or NTSCF AVTPDU template, previously built by
+ *        avtp_tscf_pdu_pack() or avtp_ntscf_pdu_pack(). The data length and
+ *        'sequence_num' fields, as well as 'avtp_timestamp' for TSCF, are set
+ *        by the aggregator on each PDU. Sequence numbers start from the
+ *        template value.
+ * @max_pdu_size: Byte budget, i.e. maximum size of emitted PDUs, headers
+ *                included.
+ * @max_latency: Latency budget, i.e. maximum time a message waits before its
+ *               PDU is due, in the unit of the 'now' arguments (e.g.
+ *               nanoseconds).
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'max_pdu_size' doesn't fit the
+ *             PDU header and one quadlet.
+ */
+int avtp_acf_agg_init(struct avtp_acf_agg *agg, const void *tmpl,
+				size_t max_pdu_size, uint64_t max_latency);
+
+/* Start building a PDU. Any PDU being built is discarded.
+ * @agg: Pointer to aggregator.
+ * @pdu: Pointer to buffer where the PDU is built (e.g. a TX queue slot).
+ * @size: Size of 'pdu' buffer, in bytes. Emitted PDUs are limited to this
+ *        size or the byte budget, whichever is smaller.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'size' doesn't fit the PDU
+ *             header and one quadlet.
+ */
+int avtp_acf_agg_start(struct avtp_acf_agg *agg, void *pdu, size_t size);
+
+/* Append ACF CAN, CAN Brief or CAN FD message to the PDU being built.
+ * @agg: Pointer to aggregator.
+ * @hdr: Pointer to struct with the message header fields.
+ * @data: Pointer to CAN frame payload.
+ * @len: Length of CAN frame payload, in bytes (see avtp_acf_can_pack()).
+ * @now: Current time. The latency budget starts running from the first
+ *       message of each PDU.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, no PDU is being built or the
+ *             message doesn't fit even in an empty PDU.
+ *    -ENOSPC: If the message doesn't fit in the room left in the PDU. The PDU
+ *             is then due.
+ */
+int avtp_acf_agg_add_can(struct avtp_acf_agg *agg,
+				const struct avtp_acf_can_hdr *hdr,
+				const void *data, size_t len, uint64_t now);
+
+/* Append ACF LIN message to the PDU being built.
+ * @agg: Pointer to aggregator.
+ * @hdr: Pointer to struct with the message header fields.
+ * @data: Pointer to LIN frame payload.
+ * @len: Length of LIN frame payload, in bytes.
+ * @now: Current time.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, no PDU is being built or the
+ *             message doesn't fit even in an empty PDU.
+ *    -ENOSPC: If the message doesn't fit in the room left in the PDU. The PDU
+ *             is then due.
+ */
+int avtp_acf_agg_add_lin(struct avtp_acf_agg *agg,
+				const struct avtp_acf_lin_hdr *hdr,
+				const void *data, size_t len, uint64_t now);
+
+/* Append an already built ACF message of any type (e.g. returned by
+ * avtp_acf_iter_next() when forwarding messages) to the PDU being built.
+ * @agg: Pointer to aggregator.
+ * @msg: Pointer to message.
+ * @len: Length of message, in bytes. It must match its 'acf_msg_length'.
+ * @now: Current time.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, no PDU is being built or the
+ *             message doesn't fit even in an empty PDU.
+ *    -ENOSPC: If the message doesn't fit in the room left in the PDU. The PDU
+ *             is then due.
+ */
+int avtp_acf_agg_add(struct avtp_acf_agg *agg, const struct avtp_acf_msg *msg,
+						size_t len, uint64_t now);
+
+/* Check whether the PDU being built is due, i.e. it holds messages and it is
+ * full or the latency budget of its first message is over.
+ * @agg: Pointer to aggregator.
+ * @now: Current time.
+ *
+ * Returns:
+ *    true: PDU is due.
+ *    false: Otherwise or if any argument is invalid.
+ */
+bool avtp_acf_agg_due(const struct avtp_acf_agg *agg, uint64_t now);
+
+/* Finish PDU being built. The header is written from the template and the
+ * sequence number is incremented. A new PDU must be started with
+ * avtp_acf_agg_start() before adding more messages.
+ * @agg: Pointer to aggregator.
+ * @avtp_time: Value of 'avtp_timestamp' field. Ignored for NTSCF.
+ *
+ * Returns:
+ *    Length of PDU, in bytes (> 0): Success.
+ *    0: No messages were added, nothing is emitted and the PDU is still
+ *       being built.
+ *    -EINVAL: If any argument is invalid or no PDU is being built.
+ */
+int avtp_acf_agg_finish(struct avtp_acf_agg *agg, uint32_t avtp_time);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stream AVTPDU batch classifier.
+ *
+ * The classifier keeps a table of registered streams, keyed by 'stream_id',
+ * and classifies vectors of received Stream AVTPDUs (e.g. as returned by
+ * recvmmsg()) against it. For each PDU it reports which registered stream the
+ * PDU belongs to and whether the PDU matches what is expected for that stream.
+ *
+ * Only Stream AVTPDUs (AAF, CVF, RVF and IEC 61883/IIDC) are supported since
+ * the classifier relies on struct avtp_stream_pdu layout.
+ */
+struct avtp_classifier;
+
+/* Per-PDU verdicts. */
+enum avtp_classifier_verdict {
+	/* PDU matches its stream and carries the expected sequence number. */
+	AVTP_CLASSIFIER_PASS,
+	/* PDU matches its stream but one or more PDUs were lost before it. */
+	AVTP_CLASSIFIER_SEQ_GAP,
+	/* PDU matches its stream but its sequence number is up to 128 behind
+	 * the expected one, i.e. it is a duplicate or arrived out of order.
+	 */
+	AVTP_CLASSIFIER_SEQ_OLD,
+	/* PDU belongs to a registered stream but doesn't match it, or is
+	 * truncated.
+	 */
+	AVTP_CLASSIFIER_FAIL,
+	/* PDU doesn't belong to any registered stream. */
+	AVTP_CLASSIFIER_UNKNOWN,
+};
+
+struct avtp_classifier_result {
+	/* Stream handle returned by avtp_classifier_add(). Set to -1 if
+	 * verdict is AVTP_CLASSIFIER_UNKNOWN or if the PDU is too short to
+	 * hold a Stream AVTPDU header.
+	 */
+	int stream;
+	enum avtp_classifier_verdict verdict;
+	/* Number of PDUs lost before this one. Only meaningful if verdict is
+	 * AVTP_CLASSIFIER_SEQ_GAP.
+	 */
+	uint8_t lost;
+};
+
+/* Create a classifier.
+ * @cls: Pointer to variable which the new classifier should be saved.
+ * @max_streams: Maximum number of streams which can be registered.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_classifier_create(struct avtp_classifier **cls,
+						unsigned int max_streams);
+
+/* Destroy classifier created by avtp_classifier_create().
+ * @cls: Pointer to classifier.
+ */
+void avtp_classifier_destroy(struct avtp_classifier *cls);
+
+/* Register a stream. PDUs are matched against the stream by comparing the
+ * 'subtype_data', 'format_specific' and 'packet_info' words from the PDU and
+ * from 'expected' on the bits set in 'mask'.
+ *
+ * 'expected' is typically built by a format pack function (e.g.
+ * avtp_aaf_pdu_pack()) and 'mask' by calling the inline setters from
+ * avtp_inline.h on a zeroed PDU with all ones values, e.g.
+ * avtp_aaf_set_nsr(&mask, 0xF). Bits from 'sequence_num' are always ignored
+ * since sequence numbers are tracked by the classifier itself. If 'mask' is
+ * NULL, only 'subtype', 'version' and 'sv' fields are compared.
+ *
+ * @cls: Pointer to classifier.
+ * @expected: Pointer to PDU header the stream PDUs should match. Its
+ *            'stream_id' field identifies the stream.
+ * @mask: Pointer to PDU header with the bits to be compared, or NULL.
+ *
+ * Returns:
+ *    Stream handle (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EEXIST: If the stream is already registered.
+ *    -ENOSPC: If 'max_streams' streams are registered already.
+ */
+int avtp_classifier_add(struct avtp_classifier *cls,
+					const struct avtp_stream_pdu *expected,
+					const struct avtp_stream_pdu *mask);
+
+/* Classify a vector of received PDUs. A PDU is truncated, and fails, if
+ * its length is shorter than the Stream AVTPDU header plus its
+ * 'stream_data_length'. Sequence number tracking is only updated by PDUs which
+ * don't fail and aren't behind the expected sequence number.
+ * @cls: Pointer to classifier.
+ * @pdus: Array with pointers to received PDUs.
+ * @lens: Array with length, in bytes, of each received PDU.
+ * @count: Number of elements in 'pdus', 'lens' and 'results'.
+ * @results: Array which the classification result of each PDU is saved.
+ *
+ * Returns:
+ *    Number of PDUs with AVTP_CLASSIFIER_PASS, AVTP_CLASSIFIER_SEQ_GAP or
+ *    AVTP_CLASSIFIER_SEQ_OLD verdicts (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_classifier_classify(struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[], unsigned int count,
+				struct avtp_classifier_result results[]);
+
+#ifdef __cplusplus
+}
+#endif
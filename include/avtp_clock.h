@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Clock id of the PTP Hardware Clock (PHC) opened as 'fd' (e.g. from
+ * open("/dev/ptp0", O_RDONLY)), to be passed to avtp_clock_create().
+ */
+#define AVTP_CLOCK_PHC(fd)	((clockid_t) ((~(unsigned int) (fd) << 3) | 3))
+
+/* Presentation time clock.
+ *
+ * Talkers and listeners need the current gPTP time on every PDU to compute
+ * or check presentation times. Reading a PHC, or any clock which isn't
+ * served by the vDSO, takes a system call. Instead, the clock object reads
+ * its reference clock (e.g. a PHC, or CLOCK_TAI kept in sync with the PHC by
+ * phc2sys) only once per 'resync_interval', together with CLOCK_MONOTONIC,
+ * and extrapolates reference time from CLOCK_MONOTONIC, which is read from
+ * the vDSO, in between. The rate of the reference clock relative to
+ * CLOCK_MONOTONIC is estimated on each resync, so extrapolation error stays
+ * well below a microsecond for resync intervals up to a second.
+ *
+ * Times are in nanoseconds. A clock object may only be used by one thread
+ * at a time.
+ */
+struct avtp_clock;
+
+/* Create a clock object. The reference clock is read once before returning.
+ * @clk: Pointer to variable which the new clock object should be saved.
+ * @clockid: Reference clock (e.g. CLOCK_TAI or AVTP_CLOCK_PHC(fd)).
+ * @resync_interval: Interval, in nanoseconds, between reads of the reference
+ *                   clock. If 0, the reference clock is read on every call.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ *    Other negative errno: If the reference clock couldn't be read.
+ */
+int avtp_clock_create(struct avtp_clock **clk, clockid_t clockid,
+						uint64_t resync_interval);
+
+/* Destroy clock object created by avtp_clock_create().
+ * @clk: Pointer to clock object.
+ */
+void avtp_clock_destroy(struct avtp_clock *clk);
+
+/* Get current reference time.
+ * @clk: Pointer to clock object.
+ * @now: Pointer to variable which the current time should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    Other negative errno: If the reference clock couldn't be read.
+ */
+int avtp_clock_now(struct avtp_clock *clk, uint64_t *now);
+
+/* Reconstruct a full time from its 'bits' least significant bits, e.g. the
+ * 32-bit 'avtp_timestamp' field, or a 40-bit gPTP time. The time picked is
+ * the closest one to 'ref', i.e. within a window of 2^bits ns centered on
+ * 'ref', so times both in the past (late PDUs) and in the future (early PDUs
+ * or long max transit times) are reconstructed correctly, as long as they are
+ * less than 2^(bits - 1) ns away from 'ref' (about 2.1 s for 32 bits and
+ * 9.2 min for 40 bits).
+ * @ref: Reference time, usually the current time.
+ * @time: Truncated time. Bits above 'bits' are ignored.
+ * @bits: Number of bits from 'time', from 1 to 63.
+ * @full: Pointer to variable which the reconstructed time should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_clock_unwrap(uint64_t ref, uint64_t time, unsigned int bits,
+							uint64_t *full);
+
+/* Reconstruct presentation times from a burst of 32-bit 'avtp_timestamp'
+ * values at once, against the current time, which is read only once.
+ * @clk: Pointer to clock object.
+ * @avtp_times: Array of 'avtp_timestamp' values.
+ * @times: Array which the reconstructed times are saved.
+ * @count: Number of elements in 'avtp_times' and 'times'.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    Other negative errno: If the reference clock couldn't be read.
+ */
+int avtp_clock_unwrap_burst(struct avtp_clock *clk,
+				const uint32_t avtp_times[], uint64_t times[],
+				unsigned int count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -71,6 +72,21 @@ enum avtp_crf_field {
 	AVTP_CRF_FIELD_MAX,
 };
 
+/* Host order representation of all CRF AVTPDU header fields. */
+struct avtp_crf_hdr {
+	uint64_t stream_id;
+	uint32_t base_freq;
+	uint16_t crf_data_len;
+	uint16_t timestamp_interval;
+	uint8_t sv;
+	uint8_t mr;
+	uint8_t fs;
+	uint8_t tu;
+	uint8_t seq_num;
+	uint8_t type;
+	uint8_t pull;
+};
+
 /* Get value from CRF AVTPDU field.
  * @pdu: Pointer to PDU struct.
  * @field: PDU field to be retrieved.
@@ -105,6 +121,166 @@ int avtp_crf_pdu_set(struct avtp_crf_pdu *pdu, enum avtp_crf_field field,
  */
 int avtp_crf_pdu_init(struct avtp_crf_pdu *pdu);
 
+/* Retrieve all CRF AVTPDU header fields at once. This is cheaper than calling
+ * avtp_crf_pdu_get() for each field since every PDU word is converted to host
+ * order only once.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_crf_pdu_unpack(const struct avtp_crf_pdu *pdu,
+						struct avtp_crf_hdr *hdr);
+
+/* Set all CRF AVTPDU header fields at once from host order struct. This is
+ * cheaper than calling avtp_crf_pdu_set() for each field since every PDU word
+ * is written only once. The 'subtype' field is set to AVTP_SUBTYPE_CRF and
+ * 'version' is set to 0.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_crf_pdu_pack(struct avtp_crf_pdu *pdu,
+					const struct avtp_crf_hdr *hdr);
+
+/* Emit CRF AVTPDU header from a template. The template is a CRF AVTPDU header
+ * previously built by avtp_crf_pdu_pack() which is copied to 'pdu', patching
+ * only the 'sequence_num' field. The 'crf_data' array is not touched.
+ * @pdu: Pointer to PDU struct to be emitted.
+ * @tmpl: Pointer to template PDU struct.
+ * @seq_num: Value of 'sequence_num' field.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_crf_pdu_emit(struct avtp_crf_pdu *pdu,
+				const struct avtp_crf_pdu *tmpl, uint8_t seq_num);
+
+/* Encode a series of CRF timestamps into 'crf_data' array, in network order.
+ * The first timestamp is 'base' and the following ones are spaced by the
+ * nominal CRF timestamp period described by 'hdr', i.e. 'timestamp_interval'
+ * periods of 'base_freq' adjusted by 'pull'. Each timestamp is rounded to the
+ * nearest nanosecond, so fractional periods don't accumulate error.
+ * @crf_data: Pointer to array which the timestamps are saved (e.g.
+ *            pdu->crf_data). It doesn't need to be aligned.
+ * @count: Number of timestamps.
+ * @base: First timestamp, in nanoseconds.
+ * @hdr: Pointer to CRF header fields describing the stream.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid (e.g. 'base_freq' is 0).
+ */
+int avtp_crf_data_encode(void *crf_data, unsigned int count, uint64_t base,
+					const struct avtp_crf_hdr *hdr);
+
+/* Decode CRF timestamps from 'crf_data' array into host order and, in the
+ * same pass, check them against the nominal CRF timestamp period described
+ * by 'hdr'. A timestamp is an outlier if it is more than half a media clock
+ * period ('base_freq' adjusted by 'pull') away from the previous one plus
+ * the nominal period, which also catches timestamps going backwards. The
+ * first timestamp has no previous one so it is never an outlier.
+ * @ts: Array which the host order timestamps are saved.
+ * @crf_data: Pointer to array of network order timestamps (e.g.
+ *            pdu->crf_data). It doesn't need to be aligned.
+ * @count: Number of timestamps.
+ * @hdr: Pointer to CRF header fields describing the stream.
+ * @outliers: Array which indexes of outliers are saved, in increasing order.
+ *            May be NULL if 'max_outliers' is 0.
+ * @max_outliers: Number of elements in 'outliers'.
+ *
+ * Returns:
+ *    Number of outliers found (>= 0), which may be greater than
+ *    'max_outliers', in which case only the first ones are saved.
+ *    -EINVAL: If any argument is invalid (e.g. 'base_freq' is 0).
+ */
+int avtp_crf_data_decode(uint64_t ts[], const void *crf_data,
+			unsigned int count, const struct avtp_crf_hdr *hdr,
+			unsigned int outliers[], unsigned int max_outliers);
+
+/* CRF media clock recovery.
+ *
+ * Timestamps carried by CRF AVTPDUs of one stream are kept in a fixed size
+ * ring and a least squares fit over the ring estimates the media clock period
+ * and phase. Once estimated, Stream AVTPDU timestamps (e.g. from AAF streams
+ * sharing the CRF domain) are mapped to media clock sample times in constant
+ * time. The ring is reset whenever the media clock is restarted ('mr' field
+ * toggled), its nominal frequency changes or a timestamp is too far off the
+ * estimate.
+ *
+ * Updates and lookups must be serialized by the caller, but lookups don't
+ * modify the clock so any number of them is fine between updates.
+ */
+struct avtp_crf_clock;
+
+/* Create CRF media clock.
+ * @clk: Pointer to variable which the new clock should be saved.
+ * @size: Number of CRF timestamps the estimate is computed from. It is
+ *        rounded up to a power of two and must be at least 2.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_crf_clock_create(struct avtp_crf_clock **clk, unsigned int size);
+
+/* Destroy clock created by avtp_crf_clock_create().
+ * @clk: Pointer to clock.
+ */
+void avtp_crf_clock_destroy(struct avtp_crf_clock *clk);
+
+/* Feed all timestamps carried by a CRF AVTPDU into the clock and update the
+ * estimate. Sequence number gaps are accounted for so lost PDUs don't skew
+ * the estimate, and PDUs with sequence number up to 128 behind the expected
+ * one, i.e. duplicate or reordered ones, are skipped.
+ * @clk: Pointer to clock.
+ * @pdu: Pointer to PDU struct.
+ * @len: Length of PDU, in bytes.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'pdu' is not a valid CRF AVTPDU
+ *             (e.g. 'crf_data_len' is not a multiple of 8 or 'base_freq'
+ *             is 0).
+ */
+int avtp_crf_clock_update(struct avtp_crf_clock *clk,
+			const struct avtp_crf_pdu *pdu, size_t len);
+
+/* Map a Stream AVTPDU timestamp to the nearest media clock sample time. The
+ * 32-bit timestamp is extended to 64 bits based on the last CRF timestamp, so
+ * it must be within 2 seconds from it.
+ * @clk: Pointer to clock.
+ * @avtp_time: Value of 'avtp_timestamp' field, in nanoseconds.
+ * @sample_time: Pointer to variable which the sample time, in nanoseconds,
+ *               is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EAGAIN: If no CRF timestamp has been fed into the clock yet.
+ */
+int avtp_crf_clock_lookup(const struct avtp_crf_clock *clk, uint32_t avtp_time,
+							uint64_t *sample_time);
+
+/* Get estimated media clock sample period.
+ * @clk: Pointer to clock.
+ * @period: Pointer to variable which the period, in nanoseconds, is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EAGAIN: If no CRF timestamp has been fed into the clock yet.
+ */
+int avtp_crf_clock_get_period(const struct avtp_crf_clock *clk,
+							double *period);
+
 #ifdef __cplusplus
 }
 #endif
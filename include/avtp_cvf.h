@@ -29,7 +29,11 @@
 #pragma once
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <sys/uio.h>
+
+#include "avtp.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +47,13 @@ extern "C" {
 #define AVTP_CVF_FORMAT_SUBTYPE_H264		0x01
 #define AVTP_CVF_FORMAT_SUBTYPE_JPEG2000	0x02
 
+/* Maximum length of the headers of a PDU emitted by the H.264 packetizer:
+ * Stream AVTPDU header, H.264 header and, for FU-A fragments, FU indicator and
+ * FU header (see RFC 6184).
+ */
+#define AVTP_CVF_H264_MAX_HDR_LEN	(sizeof(struct avtp_stream_pdu) + \
+						sizeof(uint32_t) + 2)
+
 enum avtp_cvf_field {
 	AVTP_CVF_FIELD_SV,
 	AVTP_CVF_FIELD_MR,
@@ -66,6 +77,20 @@ struct avtp_cvf_h264_payload {
 	uint8_t h264_data[0];
 } __attribute__((__packed__));
 
+/* Host order representation of all CVF AVTPDU header fields. The
+ * 'h264_timestamp' field is only meaningful if 'format_subtype' is
+ * AVTP_CVF_FORMAT_SUBTYPE_H264, otherwise it is left zeroed.
+ */
+struct avtp_cvf_hdr {
+	struct avtp_stream_hdr stream;
+	uint32_t h264_timestamp;
+	uint8_t format;
+	uint8_t format_subtype;
+	uint8_t m;
+	uint8_t evt;
+	uint8_t h264_ptv;
+};
+
 /* Get value of CVF AVTPDU field.
  * @pdu: Pointer to PDU struct.
  * @field: PDU field to be retrieved.
@@ -103,6 +128,193 @@ int avtp_cvf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_cvf_field field,
  */
 int avtp_cvf_pdu_init(struct avtp_stream_pdu *pdu, uint8_t subtype);
 
+/* Retrieve all CVF AVTPDU header fields at once. This is cheaper than calling
+ * avtp_cvf_pdu_get() for each field since every PDU word is converted to host
+ * order only once. The H.264 header is only read from the AVTPDU payload if
+ * the format subtype is AVTP_CVF_FORMAT_SUBTYPE_H264.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_cvf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+						struct avtp_cvf_hdr *hdr);
+
+/* Set all CVF AVTPDU header fields at once from host order struct. This is
+ * cheaper than calling avtp_cvf_pdu_set() for each field since every PDU word
+ * is written only once. The 'subtype' field is set to AVTP_SUBTYPE_CVF and
+ * 'version' is set to 0. The H.264 header is only written to the AVTPDU
+ * payload if the format subtype is AVTP_CVF_FORMAT_SUBTYPE_H264.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_cvf_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_cvf_hdr *hdr);
+
+/* H.264 packetizer. Splits access units into CVF H.264 PDUs carrying RFC 6184
+ * Single NAL Unit or FU-A packets. Fields are private, use the
+ * avtp_cvf_h264_packetizer_*() functions to handle them.
+ */
+struct avtp_cvf_h264_packetizer {
+	uint8_t tmpl[sizeof(struct avtp_stream_pdu) + sizeof(uint32_t)];
+	size_t max_data_len;
+	uint32_t avtp_time;
+	uint8_t seq_num;
+	const uint8_t *next;
+	const uint8_t *end;
+	const uint8_t *nal;
+	size_t nal_len;
+	uint8_t fu_indicator;
+	uint8_t fu_type;
+};
+
+/* PDU emitted by the H.264 packetizer. Only the headers are written to 'hdr',
+ * the NAL unit data is referenced from the access unit buffer so it is never
+ * copied. 'iov' is ready to be handed to sendmsg(): iov[0] points to 'hdr'
+ * and iov[1] to the NAL unit data.
+ */
+struct avtp_cvf_h264_packet {
+	uint8_t hdr[AVTP_CVF_H264_MAX_HDR_LEN];
+	struct iovec iov[2];
+};
+
+/* Initialize H.264 packetizer.
+ * @pkt: Pointer to packetizer.
+ * @tmpl: Pointer to CVF H.264 PDU template, including the H.264 header,
+ *        previously built by avtp_cvf_pdu_pack(). 'sequence_num',
+ *        'avtp_timestamp', 'stream_data_length', 'M' and 'h264_timestamp' are
+ *        set by the packetizer on each PDU.
+ * @max_pdu_size: Maximum size of emitted PDUs, headers included.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_cvf_h264_packetizer_init(struct avtp_cvf_h264_packetizer *pkt,
+					const struct avtp_stream_pdu *tmpl,
+					size_t max_pdu_size);
+
+/* Start packetizing an access unit. NAL units larger than what fits in a PDU
+ * are fragmented into FU-A packets. 'M' is set on the last PDU of the access
+ * unit. The access unit buffer must not be changed until all PDUs emitted
+ * from it are sent.
+ * @pkt: Pointer to packetizer.
+ * @au: Pointer to access unit in H.264 byte-stream format (i.e. NAL units
+ *      prefixed by start codes). Start codes are not carried in PDUs.
+ * @len: Length of access unit, in bytes.
+ * @avtp_time: Value of 'avtp_timestamp' field of all PDUs from access unit.
+ * @h264_time: Value of 'h264_timestamp' field of all PDUs from access unit.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'au' has no start code.
+ */
+int avtp_cvf_h264_packetizer_start(struct avtp_cvf_h264_packetizer *pkt,
+					const void *au, size_t len,
+					uint32_t avtp_time, uint32_t h264_time);
+
+/* Emit next PDU from current access unit. Sequence numbers are kept by the
+ * packetizer and incremented on each PDU.
+ * @pkt: Pointer to packetizer.
+ * @packet: Pointer to packet where the PDU is emitted.
+ *
+ * Returns:
+ *    1: PDU emitted.
+ *    0: No PDUs left in access unit.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_cvf_h264_packetizer_next(struct avtp_cvf_h264_packetizer *pkt,
+					struct avtp_cvf_h264_packet *packet);
+
+/* H.264 depacketizer.
+ *
+ * Gathers CVF H.264 PDUs carrying RFC 6184 Single NAL Unit, STAP-A or FU-A
+ * packets into complete access units, i.e. frames, delimited by the 'M'
+ * field. Frames are rebuilt in H.264 byte-stream format inside an arena
+ * allocated once when the depacketizer is created, and stay there until they
+ * are released, in the same order they were returned. Frames with missing
+ * PDUs, detected through 'sequence_num' gaps, or malformed payloads are
+ * dropped as a whole.
+ */
+struct avtp_cvf_h264_depacketizer;
+
+/* Frame returned by the H.264 depacketizer. */
+struct avtp_cvf_h264_frame {
+	/* Access unit in H.264 byte-stream format, inside the arena. */
+	const uint8_t *data;
+	size_t len;
+	/* 'avtp_timestamp', 'h264_timestamp' and 'ptv' fields from the last
+	 * PDU of the frame.
+	 */
+	uint32_t avtp_time;
+	uint32_t h264_time;
+	uint8_t h264_ptv;
+	/* PDUs lost and frames dropped since the previous frame returned. */
+	uint32_t lost_pdus;
+	uint32_t dropped_frames;
+};
+
+/* Create H.264 depacketizer.
+ * @depkt: Pointer to variable which the new depacketizer should be saved.
+ * @arena_size: Size, in bytes, of the arena where frames are rebuilt. It
+ *              must fit all frames not yet released plus the one being
+ *              gathered.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_cvf_h264_depacketizer_create(struct avtp_cvf_h264_depacketizer **depkt,
+							size_t arena_size);
+
+/* Destroy depacketizer created by avtp_cvf_h264_depacketizer_create(). Frames
+ * not released are no longer valid.
+ * @depkt: Pointer to depacketizer.
+ */
+void avtp_cvf_h264_depacketizer_destroy(
+				struct avtp_cvf_h264_depacketizer *depkt);
+
+/* Push a received CVF H.264 PDU into the depacketizer. PDUs with sequence
+ * number up to 128 behind the expected one, i.e. duplicate or reordered
+ * ones, are skipped.
+ * @depkt: Pointer to depacketizer.
+ * @pdu: Pointer to PDU struct.
+ * @len: Length of PDU, in bytes.
+ * @frame: Pointer to struct where a completed frame is saved.
+ *
+ * Returns:
+ *    1: PDU completed a frame, saved to 'frame'.
+ *    0: More PDUs are needed to complete a frame.
+ *    -EINVAL: If any argument is invalid or 'pdu' is not a CVF H.264 PDU.
+ *    -ENOSPC: If the arena has no room left for the frame being gathered,
+ *             which is dropped. Release frames to make room.
+ */
+int avtp_cvf_h264_depacketizer_push(struct avtp_cvf_h264_depacketizer *depkt,
+					const struct avtp_stream_pdu *pdu,
+					size_t len,
+					struct avtp_cvf_h264_frame *frame);
+
+/* Release a frame returned by avtp_cvf_h264_depacketizer_push() so its room
+ * in the arena can be reused. Frames must be released in the order they were
+ * returned.
+ * @depkt: Pointer to depacketizer.
+ * @frame: Pointer to frame.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or 'frame' is not the oldest frame
+ *             held by the depacketizer.
+ */
+int avtp_cvf_h264_depacketizer_release(struct avtp_cvf_h264_depacketizer *depkt,
+				const struct avtp_cvf_h264_frame *frame);
+
 #ifdef __cplusplus
 }
 #endif
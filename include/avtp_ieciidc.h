@@ -37,6 +37,24 @@ extern "C" {
 #define AVTP_IECIIDC_TAG_NO_CIP		0x00
 #define AVTP_IECIIDC_TAG_CIP		0x01
 
+/* CIP 'fmt' value of IEC 61883-6 Audio and Music data. */
+#define AVTP_IECIIDC_CIP_FMT_AM824	0x10
+
+/* IEC 61883-6 'sfc' (sampling frequency code) field values. */
+#define AVTP_IECIIDC_SFC_32KHZ		0x00
+#define AVTP_IECIIDC_SFC_44_1KHZ	0x01
+#define AVTP_IECIIDC_SFC_48KHZ		0x02
+#define AVTP_IECIIDC_SFC_88_2KHZ	0x03
+#define AVTP_IECIIDC_SFC_96KHZ		0x04
+#define AVTP_IECIIDC_SFC_176_4KHZ	0x05
+#define AVTP_IECIIDC_SFC_192KHZ		0x06
+
+/* IEC 61883-6 'syt' value meaning no timing information. */
+#define AVTP_IECIIDC_SYT_NO_INFO	0xFFFF
+
+/* AM824 label of Multi-bit Linear Audio quadlets with 24-bit samples. */
+#define AVTP_IECIIDC_AM824_LABEL_MBLA	0x40
+
 enum avtp_ieciidc_field {
 	AVTP_IECIIDC_FIELD_SV,
 	AVTP_IECIIDC_FIELD_MR,
@@ -108,6 +126,38 @@ struct avtp_ieciidc_cip_source_packet {
 	uint8_t cip_with_sph_payload[0];
 };
 
+/* Host order representation of all IEC 61883/IIDC AVTPDU header fields. The
+ * 'cip_*' fields are only meaningful if 'tag' is AVTP_IECIIDC_TAG_CIP,
+ * otherwise they are left zeroed. FDF fields overlap each other, so all of
+ * them are decoded and it is up to the caller to pick the ones relevant for
+ * the IEC 61883 part in use.
+ */
+struct avtp_ieciidc_hdr {
+	struct avtp_stream_hdr stream;
+	uint32_t gateway_info;
+	uint16_t cip_syt;
+	uint8_t gv;
+	uint8_t tag;
+	uint8_t channel;
+	uint8_t tcode;
+	uint8_t sy;
+	uint8_t cip_qi_1;
+	uint8_t cip_qi_2;
+	uint8_t cip_sid;
+	uint8_t cip_dbs;
+	uint8_t cip_fn;
+	uint8_t cip_qpc;
+	uint8_t cip_sph;
+	uint8_t cip_dbc;
+	uint8_t cip_fmt;
+	uint8_t cip_tsf;
+	uint8_t cip_evt;
+	uint8_t cip_sfc;
+	uint8_t cip_n;
+	uint8_t cip_nd;
+	uint8_t cip_no_data;
+};
+
 /* Get value from IEC 61883/IIDC AVTPDU field.
  * @pdu: Pointer to PDU struct.
  * @field: PDU field to be retrieved.
@@ -147,6 +197,114 @@ int avtp_ieciidc_pdu_set(struct avtp_stream_pdu *pdu,
  */
 int avtp_ieciidc_pdu_init(struct avtp_stream_pdu *pdu, uint8_t tag);
 
+/* Retrieve all IEC 61883/IIDC AVTPDU header fields at once. This is cheaper
+ * than calling avtp_ieciidc_pdu_get() for each field since every PDU word is
+ * converted to host order only once. The CIP header is only read from the
+ * AVTPDU payload if 'tag' is AVTP_IECIIDC_TAG_CIP.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ieciidc_pdu_unpack(const struct avtp_stream_pdu *pdu,
+					struct avtp_ieciidc_hdr *hdr);
+
+/* Set all IEC 61883/IIDC AVTPDU header fields at once from host order struct.
+ * This is cheaper than calling avtp_ieciidc_pdu_set() for each field since
+ * every PDU word is written only once. The 'subtype' field is set to
+ * AVTP_SUBTYPE_61883_IIDC and 'version' is set to 0. The CIP header is only
+ * written to the AVTPDU payload if 'tag' is AVTP_IECIIDC_TAG_CIP. Since FDF
+ * fields overlap, their values are OR'ed together into the FDF.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ieciidc_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_ieciidc_hdr *hdr);
+
+/* IEC 61883-6 AM824 converter. Keeps the state carried from packet to packet
+ * of an AM824 stream, like the data block counter. Fields are private, use
+ * the avtp_ieciidc_am824_*() functions to handle them.
+ */
+struct avtp_ieciidc_am824 {
+	uint32_t rate;
+	uint8_t sfc;
+	uint8_t dbs;
+	uint8_t channels;
+	uint8_t syt_interval;
+	uint8_t dbc;
+};
+
+/* Initialize AM824 converter.
+ * @am: Pointer to converter.
+ * @sfc: Sampling frequency code, one of AVTP_IECIIDC_SFC_* values.
+ * @dbs: Data block size, in quadlets.
+ * @channels: Number of audio channels, carried by the first 'channels'
+ *            quadlets of each data block. Must not be greater than 'dbs'.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ieciidc_am824_init(struct avtp_ieciidc_am824 *am, uint8_t sfc,
+					uint8_t dbs, uint8_t channels);
+
+/* Encode interleaved PCM samples into AM824 data blocks, one block per frame.
+ * The 24 most significant bits of each sample are written in network order
+ * after an AVTP_IECIIDC_AM824_LABEL_MBLA label. Quadlets past 'channels' in
+ * a data block are filled with silence.
+ *
+ * CIP header fields from 'hdr' describing the data blocks are set as well so
+ * 'hdr' can be handed to avtp_ieciidc_pdu_pack() afterwards: 'cip_fmt',
+ * 'cip_dbs', 'cip_dbc', the FDF fields, 'cip_syt' and 'stream_data_len'. The
+ * data block counter is advanced by 'frames' on each call. 'cip_syt' carries
+ * the presentation time of the first data block whose DBC is a multiple of
+ * SYT_INTERVAL, or AVTP_IECIIDC_SYT_NO_INFO if there is none. Packets without
+ * frames are encoded as NO-DATA packets.
+ * @am: Pointer to converter.
+ * @hdr: Pointer to header struct to be updated.
+ * @payload: Pointer to CIP data payload (e.g. 'cip_data_payload' field from
+ *           struct avtp_ieciidc_cip_payload).
+ * @samples: Pointer to interleaved samples buffer, 'channels' samples per
+ *           frame.
+ * @frames: Number of frames to be encoded.
+ * @time: Presentation time of the first frame, in nanoseconds, from the
+ *        media clock of the stream.
+ *
+ * Returns:
+ *    Number of payload bytes written (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ieciidc_am824_encode(struct avtp_ieciidc_am824 *am,
+				struct avtp_ieciidc_hdr *hdr, void *payload,
+				const int32_t *samples, unsigned int frames,
+				uint64_t time);
+
+/* Decode PCM samples from AM824 data blocks. This is the reverse operation of
+ * avtp_ieciidc_am824_encode(): labels are stripped and the 24-bit samples are
+ * written to the most significant bits of each sample. Quadlets past
+ * 'channels' in a data block are skipped.
+ * @am: Pointer to converter.
+ * @hdr: Pointer to header struct retrieved by avtp_ieciidc_pdu_unpack().
+ * @payload: Pointer to CIP data payload.
+ * @samples: Pointer to interleaved samples buffer.
+ * @frames: Maximum number of frames to be decoded.
+ *
+ * Returns:
+ *    Number of frames decoded (>= 0): Success.
+ *    -EINVAL: If any argument is invalid or 'hdr' doesn't describe AM824
+ *             data blocks of 'am' size.
+ */
+int avtp_ieciidc_am824_decode(const struct avtp_ieciidc_am824 *am,
+				const struct avtp_ieciidc_hdr *hdr,
+				const void *payload, int32_t *samples,
+				unsigned int frames);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Inline accessors for AVTPDU header fields.
+ *
+ * The avtp_*_pdu_get() and avtp_*_pdu_set() APIs validate their arguments and
+ * dispatch on the field enum at runtime, which the compiler can't optimize
+ * across the library boundary even when the field is a constant. This header
+ * provides one 'static inline' getter and setter per field instead, so each
+ * access boils down to a load, a byte swap and a mask.
+ *
+ * These accessors do no argument checking at all: 'pdu' must be valid and
+ * values passed to setters are silently truncated to the field width. PDUs
+ * received from the network can be validated once by avtp_pdu_view_init()
+ * before using them. Fields living in the AVTPDU payload (e.g. H.264
+ * timestamp, RVF RAW header and CIP header fields) are only accessible via
+ * the checked APIs or a PDU view.
+ *
+ * The AVTP_*_SHIFT_* and AVTP_*_MASK_* definitions below describe the header
+ * bit layout and are also what the library itself uses to implement the
+ * checked APIs.
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <stdint.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+#include "avtp_tscf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AVTP_BITMASK(len)		((1ULL << (len)) - 1)
+
+/* Common AVTPDU, 'subtype_data' word. */
+#define AVTP_COMMON_SHIFT_SUBTYPE	(31 - 7)
+#define AVTP_COMMON_SHIFT_VERSION	(31 - 11)
+
+#define AVTP_COMMON_MASK_SUBTYPE \
+			(AVTP_BITMASK(8) << AVTP_COMMON_SHIFT_SUBTYPE)
+#define AVTP_COMMON_MASK_VERSION \
+			(AVTP_BITMASK(3) << AVTP_COMMON_SHIFT_VERSION)
+
+/* Stream AVTPDU, 'subtype_data' and 'packet_info' words. */
+#define AVTP_STREAM_SHIFT_SV		(31 - 8)
+#define AVTP_STREAM_SHIFT_MR		(31 - 12)
+#define AVTP_STREAM_SHIFT_TV		(31 - 15)
+#define AVTP_STREAM_SHIFT_SEQ_NUM	(31 - 23)
+#define AVTP_STREAM_SHIFT_TU		(31 - 31)
+#define AVTP_STREAM_SHIFT_STREAM_DATA_LEN	(31 - 15)
+
+#define AVTP_STREAM_MASK_SV \
+			(AVTP_BITMASK(1) << AVTP_STREAM_SHIFT_SV)
+#define AVTP_STREAM_MASK_MR \
+			(AVTP_BITMASK(1) << AVTP_STREAM_SHIFT_MR)
+#define AVTP_STREAM_MASK_TV \
+			(AVTP_BITMASK(1) << AVTP_STREAM_SHIFT_TV)
+#define AVTP_STREAM_MASK_SEQ_NUM \
+			(AVTP_BITMASK(8) << AVTP_STREAM_SHIFT_SEQ_NUM)
+#define AVTP_STREAM_MASK_TU \
+			(AVTP_BITMASK(1) << AVTP_STREAM_SHIFT_TU)
+#define AVTP_STREAM_MASK_STREAM_DATA_LEN \
+			(AVTP_BITMASK(16) << AVTP_STREAM_SHIFT_STREAM_DATA_LEN)
+
+/* AAF AVTPDU, 'format_specific' and 'packet_info' words. */
+#define AVTP_AAF_SHIFT_FORMAT		(31 - 7)
+#define AVTP_AAF_SHIFT_NSR		(31 - 11)
+#define AVTP_AAF_SHIFT_CHAN_PER_FRAME	(31 - 23)
+#define AVTP_AAF_SHIFT_BIT_DEPTH	(31 - 31)
+#define AVTP_AAF_SHIFT_SP		(31 - 19)
+#define AVTP_AAF_SHIFT_EVT		(31 - 23)
+
+#define AVTP_AAF_MASK_FORMAT \
+			(AVTP_BITMASK(8) << AVTP_AAF_SHIFT_FORMAT)
+#define AVTP_AAF_MASK_NSR		(AVTP_BITMASK(4) << AVTP_AAF_SHIFT_NSR)
+#define AVTP_AAF_MASK_CHAN_PER_FRAME \
+			(AVTP_BITMASK(10) << AVTP_AAF_SHIFT_CHAN_PER_FRAME)
+#define AVTP_AAF_MASK_BIT_DEPTH \
+			(AVTP_BITMASK(8) << AVTP_AAF_SHIFT_BIT_DEPTH)
+#define AVTP_AAF_MASK_SP		(AVTP_BITMASK(1) << AVTP_AAF_SHIFT_SP)
+#define AVTP_AAF_MASK_EVT		(AVTP_BITMASK(4) << AVTP_AAF_SHIFT_EVT)
+
+/* CVF AVTPDU, 'format_specific' and 'packet_info' words. */
+#define AVTP_CVF_SHIFT_FORMAT		(31 - 7)
+#define AVTP_CVF_SHIFT_FORMAT_SUBTYPE	(31 - 15)
+#define AVTP_CVF_SHIFT_H264_PTV		(31 - 18)
+#define AVTP_CVF_SHIFT_M		(31 - 19)
+#define AVTP_CVF_SHIFT_EVT		(31 - 23)
+
+#define AVTP_CVF_MASK_FORMAT \
+			(AVTP_BITMASK(8) << AVTP_CVF_SHIFT_FORMAT)
+#define AVTP_CVF_MASK_FORMAT_SUBTYPE \
+			(AVTP_BITMASK(8) << AVTP_CVF_SHIFT_FORMAT_SUBTYPE)
+#define AVTP_CVF_MASK_H264_PTV \
+			(AVTP_BITMASK(1) << AVTP_CVF_SHIFT_H264_PTV)
+#define AVTP_CVF_MASK_M			(AVTP_BITMASK(1) << AVTP_CVF_SHIFT_M)
+#define AVTP_CVF_MASK_EVT		(AVTP_BITMASK(4) << AVTP_CVF_SHIFT_EVT)
+
+/* RVF AVTPDU, 'format_specific' and 'packet_info' words. */
+#define AVTP_RVF_SHIFT_ACTIVE_PIXELS	(31 - 15)
+#define AVTP_RVF_SHIFT_TOTAL_LINES	(31 - 31)
+#define AVTP_RVF_SHIFT_AP		(31 - 16)
+#define AVTP_RVF_SHIFT_F		(31 - 18)
+#define AVTP_RVF_SHIFT_EF		(31 - 19)
+#define AVTP_RVF_SHIFT_EVT		(31 - 23)
+#define AVTP_RVF_SHIFT_PD		(31 - 24)
+#define AVTP_RVF_SHIFT_I		(31 - 25)
+
+#define AVTP_RVF_MASK_ACTIVE_PIXELS \
+			(AVTP_BITMASK(16) << AVTP_RVF_SHIFT_ACTIVE_PIXELS)
+#define AVTP_RVF_MASK_TOTAL_LINES \
+			(AVTP_BITMASK(16) << AVTP_RVF_SHIFT_TOTAL_LINES)
+#define AVTP_RVF_MASK_AP		(AVTP_BITMASK(1) << AVTP_RVF_SHIFT_AP)
+#define AVTP_RVF_MASK_F			(AVTP_BITMASK(1) << AVTP_RVF_SHIFT_F)
+#define AVTP_RVF_MASK_EF		(AVTP_BITMASK(1) << AVTP_RVF_SHIFT_EF)
+#define AVTP_RVF_MASK_EVT		(AVTP_BITMASK(4) << AVTP_RVF_SHIFT_EVT)
+#define AVTP_RVF_MASK_PD		(AVTP_BITMASK(1) << AVTP_RVF_SHIFT_PD)
+#define AVTP_RVF_MASK_I			(AVTP_BITMASK(1) << AVTP_RVF_SHIFT_I)
+
+/* IEC 61883/IIDC AVTPDU, 'subtype_data' and 'packet_info' words. */
+#define AVTP_IECIIDC_SHIFT_GV		(31 - 14)
+#define AVTP_IECIIDC_SHIFT_TAG		(31 - 17)
+#define AVTP_IECIIDC_SHIFT_CHANNEL	(31 - 23)
+#define AVTP_IECIIDC_SHIFT_TCODE	(31 - 27)
+#define AVTP_IECIIDC_SHIFT_SY		(31 - 31)
+
+#define AVTP_IECIIDC_MASK_GV \
+			(AVTP_BITMASK(1) << AVTP_IECIIDC_SHIFT_GV)
+#define AVTP_IECIIDC_MASK_TAG \
+			(AVTP_BITMASK(2) << AVTP_IECIIDC_SHIFT_TAG)
+#define AVTP_IECIIDC_MASK_CHANNEL \
+			(AVTP_BITMASK(6) << AVTP_IECIIDC_SHIFT_CHANNEL)
+#define AVTP_IECIIDC_MASK_TCODE \
+			(AVTP_BITMASK(4) << AVTP_IECIIDC_SHIFT_TCODE)
+#define AVTP_IECIIDC_MASK_SY \
+			(AVTP_BITMASK(4) << AVTP_IECIIDC_SHIFT_SY)
+
+/* CRF AVTPDU, 'subtype_data' word and 64-bit 'packet_info' word. */
+#define AVTP_CRF_SHIFT_SV		(31 - 8)
+#define AVTP_CRF_SHIFT_MR		(31 - 12)
+#define AVTP_CRF_SHIFT_FS		(31 - 14)
+#define AVTP_CRF_SHIFT_TU		(31 - 15)
+#define AVTP_CRF_SHIFT_SEQ_NUM		(31 - 23)
+#define AVTP_CRF_SHIFT_TYPE		(31 - 31)
+#define AVTP_CRF_SHIFT_PULL		(63 - 2)
+#define AVTP_CRF_SHIFT_BASE_FREQ	(63 - 31)
+#define AVTP_CRF_SHIFT_CRF_DATA_LEN	(63 - 47)
+#define AVTP_CRF_SHIFT_TIMESTAMP_INTERVAL	(63 - 63)
+
+#define AVTP_CRF_MASK_SV		(AVTP_BITMASK(1) << AVTP_CRF_SHIFT_SV)
+#define AVTP_CRF_MASK_MR		(AVTP_BITMASK(1) << AVTP_CRF_SHIFT_MR)
+#define AVTP_CRF_MASK_FS		(AVTP_BITMASK(1) << AVTP_CRF_SHIFT_FS)
+#define AVTP_CRF_MASK_TU		(AVTP_BITMASK(1) << AVTP_CRF_SHIFT_TU)
+#define AVTP_CRF_MASK_SEQ_NUM \
+			(AVTP_BITMASK(8) << AVTP_CRF_SHIFT_SEQ_NUM)
+#define AVTP_CRF_MASK_TYPE		(AVTP_BITMASK(8) << AVTP_CRF_SHIFT_TYPE)
+#define AVTP_CRF_MASK_PULL		(AVTP_BITMASK(3) << AVTP_CRF_SHIFT_PULL)
+#define AVTP_CRF_MASK_BASE_FREQ \
+			(AVTP_BITMASK(29) << AVTP_CRF_SHIFT_BASE_FREQ)
+#define AVTP_CRF_MASK_CRF_DATA_LEN \
+			(AVTP_BITMASK(16) << AVTP_CRF_SHIFT_CRF_DATA_LEN)
+#define AVTP_CRF_MASK_TIMESTAMP_INTERVAL \
+			(AVTP_BITMASK(16) << AVTP_CRF_SHIFT_TIMESTAMP_INTERVAL)
+
+/* NTSCF AVTPDU, 'subtype_data' word. */
+#define AVTP_NTSCF_SHIFT_SV		(31 - 8)
+#define AVTP_NTSCF_SHIFT_DATA_LEN	(31 - 23)
+#define AVTP_NTSCF_SHIFT_SEQ_NUM	(31 - 31)
+
+#define AVTP_NTSCF_MASK_SV		(AVTP_BITMASK(1) << AVTP_NTSCF_SHIFT_SV)
+#define AVTP_NTSCF_MASK_DATA_LEN \
+			(AVTP_BITMASK(11) << AVTP_NTSCF_SHIFT_DATA_LEN)
+#define AVTP_NTSCF_MASK_SEQ_NUM \
+			(AVTP_BITMASK(8) << AVTP_NTSCF_SHIFT_SEQ_NUM)
+
+/* Define avtp_<fmt>_get_<field>() and avtp_<fmt>_set_<field>() for a bit
+ * field from a 32-bit header word. 'FMT' and 'FIELD' select the
+ * AVTP_<FMT>_SHIFT_<FIELD> and AVTP_<FMT>_MASK_<FIELD> definitions.
+ */
+#define AVTP_INLINE_FIELD32(fmt, FMT, type, word, field, FIELD)		\
+static inline uint32_t avtp_##fmt##_get_##field(const type *pdu)	\
+{									\
+	return (uint32_t) ((ntohl(pdu->word) & AVTP_##FMT##_MASK_##FIELD) \
+					>> AVTP_##FMT##_SHIFT_##FIELD);	\
+}									\
+									\
+static inline void avtp_##fmt##_set_##field(type *pdu, uint32_t val)	\
+{									\
+	uint32_t bitmap = ntohl(pdu->word);				\
+									\
+	bitmap = (uint32_t) ((bitmap & ~AVTP_##FMT##_MASK_##FIELD) |	\
+			(((uint64_t) val << AVTP_##FMT##_SHIFT_##FIELD)	\
+					& AVTP_##FMT##_MASK_##FIELD));	\
+	pdu->word = htonl(bitmap);					\
+}
+
+/* Same as AVTP_INLINE_FIELD32() but for a bit field from a 64-bit header
+ * word.
+ */
+#define AVTP_INLINE_FIELD64(fmt, FMT, type, word, field, FIELD)		\
+static inline uint64_t avtp_##fmt##_get_##field(const type *pdu)	\
+{									\
+	return (be64toh(pdu->word) & AVTP_##FMT##_MASK_##FIELD)		\
+					>> AVTP_##FMT##_SHIFT_##FIELD;	\
+}									\
+									\
+static inline void avtp_##fmt##_set_##field(type *pdu, uint64_t val)	\
+{									\
+	uint64_t bitmap = be64toh(pdu->word);				\
+									\
+	bitmap = (bitmap & ~AVTP_##FMT##_MASK_##FIELD) |		\
+			((val << AVTP_##FMT##_SHIFT_##FIELD)		\
+					& AVTP_##FMT##_MASK_##FIELD);	\
+	pdu->word = htobe64(bitmap);					\
+}
+
+AVTP_INLINE_FIELD32(common, COMMON, struct avtp_common_pdu, subtype_data,
+							subtype, SUBTYPE)
+AVTP_INLINE_FIELD32(common, COMMON, struct avtp_common_pdu, subtype_data,
+							version, VERSION)
+
+AVTP_INLINE_FIELD32(stream, STREAM, struct avtp_stream_pdu, subtype_data,
+							sv, SV)
+AVTP_INLINE_FIELD32(stream, STREAM, struct avtp_stream_pdu, subtype_data,
+							mr, MR)
+AVTP_INLINE_FIELD32(stream, STREAM, struct avtp_stream_pdu, subtype_data,
+							tv, TV)
+AVTP_INLINE_FIELD32(stream, STREAM, struct avtp_stream_pdu, subtype_data,
+							seq_num, SEQ_NUM)
+AVTP_INLINE_FIELD32(stream, STREAM, struct avtp_stream_pdu, subtype_data,
+							tu, TU)
+AVTP_INLINE_FIELD32(stream, STREAM, struct avtp_stream_pdu, packet_info,
+					stream_data_len, STREAM_DATA_LEN)
+
+static inline uint64_t avtp_stream_get_stream_id(
+					const struct avtp_stream_pdu *pdu)
+{
+	return be64toh(pdu->stream_id);
+}
+
+static inline void avtp_stream_set_stream_id(struct avtp_stream_pdu *pdu,
+								uint64_t val)
+{
+	pdu->stream_id = htobe64(val);
+}
+
+static inline uint32_t avtp_stream_get_timestamp(
+					const struct avtp_stream_pdu *pdu)
+{
+	return ntohl(pdu->avtp_time);
+}
+
+static inline void avtp_stream_set_timestamp(struct avtp_stream_pdu *pdu,
+								uint32_t val)
+{
+	pdu->avtp_time = htonl(val);
+}
+
+AVTP_INLINE_FIELD32(aaf, AAF, struct avtp_stream_pdu, format_specific,
+							format, FORMAT)
+AVTP_INLINE_FIELD32(aaf, AAF, struct avtp_stream_pdu, format_specific,
+							nsr, NSR)
+AVTP_INLINE_FIELD32(aaf, AAF, struct avtp_stream_pdu, format_specific,
+					chan_per_frame, CHAN_PER_FRAME)
+AVTP_INLINE_FIELD32(aaf, AAF, struct avtp_stream_pdu, format_specific,
+							bit_depth, BIT_DEPTH)
+AVTP_INLINE_FIELD32(aaf, AAF, struct avtp_stream_pdu, packet_info, sp, SP)
+AVTP_INLINE_FIELD32(aaf, AAF, struct avtp_stream_pdu, packet_info, evt, EVT)
+
+AVTP_INLINE_FIELD32(cvf, CVF, struct avtp_stream_pdu, format_specific,
+							format, FORMAT)
+AVTP_INLINE_FIELD32(cvf, CVF, struct avtp_stream_pdu, format_specific,
+					format_subtype, FORMAT_SUBTYPE)
+AVTP_INLINE_FIELD32(cvf, CVF, struct avtp_stream_pdu, packet_info,
+							h264_ptv, H264_PTV)
+AVTP_INLINE_FIELD32(cvf, CVF, struct avtp_stream_pdu, packet_info, m, M)
+AVTP_INLINE_FIELD32(cvf, CVF, struct avtp_stream_pdu, packet_info, evt, EVT)
+
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, format_specific,
+					active_pixels, ACTIVE_PIXELS)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, format_specific,
+					total_lines, TOTAL_LINES)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, packet_info, ap, AP)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, packet_info, f, F)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, packet_info, ef, EF)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, packet_info, evt, EVT)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, packet_info, pd, PD)
+AVTP_INLINE_FIELD32(rvf, RVF, struct avtp_stream_pdu, packet_info, i, I)
+
+AVTP_INLINE_FIELD32(ieciidc, IECIIDC, struct avtp_stream_pdu, subtype_data,
+							gv, GV)
+AVTP_INLINE_FIELD32(ieciidc, IECIIDC, struct avtp_stream_pdu, packet_info,
+							tag, TAG)
+AVTP_INLINE_FIELD32(ieciidc, IECIIDC, struct avtp_stream_pdu, packet_info,
+							channel, CHANNEL)
+AVTP_INLINE_FIELD32(ieciidc, IECIIDC, struct avtp_stream_pdu, packet_info,
+							tcode, TCODE)
+AVTP_INLINE_FIELD32(ieciidc, IECIIDC, struct avtp_stream_pdu, packet_info,
+							sy, SY)
+
+static inline uint32_t avtp_ieciidc_get_gateway_info(
+					const struct avtp_stream_pdu *pdu)
+{
+	return ntohl(pdu->format_specific);
+}
+
+static inline void avtp_ieciidc_set_gateway_info(struct avtp_stream_pdu *pdu,
+								uint32_t val)
+{
+	pdu->format_specific = htonl(val);
+}
+
+AVTP_INLINE_FIELD32(crf, CRF, struct avtp_crf_pdu, subtype_data, sv, SV)
+AVTP_INLINE_FIELD32(crf, CRF, struct avtp_crf_pdu, subtype_data, mr, MR)
+AVTP_INLINE_FIELD32(crf, CRF, struct avtp_crf_pdu, subtype_data, fs, FS)
+AVTP_INLINE_FIELD32(crf, CRF, struct avtp_crf_pdu, subtype_data, tu, TU)
+AVTP_INLINE_FIELD32(crf, CRF, struct avtp_crf_pdu, subtype_data,
+							seq_num, SEQ_NUM)
+AVTP_INLINE_FIELD32(crf, CRF, struct avtp_crf_pdu, subtype_data, type, TYPE)
+AVTP_INLINE_FIELD64(crf, CRF, struct avtp_crf_pdu, packet_info, pull, PULL)
+AVTP_INLINE_FIELD64(crf, CRF, struct avtp_crf_pdu, packet_info,
+							base_freq, BASE_FREQ)
+AVTP_INLINE_FIELD64(crf, CRF, struct avtp_crf_pdu, packet_info,
+					crf_data_len, CRF_DATA_LEN)
+AVTP_INLINE_FIELD64(crf, CRF, struct avtp_crf_pdu, packet_info,
+				timestamp_interval, TIMESTAMP_INTERVAL)
+
+static inline uint64_t avtp_crf_get_stream_id(const struct avtp_crf_pdu *pdu)
+{
+	return be64toh(pdu->stream_id);
+}
+
+static inline void avtp_crf_set_stream_id(struct avtp_crf_pdu *pdu,
+								uint64_t val)
+{
+	pdu->stream_id = htobe64(val);
+}
+
+AVTP_INLINE_FIELD32(ntscf, NTSCF, struct avtp_ntscf_pdu, subtype_data,
+							sv, SV)
+AVTP_INLINE_FIELD32(ntscf, NTSCF, struct avtp_ntscf_pdu, subtype_data,
+							data_len, DATA_LEN)
+AVTP_INLINE_FIELD32(ntscf, NTSCF, struct avtp_ntscf_pdu, subtype_data,
+							seq_num, SEQ_NUM)
+
+static inline uint64_t avtp_ntscf_get_stream_id(
+					const struct avtp_ntscf_pdu *pdu)
+{
+	return be64toh(pdu->stream_id);
+}
+
+static inline void avtp_ntscf_set_stream_id(struct avtp_ntscf_pdu *pdu,
+								uint64_t val)
+{
+	pdu->stream_id = htobe64(val);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "avtp_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Jitter buffer.
+ *
+ * Holds the PCM frames received from one stream (e.g. decoded from AAF
+ * PDUs by avtp_aaf_pcm_decode()) in a ring keyed by presentation time, and
+ * plays them out in fixed size blocks, each one at its presentation time
+ * plus the buffer delay. Presentation times are unwrapped, e.g. by
+ * avtp_stream_ctx_receive(), and must all come from the same clock.
+ *
+ * Frames are placed in the ring by their presentation time, so PDUs
+ * arriving out of order are reordered as long as their frames weren't
+ * played yet. PDUs without presentation time (e.g. from AAF streams in
+ * sparse timestamp mode, following lost PDUs) are placed by their sequence
+ * number instead, relative to the last PDU placed, assuming all PDUs carry
+ * the same number of frames. Frames arriving after their block was played
+ * are late and dropped, as are frames too far in the future to fit in the
+ * ring. PDUs more than a ring length away from the playout position (e.g.
+ * once the talker restarts) restart the buffer at their presentation time
+ * instead. Frames missing from a block once it is played are concealed by
+ * zero-filling them or by repeating the frame at the same position from
+ * the previous block.
+ *
+ * The delay is adapted between a minimum and a maximum, one block at a
+ * time, by avtp_jbuf_adapt(): it grows whenever frames were late since the
+ * previous call, and shrinks when the latency histogram from the stream
+ * stats (see struct avtp_stats_snapshot) shows that all but
+ * AVTP_JBUF_ADAPT_PERCENTILE percent of the PDUs would still arrive before
+ * their block is played with a block less of delay. Playout latency is so kept
+ * as low as the network allows, while bursts only cost a few concealed
+ * blocks until the delay catches up.
+ *
+ * Storage for the ring is allocated at creation, so no memory is allocated
+ * afterwards. A jitter buffer may only be used by one thread at a time.
+ */
+struct avtp_jbuf;
+
+/* Share of PDUs, in percent, allowed to arrive with less slack than what
+ * avtp_jbuf_adapt() requires to shrink the delay.
+ */
+#define AVTP_JBUF_ADAPT_PERCENTILE	1
+
+/* How missing frames are concealed. */
+enum avtp_jbuf_conceal {
+	/* Missing frames are played as silence. */
+	AVTP_JBUF_CONCEAL_ZERO,
+	/* Missing frames are played as the frame from the previous block at
+	 * the same position, which may have been concealed as well.
+	 */
+	AVTP_JBUF_CONCEAL_REPEAT,
+};
+
+struct avtp_jbuf_config {
+	/* Size, in bytes, of one frame, i.e. one sample from every
+	 * channel.
+	 */
+	unsigned int frame_size;
+	/* Number of frames per block played out. */
+	unsigned int block_frames;
+	/* Number of blocks in the ring. It must cover the max transit time
+	 * of the stream plus 'max_delay', since frames are held from their
+	 * arrival until they are played.
+	 */
+	unsigned int blocks;
+	/* Sample rate, in Hz. */
+	uint32_t sample_rate;
+	/* Range, in ns, of the delay blocks are played after their
+	 * presentation time. The buffer starts at 'min_delay'.
+	 */
+	uint64_t min_delay;
+	uint64_t max_delay;
+	enum avtp_jbuf_conceal conceal;
+};
+
+struct avtp_jbuf_stats {
+	/* Frames played out, including concealed ones. */
+	uint64_t played;
+	/* Frames missing from blocks played out. */
+	uint64_t concealed;
+	/* Frames which arrived after their block was played. */
+	uint64_t late;
+	/* Frames which didn't fit in the ring. */
+	uint64_t overflows;
+	/* Current delay, in ns. */
+	uint64_t delay;
+};
+
+/* Create a jitter buffer.
+ * @jbuf: Pointer to variable which the new jitter buffer should be saved.
+ * @cfg: Pointer to jitter buffer configuration.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, or if 'max_delay' doesn't fit in
+ *             the ring.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_jbuf_create(struct avtp_jbuf **jbuf,
+				const struct avtp_jbuf_config *cfg);
+
+/* Destroy jitter buffer created by avtp_jbuf_create().
+ * @jbuf: Pointer to jitter buffer.
+ */
+void avtp_jbuf_destroy(struct avtp_jbuf *jbuf);
+
+/* Store the frames carried by a PDU. The first PDU stored with a
+ * presentation time, or the one restarting the buffer, sets the time the
+ * next block starts at.
+ * @jbuf: Pointer to jitter buffer.
+ * @time: Presentation time of the first frame, in ns, or 0 if unknown.
+ * @seq_num: Value of 'sequence_num' field from the PDU.
+ * @frames: Frames to be stored.
+ * @count: Number of frames.
+ *
+ * Returns:
+ *    Number of frames stored (>= 0), i.e. neither late nor overflowing the
+ *             ring: Success. PDUs without presentation time are not stored
+ *             until some PDU with one is.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_jbuf_put(struct avtp_jbuf *jbuf, uint64_t time, uint8_t seq_num,
+				const void *frames, unsigned int count);
+
+/* Get the time the next block is due to be played out, i.e. its
+ * presentation time plus the current delay.
+ * @jbuf: Pointer to jitter buffer.
+ * @time: Pointer to variable which the time should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOENT: If no frame was stored yet.
+ */
+int avtp_jbuf_next(const struct avtp_jbuf *jbuf, uint64_t *time);
+
+/* Play out the next block, if it is due at informed time. Missing frames
+ * are concealed and the block is removed from the ring.
+ * @jbuf: Pointer to jitter buffer.
+ * @now: Current time.
+ * @block: Buffer for 'block_frames' frames which the block is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EAGAIN: If the next block is not due yet, or no frame was stored
+ *             yet.
+ */
+int avtp_jbuf_get(struct avtp_jbuf *jbuf, uint64_t now, void *block);
+
+/* Adapt the delay to the network conditions seen since the previous call,
+ * from late frames and from the stream stats. Meant to be called
+ * periodically, e.g. once per second.
+ * @jbuf: Pointer to jitter buffer.
+ * @stats: Pointer to stats object the PDUs stored are accounted in (e.g. by
+ *         avtp_stream_ctx_receive()).
+ *
+ * Returns:
+ *    1: Success, and the delay changed, so the time the next block is due
+ *       changed too.
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_jbuf_adapt(struct avtp_jbuf *jbuf, const struct avtp_stats *stats);
+
+/* Get the jitter buffer counters.
+ * @jbuf: Pointer to jitter buffer.
+ * @stats: Pointer to struct where counters are saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_jbuf_get_stats(const struct avtp_jbuf *jbuf,
+				struct avtp_jbuf_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
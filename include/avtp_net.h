@@ -0,0 +1,987 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "avtp.h"
+#include "avtp_classifier.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Network I/O helpers from libavtp-net.
+ *
+ * These helpers are provided by a separate library, libavtp-net, which is
+ * only available on Linux since it relies on AF_PACKET sockets. Applications
+ * using them must link against both libavtp-net and libavtp.
+ */
+
+/* I/O backends of RX rings and TX queues. */
+enum avtp_net_backend {
+	/* AF_PACKET sockets, going through the kernel network stack. */
+	AVTP_NET_BACKEND_PACKET,
+	/* AF_XDP sockets bound to a single device queue. Frames are received
+	 * into and transmitted from a UMEM area shared with the kernel,
+	 * bypassing the network stack. RX rings attach an XDP program to the
+	 * interface which redirects frames of the ring protocol, untagged or
+	 * with a single VLAN tag, to the socket bound to the queue they were
+	 * received on. Requires CAP_NET_ADMIN, CAP_NET_RAW and CAP_BPF (or
+	 * CAP_SYS_ADMIN). An AF_XDP socket owns its queue, so RX rings and
+	 * TX queues from the same interface must use different queues.
+	 */
+	AVTP_NET_BACKEND_XDP,
+};
+
+/* Timestamping of received and transmitted frames. */
+enum avtp_net_tstamp {
+	/* Frames are not timestamped. */
+	AVTP_NET_TSTAMP_NONE,
+	/* Frames are timestamped by the kernel, on CLOCK_REALTIME. */
+	AVTP_NET_TSTAMP_SOFTWARE,
+	/* Frames are timestamped by the NIC, on its PTP Hardware Clock.
+	 * Enabling timestamping on the device requires CAP_NET_ADMIN, and
+	 * changes its configuration for every socket (e.g. ptp4l ones) since
+	 * all frames must be timestamped. Frames the NIC didn't timestamp
+	 * get a time of 0.
+	 */
+	AVTP_NET_TSTAMP_HARDWARE,
+};
+
+/* Zero-copy receive ring.
+ *
+ * The RX ring is an AF_PACKET socket with a TPACKET_V3 ring mmap'ed into the
+ * application address space. The kernel fills ring blocks with received
+ * frames and hands a block over to the application once it is full or once
+ * its timeout expires, so a single poll() wakeup delivers a whole block of
+ * PDUs. Received PDUs are accessed directly in the ring, without any copy.
+ */
+struct avtp_net_rx;
+
+struct avtp_net_rx_config {
+	/* Network interface name. */
+	const char *ifname;
+	/* Protocol to listen to (e.g. ETH_P_TSN). */
+	uint16_t protocol;
+	/* Size, in bytes, of each ring block. Must be a multiple of the page
+	 * size. If 0, a default value is used.
+	 */
+	unsigned int block_size;
+	/* Number of ring blocks. If 0, a default value is used. */
+	unsigned int block_count;
+	/* Maximum size, in bytes, of a received frame, including kernel
+	 * packet headers. If 0, a default value is used.
+	 */
+	unsigned int frame_size;
+	/* Time, in milliseconds, after which a block which isn't full is
+	 * handed over to the application anyway. If 0, the kernel picks a
+	 * value based on link speed.
+	 */
+	unsigned int block_timeout;
+	/* I/O backend. The XDP backend ignores 'block_size', 'block_count'
+	 * and 'block_timeout' and uses 'frame_size' as the size, a power of
+	 * two not larger than the page size, of UMEM frames.
+	 */
+	enum avtp_net_backend backend;
+	/* XDP backend only: device queue the ring is bound to. */
+	unsigned int queue_id;
+	/* XDP backend only: number of UMEM frames, a power of two. If 0, a
+	 * default value is used.
+	 */
+	unsigned int frame_count;
+	/* Timestamping of received frames, so arrival times don't include
+	 * the time the application takes to wake up. Not supported by the
+	 * XDP backend.
+	 */
+	enum avtp_net_tstamp tstamp;
+};
+
+/* Create a RX ring.
+ * @rx: Pointer to variable which the new ring should be saved.
+ * @cfg: Pointer to ring configuration.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ *    -EOPNOTSUPP: If timestamping is not supported by the backend or the
+ *    device.
+ *    -EBUSY: XDP backend only: if another ring on the interface uses a
+ *    different protocol, or if the device queue is still held by an AF_XDP
+ *    socket which was closed. The kernel releases the queue asynchronously,
+ *    so creating the ring again shortly after succeeds.
+ *    Other negative errno value: If the socket or the ring couldn't be set up
+ *    (e.g. -EPERM if the caller lacks CAP_NET_RAW).
+ */
+int avtp_net_rx_create(struct avtp_net_rx **rx,
+				const struct avtp_net_rx_config *cfg);
+
+/* Destroy RX ring created by avtp_net_rx_create(). Any PDU pointer returned
+ * by the ring is invalid after this call.
+ * @rx: Pointer to ring.
+ */
+void avtp_net_rx_destroy(struct avtp_net_rx *rx);
+
+/* Get the ring file descriptor. It can be polled for POLLIN to wait for
+ * received PDUs, but it must not be read from or closed.
+ * @rx: Pointer to ring.
+ *
+ * Returns:
+ *    File descriptor (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_rx_get_fd(const struct avtp_net_rx *rx);
+
+/* Join a multicast group so the ring receives PDUs sent to it. It can be
+ * called several times to receive multiple streams on the same ring.
+ * @rx: Pointer to ring.
+ * @macaddr: Stream destination MAC address.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    Other negative errno value: If membership couldn't be added.
+ */
+int avtp_net_rx_add_membership(struct avtp_net_rx *rx,
+						const uint8_t macaddr[6]);
+
+/* Retrieve received PDUs from the ring, without blocking. PDUs are returned
+ * in the order they were received, up to one ring block per call. Returned
+ * pointers point straight into the ring and remain valid until the next call
+ * to avtp_net_rx_recv() or avtp_net_rx_classify() on the same ring, when the
+ * block holding them may be given back to the kernel.
+ * @rx: Pointer to ring.
+ * @pdus: Array which pointers to received PDUs are saved.
+ * @lens: Array which the length, in bytes, of each received PDU is saved.
+ * @max: Number of elements in 'pdus' and 'lens'.
+ *
+ * Returns:
+ *    Number of PDUs retrieved (>= 0): Success. 0 means there are no PDUs
+ *    available at the moment.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_rx_recv(struct avtp_net_rx *rx,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], unsigned int max);
+
+/* Retrieve received PDUs from the ring, as avtp_net_rx_recv() does, along
+ * with their arrival times.
+ * @rx: Pointer to ring.
+ * @pdus: Array which pointers to received PDUs are saved.
+ * @lens: Array which the length, in bytes, of each received PDU is saved.
+ * @times: Array which the arrival time, in nanoseconds, of each received PDU
+ *         is saved, as taken by the configured timestamping. It is 0 if
+ *         received PDUs are not timestamped.
+ * @max: Number of elements in 'pdus', 'lens' and 'times'.
+ *
+ * Returns:
+ *    Number of PDUs retrieved (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_rx_recv_ts(struct avtp_net_rx *rx,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				unsigned int max);
+
+/* Retrieve received PDUs from the ring, as avtp_net_rx_recv() does, and
+ * classify them with avtp_classifier_classify().
+ * @rx: Pointer to ring.
+ * @cls: Pointer to classifier.
+ * @pdus: Array which pointers to received PDUs are saved.
+ * @lens: Array which the length, in bytes, of each received PDU is saved.
+ * @results: Array which the classification result of each PDU is saved.
+ * @max: Number of elements in 'pdus', 'lens' and 'results'.
+ *
+ * Returns:
+ *    Number of PDUs retrieved (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_rx_classify(struct avtp_net_rx *rx, struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[],
+				struct avtp_classifier_result results[],
+				unsigned int max);
+
+/* Retrieve received PDUs from the ring, as avtp_net_rx_recv_ts() does, and
+ * classify them with avtp_classifier_classify().
+ * @rx: Pointer to ring.
+ * @cls: Pointer to classifier.
+ * @pdus: Array which pointers to received PDUs are saved.
+ * @lens: Array which the length, in bytes, of each received PDU is saved.
+ * @times: Array which the arrival time, in nanoseconds, of each received PDU
+ *         is saved.
+ * @results: Array which the classification result of each PDU is saved.
+ * @max: Number of elements in 'pdus', 'lens', 'times' and 'results'.
+ *
+ * Returns:
+ *    Number of PDUs retrieved (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_rx_classify_ts(struct avtp_net_rx *rx,
+				struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				struct avtp_classifier_result results[],
+				unsigned int max);
+
+/* Multi-queue listener engine.
+ *
+ * The engine spreads reception of many streams over several worker threads.
+ * Each worker owns its own RX ring and classifier, and all rings join a
+ * single PACKET_FANOUT group whose classic BPF program hashes the PDU
+ * 'stream_id' field. The kernel therefore delivers every PDU from a given
+ * stream to the same worker, so classification and any per-stream state
+ * kept by the application (e.g. reassembly buffers) are never shared across
+ * workers and need no locking.
+ */
+struct avtp_net_engine;
+
+/* Maximum number of workers, as limited by PACKET_FANOUT groups. */
+#define AVTP_NET_ENGINE_MAX_WORKERS	256
+
+/* Maximum number of PDUs handed over to the callback at once. */
+#define AVTP_NET_ENGINE_BATCH		32
+
+/* Receive callback. It runs on the worker thread which received the PDUs,
+ * with the same arguments avtp_net_rx_classify() returns. PDUs are only
+ * valid until the callback returns.
+ * @worker: Index of the worker which received the PDUs.
+ * @pdus: Array with pointers to received PDUs.
+ * @lens: Array with length, in bytes, of each received PDU.
+ * @results: Array with the classification result of each PDU. Stream
+ *           handles are the ones returned by avtp_net_engine_add_stream().
+ * @count: Number of elements in 'pdus', 'lens' and 'results'.
+ * @arg: Argument passed in engine configuration.
+ */
+typedef void (*avtp_net_engine_fn)(unsigned int worker,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[],
+				const struct avtp_classifier_result results[],
+				unsigned int count, void *arg);
+
+struct avtp_net_engine_config {
+	/* Configuration of the RX ring owned by each worker. Only the
+	 * AF_PACKET backend supports fanout groups.
+	 */
+	struct avtp_net_rx_config rx;
+	/* Number of workers, from 1 to AVTP_NET_ENGINE_MAX_WORKERS. */
+	unsigned int workers;
+	/* CPU each worker thread is pinned to, with 'workers' elements. If
+	 * NULL, worker threads are not pinned.
+	 */
+	const int *cpus;
+	/* Maximum number of streams registered on each worker. */
+	unsigned int max_streams;
+	/* Receive callback and its argument. */
+	avtp_net_engine_fn fn;
+	void *arg;
+};
+
+/* Create a listener engine. Worker rings are created and join the fanout
+ * group right away, but worker threads only run once avtp_net_engine_start()
+ * is called.
+ * @engine: Pointer to variable which the new engine should be saved.
+ * @cfg: Pointer to engine configuration.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ *    Other negative errno value: If rings or the fanout group couldn't be
+ *    set up.
+ */
+int avtp_net_engine_create(struct avtp_net_engine **engine,
+				const struct avtp_net_engine_config *cfg);
+
+/* Destroy engine created by avtp_net_engine_create(). Worker threads are
+ * stopped first if they are running.
+ * @engine: Pointer to engine.
+ */
+void avtp_net_engine_destroy(struct avtp_net_engine *engine);
+
+/* Get the worker PDUs from a given stream are steered to.
+ * @engine: Pointer to engine.
+ * @stream_id: Stream ID.
+ *
+ * Returns:
+ *    Worker index (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_engine_get_worker(const struct avtp_net_engine *engine,
+							uint64_t stream_id);
+
+/* Register a stream on the classifier of the worker it is steered to, as
+ * avtp_classifier_add() does. Streams must be registered before worker
+ * threads are started.
+ * @engine: Pointer to engine.
+ * @expected: Pointer to PDU header the stream PDUs should match.
+ * @mask: Pointer to PDU header with the bits to be compared, or NULL.
+ *
+ * Returns:
+ *    Stream handle (>= 0): Success. Handles are only unique among streams
+ *    steered to the same worker.
+ *    -EINVAL: If any argument is invalid.
+ *    -EBUSY: If worker threads are running.
+ *    Other negative value: Same as avtp_classifier_add().
+ */
+int avtp_net_engine_add_stream(struct avtp_net_engine *engine,
+					const struct avtp_stream_pdu *expected,
+					const struct avtp_stream_pdu *mask);
+
+/* Join a multicast group so the engine receives PDUs sent to it.
+ * @engine: Pointer to engine.
+ * @macaddr: Stream destination MAC address.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    Other negative errno value: If membership couldn't be added.
+ */
+int avtp_net_engine_add_membership(struct avtp_net_engine *engine,
+						const uint8_t macaddr[6]);
+
+/* Start worker threads. From now on, the callback may be called at any time
+ * from any worker thread.
+ * @engine: Pointer to engine.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EBUSY: If worker threads are running already.
+ *    Other negative errno value: If threads couldn't be started.
+ */
+int avtp_net_engine_start(struct avtp_net_engine *engine);
+
+/* Stop worker threads and wait for them to finish. Once it returns, the
+ * callback is not called anymore. PDUs received meanwhile remain in the
+ * rings and are handed over if the engine is started again.
+ * @engine: Pointer to engine.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_engine_stop(struct avtp_net_engine *engine);
+
+/* Batched transmit queue.
+ *
+ * The TX queue collects PDUs, typically emitted from header templates
+ * straight into queue buffers, and transmits all of them at once with a
+ * single sendmmsg() call. If launch times are enabled, each PDU carries its
+ * own SCM_TXTIME launch time so the Earliest TxTime First (ETF) qdisc
+ * paces the transmission (see tc-etf(8)), instead of the application waking
+ * up for each PDU.
+ *
+ * If timestamping is enabled, the kernel reports when each PDU actually left
+ * through the socket error queue, and the queue matches reports with the
+ * launch time each PDU was queued with, so compliance with launch times (and
+ * thus with the stream max transit time) can be monitored.
+ */
+struct avtp_net_tx;
+
+/* Maximum number of reports read from the error queue at once. */
+#define AVTP_NET_TX_REPORT_BATCH	32
+
+/* Transmission report of a PDU. */
+struct avtp_net_tx_report {
+	/* Index of the PDU in transmission order, counting from 0 since the
+	 * queue was created. Wraps around at 2^32.
+	 */
+	uint32_t id;
+	/* Launch time the PDU was committed with. It is 0 if the PDU was
+	 * transmitted too long ago for it to be known anymore.
+	 */
+	uint64_t launch_time;
+	/* Transmission time, in nanoseconds, as taken by the configured
+	 * timestamping.
+	 */
+	uint64_t tx_time;
+};
+
+struct avtp_net_tx_config {
+	/* Network interface name. */
+	const char *ifname;
+	/* Protocol of transmitted frames (e.g. ETH_P_TSN). */
+	uint16_t protocol;
+	/* SO_PRIORITY of transmitted frames. If 0, priority is not set. */
+	int priority;
+	/* Whether PDUs carry launch times. Requires CAP_NET_ADMIN unless
+	 * 'clockid' is CLOCK_MONOTONIC.
+	 */
+	bool txtime;
+	/* Clock launch times refer to. The ETF qdisc requires CLOCK_TAI. */
+	clockid_t clockid;
+	/* Maximum number of queued PDUs. If 0, a default value is used. */
+	unsigned int queue_size;
+	/* Maximum size, in bytes, of a PDU. If 0, a default value is used. */
+	unsigned int max_pdu_size;
+	/* I/O backend. The XDP backend doesn't support launch times, nor
+	 * 'priority', and builds Ethernet headers itself so PDUs can be
+	 * VLAN tagged with 'vlan_tci' instead.
+	 */
+	enum avtp_net_backend backend;
+	/* XDP backend only: device queue the queue is bound to. */
+	unsigned int queue_id;
+	/* XDP backend only: whether frames carry a VLAN tag and its Tag
+	 * Control Information (PCP, DEI and VID).
+	 */
+	bool vlan;
+	uint16_t vlan_tci;
+	/* Timestamping of transmitted frames, reported by
+	 * avtp_net_tx_get_reports(). Not supported by the XDP backend.
+	 */
+	enum avtp_net_tstamp tstamp;
+};
+
+/* Create a TX queue.
+ * @tx: Pointer to variable which the new queue should be saved.
+ * @cfg: Pointer to queue configuration.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ *    -EOPNOTSUPP: If timestamping is not supported by the backend or the
+ *    device.
+ *    -EBUSY: XDP backend only: if the device queue is still held by an
+ *    AF_XDP socket which was closed. The kernel releases the queue
+ *    asynchronously, so creating the queue again shortly after succeeds.
+ *    Other negative errno value: If the socket couldn't be set up.
+ */
+int avtp_net_tx_create(struct avtp_net_tx **tx,
+				const struct avtp_net_tx_config *cfg);
+
+/* Destroy TX queue created by avtp_net_tx_create(). PDUs still queued are
+ * discarded.
+ * @tx: Pointer to queue.
+ */
+void avtp_net_tx_destroy(struct avtp_net_tx *tx);
+
+/* Get the queue socket file descriptor. It must not be closed.
+ * @tx: Pointer to queue.
+ *
+ * Returns:
+ *    File descriptor (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_tx_get_fd(const struct avtp_net_tx *tx);
+
+/* Reserve a buffer for the next PDU to be queued. The PDU is built directly
+ * in the buffer (e.g. with avtp_stream_pdu_emit()) and then queued by
+ * avtp_net_tx_commit(). Calling this function again before committing
+ * returns the same buffer.
+ * @tx: Pointer to queue.
+ * @buf: Pointer to variable which the buffer address is saved. The buffer is
+ *       'max_pdu_size' bytes long.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOSPC: If the queue is full.
+ */
+int avtp_net_tx_reserve(struct avtp_net_tx *tx, void **buf);
+
+/* Queue the PDU built in the buffer returned by avtp_net_tx_reserve().
+ * @tx: Pointer to queue.
+ * @macaddr: Stream destination MAC address.
+ * @len: PDU length in bytes.
+ * @launch_time: Launch time, in nanoseconds, on the configured clock.
+ *               Ignored if launch times are disabled.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or no buffer is reserved.
+ */
+int avtp_net_tx_commit(struct avtp_net_tx *tx, const uint8_t macaddr[6],
+					size_t len, uint64_t launch_time);
+
+/* Copy a PDU into the queue. Equivalent to avtp_net_tx_reserve(), copying
+ * 'pdu' into the buffer, and avtp_net_tx_commit().
+ * @tx: Pointer to queue.
+ * @macaddr: Stream destination MAC address.
+ * @pdu: Pointer to PDU.
+ * @len: PDU length in bytes.
+ * @launch_time: Launch time, in nanoseconds, on the configured clock.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOSPC: If the queue is full.
+ */
+int avtp_net_tx_queue(struct avtp_net_tx *tx, const uint8_t macaddr[6],
+				const void *pdu, size_t len,
+				uint64_t launch_time);
+
+/* Transmit queued PDUs, in the order they were queued. If the kernel stops
+ * accepting PDUs, those not transmitted remain queued and are transmitted on
+ * the next call.
+ * @tx: Pointer to queue.
+ *
+ * Returns:
+ *    Number of PDUs transmitted (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ *    Other negative errno value: If no PDU could be transmitted.
+ */
+int avtp_net_tx_flush(struct avtp_net_tx *tx);
+
+/* Get the number of queued PDUs not transmitted yet.
+ * @tx: Pointer to queue.
+ *
+ * Returns:
+ *    Number of queued PDUs (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_tx_get_pending(const struct avtp_net_tx *tx);
+
+/* Retrieve transmission reports of PDUs from the socket error queue, without
+ * blocking. Reports are read in batches, with a single system call for up to
+ * AVTP_NET_TX_REPORT_BATCH of them. The socket file descriptor polls for
+ * POLLERR while reports are available.
+ * @tx: Pointer to queue.
+ * @reports: Array which the reports are saved.
+ * @max: Number of elements in 'reports'.
+ *
+ * Returns:
+ *    Number of reports retrieved (>= 0): Success. 0 means there are no
+ *    reports available at the moment.
+ *    -EINVAL: If any argument is invalid.
+ *    -EOPNOTSUPP: If timestamping is disabled.
+ *    Other negative errno value: If the error queue couldn't be read.
+ */
+int avtp_net_tx_get_reports(struct avtp_net_tx *tx,
+				struct avtp_net_tx_report reports[],
+				unsigned int max);
+
+/* Transmit scheduler.
+ *
+ * The scheduler multiplexes PDUs from many streams, of any format, into a
+ * single TX queue, so one thread paces all talker streams from an interface
+ * instead of each stream running its own thread and timer. Each stream
+ * builds its PDUs from a fill callback, typically emitting them from a
+ * stream context (see avtp_stream_ctx.h), and tells when its next PDU is
+ * due. The scheduler calls the callbacks in launch time order, across all
+ * streams, committing PDUs to the queue with those launch times and
+ * flushing the queue as it fills up.
+ *
+ * Each stream declares the bandwidth it reserves for its SR class as does
+ * an SRP talker, i.e. with the maximum size of its frames and the maximum
+ * number of frames it transmits per class measurement interval (125 us for
+ * class A, 250 us for class B). The scheduler sums reservations per class,
+ * so the idleslope of the credit based shaper of each class (see
+ * tc-cbs(8)) can be set from them, and accounts for each stream the class
+ * measurement intervals in which it transmitted more than it reserved,
+ * which the shaper would delay and push other streams of the same class
+ * past their max transit time.
+ */
+struct avtp_net_mux;
+
+/* Stream Reservation classes. */
+enum avtp_net_mux_class {
+	AVTP_NET_MUX_CLASS_A,
+	AVTP_NET_MUX_CLASS_B,
+	AVTP_NET_MUX_CLASS_MAX,
+};
+
+/* Per frame overhead, in bytes, on top of the PDU length, accounted for
+ * bandwidth reservations: preamble and start frame delimiter (8), Ethernet
+ * header (14), VLAN tag (4), frame check sequence (4) and interframe gap
+ * (12).
+ */
+#define AVTP_NET_MUX_FRAME_OVERHEAD	42
+
+/* Fill callback. It builds the next PDU of a stream in 'buf', which is
+ * transmitted at '*launch_time', and saves in '*launch_time' when the PDU
+ * after it is due. If the stream has no PDU to transmit at '*launch_time',
+ * it returns 0 and saves a later time in '*launch_time', when it is called
+ * again.
+ * @buf: Buffer the PDU is built in, as returned by avtp_net_tx_reserve().
+ * @size: Size of 'buf' in bytes, i.e. 'max_pdu_size' from the TX queue.
+ * @launch_time: Pointer to launch time of the PDU, in nanoseconds on the TX
+ *               queue clock.
+ * @arg: Argument passed to avtp_net_mux_add_stream().
+ *
+ * Returns:
+ *    PDU length in bytes (> 0): PDU built in 'buf'.
+ *    0: No PDU is due at '*launch_time'.
+ *    Negative errno value: Scheduling stops and avtp_net_mux_run() returns
+ *    it.
+ */
+typedef int (*avtp_net_mux_fill_fn)(void *buf, size_t size,
+					uint64_t *launch_time, void *arg);
+
+struct avtp_net_mux_stream_config {
+	/* Stream destination MAC address. */
+	uint8_t macaddr[6];
+	/* SR class the stream belongs to. */
+	enum avtp_net_mux_class sr_class;
+	/* Maximum PDU length, in bytes, and maximum number of PDUs per class
+	 * measurement interval. Together they make the stream reservation.
+	 */
+	unsigned int max_frame_size;
+	unsigned int max_interval_frames;
+	/* Launch time of the first PDU. */
+	uint64_t start_time;
+	avtp_net_mux_fill_fn fill;
+	void *arg;
+};
+
+struct avtp_net_mux_stats {
+	/* PDUs and bytes, PDU lengths only, transmitted by the stream. */
+	uint64_t pdus;
+	uint64_t bytes;
+	/* Class measurement intervals in which the stream exceeded its
+	 * reservation.
+	 */
+	uint64_t overruns;
+};
+
+/* Create a transmit scheduler.
+ * @mux: Pointer to variable which the new scheduler should be saved.
+ * @tx: TX queue PDUs are committed to. It must not be used by anyone else
+ *      while the scheduler is, and must outlive it.
+ * @max_streams: Maximum number of streams which can be added.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_net_mux_create(struct avtp_net_mux **mux, struct avtp_net_tx *tx,
+						unsigned int max_streams);
+
+/* Destroy scheduler created by avtp_net_mux_create(). The TX queue is not
+ * destroyed.
+ * @mux: Pointer to scheduler.
+ */
+void avtp_net_mux_destroy(struct avtp_net_mux *mux);
+
+/* Add a stream.
+ * @mux: Pointer to scheduler.
+ * @cfg: Pointer to stream configuration.
+ *
+ * Returns:
+ *    Stream handle (>= 0): Success.
+ *    -EINVAL: If any argument is invalid (e.g. 'max_frame_size' is larger
+ *             than 'max_pdu_size' from the TX queue).
+ *    -ENOSPC: If 'max_streams' streams are added already.
+ */
+int avtp_net_mux_add_stream(struct avtp_net_mux *mux,
+				const struct avtp_net_mux_stream_config *cfg);
+
+/* Build and queue all PDUs due up to 'until', from all streams, in launch
+ * time order, and transmit them. PDUs with the same launch time are queued
+ * class A first, then in the order their streams were added. If the kernel
+ * stops accepting PDUs and the queue fills up, scheduling stops, and PDUs
+ * not built yet are built on the next call.
+ * @mux: Pointer to scheduler.
+ * @until: Time, in nanoseconds on the TX queue clock, up to which PDUs are
+ *         built. If launch times are disabled, this is typically the
+ *         current time. Otherwise, it is some time ahead of it, so PDUs are
+ *         handed to the ETF qdisc in advance.
+ *
+ * Returns:
+ *    Number of PDUs queued (>= 0): Success.
+ *    -EINVAL: If any argument is invalid or a fill callback didn't move
+ *             its launch time forward.
+ *    Other negative errno value: Returned by a fill callback or by
+ *    avtp_net_tx_flush(), except for -EAGAIN and -ENOBUFS, which leave
+ *    PDUs queued until the next call.
+ */
+int avtp_net_mux_run(struct avtp_net_mux *mux, uint64_t until);
+
+/* Get the launch time of the next PDU due, from any stream, so the caller
+ * can sleep until shortly before then.
+ * @mux: Pointer to scheduler.
+ * @deadline: Pointer to variable which the launch time is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOENT: If no stream was added.
+ */
+int avtp_net_mux_get_deadline(const struct avtp_net_mux *mux,
+							uint64_t *deadline);
+
+/* Get the bandwidth reserved by all streams of a SR class, i.e. the
+ * idleslope the credit based shaper of the class should be set up with.
+ * @mux: Pointer to scheduler.
+ * @sr_class: SR class.
+ * @bps: Pointer to variable which the bandwidth, in bits per second, is
+ *       saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_mux_get_idleslope(const struct avtp_net_mux *mux,
+				enum avtp_net_mux_class sr_class,
+				uint64_t *bps);
+
+/* Get statistics of a stream.
+ * @mux: Pointer to scheduler.
+ * @stream: Stream handle returned by avtp_net_mux_add_stream().
+ * @stats: Pointer to struct which the statistics are saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_mux_get_stats(const struct avtp_net_mux *mux, int stream,
+					struct avtp_net_mux_stats *stats);
+
+/* Packet capture.
+ *
+ * A capture records PDUs into a pcapng file, each one with its arrival time
+ * and behind an Ethernet header built from the capture configuration, so
+ * captures can be inspected with regular tools (e.g. Wireshark) and played
+ * back by a replay. PDUs are copied into a preallocated buffer, split into
+ * segments, and a writer thread writes full segments to the file, so
+ * recording never blocks on file I/O. If the writer falls behind and no
+ * segment is free, PDUs are dropped and accounted for instead.
+ */
+struct avtp_net_capture;
+
+struct avtp_net_capture_config {
+	/* Path of the pcapng file. It is created, or truncated if it exists
+	 * already.
+	 */
+	const char *path;
+	/* Size, in bytes, of the write-behind buffer. If 0, a default value
+	 * is used.
+	 */
+	size_t buffer_size;
+	/* Maximum number of bytes recorded from each frame, including its
+	 * Ethernet header. If 0, frames are recorded in full.
+	 */
+	unsigned int snaplen;
+	/* Ethernet header of recorded frames: destination and source MAC
+	 * addresses, and protocol. If 'protocol' is 0, ETH_P_TSN is used.
+	 */
+	uint8_t dst_addr[6];
+	uint8_t src_addr[6];
+	uint16_t protocol;
+};
+
+struct avtp_net_capture_stats {
+	/* Number of PDUs recorded. */
+	uint64_t pdus;
+	/* Number of PDUs dropped because the buffer was full. */
+	uint64_t dropped;
+};
+
+/* Create a capture. The writer thread is started right away.
+ * @cap: Pointer to variable which the new capture should be saved.
+ * @cfg: Pointer to capture configuration.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid (e.g. 'buffer_size' is too small
+ *    to hold a frame of 'snaplen' bytes).
+ *    -ENOMEM: If memory couldn't be allocated.
+ *    Other negative errno value: If the file couldn't be created or the
+ *    writer thread couldn't be started.
+ */
+int avtp_net_capture_create(struct avtp_net_capture **cap,
+				const struct avtp_net_capture_config *cfg);
+
+/* Destroy capture created by avtp_net_capture_create(). PDUs still in the
+ * buffer are written to the file before it is closed.
+ * @cap: Pointer to capture.
+ */
+void avtp_net_capture_destroy(struct avtp_net_capture *cap);
+
+/* Record PDUs, e.g. as returned by avtp_net_rx_recv(). PDUs are copied, so
+ * they may be released as soon as this function returns.
+ * @cap: Pointer to capture.
+ * @pdus: Array with pointers to PDUs.
+ * @lens: Array with length, in bytes, of each PDU.
+ * @times: Array with arrival time, in nanoseconds, of each PDU.
+ * @count: Number of elements in 'pdus', 'lens' and 'times'.
+ *
+ * Returns:
+ *    Number of PDUs recorded (>= 0): Success. PDUs not recorded have been
+ *    dropped because the buffer was full.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_capture_write(struct avtp_net_capture *cap,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[], const uint64_t times[],
+				unsigned int count);
+
+/* Hand the PDUs recorded so far over to the writer thread and wait until
+ * they have been written to the file.
+ * @cap: Pointer to capture.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    Other negative errno value: If the writer thread failed to write to
+ *    the file, at this or any previous point.
+ */
+int avtp_net_capture_flush(struct avtp_net_capture *cap);
+
+/* Get capture statistics. It must be called from the thread recording PDUs.
+ * @cap: Pointer to capture.
+ * @stats: Pointer to variable which statistics are saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_capture_get_stats(const struct avtp_net_capture *cap,
+				struct avtp_net_capture_stats *stats);
+
+/* Capture replay.
+ *
+ * A replay plays a pcapng file back, e.g. one recorded by a capture, through
+ * the same interface RX rings provide, so the listener pipeline can be run
+ * and benchmarked offline. The file is mmap'ed and read into memory up front
+ * and PDUs are accessed directly in the mapping, without any copy. Frames
+ * from interfaces other than Ethernet and frames of other protocols are
+ * skipped. PDUs are either paced as they were captured, optionally sped up,
+ * or delivered as fast as they are retrieved.
+ */
+struct avtp_net_replay;
+
+struct avtp_net_replay_config {
+	/* Path of the pcapng file. */
+	const char *path;
+	/* Protocol of replayed frames, untagged or with a single VLAN tag.
+	 * If 0, ETH_P_TSN is used.
+	 */
+	uint16_t protocol;
+	/* Pace of the replay relative to the original inter-arrival times
+	 * (e.g. 1.0 for real time, 10.0 for ten times faster). If 0, PDUs
+	 * are delivered right away.
+	 */
+	double speed;
+	/* Whether the replay starts over once the end of the file is
+	 * reached.
+	 */
+	bool loop;
+};
+
+/* Create a replay.
+ * @rp: Pointer to variable which the new replay should be saved.
+ * @cfg: Pointer to replay configuration.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EBADMSG: If the file is not a pcapng file.
+ *    -ENOMEM: If memory couldn't be allocated.
+ *    Other negative errno value: If the file couldn't be mapped.
+ */
+int avtp_net_replay_create(struct avtp_net_replay **rp,
+				const struct avtp_net_replay_config *cfg);
+
+/* Destroy replay created by avtp_net_replay_create(). Any PDU pointer
+ * returned by the replay is invalid after this call.
+ * @rp: Pointer to replay.
+ */
+void avtp_net_replay_destroy(struct avtp_net_replay *rp);
+
+/* Retrieve PDUs from the replay, without blocking, as avtp_net_rx_recv()
+ * does. Paced replays only return PDUs which are due, and pacing starts with
+ * the first call to this function or to avtp_net_replay_get_deadline().
+ * Returned pointers point straight into the mapping and remain valid until
+ * the replay is destroyed.
+ * @rp: Pointer to replay.
+ * @pdus: Array which pointers to PDUs are saved.
+ * @lens: Array which the length, in bytes, of each PDU is saved.
+ * @times: Array which the capture time, in nanoseconds, of each PDU is
+ *         saved, or NULL.
+ * @max: Number of elements in 'pdus', 'lens' and 'times'.
+ *
+ * Returns:
+ *    Number of PDUs retrieved (>= 0): Success. 0 means no PDU is due yet.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENODATA: If the end of the file has been reached, and the replay
+ *    doesn't loop or the file holds no PDU at all.
+ *    -EBADMSG: If the file is corrupted.
+ */
+int avtp_net_replay_recv(struct avtp_net_replay *rp,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				unsigned int max);
+
+/* Retrieve PDUs from the replay, as avtp_net_replay_recv() does, and
+ * classify them with avtp_classifier_classify().
+ * @rp: Pointer to replay.
+ * @cls: Pointer to classifier.
+ * @pdus: Array which pointers to PDUs are saved.
+ * @lens: Array which the length, in bytes, of each PDU is saved.
+ * @times: Array which the capture time, in nanoseconds, of each PDU is
+ *         saved, or NULL.
+ * @results: Array which the classification result of each PDU is saved.
+ * @max: Number of elements in 'pdus', 'lens', 'times' and 'results'.
+ *
+ * Returns:
+ *    Number of PDUs retrieved (>= 0): Success.
+ *    Negative value: Same as avtp_net_replay_recv().
+ */
+int avtp_net_replay_classify(struct avtp_net_replay *rp,
+				struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				struct avtp_classifier_result results[],
+				unsigned int max);
+
+/* Get the time the next PDU is due, so the caller can sleep until then
+ * (e.g. with clock_nanosleep()) instead of polling the replay.
+ * @rp: Pointer to replay.
+ * @deadline: Pointer to variable which the time, in nanoseconds on
+ *            CLOCK_MONOTONIC, is saved. It is 0 if the next PDU is due
+ *            right away.
+ *
+ * Returns:
+ *    0: Success.
+ *    Negative value: Same as avtp_net_replay_recv().
+ */
+int avtp_net_replay_get_deadline(struct avtp_net_replay *rp,
+							uint64_t *deadline);
+
+/* Restart the replay from the beginning of the file. Pacing starts over
+ * with the next call to avtp_net_replay_recv().
+ * @rp: Pointer to replay.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_net_replay_rewind(struct avtp_net_replay *rp);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_ieciidc.h"
+#include "avtp_rvf.h"
+#include "avtp_tscf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PDU view.
+ *
+ * A view wraps a buffer holding a PDU received from an untrusted source
+ * (e.g. the network or a capture file). avtp_pdu_view_init() checks once
+ * that the buffer holds the whole PDU: its header, format specific headers
+ * living in the AVTPDU payload (H.264 header, RVF RAW header, CIP header)
+ * and as many bytes as announced by its data length field. From then on,
+ * the PDU struct returned by the view can be read with the unchecked inline
+ * accessors from avtp_inline.h, and the format data returned by
+ * avtp_pdu_view_data() can be read up to its length, with no further checks.
+ *
+ * Header fields shared by all PDUs of a format are decoded only when first
+ * requested by avtp_pdu_view_cvf_hdr(), avtp_pdu_view_rvf_hdr() or
+ * avtp_pdu_view_ieciidc_hdr(), and kept in the view, so a PDU dropped after
+ * reading a couple of fields doesn't pay for the rest.
+ *
+ * Supported subtypes are the Stream AVTPDU formats (AAF, CVF, RVF, IEC
+ * 61883/IIDC, TSCF), CRF and NTSCF. A view doesn't copy the buffer, which
+ * must outlive it. Fields from struct avtp_pdu_view are private and must
+ * only be accessed through the functions below, except 'buf' and 'len'
+ * which may be read directly.
+ */
+struct avtp_pdu_view {
+	const uint8_t *buf;
+	size_t len;
+
+	uint16_t data_off;
+	uint16_t data_len;
+	uint8_t subtype;
+	uint8_t decoded;
+	union {
+		struct avtp_cvf_hdr cvf;
+		struct avtp_rvf_hdr rvf;
+		struct avtp_ieciidc_hdr ieciidc;
+	} hdr;
+};
+
+/* Initialize view from a received PDU.
+ * @view: Pointer to view.
+ * @buf: Pointer to buffer holding the PDU.
+ * @len: Number of bytes received in 'buf'.
+ * @subtype: AVTP subtype the PDU is expected to have (e.g.
+ *           AVTP_SUBTYPE_AAF).
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid, 'subtype' isn't supported, the
+ *             PDU has some other subtype or 'len' is too short for the PDU.
+ */
+int avtp_pdu_view_init(struct avtp_pdu_view *view, const void *buf,
+						size_t len, uint8_t subtype);
+
+/* Get the PDU of a view from a Stream AVTPDU format. */
+static inline const struct avtp_stream_pdu *avtp_pdu_view_stream(
+					const struct avtp_pdu_view *view)
+{
+	return (const struct avtp_stream_pdu *) view->buf;
+}
+
+/* Get the PDU of a view initialized with AVTP_SUBTYPE_CRF. */
+static inline const struct avtp_crf_pdu *avtp_pdu_view_crf(
+					const struct avtp_pdu_view *view)
+{
+	return (const struct avtp_crf_pdu *) view->buf;
+}
+
+/* Get the PDU of a view initialized with AVTP_SUBTYPE_NTSCF. */
+static inline const struct avtp_ntscf_pdu *avtp_pdu_view_ntscf(
+					const struct avtp_pdu_view *view)
+{
+	return (const struct avtp_ntscf_pdu *) view->buf;
+}
+
+/* Get the format data carried by the PDU of a view, past any format specific
+ * header (e.g. H.264 NAL unit data, RVF raw data, CIP data payload, AAF
+ * samples, CRF timestamps or ACF messages).
+ * @view: Pointer to view.
+ * @len: Pointer to variable which the data length, in bytes, is saved.
+ *
+ * Returns:
+ *    Pointer to the data.
+ */
+static inline const uint8_t *avtp_pdu_view_data(
+				const struct avtp_pdu_view *view, size_t *len)
+{
+	*len = view->data_len;
+
+	return view->buf + view->data_off;
+}
+
+/* Get all CVF AVTPDU header fields from a view, decoding them on first call.
+ * @view: Pointer to view initialized with AVTP_SUBTYPE_CVF.
+ *
+ * Returns:
+ *    Pointer to the fields, valid as long as the view is, or NULL if the
+ *    view holds some other subtype.
+ */
+const struct avtp_cvf_hdr *avtp_pdu_view_cvf_hdr(struct avtp_pdu_view *view);
+
+/* Same as avtp_pdu_view_cvf_hdr() but for RVF AVTPDUs, RAW header included.
+ * @view: Pointer to view initialized with AVTP_SUBTYPE_RVF.
+ */
+const struct avtp_rvf_hdr *avtp_pdu_view_rvf_hdr(struct avtp_pdu_view *view);
+
+/* Same as avtp_pdu_view_cvf_hdr() but for IEC 61883/IIDC AVTPDUs, CIP header
+ * included.
+ * @view: Pointer to view initialized with AVTP_SUBTYPE_61883_IIDC.
+ */
+const struct avtp_ieciidc_hdr *avtp_pdu_view_ieciidc_hdr(
+						struct avtp_pdu_view *view);
+
+#ifdef __cplusplus
+}
+#endif
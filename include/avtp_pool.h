@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PDU buffer pool.
+ *
+ * The pool is a fixed size slab of cache line aligned PDU buffers which are
+ * handed from one producer thread to one consumer thread through a lock-free
+ * single-producer/single-consumer ring. The producer allocates a buffer,
+ * builds a PDU in it (e.g. with some format pack function) and submits it.
+ * The consumer receives submitted PDUs, in submission order, and releases
+ * each buffer back to the pool once it is done with it (e.g. after
+ * transmitting it). No memory is allocated and no lock is taken after the
+ * pool is created.
+ *
+ * Only one thread may act as producer, calling avtp_pool_alloc() and
+ * avtp_pool_submit(), and only one thread may act as consumer, calling
+ * avtp_pool_receive(), avtp_pool_receive_burst() and avtp_pool_release(). The
+ * producer may release a buffer it allocated but doesn't want to submit by
+ * submitting it with length 0, which the consumer should simply release.
+ */
+struct avtp_pool;
+
+/* Create a pool.
+ * @pool: Pointer to variable which the new pool should be saved.
+ * @count: Number of PDU buffers.
+ * @pdu_size: Size, in bytes, of each PDU buffer.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_pool_create(struct avtp_pool **pool, unsigned int count,
+							size_t pdu_size);
+
+/* Destroy pool created by avtp_pool_create(). Neither the producer nor the
+ * consumer may be using the pool anymore.
+ * @pool: Pointer to pool.
+ */
+void avtp_pool_destroy(struct avtp_pool *pool);
+
+/* Allocate a PDU buffer. Producer side only.
+ * @pool: Pointer to pool.
+ * @pdu: Pointer to variable which the buffer address is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOBUFS: If all buffers are in use.
+ */
+int avtp_pool_alloc(struct avtp_pool *pool, void **pdu);
+
+/* Hand a PDU buffer over to the consumer. Producer side only.
+ * @pool: Pointer to pool.
+ * @pdu: Buffer returned by avtp_pool_alloc().
+ * @len: Length, in bytes, of the PDU in the buffer.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_pool_submit(struct avtp_pool *pool, void *pdu, size_t len);
+
+/* Receive the oldest submitted PDU. Consumer side only.
+ * @pool: Pointer to pool.
+ * @pdu: Pointer to variable which the buffer address is saved.
+ * @len: Pointer to variable which the PDU length is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -EAGAIN: If there is no submitted PDU.
+ */
+int avtp_pool_receive(struct avtp_pool *pool, void **pdu, size_t *len);
+
+/* Receive up to 'max' submitted PDUs at once, oldest first. Consumer side
+ * only.
+ * @pool: Pointer to pool.
+ * @pdus: Array which the buffer addresses are saved.
+ * @lens: Array which the PDU lengths are saved.
+ * @max: Number of elements in 'pdus' and 'lens'.
+ *
+ * Returns:
+ *    Number of PDUs received (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_pool_receive_burst(struct avtp_pool *pool, void *pdus[],
+					size_t lens[], unsigned int max);
+
+/* Give a PDU buffer back to the pool. Consumer side only.
+ * @pool: Pointer to pool.
+ * @pdu: Buffer returned by avtp_pool_receive() or avtp_pool_receive_burst().
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_pool_release(struct avtp_pool *pool, void *pdu);
+
+#ifdef __cplusplus
+}
+#endif
@@ -30,7 +30,11 @@
 #pragma once
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <sys/uio.h>
+
+#include "avtp.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -125,6 +129,37 @@ struct avtp_rvf_payload {
 	uint8_t raw_data[0];
 } __attribute__((__packed__));
 
+/* Length of RVF AVTPDU headers, RAW header included. */
+#define AVTP_RVF_RAW_HDR_LEN	(sizeof(struct avtp_stream_pdu) + \
+				 sizeof(struct avtp_rvf_payload))
+
+/* Maximum number of lines carried by a single RVF AVTPDU, bounded by the
+ * width of the 'num_lines' field.
+ */
+#define AVTP_RVF_RAW_MAX_LINES	15
+
+/* Host order representation of all RVF AVTPDU header fields, including the
+ * RAW header fields which live in the AVTPDU payload.
+ */
+struct avtp_rvf_hdr {
+	struct avtp_stream_hdr stream;
+	uint16_t active_pixels;
+	uint16_t total_lines;
+	uint16_t raw_line_number;
+	uint8_t ap;
+	uint8_t f;
+	uint8_t ef;
+	uint8_t evt;
+	uint8_t pd;
+	uint8_t i;
+	uint8_t raw_pixel_depth;
+	uint8_t raw_pixel_format;
+	uint8_t raw_frame_rate;
+	uint8_t raw_colorspace;
+	uint8_t raw_num_lines;
+	uint8_t raw_i_seq_num;
+};
+
 /* Get value of RVF AVTPDU field.
  * @pdu: Pointer to PDU struct.
  * @field: PDU field to be retrieved.
@@ -160,6 +195,201 @@ int avtp_rvf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_rvf_field field,
  */
 int avtp_rvf_pdu_init(struct avtp_stream_pdu *pdu);
 
+/* Retrieve all RVF AVTPDU header fields at once. This is cheaper than calling
+ * avtp_rvf_pdu_get() for each field since every PDU word is converted to host
+ * order only once.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_rvf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+			struct avtp_rvf_hdr *hdr);
+
+/* Set all RVF AVTPDU header fields at once from host order struct. This is
+ * cheaper than calling avtp_rvf_pdu_set() for each field since every PDU word
+ * is written only once. The 'subtype' field is set to AVTP_SUBTYPE_RVF and
+ * 'version' is set to 0. The RAW header is written to the AVTPDU payload as
+ * well.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_rvf_pdu_pack(struct avtp_stream_pdu *pdu,
+		      const struct avtp_rvf_hdr *hdr);
+
+/* RAW video packetizer. Splits video frames into RVF PDUs carrying whole
+ * lines each. Fields are private, use the avtp_rvf_raw_packetizer_*()
+ * functions to handle them.
+ */
+struct avtp_rvf_raw_packetizer {
+	uint8_t tmpl[AVTP_RVF_RAW_HDR_LEN];
+	size_t line_len;
+	uint16_t field_lines;
+	uint8_t lines_per_pdu;
+	uint8_t interlaced;
+	uint8_t seq_num;
+	uint8_t i_seq_num;
+	uint32_t avtp_time;
+	const uint8_t *frame;
+	size_t stride;
+	uint16_t line;
+	uint8_t field;
+};
+
+/* PDU emitted by the RAW video packetizer. Only the headers are written to
+ * 'hdr', lines are referenced from the frame buffer so they are never copied.
+ * 'iov' is ready to be handed to sendmsg(): iov[0] points to 'hdr' and the
+ * following 'iovcnt' - 1 entries to the lines. Lines which are contiguous in
+ * the frame buffer share a single entry.
+ */
+struct avtp_rvf_raw_packet {
+	uint8_t hdr[AVTP_RVF_RAW_HDR_LEN];
+	struct iovec iov[1 + AVTP_RVF_RAW_MAX_LINES];
+	size_t iovcnt;
+};
+
+/* Initialize RAW video packetizer. Frame geometry is taken from the template:
+ * 'active_pixels' is the frame width, 'total_lines' the frame height and
+ * 'raw_pixel_format' and 'raw_pixel_depth' set the length of a line. If 'I'
+ * is set frames are interlaced: each frame is sent as two fields, the first
+ * one made of the even lines of the frame buffer and the second one of the
+ * odd lines.
+ * @pkt: Pointer to packetizer.
+ * @tmpl: Pointer to RVF PDU template, including the RAW header, previously
+ *        built by avtp_rvf_pdu_pack(). 'sequence_num', 'avtp_timestamp',
+ *        'stream_data_length', 'F', 'EF', 'num_lines', 'i_seq_num' and
+ *        'line_number' are set by the packetizer on each PDU.
+ * @max_pdu_size: Maximum size of emitted PDUs, headers included. At least one
+ *                line must fit.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or the pixel format, pixel depth or
+ *             frame geometry from 'tmpl' is not supported.
+ */
+int avtp_rvf_raw_packetizer_init(struct avtp_rvf_raw_packetizer *pkt,
+				 const struct avtp_stream_pdu *tmpl,
+				 size_t max_pdu_size);
+
+/* Start packetizing a video frame. The frame buffer must not be changed until
+ * all PDUs emitted from it are sent.
+ * @pkt: Pointer to packetizer.
+ * @frame: Pointer to the first line of the frame buffer.
+ * @stride: Distance, in bytes, between the start of two consecutive lines in
+ *          the frame buffer. It must be at least the length of a line.
+ * @avtp_time: Value of 'avtp_timestamp' field of all PDUs from frame.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_rvf_raw_packetizer_start(struct avtp_rvf_raw_packetizer *pkt,
+				  const void *frame, size_t stride,
+				  uint32_t avtp_time);
+
+/* Emit next PDU from current frame. Lines are numbered from 1 within each
+ * field (within the frame if progressive). 'F' is set on PDUs from the second
+ * field and 'EF' on the last PDU of the frame. Sequence numbers are kept by
+ * the packetizer and incremented on each PDU, 'i_seq_num' is incremented on
+ * each frame.
+ * @pkt: Pointer to packetizer.
+ * @packet: Pointer to packet where the PDU is emitted.
+ *
+ * Returns:
+ *    1: PDU emitted.
+ *    0: No PDUs left in frame.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_rvf_raw_packetizer_next(struct avtp_rvf_raw_packetizer *pkt,
+				 struct avtp_rvf_raw_packet *packet);
+
+/* RAW video depacketizer. Writes lines from RVF PDUs straight into a frame
+ * buffer provided by the application. Fields are private, use the
+ * avtp_rvf_raw_depacketizer_*() functions to handle them.
+ */
+struct avtp_rvf_raw_depacketizer {
+	uint8_t *frame;
+	size_t stride;
+	size_t size;
+	uint32_t lines;
+	uint8_t i_seq_num;
+	uint8_t next_seq;
+	uint8_t seq_valid;
+	uint32_t lost_pdus;
+	uint32_t dropped_frames;
+};
+
+/* Video frame completed by the RAW video depacketizer. */
+struct avtp_rvf_raw_frame {
+	/* 'avtp_timestamp' and 'i_seq_num' fields from the last PDU of the
+	 * frame.
+	 */
+	uint32_t avtp_time;
+	uint8_t i_seq_num;
+	/* Lines written to the frame buffer. Lines carried by lost PDUs are
+	 * left untouched so this is less than 'total_lines' if any was lost.
+	 */
+	uint32_t lines;
+	/* PDUs lost and frames dropped since the previous frame returned. */
+	uint32_t lost_pdus;
+	uint32_t dropped_frames;
+};
+
+/* Initialize RAW video depacketizer. A frame buffer must be set with
+ * avtp_rvf_raw_depacketizer_set_frame() before PDUs are pushed.
+ * @depkt: Pointer to depacketizer.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_rvf_raw_depacketizer_init(struct avtp_rvf_raw_depacketizer *depkt);
+
+/* Set the frame buffer where lines from the next PDUs are written. It is
+ * usually called once a frame is completed to swap buffers, but it can be
+ * called at any time. Interlaced fields are woven in the frame buffer: lines
+ * from the first field go to even lines and lines from the second one to odd
+ * lines.
+ * @depkt: Pointer to depacketizer.
+ * @frame: Pointer to the first line of the frame buffer.
+ * @stride: Distance, in bytes, between the start of two consecutive lines in
+ *          the frame buffer.
+ * @size: Size of frame buffer, in bytes.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_rvf_raw_depacketizer_set_frame(struct avtp_rvf_raw_depacketizer *depkt,
+					void *frame, size_t stride,
+					size_t size);
+
+/* Push a received RVF PDU into the depacketizer, writing its lines to the
+ * frame buffer. A frame is completed by the PDU with 'EF' set. If a PDU from
+ * a new frame arrives before that, the frame being gathered is dropped.
+ * @depkt: Pointer to depacketizer.
+ * @pdu: Pointer to PDU struct.
+ * @len: Length of PDU, in bytes.
+ * @frame: Pointer to struct where the completed frame is saved.
+ *
+ * Returns:
+ *    1: PDU completed a frame, saved to 'frame'.
+ *    0: More PDUs are needed to complete a frame.
+ *    -EINVAL: If any argument is invalid, no frame buffer is set, 'pdu' is
+ *             not a valid RVF PDU or its lines don't fit in the frame
+ *             buffer.
+ */
+int avtp_rvf_raw_depacketizer_push(struct avtp_rvf_raw_depacketizer *depkt,
+				   const struct avtp_stream_pdu *pdu,
+				   size_t len,
+				   struct avtp_rvf_raw_frame *frame);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of payloads handed to the dispatch callback at once. */
+#define AVTP_SCHED_BATCH		32
+
+/* Presentation scheduler.
+ *
+ * Holds payloads (e.g. PCM sample blocks or video frames, from any number
+ * of streams) until their presentation time, in a min-heap keyed by
+ * presentation time, and hands them over to a callback in presentation time
+ * order once they are due. Payloads with the same presentation time are
+ * dispatched in the order they were added.
+ *
+ * The scheduler doesn't read any clock nor own any timer. Instead, the
+ * caller drives it from a single timer (e.g. one timerfd for all streams)
+ * or a busy-poll loop: avtp_sched_add() tells when the earliest deadline
+ * changed, so the timer only needs to be re-armed then, and
+ * avtp_sched_dispatch() returns the next deadline once due payloads are
+ * dispatched. Times are in nanoseconds, usually presentation times unwrapped
+ * with avtp_clock_unwrap(), and must all come from the same clock.
+ *
+ * Storage for 'capacity' payloads is allocated at creation, so no memory is
+ * allocated afterwards. A scheduler may only be used by one thread at a
+ * time.
+ */
+struct avtp_sched;
+
+/* Dispatch callback. Payloads are passed in presentation time order.
+ * @payloads: Array of due payloads.
+ * @times: Array with the presentation time of each payload.
+ * @count: Number of payloads, from 1 to AVTP_SCHED_BATCH.
+ * @arg: Argument given to avtp_sched_create().
+ */
+typedef void (*avtp_sched_fn)(void *const payloads[], const uint64_t times[],
+						unsigned int count, void *arg);
+
+/* Create a scheduler.
+ * @sched: Pointer to variable which the new scheduler should be saved.
+ * @capacity: Maximum number of payloads held at once.
+ * @fn: Dispatch callback.
+ * @arg: Argument passed to 'fn'.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_sched_create(struct avtp_sched **sched, unsigned int capacity,
+						avtp_sched_fn fn, void *arg);
+
+/* Destroy scheduler created by avtp_sched_create(). Payloads still held are
+ * not dispatched, call avtp_sched_dispatch() with UINT64_MAX first to flush
+ * them if needed.
+ * @sched: Pointer to scheduler.
+ */
+void avtp_sched_destroy(struct avtp_sched *sched);
+
+/* Add a payload to be dispatched at informed time.
+ * @sched: Pointer to scheduler.
+ * @time: Presentation time of the payload.
+ * @payload: Payload, passed to the dispatch callback as is.
+ *
+ * Returns:
+ *    1: Success, and 'time' is the new earliest deadline, so the timer
+ *       driving the scheduler should be re-armed.
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOSPC: If the scheduler is full.
+ */
+int avtp_sched_add(struct avtp_sched *sched, uint64_t time, void *payload);
+
+/* Get the earliest deadline, i.e. the presentation time of the next payload
+ * to be dispatched.
+ * @sched: Pointer to scheduler.
+ * @time: Pointer to variable which the deadline should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOENT: If the scheduler holds no payload.
+ */
+int avtp_sched_next(const struct avtp_sched *sched, uint64_t *time);
+
+/* Dispatch all payloads due at informed time, i.e. with presentation time
+ * not after 'now', in batches of up to AVTP_SCHED_BATCH payloads. The
+ * callback may add payloads to the scheduler; the ones already due are
+ * dispatched by this same call.
+ * @sched: Pointer to scheduler.
+ * @now: Current time.
+ * @next: Pointer to variable which the next deadline is saved, or NULL. Set
+ *        to UINT64_MAX if no payload is left.
+ *
+ * Returns:
+ *    Number of payloads dispatched (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_sched_dispatch(struct avtp_sched *sched, uint64_t now,
+							uint64_t *next);
+
+/* Get number of payloads held by the scheduler.
+ * @sched: Pointer to scheduler.
+ *
+ * Returns:
+ *    Number of payloads (>= 0): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_sched_get_count(const struct avtp_sched *sched);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "avtp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of buckets from the latency histogram. */
+#define AVTP_STATS_LATENCY_BUCKETS	32
+
+/* Per-stream statistics.
+ *
+ * Statistics are gathered by the thread receiving the stream, which feeds
+ * every PDU to avtp_stats_update() (or to avtp_stats_track_seq() and
+ * avtp_stats_track_time() for PDUs other than Stream AVTPDUs, e.g. CRF).
+ * Counters are updated without taking any lock and can be read at any time
+ * from any other thread with avtp_stats_read(). Only one thread may update
+ * a given stats object.
+ *
+ * Sequence numbers are tracked over a window of the last 128 of them, so
+ * 8-bit 'sequence_num' wraparound is handled and out of order PDUs are told
+ * apart from duplicated ones. A PDU arriving after PDUs with later sequence
+ * numbers is first accounted as lost and, once it arrives, as reordered
+ * instead.
+ *
+ * Timing is measured as presentation time minus arrival time. PDUs arriving
+ * after their presentation time are late, and PDUs arriving earlier than
+ * 'max_transit_time' before it are early. The time left until presentation
+ * of PDUs which are not late is accounted in a logarithmic histogram: bucket
+ * 0 counts PDUs with 0 ns left and bucket N counts PDUs with [2^(N-1), 2^N)
+ * ns left.
+ */
+struct avtp_stats;
+
+/* Snapshot of the counters from a stats object. */
+struct avtp_stats_snapshot {
+	uint64_t received;
+	uint64_t lost;
+	uint64_t duplicated;
+	uint64_t reordered;
+	uint64_t late;
+	uint64_t early;
+	uint64_t latency[AVTP_STATS_LATENCY_BUCKETS];
+};
+
+/* Classification of a sequence number, returned by avtp_stats_track_seq(). */
+enum avtp_stats_seq {
+	/* Sequence number is the one expected. */
+	AVTP_STATS_SEQ_IN_ORDER,
+	/* Sequence number is ahead of the one expected, PDUs were lost. */
+	AVTP_STATS_SEQ_GAP,
+	/* PDU was previously accounted as lost. */
+	AVTP_STATS_SEQ_REORDERED,
+	/* PDU was already received. */
+	AVTP_STATS_SEQ_DUPLICATE,
+};
+
+/* Create a stats object.
+ * @stats: Pointer to variable which the new stats object should be saved.
+ * @max_transit_time: Maximum transit time of the stream, in nanoseconds.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_stats_create(struct avtp_stats **stats, uint32_t max_transit_time);
+
+/* Destroy stats object created by avtp_stats_create(). No thread may be using
+ * it anymore.
+ * @stats: Pointer to stats object.
+ */
+void avtp_stats_destroy(struct avtp_stats *stats);
+
+/* Account a received PDU by its sequence number.
+ * @stats: Pointer to stats object.
+ * @seq_num: Value of 'sequence_num' field from the PDU.
+ *
+ * Returns:
+ *    Classification of 'seq_num' (>= 0, enum avtp_stats_seq): Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stats_track_seq(struct avtp_stats *stats, uint8_t seq_num);
+
+/* Account the arrival time of a PDU against its presentation time.
+ * @stats: Pointer to stats object.
+ * @avtp_time: Presentation time from the PDU (e.g. 'avtp_timestamp' field).
+ * @arrival_time: Arrival time of the PDU, in nanoseconds, from the same clock
+ *                as 'avtp_time', usually gPTP time.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stats_track_time(struct avtp_stats *stats, uint32_t avtp_time,
+						uint64_t arrival_time);
+
+/* Account a received Stream AVTPDU, i.e. its sequence number and, if 'tv' is
+ * set, its arrival time.
+ * @stats: Pointer to stats object.
+ * @pdu: Pointer to PDU struct.
+ * @arrival_time: Arrival time of the PDU, in nanoseconds, usually gPTP time.
+ *
+ * Returns:
+ *    Classification of PDU sequence number (>= 0, enum avtp_stats_seq):
+ *             Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stats_update(struct avtp_stats *stats,
+				const struct avtp_stream_pdu *pdu,
+				uint64_t arrival_time);
+
+/* Read all counters from a stats object. Can be called from any thread. Each
+ * counter is read atomically but counters are not read all at once, so they
+ * may be slightly off from each other if the stats object is being updated.
+ * @stats: Pointer to stats object.
+ * @snap: Pointer to struct where counters are saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stats_read(const struct avtp_stats *stats,
+				struct avtp_stats_snapshot *snap);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "avtp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stream context.
+ *
+ * Between consecutive PDUs from a steady-state stream only 'sequence_num'
+ * and 'avtp_timestamp' change, the latter by a fixed amount per sample. A
+ * stream context keeps the header template from a stream together with the
+ * sequence number and presentation time of its next PDU, so each PDU is
+ * produced by patching two words instead of setting each field or reading
+ * the clock again.
+ *
+ * Presentation time is kept in 32.32 fixed point nanoseconds, so sample
+ * periods which aren't a whole number of nanoseconds (e.g. 20833.33 ns at
+ * 48 kHz) don't drift. The 'avtp_timestamp' field carries it rounded to the
+ * nearest nanosecond.
+ *
+ * On the listener side, a context tracks the sequence number expected from
+ * the next PDU received and reconstructs presentation times of received PDUs,
+ * accounting them in the stream stats as well if there are any.
+ *
+ * AAF streams in sparse timestamp mode (i.e. 'sp' set in the template) only
+ * carry a valid 'avtp_timestamp' in every AVTP_AAF_PCM_SPARSE_INTERVAL-th
+ * PDU, those whose sequence number is a multiple of it, so 'tv' is cleared
+ * on all others. On the listener side, presentation times of PDUs without
+ * timestamp are interpolated from the last PDU with one, advancing by the
+ * sample period and the number of frames carried by each PDU.
+ *
+ * Contexts work with any Stream AVTPDU format (AAF, CVF, RVF, IEC
+ * 61883/IIDC, TSCF). They may be read and written directly, but should be
+ * set up by avtp_stream_ctx_init(). A context may only be used by one thread
+ * at a time.
+ *
+ * Each context takes exactly one cache line, so contexts from many streams
+ * can be kept in a single array, e.g. allocated by
+ * avtp_stream_ctx_array_create(), without two streams ever sharing a cache
+ * line. Any other per-stream state from the application should live in a
+ * separate array indexed the same way.
+ */
+#define AVTP_STREAM_CTX_CACHE_LINE	64
+
+/* Flags from 'flags' field of struct avtp_stream_ctx. */
+/* 'rx_seq' holds the sequence number expected from the next PDU. */
+#define AVTP_STREAM_CTX_FLAG_RX_SEQ	(1 << 0)
+/* 'time' holds the presentation time interpolated for the next PDU. */
+#define AVTP_STREAM_CTX_FLAG_RX_TIME	(1 << 1)
+/* Stream is in AAF sparse timestamp mode. */
+#define AVTP_STREAM_CTX_FLAG_SPARSE	(1 << 2)
+
+struct avtp_stats;
+struct avtp_clock;
+
+struct avtp_stream_ctx {
+	/* Header template, in network order. */
+	struct avtp_stream_pdu tmpl;
+	/* 'subtype_data' word from template, in host order, with
+	 * 'sequence_num' bits cleared.
+	 */
+	uint32_t subtype_data;
+	uint8_t seq_num;
+	/* Sequence number expected from the next PDU received. */
+	uint8_t rx_seq;
+	/* AVTP_STREAM_CTX_FLAG_* flags. */
+	uint8_t flags;
+	/* Presentation time of next PDU, transmitted or received, 32.32
+	 * fixed point ns.
+	 */
+	uint64_t time;
+	/* Sample period, 32.32 fixed point ns. */
+	uint64_t period;
+	/* Stats object received PDUs are accounted in, or NULL. Not owned by
+	 * the context, so it may be set after avtp_stream_ctx_init().
+	 */
+	struct avtp_stats *stats;
+	/* Reference clock, or NULL. Read by avtp_stream_ctx_sync() and by
+	 * avtp_stream_ctx_receive() when no arrival time is given. Not owned
+	 * by the context either.
+	 */
+	struct avtp_clock *clk;
+} __attribute__ ((__aligned__(AVTP_STREAM_CTX_CACHE_LINE)));
+
+/* Initialize stream context. The sequence number and presentation time of
+ * the first PDU are taken from the template. No stats object or reference
+ * clock is set.
+ * @ctx: Pointer to stream context.
+ * @tmpl: Pointer to Stream AVTPDU header template, previously built by some
+ *        format pack function (e.g. avtp_aaf_pdu_pack()).
+ * @sample_rate: Sample rate, in Hz, which presentation time is advanced by.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_ctx_init(struct avtp_stream_ctx *ctx,
+				const struct avtp_stream_pdu *tmpl,
+				uint32_t sample_rate);
+
+/* Set presentation time of next PDU, e.g. to resync the stream with its
+ * reference clock.
+ * @ctx: Pointer to stream context.
+ * @time: Presentation time, in ns. Only its 32 least significant bits are
+ *        kept.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_ctx_set_time(struct avtp_stream_ctx *ctx, uint64_t time);
+
+/* Set presentation time of next PDU from the reference clock, i.e. to the
+ * current time plus 'offset'.
+ * @ctx: Pointer to stream context.
+ * @offset: Time, in ns, from now to presentation, e.g. max transit time.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid or the context has no reference
+ *             clock.
+ *    Other negative errno: If the reference clock couldn't be read.
+ */
+int avtp_stream_ctx_sync(struct avtp_stream_ctx *ctx, uint64_t offset);
+
+/* Emit next PDU header from the template, with the current sequence number
+ * and presentation time, then advance them. The AVTPDU payload is not
+ * touched.
+ * @ctx: Pointer to stream context.
+ * @pdu: Pointer to PDU struct to be emitted.
+ * @samples: Number of samples carried by the PDU, which presentation time is
+ *           advanced by.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_ctx_emit(struct avtp_stream_ctx *ctx,
+				struct avtp_stream_pdu *pdu,
+				unsigned int samples);
+
+/* Same as avtp_stream_ctx_emit() but only 'sequence_num' and
+ * 'avtp_timestamp' are written, so 'pdu' must already hold a header from
+ * this stream, e.g. a TX ring slot or pool buffer being reused.
+ * @ctx: Pointer to stream context.
+ * @pdu: Pointer to PDU struct to be updated.
+ * @samples: Number of samples carried by the PDU.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_ctx_advance(struct avtp_stream_ctx *ctx,
+				struct avtp_stream_pdu *pdu,
+				unsigned int samples);
+
+/* Emit headers of a burst of consecutive PDUs at once, e.g. to pre-fill a TX
+ * ring. Same as calling avtp_stream_ctx_emit() for each PDU.
+ * @ctx: Pointer to stream context.
+ * @pdus: Array of pointers to PDU structs.
+ * @count: Number of elements in 'pdus'.
+ * @samples: Number of samples carried by each PDU.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_ctx_emit_burst(struct avtp_stream_ctx *ctx, void *pdus[],
+				unsigned int count, unsigned int samples);
+
+/* Same as avtp_stream_ctx_emit_burst() but, as in avtp_stream_ctx_advance(),
+ * only 'sequence_num' and 'avtp_timestamp' are written.
+ * @ctx: Pointer to stream context.
+ * @pdus: Array of pointers to PDU structs.
+ * @count: Number of elements in 'pdus'.
+ * @samples: Number of samples carried by each PDU.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_stream_ctx_advance_burst(struct avtp_stream_ctx *ctx, void *pdus[],
+				unsigned int count, unsigned int samples);
+
+/* Account a PDU received from the stream. Its sequence number is checked
+ * against the one expected, the PDU is accounted in the stats object, if the
+ * context has one, and its presentation time is reconstructed from the
+ * arrival time. The PDU must have been validated as a Stream AVTPDU from
+ * this stream already.
+ * @ctx: Pointer to stream context.
+ * @pdu: Pointer to PDU struct.
+ * @arrival_time: Arrival time of the PDU, in ns, or 0 to read the reference
+ *                clock instead.
+ * @time: Pointer to variable which the presentation time, in ns, should be
+ *        saved, or NULL. It is set to 0 if 'tv' is not set in the PDU and,
+ *        for sparse timestamp mode, if the time couldn't be interpolated
+ *        either, e.g. after lost PDUs.
+ *
+ * Returns:
+ *    Classification of PDU sequence number (>= 0, enum avtp_stats_seq):
+ *             Success. Without a stats object, PDUs are only told apart as
+ *             AVTP_STATS_SEQ_IN_ORDER or AVTP_STATS_SEQ_GAP.
+ *    -EINVAL: If any argument is invalid, or if the arrival time is needed
+ *             but neither given nor available from a reference clock.
+ *    Other negative errno: If the reference clock couldn't be read.
+ */
+int avtp_stream_ctx_receive(struct avtp_stream_ctx *ctx,
+				const struct avtp_stream_pdu *pdu,
+				uint64_t arrival_time, uint64_t *time);
+
+/* Allocate an array of stream contexts in a single, cache line aligned
+ * block. Contexts are zeroed and still need to be set up by
+ * avtp_stream_ctx_init().
+ * @ctxs: Pointer to variable which the array should be saved.
+ * @count: Number of contexts.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ *    -ENOMEM: If memory couldn't be allocated.
+ */
+int avtp_stream_ctx_array_create(struct avtp_stream_ctx **ctxs,
+							unsigned int count);
+
+/* Free array allocated by avtp_stream_ctx_array_create(). Stats objects and
+ * reference clocks set in the contexts are not destroyed.
+ * @ctxs: Pointer to first context from the array.
+ */
+void avtp_stream_ctx_array_destroy(struct avtp_stream_ctx *ctxs);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "avtp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Time-Synchronous and Non-Time-Synchronous Control Formats (TSCF and NTSCF).
+ *
+ * Both formats carry a sequence of AVTP Control Format (ACF) messages (e.g.
+ * CAN or LIN messages, see avtp_acf.h) right after their header. TSCF
+ * AVTPDUs share the Stream AVTPDU header layout, so they are handled with
+ * struct avtp_stream_pdu. NTSCF AVTPDUs have a shorter header of their own
+ * with no 'avtp_timestamp' field.
+ */
+
+struct avtp_ntscf_pdu {
+	uint32_t subtype_data;
+	uint64_t stream_id;
+	uint8_t acf_msgs[0];
+} __attribute__ ((__packed__));
+
+/* Maximum value of 'ntscf_data_length' field, in bytes. */
+#define AVTP_NTSCF_MAX_DATA_LEN			2047
+
+enum avtp_tscf_field {
+	AVTP_TSCF_FIELD_SV,
+	AVTP_TSCF_FIELD_MR,
+	AVTP_TSCF_FIELD_TV,
+	AVTP_TSCF_FIELD_SEQ_NUM,
+	AVTP_TSCF_FIELD_TU,
+	AVTP_TSCF_FIELD_STREAM_ID,
+	AVTP_TSCF_FIELD_TIMESTAMP,
+	AVTP_TSCF_FIELD_STREAM_DATA_LEN,
+	AVTP_TSCF_FIELD_MAX,
+};
+
+enum avtp_ntscf_field {
+	AVTP_NTSCF_FIELD_SV,
+	AVTP_NTSCF_FIELD_DATA_LEN,
+	AVTP_NTSCF_FIELD_SEQ_NUM,
+	AVTP_NTSCF_FIELD_STREAM_ID,
+	AVTP_NTSCF_FIELD_MAX,
+};
+
+/* Host order representation of all TSCF AVTPDU header fields. TSCF has no
+ * format specific fields, 'stream_data_len' is the length of the ACF messages
+ * carried by the PDU.
+ */
+struct avtp_tscf_hdr {
+	struct avtp_stream_hdr stream;
+};
+
+/* Host order representation of all NTSCF AVTPDU header fields. */
+struct avtp_ntscf_hdr {
+	uint64_t stream_id;
+	uint16_t data_len;
+	uint8_t sv;
+	uint8_t seq_num;
+};
+
+/* Get value from TSCF AVTPDU field.
+ * @pdu: Pointer to PDU struct.
+ * @field: PDU field to be retrieved.
+ * @val: Pointer to variable which the retrieved value should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_tscf_pdu_get(const struct avtp_stream_pdu *pdu,
+				enum avtp_tscf_field field, uint64_t *val);
+
+/* Set value from TSCF AVTPDU field.
+ * @pdu: Pointer to PDU struct.
+ * @field: PDU field to be set.
+ * @val: Value to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_tscf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_tscf_field field,
+								uint64_t val);
+
+/* Initialize TSCF AVTPDU. All AVTPDU fields are initialized with zero except
+ * 'subtype' (which is set to AVTP_SUBTYPE_TSCF) and 'sv' (which is set to 1).
+ * @pdu: Pointer to PDU struct.
+ *
+ * Return values:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_tscf_pdu_init(struct avtp_stream_pdu *pdu);
+
+/* Retrieve all TSCF AVTPDU header fields at once. This is cheaper than
+ * calling avtp_tscf_pdu_get() for each field since every PDU word is
+ * converted to host order only once.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_tscf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+						struct avtp_tscf_hdr *hdr);
+
+/* Set all TSCF AVTPDU header fields at once from host order struct. This is
+ * cheaper than calling avtp_tscf_pdu_set() for each field since every PDU
+ * word is written only once. The 'subtype' field is set to AVTP_SUBTYPE_TSCF
+ * and 'version' is set to 0.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_tscf_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_tscf_hdr *hdr);
+
+/* Get value from NTSCF AVTPDU field.
+ * @pdu: Pointer to PDU struct.
+ * @field: PDU field to be retrieved.
+ * @val: Pointer to variable which the retrieved value should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ntscf_pdu_get(const struct avtp_ntscf_pdu *pdu,
+				enum avtp_ntscf_field field, uint64_t *val);
+
+/* Set value from NTSCF AVTPDU field.
+ * @pdu: Pointer to PDU struct.
+ * @field: PDU field to be set.
+ * @val: Value to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ntscf_pdu_set(struct avtp_ntscf_pdu *pdu,
+				enum avtp_ntscf_field field, uint64_t val);
+
+/* Initialize NTSCF AVTPDU. All AVTPDU fields are initialized with zero
+ * except 'subtype' (which is set to AVTP_SUBTYPE_NTSCF) and 'sv' (which is
+ * set to 1).
+ * @pdu: Pointer to PDU struct.
+ *
+ * Return values:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ntscf_pdu_init(struct avtp_ntscf_pdu *pdu);
+
+/* Retrieve all NTSCF AVTPDU header fields at once. This is cheaper than
+ * calling avtp_ntscf_pdu_get() for each field since every PDU word is
+ * converted to host order only once.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct which the retrieved fields should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ntscf_pdu_unpack(const struct avtp_ntscf_pdu *pdu,
+						struct avtp_ntscf_hdr *hdr);
+
+/* Set all NTSCF AVTPDU header fields at once from host order struct. The
+ * 'subtype' field is set to AVTP_SUBTYPE_NTSCF and 'version' is set to 0.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If any argument is invalid.
+ */
+int avtp_ntscf_pdu_pack(struct avtp_ntscf_pdu *pdu,
+					const struct avtp_ntscf_hdr *hdr);
+
+#ifdef __cplusplus
+}
+#endif
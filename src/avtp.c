@@ -29,39 +29,31 @@
 #include <stddef.h>
 
 #include "avtp.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "util.h"
 
-#define SHIFT_SUBTYPE			(31 - 7)
-#define SHIFT_VERSION			(31 - 11)
-
-#define MASK_SUBTYPE			(BITMASK(8) << SHIFT_SUBTYPE)
-#define MASK_VERSION			(BITMASK(3) << SHIFT_VERSION)
+static const struct avtp_field_desc fields[AVTP_FIELD_MAX] = {
+	[AVTP_FIELD_SUBTYPE] = AVTP_FIELD(struct avtp_common_pdu, subtype_data,
+						AVTP_COMMON_MASK_SUBTYPE),
+	[AVTP_FIELD_VERSION] = AVTP_FIELD(struct avtp_common_pdu, subtype_data,
+						AVTP_COMMON_MASK_VERSION),
+};
 
 int avtp_pdu_get(const struct avtp_common_pdu *pdu, enum avtp_field field,
 								uint32_t *val)
 {
-	uint32_t bitmap, mask;
-	uint8_t shift;
+	uint64_t value;
+	int res;
 
 	if (!pdu || !val)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_FIELD_SUBTYPE:
-		mask = MASK_SUBTYPE;
-		shift = SHIFT_SUBTYPE;
-		break;
-	case AVTP_FIELD_VERSION:
-		mask = MASK_VERSION;
-		shift = SHIFT_VERSION;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	bitmap = ntohl(pdu->subtype_data);
+	res = avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, &value);
+	if (res < 0)
+		return res;
 
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
+	*val = value;
 
 	return 0;
 }
@@ -69,30 +61,8 @@ int avtp_pdu_get(const struct avtp_common_pdu *pdu, enum avtp_field field,
 int avtp_pdu_set(struct avtp_common_pdu *pdu, enum avtp_field field,
 								uint32_t value)
 {
-	uint32_t bitmap, mask;
-	uint8_t shift;
-
 	if (!pdu)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_FIELD_SUBTYPE:
-		mask = MASK_SUBTYPE;
-		shift = SHIFT_SUBTYPE;
-		break;
-	case AVTP_FIELD_VERSION:
-		mask = MASK_VERSION;
-		shift = SHIFT_VERSION;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	bitmap = ntohl(pdu->subtype_data);
-
-	BITMAP_SET_VALUE(bitmap, value, mask, shift);
-
-	pdu->subtype_data = htonl(bitmap);
-
-	return 0;
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, value);
 }
@@ -30,189 +30,56 @@
 
 #include "avtp.h"
 #include "avtp_aaf.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "avtp_stream.h"
 #include "util.h"
 
-#define SHIFT_FORMAT			(31 - 7)
-#define SHIFT_NSR			(31 - 11)
-#define SHIFT_CHAN_PER_FRAME		(31 - 23)
-#define SHIFT_SP			(31 - 19)
-#define SHIFT_EVT			(31 - 23)
-
-#define MASK_FORMAT			(BITMASK(8) << SHIFT_FORMAT)
-#define MASK_NSR			(BITMASK(4) << SHIFT_NSR)
-#define MASK_CHAN_PER_FRAME		(BITMASK(10) << SHIFT_CHAN_PER_FRAME)
-#define MASK_BIT_DEPTH			(BITMASK(8))
-#define MASK_SP				(BITMASK(1) << SHIFT_SP)
-#define MASK_EVT			(BITMASK(4) << SHIFT_EVT)
-
-static int get_field_value(const struct avtp_stream_pdu *pdu,
-				enum avtp_aaf_field field, uint64_t *val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-
-	switch (field) {
-	case AVTP_AAF_FIELD_FORMAT:
-		mask = MASK_FORMAT;
-		shift = SHIFT_FORMAT;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_AAF_FIELD_NSR:
-		mask = MASK_NSR;
-		shift = SHIFT_NSR;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_AAF_FIELD_CHAN_PER_FRAME:
-		mask = MASK_CHAN_PER_FRAME;
-		shift = SHIFT_CHAN_PER_FRAME;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_AAF_FIELD_BIT_DEPTH:
-		mask = MASK_BIT_DEPTH;
-		shift = 0;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_AAF_FIELD_SP:
-		mask = MASK_SP;
-		shift = SHIFT_SP;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_AAF_FIELD_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
-
-	return 0;
-}
+#define SHIFT_FORMAT			AVTP_AAF_SHIFT_FORMAT
+#define SHIFT_NSR			AVTP_AAF_SHIFT_NSR
+#define SHIFT_CHAN_PER_FRAME		AVTP_AAF_SHIFT_CHAN_PER_FRAME
+#define SHIFT_SP			AVTP_AAF_SHIFT_SP
+#define SHIFT_EVT			AVTP_AAF_SHIFT_EVT
+
+#define MASK_FORMAT			AVTP_AAF_MASK_FORMAT
+#define MASK_NSR			AVTP_AAF_MASK_NSR
+#define MASK_CHAN_PER_FRAME		AVTP_AAF_MASK_CHAN_PER_FRAME
+#define MASK_BIT_DEPTH			AVTP_AAF_MASK_BIT_DEPTH
+#define MASK_SP				AVTP_AAF_MASK_SP
+#define MASK_EVT			AVTP_AAF_MASK_EVT
+
+static const struct avtp_field_desc fields[AVTP_AAF_FIELD_MAX] = {
+	AVTP_STREAM_FIELD_DESCS,
+	[AVTP_AAF_FIELD_FORMAT] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_FORMAT),
+	[AVTP_AAF_FIELD_NSR] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_NSR),
+	[AVTP_AAF_FIELD_CHAN_PER_FRAME] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_CHAN_PER_FRAME),
+	[AVTP_AAF_FIELD_BIT_DEPTH] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_BIT_DEPTH),
+	[AVTP_AAF_FIELD_SP] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_SP),
+	[AVTP_AAF_FIELD_EVT] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_EVT),
+};
 
 int avtp_aaf_pdu_get(const struct avtp_stream_pdu *pdu,
 				enum avtp_aaf_field field, uint64_t *val)
 {
-	int res;
-
 	if (!pdu || !val)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_AAF_FIELD_SV:
-	case AVTP_AAF_FIELD_MR:
-	case AVTP_AAF_FIELD_TV:
-	case AVTP_AAF_FIELD_SEQ_NUM:
-	case AVTP_AAF_FIELD_TU:
-	case AVTP_AAF_FIELD_STREAM_DATA_LEN:
-	case AVTP_AAF_FIELD_TIMESTAMP:
-	case AVTP_AAF_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_get(pdu, (enum avtp_stream_field) field,
-									val);
-		break;
-	case AVTP_AAF_FIELD_FORMAT:
-	case AVTP_AAF_FIELD_NSR:
-	case AVTP_AAF_FIELD_CHAN_PER_FRAME:
-	case AVTP_AAF_FIELD_BIT_DEPTH:
-	case AVTP_AAF_FIELD_SP:
-	case AVTP_AAF_FIELD_EVT:
-		res = get_field_value(pdu, field, val);
-		break;
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
-}
-
-static int set_field_value(struct avtp_stream_pdu *pdu,
-				enum avtp_aaf_field field, uint32_t val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-	void *ptr;
-
-	switch (field) {
-	case AVTP_AAF_FIELD_FORMAT:
-		mask = MASK_FORMAT;
-		shift = SHIFT_FORMAT;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_AAF_FIELD_NSR:
-		mask = MASK_NSR;
-		shift = SHIFT_NSR;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_AAF_FIELD_CHAN_PER_FRAME:
-		mask = MASK_CHAN_PER_FRAME;
-		shift = SHIFT_CHAN_PER_FRAME;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_AAF_FIELD_BIT_DEPTH:
-		mask = MASK_BIT_DEPTH;
-		shift = 0;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_AAF_FIELD_SP:
-		mask = MASK_SP;
-		shift = SHIFT_SP;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_AAF_FIELD_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		ptr = &pdu->packet_info;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	bitmap = get_unaligned_be32(ptr);
-
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
-
-	put_unaligned_be32(bitmap, ptr);
-
-	return 0;
+	return avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
 int avtp_aaf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_aaf_field field,
 								uint64_t val)
 {
-	int res;
-
 	if (!pdu)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_AAF_FIELD_SV:
-	case AVTP_AAF_FIELD_MR:
-	case AVTP_AAF_FIELD_TV:
-	case AVTP_AAF_FIELD_SEQ_NUM:
-	case AVTP_AAF_FIELD_TU:
-	case AVTP_AAF_FIELD_STREAM_DATA_LEN:
-	case AVTP_AAF_FIELD_TIMESTAMP:
-	case AVTP_AAF_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_set(pdu, (enum avtp_stream_field) field,
-									val);
-		break;
-	case AVTP_AAF_FIELD_FORMAT:
-	case AVTP_AAF_FIELD_NSR:
-	case AVTP_AAF_FIELD_CHAN_PER_FRAME:
-	case AVTP_AAF_FIELD_BIT_DEPTH:
-	case AVTP_AAF_FIELD_SP:
-	case AVTP_AAF_FIELD_EVT:
-		res = set_field_value(pdu, field, val);
-		break;
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
 int avtp_aaf_pdu_init(struct avtp_stream_pdu *pdu)
@@ -235,3 +102,54 @@ int avtp_aaf_pdu_init(struct avtp_stream_pdu *pdu)
 
 	return 0;
 };
+
+int avtp_aaf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+						struct avtp_aaf_hdr *hdr)
+{
+	uint32_t format_specific, packet_info;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	format_specific = ntohl(pdu->format_specific);
+	packet_info = ntohl(pdu->packet_info);
+
+	avtp_stream_hdr_decode(&hdr->stream, pdu, ntohl(pdu->subtype_data),
+								packet_info);
+
+	hdr->format = BITMAP_GET_VALUE(format_specific, MASK_FORMAT,
+								SHIFT_FORMAT);
+	hdr->nsr = BITMAP_GET_VALUE(format_specific, MASK_NSR, SHIFT_NSR);
+	hdr->chan_per_frame = BITMAP_GET_VALUE(format_specific,
+					MASK_CHAN_PER_FRAME,
+					SHIFT_CHAN_PER_FRAME);
+	hdr->bit_depth = BITMAP_GET_VALUE(format_specific, MASK_BIT_DEPTH, 0);
+	hdr->sp = BITMAP_GET_VALUE(packet_info, MASK_SP, SHIFT_SP);
+	hdr->evt = BITMAP_GET_VALUE(packet_info, MASK_EVT, SHIFT_EVT);
+
+	return 0;
+}
+
+int avtp_aaf_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_aaf_hdr *hdr)
+{
+	uint32_t format_specific = 0, packet_info = 0;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	BITMAP_SET_VALUE(format_specific, (uint32_t) hdr->format,
+						MASK_FORMAT, SHIFT_FORMAT);
+	BITMAP_SET_VALUE(format_specific, hdr->nsr, MASK_NSR, SHIFT_NSR);
+	BITMAP_SET_VALUE(format_specific, hdr->chan_per_frame,
+				MASK_CHAN_PER_FRAME, SHIFT_CHAN_PER_FRAME);
+	BITMAP_SET_VALUE(format_specific, hdr->bit_depth, MASK_BIT_DEPTH, 0);
+	BITMAP_SET_VALUE(packet_info, hdr->sp, MASK_SP, SHIFT_SP);
+	BITMAP_SET_VALUE(packet_info, hdr->evt, MASK_EVT, SHIFT_EVT);
+
+	avtp_stream_hdr_encode(pdu, &hdr->stream, AVTP_SUBTYPE_AAF, 0,
+								packet_info);
+	pdu->format_specific = htonl(format_specific);
+
+	return 0;
+}
@@ -0,0 +1,1067 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_cpu.h"
+#include "avtp_stream_ctx.h"
+#include "util.h"
+
+/* Samples are converted in blocks so intermediate buffers can live on the
+ * stack. Must be at least the maximum 'chan_per_frame' value so planar
+ * conversion always handles at least one whole frame per block.
+ */
+#define BLOCK_SIZE		1024
+
+#define S32_SCALE		2147483648.0f
+
+/* Samples converted by the kernel self-test: a few vectors of every width
+ * plus a tail.
+ */
+#define CHECK_LEN		135
+
+/* Conversion kernels between host order buffers and network order payload.
+ * Payload pointers don't need to be aligned.
+ */
+struct pcm_ops {
+	/* Swap bytes from 'n' 16-bit words. */
+	void (*bswap16)(void *dst, const void *src, size_t n);
+	/* Swap bytes from 'n' 32-bit words. */
+	void (*bswap32)(void *dst, const void *src, size_t n);
+	/* Write the 3 most significant bytes from 'n' samples, big endian. */
+	void (*pack24)(void *dst, const int32_t *src, size_t n);
+	/* Read 'n' 3-byte big endian samples into the 3 most significant
+	 * bytes of each destination sample.
+	 */
+	void (*unpack24)(int32_t *dst, const void *src, size_t n);
+};
+
+static void bswap16_generic(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		uint16_t val;
+
+		memcpy(&val, s + i * 2, sizeof(val));
+		put_unaligned_be16(val, d + i * 2);
+	}
+}
+
+static void bswap32_generic(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		uint32_t val;
+
+		memcpy(&val, s + i * 4, sizeof(val));
+		put_unaligned_be32(val, d + i * 4);
+	}
+}
+
+static void pack24_generic(void *dst, const int32_t *src, size_t n)
+{
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		uint32_t val = (uint32_t) src[i];
+
+		d[i * 3] = val >> 24;
+		d[i * 3 + 1] = val >> 16;
+		d[i * 3 + 2] = val >> 8;
+	}
+}
+
+static void unpack24_generic(int32_t *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		dst[i] = (int32_t) (((uint32_t) s[i * 3] << 24) |
+					((uint32_t) s[i * 3 + 1] << 16) |
+					((uint32_t) s[i * 3 + 2] << 8));
+	}
+}
+
+static const struct pcm_ops generic_ops = {
+	.bswap16 = bswap16_generic,
+	.bswap32 = bswap32_generic,
+	.pack24 = pack24_generic,
+	.unpack24 = unpack24_generic,
+};
+
+#ifdef HAVE_X86_KERNELS
+
+__attribute__((target("sse2")))
+static void bswap16_sse2(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 2));
+
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *) (d + i * 2), v);
+	}
+
+	bswap16_generic(d + i * 2, s + i * 2, n - i);
+}
+
+__attribute__((target("sse2")))
+static void bswap32_sse2(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 4));
+
+		/* Swap 16-bit halves from each word, then bytes from each
+		 * half.
+		 */
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *) (d + i * 4), v);
+	}
+
+	bswap32_generic(d + i * 4, s + i * 4, n - i);
+}
+
+/* SSE2 has no byte shuffle so 24-bit samples are handled by generic code. */
+static const struct pcm_ops sse2_ops = {
+	.bswap16 = bswap16_sse2,
+	.bswap32 = bswap32_sse2,
+	.pack24 = pack24_generic,
+	.unpack24 = unpack24_generic,
+};
+
+/* Byte shuffles swapping bytes from each 16-bit and 32-bit word of a 128-bit
+ * lane.
+ */
+#define BSWAP16_SHUF _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,		\
+					9, 8, 11, 10, 13, 12, 15, 14)
+#define BSWAP32_SHUF _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,		\
+					11, 10, 9, 8, 15, 14, 13, 12)
+
+__attribute__((target("sse4.2")))
+static void bswap16_sse42(void *dst, const void *src, size_t n)
+{
+	const __m128i shuf = BSWAP16_SHUF;
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 2));
+
+		v = _mm_shuffle_epi8(v, shuf);
+		_mm_storeu_si128((__m128i *) (d + i * 2), v);
+	}
+
+	bswap16_generic(d + i * 2, s + i * 2, n - i);
+}
+
+__attribute__((target("sse4.2")))
+static void bswap32_sse42(void *dst, const void *src, size_t n)
+{
+	const __m128i shuf = BSWAP32_SHUF;
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 4));
+
+		v = _mm_shuffle_epi8(v, shuf);
+		_mm_storeu_si128((__m128i *) (d + i * 4), v);
+	}
+
+	bswap32_generic(d + i * 4, s + i * 4, n - i);
+}
+
+/* 24-bit samples don't fill whole 128-bit vectors, where the partial stores
+ * needed cost as much as generic code.
+ */
+static const struct pcm_ops sse42_ops = {
+	.bswap16 = bswap16_sse42,
+	.bswap32 = bswap32_sse42,
+	.pack24 = pack24_generic,
+	.unpack24 = unpack24_generic,
+};
+
+__attribute__((target("avx2")))
+static void bswap16_avx2(void *dst, const void *src, size_t n)
+{
+	const __m256i shuf = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+					9, 8, 11, 10, 13, 12, 15, 14,
+					1, 0, 3, 2, 5, 4, 7, 6,
+					9, 8, 11, 10, 13, 12, 15, 14);
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (s + i * 2));
+
+		v = _mm256_shuffle_epi8(v, shuf);
+		_mm256_storeu_si256((__m256i *) (d + i * 2), v);
+	}
+
+	bswap16_sse2(d + i * 2, s + i * 2, n - i);
+}
+
+__attribute__((target("avx2")))
+static void bswap32_avx2(void *dst, const void *src, size_t n)
+{
+	const __m256i shuf = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+					11, 10, 9, 8, 15, 14, 13, 12,
+					3, 2, 1, 0, 7, 6, 5, 4,
+					11, 10, 9, 8, 15, 14, 13, 12);
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (s + i * 4));
+
+		v = _mm256_shuffle_epi8(v, shuf);
+		_mm256_storeu_si256((__m256i *) (d + i * 4), v);
+	}
+
+	bswap32_sse2(d + i * 4, s + i * 4, n - i);
+}
+
+__attribute__((target("avx2")))
+static void pack24_avx2(void *dst, const int32_t *src, size_t n)
+{
+	/* Pick the 3 most significant bytes from each sample, in big endian
+	 * order, into the lower 12 bytes of each 128-bit lane. Then move the
+	 * 3 used words from the upper lane right after the ones from the
+	 * lower lane.
+	 */
+	const __m256i shuf = _mm256_setr_epi8(3, 2, 1, 7, 6, 5, 11, 10,
+					9, 15, 14, 13, -1, -1, -1, -1,
+					3, 2, 1, 7, 6, 5, 11, 10,
+					9, 15, 14, 13, -1, -1, -1, -1);
+	const __m256i perm = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (src + i));
+
+		v = _mm256_shuffle_epi8(v, shuf);
+		v = _mm256_permutevar8x32_epi32(v, perm);
+		_mm_storeu_si128((__m128i *) (d + i * 3),
+						_mm256_castsi256_si128(v));
+		_mm_storel_epi64((__m128i *) (d + i * 3 + 16),
+					_mm256_extracti128_si256(v, 1));
+	}
+
+	pack24_generic(d + i * 3, src + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void unpack24_avx2(int32_t *dst, const void *src, size_t n)
+{
+	/* Spread the 24 input bytes so each 128-bit lane holds 4 samples in
+	 * its lower 12 bytes, then place each sample's bytes in the 3 most
+	 * significant bytes of a host order word.
+	 */
+	const __m256i perm = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+	const __m256i shuf = _mm256_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3,
+					-1, 8, 7, 6, -1, 11, 10, 9,
+					-1, 2, 1, 0, -1, 5, 4, 3,
+					-1, 8, 7, 6, -1, 11, 10, 9);
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		const uint8_t *p = s + i * 3;
+		__m128i lo = _mm_loadu_si128((const __m128i *) p);
+		__m128i hi = _mm_loadl_epi64((const __m128i *) (p + 16));
+		__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo),
+									hi, 1);
+
+		v = _mm256_permutevar8x32_epi32(v, perm);
+		v = _mm256_shuffle_epi8(v, shuf);
+		_mm256_storeu_si256((__m256i *) (dst + i), v);
+	}
+
+	unpack24_generic(dst + i, s + i * 3, n - i);
+}
+
+static const struct pcm_ops avx2_ops = {
+	.bswap16 = bswap16_avx2,
+	.bswap32 = bswap32_avx2,
+	.pack24 = pack24_avx2,
+	.unpack24 = unpack24_avx2,
+};
+
+__attribute__((target("avx512f,avx512bw")))
+static void bswap16_avx512(void *dst, const void *src, size_t n)
+{
+	const __m512i shuf = _mm512_broadcast_i32x4(BSWAP16_SHUF);
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 32 <= n; i += 32) {
+		__m512i v = _mm512_loadu_si512(s + i * 2);
+
+		v = _mm512_shuffle_epi8(v, shuf);
+		_mm512_storeu_si512(d + i * 2, v);
+	}
+
+	bswap16_avx2(d + i * 2, s + i * 2, n - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void bswap32_avx512(void *dst, const void *src, size_t n)
+{
+	const __m512i shuf = _mm512_broadcast_i32x4(BSWAP32_SHUF);
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m512i v = _mm512_loadu_si512(s + i * 4);
+
+		v = _mm512_shuffle_epi8(v, shuf);
+		_mm512_storeu_si512(d + i * 4, v);
+	}
+
+	bswap32_avx2(d + i * 4, s + i * 4, n - i);
+}
+
+/* 24-bit samples keep the AVX2 kernels, whose cost is in the cross-lane
+ * moves rather than in the vector width.
+ */
+static const struct pcm_ops avx512_ops = {
+	.bswap16 = bswap16_avx512,
+	.bswap32 = bswap32_avx512,
+	.pack24 = pack24_avx2,
+	.unpack24 = unpack24_avx2,
+};
+
+#endif /* HAVE_X86_KERNELS */
+
+#ifdef HAVE_NEON_KERNELS
+
+static void bswap16_neon(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8)
+		vst1q_u8(d + i * 2, vrev16q_u8(vld1q_u8(s + i * 2)));
+
+	bswap16_generic(d + i * 2, s + i * 2, n - i);
+}
+
+static void bswap32_neon(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4)
+		vst1q_u8(d + i * 4, vrev32q_u8(vld1q_u8(s + i * 4)));
+
+	bswap32_generic(d + i * 4, s + i * 4, n - i);
+}
+
+static void pack24_neon(void *dst, const int32_t *src, size_t n)
+{
+	uint8_t *d = dst;
+	size_t i;
+
+	/* De-interleave bytes from 16 samples so val[3] holds the most
+	 * significant bytes, then interleave back only the 3 upper ones in
+	 * big endian order.
+	 */
+	for (i = 0; i + 16 <= n; i += 16) {
+		uint8x16x4_t in = vld4q_u8((const uint8_t *) (src + i));
+		uint8x16x3_t out = {{ in.val[3], in.val[2], in.val[1] }};
+
+		vst3q_u8(d + i * 3, out);
+	}
+
+	pack24_generic(d + i * 3, src + i, n - i);
+}
+
+static void unpack24_neon(int32_t *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		uint8x16x3_t in = vld3q_u8(s + i * 3);
+		uint8x16x4_t out = {{ vdupq_n_u8(0), in.val[2], in.val[1],
+								in.val[0] }};
+
+		vst4q_u8((uint8_t *) (dst + i), out);
+	}
+
+	unpack24_generic(dst + i, s + i * 3, n - i);
+}
+
+static const struct pcm_ops neon_ops = {
+	.bswap16 = bswap16_neon,
+	.bswap32 = bswap32_neon,
+	.pack24 = pack24_neon,
+	.unpack24 = unpack24_neon,
+};
+
+#endif /* HAVE_NEON_KERNELS */
+
+static const struct avtp_cpu_variant variants[] = {
+	{ AVTP_CPU_SCALAR, &generic_ops },
+#ifdef HAVE_X86_KERNELS
+	{ AVTP_CPU_SSE2, &sse2_ops },
+	{ AVTP_CPU_SSE4_2, &sse42_ops },
+	{ AVTP_CPU_AVX2, &avx2_ops },
+	{ AVTP_CPU_AVX512, &avx512_ops },
+#elif defined(HAVE_NEON_KERNELS)
+	{ AVTP_CPU_NEON, &neon_ops },
+#endif
+};
+
+static const struct pcm_ops *ops = &generic_ops;
+
+static int check_ops(const void *variant, const void *ref)
+{
+	const struct pcm_ops *v = variant, *r = ref;
+	int32_t samples[CHECK_LEN], exp[CHECK_LEN], res[CHECK_LEN];
+	uint8_t src[CHECK_LEN * 4 + 1];
+	int fail = 0;
+
+	/* Sources off by one byte, so unaligned loads are checked. */
+	avtp_cpu_fill_pattern(src, sizeof(src));
+	memcpy(samples, src + 1, sizeof(samples));
+
+	r->bswap16(exp, src + 1, CHECK_LEN);
+	v->bswap16(res, src + 1, CHECK_LEN);
+	fail |= memcmp(exp, res, CHECK_LEN * 2);
+
+	r->bswap32(exp, src + 1, CHECK_LEN);
+	v->bswap32(res, src + 1, CHECK_LEN);
+	fail |= memcmp(exp, res, CHECK_LEN * 4);
+
+	r->pack24(exp, samples, CHECK_LEN);
+	v->pack24(res, samples, CHECK_LEN);
+	fail |= memcmp(exp, res, CHECK_LEN * 3);
+
+	r->unpack24(exp, src + 1, CHECK_LEN);
+	v->unpack24(res, src + 1, CHECK_LEN);
+	fail |= memcmp(exp, res, CHECK_LEN * 4);
+
+	return fail;
+}
+
+/* Kernels are selected once, when the library is loaded, according to the
+ * instruction set extensions supported by the running CPU.
+ */
+__attribute__((constructor))
+static void select_ops(void)
+{
+	ops = avtp_cpu_select(variants, ARRAY_SIZE(variants), check_ops);
+}
+
+static size_t sample_size(enum avtp_aaf_pcm_sample type)
+{
+	return type == AVTP_AAF_PCM_SAMPLE_S16 ? sizeof(int16_t) :
+							sizeof(int32_t);
+}
+
+/* NaN has no integer value, so it is mapped to silence rather than left to
+ * whatever the conversion instruction yields.
+ */
+static int32_t float_to_s32(float val)
+{
+	if (val != val)
+		return 0;
+	if (val >= 1.0f)
+		return INT32_MAX;
+	if (val <= -1.0f)
+		return INT32_MIN;
+
+	return (int32_t) (val * S32_SCALE);
+}
+
+/* Convert host samples to 32-bit samples keeping the most significant bits. */
+static void to_s32(int32_t *dst, const void *src,
+				enum avtp_aaf_pcm_sample type, size_t n)
+{
+	size_t i;
+
+	switch (type) {
+	case AVTP_AAF_PCM_SAMPLE_S16: {
+		const int16_t *s = src;
+
+		for (i = 0; i < n; i++)
+			dst[i] = (int32_t) ((uint32_t) s[i] << 16);
+		break;
+	}
+	case AVTP_AAF_PCM_SAMPLE_S32:
+		memcpy(dst, src, n * sizeof(int32_t));
+		break;
+	case AVTP_AAF_PCM_SAMPLE_FLOAT: {
+		const float *s = src;
+
+		for (i = 0; i < n; i++)
+			dst[i] = float_to_s32(s[i]);
+		break;
+	}
+	}
+}
+
+static void from_s32(void *dst, const int32_t *src,
+				enum avtp_aaf_pcm_sample type, size_t n)
+{
+	size_t i;
+
+	switch (type) {
+	case AVTP_AAF_PCM_SAMPLE_S16: {
+		int16_t *d = dst;
+
+		for (i = 0; i < n; i++)
+			d[i] = src[i] >> 16;
+		break;
+	}
+	case AVTP_AAF_PCM_SAMPLE_S32:
+		memcpy(dst, src, n * sizeof(int32_t));
+		break;
+	case AVTP_AAF_PCM_SAMPLE_FLOAT: {
+		float *d = dst;
+
+		for (i = 0; i < n; i++)
+			d[i] = src[i] / S32_SCALE;
+		break;
+	}
+	}
+}
+
+static void to_float(float *dst, const void *src,
+				enum avtp_aaf_pcm_sample type, size_t n)
+{
+	size_t i;
+
+	switch (type) {
+	case AVTP_AAF_PCM_SAMPLE_S16: {
+		const int16_t *s = src;
+
+		for (i = 0; i < n; i++)
+			dst[i] = s[i] / 32768.0f;
+		break;
+	}
+	case AVTP_AAF_PCM_SAMPLE_S32: {
+		const int32_t *s = src;
+
+		for (i = 0; i < n; i++)
+			dst[i] = s[i] / S32_SCALE;
+		break;
+	}
+	case AVTP_AAF_PCM_SAMPLE_FLOAT:
+		memcpy(dst, src, n * sizeof(float));
+		break;
+	}
+}
+
+static void from_float(void *dst, const float *src,
+				enum avtp_aaf_pcm_sample type, size_t n)
+{
+	size_t i;
+
+	switch (type) {
+	case AVTP_AAF_PCM_SAMPLE_S16: {
+		int16_t *d = dst;
+
+		for (i = 0; i < n; i++)
+			d[i] = float_to_s32(src[i]) >> 16;
+		break;
+	}
+	case AVTP_AAF_PCM_SAMPLE_S32: {
+		int32_t *d = dst;
+
+		for (i = 0; i < n; i++)
+			d[i] = float_to_s32(src[i]);
+		break;
+	}
+	case AVTP_AAF_PCM_SAMPLE_FLOAT:
+		memcpy(dst, src, n * sizeof(float));
+		break;
+	}
+}
+
+/* Encode up to BLOCK_SIZE interleaved samples. */
+static void encode_block(void *dst, uint8_t format, uint8_t bit_depth,
+			const void *src, enum avtp_aaf_pcm_sample type,
+			size_t n)
+{
+	int32_t tmp[BLOCK_SIZE];
+	uint32_t mask;
+	size_t i;
+
+	/* Fast paths which don't need any conversion besides byte order. */
+	if (format == AVTP_AAF_FORMAT_FLOAT_32BIT &&
+					type == AVTP_AAF_PCM_SAMPLE_FLOAT) {
+		ops->bswap32(dst, src, n);
+		return;
+	}
+	if (format == AVTP_AAF_FORMAT_INT_16BIT && bit_depth == 16 &&
+					type == AVTP_AAF_PCM_SAMPLE_S16) {
+		ops->bswap16(dst, src, n);
+		return;
+	}
+	if (format == AVTP_AAF_FORMAT_INT_32BIT && bit_depth == 32 &&
+					type == AVTP_AAF_PCM_SAMPLE_S32) {
+		ops->bswap32(dst, src, n);
+		return;
+	}
+	if (format == AVTP_AAF_FORMAT_INT_24BIT && bit_depth == 24 &&
+					type == AVTP_AAF_PCM_SAMPLE_S32) {
+		ops->pack24(dst, src, n);
+		return;
+	}
+
+	if (format == AVTP_AAF_FORMAT_FLOAT_32BIT) {
+		float *ftmp = (float *) tmp;
+
+		to_float(ftmp, src, type, n);
+		ops->bswap32(dst, ftmp, n);
+		return;
+	}
+
+	to_s32(tmp, src, type, n);
+
+	mask = UINT32_MAX << (32 - bit_depth);
+	for (i = 0; i < n; i++)
+		tmp[i] &= mask;
+
+	switch (format) {
+	case AVTP_AAF_FORMAT_INT_32BIT:
+		ops->bswap32(dst, tmp, n);
+		break;
+	case AVTP_AAF_FORMAT_INT_24BIT:
+		ops->pack24(dst, tmp, n);
+		break;
+	case AVTP_AAF_FORMAT_INT_16BIT: {
+		int16_t *tmp16 = (int16_t *) tmp;
+
+		/* Narrowing in place is safe since each 16-bit sample is
+		 * written at or before the 32-bit one it is read from.
+		 */
+		for (i = 0; i < n; i++)
+			tmp16[i] = tmp[i] >> 16;
+		ops->bswap16(dst, tmp16, n);
+		break;
+	}
+	}
+}
+
+/* Decode up to BLOCK_SIZE interleaved samples. */
+static void decode_block(void *dst, enum avtp_aaf_pcm_sample type,
+			const void *src, uint8_t format, size_t n)
+{
+	int32_t tmp[BLOCK_SIZE];
+	size_t i;
+
+	if (format == AVTP_AAF_FORMAT_FLOAT_32BIT &&
+					type == AVTP_AAF_PCM_SAMPLE_FLOAT) {
+		ops->bswap32(dst, src, n);
+		return;
+	}
+	if (format == AVTP_AAF_FORMAT_INT_16BIT &&
+					type == AVTP_AAF_PCM_SAMPLE_S16) {
+		ops->bswap16(dst, src, n);
+		return;
+	}
+	if (format == AVTP_AAF_FORMAT_INT_32BIT &&
+					type == AVTP_AAF_PCM_SAMPLE_S32) {
+		ops->bswap32(dst, src, n);
+		return;
+	}
+	if (format == AVTP_AAF_FORMAT_INT_24BIT &&
+					type == AVTP_AAF_PCM_SAMPLE_S32) {
+		ops->unpack24(dst, src, n);
+		return;
+	}
+
+	switch (format) {
+	case AVTP_AAF_FORMAT_FLOAT_32BIT: {
+		float *ftmp = (float *) tmp;
+
+		ops->bswap32(ftmp, src, n);
+		from_float(dst, ftmp, type, n);
+		return;
+	}
+	case AVTP_AAF_FORMAT_INT_32BIT:
+		ops->bswap32(tmp, src, n);
+		break;
+	case AVTP_AAF_FORMAT_INT_24BIT:
+		ops->unpack24(tmp, src, n);
+		break;
+	case AVTP_AAF_FORMAT_INT_16BIT: {
+		int16_t *tmp16 = (int16_t *) tmp;
+
+		ops->bswap16(tmp16, src, n);
+
+		/* Widen in place from the end so no sample is overwritten
+		 * before it is read.
+		 */
+		for (i = n; i > 0; i--)
+			tmp[i - 1] = (int32_t) ((uint32_t) tmp16[i - 1] << 16);
+		break;
+	}
+	}
+
+	from_s32(dst, tmp, type, n);
+}
+
+/* Validate arguments and return the payload size, in bytes, or -EINVAL. */
+static int payload_size(const struct avtp_aaf_hdr *hdr,
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames)
+{
+	size_t width, samples;
+
+	if (!hdr || hdr->chan_per_frame == 0 ||
+					hdr->chan_per_frame > BLOCK_SIZE)
+		return -EINVAL;
+
+	switch (hdr->format) {
+	case AVTP_AAF_FORMAT_INT_16BIT:
+		width = 2;
+		break;
+	case AVTP_AAF_FORMAT_INT_24BIT:
+		width = 3;
+		break;
+	case AVTP_AAF_FORMAT_INT_32BIT:
+	case AVTP_AAF_FORMAT_FLOAT_32BIT:
+		width = 4;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (hdr->bit_depth == 0 || hdr->bit_depth > width * 8)
+		return -EINVAL;
+	if (hdr->format == AVTP_AAF_FORMAT_FLOAT_32BIT && hdr->bit_depth != 32)
+		return -EINVAL;
+
+	switch (type) {
+	case AVTP_AAF_PCM_SAMPLE_S16:
+	case AVTP_AAF_PCM_SAMPLE_S32:
+	case AVTP_AAF_PCM_SAMPLE_FLOAT:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	samples = (size_t) frames * hdr->chan_per_frame;
+	if (samples > INT_MAX / width)
+		return -EINVAL;
+
+	return samples * width;
+}
+
+static size_t payload_width(uint8_t format)
+{
+	switch (format) {
+	case AVTP_AAF_FORMAT_INT_16BIT:
+		return 2;
+	case AVTP_AAF_FORMAT_INT_24BIT:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+int avtp_aaf_pcm_encode(const struct avtp_aaf_hdr *hdr, void *payload,
+				const void *samples,
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames)
+{
+	size_t i, n, total, width, ssize;
+	int size;
+
+	size = payload_size(hdr, type, frames);
+	if (size < 0 || !payload || !samples)
+		return -EINVAL;
+
+	width = payload_width(hdr->format);
+	ssize = sample_size(type);
+	total = (size_t) frames * hdr->chan_per_frame;
+
+	for (i = 0; i < total; i += n) {
+		n = total - i < BLOCK_SIZE ? total - i : BLOCK_SIZE;
+
+		encode_block((uint8_t *) payload + i * width, hdr->format,
+					hdr->bit_depth,
+					(const uint8_t *) samples + i * ssize,
+					type, n);
+	}
+
+	return size;
+}
+
+int avtp_aaf_pcm_encode_planar(const struct avtp_aaf_hdr *hdr, void *payload,
+				const void *const planes[],
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames)
+{
+	int32_t tmp[BLOCK_SIZE];
+	size_t f, n, ch, chans, width, ssize, block_frames;
+	int size;
+
+	size = payload_size(hdr, type, frames);
+	if (size < 0 || !payload || !planes)
+		return -EINVAL;
+
+	chans = hdr->chan_per_frame;
+	for (ch = 0; ch < chans; ch++) {
+		if (!planes[ch])
+			return -EINVAL;
+	}
+
+	width = payload_width(hdr->format);
+	ssize = sample_size(type);
+	block_frames = BLOCK_SIZE / chans;
+
+	for (f = 0; f < frames; f += n) {
+		uint8_t *t = (uint8_t *) tmp;
+		size_t i;
+
+		n = frames - f < block_frames ? frames - f : block_frames;
+
+		/* Interleave channels into host order block first. */
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < chans; ch++) {
+				const uint8_t *p = planes[ch];
+
+				memcpy(t, p + (f + i) * ssize, ssize);
+				t += ssize;
+			}
+		}
+
+		encode_block((uint8_t *) payload + f * chans * width,
+					hdr->format, hdr->bit_depth, tmp,
+					type, n * chans);
+	}
+
+	return size;
+}
+
+int avtp_aaf_pcm_decode(const struct avtp_aaf_hdr *hdr, const void *payload,
+				void *samples, enum avtp_aaf_pcm_sample type,
+				unsigned int frames)
+{
+	size_t i, n, total, width, ssize;
+	int size;
+
+	size = payload_size(hdr, type, frames);
+	if (size < 0 || !payload || !samples)
+		return -EINVAL;
+
+	width = payload_width(hdr->format);
+	ssize = sample_size(type);
+	total = (size_t) frames * hdr->chan_per_frame;
+
+	for (i = 0; i < total; i += n) {
+		n = total - i < BLOCK_SIZE ? total - i : BLOCK_SIZE;
+
+		decode_block((uint8_t *) samples + i * ssize, type,
+				(const uint8_t *) payload + i * width,
+				hdr->format, n);
+	}
+
+	return size;
+}
+
+int avtp_aaf_pcm_decode_planar(const struct avtp_aaf_hdr *hdr,
+				const void *payload, void *const planes[],
+				enum avtp_aaf_pcm_sample type,
+				unsigned int frames)
+{
+	int32_t tmp[BLOCK_SIZE];
+	size_t f, n, ch, chans, width, ssize, block_frames;
+	int size;
+
+	size = payload_size(hdr, type, frames);
+	if (size < 0 || !payload || !planes)
+		return -EINVAL;
+
+	chans = hdr->chan_per_frame;
+	for (ch = 0; ch < chans; ch++) {
+		if (!planes[ch])
+			return -EINVAL;
+	}
+
+	width = payload_width(hdr->format);
+	ssize = sample_size(type);
+	block_frames = BLOCK_SIZE / chans;
+
+	for (f = 0; f < frames; f += n) {
+		const uint8_t *t = (const uint8_t *) tmp;
+		size_t i;
+
+		n = frames - f < block_frames ? frames - f : block_frames;
+
+		decode_block(tmp, type,
+				(const uint8_t *) payload + f * chans * width,
+				hdr->format, n * chans);
+
+		/* De-interleave host order block into channels. */
+		for (i = 0; i < n; i++) {
+			for (ch = 0; ch < chans; ch++) {
+				uint8_t *p = planes[ch];
+
+				memcpy(p + (f + i) * ssize, t, ssize);
+				t += ssize;
+			}
+		}
+	}
+
+	return size;
+}
+
+int avtp_aaf_aggregator_init(struct avtp_aaf_aggregator *agg,
+				struct avtp_stream_ctx *ctx,
+				enum avtp_aaf_pcm_sample type)
+{
+	struct avtp_aaf_hdr hdr;
+	size_t frame_len;
+	int res;
+
+	if (!agg || !ctx)
+		return -EINVAL;
+
+	res = avtp_aaf_pdu_unpack(&ctx->tmpl, &hdr);
+	if (res < 0)
+		return res;
+
+	res = payload_size(&hdr, type, 1);
+	if (res < 0)
+		return res;
+
+	frame_len = res;
+	if (hdr.stream.stream_data_len == 0 ||
+			hdr.stream.stream_data_len % frame_len ||
+			hdr.stream.stream_data_len >
+					AVTP_AAF_AGGREGATOR_MAX_DATA_LEN)
+		return -EINVAL;
+
+	memset(agg, 0, sizeof(*agg));
+	agg->ctx = ctx;
+	agg->hdr = hdr;
+	agg->type = type;
+	agg->frames_per_pdu = hdr.stream.stream_data_len / frame_len;
+	agg->frame_size = sample_size(type) * hdr.chan_per_frame;
+	agg->payload_frame_size = frame_len;
+
+	return 0;
+}
+
+int avtp_aaf_aggregator_start(struct avtp_aaf_aggregator *agg,
+				const void *samples, unsigned int frames)
+{
+	if (!agg || (!samples && frames))
+		return -EINVAL;
+
+	agg->next = samples;
+	agg->frames = frames;
+
+	return 0;
+}
+
+/* Move 'frames' frames from the current block into payload 'dst'. */
+static void aggregator_take(struct avtp_aaf_aggregator *agg, uint8_t *dst,
+							unsigned int frames)
+{
+	avtp_aaf_pcm_encode(&agg->hdr, dst, agg->next, agg->type, frames);
+
+	agg->next += (size_t) frames * agg->frame_size;
+	agg->frames -= frames;
+}
+
+int avtp_aaf_aggregator_next(struct avtp_aaf_aggregator *agg,
+				struct avtp_stream_pdu *pdu)
+{
+	unsigned int needed;
+
+	if (!agg || !pdu)
+		return -EINVAL;
+
+	needed = agg->frames_per_pdu - agg->pending;
+
+	if (agg->frames < needed) {
+		unsigned int left = agg->frames;
+
+		/* Keep leftover frames, already encoded, for next block. */
+		if (left) {
+			aggregator_take(agg, agg->partial + agg->pending *
+						agg->payload_frame_size, left);
+			agg->pending += left;
+		}
+
+		return 0;
+	}
+
+	if (agg->pending) {
+		aggregator_take(agg, agg->partial + agg->pending *
+					agg->payload_frame_size, needed);
+		memcpy(pdu->avtp_payload, agg->partial,
+					agg->hdr.stream.stream_data_len);
+		agg->pending = 0;
+	} else {
+		aggregator_take(agg, pdu->avtp_payload, needed);
+	}
+
+	avtp_stream_ctx_emit(agg->ctx, pdu, agg->frames_per_pdu);
+
+	return 1;
+}
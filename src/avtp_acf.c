@@ -0,0 +1,705 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_acf.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
+#include "avtp_tscf.h"
+#include "util.h"
+
+/* ACF message header, 'acf_msg_info' word. */
+#define SHIFT_MSG_TYPE			(31 - 6)
+#define SHIFT_MSG_LENGTH		(31 - 15)
+#define SHIFT_PAD			(31 - 17)
+#define SHIFT_MTV			(31 - 18)
+#define SHIFT_RTR			(31 - 19)
+#define SHIFT_EFF			(31 - 20)
+#define SHIFT_BRS			(31 - 21)
+#define SHIFT_FDF			(31 - 22)
+#define SHIFT_ESI			(31 - 23)
+#define SHIFT_CAN_BUS_ID		(31 - 31)
+#define SHIFT_LIN_BUS_ID		(31 - 23)
+#define SHIFT_LIN_IDENTIFIER		(31 - 31)
+
+#define MASK_MSG_TYPE			(BITMASK(7) << SHIFT_MSG_TYPE)
+#define MASK_MSG_LENGTH			(BITMASK(9) << SHIFT_MSG_LENGTH)
+#define MASK_PAD			(BITMASK(2) << SHIFT_PAD)
+#define MASK_MTV			(BITMASK(1) << SHIFT_MTV)
+#define MASK_RTR			(BITMASK(1) << SHIFT_RTR)
+#define MASK_EFF			(BITMASK(1) << SHIFT_EFF)
+#define MASK_BRS			(BITMASK(1) << SHIFT_BRS)
+#define MASK_FDF			(BITMASK(1) << SHIFT_FDF)
+#define MASK_ESI			(BITMASK(1) << SHIFT_ESI)
+#define MASK_CAN_BUS_ID			(BITMASK(5) << SHIFT_CAN_BUS_ID)
+#define MASK_LIN_BUS_ID			(BITMASK(5) << SHIFT_LIN_BUS_ID)
+#define MASK_LIN_IDENTIFIER		(BITMASK(8) << SHIFT_LIN_IDENTIFIER)
+#define MASK_CAN_IDENTIFIER		(BITMASK(29))
+
+#define QUADLET_LEN			4
+#define QUADLET_ALIGN(len)		(((len) + QUADLET_LEN - 1) & \
+						~(size_t) (QUADLET_LEN - 1))
+
+#define ACF_MSG_FIELD(type, field)					\
+	[AVTP_ACF_FIELD_##field] = AVTP_FIELD(type, acf_msg_info,	\
+						MASK_##field)
+
+#define CAN_FIELD(type, field, word, mask)				\
+	[AVTP_ACF_CAN_FIELD_##field] = AVTP_FIELD(type, word, mask)
+
+#define CAN_INFO_FIELD(type, field)					\
+	CAN_FIELD(type, field, acf_msg_info, MASK_##field)
+
+#define LIN_FIELD(field, word, mask)					\
+	[AVTP_ACF_LIN_FIELD_##field] = AVTP_FIELD(struct avtp_acf_lin_msg, \
+						word, mask)
+
+static const struct avtp_field_desc msg_fields[AVTP_ACF_FIELD_MAX] = {
+	ACF_MSG_FIELD(struct avtp_acf_msg, MSG_TYPE),
+	ACF_MSG_FIELD(struct avtp_acf_msg, MSG_LENGTH),
+};
+
+static const struct avtp_field_desc can_fields[AVTP_ACF_CAN_FIELD_MAX] = {
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, MSG_TYPE),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, MSG_LENGTH),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, PAD),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, MTV),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, RTR),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, EFF),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, BRS),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, FDF),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, ESI),
+	CAN_INFO_FIELD(struct avtp_acf_can_msg, CAN_BUS_ID),
+	CAN_FIELD(struct avtp_acf_can_msg, MESSAGE_TIMESTAMP,
+					message_timestamp, UINT64_MAX),
+	CAN_FIELD(struct avtp_acf_can_msg, CAN_IDENTIFIER,
+					can_identifier, MASK_CAN_IDENTIFIER),
+};
+
+/* ACF CAN Brief messages have no 'message_timestamp', so its entry is left
+ * empty.
+ */
+static const struct avtp_field_desc can_brief_fields[AVTP_ACF_CAN_FIELD_MAX] = {
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, MSG_TYPE),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, MSG_LENGTH),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, PAD),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, MTV),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, RTR),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, EFF),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, BRS),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, FDF),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, ESI),
+	CAN_INFO_FIELD(struct avtp_acf_can_brief_msg, CAN_BUS_ID),
+	CAN_FIELD(struct avtp_acf_can_brief_msg, CAN_IDENTIFIER,
+					can_identifier, MASK_CAN_IDENTIFIER),
+};
+
+static const struct avtp_field_desc lin_fields[AVTP_ACF_LIN_FIELD_MAX] = {
+	LIN_FIELD(MSG_TYPE, acf_msg_info, MASK_MSG_TYPE),
+	LIN_FIELD(MSG_LENGTH, acf_msg_info, MASK_MSG_LENGTH),
+	LIN_FIELD(PAD, acf_msg_info, MASK_PAD),
+	LIN_FIELD(MTV, acf_msg_info, MASK_MTV),
+	LIN_FIELD(LIN_BUS_ID, acf_msg_info, MASK_LIN_BUS_ID),
+	LIN_FIELD(LIN_IDENTIFIER, acf_msg_info, MASK_LIN_IDENTIFIER),
+	LIN_FIELD(MESSAGE_TIMESTAMP, message_timestamp, UINT64_MAX),
+};
+
+static uint8_t get_msg_type(const struct avtp_acf_msg *msg)
+{
+	return BITMAP_GET_VALUE(get_unaligned_be32(msg), MASK_MSG_TYPE,
+							SHIFT_MSG_TYPE);
+}
+
+static size_t get_msg_len(const struct avtp_acf_msg *msg)
+{
+	return BITMAP_GET_VALUE(get_unaligned_be32(msg), MASK_MSG_LENGTH,
+					SHIFT_MSG_LENGTH) * QUADLET_LEN;
+}
+
+static const struct avtp_field_desc *get_can_fields(
+						const struct avtp_acf_msg *msg)
+{
+	switch (get_msg_type(msg)) {
+	case AVTP_ACF_TYPE_CAN:
+		return can_fields;
+	case AVTP_ACF_TYPE_CAN_BRIEF:
+		return can_brief_fields;
+	default:
+		return NULL;
+	}
+}
+
+/* Build 'acf_msg_info' word bits shared by all messages. */
+static uint32_t msg_info(uint8_t type, size_t msg_len, size_t pad)
+{
+	uint32_t info = 0;
+
+	BITMAP_SET_VALUE(info, (uint32_t) type, MASK_MSG_TYPE, SHIFT_MSG_TYPE);
+	BITMAP_SET_VALUE(info, (uint32_t) (msg_len / QUADLET_LEN),
+					MASK_MSG_LENGTH, SHIFT_MSG_LENGTH);
+	BITMAP_SET_VALUE(info, (uint32_t) pad, MASK_PAD, SHIFT_PAD);
+
+	return info;
+}
+
+static bool can_data_len_valid(bool fdf, size_t len)
+{
+	if (len <= AVTP_ACF_CAN_MAX_DATA_LEN)
+		return true;
+
+	if (!fdf)
+		return false;
+
+	switch (len) {
+	case 12:
+	case 16:
+	case 20:
+	case 24:
+	case 32:
+	case 48:
+	case 64:
+		return true;
+	default:
+		return false;
+	}
+}
+
+int avtp_acf_msg_get(const struct avtp_acf_msg *msg, enum avtp_acf_field field,
+								uint64_t *val)
+{
+	if (!msg || !val)
+		return -EINVAL;
+
+	return avtp_field_get(msg_fields, ARRAY_SIZE(msg_fields), msg, field,
+									val);
+}
+
+int avtp_acf_msg_set(struct avtp_acf_msg *msg, enum avtp_acf_field field,
+								uint64_t val)
+{
+	if (!msg)
+		return -EINVAL;
+
+	return avtp_field_set(msg_fields, ARRAY_SIZE(msg_fields), msg, field,
+									val);
+}
+
+int avtp_acf_can_get(const struct avtp_acf_msg *msg,
+				enum avtp_acf_can_field field, uint64_t *val)
+{
+	const struct avtp_field_desc *fields;
+
+	if (!msg || !val)
+		return -EINVAL;
+
+	fields = get_can_fields(msg);
+	if (!fields)
+		return -EINVAL;
+
+	return avtp_field_get(fields, AVTP_ACF_CAN_FIELD_MAX, msg, field, val);
+}
+
+int avtp_acf_can_set(struct avtp_acf_msg *msg, enum avtp_acf_can_field field,
+								uint64_t val)
+{
+	const struct avtp_field_desc *fields;
+
+	if (!msg)
+		return -EINVAL;
+
+	fields = get_can_fields(msg);
+	if (!fields)
+		return -EINVAL;
+
+	return avtp_field_set(fields, AVTP_ACF_CAN_FIELD_MAX, msg, field, val);
+}
+
+int avtp_acf_lin_get(const struct avtp_acf_msg *msg,
+				enum avtp_acf_lin_field field, uint64_t *val)
+{
+	if (!msg || !val || get_msg_type(msg) != AVTP_ACF_TYPE_LIN)
+		return -EINVAL;
+
+	return avtp_field_get(lin_fields, ARRAY_SIZE(lin_fields), msg, field,
+									val);
+}
+
+int avtp_acf_lin_set(struct avtp_acf_msg *msg, enum avtp_acf_lin_field field,
+								uint64_t val)
+{
+	if (!msg || get_msg_type(msg) != AVTP_ACF_TYPE_LIN)
+		return -EINVAL;
+
+	return avtp_field_set(lin_fields, ARRAY_SIZE(lin_fields), msg, field,
+									val);
+}
+
+int avtp_acf_can_pack(struct avtp_acf_msg *msg, size_t size,
+				const struct avtp_acf_can_hdr *hdr,
+				const void *data, size_t len)
+{
+	size_t hdr_len, msg_len, pad;
+	uint32_t info;
+	uint8_t *payload;
+
+	if (!msg || !hdr || (!data && len) ||
+				!can_data_len_valid(hdr->fdf, len))
+		return -EINVAL;
+
+	hdr_len = hdr->brief ? sizeof(struct avtp_acf_can_brief_msg) :
+					sizeof(struct avtp_acf_can_msg);
+	msg_len = QUADLET_ALIGN(hdr_len + len);
+	pad = msg_len - hdr_len - len;
+
+	if (msg_len > size)
+		return -ENOSPC;
+
+	info = msg_info(hdr->brief ? AVTP_ACF_TYPE_CAN_BRIEF :
+					AVTP_ACF_TYPE_CAN, msg_len, pad);
+	BITMAP_SET_VALUE(info, hdr->mtv, MASK_MTV, SHIFT_MTV);
+	BITMAP_SET_VALUE(info, hdr->rtr, MASK_RTR, SHIFT_RTR);
+	BITMAP_SET_VALUE(info, hdr->eff, MASK_EFF, SHIFT_EFF);
+	BITMAP_SET_VALUE(info, hdr->brs, MASK_BRS, SHIFT_BRS);
+	BITMAP_SET_VALUE(info, hdr->fdf, MASK_FDF, SHIFT_FDF);
+	BITMAP_SET_VALUE(info, hdr->esi, MASK_ESI, SHIFT_ESI);
+	BITMAP_SET_VALUE(info, hdr->can_bus_id, MASK_CAN_BUS_ID, 0);
+
+	put_unaligned_be32(info, &msg->acf_msg_info);
+
+	if (hdr->brief) {
+		struct avtp_acf_can_brief_msg *can =
+				(struct avtp_acf_can_brief_msg *) msg;
+
+		put_unaligned_be32(hdr->can_identifier & MASK_CAN_IDENTIFIER,
+							&can->can_identifier);
+		payload = can->can_msg_payload;
+	} else {
+		struct avtp_acf_can_msg *can = (struct avtp_acf_can_msg *) msg;
+
+		put_unaligned_be64(hdr->message_timestamp,
+						&can->message_timestamp);
+		put_unaligned_be32(hdr->can_identifier & MASK_CAN_IDENTIFIER,
+							&can->can_identifier);
+		payload = can->can_msg_payload;
+	}
+
+	if (len)
+		memcpy(payload, data, len);
+	memset(payload + len, 0, pad);
+
+	return msg_len;
+}
+
+int avtp_acf_can_unpack(const struct avtp_acf_msg *msg, size_t len,
+				struct avtp_acf_can_hdr *hdr,
+				const uint8_t **data, size_t *data_len)
+{
+	size_t hdr_len, msg_len, pad;
+	uint32_t info;
+
+	if (!msg || !hdr || !data || !data_len ||
+					len < sizeof(struct avtp_acf_msg))
+		return -EINVAL;
+
+	info = get_unaligned_be32(&msg->acf_msg_info);
+
+	switch (BITMAP_GET_VALUE(info, MASK_MSG_TYPE, SHIFT_MSG_TYPE)) {
+	case AVTP_ACF_TYPE_CAN:
+		hdr_len = sizeof(struct avtp_acf_can_msg);
+		break;
+	case AVTP_ACF_TYPE_CAN_BRIEF:
+		hdr_len = sizeof(struct avtp_acf_can_brief_msg);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	msg_len = get_msg_len(msg);
+	pad = BITMAP_GET_VALUE(info, MASK_PAD, SHIFT_PAD);
+
+	if (msg_len > len || msg_len < hdr_len + pad)
+		return -EINVAL;
+
+	hdr->brief = hdr_len == sizeof(struct avtp_acf_can_brief_msg);
+	hdr->mtv = BITMAP_GET_VALUE(info, MASK_MTV, SHIFT_MTV);
+	hdr->rtr = BITMAP_GET_VALUE(info, MASK_RTR, SHIFT_RTR);
+	hdr->eff = BITMAP_GET_VALUE(info, MASK_EFF, SHIFT_EFF);
+	hdr->brs = BITMAP_GET_VALUE(info, MASK_BRS, SHIFT_BRS);
+	hdr->fdf = BITMAP_GET_VALUE(info, MASK_FDF, SHIFT_FDF);
+	hdr->esi = BITMAP_GET_VALUE(info, MASK_ESI, SHIFT_ESI);
+	hdr->can_bus_id = BITMAP_GET_VALUE(info, MASK_CAN_BUS_ID, 0);
+
+	if (hdr->brief) {
+		const struct avtp_acf_can_brief_msg *can =
+			(const struct avtp_acf_can_brief_msg *) msg;
+
+		hdr->message_timestamp = 0;
+		hdr->can_identifier = get_unaligned_be32(&can->can_identifier) &
+							MASK_CAN_IDENTIFIER;
+	} else {
+		const struct avtp_acf_can_msg *can =
+			(const struct avtp_acf_can_msg *) msg;
+
+		hdr->message_timestamp =
+			get_unaligned_be64(&can->message_timestamp);
+		hdr->can_identifier = get_unaligned_be32(&can->can_identifier) &
+							MASK_CAN_IDENTIFIER;
+	}
+
+	*data = (const uint8_t *) msg + hdr_len;
+	*data_len = msg_len - hdr_len - pad;
+
+	return 0;
+}
+
+int avtp_acf_lin_pack(struct avtp_acf_msg *msg, size_t size,
+				const struct avtp_acf_lin_hdr *hdr,
+				const void *data, size_t len)
+{
+	struct avtp_acf_lin_msg *lin = (struct avtp_acf_lin_msg *) msg;
+	size_t msg_len, pad;
+	uint32_t info;
+
+	if (!msg || !hdr || (!data && len) || len > AVTP_ACF_LIN_MAX_DATA_LEN)
+		return -EINVAL;
+
+	msg_len = QUADLET_ALIGN(sizeof(struct avtp_acf_lin_msg) + len);
+	pad = msg_len - sizeof(struct avtp_acf_lin_msg) - len;
+
+	if (msg_len > size)
+		return -ENOSPC;
+
+	info = msg_info(AVTP_ACF_TYPE_LIN, msg_len, pad);
+	BITMAP_SET_VALUE(info, hdr->mtv, MASK_MTV, SHIFT_MTV);
+	BITMAP_SET_VALUE(info, hdr->lin_bus_id, MASK_LIN_BUS_ID,
+							SHIFT_LIN_BUS_ID);
+	BITMAP_SET_VALUE(info, hdr->lin_identifier, MASK_LIN_IDENTIFIER, 0);
+
+	put_unaligned_be32(info, &lin->acf_msg_info);
+	put_unaligned_be64(hdr->message_timestamp, &lin->message_timestamp);
+
+	if (len)
+		memcpy(lin->lin_msg_payload, data, len);
+	memset(lin->lin_msg_payload + len, 0, pad);
+
+	return msg_len;
+}
+
+int avtp_acf_lin_unpack(const struct avtp_acf_msg *msg, size_t len,
+				struct avtp_acf_lin_hdr *hdr,
+				const uint8_t **data, size_t *data_len)
+{
+	const struct avtp_acf_lin_msg *lin =
+				(const struct avtp_acf_lin_msg *) msg;
+	size_t msg_len, pad;
+	uint32_t info;
+
+	if (!msg || !hdr || !data || !data_len ||
+					len < sizeof(struct avtp_acf_msg))
+		return -EINVAL;
+
+	info = get_unaligned_be32(&msg->acf_msg_info);
+	if (BITMAP_GET_VALUE(info, MASK_MSG_TYPE, SHIFT_MSG_TYPE) !=
+							AVTP_ACF_TYPE_LIN)
+		return -EINVAL;
+
+	msg_len = get_msg_len(msg);
+	pad = BITMAP_GET_VALUE(info, MASK_PAD, SHIFT_PAD);
+
+	if (msg_len > len || msg_len < sizeof(struct avtp_acf_lin_msg) + pad)
+		return -EINVAL;
+
+	hdr->mtv = BITMAP_GET_VALUE(info, MASK_MTV, SHIFT_MTV);
+	hdr->lin_bus_id = BITMAP_GET_VALUE(info, MASK_LIN_BUS_ID,
+							SHIFT_LIN_BUS_ID);
+	hdr->lin_identifier = BITMAP_GET_VALUE(info, MASK_LIN_IDENTIFIER, 0);
+	hdr->message_timestamp = get_unaligned_be64(&lin->message_timestamp);
+
+	*data = lin->lin_msg_payload;
+	*data_len = msg_len - sizeof(struct avtp_acf_lin_msg) - pad;
+
+	return 0;
+}
+
+int avtp_acf_iter_init(struct avtp_acf_iter *iter, const void *pdu,
+								size_t len)
+{
+	size_t hdr_len, data_len;
+
+	if (!iter || !pdu || len < sizeof(struct avtp_common_pdu))
+		return -EINVAL;
+
+	switch (avtp_common_get_subtype(pdu)) {
+	case AVTP_SUBTYPE_TSCF:
+		hdr_len = sizeof(struct avtp_stream_pdu);
+		if (len < hdr_len)
+			return -EINVAL;
+		data_len = avtp_stream_get_stream_data_len(pdu);
+		break;
+	case AVTP_SUBTYPE_NTSCF:
+		hdr_len = sizeof(struct avtp_ntscf_pdu);
+		if (len < hdr_len)
+			return -EINVAL;
+		data_len = avtp_ntscf_get_data_len(pdu);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (data_len > len - hdr_len)
+		return -EINVAL;
+
+	iter->next = (const uint8_t *) pdu + hdr_len;
+	iter->end = iter->next + data_len;
+
+	return 0;
+}
+
+int avtp_acf_iter_next(struct avtp_acf_iter *iter,
+				const struct avtp_acf_msg **msg, size_t *len)
+{
+	size_t left, msg_len = 0;
+
+	if (!iter || !msg || !len)
+		return -EINVAL;
+
+	left = iter->end - iter->next;
+	if (!left)
+		return 0;
+
+	if (left >= sizeof(struct avtp_acf_msg))
+		msg_len = get_msg_len((const struct avtp_acf_msg *) iter->next);
+
+	if (!msg_len || msg_len > left) {
+		iter->next = iter->end;
+		return -EINVAL;
+	}
+
+	*msg = (const struct avtp_acf_msg *) iter->next;
+	*len = msg_len;
+	iter->next += msg_len;
+
+	return 1;
+}
+
+int avtp_acf_agg_init(struct avtp_acf_agg *agg, const void *tmpl,
+				size_t max_pdu_size, uint64_t max_latency)
+{
+	size_t hdr_len, max_data_len;
+	uint8_t seq_num;
+
+	if (!agg || !tmpl)
+		return -EINVAL;
+
+	switch (avtp_common_get_subtype(tmpl)) {
+	case AVTP_SUBTYPE_TSCF:
+		hdr_len = sizeof(struct avtp_stream_pdu);
+		max_data_len = UINT16_MAX;
+		seq_num = avtp_stream_get_seq_num(tmpl);
+		break;
+	case AVTP_SUBTYPE_NTSCF:
+		hdr_len = sizeof(struct avtp_ntscf_pdu);
+		max_data_len = AVTP_NTSCF_MAX_DATA_LEN;
+		seq_num = avtp_ntscf_get_seq_num(tmpl);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (max_pdu_size < hdr_len + sizeof(struct avtp_acf_msg))
+		return -EINVAL;
+
+	memset(agg, 0, sizeof(*agg));
+	memcpy(agg->tmpl, tmpl, hdr_len);
+	agg->hdr_len = hdr_len;
+	agg->max_pdu_size = hdr_len + max_data_len;
+	if (max_pdu_size < agg->max_pdu_size)
+		agg->max_pdu_size = max_pdu_size;
+	agg->max_latency = max_latency;
+	agg->seq_num = seq_num;
+
+	return 0;
+}
+
+int avtp_acf_agg_start(struct avtp_acf_agg *agg, void *pdu, size_t size)
+{
+	if (!agg || !pdu || !agg->hdr_len ||
+			size < agg->hdr_len + sizeof(struct avtp_acf_msg))
+		return -EINVAL;
+
+	if (size > agg->max_pdu_size)
+		size = agg->max_pdu_size;
+
+	agg->pdu = pdu;
+	agg->limit = size - agg->hdr_len;
+	agg->len = 0;
+	agg->full = false;
+
+	return 0;
+}
+
+/* Get room left for messages in the PDU being built. */
+static struct avtp_acf_msg *agg_room(struct avtp_acf_agg *agg, size_t *size)
+{
+	*size = agg->limit - agg->len;
+
+	return (struct avtp_acf_msg *) (agg->pdu + agg->hdr_len + agg->len);
+}
+
+/* Account for message of 'res' bytes just built in the PDU, or for the error
+ * returned while building it.
+ */
+static int agg_commit(struct avtp_acf_agg *agg, int res, uint64_t now)
+{
+	if (res == -ENOSPC) {
+		/* A message which doesn't fit in an empty PDU never will. */
+		if (!agg->len)
+			return -EINVAL;
+
+		agg->full = true;
+	}
+
+	if (res < 0)
+		return res;
+
+	if (!agg->len) {
+		if (agg->max_latency > UINT64_MAX - now)
+			agg->deadline = UINT64_MAX;
+		else
+			agg->deadline = now + agg->max_latency;
+	}
+
+	agg->len += res;
+	if (agg->limit - agg->len < sizeof(struct avtp_acf_msg))
+		agg->full = true;
+
+	return 0;
+}
+
+int avtp_acf_agg_add_can(struct avtp_acf_agg *agg,
+				const struct avtp_acf_can_hdr *hdr,
+				const void *data, size_t len, uint64_t now)
+{
+	struct avtp_acf_msg *msg;
+	size_t size;
+	int res;
+
+	if (!agg || !agg->pdu)
+		return -EINVAL;
+
+	msg = agg_room(agg, &size);
+	res = avtp_acf_can_pack(msg, size, hdr, data, len);
+
+	return agg_commit(agg, res, now);
+}
+
+int avtp_acf_agg_add_lin(struct avtp_acf_agg *agg,
+				const struct avtp_acf_lin_hdr *hdr,
+				const void *data, size_t len, uint64_t now)
+{
+	struct avtp_acf_msg *msg;
+	size_t size;
+	int res;
+
+	if (!agg || !agg->pdu)
+		return -EINVAL;
+
+	msg = agg_room(agg, &size);
+	res = avtp_acf_lin_pack(msg, size, hdr, data, len);
+
+	return agg_commit(agg, res, now);
+}
+
+int avtp_acf_agg_add(struct avtp_acf_agg *agg, const struct avtp_acf_msg *msg,
+						size_t len, uint64_t now)
+{
+	struct avtp_acf_msg *room;
+	size_t size;
+	int res;
+
+	if (!agg || !agg->pdu || !msg || len < sizeof(struct avtp_acf_msg) ||
+						len != get_msg_len(msg))
+		return -EINVAL;
+
+	room = agg_room(agg, &size);
+	if (len > size) {
+		res = -ENOSPC;
+	} else {
+		memcpy(room, msg, len);
+		res = len;
+	}
+
+	return agg_commit(agg, res, now);
+}
+
+bool avtp_acf_agg_due(const struct avtp_acf_agg *agg, uint64_t now)
+{
+	if (!agg || !agg->pdu || !agg->len)
+		return false;
+
+	return agg->full || now >= agg->deadline;
+}
+
+int avtp_acf_agg_finish(struct avtp_acf_agg *agg, uint32_t avtp_time)
+{
+	int res;
+
+	if (!agg || !agg->pdu)
+		return -EINVAL;
+
+	if (!agg->len)
+		return 0;
+
+	if (agg->hdr_len == sizeof(struct avtp_stream_pdu)) {
+		res = avtp_stream_pdu_emit((struct avtp_stream_pdu *) agg->pdu,
+				(const struct avtp_stream_pdu *) agg->tmpl,
+				agg->seq_num, avtp_time, agg->len);
+		if (res < 0)
+			return res;
+	} else {
+		struct avtp_ntscf_pdu *pdu = (struct avtp_ntscf_pdu *) agg->pdu;
+
+		memcpy(pdu, agg->tmpl, sizeof(struct avtp_ntscf_pdu));
+		avtp_ntscf_set_seq_num(pdu, agg->seq_num);
+		avtp_ntscf_set_data_len(pdu, agg->len);
+	}
+
+	res = agg->hdr_len + agg->len;
+
+	agg->seq_num++;
+	agg->pdu = NULL;
+	agg->len = 0;
+	agg->full = false;
+
+	return res;
+}
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "avtp.h"
+#include "avtp_classifier.h"
+#include "avtp_inline.h"
+#include "util.h"
+
+/* PDUs are classified in batches so the header words compare loop runs over
+ * contiguous arrays and can be vectorized by the compiler.
+ */
+#define BATCH_SIZE			32
+
+/* Header words compared by the classifier, in this order. */
+#define WORD_SUBTYPE_DATA		0
+#define WORD_FORMAT_SPECIFIC		1
+#define WORD_PACKET_INFO		2
+#define NUM_WORDS			3
+
+#define EMPTY_SLOT			-1
+
+#define DEFAULT_MASK			(AVTP_COMMON_MASK_SUBTYPE | \
+					AVTP_COMMON_MASK_VERSION | \
+					AVTP_STREAM_MASK_SV)
+
+/* Golden ratio constant used for multiplicative hashing. */
+#define HASH_MULTIPLIER			0x9E3779B97F4A7C15ULL
+
+struct stream {
+	/* Words are kept in network order so received PDUs don't need to be
+	 * byte swapped before comparing them.
+	 */
+	uint32_t expected[NUM_WORDS];
+	uint32_t mask[NUM_WORDS];
+	uint8_t next_seq;
+	bool seq_valid;
+};
+
+struct slot {
+	/* Network order, as found in the PDU. */
+	uint64_t stream_id;
+	int stream;
+};
+
+struct avtp_classifier {
+	struct slot *slots;
+	unsigned int slot_bits;
+	struct stream *streams;
+	unsigned int num_streams;
+	unsigned int max_streams;
+};
+
+static unsigned int hash(const struct avtp_classifier *cls, uint64_t stream_id)
+{
+	return (stream_id * HASH_MULTIPLIER) >> (64 - cls->slot_bits);
+}
+
+static int lookup(const struct avtp_classifier *cls, uint64_t stream_id)
+{
+	unsigned int mask = BITMASK(cls->slot_bits);
+	unsigned int i = hash(cls, stream_id);
+
+	/* Table is never more than half full so this always terminates. */
+	while (cls->slots[i].stream != EMPTY_SLOT) {
+		if (cls->slots[i].stream_id == stream_id)
+			return cls->slots[i].stream;
+
+		i = (i + 1) & mask;
+	}
+
+	return EMPTY_SLOT;
+}
+
+int avtp_classifier_create(struct avtp_classifier **cls,
+						unsigned int max_streams)
+{
+	struct avtp_classifier *c;
+	unsigned int i, slot_bits = 1;
+
+	if (!cls || max_streams == 0 || max_streams > (1U << 30))
+		return -EINVAL;
+
+	/* Keep the load factor at most 50% so probe sequences stay short. */
+	while ((1U << slot_bits) < 2 * max_streams)
+		slot_bits++;
+
+	c = calloc(1, sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	c->slots = malloc(sizeof(struct slot) << slot_bits);
+	c->streams = calloc(max_streams, sizeof(struct stream));
+	if (!c->slots || !c->streams) {
+		avtp_classifier_destroy(c);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < (1U << slot_bits); i++)
+		c->slots[i].stream = EMPTY_SLOT;
+
+	c->slot_bits = slot_bits;
+	c->max_streams = max_streams;
+
+	*cls = c;
+	return 0;
+}
+
+void avtp_classifier_destroy(struct avtp_classifier *cls)
+{
+	if (!cls)
+		return;
+
+	free(cls->slots);
+	free(cls->streams);
+	free(cls);
+}
+
+int avtp_classifier_add(struct avtp_classifier *cls,
+					const struct avtp_stream_pdu *expected,
+					const struct avtp_stream_pdu *mask)
+{
+	struct stream *s;
+	unsigned int i;
+	int stream;
+
+	if (!cls || !expected)
+		return -EINVAL;
+
+	if (lookup(cls, expected->stream_id) != EMPTY_SLOT)
+		return -EEXIST;
+
+	if (cls->num_streams == cls->max_streams)
+		return -ENOSPC;
+
+	stream = cls->num_streams++;
+	s = &cls->streams[stream];
+
+	if (mask) {
+		s->mask[WORD_SUBTYPE_DATA] = mask->subtype_data;
+		s->mask[WORD_FORMAT_SPECIFIC] = mask->format_specific;
+		s->mask[WORD_PACKET_INFO] = mask->packet_info;
+	} else {
+		s->mask[WORD_SUBTYPE_DATA] = htonl(DEFAULT_MASK);
+	}
+	s->mask[WORD_SUBTYPE_DATA] &= htonl((uint32_t) ~AVTP_STREAM_MASK_SEQ_NUM);
+
+	s->expected[WORD_SUBTYPE_DATA] = expected->subtype_data;
+	s->expected[WORD_FORMAT_SPECIFIC] = expected->format_specific;
+	s->expected[WORD_PACKET_INFO] = expected->packet_info;
+
+	i = hash(cls, expected->stream_id);
+	while (cls->slots[i].stream != EMPTY_SLOT)
+		i = (i + 1) & BITMASK(cls->slot_bits);
+
+	cls->slots[i].stream_id = expected->stream_id;
+	cls->slots[i].stream = stream;
+
+	return stream;
+}
+
+static int classify_batch(struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[], unsigned int count,
+				struct avtp_classifier_result results[])
+{
+	uint32_t words[NUM_WORDS][BATCH_SIZE];
+	uint32_t expected[NUM_WORDS][BATCH_SIZE];
+	uint32_t mask[NUM_WORDS][BATCH_SIZE];
+	uint32_t mismatch[BATCH_SIZE];
+	unsigned int i, w;
+	int accepted = 0;
+
+	/* First pass: look streams up and gather header words. PDUs which
+	 * don't belong to any stream get an all zeros mask so they never
+	 * mismatch, their verdict is sorted out in the last pass.
+	 */
+	for (i = 0; i < count; i++) {
+		const struct avtp_stream_pdu *pdu = pdus[i];
+		const struct stream *s;
+		int stream = EMPTY_SLOT;
+
+		if (pdu && lens[i] >= sizeof(struct avtp_stream_pdu))
+			stream = lookup(cls, pdu->stream_id);
+
+		results[i].stream = stream;
+		results[i].lost = 0;
+
+		if (stream == EMPTY_SLOT) {
+			for (w = 0; w < NUM_WORDS; w++) {
+				words[w][i] = 0;
+				expected[w][i] = 0;
+				mask[w][i] = 0;
+			}
+			continue;
+		}
+
+		s = &cls->streams[stream];
+		words[WORD_SUBTYPE_DATA][i] = pdu->subtype_data;
+		words[WORD_FORMAT_SPECIFIC][i] = pdu->format_specific;
+		words[WORD_PACKET_INFO][i] = pdu->packet_info;
+		for (w = 0; w < NUM_WORDS; w++) {
+			expected[w][i] = s->expected[w];
+			mask[w][i] = s->mask[w];
+		}
+	}
+
+	/* Second pass: compare all masked words at once. */
+	for (i = 0; i < count; i++) {
+		mismatch[i] = ((words[0][i] ^ expected[0][i]) & mask[0][i]) |
+			((words[1][i] ^ expected[1][i]) & mask[1][i]) |
+			((words[2][i] ^ expected[2][i]) & mask[2][i]);
+	}
+
+	/* Last pass: check lengths, track sequence numbers and set verdicts.
+	 * This is sequential since PDUs from the same stream depend on each
+	 * other.
+	 */
+	for (i = 0; i < count; i++) {
+		struct avtp_classifier_result *res = &results[i];
+		const struct avtp_stream_pdu *pdu = pdus[i];
+		uint32_t subtype_data, packet_info;
+		struct stream *s;
+		size_t data_len;
+		uint8_t seq;
+
+		if (res->stream == EMPTY_SLOT) {
+			if (pdu && lens[i] >= sizeof(struct avtp_stream_pdu))
+				res->verdict = AVTP_CLASSIFIER_UNKNOWN;
+			else
+				res->verdict = AVTP_CLASSIFIER_FAIL;
+			continue;
+		}
+
+		packet_info = ntohl(words[WORD_PACKET_INFO][i]);
+		data_len = BITMAP_GET_VALUE(packet_info,
+						AVTP_STREAM_MASK_STREAM_DATA_LEN,
+						AVTP_STREAM_SHIFT_STREAM_DATA_LEN);
+
+		if (mismatch[i] ||
+			lens[i] - sizeof(struct avtp_stream_pdu) < data_len) {
+			res->verdict = AVTP_CLASSIFIER_FAIL;
+			continue;
+		}
+
+		s = &cls->streams[res->stream];
+		subtype_data = ntohl(words[WORD_SUBTYPE_DATA][i]);
+		seq = BITMAP_GET_VALUE(subtype_data, AVTP_STREAM_MASK_SEQ_NUM,
+						AVTP_STREAM_SHIFT_SEQ_NUM);
+
+		if (!s->seq_valid || seq == s->next_seq) {
+			res->verdict = AVTP_CLASSIFIER_PASS;
+		} else if ((int8_t) (seq - s->next_seq) < 0) {
+			/* Duplicate or reordered PDU, which doesn't move
+			 * tracking backwards.
+			 */
+			res->verdict = AVTP_CLASSIFIER_SEQ_OLD;
+			accepted++;
+			continue;
+		} else {
+			res->verdict = AVTP_CLASSIFIER_SEQ_GAP;
+			res->lost = seq - s->next_seq;
+		}
+
+		s->next_seq = seq + 1;
+		s->seq_valid = true;
+		accepted++;
+	}
+
+	return accepted;
+}
+
+int avtp_classifier_classify(struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[], unsigned int count,
+				struct avtp_classifier_result results[])
+{
+	unsigned int i;
+	int accepted = 0;
+
+	if (!cls || !pdus || !lens || !results)
+		return -EINVAL;
+
+	for (i = 0; i < count; i += BATCH_SIZE) {
+		unsigned int n = count - i;
+
+		if (n > BATCH_SIZE)
+			n = BATCH_SIZE;
+
+		accepted += classify_batch(cls, &pdus[i], &lens[i], n,
+								&results[i]);
+	}
+
+	return accepted;
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "avtp_clock.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+
+/* Reads of the reference clock are bracketed by reads of CLOCK_MONOTONIC and
+ * the tightest bracket out of SYNC_SAMPLES is kept, so preemption during a
+ * read doesn't skew the time base.
+ */
+#define SYNC_SAMPLES		3
+
+/* Rate estimates are only taken over intervals long enough for read
+ * jitter to be negligible, and are discarded if the reference clock drifts
+ * more than MAX_RATE_PPM from CLOCK_MONOTONIC, which means it was stepped.
+ */
+#define MIN_RATE_INTERVAL	(10 * 1000000ULL)
+#define MAX_RATE_PPM		1000
+
+struct avtp_clock {
+	clockid_t clockid;
+	uint64_t resync_interval;
+	/* Time base: reference time 'ref_base' was read at CLOCK_MONOTONIC
+	 * time 'mono_base'.
+	 */
+	uint64_t ref_base;
+	uint64_t mono_base;
+	/* Time base the rate is estimated against. It only moves once the
+	 * estimation interval is long enough, whatever the resync interval.
+	 */
+	uint64_t rate_ref;
+	uint64_t rate_mono;
+	/* Reference clock ticks per CLOCK_MONOTONIC tick. */
+	double rate;
+};
+
+static int read_clock(clockid_t clockid, uint64_t *time)
+{
+	struct timespec ts;
+
+	if (clock_gettime(clockid, &ts) < 0)
+		return -errno;
+
+	*time = ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+	return 0;
+}
+
+static int clock_sync(struct avtp_clock *clk, bool first)
+{
+	uint64_t before = 0, after = 0, ref = 0, mono = 0, best_ref = 0;
+	uint64_t best = UINT64_MAX;
+	int i, res;
+
+	for (i = 0; i < SYNC_SAMPLES; i++) {
+		res = read_clock(CLOCK_MONOTONIC, &before);
+		if (res < 0)
+			return res;
+
+		res = read_clock(clk->clockid, &ref);
+		if (res < 0)
+			return res;
+
+		res = read_clock(CLOCK_MONOTONIC, &after);
+		if (res < 0)
+			return res;
+
+		if (after - before < best) {
+			best = after - before;
+			mono = before + best / 2;
+			best_ref = ref;
+		}
+	}
+
+	if (first) {
+		clk->rate_ref = best_ref;
+		clk->rate_mono = mono;
+	} else if (mono - clk->rate_mono >= MIN_RATE_INTERVAL) {
+		double rate = (double) (int64_t) (best_ref - clk->rate_ref) /
+						(mono - clk->rate_mono);
+
+		if (rate > 1.0 - MAX_RATE_PPM * 1e-6 &&
+					rate < 1.0 + MAX_RATE_PPM * 1e-6)
+			clk->rate = rate;
+		else
+			clk->rate = 1.0;
+
+		clk->rate_ref = best_ref;
+		clk->rate_mono = mono;
+	}
+
+	clk->ref_base = best_ref;
+	clk->mono_base = mono;
+
+	return 0;
+}
+
+int avtp_clock_create(struct avtp_clock **clk, clockid_t clockid,
+						uint64_t resync_interval)
+{
+	struct avtp_clock *c;
+	int res;
+
+	if (!clk)
+		return -EINVAL;
+
+	c = calloc(1, sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	c->clockid = clockid;
+	c->resync_interval = resync_interval;
+	c->rate = 1.0;
+
+	res = clock_sync(c, true);
+	if (res < 0) {
+		free(c);
+		return res;
+	}
+
+	*clk = c;
+	return 0;
+}
+
+void avtp_clock_destroy(struct avtp_clock *clk)
+{
+	free(clk);
+}
+
+int avtp_clock_now(struct avtp_clock *clk, uint64_t *now)
+{
+	uint64_t mono = 0, elapsed;
+	int res;
+
+	if (!clk || !now)
+		return -EINVAL;
+
+	if (clk->resync_interval == 0)
+		return read_clock(clk->clockid, now);
+
+	res = read_clock(CLOCK_MONOTONIC, &mono);
+	if (res < 0)
+		return res;
+
+	elapsed = mono - clk->mono_base;
+	if (elapsed >= clk->resync_interval) {
+		res = clock_sync(clk, false);
+		if (res < 0)
+			return res;
+
+		elapsed = mono - clk->mono_base;
+	}
+
+	/* Samples taken right before the resync may be slightly behind its
+	 * time base.
+	 */
+	if ((int64_t) elapsed < 0)
+		elapsed = 0;
+
+	*now = clk->ref_base + (uint64_t) (elapsed * clk->rate);
+	return 0;
+}
+
+static uint64_t unwrap(uint64_t ref, uint64_t time, unsigned int bits)
+{
+	uint64_t mask = (1ULL << bits) - 1;
+	uint64_t diff = (time - ref) & mask;
+
+	/* Sign extend 'diff' from 'bits' wide to get the signed distance
+	 * from 'ref', which ranges from -2^(bits - 1) to 2^(bits - 1) - 1.
+	 */
+	if (diff & (1ULL << (bits - 1)))
+		return ref - ((~diff + 1) & mask);
+
+	return ref + diff;
+}
+
+int avtp_clock_unwrap(uint64_t ref, uint64_t time, unsigned int bits,
+							uint64_t *full)
+{
+	if (!full || bits == 0 || bits > 63)
+		return -EINVAL;
+
+	*full = unwrap(ref, time, bits);
+	return 0;
+}
+
+int avtp_clock_unwrap_burst(struct avtp_clock *clk,
+				const uint32_t avtp_times[], uint64_t times[],
+				unsigned int count)
+{
+	uint64_t now;
+	unsigned int i;
+	int res;
+
+	if (!avtp_times || !times)
+		return -EINVAL;
+
+	res = avtp_clock_now(clk, &now);
+	if (res < 0)
+		return res;
+
+	for (i = 0; i < count; i++)
+		times[i] = now + (int32_t) (avtp_times[i] - (uint32_t) now);
+
+	return 0;
+}
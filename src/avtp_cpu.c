@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdint.h>
+
+#include "avtp_cpu.h"
+
+static enum avtp_cpu_level probe_level(void)
+{
+#if defined(HAVE_X86_KERNELS)
+	__builtin_cpu_init();
+
+	/* Support for AVX state by the OS is checked by the compiler
+	 * runtime as well.
+	 */
+	if (__builtin_cpu_supports("avx512f") &&
+			__builtin_cpu_supports("avx512bw"))
+		return AVTP_CPU_AVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return AVTP_CPU_AVX2;
+	if (__builtin_cpu_supports("sse4.2"))
+		return AVTP_CPU_SSE4_2;
+	if (__builtin_cpu_supports("sse2"))
+		return AVTP_CPU_SSE2;
+#elif defined(HAVE_NEON_KERNELS)
+	return AVTP_CPU_NEON;
+#endif
+	return AVTP_CPU_SCALAR;
+}
+
+enum avtp_cpu_level avtp_cpu_get_level(void)
+{
+	/* Only called from constructors, which run one at a time. */
+	static int probed;
+	static enum avtp_cpu_level level;
+
+	if (!probed) {
+		level = probe_level();
+		if (level > AVTP_CPU_MAX_LEVEL)
+			level = AVTP_CPU_MAX_LEVEL;
+		probed = 1;
+	}
+
+	return level;
+}
+
+const void *avtp_cpu_select(const struct avtp_cpu_variant variants[],
+				size_t count, avtp_cpu_check_fn check)
+{
+	enum avtp_cpu_level level = avtp_cpu_get_level();
+	size_t i;
+
+	for (i = count; i-- > 1;) {
+		if (variants[i].level > level)
+			continue;
+
+		if (check(variants[i].ops, variants[0].ops) == 0)
+			return variants[i].ops;
+	}
+
+	return variants[0].ops;
+}
+
+void avtp_cpu_fill_pattern(void *buf, size_t len)
+{
+	uint8_t *b = buf;
+	size_t i;
+
+	/* Odd multiplier, so it is invertible modulo 256. */
+	for (i = 0; i < len; i++)
+		b[i] = i * 167 + 13;
+}
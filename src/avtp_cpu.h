@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <endian.h>
+#include <stddef.h>
+
+/* Optimized kernels are built for the architecture targeted, whatever the
+ * compiler flags, with the 'target' function attribute on x86. NEON is part
+ * of the aarch64 baseline, so it needs no attribute.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS
+#elif defined(__aarch64__) && __BYTE_ORDER == __LITTLE_ENDIAN
+#include <arm_neon.h>
+#define HAVE_NEON_KERNELS
+#endif
+
+#pragma GCC visibility push(hidden)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Instruction set levels optimized kernels are built for. x86 levels are
+ * ordered so each one implies the ones below it: AVX-512 stands for the F
+ * and BW extensions. NEON is the only aarch64 level.
+ */
+enum avtp_cpu_level {
+	AVTP_CPU_SCALAR,
+	AVTP_CPU_SSE2,
+	AVTP_CPU_SSE4_2,
+	AVTP_CPU_AVX2,
+	AVTP_CPU_AVX512,
+	AVTP_CPU_NEON,
+};
+
+/* Highest level kernels are selected at, set by the 'simd' build option.
+ * Levels not supported by the running CPU are never selected anyway.
+ */
+#ifndef AVTP_CPU_MAX_LEVEL
+#define AVTP_CPU_MAX_LEVEL	AVTP_CPU_NEON
+#endif
+
+/* One variant of a kernel table (e.g. struct pcm_ops from avtp_aaf_pcm.c),
+ * built for some level.
+ */
+struct avtp_cpu_variant {
+	enum avtp_cpu_level level;
+	const void *ops;
+};
+
+/* Self-test of a kernel table, run before it is selected.
+ * @ops: Kernel table to be checked.
+ * @ref: Scalar kernel table, the reference.
+ *
+ * Returns:
+ *    0: If every kernel from 'ops' gives the same results as 'ref'.
+ *    Any other value: Otherwise.
+ */
+typedef int (*avtp_cpu_check_fn)(const void *ops, const void *ref);
+
+/* Get the highest level supported by the running CPU, capped by
+ * AVTP_CPU_MAX_LEVEL. The CPU is only probed on the first call.
+ */
+enum avtp_cpu_level avtp_cpu_get_level(void);
+
+/* Select the kernel table to be used. Meant to be called once, when the
+ * library is loaded, by a constructor of each module with optimized kernels:
+ *
+ *	__attribute__((constructor))
+ *	static void select_ops(void)
+ *	{
+ *		ops = avtp_cpu_select(variants, ARRAY_SIZE(variants),
+ *								check_ops);
+ *	}
+ *
+ * The highest variant not above avtp_cpu_get_level() which passes its
+ * self-test is selected, so a miscompiled kernel or a CPU misreporting its
+ * extensions costs speed instead of correctness.
+ * @variants: Array of variants, in increasing level order, starting with the
+ *            scalar one.
+ * @count: Number of elements in 'variants'.
+ * @check: Self-test run on variants other than the scalar one.
+ *
+ * Returns:
+ *    Kernel table selected.
+ */
+const void *avtp_cpu_select(const struct avtp_cpu_variant variants[],
+				size_t count, avtp_cpu_check_fn check);
+
+/* Fill a buffer with a pattern for kernel self-tests. Bytes less than 256
+ * bytes apart never match, so swapped or misplaced bytes are always caught.
+ * @buf: Buffer to be filled.
+ * @len: Length of 'buf', in bytes.
+ */
+void avtp_cpu_fill_pattern(void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
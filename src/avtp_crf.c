@@ -31,258 +31,176 @@
 
 #include "avtp.h"
 #include "avtp_crf.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "util.h"
 
-#define SHIFT_SV			(31 - 8)
-#define SHIFT_MR			(31 - 12)
-#define SHIFT_FS			(31 - 14)
-#define SHIFT_TU			(31 - 15)
-#define SHIFT_SEQ_NUM			(31 - 23)
-#define SHIFT_PULL			(63 - 2)
-#define SHIFT_BASE_FREQ			(63 - 31)
-#define SHIFT_CRF_DATA_LEN		(63 - 47)
+#define SHIFT_SUBTYPE			AVTP_COMMON_SHIFT_SUBTYPE
+#define SHIFT_SV			AVTP_CRF_SHIFT_SV
+#define SHIFT_MR			AVTP_CRF_SHIFT_MR
+#define SHIFT_FS			AVTP_CRF_SHIFT_FS
+#define SHIFT_TU			AVTP_CRF_SHIFT_TU
+#define SHIFT_SEQ_NUM			AVTP_CRF_SHIFT_SEQ_NUM
+#define SHIFT_PULL			AVTP_CRF_SHIFT_PULL
+#define SHIFT_BASE_FREQ			AVTP_CRF_SHIFT_BASE_FREQ
+#define SHIFT_CRF_DATA_LEN		AVTP_CRF_SHIFT_CRF_DATA_LEN
+
+#define MASK_SUBTYPE			AVTP_COMMON_MASK_SUBTYPE
+#define MASK_SV				AVTP_CRF_MASK_SV
+#define MASK_MR				AVTP_CRF_MASK_MR
+#define MASK_FS				AVTP_CRF_MASK_FS
+#define MASK_TU				AVTP_CRF_MASK_TU
+#define MASK_SEQ_NUM			AVTP_CRF_MASK_SEQ_NUM
+#define MASK_TYPE			AVTP_CRF_MASK_TYPE
+#define MASK_PULL			AVTP_CRF_MASK_PULL
+#define MASK_BASE_FREQ			AVTP_CRF_MASK_BASE_FREQ
+#define MASK_CRF_DATA_LEN		AVTP_CRF_MASK_CRF_DATA_LEN
+#define MASK_TIMESTAMP_INTERVAL		AVTP_CRF_MASK_TIMESTAMP_INTERVAL
+
+static const struct avtp_field_desc fields[AVTP_CRF_FIELD_MAX] = {
+	[AVTP_CRF_FIELD_SV] = AVTP_FIELD(struct avtp_crf_pdu,
+					subtype_data, MASK_SV),
+	[AVTP_CRF_FIELD_MR] = AVTP_FIELD(struct avtp_crf_pdu,
+					subtype_data, MASK_MR),
+	[AVTP_CRF_FIELD_FS] = AVTP_FIELD(struct avtp_crf_pdu,
+					subtype_data, MASK_FS),
+	[AVTP_CRF_FIELD_TU] = AVTP_FIELD(struct avtp_crf_pdu,
+					subtype_data, MASK_TU),
+	[AVTP_CRF_FIELD_SEQ_NUM] = AVTP_FIELD(struct avtp_crf_pdu,
+					subtype_data, MASK_SEQ_NUM),
+	[AVTP_CRF_FIELD_TYPE] = AVTP_FIELD(struct avtp_crf_pdu,
+					subtype_data, MASK_TYPE),
+	[AVTP_CRF_FIELD_STREAM_ID] = AVTP_FIELD(struct avtp_crf_pdu,
+					stream_id, UINT64_MAX),
+	[AVTP_CRF_FIELD_PULL] = AVTP_FIELD(struct avtp_crf_pdu,
+					packet_info, MASK_PULL),
+	[AVTP_CRF_FIELD_BASE_FREQ] = AVTP_FIELD(struct avtp_crf_pdu,
+					packet_info, MASK_BASE_FREQ),
+	[AVTP_CRF_FIELD_CRF_DATA_LEN] = AVTP_FIELD(struct avtp_crf_pdu,
+					packet_info, MASK_CRF_DATA_LEN),
+	[AVTP_CRF_FIELD_TIMESTAMP_INTERVAL] = AVTP_FIELD(struct avtp_crf_pdu,
+					packet_info, MASK_TIMESTAMP_INTERVAL),
+};
 
-#define MASK_SV				(BITMASK(1) << SHIFT_SV)
-#define MASK_MR				(BITMASK(1) << SHIFT_MR)
-#define MASK_FS				(BITMASK(1) << SHIFT_FS)
-#define MASK_TU				(BITMASK(1) << SHIFT_TU)
-#define MASK_SEQ_NUM			(BITMASK(8) << SHIFT_SEQ_NUM)
-#define MASK_TYPE			(BITMASK(8))
-#define MASK_PULL			(BITMASK(3) << SHIFT_PULL)
-#define MASK_BASE_FREQ			(BITMASK(29) << SHIFT_BASE_FREQ)
-#define MASK_CRF_DATA_LEN		(BITMASK(16) << SHIFT_CRF_DATA_LEN)
-#define MASK_TIMESTAMP_INTERVAL		(BITMASK(16))
-
-static int get_field_value(const struct avtp_crf_pdu *pdu,
+int avtp_crf_pdu_get(const struct avtp_crf_pdu *pdu,
 				enum avtp_crf_field field, uint64_t *val)
 {
-	uint64_t bitmap, mask;
-	uint8_t shift;
-
-	switch (field) {
-	case AVTP_CRF_FIELD_SV:
-		mask = MASK_SV;
-		shift = SHIFT_SV;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_CRF_FIELD_MR:
-		mask = MASK_MR;
-		shift = SHIFT_MR;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_CRF_FIELD_FS:
-		mask = MASK_FS;
-		shift = SHIFT_FS;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_CRF_FIELD_TU:
-		mask = MASK_TU;
-		shift = SHIFT_TU;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_CRF_FIELD_SEQ_NUM:
-		mask = MASK_SEQ_NUM;
-		shift = SHIFT_SEQ_NUM;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_CRF_FIELD_TYPE:
-		mask = MASK_TYPE;
-		shift = 0;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_CRF_FIELD_PULL:
-		mask = MASK_PULL;
-		shift = SHIFT_PULL;
-		bitmap = be64toh(pdu->packet_info);
-		break;
-	case AVTP_CRF_FIELD_BASE_FREQ:
-		mask = MASK_BASE_FREQ;
-		shift = SHIFT_BASE_FREQ;
-		bitmap = be64toh(pdu->packet_info);
-		break;
-	case AVTP_CRF_FIELD_CRF_DATA_LEN:
-		mask = MASK_CRF_DATA_LEN;
-		shift = SHIFT_CRF_DATA_LEN;
-		bitmap = be64toh(pdu->packet_info);
-		break;
-	case AVTP_CRF_FIELD_TIMESTAMP_INTERVAL:
-		mask = MASK_TIMESTAMP_INTERVAL;
-		shift = 0;
-		bitmap = be64toh(pdu->packet_info);
-		break;
-	default:
+	if (!pdu || !val)
 		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
 
-	return 0;
+	return avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
-int avtp_crf_pdu_get(const struct avtp_crf_pdu *pdu,
-				enum avtp_crf_field field, uint64_t *val)
+int avtp_crf_pdu_set(struct avtp_crf_pdu *pdu, enum avtp_crf_field field,
+								uint64_t val)
 {
-	int res;
-
-	if (!pdu || !val)
+	if (!pdu)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_CRF_FIELD_SV:
-	case AVTP_CRF_FIELD_MR:
-	case AVTP_CRF_FIELD_FS:
-	case AVTP_CRF_FIELD_TU:
-	case AVTP_CRF_FIELD_SEQ_NUM:
-	case AVTP_CRF_FIELD_TYPE:
-	case AVTP_CRF_FIELD_PULL:
-	case AVTP_CRF_FIELD_BASE_FREQ:
-	case AVTP_CRF_FIELD_CRF_DATA_LEN:
-	case AVTP_CRF_FIELD_TIMESTAMP_INTERVAL:
-		res = get_field_value(pdu, field, val);
-		break;
-	case AVTP_CRF_FIELD_STREAM_ID:
-		*val = be64toh(pdu->stream_id);
-		res = 0;
-		break;
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
-static int set_field_value_32(struct avtp_crf_pdu *pdu,
-				enum avtp_crf_field field, uint64_t val)
+int avtp_crf_pdu_init(struct avtp_crf_pdu *pdu)
 {
-	uint32_t bitmap, mask;
-	uint8_t shift;
+	int res;
 
-	switch (field) {
-	case AVTP_CRF_FIELD_SV:
-		mask = MASK_SV;
-		shift = SHIFT_SV;
-		break;
-	case AVTP_CRF_FIELD_MR:
-		mask = MASK_MR;
-		shift = SHIFT_MR;
-		break;
-	case AVTP_CRF_FIELD_FS:
-		mask = MASK_FS;
-		shift = SHIFT_FS;
-		break;
-	case AVTP_CRF_FIELD_TU:
-		mask = MASK_TU;
-		shift = SHIFT_TU;
-		break;
-	case AVTP_CRF_FIELD_SEQ_NUM:
-		mask = MASK_SEQ_NUM;
-		shift = SHIFT_SEQ_NUM;
-		break;
-	case AVTP_CRF_FIELD_TYPE:
-		mask = MASK_TYPE;
-		shift = 0;
-		break;
-	default:
+	if (!pdu)
 		return -EINVAL;
-	}
 
-	bitmap = ntohl(pdu->subtype_data);
+	memset(pdu, 0, sizeof(struct avtp_crf_pdu));
 
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
+	res = avtp_pdu_set((struct avtp_common_pdu *) pdu, AVTP_FIELD_SUBTYPE,
+							AVTP_SUBTYPE_CRF);
+	if (res < 0)
+		return res;
 
-	pdu->subtype_data = htonl(bitmap);
+	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_SV, 1);
+	if (res < 0)
+		return res;
 
 	return 0;
 }
 
-static int set_field_value_64(struct avtp_crf_pdu *pdu,
-				enum avtp_crf_field field, uint64_t val)
+int avtp_crf_pdu_unpack(const struct avtp_crf_pdu *pdu,
+						struct avtp_crf_hdr *hdr)
 {
-	uint64_t bitmap, mask;
-	uint8_t shift;
+	uint32_t subtype_data;
+	uint64_t packet_info;
 
-	switch (field) {
-	case AVTP_CRF_FIELD_PULL:
-		mask = MASK_PULL;
-		shift = SHIFT_PULL;
-		break;
-	case AVTP_CRF_FIELD_BASE_FREQ:
-		mask = MASK_BASE_FREQ;
-		shift = SHIFT_BASE_FREQ;
-		break;
-	case AVTP_CRF_FIELD_CRF_DATA_LEN:
-		mask = MASK_CRF_DATA_LEN;
-		shift = SHIFT_CRF_DATA_LEN;
-		break;
-	case AVTP_CRF_FIELD_TIMESTAMP_INTERVAL:
-		mask = MASK_TIMESTAMP_INTERVAL;
-		shift = 0;
-		break;
-	default:
+	if (!pdu || !hdr)
 		return -EINVAL;
-	}
-
-	bitmap = be64toh(pdu->packet_info);
-
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
 
-	pdu->packet_info = htobe64(bitmap);
+	subtype_data = ntohl(pdu->subtype_data);
+	packet_info = be64toh(pdu->packet_info);
+
+	hdr->sv = BITMAP_GET_VALUE(subtype_data, MASK_SV, SHIFT_SV);
+	hdr->mr = BITMAP_GET_VALUE(subtype_data, MASK_MR, SHIFT_MR);
+	hdr->fs = BITMAP_GET_VALUE(subtype_data, MASK_FS, SHIFT_FS);
+	hdr->tu = BITMAP_GET_VALUE(subtype_data, MASK_TU, SHIFT_TU);
+	hdr->seq_num = BITMAP_GET_VALUE(subtype_data, MASK_SEQ_NUM,
+								SHIFT_SEQ_NUM);
+	hdr->type = BITMAP_GET_VALUE(subtype_data, MASK_TYPE, 0);
+	hdr->stream_id = be64toh(pdu->stream_id);
+	hdr->pull = BITMAP_GET_VALUE(packet_info, MASK_PULL, SHIFT_PULL);
+	hdr->base_freq = BITMAP_GET_VALUE(packet_info, MASK_BASE_FREQ,
+							SHIFT_BASE_FREQ);
+	hdr->crf_data_len = BITMAP_GET_VALUE(packet_info, MASK_CRF_DATA_LEN,
+							SHIFT_CRF_DATA_LEN);
+	hdr->timestamp_interval = BITMAP_GET_VALUE(packet_info,
+						MASK_TIMESTAMP_INTERVAL, 0);
 
 	return 0;
 }
 
-int avtp_crf_pdu_set(struct avtp_crf_pdu *pdu, enum avtp_crf_field field,
-								uint64_t val)
+int avtp_crf_pdu_pack(struct avtp_crf_pdu *pdu,
+					const struct avtp_crf_hdr *hdr)
 {
-	int res;
+	uint32_t subtype_data = 0;
+	uint64_t packet_info = 0;
 
-	if (!pdu)
+	if (!pdu || !hdr)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_CRF_FIELD_SV:
-	case AVTP_CRF_FIELD_MR:
-	case AVTP_CRF_FIELD_FS:
-	case AVTP_CRF_FIELD_TU:
-	case AVTP_CRF_FIELD_SEQ_NUM:
-	case AVTP_CRF_FIELD_TYPE:
-		res = set_field_value_32(pdu, field, val);
-		break;
-	case AVTP_CRF_FIELD_PULL:
-	case AVTP_CRF_FIELD_BASE_FREQ:
-	case AVTP_CRF_FIELD_CRF_DATA_LEN:
-	case AVTP_CRF_FIELD_TIMESTAMP_INTERVAL:
-		res = set_field_value_64(pdu, field, val);
-		break;
-	case AVTP_CRF_FIELD_STREAM_ID:
-		pdu->stream_id = htobe64(val);
-		res = 0;
-		break;
-	default:
-		res = -EINVAL;
-	}
+	BITMAP_SET_VALUE(subtype_data, (uint32_t) AVTP_SUBTYPE_CRF,
+						MASK_SUBTYPE, SHIFT_SUBTYPE);
+	BITMAP_SET_VALUE(subtype_data, hdr->sv, MASK_SV, SHIFT_SV);
+	BITMAP_SET_VALUE(subtype_data, hdr->mr, MASK_MR, SHIFT_MR);
+	BITMAP_SET_VALUE(subtype_data, hdr->fs, MASK_FS, SHIFT_FS);
+	BITMAP_SET_VALUE(subtype_data, hdr->tu, MASK_TU, SHIFT_TU);
+	BITMAP_SET_VALUE(subtype_data, hdr->seq_num, MASK_SEQ_NUM,
+								SHIFT_SEQ_NUM);
+	BITMAP_SET_VALUE(subtype_data, hdr->type, MASK_TYPE, 0);
+	BITMAP_SET_VALUE(packet_info, (uint64_t) hdr->pull, MASK_PULL,
+								SHIFT_PULL);
+	BITMAP_SET_VALUE(packet_info, (uint64_t) hdr->base_freq,
+					MASK_BASE_FREQ, SHIFT_BASE_FREQ);
+	BITMAP_SET_VALUE(packet_info, (uint64_t) hdr->crf_data_len,
+				MASK_CRF_DATA_LEN, SHIFT_CRF_DATA_LEN);
+	BITMAP_SET_VALUE(packet_info, (uint64_t) hdr->timestamp_interval,
+						MASK_TIMESTAMP_INTERVAL, 0);
+
+	pdu->subtype_data = htonl(subtype_data);
+	pdu->stream_id = htobe64(hdr->stream_id);
+	pdu->packet_info = htobe64(packet_info);
 
-	return res;
+	return 0;
 }
 
-int avtp_crf_pdu_init(struct avtp_crf_pdu *pdu)
+int avtp_crf_pdu_emit(struct avtp_crf_pdu *pdu,
+				const struct avtp_crf_pdu *tmpl, uint8_t seq_num)
 {
-	int res;
+	uint32_t subtype_data;
 
-	if (!pdu)
+	if (!pdu || !tmpl)
 		return -EINVAL;
 
-	memset(pdu, 0, sizeof(struct avtp_crf_pdu));
+	subtype_data = ntohl(tmpl->subtype_data);
 
-	res = avtp_pdu_set((struct avtp_common_pdu *) pdu, AVTP_FIELD_SUBTYPE,
-							AVTP_SUBTYPE_CRF);
-	if (res < 0)
-		return res;
+	BITMAP_SET_VALUE(subtype_data, seq_num, MASK_SEQ_NUM, SHIFT_SEQ_NUM);
 
-	res = avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_SV, 1);
-	if (res < 0)
-		return res;
+	pdu->subtype_data = htonl(subtype_data);
+	pdu->stream_id = tmpl->stream_id;
+	pdu->packet_info = tmpl->packet_info;
 
 	return 0;
 }
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <endian.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+#include "avtp_crf_data.h"
+#include "avtp_inline.h"
+
+/* Timestamps are converted to host order in blocks of this size. */
+#define BLOCK_SIZE		64
+
+struct entry {
+	int64_t index;
+	uint64_t timestamp;
+};
+
+struct avtp_crf_clock {
+	/* Last timestamps received. Indexes of timestamps grow by one on each
+	 * timestamp, lost ones included, so they are the 'x' of the fit.
+	 */
+	struct entry *ring;
+	unsigned int size;
+	unsigned int head;
+	unsigned int count;
+	int64_t next_index;
+
+	/* Stream state used to detect lost PDUs and discontinuities. */
+	uint8_t next_seq;
+	uint8_t mr;
+	double nominal;
+
+	/* Estimate: timestamp with index 'last_index' is 'base + frac' and
+	 * consecutive timestamps are 'period' apart.
+	 */
+	int64_t last_index;
+	uint64_t base;
+	double frac;
+	double period;
+	double sample_period;
+	uint16_t interval;
+};
+
+/* Round to nearest integer without pulling libm in. */
+static inline int64_t round_nearest(double x)
+{
+	return (int64_t) (x < 0 ? x - 0.5 : x + 0.5);
+}
+
+int avtp_crf_clock_create(struct avtp_crf_clock **clk, unsigned int size)
+{
+	struct avtp_crf_clock *c;
+	unsigned int ring_size = 2;
+
+	if (!clk || size < 2 || size > (1U << 31))
+		return -EINVAL;
+
+	/* Power of two sized so indexes can be masked. */
+	while (ring_size < size)
+		ring_size <<= 1;
+
+	c = calloc(1, sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	c->ring = calloc(ring_size, sizeof(*c->ring));
+	if (!c->ring) {
+		free(c);
+		return -ENOMEM;
+	}
+
+	c->size = ring_size;
+	*clk = c;
+	return 0;
+}
+
+void avtp_crf_clock_destroy(struct avtp_crf_clock *clk)
+{
+	if (!clk)
+		return;
+
+	free(clk->ring);
+	free(clk);
+}
+
+static void clock_reset(struct avtp_crf_clock *clk)
+{
+	clk->head = 0;
+	clk->count = 0;
+	clk->next_index = 0;
+}
+
+/* Least squares fit of timestamps over their indexes. Coordinates are taken
+ * relative to the last timestamp so doubles don't lose precision.
+ */
+static void clock_fit(struct avtp_crf_clock *clk)
+{
+	const unsigned int mask = clk->size - 1;
+	const struct entry *last = &clk->ring[(clk->head - 1) & mask];
+	double mean_x = 0, mean_y = 0, sxx = 0, sxy = 0;
+	unsigned int i;
+
+	clk->last_index = last->index;
+	clk->base = last->timestamp;
+
+	if (clk->count < 2) {
+		clk->frac = 0;
+		clk->period = clk->nominal;
+		goto out;
+	}
+
+	for (i = 0; i < clk->count; i++) {
+		const struct entry *e = &clk->ring[(clk->head - 1 - i) & mask];
+
+		mean_x += (double) (e->index - last->index);
+		mean_y += (double) (int64_t) (e->timestamp - last->timestamp);
+	}
+
+	mean_x /= clk->count;
+	mean_y /= clk->count;
+
+	for (i = 0; i < clk->count; i++) {
+		const struct entry *e = &clk->ring[(clk->head - 1 - i) & mask];
+		double x, y;
+
+		x = (double) (e->index - last->index) - mean_x;
+		y = (double) (int64_t) (e->timestamp - last->timestamp) -
+									mean_y;
+		sxx += x * x;
+		sxy += x * y;
+	}
+
+	clk->period = sxy / sxx;
+	clk->frac = mean_y - clk->period * mean_x;
+
+out:
+	clk->sample_period = clk->period / clk->interval;
+}
+
+/* Offset of 'timestamp' from the estimate for index 'index'. */
+static double clock_error(const struct avtp_crf_clock *clk, int64_t index,
+							uint64_t timestamp)
+{
+	return (double) (int64_t) (timestamp - clk->base) - clk->frac -
+			clk->period * (double) (index - clk->last_index);
+}
+
+int avtp_crf_clock_update(struct avtp_crf_clock *clk,
+			const struct avtp_crf_pdu *pdu, size_t len)
+{
+	struct avtp_crf_hdr hdr;
+	uint64_t ts[BLOCK_SIZE];
+	unsigned int i, n;
+	uint64_t num, den;
+	double nominal, max_err;
+	int res;
+
+	if (!clk || !pdu || len < sizeof(*pdu))
+		return -EINVAL;
+
+	if (avtp_common_get_subtype((const struct avtp_common_pdu *) pdu) !=
+							AVTP_SUBTYPE_CRF)
+		return -EINVAL;
+
+	res = avtp_crf_pdu_unpack(pdu, &hdr);
+	if (res < 0)
+		return res;
+
+	res = avtp_crf_get_period(&hdr, &num, &den);
+	if (res < 0)
+		return res;
+
+	if (hdr.crf_data_len == 0 || hdr.crf_data_len % sizeof(uint64_t) ||
+			hdr.crf_data_len > len - sizeof(*pdu))
+		return -EINVAL;
+
+	/* Duplicate or reordered PDUs carry timestamps already accounted
+	 * for, or older than those, so they are skipped.
+	 */
+	if (clk->count && (int8_t) (hdr.seq_num - clk->next_seq) < 0)
+		return 0;
+
+	n = hdr.crf_data_len / sizeof(uint64_t);
+	nominal = (double) num / den;
+
+	if (clk->count) {
+		if (hdr.mr != clk->mr || nominal != clk->nominal) {
+			clock_reset(clk);
+		} else {
+			/* Skip indexes of timestamps from lost PDUs. */
+			uint8_t lost = hdr.seq_num - clk->next_seq;
+
+			clk->next_index += (int64_t) lost * n;
+		}
+	}
+
+	clk->next_seq = hdr.seq_num + 1;
+	clk->mr = hdr.mr;
+	clk->nominal = nominal;
+	clk->interval = hdr.timestamp_interval;
+
+	/* A timestamp more than half a sample period away from the estimate
+	 * means the clock jumped (or too many PDUs were lost to tell its
+	 * index), so start over.
+	 */
+	max_err = nominal / hdr.timestamp_interval / 2;
+
+	for (i = 0; i < n; i++) {
+		double err;
+
+		if (i % BLOCK_SIZE == 0)
+			avtp_crf_data_swap(ts, &pdu->crf_data[i],
+				n - i < BLOCK_SIZE ? n - i : BLOCK_SIZE);
+
+		if (clk->count) {
+			err = clock_error(clk, clk->next_index,
+							ts[i % BLOCK_SIZE]);
+			if (err > max_err || err < -max_err)
+				clock_reset(clk);
+		}
+
+		clk->ring[clk->head & (clk->size - 1)] = (struct entry) {
+			.index = clk->next_index++,
+			.timestamp = ts[i % BLOCK_SIZE],
+		};
+		clk->head++;
+		if (clk->count < clk->size)
+			clk->count++;
+
+		if (clk->count == 1)
+			clock_fit(clk);
+	}
+
+	clock_fit(clk);
+
+	return 0;
+}
+
+int avtp_crf_clock_lookup(const struct avtp_crf_clock *clk, uint32_t avtp_time,
+							uint64_t *sample_time)
+{
+	double offset;
+	int64_t k;
+
+	if (!clk || !sample_time)
+		return -EINVAL;
+
+	if (!clk->count)
+		return -EAGAIN;
+
+	/* Offset from the last timestamp estimate, in 32-bit arithmetic. */
+	offset = (double) (int32_t) (avtp_time - (uint32_t) clk->base) -
+								clk->frac;
+
+	k = round_nearest(offset / clk->sample_period);
+
+	*sample_time = clk->base +
+			round_nearest(clk->frac + k * clk->sample_period);
+
+	return 0;
+}
+
+int avtp_crf_clock_get_period(const struct avtp_crf_clock *clk,
+							double *period)
+{
+	if (!clk || !period)
+		return -EINVAL;
+
+	if (!clk->count)
+		return -EAGAIN;
+
+	*period = clk->sample_period;
+
+	return 0;
+}
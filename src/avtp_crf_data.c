@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <endian.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_cpu.h"
+#include "avtp_crf.h"
+#include "avtp_crf_data.h"
+#include "util.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+
+/* Timestamps are converted and checked in blocks, so each block is checked
+ * while it is still in L1 cache.
+ */
+#define BLOCK_SIZE		256
+
+/* Timestamps swapped by the kernel self-test: a few vectors of every width
+ * plus a tail.
+ */
+#define CHECK_LEN		35
+
+/* Conversion kernels between host order timestamps and network order CRF
+ * data. Pointers don't need to be aligned.
+ */
+struct crf_ops {
+	/* Swap bytes from 'n' 64-bit words. */
+	void (*swap64)(void *dst, const void *src, size_t n);
+};
+
+/* Numerator and denominator of each 'pull' multiplier. */
+static const uint32_t pull_ratio[][2] = {
+	[AVTP_CRF_PULL_MULT_BY_1] = { 1, 1 },
+	[AVTP_CRF_PULL_MULT_BY_1_OVER_1_001] = { 1000, 1001 },
+	[AVTP_CRF_PULL_MULT_BY_1_001] = { 1001, 1000 },
+	[AVTP_CRF_PULL_MULT_BY_24_OVER_25] = { 24, 25 },
+	[AVTP_CRF_PULL_MULT_BY_25_OVER_24] = { 25, 24 },
+	[AVTP_CRF_PULL_MULT_BY_1_OVER_8] = { 1, 8 },
+};
+
+static void swap64_generic(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		uint64_t val;
+
+		memcpy(&val, s + i * 8, sizeof(val));
+		put_unaligned_be64(val, d + i * 8);
+	}
+}
+
+static const struct crf_ops generic_ops = {
+	.swap64 = swap64_generic,
+};
+
+#ifdef HAVE_X86_KERNELS
+
+__attribute__((target("sse2")))
+static void swap64_sse2(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 2 <= n; i += 2) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 8));
+
+		/* Swap 32-bit halves from each timestamp, then 16-bit halves
+		 * from each word, then bytes from each half.
+		 */
+		v = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *) (d + i * 8), v);
+	}
+
+	swap64_generic(d + i * 8, s + i * 8, n - i);
+}
+
+static const struct crf_ops sse2_ops = {
+	.swap64 = swap64_sse2,
+};
+
+/* Byte shuffle swapping bytes from each 64-bit word of a 128-bit lane. */
+#define SWAP64_SHUF _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0,		\
+					15, 14, 13, 12, 11, 10, 9, 8)
+
+__attribute__((target("sse4.2")))
+static void swap64_sse42(void *dst, const void *src, size_t n)
+{
+	const __m128i shuf = SWAP64_SHUF;
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 2 <= n; i += 2) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 8));
+
+		v = _mm_shuffle_epi8(v, shuf);
+		_mm_storeu_si128((__m128i *) (d + i * 8), v);
+	}
+
+	swap64_generic(d + i * 8, s + i * 8, n - i);
+}
+
+static const struct crf_ops sse42_ops = {
+	.swap64 = swap64_sse42,
+};
+
+__attribute__((target("avx2")))
+static void swap64_avx2(void *dst, const void *src, size_t n)
+{
+	const __m256i shuf = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0,
+					15, 14, 13, 12, 11, 10, 9, 8,
+					7, 6, 5, 4, 3, 2, 1, 0,
+					15, 14, 13, 12, 11, 10, 9, 8);
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (s + i * 8));
+
+		v = _mm256_shuffle_epi8(v, shuf);
+		_mm256_storeu_si256((__m256i *) (d + i * 8), v);
+	}
+
+	swap64_sse42(d + i * 8, s + i * 8, n - i);
+}
+
+static const struct crf_ops avx2_ops = {
+	.swap64 = swap64_avx2,
+};
+
+__attribute__((target("avx512f,avx512bw")))
+static void swap64_avx512(void *dst, const void *src, size_t n)
+{
+	const __m512i shuf = _mm512_broadcast_i32x4(SWAP64_SHUF);
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m512i v = _mm512_loadu_si512(s + i * 8);
+
+		v = _mm512_shuffle_epi8(v, shuf);
+		_mm512_storeu_si512(d + i * 8, v);
+	}
+
+	swap64_avx2(d + i * 8, s + i * 8, n - i);
+}
+
+static const struct crf_ops avx512_ops = {
+	.swap64 = swap64_avx512,
+};
+
+#endif /* HAVE_X86_KERNELS */
+
+#ifdef HAVE_NEON_KERNELS
+
+static void swap64_neon(void *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 2 <= n; i += 2)
+		vst1q_u8(d + i * 8, vrev64q_u8(vld1q_u8(s + i * 8)));
+
+	swap64_generic(d + i * 8, s + i * 8, n - i);
+}
+
+static const struct crf_ops neon_ops = {
+	.swap64 = swap64_neon,
+};
+
+#endif /* HAVE_NEON_KERNELS */
+
+static const struct avtp_cpu_variant variants[] = {
+	{ AVTP_CPU_SCALAR, &generic_ops },
+#ifdef HAVE_X86_KERNELS
+	{ AVTP_CPU_SSE2, &sse2_ops },
+	{ AVTP_CPU_SSE4_2, &sse42_ops },
+	{ AVTP_CPU_AVX2, &avx2_ops },
+	{ AVTP_CPU_AVX512, &avx512_ops },
+#elif defined(HAVE_NEON_KERNELS)
+	{ AVTP_CPU_NEON, &neon_ops },
+#endif
+};
+
+static const struct crf_ops *ops = &generic_ops;
+
+static int check_ops(const void *variant, const void *ref)
+{
+	const struct crf_ops *v = variant, *r = ref;
+	uint8_t src[CHECK_LEN * 8 + 1];
+	uint8_t exp[CHECK_LEN * 8], res[CHECK_LEN * 8];
+
+	/* Source off by one byte, so unaligned loads are checked. */
+	avtp_cpu_fill_pattern(src, sizeof(src));
+
+	r->swap64(exp, src + 1, CHECK_LEN);
+	v->swap64(res, src + 1, CHECK_LEN);
+
+	return memcmp(exp, res, sizeof(res));
+}
+
+/* Kernels are selected once, when the library is loaded, according to the
+ * instruction set extensions supported by the running CPU.
+ */
+__attribute__((constructor))
+static void select_ops(void)
+{
+	ops = avtp_cpu_select(variants, ARRAY_SIZE(variants), check_ops);
+}
+
+void avtp_crf_data_swap(void *dst, const void *src, size_t n)
+{
+	ops->swap64(dst, src, n);
+}
+
+int avtp_crf_get_period(const struct avtp_crf_hdr *hdr, uint64_t *num,
+							uint64_t *den)
+{
+	if (hdr->base_freq == 0 || hdr->timestamp_interval == 0 ||
+			hdr->pull > AVTP_CRF_PULL_MULT_BY_1_OVER_8)
+		return -EINVAL;
+
+	/* Both fit in 64 bits: 'timestamp_interval' is 16-bit, 'base_freq'
+	 * is 29-bit and pull ratio terms are below 2^10.
+	 */
+	*num = hdr->timestamp_interval * NSEC_PER_SEC *
+						pull_ratio[hdr->pull][1];
+	*den = (uint64_t) hdr->base_freq * pull_ratio[hdr->pull][0];
+
+	return 0;
+}
+
+int avtp_crf_data_encode(void *crf_data, unsigned int count, uint64_t base,
+					const struct avtp_crf_hdr *hdr)
+{
+	uint64_t num, den, step, rem, ts;
+	uint64_t block[BLOCK_SIZE];
+	unsigned int i, j;
+	int res;
+
+	if (!crf_data || !hdr)
+		return -EINVAL;
+
+	res = avtp_crf_get_period(hdr, &num, &den);
+	if (res < 0)
+		return res;
+
+	/* Timestamp 'i' is 'base + round(i * num / den)'. It is computed
+	 * incrementally from the integer and fractional parts of the period,
+	 * so it is exact and no product overflows.
+	 */
+	step = num / den;
+	rem = den / 2;
+	ts = base;
+
+	for (i = 0; i < count; i += BLOCK_SIZE) {
+		unsigned int n = count - i < BLOCK_SIZE ? count - i :
+								BLOCK_SIZE;
+
+		for (j = 0; j < n; j++) {
+			block[j] = ts;
+
+			ts += step;
+			rem += num % den;
+			if (rem >= den) {
+				rem -= den;
+				ts++;
+			}
+		}
+
+		ops->swap64((uint8_t *) crf_data + i * sizeof(uint64_t),
+								block, n);
+	}
+
+	return 0;
+}
+
+int avtp_crf_data_decode(uint64_t ts[], const void *crf_data,
+			unsigned int count, const struct avtp_crf_hdr *hdr,
+			unsigned int outliers[], unsigned int max_outliers)
+{
+	uint64_t num, den;
+	int64_t period, tolerance;
+	unsigned int i, j, found = 0;
+	int res;
+
+	if (!ts || !crf_data || !hdr || (!outliers && max_outliers))
+		return -EINVAL;
+
+	res = avtp_crf_get_period(hdr, &num, &den);
+	if (res < 0)
+		return res;
+
+	period = (num + den / 2) / den;
+	tolerance = num / (den * hdr->timestamp_interval * 2);
+
+	for (i = 0; i < count; i += BLOCK_SIZE) {
+		unsigned int n = count - i < BLOCK_SIZE ? count - i :
+								BLOCK_SIZE;
+
+		ops->swap64(ts + i, (const uint8_t *) crf_data +
+						i * sizeof(uint64_t), n);
+
+		for (j = i ? i : 1; j < i + n; j++) {
+			/* Wraps instead of overflowing on timestamps far
+			 * apart, which are outliers either way.
+			 */
+			int64_t err = ts[j] - ts[j - 1] - (uint64_t) period;
+
+			if (err <= tolerance && err >= -tolerance)
+				continue;
+
+			if (found < max_outliers)
+				outliers[found] = j;
+			found++;
+		}
+	}
+
+	return found;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp_crf.h"
+
+#pragma GCC visibility push(hidden)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Get nominal CRF timestamp period described by 'hdr', 'num / den'
+ * nanoseconds, and media clock period, 'num / (den * timestamp_interval)'
+ * nanoseconds.
+ * @hdr: Pointer to CRF header fields.
+ * @num: Pointer to variable which the numerator is saved.
+ * @den: Pointer to variable which the denominator is saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If 'base_freq' or 'timestamp_interval' is 0, or 'pull' is
+ *             invalid.
+ */
+int avtp_crf_get_period(const struct avtp_crf_hdr *hdr, uint64_t *num,
+							uint64_t *den);
+
+/* Convert 'n' CRF timestamps between network and host order (both ways are
+ * the same operation), using the fastest kernel supported by the running
+ * CPU. 'src' and 'dst' don't need to be aligned and may be the same array.
+ */
+void avtp_crf_data_swap(void *dst, const void *src, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
@@ -30,194 +30,57 @@
 
 #include "avtp.h"
 #include "avtp_cvf.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "avtp_stream.h"
 #include "util.h"
 
-#define SHIFT_FORMAT		(31 - 7)
-#define SHIFT_FORMAT_SUBTYPE	(31 - 15)
-#define SHIFT_M			(31 - 19)
-#define SHIFT_EVT		(31 - 23)
-#define SHIFT_PTV		(31 - 18)
-
-#define MASK_FORMAT		(BITMASK(8) << SHIFT_FORMAT)
-#define MASK_FORMAT_SUBTYPE	(BITMASK(8) << SHIFT_FORMAT_SUBTYPE)
-#define MASK_M			(BITMASK(1) << SHIFT_M)
-#define MASK_EVT		(BITMASK(4) << SHIFT_EVT)
-#define MASK_PTV		(BITMASK(1) << SHIFT_PTV)
-
-static int get_field_value(const struct avtp_stream_pdu *pdu,
-				enum avtp_cvf_field field, uint64_t *val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-
-	switch (field) {
-	case AVTP_CVF_FIELD_FORMAT:
-		mask = MASK_FORMAT;
-		shift = SHIFT_FORMAT;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_CVF_FIELD_FORMAT_SUBTYPE:
-		mask = MASK_FORMAT_SUBTYPE;
-		shift = SHIFT_FORMAT_SUBTYPE;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_CVF_FIELD_M:
-		mask = MASK_M;
-		shift = SHIFT_M;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_CVF_FIELD_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_CVF_FIELD_H264_PTV:
-		mask = MASK_PTV;
-		shift = SHIFT_PTV;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
-
-	return 0;
-}
+#define SHIFT_FORMAT		AVTP_CVF_SHIFT_FORMAT
+#define SHIFT_FORMAT_SUBTYPE	AVTP_CVF_SHIFT_FORMAT_SUBTYPE
+#define SHIFT_M			AVTP_CVF_SHIFT_M
+#define SHIFT_EVT		AVTP_CVF_SHIFT_EVT
+#define SHIFT_PTV		AVTP_CVF_SHIFT_H264_PTV
+
+#define MASK_FORMAT		AVTP_CVF_MASK_FORMAT
+#define MASK_FORMAT_SUBTYPE	AVTP_CVF_MASK_FORMAT_SUBTYPE
+#define MASK_M			AVTP_CVF_MASK_M
+#define MASK_EVT		AVTP_CVF_MASK_EVT
+#define MASK_PTV		AVTP_CVF_MASK_H264_PTV
+
+static const struct avtp_field_desc fields[AVTP_CVF_FIELD_MAX] = {
+	AVTP_STREAM_FIELD_DESCS,
+	[AVTP_CVF_FIELD_FORMAT] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_FORMAT),
+	[AVTP_CVF_FIELD_FORMAT_SUBTYPE] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_FORMAT_SUBTYPE),
+	[AVTP_CVF_FIELD_M] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_M),
+	[AVTP_CVF_FIELD_EVT] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_EVT),
+	[AVTP_CVF_FIELD_H264_PTV] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_PTV),
+	/* This field lives on H.264 header, inside avtp_payload */
+	[AVTP_CVF_FIELD_H264_TIMESTAMP] = AVTP_STREAM_PAYLOAD_FIELD(
+					struct avtp_cvf_h264_payload,
+					h264_header, BITMASK(32)),
+};
 
 int avtp_cvf_pdu_get(const struct avtp_stream_pdu *pdu,
 				enum avtp_cvf_field field, uint64_t *val)
 {
-	int res;
-
 	if (!pdu || !val)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_CVF_FIELD_SV:
-	case AVTP_CVF_FIELD_MR:
-	case AVTP_CVF_FIELD_TV:
-	case AVTP_CVF_FIELD_SEQ_NUM:
-	case AVTP_CVF_FIELD_TU:
-	case AVTP_CVF_FIELD_STREAM_DATA_LEN:
-	case AVTP_CVF_FIELD_TIMESTAMP:
-	case AVTP_CVF_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_get(pdu, (enum avtp_stream_field) field,
-									val);
-		break;
-	case AVTP_CVF_FIELD_FORMAT:
-	case AVTP_CVF_FIELD_FORMAT_SUBTYPE:
-	case AVTP_CVF_FIELD_M:
-	case AVTP_CVF_FIELD_EVT:
-	case AVTP_CVF_FIELD_H264_PTV:
-		res = get_field_value(pdu, field, val);
-		break;
-	case AVTP_CVF_FIELD_H264_TIMESTAMP:
-	{
-		/* This field lives on H.264 header, inside avtp_payload */
-		struct avtp_cvf_h264_payload *pay =
-			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
-		*val = ntohl(pay->h264_header);
-		res = 0;
-		break;
-	}
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
-}
-
-static int set_field_value(struct avtp_stream_pdu *pdu,
-				enum avtp_cvf_field field, uint32_t val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-	void *ptr;
-
-	switch (field) {
-	case AVTP_CVF_FIELD_FORMAT:
-		mask = MASK_FORMAT;
-		shift = SHIFT_FORMAT;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_CVF_FIELD_FORMAT_SUBTYPE:
-		mask = MASK_FORMAT_SUBTYPE;
-		shift = SHIFT_FORMAT_SUBTYPE;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_CVF_FIELD_M:
-		mask = MASK_M;
-		shift = SHIFT_M;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_CVF_FIELD_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_CVF_FIELD_H264_PTV:
-		mask = MASK_PTV;
-		shift = SHIFT_PTV;
-		ptr = &pdu->packet_info;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	bitmap = get_unaligned_be32(ptr);
-
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
-
-	put_unaligned_be32(bitmap, ptr);
-
-	return 0;
+	return avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
 int avtp_cvf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_cvf_field field,
 								uint64_t val)
 {
-	int res;
-
 	if (!pdu)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_CVF_FIELD_SV:
-	case AVTP_CVF_FIELD_MR:
-	case AVTP_CVF_FIELD_TV:
-	case AVTP_CVF_FIELD_SEQ_NUM:
-	case AVTP_CVF_FIELD_TU:
-	case AVTP_CVF_FIELD_STREAM_DATA_LEN:
-	case AVTP_CVF_FIELD_TIMESTAMP:
-	case AVTP_CVF_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_set(pdu, (enum avtp_stream_field) field,
-									val);
-		break;
-	case AVTP_CVF_FIELD_FORMAT:
-	case AVTP_CVF_FIELD_FORMAT_SUBTYPE:
-	case AVTP_CVF_FIELD_M:
-	case AVTP_CVF_FIELD_EVT:
-	case AVTP_CVF_FIELD_H264_PTV:
-		res = set_field_value(pdu, field, val);
-		break;
-	case AVTP_CVF_FIELD_H264_TIMESTAMP:
-	{
-		/* This field lives on H.264 header, inside avtp_payload */
-		struct avtp_cvf_h264_payload *pay =
-			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
-		pay->h264_header = htonl(val);
-		res = 0;
-		break;
-	}
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
 int avtp_cvf_pdu_init(struct avtp_stream_pdu *pdu, uint8_t subtype)
@@ -251,3 +114,68 @@ int avtp_cvf_pdu_init(struct avtp_stream_pdu *pdu, uint8_t subtype)
 
 	return 0;
 }
+
+int avtp_cvf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+						struct avtp_cvf_hdr *hdr)
+{
+	uint32_t format_specific, packet_info;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	format_specific = ntohl(pdu->format_specific);
+	packet_info = ntohl(pdu->packet_info);
+
+	avtp_stream_hdr_decode(&hdr->stream, pdu, ntohl(pdu->subtype_data),
+								packet_info);
+
+	hdr->format = BITMAP_GET_VALUE(format_specific, MASK_FORMAT,
+								SHIFT_FORMAT);
+	hdr->format_subtype = BITMAP_GET_VALUE(format_specific,
+					MASK_FORMAT_SUBTYPE,
+					SHIFT_FORMAT_SUBTYPE);
+	hdr->m = BITMAP_GET_VALUE(packet_info, MASK_M, SHIFT_M);
+	hdr->evt = BITMAP_GET_VALUE(packet_info, MASK_EVT, SHIFT_EVT);
+	hdr->h264_ptv = BITMAP_GET_VALUE(packet_info, MASK_PTV, SHIFT_PTV);
+
+	if (hdr->format_subtype == AVTP_CVF_FORMAT_SUBTYPE_H264) {
+		/* This field lives on H.264 header, inside avtp_payload */
+		struct avtp_cvf_h264_payload *pay =
+			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
+		hdr->h264_timestamp = ntohl(pay->h264_header);
+	} else {
+		hdr->h264_timestamp = 0;
+	}
+
+	return 0;
+}
+
+int avtp_cvf_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_cvf_hdr *hdr)
+{
+	uint32_t format_specific = 0, packet_info = 0;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	BITMAP_SET_VALUE(format_specific, (uint32_t) hdr->format,
+						MASK_FORMAT, SHIFT_FORMAT);
+	BITMAP_SET_VALUE(format_specific, hdr->format_subtype,
+				MASK_FORMAT_SUBTYPE, SHIFT_FORMAT_SUBTYPE);
+	BITMAP_SET_VALUE(packet_info, hdr->m, MASK_M, SHIFT_M);
+	BITMAP_SET_VALUE(packet_info, hdr->evt, MASK_EVT, SHIFT_EVT);
+	BITMAP_SET_VALUE(packet_info, hdr->h264_ptv, MASK_PTV, SHIFT_PTV);
+
+	avtp_stream_hdr_encode(pdu, &hdr->stream, AVTP_SUBTYPE_CVF, 0,
+								packet_info);
+	pdu->format_specific = htonl(format_specific);
+
+	if (hdr->format_subtype == AVTP_CVF_FORMAT_SUBTYPE_H264) {
+		/* This field lives on H.264 header, inside avtp_payload */
+		struct avtp_cvf_h264_payload *pay =
+			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
+		pay->h264_header = htonl(hdr->h264_timestamp);
+	}
+
+	return 0;
+}
@@ -0,0 +1,585 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_cvf.h"
+#include "avtp_inline.h"
+#include "util.h"
+
+/* RFC 6184 NAL unit header fields and FU-A definitions. */
+#define NAL_MASK_F_NRI		0xE0
+#define NAL_MASK_TYPE		0x1F
+#define NAL_TYPE_STAP_A		24
+#define NAL_TYPE_FU_A		28
+#define FU_HDR_S		0x80
+#define FU_HDR_E		0x40
+#define FU_HDR_LEN		2
+#define STAP_SIZE_LEN		2
+#define START_CODE_LEN		4
+
+#define H264_HDR_LEN		(sizeof(struct avtp_stream_pdu) + \
+					sizeof(struct avtp_cvf_h264_payload))
+#define MAX_DATA_LEN		(UINT16_MAX - \
+					sizeof(struct avtp_cvf_h264_payload))
+
+static const uint8_t start_code[START_CODE_LEN] = { 0x00, 0x00, 0x00, 0x01 };
+
+struct avtp_cvf_h264_depacketizer {
+	/* Frames are rebuilt one after another in 'arena', wrapping around
+	 * to its start when the top is reached.
+	 */
+	uint8_t *arena;
+	size_t size;
+	/* Offset of the oldest frame not released. */
+	size_t read;
+	/* Offset and length of the frame being gathered. */
+	size_t write;
+	size_t len;
+	/* End of the frames left at the top of 'arena' when the frame being
+	 * gathered wrapped around, 0 otherwise.
+	 */
+	size_t wrap_end;
+	/* Frames returned and not released yet. */
+	unsigned int held;
+
+	uint8_t next_seq;
+	bool seq_valid;
+	/* A FU-A fragmented NAL unit is being gathered. */
+	bool in_fu;
+	/* The frame being gathered is damaged so PDUs are skipped up to the
+	 * end of the frame.
+	 */
+	bool discard;
+
+	uint32_t lost_pdus;
+	uint32_t dropped_frames;
+};
+
+/* Return position of the first 3-byte start code prefix (0x000001) found in
+ * [p, end), or 'end' if there is none. memchr() is used to skip straight to
+ * every 0x01 byte, which is then checked for two leading zero bytes.
+ */
+static const uint8_t *find_start_code(const uint8_t *p, const uint8_t *end)
+{
+	if (end - p < 3)
+		return end;
+
+	p += 2;
+	while (p < end && (p = memchr(p, 0x01, end - p))) {
+		if (p[-1] == 0 && p[-2] == 0)
+			return p - 2;
+
+		/* A start code can't end before p + 3 since *p is not zero. */
+		p += 3;
+	}
+
+	return end;
+}
+
+/* Load next non-empty NAL unit from current access unit. Returns false if
+ * there are no NAL units left.
+ */
+static bool load_nal(struct avtp_cvf_h264_packetizer *pkt)
+{
+	while (pkt->next < pkt->end) {
+		const uint8_t *start = pkt->next + 3;
+		const uint8_t *end = find_start_code(start, pkt->end);
+
+		pkt->next = end;
+
+		/* Zero bytes before a start code are either trailing_zero_8bits
+		 * or the leading byte of a 4-byte start code, so they are not
+		 * part of the NAL unit.
+		 */
+		while (end > start && end[-1] == 0)
+			end--;
+
+		if (end > start) {
+			pkt->nal = start;
+			pkt->nal_len = end - start;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int avtp_cvf_h264_packetizer_init(struct avtp_cvf_h264_packetizer *pkt,
+					const struct avtp_stream_pdu *tmpl,
+					size_t max_pdu_size)
+{
+	size_t max_data_len;
+
+	if (!pkt || !tmpl)
+		return -EINVAL;
+
+	if (avtp_common_get_subtype((const struct avtp_common_pdu *) tmpl) !=
+							AVTP_SUBTYPE_CVF)
+		return -EINVAL;
+
+	if (avtp_cvf_get_format_subtype(tmpl) != AVTP_CVF_FORMAT_SUBTYPE_H264)
+		return -EINVAL;
+
+	/* At least one byte of NAL unit data must fit along with the FU-A
+	 * headers.
+	 */
+	if (max_pdu_size <= H264_HDR_LEN + FU_HDR_LEN)
+		return -EINVAL;
+
+	/* 'stream_data_length' also accounts for the H.264 header. */
+	max_data_len = max_pdu_size - H264_HDR_LEN;
+	if (max_data_len > MAX_DATA_LEN)
+		max_data_len = MAX_DATA_LEN;
+
+	memset(pkt, 0, sizeof(*pkt));
+	memcpy(pkt->tmpl, tmpl, sizeof(pkt->tmpl));
+	avtp_cvf_set_m((struct avtp_stream_pdu *) pkt->tmpl, 0);
+	pkt->max_data_len = max_data_len;
+
+	return 0;
+}
+
+int avtp_cvf_h264_packetizer_start(struct avtp_cvf_h264_packetizer *pkt,
+					const void *au, size_t len,
+					uint32_t avtp_time, uint32_t h264_time)
+{
+	struct avtp_stream_pdu *tmpl;
+	struct avtp_cvf_h264_payload *pay;
+	const uint8_t *end;
+
+	if (!pkt || !au)
+		return -EINVAL;
+
+	end = (const uint8_t *) au + len;
+
+	pkt->next = find_start_code(au, end);
+	if (pkt->next == end)
+		return -EINVAL;
+
+	tmpl = (struct avtp_stream_pdu *) pkt->tmpl;
+	pay = (struct avtp_cvf_h264_payload *) tmpl->avtp_payload;
+	pay->h264_header = htonl(h264_time);
+
+	pkt->end = end;
+	pkt->avtp_time = avtp_time;
+	pkt->nal = NULL;
+	pkt->nal_len = 0;
+	pkt->fu_indicator = 0;
+
+	return 0;
+}
+
+int avtp_cvf_h264_packetizer_next(struct avtp_cvf_h264_packetizer *pkt,
+					struct avtp_cvf_h264_packet *packet)
+{
+	const struct avtp_stream_pdu *tmpl;
+	struct avtp_stream_pdu *pdu;
+	struct avtp_cvf_h264_payload *pay;
+	size_t hdr_len, data_len;
+	const uint8_t *data;
+
+	if (!pkt || !packet)
+		return -EINVAL;
+
+	if (pkt->nal_len == 0 && !load_nal(pkt))
+		return 0;
+
+	tmpl = (const struct avtp_stream_pdu *) pkt->tmpl;
+	pdu = (struct avtp_stream_pdu *) packet->hdr;
+	pay = (struct avtp_cvf_h264_payload *) pdu->avtp_payload;
+	hdr_len = H264_HDR_LEN;
+
+	if (!pkt->fu_indicator && pkt->nal_len <= pkt->max_data_len) {
+		/* Single NAL Unit packet. */
+		data = pkt->nal;
+		data_len = pkt->nal_len;
+	} else {
+		uint8_t fu_header;
+
+		/* FU-A packet. The NAL unit header is not sent as is but
+		 * split between FU indicator and FU header of each fragment.
+		 * 'fu_indicator' is non-zero while a NAL unit is being
+		 * fragmented.
+		 */
+		if (!pkt->fu_indicator) {
+			pkt->fu_indicator = (pkt->nal[0] & NAL_MASK_F_NRI) |
+								NAL_TYPE_FU_A;
+			pkt->fu_type = pkt->nal[0] & NAL_MASK_TYPE;
+			pkt->nal++;
+			pkt->nal_len--;
+			fu_header = FU_HDR_S | pkt->fu_type;
+		} else {
+			fu_header = pkt->fu_type;
+		}
+
+		data = pkt->nal;
+		data_len = pkt->max_data_len - FU_HDR_LEN;
+		if (data_len >= pkt->nal_len) {
+			data_len = pkt->nal_len;
+			fu_header |= FU_HDR_E;
+		}
+
+		pay->h264_data[0] = pkt->fu_indicator;
+		pay->h264_data[1] = fu_header;
+		hdr_len += FU_HDR_LEN;
+	}
+
+	pkt->nal += data_len;
+	pkt->nal_len -= data_len;
+	if (pkt->nal_len == 0)
+		pkt->fu_indicator = 0;
+
+	avtp_stream_pdu_emit(pdu, tmpl, pkt->seq_num++, pkt->avtp_time,
+			hdr_len - sizeof(struct avtp_stream_pdu) + data_len);
+	memcpy(pay, tmpl->avtp_payload, sizeof(*pay));
+
+	/* 'M' flags the last PDU from the access unit. The next NAL unit is
+	 * loaded right away since trailing start codes or zero bytes may
+	 * follow the last one.
+	 */
+	if (pkt->nal_len == 0 && !load_nal(pkt))
+		avtp_cvf_set_m(pdu, 1);
+
+	packet->iov[0].iov_base = packet->hdr;
+	packet->iov[0].iov_len = hdr_len;
+	packet->iov[1].iov_base = (void *) data;
+	packet->iov[1].iov_len = data_len;
+
+	return 1;
+}
+
+int avtp_cvf_h264_depacketizer_create(struct avtp_cvf_h264_depacketizer **depkt,
+							size_t arena_size)
+{
+	struct avtp_cvf_h264_depacketizer *d;
+
+	if (!depkt || arena_size == 0)
+		return -EINVAL;
+
+	d = calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->arena = malloc(arena_size);
+	if (!d->arena) {
+		free(d);
+		return -ENOMEM;
+	}
+
+	d->size = arena_size;
+	*depkt = d;
+	return 0;
+}
+
+void avtp_cvf_h264_depacketizer_destroy(
+				struct avtp_cvf_h264_depacketizer *depkt)
+{
+	if (!depkt)
+		return;
+
+	free(depkt->arena);
+	free(depkt);
+}
+
+/* Get room for 'n' more bytes of the frame being gathered. Returns NULL if
+ * the arena has no room left.
+ */
+static uint8_t *arena_reserve(struct avtp_cvf_h264_depacketizer *d, size_t n)
+{
+	uint8_t *p;
+
+	if (!d->wrap_end) {
+		if (d->write + d->len + n > d->size) {
+			/* Wrap around, moving what is gathered so far. Free
+			 * room ends at the oldest frame, if any.
+			 */
+			if (d->held == 0) {
+				if (d->len + n > d->size)
+					return NULL;
+
+				d->read = 0;
+			} else {
+				if (d->len + n > d->read)
+					return NULL;
+
+				d->wrap_end = d->write;
+			}
+
+			memmove(d->arena, d->arena + d->write, d->len);
+			d->write = 0;
+		}
+	} else if (d->write + d->len + n > d->read) {
+		return NULL;
+	}
+
+	p = d->arena + d->write + d->len;
+	d->len += n;
+	return p;
+}
+
+static int append_nal(struct avtp_cvf_h264_depacketizer *d,
+						const uint8_t *nal, size_t len)
+{
+	uint8_t *p;
+
+	p = arena_reserve(d, START_CODE_LEN + len);
+	if (!p)
+		return -ENOSPC;
+
+	memcpy(p, start_code, START_CODE_LEN);
+	memcpy(p + START_CODE_LEN, nal, len);
+	return 0;
+}
+
+/* Append the NAL units carried by a RFC 6184 packet to the frame being
+ * gathered. Returns -EPROTO if the packet is malformed or out of place.
+ */
+static int depacketize(struct avtp_cvf_h264_depacketizer *d,
+					const uint8_t *data, size_t len)
+{
+	uint8_t type, fu_header;
+	int res;
+
+	if (len == 0)
+		return -EPROTO;
+
+	type = data[0] & NAL_MASK_TYPE;
+
+	if (type == NAL_TYPE_FU_A) {
+		if (len <= FU_HDR_LEN)
+			return -EPROTO;
+
+		fu_header = data[1];
+
+		if (fu_header & FU_HDR_S) {
+			uint8_t *p;
+
+			if (d->in_fu)
+				return -EPROTO;
+
+			/* Rebuild NAL unit header from FU indicator and FU
+			 * header.
+			 */
+			p = arena_reserve(d, START_CODE_LEN + 1 +
+							len - FU_HDR_LEN);
+			if (!p)
+				return -ENOSPC;
+
+			memcpy(p, start_code, START_CODE_LEN);
+			p[START_CODE_LEN] = (data[0] & NAL_MASK_F_NRI) |
+						(fu_header & NAL_MASK_TYPE);
+			memcpy(p + START_CODE_LEN + 1, data + FU_HDR_LEN,
+							len - FU_HDR_LEN);
+			d->in_fu = true;
+		} else {
+			uint8_t *p;
+
+			if (!d->in_fu)
+				return -EPROTO;
+
+			p = arena_reserve(d, len - FU_HDR_LEN);
+			if (!p)
+				return -ENOSPC;
+
+			memcpy(p, data + FU_HDR_LEN, len - FU_HDR_LEN);
+		}
+
+		if (fu_header & FU_HDR_E)
+			d->in_fu = false;
+
+		return 0;
+	}
+
+	if (d->in_fu)
+		return -EPROTO;
+
+	if (type == NAL_TYPE_STAP_A) {
+		const uint8_t *p = data + 1, *end = data + len;
+
+		if (p == end)
+			return -EPROTO;
+
+		while (p < end) {
+			size_t size;
+
+			if (end - p < STAP_SIZE_LEN)
+				return -EPROTO;
+
+			size = get_unaligned_be16(p);
+			p += STAP_SIZE_LEN;
+			if (size == 0 || size > (size_t) (end - p))
+				return -EPROTO;
+
+			res = append_nal(d, p, size);
+			if (res < 0)
+				return res;
+
+			p += size;
+		}
+
+		return 0;
+	}
+
+	/* Single NAL Unit packet. Types beyond STAP-A, but FU-A, are only
+	 * used in interleaved mode, which is not supported.
+	 */
+	if (type == 0 || type > NAL_TYPE_STAP_A)
+		return -EPROTO;
+
+	return append_nal(d, data, len);
+}
+
+/* Drop the frame being gathered and skip PDUs up to the end of the frame. */
+static void drop_frame(struct avtp_cvf_h264_depacketizer *d)
+{
+	if (!d->discard) {
+		d->discard = true;
+		d->dropped_frames++;
+	}
+
+	d->len = 0;
+	d->in_fu = false;
+}
+
+int avtp_cvf_h264_depacketizer_push(struct avtp_cvf_h264_depacketizer *depkt,
+					const struct avtp_stream_pdu *pdu,
+					size_t len,
+					struct avtp_cvf_h264_frame *frame)
+{
+	const struct avtp_cvf_h264_payload *pay;
+	struct avtp_cvf_hdr hdr;
+	size_t data_len;
+	int res, ret = 0;
+
+	if (!depkt || !pdu || !frame || len < H264_HDR_LEN)
+		return -EINVAL;
+
+	if (avtp_common_get_subtype((const struct avtp_common_pdu *) pdu) !=
+							AVTP_SUBTYPE_CVF)
+		return -EINVAL;
+
+	res = avtp_cvf_pdu_unpack(pdu, &hdr);
+	if (res < 0)
+		return res;
+
+	if (hdr.format_subtype != AVTP_CVF_FORMAT_SUBTYPE_H264)
+		return -EINVAL;
+
+	if (hdr.stream.stream_data_len < sizeof(*pay) ||
+			hdr.stream.stream_data_len > len - sizeof(*pdu))
+		return -EINVAL;
+
+	/* Duplicate or reordered PDUs carry data already gathered, or data
+	 * from a frame already given up on, so they are skipped.
+	 */
+	if (depkt->seq_valid &&
+		(int8_t) (hdr.stream.seq_num - depkt->next_seq) < 0)
+		return 0;
+
+	/* Any PDU missing damages the frame being gathered. */
+	if (depkt->seq_valid && hdr.stream.seq_num != depkt->next_seq) {
+		depkt->lost_pdus += (uint8_t) (hdr.stream.seq_num -
+							depkt->next_seq);
+		drop_frame(depkt);
+	}
+
+	depkt->next_seq = hdr.stream.seq_num + 1;
+	depkt->seq_valid = true;
+
+	if (!depkt->discard) {
+		pay = (const struct avtp_cvf_h264_payload *) pdu->avtp_payload;
+		data_len = hdr.stream.stream_data_len - sizeof(*pay);
+
+		res = depacketize(depkt, pay->h264_data, data_len);
+		if (res < 0) {
+			drop_frame(depkt);
+			if (res == -ENOSPC)
+				ret = -ENOSPC;
+		}
+	}
+
+	if (!hdr.m)
+		return ret;
+
+	/* A NAL unit left unterminated also damages the frame. */
+	if (depkt->in_fu)
+		drop_frame(depkt);
+
+	if (depkt->discard || depkt->len == 0) {
+		depkt->discard = false;
+		depkt->len = 0;
+		return ret;
+	}
+
+	frame->data = depkt->arena + depkt->write;
+	frame->len = depkt->len;
+	frame->avtp_time = hdr.stream.timestamp;
+	frame->h264_time = hdr.h264_timestamp;
+	frame->h264_ptv = hdr.h264_ptv;
+	frame->lost_pdus = depkt->lost_pdus;
+	frame->dropped_frames = depkt->dropped_frames;
+
+	depkt->write += depkt->len;
+	depkt->len = 0;
+	depkt->held++;
+	depkt->lost_pdus = 0;
+	depkt->dropped_frames = 0;
+
+	return 1;
+}
+
+int avtp_cvf_h264_depacketizer_release(struct avtp_cvf_h264_depacketizer *depkt,
+				const struct avtp_cvf_h264_frame *frame)
+{
+	if (!depkt || !frame)
+		return -EINVAL;
+
+	if (depkt->held == 0 || frame->data != depkt->arena + depkt->read)
+		return -EINVAL;
+
+	depkt->held--;
+	depkt->read += frame->len;
+
+	if (depkt->held == 0) {
+		/* Nothing held, free room starts at the frame being
+		 * gathered.
+		 */
+		depkt->read = depkt->write;
+		depkt->wrap_end = 0;
+	} else if (depkt->read == depkt->wrap_end) {
+		depkt->read = 0;
+		depkt->wrap_end = 0;
+	}
+
+	return 0;
+}
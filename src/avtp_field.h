@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "util.h"
+
+#pragma GCC visibility push(hidden)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Descriptor of a PDU field. A field is a continuous bit field within a big
+ * endian 32-bit or 64-bit word located 'offset' bytes from the beginning of
+ * the PDU. Formats describe their fields with a constant table indexed by
+ * their field enum, so getting or setting a field is a table lookup followed
+ * by a shift and a mask instead of a switch over every field.
+ *
+ * Entries with 'size' equal to 0 don't describe any field and are rejected
+ * by avtp_field_get() and avtp_field_set().
+ */
+struct avtp_field_desc {
+	uint8_t offset;
+	uint8_t size;
+	uint8_t shift;
+	uint8_t width;
+};
+
+/* Build a descriptor for the field at the position represented by 'mask'
+ * (e.g. AVTP_AAF_MASK_NSR) within the 'size' bytes word at 'offset'. The
+ * 'mask' parameter must be a continuous bit mask, just like in
+ * BITMAP_GET_VALUE().
+ */
+#define AVTP_FIELD_DESC(off, sz, mask)					\
+	{								\
+		.offset = (off),					\
+		.size = (sz),						\
+		.shift = __builtin_ctzll(mask),				\
+		.width = __builtin_popcountll(mask),			\
+	}
+
+/* Same as AVTP_FIELD_DESC() for a field from the 'word' member of 'type'. */
+#define AVTP_FIELD(type, word, mask)					\
+	AVTP_FIELD_DESC(offsetof(type, word),				\
+			sizeof(((type *) 0)->word), (mask))
+
+/* Get value from PDU field described by 'desc[field]'.
+ * @desc: Descriptor table.
+ * @count: Number of entries from 'desc'.
+ * @pdu: Pointer to PDU.
+ * @field: PDU field to be retrieved.
+ * @val: Pointer to variable which the retrieved value should be saved.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If 'field' isn't described by 'desc'.
+ */
+static inline int avtp_field_get(const struct avtp_field_desc *desc,
+				size_t count, const void *pdu,
+				unsigned int field, uint64_t *val)
+{
+	const uint8_t *ptr;
+	uint64_t word;
+
+	if (field >= count || !desc[field].size)
+		return -EINVAL;
+
+	desc += field;
+	ptr = (const uint8_t *) pdu + desc->offset;
+
+	if (desc->size == sizeof(uint64_t))
+		word = get_unaligned_be64(ptr);
+	else
+		word = get_unaligned_be32(ptr);
+
+	*val = (word >> desc->shift) & (UINT64_MAX >> (64 - desc->width));
+
+	return 0;
+}
+
+/* Set value from PDU field described by 'desc[field]'. Bits from 'val' which
+ * don't fit in the field are discarded.
+ * @desc: Descriptor table.
+ * @count: Number of entries from 'desc'.
+ * @pdu: Pointer to PDU.
+ * @field: PDU field to be set.
+ * @val: Value to be set.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EINVAL: If 'field' isn't described by 'desc'.
+ */
+static inline int avtp_field_set(const struct avtp_field_desc *desc,
+				size_t count, void *pdu, unsigned int field,
+				uint64_t val)
+{
+	uint64_t word, mask;
+	uint8_t *ptr;
+
+	if (field >= count || !desc[field].size)
+		return -EINVAL;
+
+	desc += field;
+	ptr = (uint8_t *) pdu + desc->offset;
+	mask = (UINT64_MAX >> (64 - desc->width)) << desc->shift;
+
+	if (desc->size == sizeof(uint64_t)) {
+		word = get_unaligned_be64(ptr);
+		BITMAP_SET_VALUE(word, val, mask, desc->shift);
+		put_unaligned_be64(word, ptr);
+	} else {
+		word = get_unaligned_be32(ptr);
+		BITMAP_SET_VALUE(word, val, mask, desc->shift);
+		put_unaligned_be32(word, ptr);
+	}
+
+	return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
@@ -31,13 +31,15 @@
 
 #include "avtp.h"
 #include "avtp_ieciidc.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "avtp_stream.h"
 #include "util.h"
 
-#define SHIFT_GV			(31 - 14)
-#define SHIFT_TAG			(31 - 17)
-#define SHIFT_CHANNEL			(31 - 23)
-#define SHIFT_TCODE			(31 - 27)
+#define SHIFT_GV			AVTP_IECIIDC_SHIFT_GV
+#define SHIFT_TAG			AVTP_IECIIDC_SHIFT_TAG
+#define SHIFT_CHANNEL			AVTP_IECIIDC_SHIFT_CHANNEL
+#define SHIFT_TCODE			AVTP_IECIIDC_SHIFT_TCODE
 #define SHIFT_QI_1			(31 - 1)
 #define SHIFT_QI_2			(31 - 1)
 #define SHIFT_SID			(31 - 7)
@@ -54,11 +56,11 @@
 #define SHIFT_NO_DATA			(31 - 15)
 #define SHIFT_ND			(31 - 8)
 
-#define MASK_GV				(BITMASK(1) << SHIFT_GV)
-#define MASK_TAG			(BITMASK(2) << SHIFT_TAG)
-#define MASK_CHANNEL			(BITMASK(6) << SHIFT_CHANNEL)
-#define MASK_TCODE			(BITMASK(4) << SHIFT_TCODE)
-#define MASK_SY				(BITMASK(4))
+#define MASK_GV				AVTP_IECIIDC_MASK_GV
+#define MASK_TAG			AVTP_IECIIDC_MASK_TAG
+#define MASK_CHANNEL			AVTP_IECIIDC_MASK_CHANNEL
+#define MASK_TCODE			AVTP_IECIIDC_MASK_TCODE
+#define MASK_SY				AVTP_IECIIDC_MASK_SY
 #define MASK_QI_1			(BITMASK(2) << SHIFT_QI_1)
 #define MASK_QI_2			(BITMASK(2) << SHIFT_QI_2)
 #define MASK_SID			(BITMASK(6) << SHIFT_SID)
@@ -76,367 +78,58 @@
 #define MASK_NO_DATA			(BITMASK(8) << SHIFT_NO_DATA)
 #define MASK_ND				(BITMASK(1) << SHIFT_ND)
 
-static int get_field_value(const struct avtp_stream_pdu *pdu,
-				enum avtp_ieciidc_field field, uint64_t *val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-
-	struct avtp_ieciidc_cip_payload *pay =
-			(struct avtp_ieciidc_cip_payload *) pdu->avtp_payload;
-
-	switch (field) {
-	case AVTP_IECIIDC_FIELD_GV:
-		mask = MASK_GV;
-		shift = SHIFT_GV;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_IECIIDC_FIELD_TAG:
-		mask = MASK_TAG;
-		shift = SHIFT_TAG;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_IECIIDC_FIELD_CHANNEL:
-		mask = MASK_CHANNEL;
-		shift = SHIFT_CHANNEL;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_IECIIDC_FIELD_TCODE:
-		mask = MASK_TCODE;
-		shift = SHIFT_TCODE;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_IECIIDC_FIELD_SY:
-		mask = MASK_SY;
-		shift = 0;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_QI_1:
-		mask = MASK_QI_1;
-		shift = SHIFT_QI_1;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_QI_2:
-		mask = MASK_QI_2;
-		shift = SHIFT_QI_2;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SID:
-		mask = MASK_SID;
-		shift = SHIFT_SID;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_DBS:
-		mask = MASK_DBS;
-		shift = SHIFT_DBS;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_FN:
-		mask = MASK_FN;
-		shift = SHIFT_FN;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_QPC:
-		mask = MASK_QPC;
-		shift = SHIFT_QPC;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SPH:
-		mask = MASK_SPH;
-		shift = SHIFT_SPH;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_DBC:
-		mask = MASK_DBC;
-		shift = 0;
-		bitmap = ntohl(pay->cip_1);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_FMT:
-		mask = MASK_FMT;
-		shift = SHIFT_FMT;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_TSF:
-		mask = MASK_TSF;
-		shift = SHIFT_TSF;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SFC:
-		mask = MASK_SFC;
-		shift = SHIFT_SFC;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_N:
-		mask = MASK_N;
-		shift = SHIFT_N;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_ND:
-		mask = MASK_ND;
-		shift = SHIFT_ND;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_NO_DATA:
-		mask = MASK_NO_DATA;
-		shift = SHIFT_NO_DATA;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SYT:
-		mask = MASK_SYT;
-		shift = 0;
-		bitmap = ntohl(pay->cip_2);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
-
-	return 0;
-}
+/* Fields from CIP header, inside avtp_payload. */
+#define CIP_FIELD(word, mask) \
+	AVTP_STREAM_PAYLOAD_FIELD(struct avtp_ieciidc_cip_payload, word, mask)
+
+static const struct avtp_field_desc fields[AVTP_IECIIDC_FIELD_MAX] = {
+	AVTP_STREAM_FIELD_DESCS,
+	[AVTP_IECIIDC_FIELD_GV] = AVTP_FIELD(struct avtp_stream_pdu,
+					subtype_data, MASK_GV),
+	[AVTP_IECIIDC_FIELD_GATEWAY_INFO] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, BITMASK(32)),
+	[AVTP_IECIIDC_FIELD_TAG] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_TAG),
+	[AVTP_IECIIDC_FIELD_CHANNEL] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_CHANNEL),
+	[AVTP_IECIIDC_FIELD_TCODE] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_TCODE),
+	[AVTP_IECIIDC_FIELD_SY] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_SY),
+	[AVTP_IECIIDC_FIELD_CIP_QI_1] = CIP_FIELD(cip_1, MASK_QI_1),
+	[AVTP_IECIIDC_FIELD_CIP_SID] = CIP_FIELD(cip_1, MASK_SID),
+	[AVTP_IECIIDC_FIELD_CIP_DBS] = CIP_FIELD(cip_1, MASK_DBS),
+	[AVTP_IECIIDC_FIELD_CIP_FN] = CIP_FIELD(cip_1, MASK_FN),
+	[AVTP_IECIIDC_FIELD_CIP_QPC] = CIP_FIELD(cip_1, MASK_QPC),
+	[AVTP_IECIIDC_FIELD_CIP_SPH] = CIP_FIELD(cip_1, MASK_SPH),
+	[AVTP_IECIIDC_FIELD_CIP_DBC] = CIP_FIELD(cip_1, MASK_DBC),
+	[AVTP_IECIIDC_FIELD_CIP_QI_2] = CIP_FIELD(cip_2, MASK_QI_2),
+	[AVTP_IECIIDC_FIELD_CIP_FMT] = CIP_FIELD(cip_2, MASK_FMT),
+	[AVTP_IECIIDC_FIELD_CIP_SYT] = CIP_FIELD(cip_2, MASK_SYT),
+	[AVTP_IECIIDC_FIELD_CIP_TSF] = CIP_FIELD(cip_2, MASK_TSF),
+	[AVTP_IECIIDC_FIELD_CIP_EVT] = CIP_FIELD(cip_2, MASK_EVT),
+	[AVTP_IECIIDC_FIELD_CIP_SFC] = CIP_FIELD(cip_2, MASK_SFC),
+	[AVTP_IECIIDC_FIELD_CIP_N] = CIP_FIELD(cip_2, MASK_N),
+	[AVTP_IECIIDC_FIELD_CIP_ND] = CIP_FIELD(cip_2, MASK_ND),
+	[AVTP_IECIIDC_FIELD_CIP_NO_DATA] = CIP_FIELD(cip_2, MASK_NO_DATA),
+};
 
 int avtp_ieciidc_pdu_get(const struct avtp_stream_pdu *pdu,
 				enum avtp_ieciidc_field field, uint64_t *val)
 {
-	int res;
-
 	if (!pdu || !val)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_IECIIDC_FIELD_SV:
-	case AVTP_IECIIDC_FIELD_MR:
-	case AVTP_IECIIDC_FIELD_TV:
-	case AVTP_IECIIDC_FIELD_SEQ_NUM:
-	case AVTP_IECIIDC_FIELD_TU:
-	case AVTP_IECIIDC_FIELD_STREAM_DATA_LEN:
-	case AVTP_IECIIDC_FIELD_TIMESTAMP:
-	case AVTP_IECIIDC_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_get(pdu, (enum avtp_stream_field) field,
-									val);
-		break;
-	case AVTP_IECIIDC_FIELD_GV:
-	case AVTP_IECIIDC_FIELD_TAG:
-	case AVTP_IECIIDC_FIELD_CHANNEL:
-	case AVTP_IECIIDC_FIELD_TCODE:
-	case AVTP_IECIIDC_FIELD_SY:
-	case AVTP_IECIIDC_FIELD_CIP_QI_1:
-	case AVTP_IECIIDC_FIELD_CIP_QI_2:
-	case AVTP_IECIIDC_FIELD_CIP_SID:
-	case AVTP_IECIIDC_FIELD_CIP_DBS:
-	case AVTP_IECIIDC_FIELD_CIP_FN:
-	case AVTP_IECIIDC_FIELD_CIP_QPC:
-	case AVTP_IECIIDC_FIELD_CIP_SPH:
-	case AVTP_IECIIDC_FIELD_CIP_DBC:
-	case AVTP_IECIIDC_FIELD_CIP_FMT:
-	case AVTP_IECIIDC_FIELD_CIP_TSF:
-	case AVTP_IECIIDC_FIELD_CIP_EVT:
-	case AVTP_IECIIDC_FIELD_CIP_SFC:
-	case AVTP_IECIIDC_FIELD_CIP_N:
-	case AVTP_IECIIDC_FIELD_CIP_ND:
-	case AVTP_IECIIDC_FIELD_CIP_NO_DATA:
-	case AVTP_IECIIDC_FIELD_CIP_SYT:
-		res = get_field_value(pdu, field, val);
-		break;
-	case AVTP_IECIIDC_FIELD_GATEWAY_INFO:
-		*val = ntohl(pdu->format_specific);
-		res = 0;
-		break;
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
-}
-
-static int set_field_value(struct avtp_stream_pdu *pdu,
-			enum avtp_ieciidc_field field, uint64_t value)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-	void *ptr;
-
-	struct avtp_ieciidc_cip_payload *pay =
-			(struct avtp_ieciidc_cip_payload *) pdu->avtp_payload;
-
-	switch (field) {
-	case AVTP_IECIIDC_FIELD_GV:
-		mask = MASK_GV;
-		shift = SHIFT_GV;
-		ptr = &pdu->subtype_data;
-		break;
-	case AVTP_IECIIDC_FIELD_TAG:
-		mask = MASK_TAG;
-		shift = SHIFT_TAG;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_IECIIDC_FIELD_CHANNEL:
-		mask = MASK_CHANNEL;
-		shift = SHIFT_CHANNEL;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_IECIIDC_FIELD_TCODE:
-		mask = MASK_TCODE;
-		shift = SHIFT_TCODE;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_IECIIDC_FIELD_SY:
-		mask = MASK_SY;
-		shift = 0;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_QI_1:
-		mask = MASK_QI_1;
-		shift = SHIFT_QI_1;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_QI_2:
-		mask = MASK_QI_2;
-		shift = SHIFT_QI_2;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SID:
-		mask = MASK_SID;
-		shift = SHIFT_SID;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_DBS:
-		mask = MASK_DBS;
-		shift = SHIFT_DBS;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_FN:
-		mask = MASK_FN;
-		shift = SHIFT_FN;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_QPC:
-		mask = MASK_QPC;
-		shift = SHIFT_QPC;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SPH:
-		mask = MASK_SPH;
-		shift = SHIFT_SPH;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_DBC:
-		mask = MASK_DBC;
-		shift = 0;
-		ptr = &pay->cip_1;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_FMT:
-		mask = MASK_FMT;
-		shift = SHIFT_FMT;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_TSF:
-		mask = MASK_TSF;
-		shift = SHIFT_TSF;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SFC:
-		mask = MASK_SFC;
-		shift = SHIFT_SFC;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_N:
-		mask = MASK_N;
-		shift = SHIFT_N;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_ND:
-		mask = MASK_ND;
-		shift = SHIFT_ND;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_NO_DATA:
-		mask = MASK_NO_DATA;
-		shift = SHIFT_NO_DATA;
-		ptr = &pay->cip_2;
-		break;
-	case AVTP_IECIIDC_FIELD_CIP_SYT:
-		mask = MASK_SYT;
-		shift = 0;
-		ptr = &pay->cip_2;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	bitmap = get_unaligned_be32(ptr);
-
-	BITMAP_SET_VALUE(bitmap, value, mask, shift);
-
-	put_unaligned_be32(bitmap, ptr);
-
-	return 0;
+	return avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
 int avtp_ieciidc_pdu_set(struct avtp_stream_pdu *pdu,
 			enum avtp_ieciidc_field field, uint64_t value)
 {
-	int res;
-
 	if (!pdu)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_IECIIDC_FIELD_SV:
-	case AVTP_IECIIDC_FIELD_MR:
-	case AVTP_IECIIDC_FIELD_TV:
-	case AVTP_IECIIDC_FIELD_SEQ_NUM:
-	case AVTP_IECIIDC_FIELD_TU:
-	case AVTP_IECIIDC_FIELD_STREAM_DATA_LEN:
-	case AVTP_IECIIDC_FIELD_TIMESTAMP:
-	case AVTP_IECIIDC_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_set(pdu, (enum avtp_stream_field) field,
-									value);
-		break;
-	case AVTP_IECIIDC_FIELD_GV:
-	case AVTP_IECIIDC_FIELD_TAG:
-	case AVTP_IECIIDC_FIELD_CHANNEL:
-	case AVTP_IECIIDC_FIELD_TCODE:
-	case AVTP_IECIIDC_FIELD_SY:
-	case AVTP_IECIIDC_FIELD_CIP_QI_1:
-	case AVTP_IECIIDC_FIELD_CIP_QI_2:
-	case AVTP_IECIIDC_FIELD_CIP_SID:
-	case AVTP_IECIIDC_FIELD_CIP_DBS:
-	case AVTP_IECIIDC_FIELD_CIP_FN:
-	case AVTP_IECIIDC_FIELD_CIP_QPC:
-	case AVTP_IECIIDC_FIELD_CIP_SPH:
-	case AVTP_IECIIDC_FIELD_CIP_DBC:
-	case AVTP_IECIIDC_FIELD_CIP_FMT:
-	case AVTP_IECIIDC_FIELD_CIP_TSF:
-	case AVTP_IECIIDC_FIELD_CIP_EVT:
-	case AVTP_IECIIDC_FIELD_CIP_SFC:
-	case AVTP_IECIIDC_FIELD_CIP_N:
-	case AVTP_IECIIDC_FIELD_CIP_ND:
-	case AVTP_IECIIDC_FIELD_CIP_NO_DATA:
-	case AVTP_IECIIDC_FIELD_CIP_SYT:
-		res = set_field_value(pdu, field, value);
-		break;
-	case AVTP_IECIIDC_FIELD_GATEWAY_INFO:
-		pdu->format_specific = htonl(value);
-		res = 0;
-		break;
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, value);
 }
 
 int avtp_ieciidc_pdu_init(struct avtp_stream_pdu *pdu, uint8_t tag)
@@ -468,3 +161,111 @@ int avtp_ieciidc_pdu_init(struct avtp_stream_pdu *pdu, uint8_t tag)
 
 	return 0;
 }
+
+int avtp_ieciidc_pdu_unpack(const struct avtp_stream_pdu *pdu,
+					struct avtp_ieciidc_hdr *hdr)
+{
+	uint32_t subtype_data, packet_info, cip_1, cip_2;
+	struct avtp_ieciidc_cip_payload *pay;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	subtype_data = ntohl(pdu->subtype_data);
+	packet_info = ntohl(pdu->packet_info);
+
+	avtp_stream_hdr_decode(&hdr->stream, pdu, subtype_data, packet_info);
+
+	hdr->gv = BITMAP_GET_VALUE(subtype_data, MASK_GV, SHIFT_GV);
+	hdr->gateway_info = ntohl(pdu->format_specific);
+	hdr->tag = BITMAP_GET_VALUE(packet_info, MASK_TAG, SHIFT_TAG);
+	hdr->channel = BITMAP_GET_VALUE(packet_info, MASK_CHANNEL,
+								SHIFT_CHANNEL);
+	hdr->tcode = BITMAP_GET_VALUE(packet_info, MASK_TCODE, SHIFT_TCODE);
+	hdr->sy = BITMAP_GET_VALUE(packet_info, MASK_SY, 0);
+
+	if (hdr->tag != AVTP_IECIIDC_TAG_CIP) {
+		cip_1 = 0;
+		cip_2 = 0;
+	} else {
+		pay = (struct avtp_ieciidc_cip_payload *) pdu->avtp_payload;
+		cip_1 = get_unaligned_be32(&pay->cip_1);
+		cip_2 = get_unaligned_be32(&pay->cip_2);
+	}
+
+	hdr->cip_qi_1 = BITMAP_GET_VALUE(cip_1, MASK_QI_1, SHIFT_QI_1);
+	hdr->cip_sid = BITMAP_GET_VALUE(cip_1, MASK_SID, SHIFT_SID);
+	hdr->cip_dbs = BITMAP_GET_VALUE(cip_1, MASK_DBS, SHIFT_DBS);
+	hdr->cip_fn = BITMAP_GET_VALUE(cip_1, MASK_FN, SHIFT_FN);
+	hdr->cip_qpc = BITMAP_GET_VALUE(cip_1, MASK_QPC, SHIFT_QPC);
+	hdr->cip_sph = BITMAP_GET_VALUE(cip_1, MASK_SPH, SHIFT_SPH);
+	hdr->cip_dbc = BITMAP_GET_VALUE(cip_1, MASK_DBC, 0);
+	hdr->cip_qi_2 = BITMAP_GET_VALUE(cip_2, MASK_QI_2, SHIFT_QI_2);
+	hdr->cip_fmt = BITMAP_GET_VALUE(cip_2, MASK_FMT, SHIFT_FMT);
+	hdr->cip_tsf = BITMAP_GET_VALUE(cip_2, MASK_TSF, SHIFT_TSF);
+	hdr->cip_evt = BITMAP_GET_VALUE(cip_2, MASK_EVT, SHIFT_EVT);
+	hdr->cip_sfc = BITMAP_GET_VALUE(cip_2, MASK_SFC, SHIFT_SFC);
+	hdr->cip_n = BITMAP_GET_VALUE(cip_2, MASK_N, SHIFT_N);
+	hdr->cip_nd = BITMAP_GET_VALUE(cip_2, MASK_ND, SHIFT_ND);
+	hdr->cip_no_data = BITMAP_GET_VALUE(cip_2, MASK_NO_DATA,
+								SHIFT_NO_DATA);
+	hdr->cip_syt = BITMAP_GET_VALUE(cip_2, MASK_SYT, 0);
+
+	return 0;
+}
+
+int avtp_ieciidc_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_ieciidc_hdr *hdr)
+{
+	uint32_t subtype_data = 0, packet_info = 0, cip_1 = 0, cip_2 = 0;
+	struct avtp_ieciidc_cip_payload *pay;
+	uint32_t fdf;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	BITMAP_SET_VALUE(subtype_data, hdr->gv, MASK_GV, SHIFT_GV);
+	BITMAP_SET_VALUE(packet_info, hdr->tag, MASK_TAG, SHIFT_TAG);
+	BITMAP_SET_VALUE(packet_info, hdr->channel, MASK_CHANNEL,
+								SHIFT_CHANNEL);
+	BITMAP_SET_VALUE(packet_info, hdr->tcode, MASK_TCODE, SHIFT_TCODE);
+	BITMAP_SET_VALUE(packet_info, hdr->sy, MASK_SY, 0);
+
+	avtp_stream_hdr_encode(pdu, &hdr->stream, AVTP_SUBTYPE_61883_IIDC,
+						subtype_data, packet_info);
+	pdu->format_specific = htonl(hdr->gateway_info);
+
+	if (hdr->tag != AVTP_IECIIDC_TAG_CIP)
+		return 0;
+
+	BITMAP_SET_VALUE(cip_1, (uint32_t) hdr->cip_qi_1, MASK_QI_1,
+								SHIFT_QI_1);
+	BITMAP_SET_VALUE(cip_1, hdr->cip_sid, MASK_SID, SHIFT_SID);
+	BITMAP_SET_VALUE(cip_1, hdr->cip_dbs, MASK_DBS, SHIFT_DBS);
+	BITMAP_SET_VALUE(cip_1, hdr->cip_fn, MASK_FN, SHIFT_FN);
+	BITMAP_SET_VALUE(cip_1, hdr->cip_qpc, MASK_QPC, SHIFT_QPC);
+	BITMAP_SET_VALUE(cip_1, hdr->cip_sph, MASK_SPH, SHIFT_SPH);
+	BITMAP_SET_VALUE(cip_1, hdr->cip_dbc, MASK_DBC, 0);
+	BITMAP_SET_VALUE(cip_2, (uint32_t) hdr->cip_qi_2, MASK_QI_2,
+								SHIFT_QI_2);
+	BITMAP_SET_VALUE(cip_2, hdr->cip_fmt, MASK_FMT, SHIFT_FMT);
+	BITMAP_SET_VALUE(cip_2, hdr->cip_syt, MASK_SYT, 0);
+
+	/* FDF fields overlap each other so they can't simply be set one after
+	 * the other, otherwise the last one would clear bits from the previous
+	 * ones.
+	 */
+	fdf = ((hdr->cip_no_data << SHIFT_NO_DATA) & MASK_NO_DATA) |
+		((hdr->cip_tsf << SHIFT_TSF) & MASK_TSF) |
+		((hdr->cip_evt << SHIFT_EVT) & MASK_EVT) |
+		((hdr->cip_sfc << SHIFT_SFC) & MASK_SFC) |
+		((hdr->cip_n << SHIFT_N) & MASK_N) |
+		((hdr->cip_nd << SHIFT_ND) & MASK_ND);
+	cip_2 |= fdf;
+
+	pay = (struct avtp_ieciidc_cip_payload *) pdu->avtp_payload;
+	put_unaligned_be32(cip_1, &pay->cip_1);
+	put_unaligned_be32(cip_2, &pay->cip_2);
+
+	return 0;
+}
@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_cpu.h"
+#include "avtp_ieciidc.h"
+#include "util.h"
+
+#define CIP_HDR_LEN		sizeof(struct avtp_ieciidc_cip_payload)
+#define QUADLET_LEN		sizeof(uint32_t)
+#define FDF_NO_DATA		0xFF
+
+#define LABEL_MBLA		((uint32_t) AVTP_IECIIDC_AM824_LABEL_MBLA << 24)
+
+#define NSEC_PER_SEC		1000000000ULL
+/* The 1394 cycle timer ticks at 24.576 MHz, 3072 ticks per 125 us cycle.
+ * SYT only carries the 4 least significant bits of the cycle count, so it
+ * wraps around every 16 cycles.
+ */
+#define TICKS_PER_CYCLE		3072
+#define NSEC_PER_CYCLE		125000
+#define SYT_CYCLES		16
+
+/* Quadlets converted by the kernel self-test: a few vectors of every width
+ * plus a tail.
+ */
+#define CHECK_LEN		71
+
+/* Conversion kernels between host order samples and network order AM824
+ * quadlets. Payload pointers don't need to be aligned.
+ */
+struct am824_ops {
+	/* Write 'n' quadlets made of an MBLA label and the 24 most
+	 * significant bits from each sample, big endian.
+	 */
+	void (*label)(void *dst, const int32_t *src, size_t n);
+	/* Strip labels from 'n' quadlets, placing their 24-bit samples into
+	 * the most significant bits of each destination sample.
+	 */
+	void (*strip)(int32_t *dst, const void *src, size_t n);
+};
+
+static void label_generic(void *dst, const int32_t *src, size_t n)
+{
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		put_unaligned_be32(((uint32_t) src[i] >> 8) | LABEL_MBLA,
+								d + i * 4);
+}
+
+static void strip_generic(int32_t *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = (int32_t) (get_unaligned_be32(s + i * 4) << 8);
+}
+
+static const struct am824_ops generic_ops = {
+	.label = label_generic,
+	.strip = strip_generic,
+};
+
+#ifdef HAVE_X86_KERNELS
+
+/* Swap bytes from each 32-bit word. SSE2 has no byte shuffle so 16-bit halves
+ * are swapped first, then bytes from each half.
+ */
+__attribute__((target("sse2")))
+static inline __m128i bswap32_sse2(__m128i v)
+{
+	v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+	v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+
+	return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+__attribute__((target("sse2")))
+static void label_sse2(void *dst, const int32_t *src, size_t n)
+{
+	const __m128i label = _mm_set1_epi32(LABEL_MBLA);
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+
+		v = _mm_or_si128(_mm_srli_epi32(v, 8), label);
+		_mm_storeu_si128((__m128i *) (d + i * 4), bswap32_sse2(v));
+	}
+
+	label_generic(d + i * 4, src + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void strip_sse2(int32_t *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 4));
+
+		v = _mm_slli_epi32(bswap32_sse2(v), 8);
+		_mm_storeu_si128((__m128i *) (dst + i), v);
+	}
+
+	strip_generic(dst + i, s + i * 4, n - i);
+}
+
+static const struct am824_ops sse2_ops = {
+	.label = label_sse2,
+	.strip = strip_sse2,
+};
+
+/* With a byte shuffle, both directions are a single one: the 3 most
+ * significant bytes of a host order sample become the 3 least significant
+ * bytes of a quadlet, in big endian order, and vice versa. The byte left
+ * over is the label, which is ORed in or dropped.
+ */
+#define AM824_SHUF_SSE42 _mm_setr_epi8(-1, 3, 2, 1, -1, 7, 6, 5,	\
+					-1, 11, 10, 9, -1, 15, 14, 13)
+
+__attribute__((target("sse4.2")))
+static void label_sse42(void *dst, const int32_t *src, size_t n)
+{
+	const __m128i shuf = AM824_SHUF_SSE42;
+	const __m128i label = _mm_set1_epi32(AVTP_IECIIDC_AM824_LABEL_MBLA);
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+
+		v = _mm_or_si128(_mm_shuffle_epi8(v, shuf), label);
+		_mm_storeu_si128((__m128i *) (d + i * 4), v);
+	}
+
+	label_generic(d + i * 4, src + i, n - i);
+}
+
+__attribute__((target("sse4.2")))
+static void strip_sse42(int32_t *dst, const void *src, size_t n)
+{
+	const __m128i shuf = AM824_SHUF_SSE42;
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (s + i * 4));
+
+		v = _mm_shuffle_epi8(v, shuf);
+		_mm_storeu_si128((__m128i *) (dst + i), v);
+	}
+
+	strip_generic(dst + i, s + i * 4, n - i);
+}
+
+static const struct am824_ops sse42_ops = {
+	.label = label_sse42,
+	.strip = strip_sse42,
+};
+
+#define AM824_SHUF_AVX2 _mm256_setr_epi8(-1, 3, 2, 1, -1, 7, 6, 5,	\
+					-1, 11, 10, 9, -1, 15, 14, 13,	\
+					-1, 3, 2, 1, -1, 7, 6, 5,	\
+					-1, 11, 10, 9, -1, 15, 14, 13)
+
+__attribute__((target("avx2")))
+static void label_avx2(void *dst, const int32_t *src, size_t n)
+{
+	const __m256i shuf = AM824_SHUF_AVX2;
+	const __m256i label = _mm256_set1_epi32(AVTP_IECIIDC_AM824_LABEL_MBLA);
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (src + i));
+
+		v = _mm256_or_si256(_mm256_shuffle_epi8(v, shuf), label);
+		_mm256_storeu_si256((__m256i *) (d + i * 4), v);
+	}
+
+	label_sse2(d + i * 4, src + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void strip_avx2(int32_t *dst, const void *src, size_t n)
+{
+	const __m256i shuf = AM824_SHUF_AVX2;
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (s + i * 4));
+
+		v = _mm256_shuffle_epi8(v, shuf);
+		_mm256_storeu_si256((__m256i *) (dst + i), v);
+	}
+
+	strip_sse2(dst + i, s + i * 4, n - i);
+}
+
+static const struct am824_ops avx2_ops = {
+	.label = label_avx2,
+	.strip = strip_avx2,
+};
+
+__attribute__((target("avx512f,avx512bw")))
+static void label_avx512(void *dst, const int32_t *src, size_t n)
+{
+	const __m512i shuf = _mm512_broadcast_i32x4(AM824_SHUF_SSE42);
+	const __m512i label = _mm512_set1_epi32(AVTP_IECIIDC_AM824_LABEL_MBLA);
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m512i v = _mm512_loadu_si512(src + i);
+
+		v = _mm512_or_si512(_mm512_shuffle_epi8(v, shuf), label);
+		_mm512_storeu_si512(d + i * 4, v);
+	}
+
+	label_avx2(d + i * 4, src + i, n - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void strip_avx512(int32_t *dst, const void *src, size_t n)
+{
+	const __m512i shuf = _mm512_broadcast_i32x4(AM824_SHUF_SSE42);
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m512i v = _mm512_loadu_si512(s + i * 4);
+
+		v = _mm512_shuffle_epi8(v, shuf);
+		_mm512_storeu_si512(dst + i, v);
+	}
+
+	strip_avx2(dst + i, s + i * 4, n - i);
+}
+
+static const struct am824_ops avx512_ops = {
+	.label = label_avx512,
+	.strip = strip_avx512,
+};
+
+#endif /* HAVE_X86_KERNELS */
+
+#ifdef HAVE_NEON_KERNELS
+
+static void label_neon(void *dst, const int32_t *src, size_t n)
+{
+	const uint32x4_t label = vdupq_n_u32(LABEL_MBLA);
+	uint8_t *d = dst;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		uint32x4_t v = vld1q_u32((const uint32_t *) (src + i));
+
+		v = vorrq_u32(vshrq_n_u32(v, 8), label);
+		vst1q_u8(d + i * 4, vrev32q_u8(vreinterpretq_u8_u32(v)));
+	}
+
+	label_generic(d + i * 4, src + i, n - i);
+}
+
+static void strip_neon(int32_t *dst, const void *src, size_t n)
+{
+	const uint8_t *s = src;
+	size_t i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		uint8x16_t v = vrev32q_u8(vld1q_u8(s + i * 4));
+
+		vst1q_s32(dst + i,
+			vshlq_n_s32(vreinterpretq_s32_u8(v), 8));
+	}
+
+	strip_generic(dst + i, s + i * 4, n - i);
+}
+
+static const struct am824_ops neon_ops = {
+	.label = label_neon,
+	.strip = strip_neon,
+};
+
+#endif /* HAVE_NEON_KERNELS */
+
+static const struct avtp_cpu_variant variants[] = {
+	{ AVTP_CPU_SCALAR, &generic_ops },
+#ifdef HAVE_X86_KERNELS
+	{ AVTP_CPU_SSE2, &sse2_ops },
+	{ AVTP_CPU_SSE4_2, &sse42_ops },
+	{ AVTP_CPU_AVX2, &avx2_ops },
+	{ AVTP_CPU_AVX512, &avx512_ops },
+#elif defined(HAVE_NEON_KERNELS)
+	{ AVTP_CPU_NEON, &neon_ops },
+#endif
+};
+
+static const struct am824_ops *ops = &generic_ops;
+
+static int check_ops(const void *variant, const void *ref)
+{
+	const struct am824_ops *v = variant, *r = ref;
+	int32_t samples[CHECK_LEN], exp[CHECK_LEN], res[CHECK_LEN];
+	uint8_t src[CHECK_LEN * 4 + 1];
+	int fail = 0;
+
+	/* Sources off by one byte, so unaligned loads are checked. */
+	avtp_cpu_fill_pattern(src, sizeof(src));
+	memcpy(samples, src + 1, sizeof(samples));
+
+	r->label(exp, samples, CHECK_LEN);
+	v->label(res, samples, CHECK_LEN);
+	fail |= memcmp(exp, res, sizeof(res));
+
+	r->strip(exp, src + 1, CHECK_LEN);
+	v->strip(res, src + 1, CHECK_LEN);
+	fail |= memcmp(exp, res, sizeof(res));
+
+	return fail;
+}
+
+/* Kernels are selected once, when the library is loaded, according to the
+ * instruction set extensions supported by the running CPU.
+ */
+__attribute__((constructor))
+static void select_ops(void)
+{
+	ops = avtp_cpu_select(variants, ARRAY_SIZE(variants), check_ops);
+}
+
+/* Compute SYT from presentation time, in nanoseconds. Only the time within the
+ * current SYT wrap around period matters.
+ */
+static uint16_t time_to_syt(uint64_t time)
+{
+	uint64_t ticks;
+
+	time %= SYT_CYCLES * NSEC_PER_CYCLE;
+	ticks = time * TICKS_PER_CYCLE / NSEC_PER_CYCLE;
+
+	return ((ticks / TICKS_PER_CYCLE) << 12) | (ticks % TICKS_PER_CYCLE);
+}
+
+int avtp_ieciidc_am824_init(struct avtp_ieciidc_am824 *am, uint8_t sfc,
+					uint8_t dbs, uint8_t channels)
+{
+	/* Nominal sampling frequency and SYT_INTERVAL, from IEC 61883-6
+	 * Table 8, indexed by SFC.
+	 */
+	static const struct {
+		uint32_t rate;
+		uint8_t syt_interval;
+	} sfc_table[] = {
+		[AVTP_IECIIDC_SFC_32KHZ] = { 32000, 8 },
+		[AVTP_IECIIDC_SFC_44_1KHZ] = { 44100, 8 },
+		[AVTP_IECIIDC_SFC_48KHZ] = { 48000, 8 },
+		[AVTP_IECIIDC_SFC_88_2KHZ] = { 88200, 16 },
+		[AVTP_IECIIDC_SFC_96KHZ] = { 96000, 16 },
+		[AVTP_IECIIDC_SFC_176_4KHZ] = { 176400, 32 },
+		[AVTP_IECIIDC_SFC_192KHZ] = { 192000, 32 },
+	};
+
+	if (!am || sfc > AVTP_IECIIDC_SFC_192KHZ)
+		return -EINVAL;
+
+	if (dbs == 0 || channels == 0 || channels > dbs)
+		return -EINVAL;
+
+	memset(am, 0, sizeof(*am));
+	am->rate = sfc_table[sfc].rate;
+	am->syt_interval = sfc_table[sfc].syt_interval;
+	am->sfc = sfc;
+	am->dbs = dbs;
+	am->channels = channels;
+
+	return 0;
+}
+
+int avtp_ieciidc_am824_encode(struct avtp_ieciidc_am824 *am,
+				struct avtp_ieciidc_hdr *hdr, void *payload,
+				const int32_t *samples, unsigned int frames,
+				uint64_t time)
+{
+	size_t block_len, len;
+	unsigned int i, k;
+	uint8_t *d = payload;
+
+	if (!am || !hdr || !payload || (frames && !samples))
+		return -EINVAL;
+
+	block_len = am->dbs * QUADLET_LEN;
+	len = (size_t) frames * block_len;
+	if (len > UINT16_MAX - CIP_HDR_LEN)
+		return -EINVAL;
+
+	if (am->channels == am->dbs) {
+		ops->label(d, samples, (size_t) frames * am->channels);
+	} else {
+		for (i = 0; i < frames; i++) {
+			uint8_t *block = d + i * block_len;
+			unsigned int q;
+
+			ops->label(block, samples + i * am->channels,
+								am->channels);
+
+			for (q = am->channels; q < am->dbs; q++)
+				put_unaligned_be32(LABEL_MBLA,
+						block + q * QUADLET_LEN);
+		}
+	}
+
+	hdr->stream.stream_data_len = CIP_HDR_LEN + len;
+	hdr->cip_fmt = AVTP_IECIIDC_CIP_FMT_AM824;
+	hdr->cip_dbs = am->dbs;
+	hdr->cip_dbc = am->dbc;
+	hdr->cip_fn = 0;
+	hdr->cip_qpc = 0;
+	hdr->cip_sph = 0;
+	hdr->cip_tsf = 0;
+	hdr->cip_evt = 0;
+	hdr->cip_n = 0;
+	hdr->cip_nd = 0;
+	hdr->cip_sfc = am->sfc;
+	hdr->cip_no_data = 0;
+	hdr->cip_syt = AVTP_IECIIDC_SYT_NO_INFO;
+
+	if (frames == 0) {
+		hdr->cip_no_data = FDF_NO_DATA;
+		return 0;
+	}
+
+	/* Index of the first data block whose DBC is a multiple of
+	 * SYT_INTERVAL. SYT_INTERVAL is a power of 2.
+	 */
+	k = (am->syt_interval - (am->dbc & (am->syt_interval - 1))) &
+						(am->syt_interval - 1);
+	if (k < frames)
+		hdr->cip_syt = time_to_syt(time + k * NSEC_PER_SEC / am->rate);
+
+	am->dbc += frames;
+
+	return len;
+}
+
+int avtp_ieciidc_am824_decode(const struct avtp_ieciidc_am824 *am,
+				const struct avtp_ieciidc_hdr *hdr,
+				const void *payload, int32_t *samples,
+				unsigned int frames)
+{
+	const uint8_t *s = payload;
+	size_t block_len;
+	unsigned int blocks, i;
+
+	if (!am || !hdr || !payload || (frames && !samples))
+		return -EINVAL;
+
+	if (hdr->tag != AVTP_IECIIDC_TAG_CIP ||
+			hdr->cip_fmt != AVTP_IECIIDC_CIP_FMT_AM824 ||
+			hdr->cip_dbs != am->dbs ||
+			hdr->stream.stream_data_len < CIP_HDR_LEN)
+		return -EINVAL;
+
+	if (hdr->cip_no_data == FDF_NO_DATA)
+		return 0;
+
+	block_len = am->dbs * QUADLET_LEN;
+	blocks = (hdr->stream.stream_data_len - CIP_HDR_LEN) / block_len;
+	if (frames > blocks)
+		frames = blocks;
+
+	if (am->channels == am->dbs) {
+		ops->strip(samples, s, (size_t) frames * am->channels);
+		return frames;
+	}
+
+	for (i = 0; i < frames; i++)
+		ops->strip(samples + i * am->channels, s + i * block_len,
+								am->channels);
+
+	return frames;
+}
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp_jbuf.h"
+#include "util.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+
+/* Presentation times further than this from the playout position can't be
+ * turned into frame offsets without overflowing, so they restart the buffer
+ * right away.
+ */
+#define MAX_TIME_OFFSET		((int64_t) BIT(40))
+
+struct avtp_jbuf {
+	struct avtp_jbuf_config cfg;
+	/* Number of frames in the ring, a multiple of 'block_frames', so
+	 * blocks never wrap around.
+	 */
+	unsigned int frames;
+	/* Duration of a block, in ns. */
+	uint64_t step;
+	uint64_t delay;
+
+	/* Set once a PDU with presentation time is stored. */
+	bool started;
+	/* Playout position is 'head_off' frames past presentation time
+	 * 'base'. Frames are counted from 'base' so sample periods which
+	 * aren't a whole number of ns don't drift, and 'base' moves a second
+	 * at a time so 'head_off' stays below the sample rate.
+	 */
+	uint64_t base;
+	uint32_t head_off;
+	/* Ring index of the playout position. */
+	unsigned int head;
+	/* Frames played since the first PDU was stored. */
+	uint64_t head_abs;
+
+	/* Last PDU stored, which PDUs without presentation time are placed
+	 * relative to.
+	 */
+	bool has_last;
+	uint8_t last_seq;
+	unsigned int last_count;
+	uint64_t last_abs;
+
+	struct avtp_jbuf_stats stats;
+	/* Counters as of the previous avtp_jbuf_adapt() call. */
+	uint64_t prev_late;
+	struct avtp_stats_snapshot prev;
+
+	/* 'frames' frames, followed by a flag per frame telling whether it
+	 * was stored, followed by the previous block played.
+	 */
+	uint8_t *ring;
+	uint8_t *valid;
+	uint8_t *last_block;
+	uint8_t data[];
+};
+
+int avtp_jbuf_create(struct avtp_jbuf **jbuf,
+				const struct avtp_jbuf_config *cfg)
+{
+	struct avtp_jbuf *jb;
+	uint64_t frames, ring_size, duration;
+
+	if (!jbuf || !cfg || cfg->frame_size == 0 || cfg->block_frames == 0 ||
+				cfg->blocks == 0 || cfg->sample_rate == 0 ||
+				cfg->min_delay > cfg->max_delay)
+		return -EINVAL;
+
+	if (cfg->conceal != AVTP_JBUF_CONCEAL_ZERO &&
+				cfg->conceal != AVTP_JBUF_CONCEAL_REPEAT)
+		return -EINVAL;
+
+	frames = (uint64_t) cfg->block_frames * cfg->blocks;
+	if (frames > UINT32_MAX / cfg->frame_size)
+		return -EINVAL;
+
+	duration = frames * NSEC_PER_SEC / cfg->sample_rate;
+	if (cfg->max_delay >= duration)
+		return -EINVAL;
+
+	ring_size = frames * cfg->frame_size;
+
+	jb = calloc(1, sizeof(*jb) + ring_size + frames +
+				cfg->block_frames * cfg->frame_size);
+	if (!jb)
+		return -ENOMEM;
+
+	jb->cfg = *cfg;
+	jb->frames = frames;
+	jb->step = cfg->block_frames * NSEC_PER_SEC / cfg->sample_rate;
+	jb->delay = cfg->min_delay;
+	jb->ring = jb->data;
+	jb->valid = jb->ring + ring_size;
+	jb->last_block = jb->valid + frames;
+
+	*jbuf = jb;
+	return 0;
+}
+
+void avtp_jbuf_destroy(struct avtp_jbuf *jbuf)
+{
+	free(jbuf);
+}
+
+/* Copy 'count' frames into the ring, at 'pos' frames past the playout
+ * position. The frames must fit in the ring.
+ */
+static void store(struct avtp_jbuf *jb, unsigned int pos,
+				const uint8_t *frames, unsigned int count)
+{
+	unsigned int fs = jb->cfg.frame_size;
+	unsigned int idx = (jb->head + pos) % jb->frames;
+	unsigned int n = count;
+
+	if (n > jb->frames - idx)
+		n = jb->frames - idx;
+
+	memcpy(jb->ring + idx * fs, frames, n * fs);
+	memset(jb->valid + idx, 1, n);
+
+	if (n < count) {
+		memcpy(jb->ring, frames + n * fs, (count - n) * fs);
+		memset(jb->valid, 1, count - n);
+	}
+}
+
+/* Start playing out from presentation time 'time', dropping any frame held
+ * in the ring.
+ */
+static void restart(struct avtp_jbuf *jb, uint64_t time)
+{
+	memset(jb->valid, 0, jb->frames);
+	jb->started = true;
+	jb->base = time;
+	jb->head_off = 0;
+}
+
+int avtp_jbuf_put(struct avtp_jbuf *jbuf, uint64_t time, uint8_t seq_num,
+				const void *frames, unsigned int count)
+{
+	const uint8_t *src = frames;
+	int64_t pos = 0, end;
+	uint64_t abs;
+	unsigned int skip;
+
+	if (!jbuf || !frames || count == 0 || count > INT32_MAX)
+		return -EINVAL;
+
+	if (time) {
+		int64_t offset = time - jbuf->base;
+
+		if (jbuf->started && offset < MAX_TIME_OFFSET &&
+						offset > -MAX_TIME_OFFSET) {
+			/* Nearest frame to the presentation time, which is
+			 * before 'base' for late or reordered PDUs, so round
+			 * towards minus infinity.
+			 */
+			int64_t num = offset *
+					(int64_t) jbuf->cfg.sample_rate +
+					(int64_t) NSEC_PER_SEC / 2;
+
+			pos = num / (int64_t) NSEC_PER_SEC;
+			if (num % (int64_t) NSEC_PER_SEC < 0)
+				pos--;
+			pos -= jbuf->head_off;
+		}
+
+		if (!jbuf->started || offset >= MAX_TIME_OFFSET ||
+					offset <= -MAX_TIME_OFFSET ||
+					pos < -(int64_t) jbuf->frames ||
+					pos >= 2 * (int64_t) jbuf->frames) {
+			restart(jbuf, time);
+			pos = 0;
+		}
+
+		abs = jbuf->head_abs + pos;
+	} else {
+		if (!jbuf->has_last)
+			return 0;
+
+		/* Sequence numbers wrap around, so PDUs are placed up to
+		 * 128 PDUs before or after the last one.
+		 */
+		abs = jbuf->last_abs +
+			(int64_t) (int8_t) (seq_num - jbuf->last_seq) *
+							jbuf->last_count;
+		pos = abs - jbuf->head_abs;
+	}
+
+	jbuf->has_last = true;
+	jbuf->last_seq = seq_num;
+	jbuf->last_count = count;
+	jbuf->last_abs = abs;
+
+	end = pos + count;
+
+	if (end <= 0) {
+		jbuf->stats.late += count;
+		return 0;
+	}
+	if (pos >= jbuf->frames) {
+		jbuf->stats.overflows += count;
+		return 0;
+	}
+
+	skip = 0;
+	if (pos < 0) {
+		skip = -pos;
+		jbuf->stats.late += skip;
+		pos = 0;
+	}
+	if (end > jbuf->frames) {
+		jbuf->stats.overflows += end - jbuf->frames;
+		end = jbuf->frames;
+	}
+
+	store(jbuf, pos, src + skip * jbuf->cfg.frame_size, end - pos);
+
+	return end - pos;
+}
+
+/* Presentation time of the playout position. */
+static uint64_t head_time(const struct avtp_jbuf *jb)
+{
+	return jb->base + ((uint64_t) jb->head_off * NSEC_PER_SEC +
+				jb->cfg.sample_rate / 2) / jb->cfg.sample_rate;
+}
+
+int avtp_jbuf_next(const struct avtp_jbuf *jbuf, uint64_t *time)
+{
+	if (!jbuf || !time)
+		return -EINVAL;
+
+	if (!jbuf->started)
+		return -ENOENT;
+
+	*time = head_time(jbuf) + jbuf->delay;
+	return 0;
+}
+
+int avtp_jbuf_get(struct avtp_jbuf *jbuf, uint64_t now, void *block)
+{
+	unsigned int fs, bf, i;
+	uint8_t *dst = block;
+	uint8_t *valid;
+
+	if (!jbuf || !block)
+		return -EINVAL;
+
+	if (!jbuf->started || now < head_time(jbuf) + jbuf->delay)
+		return -EAGAIN;
+
+	fs = jbuf->cfg.frame_size;
+	bf = jbuf->cfg.block_frames;
+	valid = jbuf->valid + jbuf->head;
+
+	memcpy(dst, jbuf->ring + jbuf->head * fs, bf * fs);
+
+	for (i = 0; i < bf; i++) {
+		if (valid[i])
+			continue;
+
+		if (jbuf->cfg.conceal == AVTP_JBUF_CONCEAL_REPEAT)
+			memcpy(dst + i * fs, jbuf->last_block + i * fs, fs);
+		else
+			memset(dst + i * fs, 0, fs);
+
+		jbuf->stats.concealed++;
+	}
+
+	memset(valid, 0, bf);
+	if (jbuf->cfg.conceal == AVTP_JBUF_CONCEAL_REPEAT)
+		memcpy(jbuf->last_block, dst, bf * fs);
+
+	jbuf->head = (jbuf->head + bf) % jbuf->frames;
+	jbuf->head_abs += bf;
+	jbuf->head_off += bf;
+	while (jbuf->head_off >= jbuf->cfg.sample_rate) {
+		jbuf->head_off -= jbuf->cfg.sample_rate;
+		jbuf->base += NSEC_PER_SEC;
+	}
+
+	jbuf->stats.played += bf;
+	return 0;
+}
+
+int avtp_jbuf_adapt(struct avtp_jbuf *jbuf, const struct avtp_stats *stats)
+{
+	struct avtp_stats_snapshot snap;
+	uint64_t late, total, threshold, cum, slack;
+	unsigned int i;
+	int res;
+
+	if (!jbuf || !stats)
+		return -EINVAL;
+
+	res = avtp_stats_read(stats, &snap);
+	if (res < 0)
+		return res;
+
+	late = jbuf->stats.late - jbuf->prev_late;
+	jbuf->prev_late = jbuf->stats.late;
+
+	/* PDUs arriving after their presentation time aren't accounted in
+	 * the histogram, they are the ones with the least slack.
+	 */
+	cum = snap.late - jbuf->prev.late;
+	total = cum;
+	for (i = 0; i < AVTP_STATS_LATENCY_BUCKETS; i++)
+		total += snap.latency[i] - jbuf->prev.latency[i];
+
+	threshold = total * AVTP_JBUF_ADAPT_PERCENTILE / 100;
+
+	/* Lower bound of the slack, i.e. time from arrival to presentation,
+	 * of all but the PDUs with the least of it.
+	 */
+	slack = 0;
+	if (cum <= threshold) {
+		for (i = 0; i < AVTP_STATS_LATENCY_BUCKETS; i++) {
+			cum += snap.latency[i] - jbuf->prev.latency[i];
+			if (cum > threshold)
+				break;
+		}
+		slack = i ? 1ULL << (i - 1) : 0;
+	}
+
+	jbuf->prev = snap;
+
+	if (late) {
+		if (jbuf->delay == jbuf->cfg.max_delay)
+			return 0;
+
+		jbuf->delay += jbuf->step;
+		if (jbuf->delay > jbuf->cfg.max_delay)
+			jbuf->delay = jbuf->cfg.max_delay;
+		return 1;
+	}
+
+	/* Blocks are played at the presentation time of their first frame
+	 * plus the delay, so the last frame only makes it if the delay plus
+	 * the slack of its PDU cover a block. The delay is only shrunk if that
+	 * still holds with a block less of it.
+	 */
+	if (total == 0 || jbuf->delay < jbuf->cfg.min_delay + jbuf->step ||
+				slack + jbuf->delay < 2 * jbuf->step)
+		return 0;
+
+	jbuf->delay -= jbuf->step;
+	return 1;
+}
+
+int avtp_jbuf_get_stats(const struct avtp_jbuf *jbuf,
+				struct avtp_jbuf_stats *stats)
+{
+	if (!jbuf || !stats)
+		return -EINVAL;
+
+	*stats = jbuf->stats;
+	stats->delay = jbuf->delay;
+	return 0;
+}
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Required by pthread_attr_setaffinity_np(). */
+#define _GNU_SOURCE
+
+#include <endian.h>
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_classifier.h"
+#include "avtp_net.h"
+
+/* Offsets, in bytes, of both halves of Stream AVTPDU 'stream_id' field. */
+#define STREAM_ID_HI_OFFSET	4
+#define STREAM_ID_LO_OFFSET	8
+
+struct worker {
+	struct avtp_net_engine *engine;
+	struct avtp_net_rx *rx;
+	struct avtp_classifier *cls;
+	pthread_t thread;
+	unsigned int index;
+	/* CPU the worker thread is pinned to, or -1. */
+	int cpu;
+};
+
+struct avtp_net_engine {
+	avtp_net_engine_fn fn;
+	void *arg;
+	/* Written to wake workers up when they should stop. */
+	int stop_fd;
+	bool stopping;
+	bool running;
+	unsigned int num_workers;
+	struct worker workers[];
+};
+
+/* Hash 'stream_id' into a worker index. Must be kept in sync with the fanout
+ * program built by fanout_attach(), which computes the same hash in the
+ * kernel.
+ */
+static unsigned int stream_worker(uint64_t stream_id, unsigned int workers)
+{
+	uint32_t hash = (stream_id >> 32) ^ (uint32_t) stream_id;
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash % workers;
+}
+
+/* Attach the classic BPF program which steers PDUs to fanout group members.
+ * Packet sockets see frames starting at the network header, so offsets are
+ * relative to the AVTPDU. Absolute loads convert words to host order, and
+ * frames too short to hold 'stream_id' are steered to the first member.
+ */
+static int fanout_attach(int fd, unsigned int workers)
+{
+	struct sock_filter code[] = {
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS, STREAM_ID_HI_OFFSET),
+		BPF_STMT(BPF_MISC | BPF_TAX, 0),
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS, STREAM_ID_LO_OFFSET),
+		BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+		BPF_STMT(BPF_MISC | BPF_TAX, 0),
+		BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+		BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+		BPF_STMT(BPF_MISC | BPF_TAX, 0),
+		BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 8),
+		BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+		BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, workers),
+		BPF_STMT(BPF_RET | BPF_A, 0),
+	};
+	struct sock_fprog prog = {
+		.len = sizeof(code) / sizeof(code[0]),
+		.filter = code,
+	};
+	int res;
+
+	res = setsockopt(fd, SOL_PACKET, PACKET_FANOUT_DATA, &prog,
+								sizeof(prog));
+	if (res < 0)
+		return -errno;
+
+	return 0;
+}
+
+/* Make all worker rings join a new fanout group. The first ring asks the
+ * kernel for an unused group ID and attaches the steering program, then the
+ * other rings join the group by that ID.
+ */
+static int fanout_join(struct avtp_net_engine *e)
+{
+	socklen_t len = sizeof(int);
+	unsigned int i;
+	int fd, val, res;
+
+	fd = avtp_net_rx_get_fd(e->workers[0].rx);
+	val = (PACKET_FANOUT_CBPF | PACKET_FANOUT_FLAG_UNIQUEID) << 16;
+
+	res = setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &val, sizeof(val));
+	if (res < 0)
+		return -errno;
+
+	res = fanout_attach(fd, e->num_workers);
+	if (res < 0)
+		return res;
+
+	res = getsockopt(fd, SOL_PACKET, PACKET_FANOUT, &val, &len);
+	if (res < 0)
+		return -errno;
+
+	val = (val & 0xFFFF) | (PACKET_FANOUT_CBPF << 16);
+
+	for (i = 1; i < e->num_workers; i++) {
+		fd = avtp_net_rx_get_fd(e->workers[i].rx);
+
+		res = setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &val,
+								sizeof(val));
+		if (res < 0)
+			return -errno;
+	}
+
+	return 0;
+}
+
+static void *worker_run(void *data)
+{
+	const struct avtp_stream_pdu *pdus[AVTP_NET_ENGINE_BATCH];
+	struct avtp_classifier_result results[AVTP_NET_ENGINE_BATCH];
+	size_t lens[AVTP_NET_ENGINE_BATCH];
+	struct worker *w = data;
+	struct avtp_net_engine *e = w->engine;
+	struct pollfd pfds[2] = {
+		{ .fd = avtp_net_rx_get_fd(w->rx), .events = POLLIN },
+		{ .fd = e->stop_fd, .events = POLLIN },
+	};
+
+	while (!__atomic_load_n(&e->stopping, __ATOMIC_ACQUIRE)) {
+		int n;
+
+		n = avtp_net_rx_classify(w->rx, w->cls, pdus, lens, results,
+						AVTP_NET_ENGINE_BATCH);
+		if (n > 0) {
+			e->fn(w->index, pdus, lens, results, n, e->arg);
+			continue;
+		}
+
+		/* Ring is drained, sleep until the kernel hands a block
+		 * over or the engine is stopped.
+		 */
+		if (poll(pfds, 2, -1) < 0 && errno != EINTR)
+			break;
+	}
+
+	return NULL;
+}
+
+static void stop_workers(struct avtp_net_engine *e, unsigned int count)
+{
+	eventfd_t val;
+	unsigned int i;
+
+	__atomic_store_n(&e->stopping, true, __ATOMIC_RELEASE);
+	eventfd_write(e->stop_fd, 1);
+
+	for (i = 0; i < count; i++)
+		pthread_join(e->workers[i].thread, NULL);
+
+	/* Reset the event counter so workers sleep again once restarted. */
+	eventfd_read(e->stop_fd, &val);
+
+	e->stopping = false;
+}
+
+static void destroy_workers(struct avtp_net_engine *e)
+{
+	unsigned int i;
+
+	for (i = 0; i < e->num_workers; i++) {
+		avtp_classifier_destroy(e->workers[i].cls);
+		avtp_net_rx_destroy(e->workers[i].rx);
+	}
+}
+
+int avtp_net_engine_create(struct avtp_net_engine **engine,
+				const struct avtp_net_engine_config *cfg)
+{
+	struct avtp_net_engine *e;
+	unsigned int i;
+	int res;
+
+	if (!engine || !cfg || !cfg->fn || !cfg->workers ||
+				cfg->workers > AVTP_NET_ENGINE_MAX_WORKERS ||
+				cfg->rx.backend != AVTP_NET_BACKEND_PACKET)
+		return -EINVAL;
+
+	e = calloc(1, sizeof(*e) + cfg->workers * sizeof(e->workers[0]));
+	if (!e)
+		return -ENOMEM;
+
+	e->fn = cfg->fn;
+	e->arg = cfg->arg;
+
+	e->stop_fd = eventfd(0, EFD_NONBLOCK);
+	if (e->stop_fd < 0) {
+		res = -errno;
+		goto err_free;
+	}
+
+	for (i = 0; i < cfg->workers; i++) {
+		struct worker *w = &e->workers[i];
+
+		w->engine = e;
+		w->index = i;
+		w->cpu = cfg->cpus ? cfg->cpus[i] : -1;
+
+		if (cfg->cpus && (w->cpu < 0 || w->cpu >= CPU_SETSIZE)) {
+			res = -EINVAL;
+			goto err_workers;
+		}
+
+		res = avtp_classifier_create(&w->cls, cfg->max_streams);
+		if (res < 0)
+			goto err_workers;
+
+		/* Count the worker as soon as it owns something to be
+		 * destroyed.
+		 */
+		e->num_workers++;
+
+		res = avtp_net_rx_create(&w->rx, &cfg->rx);
+		if (res < 0)
+			goto err_workers;
+	}
+
+	res = fanout_join(e);
+	if (res < 0)
+		goto err_workers;
+
+	*engine = e;
+	return 0;
+
+err_workers:
+	destroy_workers(e);
+	close(e->stop_fd);
+err_free:
+	free(e);
+	return res;
+}
+
+void avtp_net_engine_destroy(struct avtp_net_engine *engine)
+{
+	if (!engine)
+		return;
+
+	if (engine->running)
+		stop_workers(engine, engine->num_workers);
+
+	destroy_workers(engine);
+	close(engine->stop_fd);
+	free(engine);
+}
+
+int avtp_net_engine_get_worker(const struct avtp_net_engine *engine,
+							uint64_t stream_id)
+{
+	if (!engine)
+		return -EINVAL;
+
+	return stream_worker(stream_id, engine->num_workers);
+}
+
+int avtp_net_engine_add_stream(struct avtp_net_engine *engine,
+					const struct avtp_stream_pdu *expected,
+					const struct avtp_stream_pdu *mask)
+{
+	unsigned int i;
+
+	if (!engine || !expected)
+		return -EINVAL;
+
+	if (engine->running)
+		return -EBUSY;
+
+	i = stream_worker(be64toh(expected->stream_id), engine->num_workers);
+
+	return avtp_classifier_add(engine->workers[i].cls, expected, mask);
+}
+
+int avtp_net_engine_add_membership(struct avtp_net_engine *engine,
+						const uint8_t macaddr[6])
+{
+	if (!engine)
+		return -EINVAL;
+
+	/* Multicast filters are per interface, so joining the group from
+	 * one ring is enough for all of them to receive its PDUs.
+	 */
+	return avtp_net_rx_add_membership(engine->workers[0].rx, macaddr);
+}
+
+int avtp_net_engine_start(struct avtp_net_engine *engine)
+{
+	pthread_attr_t attr;
+	unsigned int i;
+	int res;
+
+	if (!engine)
+		return -EINVAL;
+
+	if (engine->running)
+		return -EBUSY;
+
+	res = pthread_attr_init(&attr);
+	if (res)
+		return -res;
+
+	for (i = 0; i < engine->num_workers; i++) {
+		struct worker *w = &engine->workers[i];
+
+		if (w->cpu >= 0) {
+			cpu_set_t cpus;
+
+			CPU_ZERO(&cpus);
+			CPU_SET(w->cpu, &cpus);
+
+			res = pthread_attr_setaffinity_np(&attr, sizeof(cpus),
+									&cpus);
+			if (res)
+				break;
+		}
+
+		res = pthread_create(&w->thread, &attr, worker_run, w);
+		if (res)
+			break;
+	}
+
+	pthread_attr_destroy(&attr);
+
+	if (res) {
+		stop_workers(engine, i);
+		return -res;
+	}
+
+	engine->running = true;
+	return 0;
+}
+
+int avtp_net_engine_stop(struct avtp_net_engine *engine)
+{
+	if (!engine)
+		return -EINVAL;
+
+	if (engine->running) {
+		stop_workers(engine, engine->num_workers);
+		engine->running = false;
+	}
+
+	return 0;
+}
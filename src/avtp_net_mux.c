@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp_net.h"
+#include "avtp_net_tx.h"
+
+#define NSEC_PER_SEC			1000000000ULL
+
+/* Class measurement intervals, in nanoseconds. */
+static const uint64_t class_intervals[AVTP_NET_MUX_CLASS_MAX] = {
+	[AVTP_NET_MUX_CLASS_A] = 125000,
+	[AVTP_NET_MUX_CLASS_B] = 250000,
+};
+
+struct mux_stream {
+	struct avtp_net_mux_stream_config cfg;
+	/* Bytes on the wire reserved per class measurement interval. */
+	uint64_t budget;
+	/* Class measurement interval the last PDU was transmitted in: its
+	 * end, and bytes on the wire transmitted in it so far.
+	 */
+	uint64_t window_end;
+	uint64_t window_bytes;
+	bool overrun;
+	struct avtp_net_mux_stats stats;
+};
+
+struct entry {
+	uint64_t time;
+	unsigned int stream;
+	enum avtp_net_mux_class sr_class;
+};
+
+struct avtp_net_mux {
+	struct avtp_net_tx *tx;
+	unsigned int max_pdu_size;
+	struct mux_stream *streams;
+	unsigned int max_streams;
+	unsigned int count;
+	uint64_t idleslope[AVTP_NET_MUX_CLASS_MAX];
+	/* Binary min-heap with the next PDU due from each stream: children of
+	 * entry i are entries 2i+1 and 2i+2.
+	 */
+	struct entry heap[];
+};
+
+/* Order by launch time, then class A first, then by stream handle. */
+static bool before(const struct entry *a, const struct entry *b)
+{
+	if (a->time != b->time)
+		return a->time < b->time;
+
+	if (a->sr_class != b->sr_class)
+		return a->sr_class < b->sr_class;
+
+	return a->stream < b->stream;
+}
+
+static void sift_up(struct avtp_net_mux *mux, unsigned int i)
+{
+	struct entry e = mux->heap[i];
+
+	while (i > 0) {
+		unsigned int parent = (i - 1) / 2;
+
+		if (!before(&e, &mux->heap[parent]))
+			break;
+
+		mux->heap[i] = mux->heap[parent];
+		i = parent;
+	}
+
+	mux->heap[i] = e;
+}
+
+static void sift_down(struct avtp_net_mux *mux, unsigned int i)
+{
+	struct entry e = mux->heap[i];
+
+	while (1) {
+		unsigned int child = 2 * i + 1;
+
+		if (child >= mux->count)
+			break;
+
+		if (child + 1 < mux->count &&
+			before(&mux->heap[child + 1], &mux->heap[child]))
+			child++;
+
+		if (!before(&mux->heap[child], &e))
+			break;
+
+		mux->heap[i] = mux->heap[child];
+		i = child;
+	}
+
+	mux->heap[i] = e;
+}
+
+int avtp_net_mux_create(struct avtp_net_mux **mux, struct avtp_net_tx *tx,
+						unsigned int max_streams)
+{
+	struct avtp_net_mux *m;
+
+	if (!mux || !tx || max_streams == 0)
+		return -EINVAL;
+
+	m = calloc(1, sizeof(*m) + max_streams * sizeof(m->heap[0]));
+	if (!m)
+		return -ENOMEM;
+
+	m->streams = calloc(max_streams, sizeof(m->streams[0]));
+	if (!m->streams) {
+		free(m);
+		return -ENOMEM;
+	}
+
+	m->tx = tx;
+	m->max_pdu_size = avtp_net_tx_max_pdu_size(tx);
+	m->max_streams = max_streams;
+
+	*mux = m;
+	return 0;
+}
+
+void avtp_net_mux_destroy(struct avtp_net_mux *mux)
+{
+	if (!mux)
+		return;
+
+	free(mux->streams);
+	free(mux);
+}
+
+int avtp_net_mux_add_stream(struct avtp_net_mux *mux,
+				const struct avtp_net_mux_stream_config *cfg)
+{
+	struct mux_stream *s;
+	struct entry *e;
+	uint64_t interval;
+
+	if (!mux || !cfg || !cfg->fill || cfg->max_frame_size == 0 ||
+				cfg->max_frame_size > mux->max_pdu_size ||
+				cfg->max_interval_frames == 0 ||
+				cfg->sr_class >= AVTP_NET_MUX_CLASS_MAX)
+		return -EINVAL;
+
+	if (mux->count == mux->max_streams)
+		return -ENOSPC;
+
+	s = &mux->streams[mux->count];
+	s->cfg = *cfg;
+	s->budget = (uint64_t) (cfg->max_frame_size +
+				AVTP_NET_MUX_FRAME_OVERHEAD) *
+				cfg->max_interval_frames;
+
+	interval = class_intervals[cfg->sr_class];
+	mux->idleslope[cfg->sr_class] += s->budget * 8 * NSEC_PER_SEC /
+								interval;
+
+	e = &mux->heap[mux->count];
+	e->time = cfg->start_time;
+	e->stream = mux->count;
+	e->sr_class = cfg->sr_class;
+	sift_up(mux, mux->count);
+
+	return mux->count++;
+}
+
+/* Account a PDU transmitted by a stream at 'launch_time' against its
+ * reservation. An overrun is counted once per class measurement interval.
+ */
+static void account_pdu(struct mux_stream *s, uint64_t launch_time,
+							size_t len)
+{
+	uint64_t interval = class_intervals[s->cfg.sr_class];
+
+	if (launch_time >= s->window_end) {
+		s->window_end = launch_time - launch_time % interval +
+								interval;
+		s->window_bytes = 0;
+		s->overrun = false;
+	}
+
+	s->window_bytes += len + AVTP_NET_MUX_FRAME_OVERHEAD;
+	if (s->window_bytes > s->budget && !s->overrun) {
+		s->overrun = true;
+		s->stats.overruns++;
+	}
+
+	s->stats.pdus++;
+	s->stats.bytes += len;
+}
+
+/* Transmit queued PDUs. PDUs the kernel doesn't accept for now stay queued,
+ * which is not an error.
+ */
+static int flush(struct avtp_net_mux *mux)
+{
+	int res;
+
+	res = avtp_net_tx_flush(mux->tx);
+	if (res == -EAGAIN || res == -ENOBUFS)
+		return 0;
+
+	return res;
+}
+
+int avtp_net_mux_run(struct avtp_net_mux *mux, uint64_t until)
+{
+	int queued = 0;
+	int res;
+
+	if (!mux)
+		return -EINVAL;
+
+	while (mux->count && mux->heap[0].time <= until) {
+		struct entry *e = &mux->heap[0];
+		struct mux_stream *s = &mux->streams[e->stream];
+		uint64_t launch_time = e->time;
+		void *buf;
+
+		res = avtp_net_tx_reserve(mux->tx, &buf);
+		if (res == -ENOSPC) {
+			res = flush(mux);
+			if (res < 0)
+				return res;
+
+			/* Only a queue transmitted in full has room again. */
+			if (avtp_net_tx_get_pending(mux->tx) > 0)
+				break;
+			continue;
+		}
+		if (res < 0)
+			return res;
+
+		res = s->cfg.fill(buf, mux->max_pdu_size, &launch_time,
+								s->cfg.arg);
+		if (res < 0)
+			return res;
+
+		/* A stream not moving forward would be picked again right
+		 * away, forever.
+		 */
+		if (launch_time <= e->time)
+			return -EINVAL;
+
+		if (res > 0) {
+			int len = res;
+
+			res = avtp_net_tx_commit(mux->tx, s->cfg.macaddr, len,
+								e->time);
+			if (res < 0)
+				return res;
+
+			account_pdu(s, e->time, len);
+			queued++;
+		}
+
+		e->time = launch_time;
+		sift_down(mux, 0);
+	}
+
+	res = flush(mux);
+	if (res < 0)
+		return res;
+
+	return queued;
+}
+
+int avtp_net_mux_get_deadline(const struct avtp_net_mux *mux,
+							uint64_t *deadline)
+{
+	if (!mux || !deadline)
+		return -EINVAL;
+
+	if (mux->count == 0)
+		return -ENOENT;
+
+	*deadline = mux->heap[0].time;
+	return 0;
+}
+
+int avtp_net_mux_get_idleslope(const struct avtp_net_mux *mux,
+				enum avtp_net_mux_class sr_class,
+				uint64_t *bps)
+{
+	if (!mux || !bps || sr_class >= AVTP_NET_MUX_CLASS_MAX)
+		return -EINVAL;
+
+	*bps = mux->idleslope[sr_class];
+	return 0;
+}
+
+int avtp_net_mux_get_stats(const struct avtp_net_mux *mux, int stream,
+					struct avtp_net_mux_stats *stats)
+{
+	if (!mux || !stats || stream < 0 ||
+					(unsigned int) stream >= mux->count)
+		return -EINVAL;
+
+	*stats = mux->streams[stream].stats;
+	return 0;
+}
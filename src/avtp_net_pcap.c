@@ -0,0 +1,922 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <linux/if_ether.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_classifier.h"
+#include "avtp_net.h"
+#include "util.h"
+
+/* pcapng block types and options (see draft-ietf-opsawg-pcapng). */
+#define BLOCK_SHB		0x0A0D0D0A
+#define BLOCK_IDB		0x00000001
+#define BLOCK_SPB		0x00000003
+#define BLOCK_EPB		0x00000006
+#define BYTE_ORDER_MAGIC	0x1A2B3C4D
+#define OPT_END			0
+#define OPT_IF_TSRESOL		9
+#define LINKTYPE_ETHERNET	1
+
+/* Sizes, in bytes, of blocks written by captures. EPBs are followed by the
+ * frame, padded to 32 bits, and by the trailing block length.
+ */
+#define SHB_SIZE		28
+#define IDB_SIZE		32
+#define EPB_HDR_SIZE		28
+#define BLOCK_MIN_SIZE		12
+
+/* Timestamp resolution of the interface written by captures, as exponent
+ * of a negative power of 10: nanoseconds.
+ */
+#define TSRESOL_NSEC		9
+/* Default timestamp resolution of interfaces: microseconds. */
+#define TSRESOL_DEFAULT		6
+
+#define DEFAULT_BUFFER_SIZE	(4 << 20)
+#define MAX_SNAPLEN		65535
+#define SEGMENT_COUNT		4
+
+#define NSEC_PER_SEC		1000000000ULL
+
+#define PAD32(len)		(((len) + 3) & ~(size_t) 3)
+
+struct segment {
+	uint8_t *data;
+	size_t len;
+	/* Whether the segment has been handed over to the writer thread. */
+	bool full;
+};
+
+struct avtp_net_capture {
+	int fd;
+	uint8_t *buf;
+	size_t seg_size;
+	unsigned int snaplen;
+	struct ethhdr eth;
+
+	/* Segment PDUs are recorded into, only accessed by the recording
+	 * thread, and segment written next by the writer thread. Segments
+	 * change hands under 'lock'.
+	 */
+	struct segment segs[SEGMENT_COUNT];
+	unsigned int head;
+	unsigned int tail;
+
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	bool stop;
+	/* First error the writer thread has run into. */
+	int err;
+
+	struct avtp_net_capture_stats stats;
+};
+
+static int write_all(int fd, const uint8_t *data, size_t len)
+{
+	while (len) {
+		ssize_t n = write(fd, data, len);
+
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return -errno;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+static void *writer_run(void *arg)
+{
+	struct avtp_net_capture *cap = arg;
+
+	pthread_mutex_lock(&cap->lock);
+
+	while (1) {
+		struct segment *seg = &cap->segs[cap->tail];
+		int res;
+
+		while (!seg->full && !cap->stop)
+			pthread_cond_wait(&cap->cond, &cap->lock);
+
+		if (!seg->full)
+			break;
+
+		/* The segment is not touched by the recording thread until
+		 * it is given back, so it is written without holding the
+		 * lock.
+		 */
+		pthread_mutex_unlock(&cap->lock);
+		res = write_all(cap->fd, seg->data, seg->len);
+		pthread_mutex_lock(&cap->lock);
+
+		if (res < 0 && !cap->err)
+			cap->err = res;
+
+		seg->len = 0;
+		seg->full = false;
+		cap->tail = (cap->tail + 1) % SEGMENT_COUNT;
+		pthread_cond_broadcast(&cap->cond);
+	}
+
+	pthread_mutex_unlock(&cap->lock);
+	return NULL;
+}
+
+/* Hand the current segment over to the writer thread and move to the next
+ * one, if it is free. With 'wait' set, wait for it to be freed.
+ */
+static bool next_segment(struct avtp_net_capture *cap, bool wait)
+{
+	unsigned int next = (cap->head + 1) % SEGMENT_COUNT;
+	bool done = false;
+
+	pthread_mutex_lock(&cap->lock);
+
+	while (wait && cap->segs[next].full)
+		pthread_cond_wait(&cap->cond, &cap->lock);
+
+	if (!cap->segs[next].full) {
+		cap->segs[cap->head].full = true;
+		cap->head = next;
+		pthread_cond_broadcast(&cap->cond);
+		done = true;
+	}
+
+	pthread_mutex_unlock(&cap->lock);
+	return done;
+}
+
+/* Reserve 'size' bytes at the end of the current segment. They are only
+ * accounted for once the caller commits them by growing the segment length.
+ */
+static uint32_t *reserve(struct avtp_net_capture *cap, size_t size)
+{
+	struct segment *seg = &cap->segs[cap->head];
+
+	if (cap->seg_size - seg->len < size) {
+		if (!next_segment(cap, false))
+			return NULL;
+
+		seg = &cap->segs[cap->head];
+	}
+
+	return (uint32_t *) (seg->data + seg->len);
+}
+
+static void commit(struct avtp_net_capture *cap, size_t size)
+{
+	cap->segs[cap->head].len += size;
+}
+
+/* Write a pair of 16-bit fields sharing a 32-bit word. */
+static void put_halves(uint32_t *word, uint16_t first, uint16_t second)
+{
+	uint16_t halves[2] = { first, second };
+
+	memcpy(word, halves, sizeof(halves));
+}
+
+/* Section Header Block, followed by the description of the only interface
+ * recorded frames belong to. Blocks are written in host order, as allowed by
+ * pcapng.
+ */
+static void write_headers(struct avtp_net_capture *cap)
+{
+	uint32_t *blk = reserve(cap, SHB_SIZE + IDB_SIZE);
+
+	blk[0] = BLOCK_SHB;
+	blk[1] = SHB_SIZE;
+	blk[2] = BYTE_ORDER_MAGIC;
+	/* Version 1.0 and unspecified section length. */
+	put_halves(&blk[3], 1, 0);
+	blk[4] = UINT32_MAX;
+	blk[5] = UINT32_MAX;
+	blk[6] = SHB_SIZE;
+
+	blk += SHB_SIZE / sizeof(*blk);
+	blk[0] = BLOCK_IDB;
+	blk[1] = IDB_SIZE;
+	put_halves(&blk[2], LINKTYPE_ETHERNET, 0);
+	blk[3] = cap->snaplen;
+	/* if_tsresol option, padded to 32 bits, and end of options. */
+	put_halves(&blk[4], OPT_IF_TSRESOL, 1);
+	blk[5] = 0;
+	memset(&blk[5], TSRESOL_NSEC, 1);
+	blk[6] = OPT_END;
+	blk[7] = IDB_SIZE;
+
+	commit(cap, SHB_SIZE + IDB_SIZE);
+}
+
+int avtp_net_capture_create(struct avtp_net_capture **cap,
+				const struct avtp_net_capture_config *cfg)
+{
+	struct avtp_net_capture *c;
+	size_t buffer_size;
+	unsigned int i;
+	int res;
+
+	if (!cap || !cfg || !cfg->path)
+		return -EINVAL;
+
+	if (cfg->snaplen && (cfg->snaplen < ETH_HLEN ||
+						cfg->snaplen > MAX_SNAPLEN))
+		return -EINVAL;
+
+	c = calloc(1, sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	c->snaplen = cfg->snaplen ?: MAX_SNAPLEN;
+	memcpy(c->eth.h_dest, cfg->dst_addr, ETH_ALEN);
+	memcpy(c->eth.h_source, cfg->src_addr, ETH_ALEN);
+	c->eth.h_proto = htons(cfg->protocol ?: ETH_P_TSN);
+
+	/* Any segment must hold the largest record, and the first one the
+	 * file headers on top of it.
+	 */
+	buffer_size = cfg->buffer_size ?: DEFAULT_BUFFER_SIZE;
+	c->seg_size = buffer_size / SEGMENT_COUNT & ~(size_t) 3;
+	if (c->seg_size < SHB_SIZE + IDB_SIZE + EPB_HDR_SIZE +
+					PAD32(c->snaplen) + sizeof(uint32_t)) {
+		res = -EINVAL;
+		goto err;
+	}
+
+	c->buf = malloc(c->seg_size * SEGMENT_COUNT);
+	if (!c->buf) {
+		res = -ENOMEM;
+		goto err;
+	}
+
+	/* Fault the whole buffer in now rather than from the receive path. */
+	memset(c->buf, 0, c->seg_size * SEGMENT_COUNT);
+
+	for (i = 0; i < SEGMENT_COUNT; i++)
+		c->segs[i].data = c->buf + i * c->seg_size;
+
+	c->fd = open(cfg->path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+									0644);
+	if (c->fd < 0) {
+		res = -errno;
+		goto err_buf;
+	}
+
+	write_headers(c);
+
+	pthread_mutex_init(&c->lock, NULL);
+	pthread_cond_init(&c->cond, NULL);
+
+	res = pthread_create(&c->thread, NULL, writer_run, c);
+	if (res) {
+		res = -res;
+		goto err_thread;
+	}
+
+	*cap = c;
+	return 0;
+
+err_thread:
+	pthread_cond_destroy(&c->cond);
+	pthread_mutex_destroy(&c->lock);
+	close(c->fd);
+	unlink(cfg->path);
+err_buf:
+	free(c->buf);
+err:
+	free(c);
+	return res;
+}
+
+void avtp_net_capture_destroy(struct avtp_net_capture *cap)
+{
+	if (!cap)
+		return;
+
+	if (cap->segs[cap->head].len)
+		next_segment(cap, true);
+
+	pthread_mutex_lock(&cap->lock);
+	cap->stop = true;
+	pthread_cond_broadcast(&cap->cond);
+	pthread_mutex_unlock(&cap->lock);
+
+	pthread_join(cap->thread, NULL);
+
+	pthread_cond_destroy(&cap->cond);
+	pthread_mutex_destroy(&cap->lock);
+	close(cap->fd);
+	free(cap->buf);
+	free(cap);
+}
+
+int avtp_net_capture_write(struct avtp_net_capture *cap,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[], const uint64_t times[],
+				unsigned int count)
+{
+	unsigned int i, n = 0;
+
+	if (!cap || !pdus || !lens || !times)
+		return -EINVAL;
+
+	for (i = 0; i < count; i++) {
+		size_t len = ETH_HLEN + lens[i];
+		size_t caplen = len < cap->snaplen ? len : cap->snaplen;
+		size_t size = EPB_HDR_SIZE + PAD32(caplen) + sizeof(uint32_t);
+		uint8_t *frame;
+		uint32_t *blk;
+
+		blk = reserve(cap, size);
+		if (!blk) {
+			cap->stats.dropped++;
+			continue;
+		}
+
+		blk[0] = BLOCK_EPB;
+		blk[1] = size;
+		blk[2] = 0;
+		blk[3] = times[i] >> 32;
+		blk[4] = times[i];
+		blk[5] = caplen;
+		blk[6] = len;
+
+		frame = (uint8_t *) &blk[7];
+		memcpy(frame, &cap->eth, ETH_HLEN);
+		memcpy(frame + ETH_HLEN, pdus[i], caplen - ETH_HLEN);
+		memset(frame + caplen, 0, PAD32(caplen) - caplen);
+		blk[size / sizeof(*blk) - 1] = size;
+
+		commit(cap, size);
+		cap->stats.pdus++;
+		n++;
+	}
+
+	return n;
+}
+
+int avtp_net_capture_flush(struct avtp_net_capture *cap)
+{
+	unsigned int i;
+	int res;
+
+	if (!cap)
+		return -EINVAL;
+
+	if (cap->segs[cap->head].len)
+		next_segment(cap, true);
+
+	pthread_mutex_lock(&cap->lock);
+
+	for (i = 0; i < SEGMENT_COUNT; i++) {
+		while (cap->segs[i].full)
+			pthread_cond_wait(&cap->cond, &cap->lock);
+	}
+
+	res = cap->err;
+	pthread_mutex_unlock(&cap->lock);
+
+	return res;
+}
+
+int avtp_net_capture_get_stats(const struct avtp_net_capture *cap,
+				struct avtp_net_capture_stats *stats)
+{
+	if (!cap || !stats)
+		return -EINVAL;
+
+	*stats = cap->stats;
+	return 0;
+}
+
+struct iface {
+	bool ethernet;
+	/* if_tsresol option value, and the factor timestamps are multiplied
+	 * or divided by to get nanoseconds if it is a power of 10.
+	 */
+	uint8_t tsresol;
+	uint64_t scale;
+};
+
+struct avtp_net_replay {
+	const uint8_t *map;
+	size_t size;
+	uint16_t protocol;
+	double speed;
+	bool loop;
+
+	/* Offset of the next block to be parsed, and state of the section
+	 * it belongs to.
+	 */
+	size_t pos;
+	bool swapped;
+	struct iface *ifaces;
+	unsigned int iface_count;
+	unsigned int iface_max;
+	/* Time of the last Enhanced Packet Block, which Simple Packet Blocks
+	 * lack.
+	 */
+	uint64_t last_time;
+
+	/* Next PDU, parsed already but not retrieved yet. */
+	bool pending;
+	const struct avtp_stream_pdu *pdu;
+	size_t len;
+	uint64_t time;
+
+	/* Whether pacing has started, and then the monotonic time it started
+	 * and the capture time of the first PDU since then.
+	 */
+	bool started;
+	uint64_t start;
+	uint64_t base;
+};
+
+static uint64_t monotonic_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static uint16_t rd16(const struct avtp_net_replay *rp, const uint8_t *p)
+{
+	uint16_t val;
+
+	memcpy(&val, p, sizeof(val));
+	return rp->swapped ? __builtin_bswap16(val) : val;
+}
+
+static uint32_t rd32(const struct avtp_net_replay *rp, const uint8_t *p)
+{
+	uint32_t val;
+
+	memcpy(&val, p, sizeof(val));
+	return rp->swapped ? __builtin_bswap32(val) : val;
+}
+
+/* Convert a timestamp in units of the interface resolution: negative power
+ * of 2 if the most significant bit of 'tsresol' is set, negative power of 10
+ * otherwise.
+ */
+static uint64_t to_nsec(const struct iface *iface, uint64_t ts)
+{
+	unsigned int exp = iface->tsresol & 0x7F;
+
+	if (iface->tsresol & 0x80)
+		return ((unsigned __int128) ts * NSEC_PER_SEC) >> exp;
+
+	return exp <= 9 ? ts * iface->scale : ts / iface->scale;
+}
+
+static uint64_t tsresol_scale(uint8_t tsresol)
+{
+	unsigned int exp = tsresol & 0x7F;
+	unsigned int digits = exp <= 9 ? 9 - exp : exp - 9;
+	uint64_t scale = 1;
+
+	/* Scales of resolutions finer than 10^-19 s don't fit in 64 bits,
+	 * and are clamped.
+	 */
+	if (digits > 10)
+		digits = 10;
+
+	while (digits--)
+		scale *= 10;
+
+	return scale;
+}
+
+static int parse_shb(struct avtp_net_replay *rp, const uint8_t *blk,
+							size_t avail)
+{
+	uint32_t magic;
+
+	if (avail < SHB_SIZE)
+		return -EBADMSG;
+
+	memcpy(&magic, blk + 8, sizeof(magic));
+	if (magic == BYTE_ORDER_MAGIC)
+		rp->swapped = false;
+	else if (magic == __builtin_bswap32(BYTE_ORDER_MAGIC))
+		rp->swapped = true;
+	else
+		return -EBADMSG;
+
+	/* Interfaces are only valid within their section. */
+	rp->iface_count = 0;
+	return 0;
+}
+
+static int parse_idb(struct avtp_net_replay *rp, const uint8_t *blk,
+							uint32_t len)
+{
+	const uint8_t *opt = blk + 16;
+	const uint8_t *end = blk + len - sizeof(uint32_t);
+	struct iface *iface;
+
+	if (len < 20)
+		return -EBADMSG;
+
+	if (rp->iface_count == rp->iface_max) {
+		unsigned int max = rp->iface_max ? rp->iface_max * 2 : 4;
+
+		iface = realloc(rp->ifaces, max * sizeof(*iface));
+		if (!iface)
+			return -ENOMEM;
+
+		rp->ifaces = iface;
+		rp->iface_max = max;
+	}
+
+	iface = &rp->ifaces[rp->iface_count++];
+	iface->ethernet = rd16(rp, blk + 8) == LINKTYPE_ETHERNET;
+	iface->tsresol = TSRESOL_DEFAULT;
+
+	while (end - opt >= 4) {
+		uint16_t code = rd16(rp, opt);
+		uint16_t olen = rd16(rp, opt + 2);
+
+		if (code == OPT_END || PAD32(olen) > (size_t) (end - opt - 4))
+			break;
+
+		if (code == OPT_IF_TSRESOL && olen >= 1)
+			iface->tsresol = opt[4];
+
+		opt += 4 + PAD32(olen);
+	}
+
+	iface->scale = tsresol_scale(iface->tsresol);
+	return 0;
+}
+
+/* Locate the PDU in a frame captured on interface 'ifid'. */
+static bool parse_frame(struct avtp_net_replay *rp, uint32_t ifid,
+				const uint8_t *frame, size_t caplen)
+{
+	size_t off = ETH_HLEN;
+	uint16_t proto;
+
+	if (ifid >= rp->iface_count || !rp->ifaces[ifid].ethernet ||
+							caplen < ETH_HLEN)
+		return false;
+
+	proto = get_unaligned_be16(frame + 12);
+	if (proto == ETH_P_8021Q || proto == ETH_P_8021AD) {
+		if (caplen < ETH_HLEN + 4)
+			return false;
+
+		proto = get_unaligned_be16(frame + 16);
+		off += 4;
+	}
+
+	if (proto != rp->protocol)
+		return false;
+
+	rp->pdu = (const struct avtp_stream_pdu *) (frame + off);
+	rp->len = caplen - off;
+	rp->pending = true;
+	return true;
+}
+
+/* Parse blocks until the next PDU is found.
+ *
+ * Returns:
+ *    1: A PDU is pending.
+ *    0: The end of the file has been reached.
+ *    Negative errno value: If the file is corrupted.
+ */
+static int parse_next(struct avtp_net_replay *rp)
+{
+	while (!rp->pending) {
+		const uint8_t *blk = rp->map + rp->pos;
+		size_t avail = rp->size - rp->pos;
+		uint32_t type, len, ifid, caplen;
+		uint64_t ts;
+		int res;
+
+		if (avail == 0)
+			return 0;
+		if (avail < BLOCK_MIN_SIZE)
+			return -EBADMSG;
+
+		/* The SHB type reads the same in both byte orders, and the
+		 * SHB sets the byte order its section is read with.
+		 */
+		type = rd32(rp, blk);
+		if (type == BLOCK_SHB) {
+			res = parse_shb(rp, blk, avail);
+			if (res < 0)
+				return res;
+		}
+
+		len = rd32(rp, blk + 4);
+		if (len < BLOCK_MIN_SIZE || len % 4 || len > avail)
+			return -EBADMSG;
+
+		rp->pos += len;
+
+		switch (type) {
+		case BLOCK_IDB:
+			res = parse_idb(rp, blk, len);
+			if (res < 0)
+				return res;
+			break;
+		case BLOCK_EPB:
+			if (len < EPB_HDR_SIZE + sizeof(uint32_t))
+				return -EBADMSG;
+
+			ifid = rd32(rp, blk + 8);
+			ts = (uint64_t) rd32(rp, blk + 12) << 32 |
+							rd32(rp, blk + 16);
+			caplen = rd32(rp, blk + 20);
+			if (caplen > len - EPB_HDR_SIZE - sizeof(uint32_t))
+				return -EBADMSG;
+
+			if (ifid < rp->iface_count)
+				rp->last_time = to_nsec(&rp->ifaces[ifid],
+									ts);
+
+			rp->time = rp->last_time;
+			parse_frame(rp, ifid, blk + EPB_HDR_SIZE, caplen);
+			break;
+		case BLOCK_SPB:
+			if (len < 16)
+				return -EBADMSG;
+
+			/* Frames are truncated to the block, and belong to
+			 * the first interface.
+			 */
+			caplen = rd32(rp, blk + 8);
+			if (caplen > len - 16)
+				caplen = len - 16;
+
+			rp->time = rp->last_time;
+			parse_frame(rp, 0, blk + 12, caplen);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return 1;
+}
+
+/* Parse the next PDU, starting over at the end of the file if the replay
+ * loops.
+ */
+static int next_pdu(struct avtp_net_replay *rp)
+{
+	int res;
+
+	res = parse_next(rp);
+	if (res != 0)
+		return res;
+
+	if (!rp->loop)
+		return -ENODATA;
+
+	avtp_net_replay_rewind(rp);
+
+	res = parse_next(rp);
+	return res == 0 ? -ENODATA : res;
+}
+
+/* Time, on CLOCK_MONOTONIC, the pending PDU is due. Pacing starts at 'now'
+ * if it hasn't started yet.
+ */
+static uint64_t due_time(struct avtp_net_replay *rp, uint64_t now)
+{
+	if (!rp->started) {
+		rp->started = true;
+		rp->start = now;
+		rp->base = rp->time;
+	}
+
+	/* Captures may not be in time order, so PDUs captured before the
+	 * first one are due right away.
+	 */
+	if (rp->time <= rp->base)
+		return rp->start;
+
+	return rp->start + (uint64_t) ((rp->time - rp->base) / rp->speed);
+}
+
+int avtp_net_replay_create(struct avtp_net_replay **rp,
+				const struct avtp_net_replay_config *cfg)
+{
+	struct avtp_net_replay *r;
+	struct stat st;
+	uint32_t type;
+	void *map;
+	int fd, res;
+
+	if (!rp || !cfg || !cfg->path || cfg->speed < 0)
+		return -EINVAL;
+
+	r = calloc(1, sizeof(*r));
+	if (!r)
+		return -ENOMEM;
+
+	r->protocol = cfg->protocol ?: ETH_P_TSN;
+	r->speed = cfg->speed;
+	r->loop = cfg->loop;
+
+	fd = open(cfg->path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		res = -errno;
+		goto err;
+	}
+
+	if (fstat(fd, &st) < 0) {
+		res = -errno;
+		goto err_fd;
+	}
+
+	r->size = st.st_size;
+	if (r->size < SHB_SIZE) {
+		res = -EBADMSG;
+		goto err_fd;
+	}
+
+	/* Read the whole file in now so replaying it doesn't fault pages in
+	 * from the disk.
+	 */
+	map = mmap(NULL, r->size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd,
+									0);
+	if (map == MAP_FAILED) {
+		res = -errno;
+		goto err_fd;
+	}
+
+	close(fd);
+	r->map = map;
+
+	memcpy(&type, r->map, sizeof(type));
+	if (type != BLOCK_SHB) {
+		res = -EBADMSG;
+		goto err_map;
+	}
+
+	*rp = r;
+	return 0;
+
+err_map:
+	munmap(map, r->size);
+	free(r);
+	return res;
+err_fd:
+	close(fd);
+err:
+	free(r);
+	return res;
+}
+
+void avtp_net_replay_destroy(struct avtp_net_replay *rp)
+{
+	if (!rp)
+		return;
+
+	munmap((void *) rp->map, rp->size);
+	free(rp->ifaces);
+	free(rp);
+}
+
+int avtp_net_replay_recv(struct avtp_net_replay *rp,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				unsigned int max)
+{
+	unsigned int n = 0;
+	uint64_t now = 0;
+	int res;
+
+	if (!rp || !pdus || !lens)
+		return -EINVAL;
+
+	/* The clock is read once per call, so PDUs due meanwhile are left
+	 * for the next one.
+	 */
+	if (rp->speed > 0)
+		now = monotonic_now();
+
+	while (n < max) {
+		/* Don't start over within a call, so PDUs from both ends of
+		 * a looping replay are never returned together.
+		 */
+		res = n ? parse_next(rp) : next_pdu(rp);
+		if (res < 0)
+			return res;
+		if (res == 0)
+			break;
+
+		if (rp->speed > 0 && due_time(rp, now) > now)
+			break;
+
+		pdus[n] = rp->pdu;
+		lens[n] = rp->len;
+		if (times)
+			times[n] = rp->time;
+		rp->pending = false;
+		n++;
+	}
+
+	return n;
+}
+
+int avtp_net_replay_classify(struct avtp_net_replay *rp,
+				struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				struct avtp_classifier_result results[],
+				unsigned int max)
+{
+	int res, n;
+
+	if (!cls || !results)
+		return -EINVAL;
+
+	n = avtp_net_replay_recv(rp, pdus, lens, times, max);
+	if (n <= 0)
+		return n;
+
+	res = avtp_classifier_classify(cls, pdus, lens, n, results);
+	if (res < 0)
+		return res;
+
+	return n;
+}
+
+int avtp_net_replay_get_deadline(struct avtp_net_replay *rp,
+							uint64_t *deadline)
+{
+	int res;
+
+	if (!rp || !deadline)
+		return -EINVAL;
+
+	res = next_pdu(rp);
+	if (res < 0)
+		return res;
+
+	*deadline = rp->speed > 0 ? due_time(rp, monotonic_now()) : 0;
+	return 0;
+}
+
+int avtp_net_replay_rewind(struct avtp_net_replay *rp)
+{
+	if (!rp)
+		return -EINVAL;
+
+	rp->pos = 0;
+	rp->swapped = false;
+	rp->iface_count = 0;
+	rp->last_time = 0;
+	rp->pending = false;
+	rp->started = false;
+
+	return 0;
+}
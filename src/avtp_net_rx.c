@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_net.h"
+#include "avtp_net_tstamp.h"
+#include "avtp_net_xdp.h"
+
+#define DEFAULT_BLOCK_SIZE		(1 << 16)
+#define DEFAULT_BLOCK_COUNT		64
+#define DEFAULT_FRAME_SIZE		2048
+
+#define NSEC_PER_SEC			1000000000ULL
+
+struct avtp_net_rx {
+	int fd;
+	uint8_t *ring;
+	size_t ring_size;
+	unsigned int block_size;
+	unsigned int block_count;
+	int ifindex;
+	enum avtp_net_tstamp tstamp;
+	/* AF_XDP socket, if the ring uses the XDP backend. Then 'fd' is only
+	 * used to add multicast memberships.
+	 */
+	struct avtp_net_xdp *xdp;
+
+	/* Index of the block the ring is currently at. */
+	unsigned int block;
+	/* Whether the current block is owned by us, i.e. it has been handed
+	 * over by the kernel and not given back yet.
+	 */
+	bool owned;
+	/* Next packet to be retrieved from the current block and number of
+	 * packets left to be retrieved from it.
+	 */
+	struct tpacket3_hdr *pkt;
+	unsigned int pkts_left;
+};
+
+static struct tpacket_block_desc *block_desc(struct avtp_net_rx *rx,
+							unsigned int block)
+{
+	return (struct tpacket_block_desc *) (rx->ring +
+					(size_t) block * rx->block_size);
+}
+
+/* Take ownership of the current block, if the kernel has handed it over. */
+static bool acquire_block(struct avtp_net_rx *rx)
+{
+	struct tpacket_block_desc *desc = block_desc(rx, rx->block);
+	uint32_t status;
+
+	status = __atomic_load_n(&desc->hdr.bh1.block_status,
+							__ATOMIC_ACQUIRE);
+	if (!(status & TP_STATUS_USER))
+		return false;
+
+	rx->owned = true;
+	rx->pkts_left = desc->hdr.bh1.num_pkts;
+	rx->pkt = (struct tpacket3_hdr *) ((uint8_t *) desc +
+					desc->hdr.bh1.offset_to_first_pkt);
+	return true;
+}
+
+/* Give the current block back to the kernel and move to the next one. */
+static void release_block(struct avtp_net_rx *rx)
+{
+	struct tpacket_block_desc *desc = block_desc(rx, rx->block);
+
+	__atomic_store_n(&desc->hdr.bh1.block_status, TP_STATUS_KERNEL,
+							__ATOMIC_RELEASE);
+
+	rx->owned = false;
+	rx->block = (rx->block + 1) % rx->block_count;
+}
+
+static int setup_ring(struct avtp_net_rx *rx,
+				const struct avtp_net_rx_config *cfg)
+{
+	struct tpacket_req3 req = { 0 };
+	int version = TPACKET_V3;
+	long page_size;
+	int res;
+
+	rx->block_size = cfg->block_size ?: DEFAULT_BLOCK_SIZE;
+	rx->block_count = cfg->block_count ?: DEFAULT_BLOCK_COUNT;
+
+	req.tp_block_size = rx->block_size;
+	req.tp_block_nr = rx->block_count;
+	req.tp_frame_size = cfg->frame_size ?: DEFAULT_FRAME_SIZE;
+	req.tp_retire_blk_tov = cfg->block_timeout;
+
+	page_size = sysconf(_SC_PAGESIZE);
+	if (page_size <= 0 || req.tp_block_size % page_size ||
+				req.tp_frame_size % TPACKET_ALIGNMENT ||
+				req.tp_frame_size > req.tp_block_size)
+		return -EINVAL;
+
+	req.tp_frame_nr = (req.tp_block_size / req.tp_frame_size) *
+							req.tp_block_nr;
+
+	res = setsockopt(rx->fd, SOL_PACKET, PACKET_VERSION, &version,
+							sizeof(version));
+	if (res < 0)
+		return -errno;
+
+	res = setsockopt(rx->fd, SOL_PACKET, PACKET_RX_RING, &req,
+								sizeof(req));
+	if (res < 0)
+		return -errno;
+
+	rx->ring_size = (size_t) req.tp_block_size * req.tp_block_nr;
+	rx->ring = mmap(NULL, rx->ring_size, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, rx->fd, 0);
+	if (rx->ring == MAP_FAILED) {
+		rx->ring = NULL;
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int create_xdp(struct avtp_net_rx *rx,
+				const struct avtp_net_rx_config *cfg)
+{
+	int res;
+
+	/* A packet socket with no protocol doesn't receive any frame, it is
+	 * only used to add multicast memberships.
+	 */
+	rx->fd = socket(AF_PACKET, SOCK_DGRAM, 0);
+	if (rx->fd < 0)
+		return -errno;
+
+	res = avtp_net_xdp_rx_create(&rx->xdp, cfg, rx->ifindex);
+	if (res < 0) {
+		close(rx->fd);
+		return res;
+	}
+
+	return 0;
+}
+
+int avtp_net_rx_create(struct avtp_net_rx **rx,
+				const struct avtp_net_rx_config *cfg)
+{
+	struct sockaddr_ll addr = { 0 };
+	struct avtp_net_rx *r;
+	int res;
+
+	if (!rx || !cfg || !cfg->ifname)
+		return -EINVAL;
+
+	r = calloc(1, sizeof(*r));
+	if (!r)
+		return -ENOMEM;
+
+	r->ifindex = if_nametoindex(cfg->ifname);
+	if (!r->ifindex) {
+		res = -errno;
+		goto err_free;
+	}
+
+	r->tstamp = cfg->tstamp;
+
+	if (cfg->backend == AVTP_NET_BACKEND_XDP) {
+		res = -EOPNOTSUPP;
+		if (cfg->tstamp != AVTP_NET_TSTAMP_NONE)
+			goto err_free;
+
+		res = create_xdp(r, cfg);
+		if (res < 0)
+			goto err_free;
+
+		*rx = r;
+		return 0;
+	}
+
+	if (cfg->backend != AVTP_NET_BACKEND_PACKET) {
+		res = -EINVAL;
+		goto err_free;
+	}
+
+	/* Socket is opened with no protocol so it doesn't receive any frame
+	 * until bound below, once the ring is set up.
+	 */
+	r->fd = socket(AF_PACKET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+	if (r->fd < 0) {
+		res = -errno;
+		goto err_free;
+	}
+
+	res = avtp_net_tstamp_enable(r->fd, cfg->ifname, cfg->tstamp, false);
+	if (res < 0)
+		goto err_close;
+
+	/* Ring is set up before binding so no frame is queued outside it. */
+	res = setup_ring(r, cfg);
+	if (res < 0)
+		goto err_close;
+
+	addr.sll_family = AF_PACKET;
+	addr.sll_protocol = htons(cfg->protocol);
+	addr.sll_ifindex = r->ifindex;
+
+	res = bind(r->fd, (struct sockaddr *) &addr, sizeof(addr));
+	if (res < 0) {
+		res = -errno;
+		goto err_unmap;
+	}
+
+	*rx = r;
+	return 0;
+
+err_unmap:
+	munmap(r->ring, r->ring_size);
+err_close:
+	close(r->fd);
+err_free:
+	free(r);
+	return res;
+}
+
+void avtp_net_rx_destroy(struct avtp_net_rx *rx)
+{
+	if (!rx)
+		return;
+
+	if (rx->xdp)
+		avtp_net_xdp_destroy(rx->xdp);
+	else
+		munmap(rx->ring, rx->ring_size);
+
+	close(rx->fd);
+	free(rx);
+}
+
+int avtp_net_rx_get_fd(const struct avtp_net_rx *rx)
+{
+	if (!rx)
+		return -EINVAL;
+
+	if (rx->xdp)
+		return avtp_net_xdp_get_fd(rx->xdp);
+
+	return rx->fd;
+}
+
+int avtp_net_rx_add_membership(struct avtp_net_rx *rx,
+						const uint8_t macaddr[6])
+{
+	struct packet_mreq mreq = { 0 };
+	int res;
+
+	if (!rx || !macaddr)
+		return -EINVAL;
+
+	mreq.mr_ifindex = rx->ifindex;
+	mreq.mr_type = PACKET_MR_MULTICAST;
+	mreq.mr_alen = ETH_ALEN;
+	memcpy(mreq.mr_address, macaddr, ETH_ALEN);
+
+	res = setsockopt(rx->fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq,
+								sizeof(mreq));
+	if (res < 0)
+		return -errno;
+
+	return 0;
+}
+
+/* Arrival time of a packet from the ring. Packets always carry a software
+ * timestamp, so hardware ones are told apart by their status.
+ */
+static uint64_t pkt_time(const struct avtp_net_rx *rx,
+					const struct tpacket3_hdr *pkt)
+{
+	if (rx->tstamp == AVTP_NET_TSTAMP_NONE ||
+			(rx->tstamp == AVTP_NET_TSTAMP_HARDWARE &&
+			!(pkt->tp_status & TP_STATUS_TS_RAW_HARDWARE)))
+		return 0;
+
+	return pkt->tp_sec * NSEC_PER_SEC + pkt->tp_nsec;
+}
+
+int avtp_net_rx_recv_ts(struct avtp_net_rx *rx,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				unsigned int max)
+{
+	unsigned int n = 0;
+
+	if (!rx || !pdus || !lens)
+		return -EINVAL;
+
+	if (rx->xdp) {
+		int res = avtp_net_xdp_recv(rx->xdp, pdus, lens, max);
+
+		if (times && res > 0)
+			memset(times, 0, res * sizeof(*times));
+
+		return res;
+	}
+
+	/* PDUs returned by the previous call may live in the current block,
+	 * so it is only given back to the kernel now, once it is exhausted.
+	 */
+	while (!rx->owned || rx->pkts_left == 0) {
+		if (rx->owned)
+			release_block(rx);
+
+		if (!acquire_block(rx))
+			return 0;
+	}
+
+	while (n < max && rx->pkts_left) {
+		struct tpacket3_hdr *pkt = rx->pkt;
+
+		/* With SOCK_DGRAM sockets, the network header is the AVTPDU
+		 * itself.
+		 */
+		pdus[n] = (const struct avtp_stream_pdu *) ((uint8_t *) pkt +
+								pkt->tp_net);
+		lens[n] = pkt->tp_snaplen;
+		if (times)
+			times[n] = pkt_time(rx, pkt);
+		n++;
+
+		rx->pkt = (struct tpacket3_hdr *) ((uint8_t *) pkt +
+							pkt->tp_next_offset);
+		rx->pkts_left--;
+	}
+
+	return n;
+}
+
+int avtp_net_rx_recv(struct avtp_net_rx *rx,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], unsigned int max)
+{
+	return avtp_net_rx_recv_ts(rx, pdus, lens, NULL, max);
+}
+
+int avtp_net_rx_classify(struct avtp_net_rx *rx, struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[],
+				struct avtp_classifier_result results[],
+				unsigned int max)
+{
+	int res, n;
+
+	if (!cls || !results)
+		return -EINVAL;
+
+	n = avtp_net_rx_recv(rx, pdus, lens, max);
+	if (n <= 0)
+		return n;
+
+	res = avtp_classifier_classify(cls, pdus, lens, n, results);
+	if (res < 0)
+		return res;
+
+	return n;
+}
+
+int avtp_net_rx_classify_ts(struct avtp_net_rx *rx,
+				struct avtp_classifier *cls,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], uint64_t times[],
+				struct avtp_classifier_result results[],
+				unsigned int max)
+{
+	int res, n;
+
+	if (!cls || !results)
+		return -EINVAL;
+
+	n = avtp_net_rx_recv_ts(rx, pdus, lens, times, max);
+	if (n <= 0)
+		return n;
+
+	res = avtp_classifier_classify(cls, pdus, lens, n, results);
+	if (res < 0)
+		return res;
+
+	return n;
+}
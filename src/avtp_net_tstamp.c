@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <linux/if_packet.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+#include <net/if.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+#include "avtp_net.h"
+#include "avtp_net_tstamp.h"
+
+static int enable_device(int fd, const char *ifname, bool tx)
+{
+	struct hwtstamp_config hwc;
+	struct ifreq ifr = { 0 };
+
+	snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", ifname);
+	ifr.ifr_data = (void *) &hwc;
+
+	/* Keep the configuration of the other direction, which other
+	 * sockets may rely on. Drivers which can't report it start from
+	 * scratch.
+	 */
+	memset(&hwc, 0, sizeof(hwc));
+	if (ioctl(fd, SIOCGHWTSTAMP, &ifr) < 0)
+		memset(&hwc, 0, sizeof(hwc));
+
+	if (tx) {
+		if (hwc.tx_type == HWTSTAMP_TX_ON)
+			return 0;
+
+		hwc.tx_type = HWTSTAMP_TX_ON;
+	} else {
+		/* AVTP frames are not PTP events, so filters for PTP
+		 * frames don't do.
+		 */
+		if (hwc.rx_filter == HWTSTAMP_FILTER_ALL)
+			return 0;
+
+		hwc.rx_filter = HWTSTAMP_FILTER_ALL;
+	}
+
+	hwc.flags = 0;
+	if (ioctl(fd, SIOCSHWTSTAMP, &ifr) < 0)
+		return errno == ENOTTY || errno == ERANGE ? -EOPNOTSUPP :
+									-errno;
+
+	return 0;
+}
+
+int avtp_net_tstamp_enable(int fd, const char *ifname,
+				enum avtp_net_tstamp tstamp, bool tx)
+{
+	unsigned int flags;
+	int res;
+
+	switch (tstamp) {
+	case AVTP_NET_TSTAMP_NONE:
+		return 0;
+	case AVTP_NET_TSTAMP_SOFTWARE:
+		flags = SOF_TIMESTAMPING_SOFTWARE | (tx ?
+					SOF_TIMESTAMPING_TX_SOFTWARE :
+					SOF_TIMESTAMPING_RX_SOFTWARE);
+		break;
+	case AVTP_NET_TSTAMP_HARDWARE:
+		res = enable_device(fd, ifname, tx);
+		if (res < 0)
+			return res;
+
+		flags = SOF_TIMESTAMPING_RAW_HARDWARE | (tx ?
+					SOF_TIMESTAMPING_TX_HARDWARE :
+					SOF_TIMESTAMPING_RX_HARDWARE);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (tx)
+		flags |= SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+
+	res = setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+							sizeof(flags));
+	if (res < 0)
+		return -errno;
+
+	/* The RX ring stores software timestamps unless told otherwise. */
+	if (!tx && tstamp == AVTP_NET_TSTAMP_HARDWARE) {
+		flags = SOF_TIMESTAMPING_RAW_HARDWARE;
+
+		res = setsockopt(fd, SOL_PACKET, PACKET_TIMESTAMP, &flags,
+							sizeof(flags));
+		if (res < 0)
+			return -errno;
+	}
+
+	return 0;
+}
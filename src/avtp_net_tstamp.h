@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include "avtp_net.h"
+
+#pragma GCC visibility push(hidden)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Enable timestamping of frames received, or transmitted if 'tx' is set, on
+ * a packet socket. Hardware timestamping is enabled on the device as well,
+ * keeping what it has enabled already for the other direction. Transmitted
+ * frames are reported without their payload, keyed by their index in
+ * transmission order.
+ * @fd: Packet socket.
+ * @ifname: Name of the interface the socket sends or receives on.
+ * @tstamp: Timestamping mode.
+ * @tx: Whether transmitted frames are timestamped, instead of received ones.
+ *
+ * Returns:
+ *    0: Success.
+ *    -EOPNOTSUPP: If the device doesn't support hardware timestamping.
+ *    Other negative errno value: If timestamping couldn't be enabled.
+ */
+int avtp_net_tstamp_enable(int fd, const char *ifname,
+				enum avtp_net_tstamp tstamp, bool tx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
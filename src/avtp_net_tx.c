@@ -0,0 +1,564 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Required by sendmmsg(). */
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <linux/errqueue.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/net_tstamp.h>
+#include <net/if.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_net.h"
+#include "avtp_net_tstamp.h"
+#include "avtp_net_tx.h"
+#include "avtp_net_xdp.h"
+
+#ifndef SO_TXTIME
+#define SO_TXTIME			61
+#define SCM_TXTIME			SO_TXTIME
+#endif
+
+#define DEFAULT_QUEUE_SIZE		64
+#define DEFAULT_MAX_PDU_SIZE		1500
+
+/* Launch times of the last transmitted PDUs are kept for this many queue
+ * sizes' worth of PDUs, so reports can still be matched with them.
+ */
+#define LAUNCH_HISTORY_FACTOR		4
+
+#define NSEC_PER_SEC			1000000000ULL
+
+struct tx_slot {
+	struct sockaddr_ll addr;
+	struct iovec iov;
+	uint64_t launch_time;
+	union {
+		struct cmsghdr align;
+		uint8_t buf[CMSG_SPACE(sizeof(uint64_t))];
+	} control;
+};
+
+struct avtp_net_tx {
+	int fd;
+	int ifindex;
+	uint16_t protocol;
+	bool txtime;
+	/* AF_XDP socket, if the queue uses the XDP backend. Then other fields
+	 * below are unused.
+	 */
+	struct avtp_net_xdp *xdp;
+
+	unsigned int queue_size;
+	unsigned int max_pdu_size;
+	/* Index of the first queued PDU not transmitted yet. */
+	unsigned int head;
+	/* Number of queued PDUs, including those already transmitted by a
+	 * flush which didn't transmit all of them.
+	 */
+	unsigned int count;
+	bool reserved;
+
+	/* Messages are set up once and handed to sendmmsg() as they are. */
+	struct mmsghdr *msgs;
+	struct tx_slot *slots;
+	uint8_t *bufs;
+
+	/* Timestamping: index of the next PDU transmitted, launch times of
+	 * the last transmitted ones, indexed by PDU index modulo the history
+	 * size (a power of two), and messages the error queue is read into.
+	 */
+	enum avtp_net_tstamp tstamp;
+	uint32_t next_id;
+	uint64_t *launch_times;
+	uint32_t history_mask;
+	struct mmsghdr *err_msgs;
+	struct err_control *err_control;
+};
+
+/* Control messages of a report: the timestamps and the extended error which
+ * tells the PDU index.
+ */
+struct err_control {
+	union {
+		struct cmsghdr align;
+		uint8_t buf[CMSG_SPACE(sizeof(struct scm_timestamping)) +
+				CMSG_SPACE(sizeof(struct sock_extended_err) +
+					sizeof(struct sockaddr_ll))];
+	};
+};
+
+static int setup_socket(struct avtp_net_tx *tx,
+				const struct avtp_net_tx_config *cfg)
+{
+	int res;
+
+	tx->fd = socket(AF_PACKET, SOCK_DGRAM, htons(cfg->protocol));
+	if (tx->fd < 0)
+		return -errno;
+
+	if (cfg->priority) {
+		res = setsockopt(tx->fd, SOL_SOCKET, SO_PRIORITY,
+				&cfg->priority, sizeof(cfg->priority));
+		if (res < 0)
+			goto err;
+	}
+
+	if (cfg->txtime) {
+		struct sock_txtime txtime = {
+			.clockid = cfg->clockid,
+		};
+
+		res = setsockopt(tx->fd, SOL_SOCKET, SO_TXTIME, &txtime,
+							sizeof(txtime));
+		if (res < 0)
+			goto err;
+	}
+
+	res = avtp_net_tstamp_enable(tx->fd, cfg->ifname, cfg->tstamp, true);
+	if (res < 0) {
+		close(tx->fd);
+		return res;
+	}
+
+	return 0;
+
+err:
+	res = -errno;
+	close(tx->fd);
+	return res;
+}
+
+static int setup_reports(struct avtp_net_tx *tx)
+{
+	unsigned int i, history = 1;
+
+	while (history < tx->queue_size * LAUNCH_HISTORY_FACTOR)
+		history <<= 1;
+
+	tx->history_mask = history - 1;
+	tx->launch_times = calloc(history, sizeof(*tx->launch_times));
+	tx->err_msgs = calloc(AVTP_NET_TX_REPORT_BATCH,
+						sizeof(*tx->err_msgs));
+	tx->err_control = calloc(AVTP_NET_TX_REPORT_BATCH,
+						sizeof(*tx->err_control));
+	if (!tx->launch_times || !tx->err_msgs || !tx->err_control)
+		return -ENOMEM;
+
+	/* Reports carry no payload, only control messages. */
+	for (i = 0; i < AVTP_NET_TX_REPORT_BATCH; i++) {
+		struct msghdr *msg = &tx->err_msgs[i].msg_hdr;
+
+		msg->msg_control = tx->err_control[i].buf;
+		msg->msg_controllen = sizeof(tx->err_control[i].buf);
+	}
+
+	return 0;
+}
+
+static void init_slots(struct avtp_net_tx *tx)
+{
+	unsigned int i;
+
+	for (i = 0; i < tx->queue_size; i++) {
+		struct tx_slot *slot = &tx->slots[i];
+		struct msghdr *msg = &tx->msgs[i].msg_hdr;
+
+		slot->addr.sll_family = AF_PACKET;
+		slot->addr.sll_protocol = htons(tx->protocol);
+		slot->addr.sll_ifindex = tx->ifindex;
+		slot->addr.sll_halen = ETH_ALEN;
+		slot->iov.iov_base = tx->bufs + (size_t) i * tx->max_pdu_size;
+
+		msg->msg_name = &slot->addr;
+		msg->msg_namelen = sizeof(slot->addr);
+		msg->msg_iov = &slot->iov;
+		msg->msg_iovlen = 1;
+
+		if (tx->txtime) {
+			struct cmsghdr *cmsg;
+
+			msg->msg_control = slot->control.buf;
+			msg->msg_controllen = sizeof(slot->control.buf);
+
+			cmsg = CMSG_FIRSTHDR(msg);
+			cmsg->cmsg_level = SOL_SOCKET;
+			cmsg->cmsg_type = SCM_TXTIME;
+			cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+		}
+	}
+}
+
+int avtp_net_tx_create(struct avtp_net_tx **tx,
+				const struct avtp_net_tx_config *cfg)
+{
+	struct avtp_net_tx *t;
+	int res;
+
+	if (!tx || !cfg || !cfg->ifname || (cfg->backend !=
+				AVTP_NET_BACKEND_PACKET &&
+				cfg->backend != AVTP_NET_BACKEND_XDP))
+		return -EINVAL;
+
+	if (cfg->backend == AVTP_NET_BACKEND_XDP &&
+				cfg->tstamp != AVTP_NET_TSTAMP_NONE)
+		return -EOPNOTSUPP;
+
+	t = calloc(1, sizeof(*t));
+	if (!t)
+		return -ENOMEM;
+
+	t->protocol = cfg->protocol;
+	t->txtime = cfg->txtime;
+	t->queue_size = cfg->queue_size ?: DEFAULT_QUEUE_SIZE;
+	t->max_pdu_size = cfg->max_pdu_size ?: DEFAULT_MAX_PDU_SIZE;
+	t->tstamp = cfg->tstamp;
+
+	t->ifindex = if_nametoindex(cfg->ifname);
+	if (!t->ifindex) {
+		res = -errno;
+		goto err_free;
+	}
+
+	if (cfg->backend == AVTP_NET_BACKEND_XDP) {
+		res = avtp_net_xdp_tx_create(&t->xdp, cfg, t->ifindex);
+		if (res < 0)
+			goto err_free;
+
+		*tx = t;
+		return 0;
+	}
+
+	t->msgs = calloc(t->queue_size, sizeof(*t->msgs));
+	t->slots = calloc(t->queue_size, sizeof(*t->slots));
+	t->bufs = calloc(t->queue_size, t->max_pdu_size);
+	if (!t->msgs || !t->slots || !t->bufs) {
+		res = -ENOMEM;
+		goto err_free;
+	}
+
+	if (t->tstamp != AVTP_NET_TSTAMP_NONE) {
+		res = setup_reports(t);
+		if (res < 0)
+			goto err_free;
+	}
+
+	res = setup_socket(t, cfg);
+	if (res < 0)
+		goto err_free;
+
+	init_slots(t);
+
+	*tx = t;
+	return 0;
+
+err_free:
+	free(t->err_control);
+	free(t->err_msgs);
+	free(t->launch_times);
+	free(t->bufs);
+	free(t->slots);
+	free(t->msgs);
+	free(t);
+	return res;
+}
+
+void avtp_net_tx_destroy(struct avtp_net_tx *tx)
+{
+	if (!tx)
+		return;
+
+	if (tx->xdp)
+		avtp_net_xdp_destroy(tx->xdp);
+	else
+		close(tx->fd);
+
+	free(tx->err_control);
+	free(tx->err_msgs);
+	free(tx->launch_times);
+	free(tx->bufs);
+	free(tx->slots);
+	free(tx->msgs);
+	free(tx);
+}
+
+int avtp_net_tx_get_fd(const struct avtp_net_tx *tx)
+{
+	if (!tx)
+		return -EINVAL;
+
+	if (tx->xdp)
+		return avtp_net_xdp_get_fd(tx->xdp);
+
+	return tx->fd;
+}
+
+int avtp_net_tx_reserve(struct avtp_net_tx *tx, void **buf)
+{
+	if (!tx || !buf)
+		return -EINVAL;
+
+	if (tx->xdp)
+		return avtp_net_xdp_reserve(tx->xdp, buf);
+
+	if (tx->count == tx->queue_size)
+		return -ENOSPC;
+
+	tx->reserved = true;
+	*buf = tx->slots[tx->count].iov.iov_base;
+	return 0;
+}
+
+int avtp_net_tx_commit(struct avtp_net_tx *tx, const uint8_t macaddr[6],
+					size_t len, uint64_t launch_time)
+{
+	struct tx_slot *slot;
+
+	if (!tx || !macaddr)
+		return -EINVAL;
+
+	if (tx->xdp)
+		return avtp_net_xdp_commit(tx->xdp, macaddr, len);
+
+	if (!tx->reserved || len > tx->max_pdu_size)
+		return -EINVAL;
+
+	slot = &tx->slots[tx->count];
+	memcpy(slot->addr.sll_addr, macaddr, ETH_ALEN);
+	slot->iov.iov_len = len;
+	slot->launch_time = launch_time;
+
+	if (tx->txtime) {
+		struct msghdr *msg = &tx->msgs[tx->count].msg_hdr;
+		struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg);
+
+		memcpy(CMSG_DATA(cmsg), &launch_time, sizeof(launch_time));
+	}
+
+	tx->reserved = false;
+	tx->count++;
+	return 0;
+}
+
+int avtp_net_tx_queue(struct avtp_net_tx *tx, const uint8_t macaddr[6],
+				const void *pdu, size_t len,
+				uint64_t launch_time)
+{
+	void *buf;
+	int res;
+
+	if (!pdu || !macaddr || (tx && len > tx->max_pdu_size))
+		return -EINVAL;
+
+	res = avtp_net_tx_reserve(tx, &buf);
+	if (res < 0)
+		return res;
+
+	memcpy(buf, pdu, len);
+
+	return avtp_net_tx_commit(tx, macaddr, len, launch_time);
+}
+
+/* Keep launch times of the next 'count' PDUs transmitted, indexed as the
+ * kernel keys their reports.
+ */
+static void record_launch_times(struct avtp_net_tx *tx, unsigned int count)
+{
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		struct tx_slot *slot = &tx->slots[tx->head + i];
+
+		tx->launch_times[tx->next_id & tx->history_mask] =
+							slot->launch_time;
+		tx->next_id++;
+	}
+}
+
+int avtp_net_tx_flush(struct avtp_net_tx *tx)
+{
+	unsigned int sent = 0;
+
+	if (!tx)
+		return -EINVAL;
+
+	if (tx->xdp)
+		return avtp_net_xdp_flush(tx->xdp);
+
+	while (tx->head < tx->count) {
+		int n;
+
+		n = sendmmsg(tx->fd, &tx->msgs[tx->head], tx->count - tx->head,
+									0);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			if (sent == 0)
+				return -errno;
+			break;
+		}
+
+		if (tx->launch_times)
+			record_launch_times(tx, n);
+
+		tx->head += n;
+		sent += n;
+	}
+
+	/* Reuse the queue from the start only once all PDUs are transmitted,
+	 * so pending ones keep their order, and no buffer is reserved, so the
+	 * reserved buffer still belongs to the slot it is committed to.
+	 */
+	if (tx->head == tx->count && !tx->reserved) {
+		tx->head = 0;
+		tx->count = 0;
+	}
+
+	return sent;
+}
+
+unsigned int avtp_net_tx_max_pdu_size(const struct avtp_net_tx *tx)
+{
+	return tx->max_pdu_size;
+}
+
+int avtp_net_tx_get_pending(const struct avtp_net_tx *tx)
+{
+	if (!tx)
+		return -EINVAL;
+
+	if (tx->xdp)
+		return avtp_net_xdp_get_pending(tx->xdp);
+
+	return tx->count - tx->head;
+}
+
+/* Fill a report from the control messages of an error queue message.
+ *
+ * Returns:
+ *    true: If the message is a timestamp report.
+ *    false: Otherwise.
+ */
+static bool parse_report(const struct avtp_net_tx *tx, struct msghdr *msg,
+					struct avtp_net_tx_report *report)
+{
+	const struct scm_timestamping *tss = NULL;
+	const struct sock_extended_err *serr = NULL;
+	const struct timespec *ts;
+	struct cmsghdr *cmsg;
+	uint32_t age;
+
+	for (cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+				cmsg->cmsg_type == SCM_TIMESTAMPING)
+			tss = (const struct scm_timestamping *)
+							CMSG_DATA(cmsg);
+		else if (cmsg->cmsg_level == SOL_PACKET &&
+				cmsg->cmsg_type == PACKET_TX_TIMESTAMP)
+			serr = (const struct sock_extended_err *)
+							CMSG_DATA(cmsg);
+	}
+
+	if (!tss || !serr || serr->ee_errno != ENOMSG ||
+			serr->ee_origin != SO_EE_ORIGIN_TIMESTAMPING)
+		return false;
+
+	/* Software timestamps come first, raw hardware ones last. */
+	ts = tx->tstamp == AVTP_NET_TSTAMP_HARDWARE ? &tss->ts[2] :
+								&tss->ts[0];
+
+	report->id = serr->ee_data;
+	report->tx_time = ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+
+	age = tx->next_id - report->id;
+	if (age == 0 || age > tx->history_mask + 1)
+		report->launch_time = 0;
+	else
+		report->launch_time = tx->launch_times[report->id &
+							tx->history_mask];
+
+	return true;
+}
+
+int avtp_net_tx_get_reports(struct avtp_net_tx *tx,
+				struct avtp_net_tx_report reports[],
+				unsigned int max)
+{
+	unsigned int count = 0;
+
+	if (!tx || !reports)
+		return -EINVAL;
+
+	if (!tx->launch_times)
+		return -EOPNOTSUPP;
+
+	while (count < max) {
+		unsigned int batch = max - count;
+		unsigned int i;
+		int n;
+
+		if (batch > AVTP_NET_TX_REPORT_BATCH)
+			batch = AVTP_NET_TX_REPORT_BATCH;
+
+		for (i = 0; i < batch; i++) {
+			struct msghdr *msg = &tx->err_msgs[i].msg_hdr;
+
+			msg->msg_controllen = sizeof(tx->err_control[i].buf);
+		}
+
+		n = recvmmsg(tx->fd, tx->err_msgs, batch,
+					MSG_ERRQUEUE | MSG_DONTWAIT, NULL);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || count > 0)
+				break;
+			return -errno;
+		}
+
+		/* Other errors queued (e.g. by the ETF qdisc) are skipped. */
+		for (i = 0; i < (unsigned int) n; i++) {
+			struct msghdr *msg = &tx->err_msgs[i].msg_hdr;
+
+			if (parse_report(tx, msg, &reports[count]))
+				count++;
+		}
+
+		if ((unsigned int) n < batch)
+			break;
+	}
+
+	return count;
+}
@@ -0,0 +1,833 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* Required by syscall(). */
+#define _GNU_SOURCE
+
+#include <arpa/inet.h>
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <linux/if_xdp.h>
+#include <net/if.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_net.h"
+#include "avtp_net_xdp.h"
+
+#ifndef AF_XDP
+#define AF_XDP				44
+#endif
+
+#ifndef SOL_XDP
+#define SOL_XDP				283
+#endif
+
+#define DEFAULT_FRAME_SIZE		2048
+#define DEFAULT_FRAME_COUNT		4096
+#define DEFAULT_QUEUE_SIZE		64
+#define DEFAULT_MAX_PDU_SIZE		1500
+
+/* Smallest UMEM frame size supported by the kernel. */
+#define MIN_FRAME_SIZE			2048
+
+/* Number of entries of the XSKMAP which the XDP program redirects frames
+ * through. The map is indexed by device queue.
+ */
+#define MAX_QUEUES			64
+
+#define VLAN_HLEN			4
+
+/* Build an eBPF instruction. Jumps are given the index of the jumping
+ * instruction and of its target so offsets are computed here.
+ */
+#define INSN(c, dst, src, o, i)						\
+	((struct bpf_insn) {						\
+		.code = (c), .dst_reg = (dst), .src_reg = (src),	\
+		.off = (o), .imm = (i),					\
+	})
+#define JUMP(op, dst, src, i, from, to)					\
+	INSN(BPF_JMP | (op), dst, src, (to) - (from) - 1, i)
+
+struct ring {
+	uint32_t *producer;
+	uint32_t *consumer;
+	uint32_t *flags;
+	void *descs;
+	uint32_t size;
+	void *map;
+	size_t map_size;
+};
+
+/* XDP programs attached by RX rings. A single program is attached to each
+ * interface, and shared by the rings bound to its queues.
+ */
+struct xdp_prog {
+	struct xdp_prog *next;
+	int ifindex;
+	uint16_t protocol;
+	int map_fd;
+	int link_fd;
+	unsigned int refs;
+};
+
+struct avtp_net_xdp {
+	int fd;
+	bool zerocopy;
+	uint8_t *umem;
+	size_t umem_size;
+	unsigned int frame_size;
+	unsigned int frame_count;
+	struct ring fill;
+	struct ring comp;
+	struct ring rx;
+	struct ring tx;
+
+	/* RX only. Frames holding the PDUs returned by the last call to
+	 * avtp_net_xdp_recv() are given back to the fill ring on the next
+	 * call.
+	 */
+	struct xdp_prog *prog;
+	uint32_t queue_id;
+	uint64_t *held;
+	unsigned int held_count;
+
+	/* TX only. Queued PDUs live in the first 'queue_size' frames, one
+	 * per frame, right after the Ethernet header copied from 'hdr'.
+	 */
+	uint8_t hdr[ETH_HLEN + VLAN_HLEN];
+	unsigned int hdr_len;
+	unsigned int max_pdu_size;
+	unsigned int queue_size;
+	uint32_t *lens;
+	/* Number of committed PDUs, of PDUs pushed to the TX ring and of PDUs
+	 * whose transmission is completed.
+	 */
+	unsigned int count;
+	unsigned int submitted;
+	unsigned int completed;
+	bool reserved;
+};
+
+static struct xdp_prog *progs;
+static pthread_mutex_t progs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool is_power_of_2(unsigned int val)
+{
+	return val && !(val & (val - 1));
+}
+
+static int sys_bpf(int cmd, union bpf_attr *attr)
+{
+	int res;
+
+	res = syscall(__NR_bpf, cmd, attr, sizeof(*attr));
+	if (res < 0)
+		return -errno;
+
+	return res;
+}
+
+/* Load the XDP program which redirects frames of 'protocol', untagged or
+ * with a single VLAN tag, to the socket bound to the queue they are received
+ * on. Other frames, or frames received on queues without socket, go on to
+ * the network stack.
+ */
+static int load_prog(int map_fd, uint16_t protocol)
+{
+	const int32_t proto = htons(protocol);
+	const int32_t vlan = htons(ETH_P_8021Q);
+	/* Indexes of jump targets. */
+	enum { REDIRECT = 14, PASS = 20 };
+	const struct bpf_insn insns[] = {
+		/* r6 = ctx, r2 = data, r3 = data_end. */
+		INSN(BPF_ALU64 | BPF_MOV | BPF_X, 6, 1, 0, 0),
+		INSN(BPF_LDX | BPF_MEM | BPF_W, 2, 6,
+					offsetof(struct xdp_md, data), 0),
+		INSN(BPF_LDX | BPF_MEM | BPF_W, 3, 6,
+					offsetof(struct xdp_md, data_end), 0),
+		/* Untagged frame of 'protocol'? */
+		INSN(BPF_ALU64 | BPF_MOV | BPF_X, 4, 2, 0, 0),
+		INSN(BPF_ALU64 | BPF_ADD | BPF_K, 4, 0, 0, ETH_HLEN),
+		JUMP(BPF_JGT | BPF_X, 4, 3, 0, 5, PASS),
+		INSN(BPF_LDX | BPF_MEM | BPF_H, 5, 2, ETH_HLEN - 2, 0),
+		JUMP(BPF_JEQ | BPF_K, 5, 0, proto, 7, REDIRECT),
+		/* Tagged frame of 'protocol'? */
+		JUMP(BPF_JNE | BPF_K, 5, 0, vlan, 8, PASS),
+		INSN(BPF_ALU64 | BPF_MOV | BPF_X, 4, 2, 0, 0),
+		INSN(BPF_ALU64 | BPF_ADD | BPF_K, 4, 0, 0,
+						ETH_HLEN + VLAN_HLEN),
+		JUMP(BPF_JGT | BPF_X, 4, 3, 0, 11, PASS),
+		INSN(BPF_LDX | BPF_MEM | BPF_H, 5, 2, ETH_HLEN + 2, 0),
+		JUMP(BPF_JNE | BPF_K, 5, 0, proto, 13, PASS),
+		/* REDIRECT: bpf_redirect_map(map, rx_queue_index, XDP_PASS). */
+		INSN(BPF_LDX | BPF_MEM | BPF_W, 2, 6,
+				offsetof(struct xdp_md, rx_queue_index), 0),
+		INSN(BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0,
+								map_fd),
+		INSN(0, 0, 0, 0, 0),
+		INSN(BPF_ALU64 | BPF_MOV | BPF_K, 3, 0, 0, XDP_PASS),
+		INSN(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map),
+		INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+		/* PASS. */
+		INSN(BPF_ALU64 | BPF_MOV | BPF_K, 0, 0, 0, XDP_PASS),
+		INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+	};
+	union bpf_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.prog_type = BPF_PROG_TYPE_XDP;
+	attr.insns = (uintptr_t) insns;
+	attr.insn_cnt = sizeof(insns) / sizeof(insns[0]);
+	attr.license = (uintptr_t) "BSD";
+
+	return sys_bpf(BPF_PROG_LOAD, &attr);
+}
+
+static int attach_prog(struct xdp_prog *prog)
+{
+	union bpf_attr attr;
+	int prog_fd, res;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.map_type = BPF_MAP_TYPE_XSKMAP;
+	attr.key_size = sizeof(uint32_t);
+	attr.value_size = sizeof(int);
+	attr.max_entries = MAX_QUEUES;
+
+	res = sys_bpf(BPF_MAP_CREATE, &attr);
+	if (res < 0)
+		return res;
+
+	prog->map_fd = res;
+
+	prog_fd = load_prog(prog->map_fd, prog->protocol);
+	if (prog_fd < 0) {
+		res = prog_fd;
+		goto err;
+	}
+
+	/* Without mode flags, the kernel picks the driver mode if the
+	 * driver supports XDP and the generic mode otherwise.
+	 */
+	memset(&attr, 0, sizeof(attr));
+	attr.link_create.prog_fd = prog_fd;
+	attr.link_create.target_ifindex = prog->ifindex;
+	attr.link_create.attach_type = BPF_XDP;
+
+	res = sys_bpf(BPF_LINK_CREATE, &attr);
+
+	/* The link holds its own reference to the program, which is
+	 * detached once the link is closed.
+	 */
+	close(prog_fd);
+	if (res < 0)
+		goto err;
+
+	prog->link_fd = res;
+	return 0;
+
+err:
+	close(prog->map_fd);
+	return res;
+}
+
+static void detach_prog(struct xdp_prog *prog)
+{
+	struct xdp_prog **p;
+
+	for (p = &progs; *p != prog; p = &(*p)->next)
+		;
+	*p = prog->next;
+
+	close(prog->link_fd);
+	close(prog->map_fd);
+	free(prog);
+}
+
+/* Get the program attached to the interface, attaching it if needed, and
+ * make it redirect frames received on 'queue_id' to socket 'fd'.
+ */
+static int get_prog(struct xdp_prog **prog, int ifindex, uint16_t protocol,
+						uint32_t queue_id, int fd)
+{
+	union bpf_attr attr;
+	struct xdp_prog *p;
+	int res;
+
+	pthread_mutex_lock(&progs_lock);
+
+	for (p = progs; p; p = p->next)
+		if (p->ifindex == ifindex)
+			break;
+
+	if (p && p->protocol != protocol) {
+		res = -EBUSY;
+		goto out;
+	}
+
+	if (!p) {
+		p = calloc(1, sizeof(*p));
+		if (!p) {
+			res = -ENOMEM;
+			goto out;
+		}
+
+		p->ifindex = ifindex;
+		p->protocol = protocol;
+
+		res = attach_prog(p);
+		if (res < 0) {
+			free(p);
+			goto out;
+		}
+
+		p->next = progs;
+		progs = p;
+	}
+
+	memset(&attr, 0, sizeof(attr));
+	attr.map_fd = p->map_fd;
+	attr.key = (uintptr_t) &queue_id;
+	attr.value = (uintptr_t) &fd;
+	attr.flags = BPF_NOEXIST;
+
+	res = sys_bpf(BPF_MAP_UPDATE_ELEM, &attr);
+	if (res < 0) {
+		if (!p->refs)
+			detach_prog(p);
+		goto out;
+	}
+
+	p->refs++;
+	*prog = p;
+	res = 0;
+
+out:
+	pthread_mutex_unlock(&progs_lock);
+	return res;
+}
+
+static void put_prog(struct xdp_prog *prog, uint32_t queue_id)
+{
+	union bpf_attr attr;
+
+	pthread_mutex_lock(&progs_lock);
+
+	memset(&attr, 0, sizeof(attr));
+	attr.map_fd = prog->map_fd;
+	attr.key = (uintptr_t) &queue_id;
+	sys_bpf(BPF_MAP_DELETE_ELEM, &attr);
+
+	if (--prog->refs == 0)
+		detach_prog(prog);
+
+	pthread_mutex_unlock(&progs_lock);
+}
+
+static int map_ring(int fd, struct ring *ring, uint32_t size,
+				const struct xdp_ring_offset *off, off_t pgoff,
+				size_t desc_size)
+{
+	uint8_t *map;
+
+	ring->map_size = off->desc + size * desc_size;
+	ring->map = mmap(NULL, ring->map_size, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, fd, pgoff);
+	if (ring->map == MAP_FAILED) {
+		ring->map = NULL;
+		return -errno;
+	}
+
+	map = ring->map;
+	ring->producer = (uint32_t *) (map + off->producer);
+	ring->consumer = (uint32_t *) (map + off->consumer);
+	ring->flags = (uint32_t *) (map + off->flags);
+	ring->descs = map + off->desc;
+	ring->size = size;
+	return 0;
+}
+
+static void unmap_ring(struct ring *ring)
+{
+	if (ring->map)
+		munmap(ring->map, ring->map_size);
+}
+
+/* Whether the kernel must be kicked to process 'ring'. In copy mode, TX
+ * rings are only processed when the socket is kicked.
+ */
+static bool needs_wakeup(const struct avtp_net_xdp *xdp,
+						const struct ring *ring)
+{
+	if (ring == &xdp->tx && !xdp->zerocopy)
+		return true;
+
+	return __atomic_load_n(ring->flags, __ATOMIC_RELAXED) &
+							XDP_RING_NEED_WAKEUP;
+}
+
+/* Allocate the UMEM, register it and set up the socket rings, with as many
+ * entries as UMEM frames, then bind the socket to its device queue.
+ */
+static int setup_socket(struct avtp_net_xdp *xdp, int ifindex,
+						uint32_t queue_id, bool rx)
+{
+	struct xdp_umem_reg reg = { 0 };
+	struct sockaddr_xdp addr = { 0 };
+	struct xdp_mmap_offsets off;
+	struct xdp_options opts;
+	socklen_t len;
+	int size = xdp->frame_count;
+	int res;
+
+	xdp->umem_size = (size_t) xdp->frame_count * xdp->frame_size;
+	xdp->umem = mmap(NULL, xdp->umem_size, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE,
+				-1, 0);
+	if (xdp->umem == MAP_FAILED) {
+		xdp->umem = NULL;
+		return -errno;
+	}
+
+	xdp->fd = socket(AF_XDP, SOCK_RAW, 0);
+	if (xdp->fd < 0)
+		return -errno;
+
+	reg.addr = (uintptr_t) xdp->umem;
+	reg.len = xdp->umem_size;
+	reg.chunk_size = xdp->frame_size;
+
+	len = sizeof(off);
+	if (setsockopt(xdp->fd, SOL_XDP, XDP_UMEM_REG, &reg,
+							sizeof(reg)) < 0 ||
+		setsockopt(xdp->fd, SOL_XDP, XDP_UMEM_FILL_RING, &size,
+							sizeof(size)) < 0 ||
+		setsockopt(xdp->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &size,
+							sizeof(size)) < 0 ||
+		setsockopt(xdp->fd, SOL_XDP, rx ? XDP_RX_RING : XDP_TX_RING,
+						&size, sizeof(size)) < 0 ||
+		getsockopt(xdp->fd, SOL_XDP, XDP_MMAP_OFFSETS, &off,
+								&len) < 0)
+		return -errno;
+
+	res = map_ring(xdp->fd, &xdp->fill, size, &off.fr,
+				XDP_UMEM_PGOFF_FILL_RING, sizeof(uint64_t));
+	if (res < 0)
+		return res;
+
+	res = map_ring(xdp->fd, &xdp->comp, size, &off.cr,
+			XDP_UMEM_PGOFF_COMPLETION_RING, sizeof(uint64_t));
+	if (res < 0)
+		return res;
+
+	if (rx)
+		res = map_ring(xdp->fd, &xdp->rx, size, &off.rx,
+				XDP_PGOFF_RX_RING, sizeof(struct xdp_desc));
+	else
+		res = map_ring(xdp->fd, &xdp->tx, size, &off.tx,
+				XDP_PGOFF_TX_RING, sizeof(struct xdp_desc));
+	if (res < 0)
+		return res;
+
+	addr.sxdp_family = AF_XDP;
+	addr.sxdp_ifindex = ifindex;
+	addr.sxdp_queue_id = queue_id;
+	addr.sxdp_flags = XDP_USE_NEED_WAKEUP;
+
+	res = bind(xdp->fd, (struct sockaddr *) &addr, sizeof(addr));
+	if (res < 0)
+		return -errno;
+
+	len = sizeof(opts);
+	res = getsockopt(xdp->fd, SOL_XDP, XDP_OPTIONS, &opts, &len);
+	if (res < 0)
+		return -errno;
+
+	xdp->zerocopy = opts.flags & XDP_OPTIONS_ZEROCOPY;
+	return 0;
+}
+
+static struct avtp_net_xdp *alloc_xdp(void)
+{
+	struct avtp_net_xdp *xdp;
+
+	xdp = calloc(1, sizeof(*xdp));
+	if (xdp)
+		xdp->fd = -1;
+
+	return xdp;
+}
+
+int avtp_net_xdp_rx_create(struct avtp_net_xdp **xdp,
+				const struct avtp_net_rx_config *cfg,
+				int ifindex)
+{
+	struct avtp_net_xdp *x;
+	long page_size;
+	uint64_t *fill;
+	unsigned int i;
+	int res;
+
+	x = alloc_xdp();
+	if (!x)
+		return -ENOMEM;
+
+	x->frame_size = cfg->frame_size ?: DEFAULT_FRAME_SIZE;
+	x->frame_count = cfg->frame_count ?: DEFAULT_FRAME_COUNT;
+	x->queue_id = cfg->queue_id;
+
+	page_size = sysconf(_SC_PAGESIZE);
+	if (page_size <= 0 || !is_power_of_2(x->frame_size) ||
+				x->frame_size < MIN_FRAME_SIZE ||
+				x->frame_size > page_size ||
+				!is_power_of_2(x->frame_count) ||
+				x->queue_id >= MAX_QUEUES) {
+		res = -EINVAL;
+		goto err;
+	}
+
+	x->held = calloc(x->frame_count, sizeof(x->held[0]));
+	if (!x->held) {
+		res = -ENOMEM;
+		goto err;
+	}
+
+	res = setup_socket(x, ifindex, x->queue_id, true);
+	if (res < 0)
+		goto err;
+
+	/* All frames are handed over to the kernel upfront. */
+	fill = x->fill.descs;
+	for (i = 0; i < x->frame_count; i++)
+		fill[i] = (uint64_t) i * x->frame_size;
+	__atomic_store_n(x->fill.producer, x->frame_count, __ATOMIC_RELEASE);
+
+	res = get_prog(&x->prog, ifindex, cfg->protocol, x->queue_id, x->fd);
+	if (res < 0)
+		goto err;
+
+	*xdp = x;
+	return 0;
+
+err:
+	avtp_net_xdp_destroy(x);
+	return res;
+}
+
+static int init_eth_hdr(struct avtp_net_xdp *xdp,
+				const struct avtp_net_tx_config *cfg)
+{
+	struct ifreq ifr = { 0 };
+	uint16_t val;
+	uint8_t *p;
+	int fd, res;
+
+	/* Ioctls on interfaces aren't supported by AF_XDP sockets. */
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0)
+		return -errno;
+
+	strncpy(ifr.ifr_name, cfg->ifname, sizeof(ifr.ifr_name) - 1);
+	res = ioctl(fd, SIOCGIFHWADDR, &ifr);
+	close(fd);
+	if (res < 0)
+		return -errno;
+
+	/* Destination address is filled in when each PDU is committed. */
+	p = xdp->hdr + ETH_ALEN;
+	memcpy(p, ifr.ifr_hwaddr.sa_data, ETH_ALEN);
+	p += ETH_ALEN;
+
+	if (cfg->vlan) {
+		val = htons(ETH_P_8021Q);
+		memcpy(p, &val, sizeof(val));
+		val = htons(cfg->vlan_tci);
+		memcpy(p + 2, &val, sizeof(val));
+		p += VLAN_HLEN;
+	}
+
+	val = htons(cfg->protocol);
+	memcpy(p, &val, sizeof(val));
+
+	xdp->hdr_len = p + sizeof(val) - xdp->hdr;
+	return 0;
+}
+
+int avtp_net_xdp_tx_create(struct avtp_net_xdp **xdp,
+				const struct avtp_net_tx_config *cfg,
+				int ifindex)
+{
+	struct avtp_net_xdp *x;
+	int res;
+
+	if (cfg->txtime || cfg->priority)
+		return -EOPNOTSUPP;
+
+	x = alloc_xdp();
+	if (!x)
+		return -ENOMEM;
+
+	x->queue_size = cfg->queue_size ?: DEFAULT_QUEUE_SIZE;
+	x->max_pdu_size = cfg->max_pdu_size ?: DEFAULT_MAX_PDU_SIZE;
+	x->frame_size = DEFAULT_FRAME_SIZE;
+
+	/* Each queued PDU owns a frame, and rings need a power of two
+	 * number of entries.
+	 */
+	x->frame_count = 1;
+	while (x->frame_count < x->queue_size)
+		x->frame_count <<= 1;
+
+	res = init_eth_hdr(x, cfg);
+	if (res < 0)
+		goto err;
+
+	if (x->max_pdu_size > x->frame_size - x->hdr_len ||
+						x->queue_size > (1U << 31)) {
+		res = -EINVAL;
+		goto err;
+	}
+
+	x->lens = calloc(x->queue_size, sizeof(x->lens[0]));
+	if (!x->lens) {
+		res = -ENOMEM;
+		goto err;
+	}
+
+	res = setup_socket(x, ifindex, cfg->queue_id, false);
+	if (res < 0)
+		goto err;
+
+	*xdp = x;
+	return 0;
+
+err:
+	avtp_net_xdp_destroy(x);
+	return res;
+}
+
+void avtp_net_xdp_destroy(struct avtp_net_xdp *xdp)
+{
+	/* Frames must not be redirected to the socket once it is closed. */
+	if (xdp->prog)
+		put_prog(xdp->prog, xdp->queue_id);
+
+	unmap_ring(&xdp->tx);
+	unmap_ring(&xdp->rx);
+	unmap_ring(&xdp->comp);
+	unmap_ring(&xdp->fill);
+
+	if (xdp->fd >= 0)
+		close(xdp->fd);
+
+	if (xdp->umem)
+		munmap(xdp->umem, xdp->umem_size);
+
+	free(xdp->lens);
+	free(xdp->held);
+	free(xdp);
+}
+
+int avtp_net_xdp_get_fd(const struct avtp_net_xdp *xdp)
+{
+	return xdp->fd;
+}
+
+/* Get the length of the Ethernet header of a received frame, VLAN tag
+ * included, or 0 if the frame is too short to hold it.
+ */
+static unsigned int eth_hdr_len(const uint8_t *frame, uint32_t len)
+{
+	uint16_t type;
+
+	if (len < ETH_HLEN)
+		return 0;
+
+	memcpy(&type, frame + ETH_HLEN - 2, sizeof(type));
+	if (type != htons(ETH_P_8021Q))
+		return ETH_HLEN;
+
+	return len < ETH_HLEN + VLAN_HLEN ? 0 : ETH_HLEN + VLAN_HLEN;
+}
+
+int avtp_net_xdp_recv(struct avtp_net_xdp *xdp,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], unsigned int max)
+{
+	const struct xdp_desc *descs = xdp->rx.descs;
+	uint32_t mask = xdp->rx.size - 1;
+	uint32_t cons, avail, i;
+	unsigned int n = 0;
+
+	/* PDUs returned by the previous call live in held frames, so they are
+	 * only given back to the kernel now. The fill ring has an entry for
+	 * each UMEM frame so there is always room for them.
+	 */
+	if (xdp->held_count) {
+		uint64_t *fill = xdp->fill.descs;
+		uint32_t prod = *xdp->fill.producer;
+
+		for (i = 0; i < xdp->held_count; i++)
+			fill[(prod + i) & (xdp->fill.size - 1)] = xdp->held[i];
+
+		__atomic_store_n(xdp->fill.producer, prod + xdp->held_count,
+							__ATOMIC_RELEASE);
+		xdp->held_count = 0;
+	}
+
+	if (needs_wakeup(xdp, &xdp->fill))
+		recvfrom(xdp->fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+
+	cons = *xdp->rx.consumer;
+	avail = __atomic_load_n(xdp->rx.producer, __ATOMIC_ACQUIRE) - cons;
+	if (avail > max)
+		avail = max;
+
+	for (i = 0; i < avail; i++) {
+		const struct xdp_desc *desc = &descs[(cons + i) & mask];
+		const uint8_t *frame = xdp->umem + desc->addr;
+		unsigned int hdr_len = eth_hdr_len(frame, desc->len);
+
+		xdp->held[xdp->held_count++] = desc->addr &
+					~((uint64_t) xdp->frame_size - 1);
+
+		/* Runt frames are dropped, their frame is recycled. */
+		if (!hdr_len)
+			continue;
+
+		pdus[n] = (const struct avtp_stream_pdu *) (frame + hdr_len);
+		lens[n] = desc->len - hdr_len;
+		n++;
+	}
+
+	__atomic_store_n(xdp->rx.consumer, cons + avail, __ATOMIC_RELEASE);
+	return n;
+}
+
+/* Reap completed transmissions, and reuse the queue from the start once
+ * every queued PDU is completed and no buffer is reserved.
+ */
+static unsigned int reap_completions(struct avtp_net_xdp *xdp)
+{
+	uint32_t cons = *xdp->comp.consumer;
+	uint32_t n;
+
+	n = __atomic_load_n(xdp->comp.producer, __ATOMIC_ACQUIRE) - cons;
+	if (n)
+		__atomic_store_n(xdp->comp.consumer, cons + n,
+							__ATOMIC_RELEASE);
+
+	xdp->completed += n;
+
+	if (xdp->completed == xdp->count && !xdp->reserved) {
+		xdp->count = 0;
+		xdp->submitted = 0;
+		xdp->completed = 0;
+	}
+
+	return n;
+}
+
+int avtp_net_xdp_reserve(struct avtp_net_xdp *xdp, void **buf)
+{
+	if (xdp->count == xdp->queue_size && !xdp->reserved)
+		reap_completions(xdp);
+
+	if (xdp->count == xdp->queue_size)
+		return -ENOSPC;
+
+	xdp->reserved = true;
+	*buf = xdp->umem + (size_t) xdp->count * xdp->frame_size +
+								xdp->hdr_len;
+	return 0;
+}
+
+int avtp_net_xdp_commit(struct avtp_net_xdp *xdp, const uint8_t macaddr[6],
+								size_t len)
+{
+	uint8_t *frame;
+
+	if (!xdp->reserved || len > xdp->max_pdu_size)
+		return -EINVAL;
+
+	frame = xdp->umem + (size_t) xdp->count * xdp->frame_size;
+	memcpy(frame, xdp->hdr, xdp->hdr_len);
+	memcpy(frame, macaddr, ETH_ALEN);
+
+	xdp->lens[xdp->count] = xdp->hdr_len + len;
+	xdp->reserved = false;
+	xdp->count++;
+	return 0;
+}
+
+int avtp_net_xdp_flush(struct avtp_net_xdp *xdp)
+{
+	struct xdp_desc *descs = xdp->tx.descs;
+	uint32_t mask = xdp->tx.size - 1;
+	uint32_t prod = *xdp->tx.producer;
+	unsigned int i;
+
+	/* The TX ring has an entry for each queued PDU so every committed PDU
+	 * fits in it.
+	 */
+	for (i = xdp->submitted; i < xdp->count; i++) {
+		struct xdp_desc *desc = &descs[prod++ & mask];
+
+		desc->addr = (uint64_t) i * xdp->frame_size;
+		desc->len = xdp->lens[i];
+		desc->options = 0;
+	}
+
+	__atomic_store_n(xdp->tx.producer, prod, __ATOMIC_RELEASE);
+	xdp->submitted = xdp->count;
+
+	if (xdp->completed < xdp->submitted && needs_wakeup(xdp, &xdp->tx)) {
+		int res;
+
+		res = sendto(xdp->fd, NULL, 0, MSG_DONTWAIT, NULL, 0);
+		if (res < 0 && errno != EAGAIN && errno != EBUSY &&
+							errno != ENOBUFS)
+			return -errno;
+	}
+
+	return reap_completions(xdp);
+}
+
+int avtp_net_xdp_get_pending(const struct avtp_net_xdp *xdp)
+{
+	return xdp->count - xdp->completed;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "avtp.h"
+#include "avtp_net.h"
+
+#pragma GCC visibility push(hidden)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* AF_XDP socket with its UMEM, backing RX rings and TX queues created with
+ * AVTP_NET_BACKEND_XDP. Functions below implement the avtp_net_rx_*() and
+ * avtp_net_tx_*() functions of the same name, and have the same semantics,
+ * with PDUs laid out in UMEM frames right after their Ethernet header.
+ */
+struct avtp_net_xdp;
+
+int avtp_net_xdp_rx_create(struct avtp_net_xdp **xdp,
+				const struct avtp_net_rx_config *cfg,
+				int ifindex);
+
+int avtp_net_xdp_tx_create(struct avtp_net_xdp **xdp,
+				const struct avtp_net_tx_config *cfg,
+				int ifindex);
+
+void avtp_net_xdp_destroy(struct avtp_net_xdp *xdp);
+
+int avtp_net_xdp_get_fd(const struct avtp_net_xdp *xdp);
+
+int avtp_net_xdp_recv(struct avtp_net_xdp *xdp,
+				const struct avtp_stream_pdu *pdus[],
+				size_t lens[], unsigned int max);
+
+int avtp_net_xdp_reserve(struct avtp_net_xdp *xdp, void **buf);
+
+int avtp_net_xdp_commit(struct avtp_net_xdp *xdp, const uint8_t macaddr[6],
+								size_t len);
+
+int avtp_net_xdp_flush(struct avtp_net_xdp *xdp);
+
+int avtp_net_xdp_get_pending(const struct avtp_net_xdp *xdp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <errno.h>
+#include <stddef.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_ieciidc.h"
+#include "avtp_inline.h"
+#include "avtp_pdu_view.h"
+#include "avtp_rvf.h"
+#include "avtp_tscf.h"
+
+/* Length of the format specific header living at the beginning of the
+ * AVTPDU payload of Stream AVTPDUs, if any.
+ */
+static size_t payload_hdr_len(const struct avtp_stream_pdu *pdu,
+							uint8_t subtype)
+{
+	switch (subtype) {
+	case AVTP_SUBTYPE_CVF:
+		if (avtp_cvf_get_format_subtype(pdu) !=
+						AVTP_CVF_FORMAT_SUBTYPE_H264)
+			return 0;
+		return sizeof(struct avtp_cvf_h264_payload);
+	case AVTP_SUBTYPE_RVF:
+		return sizeof(struct avtp_rvf_payload);
+	case AVTP_SUBTYPE_61883_IIDC:
+		if (avtp_ieciidc_get_tag(pdu) != AVTP_IECIIDC_TAG_CIP)
+			return 0;
+		return sizeof(struct avtp_ieciidc_cip_payload);
+	default:
+		return 0;
+	}
+}
+
+int avtp_pdu_view_init(struct avtp_pdu_view *view, const void *buf,
+						size_t len, uint8_t subtype)
+{
+	size_t hdr_len, data_len, sub_len = 0;
+
+	if (!view || !buf)
+		return -EINVAL;
+
+	switch (subtype) {
+	case AVTP_SUBTYPE_AAF:
+	case AVTP_SUBTYPE_CVF:
+	case AVTP_SUBTYPE_RVF:
+	case AVTP_SUBTYPE_61883_IIDC:
+	case AVTP_SUBTYPE_TSCF:
+		hdr_len = sizeof(struct avtp_stream_pdu);
+		break;
+	case AVTP_SUBTYPE_CRF:
+		hdr_len = sizeof(struct avtp_crf_pdu);
+		break;
+	case AVTP_SUBTYPE_NTSCF:
+		hdr_len = sizeof(struct avtp_ntscf_pdu);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (len < hdr_len || avtp_common_get_subtype(buf) != subtype)
+		return -EINVAL;
+
+	switch (subtype) {
+	case AVTP_SUBTYPE_CRF:
+		data_len = avtp_crf_get_crf_data_len(buf);
+		break;
+	case AVTP_SUBTYPE_NTSCF:
+		data_len = avtp_ntscf_get_data_len(buf);
+		break;
+	default:
+		data_len = avtp_stream_get_stream_data_len(buf);
+		sub_len = payload_hdr_len(buf, subtype);
+		break;
+	}
+
+	if (data_len > len - hdr_len || data_len < sub_len)
+		return -EINVAL;
+
+	view->buf = buf;
+	view->len = len;
+	view->data_off = hdr_len + sub_len;
+	view->data_len = data_len - sub_len;
+	view->subtype = subtype;
+	view->decoded = 0;
+
+	return 0;
+}
+
+const struct avtp_cvf_hdr *avtp_pdu_view_cvf_hdr(struct avtp_pdu_view *view)
+{
+	if (!view || view->subtype != AVTP_SUBTYPE_CVF)
+		return NULL;
+
+	if (!view->decoded) {
+		avtp_cvf_pdu_unpack(avtp_pdu_view_stream(view),
+							&view->hdr.cvf);
+		view->decoded = 1;
+	}
+
+	return &view->hdr.cvf;
+}
+
+const struct avtp_rvf_hdr *avtp_pdu_view_rvf_hdr(struct avtp_pdu_view *view)
+{
+	if (!view || view->subtype != AVTP_SUBTYPE_RVF)
+		return NULL;
+
+	if (!view->decoded) {
+		avtp_rvf_pdu_unpack(avtp_pdu_view_stream(view),
+							&view->hdr.rvf);
+		view->decoded = 1;
+	}
+
+	return &view->hdr.rvf;
+}
+
+const struct avtp_ieciidc_hdr *avtp_pdu_view_ieciidc_hdr(
+						struct avtp_pdu_view *view)
+{
+	if (!view || view->subtype != AVTP_SUBTYPE_61883_IIDC)
+		return NULL;
+
+	if (!view->decoded) {
+		avtp_ieciidc_pdu_unpack(avtp_pdu_view_stream(view),
+							&view->hdr.ieciidc);
+		view->decoded = 1;
+	}
+
+	return &view->hdr.ieciidc;
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp_pool.h"
+
+#define CACHE_LINE_SIZE			64
+
+#define ALIGN_UP(x, a)			(((x) + (a) - 1) / (a) * (a))
+
+/* Single-producer/single-consumer ring of buffer indexes. Indexes grow
+ * freely and are masked on access, so 'head - tail' is always the number of
+ * entries in the ring. Each side keeps a cached copy of the index owned by
+ * the other side and only reloads it when the ring looks full or empty, so
+ * the shared cache lines are touched as little as possible.
+ */
+struct ring {
+	/* Producer side. */
+	_Alignas(CACHE_LINE_SIZE) atomic_uint head;
+	unsigned int cached_tail;
+
+	/* Consumer side. */
+	_Alignas(CACHE_LINE_SIZE) atomic_uint tail;
+	unsigned int cached_head;
+
+	_Alignas(CACHE_LINE_SIZE) uint32_t *entries;
+	unsigned int size;
+};
+
+struct avtp_pool {
+	/* Buffers submitted by the producer to the consumer. */
+	struct ring ready;
+	/* Buffers released by the consumer back to the producer. */
+	struct ring free;
+
+	uint8_t *slab;
+	size_t stride;
+	size_t pdu_size;
+	unsigned int count;
+	/* Length of the PDU in each buffer. Written by the producer before
+	 * the buffer is pushed to 'ready' so the consumer reads it after
+	 * popping the buffer.
+	 */
+	uint32_t *lens;
+};
+
+static int ring_init(struct ring *ring, unsigned int count)
+{
+	unsigned int size = 1;
+
+	/* Power of two sized so indexes can be masked. */
+	while (size < count)
+		size <<= 1;
+
+	ring->entries = calloc(size, sizeof(*ring->entries));
+	if (!ring->entries)
+		return -ENOMEM;
+
+	ring->size = size;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	ring->cached_head = 0;
+	ring->cached_tail = 0;
+	return 0;
+}
+
+static bool ring_push(struct ring *ring, uint32_t val)
+{
+	unsigned int head;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+	if (head - ring->cached_tail == ring->size) {
+		ring->cached_tail = atomic_load_explicit(&ring->tail,
+							memory_order_acquire);
+		if (head - ring->cached_tail == ring->size)
+			return false;
+	}
+
+	ring->entries[head & (ring->size - 1)] = val;
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+	return true;
+}
+
+/* Pop up to 'max' entries. Returns the number of entries popped. */
+static unsigned int ring_pop(struct ring *ring, uint32_t vals[],
+							unsigned int max)
+{
+	unsigned int tail, avail, i;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+	if (ring->cached_head - tail < max) {
+		ring->cached_head = atomic_load_explicit(&ring->head,
+							memory_order_acquire);
+	}
+
+	avail = ring->cached_head - tail;
+	if (avail > max)
+		avail = max;
+
+	for (i = 0; i < avail; i++)
+		vals[i] = ring->entries[(tail + i) & (ring->size - 1)];
+
+	if (avail) {
+		atomic_store_explicit(&ring->tail, tail + avail,
+							memory_order_release);
+	}
+
+	return avail;
+}
+
+/* Map a buffer address back to its index. Returns -1 if 'pdu' isn't the
+ * start of a buffer from 'pool'.
+ */
+static int buffer_index(const struct avtp_pool *pool, const void *pdu)
+{
+	const uint8_t *p = pdu;
+	size_t off;
+
+	if (p < pool->slab)
+		return -1;
+
+	off = p - pool->slab;
+	if (off % pool->stride || off / pool->stride >= pool->count)
+		return -1;
+
+	return off / pool->stride;
+}
+
+int avtp_pool_create(struct avtp_pool **pool, unsigned int count,
+							size_t pdu_size)
+{
+	struct avtp_pool *p;
+	unsigned int i;
+	int res;
+
+	if (!pool || count == 0 || pdu_size == 0 || pdu_size > UINT32_MAX)
+		return -EINVAL;
+
+	p = aligned_alloc(CACHE_LINE_SIZE, ALIGN_UP(sizeof(*p),
+							CACHE_LINE_SIZE));
+	if (!p)
+		return -ENOMEM;
+
+	memset(p, 0, sizeof(*p));
+
+	p->count = count;
+	p->pdu_size = pdu_size;
+	p->stride = ALIGN_UP(pdu_size, CACHE_LINE_SIZE);
+
+	if (p->stride > SIZE_MAX / count) {
+		res = -EINVAL;
+		goto err;
+	}
+
+	res = -ENOMEM;
+	p->slab = aligned_alloc(CACHE_LINE_SIZE, p->stride * count);
+	p->lens = calloc(count, sizeof(*p->lens));
+	if (!p->slab || !p->lens)
+		goto err;
+
+	if (ring_init(&p->ready, count) < 0 || ring_init(&p->free, count) < 0)
+		goto err;
+
+	/* All buffers start free. No other thread can be using the pool yet
+	 * so the producer side of the free ring may be used here.
+	 */
+	for (i = 0; i < count; i++)
+		ring_push(&p->free, i);
+
+	*pool = p;
+	return 0;
+
+err:
+	free(p->free.entries);
+	free(p->ready.entries);
+	free(p->lens);
+	free(p->slab);
+	free(p);
+	return res;
+}
+
+void avtp_pool_destroy(struct avtp_pool *pool)
+{
+	if (!pool)
+		return;
+
+	free(pool->free.entries);
+	free(pool->ready.entries);
+	free(pool->lens);
+	free(pool->slab);
+	free(pool);
+}
+
+int avtp_pool_alloc(struct avtp_pool *pool, void **pdu)
+{
+	uint32_t idx;
+
+	if (!pool || !pdu)
+		return -EINVAL;
+
+	if (!ring_pop(&pool->free, &idx, 1))
+		return -ENOBUFS;
+
+	*pdu = pool->slab + idx * pool->stride;
+	return 0;
+}
+
+int avtp_pool_submit(struct avtp_pool *pool, void *pdu, size_t len)
+{
+	int idx;
+
+	if (!pool || !pdu || len > pool->pdu_size)
+		return -EINVAL;
+
+	idx = buffer_index(pool, pdu);
+	if (idx < 0)
+		return -EINVAL;
+
+	pool->lens[idx] = len;
+
+	/* Can't fail since the ring holds as many entries as buffers. */
+	ring_push(&pool->ready, idx);
+	return 0;
+}
+
+int avtp_pool_receive(struct avtp_pool *pool, void **pdu, size_t *len)
+{
+	int res;
+
+	if (!pdu || !len)
+		return -EINVAL;
+
+	res = avtp_pool_receive_burst(pool, pdu, len, 1);
+	if (res < 0)
+		return res;
+
+	return res ? 0 : -EAGAIN;
+}
+
+int avtp_pool_receive_burst(struct avtp_pool *pool, void *pdus[],
+					size_t lens[], unsigned int max)
+{
+	uint32_t idx[32];
+	unsigned int n = 0;
+
+	if (!pool || !pdus || !lens)
+		return -EINVAL;
+
+	while (n < max) {
+		unsigned int i, chunk, popped;
+
+		chunk = max - n < 32 ? max - n : 32;
+
+		popped = ring_pop(&pool->ready, idx, chunk);
+		for (i = 0; i < popped; i++) {
+			pdus[n + i] = pool->slab + idx[i] * pool->stride;
+			lens[n + i] = pool->lens[idx[i]];
+		}
+
+		n += popped;
+		if (popped < chunk)
+			break;
+	}
+
+	return n;
+}
+
+int avtp_pool_release(struct avtp_pool *pool, void *pdu)
+{
+	int idx;
+
+	if (!pool || !pdu)
+		return -EINVAL;
+
+	idx = buffer_index(pool, pdu);
+	if (idx < 0)
+		return -EINVAL;
+
+	ring_push(&pool->free, idx);
+	return 0;
+}
@@ -32,17 +32,19 @@
 
 #include "avtp.h"
 #include "avtp_rvf.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "avtp_stream.h"
 #include "util.h"
 
-#define SHIFT_ACTIVE_PIXELS    (31 - 15)
-#define SHIFT_TOTAL_LINES      (31 - 31)
-#define SHIFT_AP	       (31 - 16)
-#define SHIFT_F		       (31 - 18)
-#define SHIFT_EF	       (31 - 19)
-#define SHIFT_EVT	       (31 - 23)
-#define SHIFT_PD	       (31 - 24)
-#define SHIFT_I		       (31 - 25)
+#define SHIFT_ACTIVE_PIXELS    AVTP_RVF_SHIFT_ACTIVE_PIXELS
+#define SHIFT_TOTAL_LINES      AVTP_RVF_SHIFT_TOTAL_LINES
+#define SHIFT_AP	       AVTP_RVF_SHIFT_AP
+#define SHIFT_F		       AVTP_RVF_SHIFT_F
+#define SHIFT_EF	       AVTP_RVF_SHIFT_EF
+#define SHIFT_EVT	       AVTP_RVF_SHIFT_EVT
+#define SHIFT_PD	       AVTP_RVF_SHIFT_PD
+#define SHIFT_I		       AVTP_RVF_SHIFT_I
 #define SHIFT_RAW_PIXEL_DEPTH  (63 - 11)
 #define SHIFT_RAW_PIXEL_FORMAT (63 - 15)
 #define SHIFT_RAW_FRAME_RATE   (63 - 23)
@@ -51,14 +53,14 @@
 #define SHIFT_RAW_I_SEQ_NUM    (63 - 47)
 #define SHIFT_RAW_LINE_NUMBER  (63 - 63)
 
-#define MASK_ACTIVE_PIXELS    (BITMASK(16) << SHIFT_ACTIVE_PIXELS)
-#define MASK_TOTAL_LINES      (BITMASK(16) << SHIFT_TOTAL_LINES)
-#define MASK_AP		      (BITMASK(1) << SHIFT_AP)
-#define MASK_F		      (BITMASK(1) << SHIFT_F)
-#define MASK_EF		      (BITMASK(1) << SHIFT_EF)
-#define MASK_EVT	      (BITMASK(4) << SHIFT_EVT)
-#define MASK_PD		      (BITMASK(1) << SHIFT_PD)
-#define MASK_I		      (BITMASK(1) << SHIFT_I)
+#define MASK_ACTIVE_PIXELS    AVTP_RVF_MASK_ACTIVE_PIXELS
+#define MASK_TOTAL_LINES      AVTP_RVF_MASK_TOTAL_LINES
+#define MASK_AP		      AVTP_RVF_MASK_AP
+#define MASK_F		      AVTP_RVF_MASK_F
+#define MASK_EF		      AVTP_RVF_MASK_EF
+#define MASK_EVT	      AVTP_RVF_MASK_EVT
+#define MASK_PD		      AVTP_RVF_MASK_PD
+#define MASK_I		      AVTP_RVF_MASK_I
 #define MASK_RAW_PIXEL_DEPTH  (BITMASK(4) << SHIFT_RAW_PIXEL_DEPTH)
 #define MASK_RAW_PIXEL_FORMAT (BITMASK(4) << SHIFT_RAW_PIXEL_FORMAT)
 #define MASK_RAW_FRAME_RATE   (BITMASK(8) << SHIFT_RAW_FRAME_RATE)
@@ -67,334 +69,166 @@
 #define MASK_RAW_I_SEQ_NUM    (BITMASK(8) << SHIFT_RAW_I_SEQ_NUM)
 #define MASK_RAW_LINE_NUMBER  (BITMASK(16) << SHIFT_RAW_LINE_NUMBER)
 
-static int get_field_value(const struct avtp_stream_pdu *pdu,
-			   enum avtp_rvf_field field, uint64_t *val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-
-	switch (field) {
-	case AVTP_RVF_FIELD_ACTIVE_PIXELS:
-		mask = MASK_ACTIVE_PIXELS;
-		shift = SHIFT_ACTIVE_PIXELS;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_RVF_FIELD_TOTAL_LINES:
-		mask = MASK_TOTAL_LINES;
-		shift = SHIFT_TOTAL_LINES;
-		bitmap = ntohl(pdu->format_specific);
-		break;
-	case AVTP_RVF_FIELD_AP:
-		mask = MASK_AP;
-		shift = SHIFT_AP;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_RVF_FIELD_F:
-		mask = MASK_F;
-		shift = SHIFT_F;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_RVF_FIELD_EF:
-		mask = MASK_EF;
-		shift = SHIFT_EF;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_RVF_FIELD_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_RVF_FIELD_PD:
-		mask = MASK_PD;
-		shift = SHIFT_PD;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	case AVTP_RVF_FIELD_I:
-		mask = MASK_I;
-		shift = SHIFT_I;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
-
-	return 0;
-}
-
-static int get_raw_field_value(const uint64_t bitmap, enum avtp_rvf_field field,
-			       uint64_t *val)
-{
-	uint64_t mask;
-	uint8_t shift;
-
-	switch (field) {
-	case AVTP_RVF_FIELD_RAW_PIXEL_DEPTH:
-		mask = MASK_RAW_PIXEL_DEPTH;
-		shift = SHIFT_RAW_PIXEL_DEPTH;
-		break;
-	case AVTP_RVF_FIELD_RAW_PIXEL_FORMAT:
-		mask = MASK_RAW_PIXEL_FORMAT;
-		shift = SHIFT_RAW_PIXEL_FORMAT;
-		break;
-	case AVTP_RVF_FIELD_RAW_FRAME_RATE:
-		mask = MASK_RAW_FRAME_RATE;
-		shift = SHIFT_RAW_FRAME_RATE;
-		break;
-	case AVTP_RVF_FIELD_RAW_COLORSPACE:
-		mask = MASK_RAW_COLORSPACE;
-		shift = SHIFT_RAW_COLORSPACE;
-		break;
-	case AVTP_RVF_FIELD_RAW_NUM_LINES:
-		mask = MASK_RAW_NUM_LINES;
-		shift = SHIFT_RAW_NUM_LINES;
-		break;
-	case AVTP_RVF_FIELD_RAW_I_SEQ_NUM:
-		mask = MASK_RAW_I_SEQ_NUM;
-		shift = SHIFT_RAW_I_SEQ_NUM;
-		break;
-	case AVTP_RVF_FIELD_RAW_LINE_NUMBER:
-		mask = MASK_RAW_LINE_NUMBER;
-		shift = SHIFT_RAW_LINE_NUMBER;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
-
-	return 0;
-}
+/* Fields from RAW header, inside avtp_payload. */
+#define RAW_FIELD(mask) \
+	AVTP_STREAM_PAYLOAD_FIELD(struct avtp_rvf_payload, raw_header, mask)
+
+static const struct avtp_field_desc fields[AVTP_RVF_FIELD_MAX] = {
+	AVTP_STREAM_FIELD_DESCS,
+	[AVTP_RVF_FIELD_ACTIVE_PIXELS] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_ACTIVE_PIXELS),
+	[AVTP_RVF_FIELD_TOTAL_LINES] = AVTP_FIELD(struct avtp_stream_pdu,
+					format_specific, MASK_TOTAL_LINES),
+	[AVTP_RVF_FIELD_AP] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_AP),
+	[AVTP_RVF_FIELD_F] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_F),
+	[AVTP_RVF_FIELD_EF] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_EF),
+	[AVTP_RVF_FIELD_EVT] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_EVT),
+	[AVTP_RVF_FIELD_PD] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_PD),
+	[AVTP_RVF_FIELD_I] = AVTP_FIELD(struct avtp_stream_pdu,
+					packet_info, MASK_I),
+	[AVTP_RVF_FIELD_RAW_PIXEL_DEPTH] = RAW_FIELD(MASK_RAW_PIXEL_DEPTH),
+	[AVTP_RVF_FIELD_RAW_PIXEL_FORMAT] = RAW_FIELD(MASK_RAW_PIXEL_FORMAT),
+	[AVTP_RVF_FIELD_RAW_FRAME_RATE] = RAW_FIELD(MASK_RAW_FRAME_RATE),
+	[AVTP_RVF_FIELD_RAW_COLORSPACE] = RAW_FIELD(MASK_RAW_COLORSPACE),
+	[AVTP_RVF_FIELD_RAW_NUM_LINES] = RAW_FIELD(MASK_RAW_NUM_LINES),
+	[AVTP_RVF_FIELD_RAW_I_SEQ_NUM] = RAW_FIELD(MASK_RAW_I_SEQ_NUM),
+	[AVTP_RVF_FIELD_RAW_LINE_NUMBER] = RAW_FIELD(MASK_RAW_LINE_NUMBER),
+};
 
 int avtp_rvf_pdu_get(const struct avtp_stream_pdu *pdu,
 		     enum avtp_rvf_field field, uint64_t *val)
 {
-	int res;
-
 	if (!pdu || !val)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_RVF_FIELD_SV:
-	case AVTP_RVF_FIELD_MR:
-	case AVTP_RVF_FIELD_TV:
-	case AVTP_RVF_FIELD_SEQ_NUM:
-	case AVTP_RVF_FIELD_TU:
-	case AVTP_RVF_FIELD_STREAM_DATA_LEN:
-	case AVTP_RVF_FIELD_TIMESTAMP:
-	case AVTP_RVF_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_get(pdu, (enum avtp_stream_field)field,
-					  val);
-		break;
-	case AVTP_RVF_FIELD_ACTIVE_PIXELS:
-	case AVTP_RVF_FIELD_TOTAL_LINES:
-	case AVTP_RVF_FIELD_AP:
-	case AVTP_RVF_FIELD_F:
-	case AVTP_RVF_FIELD_EF:
-	case AVTP_RVF_FIELD_EVT:
-	case AVTP_RVF_FIELD_PD:
-	case AVTP_RVF_FIELD_I:
-		res = get_field_value(pdu, field, val);
-		break;
-	case AVTP_RVF_FIELD_RAW_PIXEL_DEPTH:
-	case AVTP_RVF_FIELD_RAW_PIXEL_FORMAT:
-	case AVTP_RVF_FIELD_RAW_FRAME_RATE:
-	case AVTP_RVF_FIELD_RAW_COLORSPACE:
-	case AVTP_RVF_FIELD_RAW_NUM_LINES:
-	case AVTP_RVF_FIELD_RAW_I_SEQ_NUM:
-	case AVTP_RVF_FIELD_RAW_LINE_NUMBER: {
-		/* These fields lives on RAW header, inside avtp_payload */
-		struct avtp_rvf_payload *pay =
-			(struct avtp_rvf_payload *)pdu->avtp_payload;
-		res = get_raw_field_value(be64toh(pay->raw_header), field, val);
-		break;
-	}
-	default:
-		res = -EINVAL;
-		break;
-	}
-
-	return res;
+	return avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
-static int set_field_value(struct avtp_stream_pdu *pdu,
-			   enum avtp_rvf_field field, uint32_t val)
+int avtp_rvf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_rvf_field field,
+		     uint64_t val)
 {
-	uint32_t bitmap, mask;
-	uint8_t shift;
-	void *ptr;
-
-	switch (field) {
-	case AVTP_RVF_FIELD_ACTIVE_PIXELS:
-		mask = MASK_ACTIVE_PIXELS;
-		shift = SHIFT_ACTIVE_PIXELS;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_RVF_FIELD_TOTAL_LINES:
-		mask = MASK_TOTAL_LINES;
-		shift = SHIFT_TOTAL_LINES;
-		ptr = &pdu->format_specific;
-		break;
-	case AVTP_RVF_FIELD_AP:
-		mask = MASK_AP;
-		shift = SHIFT_AP;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_RVF_FIELD_F:
-		mask = MASK_F;
-		shift = SHIFT_F;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_RVF_FIELD_EF:
-		mask = MASK_EF;
-		shift = SHIFT_EF;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_RVF_FIELD_EVT:
-		mask = MASK_EVT;
-		shift = SHIFT_EVT;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_RVF_FIELD_PD:
-		mask = MASK_PD;
-		shift = SHIFT_PD;
-		ptr = &pdu->packet_info;
-		break;
-	case AVTP_RVF_FIELD_I:
-		mask = MASK_I;
-		shift = SHIFT_I;
-		ptr = &pdu->packet_info;
-		break;
-	default:
+	if (!pdu)
 		return -EINVAL;
-	}
-
-	bitmap = get_unaligned_be32(ptr);
-
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
-
-	put_unaligned_be32(bitmap, ptr);
 
-	return 0;
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
-static int set_raw_field_value(struct avtp_rvf_payload *pay,
-			       enum avtp_rvf_field field, uint64_t val)
+int avtp_rvf_pdu_init(struct avtp_stream_pdu *pdu)
 {
-	uint64_t bitmap, mask;
-	uint8_t shift;
+	int res;
 
-	switch (field) {
-	case AVTP_RVF_FIELD_RAW_PIXEL_DEPTH:
-		mask = MASK_RAW_PIXEL_DEPTH;
-		shift = SHIFT_RAW_PIXEL_DEPTH;
-		break;
-	case AVTP_RVF_FIELD_RAW_PIXEL_FORMAT:
-		mask = MASK_RAW_PIXEL_FORMAT;
-		shift = SHIFT_RAW_PIXEL_FORMAT;
-		break;
-	case AVTP_RVF_FIELD_RAW_FRAME_RATE:
-		mask = MASK_RAW_FRAME_RATE;
-		shift = SHIFT_RAW_FRAME_RATE;
-		break;
-	case AVTP_RVF_FIELD_RAW_COLORSPACE:
-		mask = MASK_RAW_COLORSPACE;
-		shift = SHIFT_RAW_COLORSPACE;
-		break;
-	case AVTP_RVF_FIELD_RAW_NUM_LINES:
-		mask = MASK_RAW_NUM_LINES;
-		shift = SHIFT_RAW_NUM_LINES;
-		break;
-	case AVTP_RVF_FIELD_RAW_I_SEQ_NUM:
-		mask = MASK_RAW_I_SEQ_NUM;
-		shift = SHIFT_RAW_I_SEQ_NUM;
-		break;
-	case AVTP_RVF_FIELD_RAW_LINE_NUMBER:
-		mask = MASK_RAW_LINE_NUMBER;
-		shift = SHIFT_RAW_LINE_NUMBER;
-		break;
-	default:
+	if (!pdu)
 		return -EINVAL;
-	}
 
-	bitmap = be64toh(pay->raw_header);
+	memset(pdu, 0, sizeof(struct avtp_stream_pdu));
 
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
+	res = avtp_pdu_set((struct avtp_common_pdu *)pdu, AVTP_FIELD_SUBTYPE,
+			   AVTP_SUBTYPE_RVF);
+	if (res < 0)
+		return res;
 
-	pay->raw_header = htobe64(bitmap);
+	res = avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_SV, 1);
+	if (res < 0)
+		return res;
 
 	return 0;
 }
 
-int avtp_rvf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_rvf_field field,
-		     uint64_t val)
+int avtp_rvf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+			struct avtp_rvf_hdr *hdr)
 {
-	int res;
+	uint32_t format_specific, packet_info;
+	uint64_t raw_header;
+	struct avtp_rvf_payload *pay;
 
-	if (!pdu)
+	if (!pdu || !hdr)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_RVF_FIELD_SV:
-	case AVTP_RVF_FIELD_MR:
-	case AVTP_RVF_FIELD_TV:
-	case AVTP_RVF_FIELD_SEQ_NUM:
-	case AVTP_RVF_FIELD_TU:
-	case AVTP_RVF_FIELD_STREAM_DATA_LEN:
-	case AVTP_RVF_FIELD_TIMESTAMP:
-	case AVTP_RVF_FIELD_STREAM_ID:
-		res = avtp_stream_pdu_set(pdu, (enum avtp_stream_field)field,
-					  val);
-		break;
-	case AVTP_RVF_FIELD_ACTIVE_PIXELS:
-	case AVTP_RVF_FIELD_TOTAL_LINES:
-	case AVTP_RVF_FIELD_AP:
-	case AVTP_RVF_FIELD_F:
-	case AVTP_RVF_FIELD_EF:
-	case AVTP_RVF_FIELD_EVT:
-	case AVTP_RVF_FIELD_PD:
-	case AVTP_RVF_FIELD_I:
-		res = set_field_value(pdu, field, val);
-		break;
-	case AVTP_RVF_FIELD_RAW_PIXEL_DEPTH:
-	case AVTP_RVF_FIELD_RAW_PIXEL_FORMAT:
-	case AVTP_RVF_FIELD_RAW_FRAME_RATE:
-	case AVTP_RVF_FIELD_RAW_COLORSPACE:
-	case AVTP_RVF_FIELD_RAW_NUM_LINES:
-	case AVTP_RVF_FIELD_RAW_I_SEQ_NUM:
-	case AVTP_RVF_FIELD_RAW_LINE_NUMBER: {
-		/* These fields lives on RAW header, inside avtp_payload */
-		res = set_raw_field_value(
-			(struct avtp_rvf_payload *)pdu->avtp_payload, field,
-			val);
-		break;
-	}
-	default:
-		res = -EINVAL;
-		break;
-	}
+	format_specific = ntohl(pdu->format_specific);
+	packet_info = ntohl(pdu->packet_info);
+
+	/* RAW header lives inside avtp_payload */
+	pay = (struct avtp_rvf_payload *)pdu->avtp_payload;
+	raw_header = be64toh(pay->raw_header);
+
+	avtp_stream_hdr_decode(&hdr->stream, pdu, ntohl(pdu->subtype_data),
+			       packet_info);
+
+	hdr->active_pixels = BITMAP_GET_VALUE(
+		format_specific, MASK_ACTIVE_PIXELS, SHIFT_ACTIVE_PIXELS);
+	hdr->total_lines = BITMAP_GET_VALUE(format_specific, MASK_TOTAL_LINES,
+					    SHIFT_TOTAL_LINES);
+	hdr->ap = BITMAP_GET_VALUE(packet_info, MASK_AP, SHIFT_AP);
+	hdr->f = BITMAP_GET_VALUE(packet_info, MASK_F, SHIFT_F);
+	hdr->ef = BITMAP_GET_VALUE(packet_info, MASK_EF, SHIFT_EF);
+	hdr->evt = BITMAP_GET_VALUE(packet_info, MASK_EVT, SHIFT_EVT);
+	hdr->pd = BITMAP_GET_VALUE(packet_info, MASK_PD, SHIFT_PD);
+	hdr->i = BITMAP_GET_VALUE(packet_info, MASK_I, SHIFT_I);
+	hdr->raw_pixel_depth = BITMAP_GET_VALUE(
+		raw_header, MASK_RAW_PIXEL_DEPTH, SHIFT_RAW_PIXEL_DEPTH);
+	hdr->raw_pixel_format = BITMAP_GET_VALUE(
+		raw_header, MASK_RAW_PIXEL_FORMAT, SHIFT_RAW_PIXEL_FORMAT);
+	hdr->raw_frame_rate = BITMAP_GET_VALUE(raw_header, MASK_RAW_FRAME_RATE,
+					       SHIFT_RAW_FRAME_RATE);
+	hdr->raw_colorspace = BITMAP_GET_VALUE(
+		raw_header, MASK_RAW_COLORSPACE, SHIFT_RAW_COLORSPACE);
+	hdr->raw_num_lines = BITMAP_GET_VALUE(raw_header, MASK_RAW_NUM_LINES,
+					      SHIFT_RAW_NUM_LINES);
+	hdr->raw_i_seq_num = BITMAP_GET_VALUE(raw_header, MASK_RAW_I_SEQ_NUM,
+					      SHIFT_RAW_I_SEQ_NUM);
+	hdr->raw_line_number = BITMAP_GET_VALUE(
+		raw_header, MASK_RAW_LINE_NUMBER, SHIFT_RAW_LINE_NUMBER);
 
-	return res;
+	return 0;
 }
 
-int avtp_rvf_pdu_init(struct avtp_stream_pdu *pdu)
+int avtp_rvf_pdu_pack(struct avtp_stream_pdu *pdu,
+		      const struct avtp_rvf_hdr *hdr)
 {
-	int res;
+	uint32_t format_specific = 0, packet_info = 0;
+	uint64_t raw_header = 0;
+	struct avtp_rvf_payload *pay;
 
-	if (!pdu)
+	if (!pdu || !hdr)
 		return -EINVAL;
 
-	memset(pdu, 0, sizeof(struct avtp_stream_pdu));
-
-	res = avtp_pdu_set((struct avtp_common_pdu *)pdu, AVTP_FIELD_SUBTYPE,
-			   AVTP_SUBTYPE_RVF);
-	if (res < 0)
-		return res;
-
-	res = avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_SV, 1);
-	if (res < 0)
-		return res;
+	BITMAP_SET_VALUE(format_specific, (uint32_t)hdr->active_pixels,
+			 MASK_ACTIVE_PIXELS, SHIFT_ACTIVE_PIXELS);
+	BITMAP_SET_VALUE(format_specific, hdr->total_lines, MASK_TOTAL_LINES,
+			 SHIFT_TOTAL_LINES);
+	BITMAP_SET_VALUE(packet_info, hdr->ap, MASK_AP, SHIFT_AP);
+	BITMAP_SET_VALUE(packet_info, hdr->f, MASK_F, SHIFT_F);
+	BITMAP_SET_VALUE(packet_info, hdr->ef, MASK_EF, SHIFT_EF);
+	BITMAP_SET_VALUE(packet_info, hdr->evt, MASK_EVT, SHIFT_EVT);
+	BITMAP_SET_VALUE(packet_info, hdr->pd, MASK_PD, SHIFT_PD);
+	BITMAP_SET_VALUE(packet_info, hdr->i, MASK_I, SHIFT_I);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_pixel_depth,
+			 MASK_RAW_PIXEL_DEPTH, SHIFT_RAW_PIXEL_DEPTH);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_pixel_format,
+			 MASK_RAW_PIXEL_FORMAT, SHIFT_RAW_PIXEL_FORMAT);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_frame_rate,
+			 MASK_RAW_FRAME_RATE, SHIFT_RAW_FRAME_RATE);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_colorspace,
+			 MASK_RAW_COLORSPACE, SHIFT_RAW_COLORSPACE);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_num_lines,
+			 MASK_RAW_NUM_LINES, SHIFT_RAW_NUM_LINES);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_i_seq_num,
+			 MASK_RAW_I_SEQ_NUM, SHIFT_RAW_I_SEQ_NUM);
+	BITMAP_SET_VALUE(raw_header, (uint64_t)hdr->raw_line_number,
+			 MASK_RAW_LINE_NUMBER, SHIFT_RAW_LINE_NUMBER);
+
+	avtp_stream_hdr_encode(pdu, &hdr->stream, AVTP_SUBTYPE_RVF, 0,
+			       packet_info);
+	pdu->format_specific = htonl(format_specific);
+
+	/* RAW header lives inside avtp_payload */
+	pay = (struct avtp_rvf_payload *)pdu->avtp_payload;
+	pay->raw_header = htobe64(raw_header);
 
 	return 0;
 }
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_rvf.h"
+#include "avtp_inline.h"
+#include "util.h"
+
+#define SHIFT_RAW_NUM_LINES (63 - 31)
+#define SHIFT_RAW_I_SEQ_NUM (63 - 47)
+
+#define MAX_DATA_LEN (UINT16_MAX - sizeof(struct avtp_rvf_payload))
+
+/* Length, in bytes, of a line 'width' pixels wide. Samples per pixel are
+ * doubled so 4:1:1 and 4:2:0 formats, averaging 1.5 samples per pixel, are
+ * handled as well. Lines must be a whole number of bytes long.
+ */
+static int line_length(uint8_t format, uint8_t depth, uint16_t width,
+		       size_t *len)
+{
+	unsigned int samples, bits;
+	size_t line_bits;
+
+	switch (format) {
+	case AVTP_RVF_PIXEL_FORMAT_MONO:
+	case AVTP_RVF_PIXEL_FORMAT_BAYER_GRBG:
+	case AVTP_RVF_PIXEL_FORMAT_BAYER_RGGB:
+	case AVTP_RVF_PIXEL_FORMAT_BAYER_BGGR:
+	case AVTP_RVF_PIXEL_FORMAT_BAYER_GBRG:
+		samples = 2;
+		break;
+	case AVTP_RVF_PIXEL_FORMAT_411:
+	case AVTP_RVF_PIXEL_FORMAT_420:
+		samples = 3;
+		break;
+	case AVTP_RVF_PIXEL_FORMAT_422:
+		samples = 4;
+		break;
+	case AVTP_RVF_PIXEL_FORMAT_444:
+	case AVTP_RVF_PIXEL_FORMAT_4224:
+		samples = 6;
+		break;
+	case AVTP_RVF_PIXEL_FORMAT_4444:
+		samples = 8;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	switch (depth) {
+	case AVTP_RVF_PIXEL_DEPTH_8:
+		bits = 8;
+		break;
+	case AVTP_RVF_PIXEL_DEPTH_10:
+		bits = 10;
+		break;
+	case AVTP_RVF_PIXEL_DEPTH_12:
+		bits = 12;
+		break;
+	case AVTP_RVF_PIXEL_DEPTH_16:
+		bits = 16;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	line_bits = (size_t)width * samples * bits / 2;
+	if (line_bits == 0 || line_bits % 8)
+		return -EINVAL;
+
+	*len = line_bits / 8;
+	return 0;
+}
+
+int avtp_rvf_raw_packetizer_init(struct avtp_rvf_raw_packetizer *pkt,
+				 const struct avtp_stream_pdu *tmpl,
+				 size_t max_pdu_size)
+{
+	struct avtp_rvf_hdr hdr;
+	size_t line_len, max_data_len, lines;
+	int res;
+
+	if (!pkt || !tmpl)
+		return -EINVAL;
+
+	if (avtp_common_get_subtype((const struct avtp_common_pdu *)tmpl) !=
+	    AVTP_SUBTYPE_RVF)
+		return -EINVAL;
+
+	res = avtp_rvf_pdu_unpack(tmpl, &hdr);
+	if (res < 0)
+		return res;
+
+	res = line_length(hdr.raw_pixel_format, hdr.raw_pixel_depth,
+			  hdr.active_pixels, &line_len);
+	if (res < 0)
+		return res;
+
+	/* Both fields of an interlaced frame have the same number of lines. */
+	if (hdr.total_lines == 0 || (hdr.i && hdr.total_lines % 2))
+		return -EINVAL;
+
+	if (max_pdu_size <= AVTP_RVF_RAW_HDR_LEN)
+		return -EINVAL;
+
+	/* 'stream_data_length' also accounts for the RAW header. */
+	max_data_len = max_pdu_size - AVTP_RVF_RAW_HDR_LEN;
+	if (max_data_len > MAX_DATA_LEN)
+		max_data_len = MAX_DATA_LEN;
+
+	lines = max_data_len / line_len;
+	if (lines == 0)
+		return -EINVAL;
+	if (lines > AVTP_RVF_RAW_MAX_LINES)
+		lines = AVTP_RVF_RAW_MAX_LINES;
+
+	/* Fields set on each PDU are cleared from the template so they can
+	 * simply be ORed in when PDUs are emitted.
+	 */
+	hdr.f = 0;
+	hdr.ef = 0;
+	hdr.raw_num_lines = 0;
+	hdr.raw_i_seq_num = 0;
+	hdr.raw_line_number = 0;
+
+	memset(pkt, 0, sizeof(*pkt));
+
+	res = avtp_rvf_pdu_pack((struct avtp_stream_pdu *)pkt->tmpl, &hdr);
+	if (res < 0)
+		return res;
+
+	pkt->line_len = line_len;
+	pkt->interlaced = hdr.i ? 1 : 0;
+	pkt->field_lines = hdr.total_lines >> pkt->interlaced;
+	pkt->lines_per_pdu = lines;
+
+	return 0;
+}
+
+int avtp_rvf_raw_packetizer_start(struct avtp_rvf_raw_packetizer *pkt,
+				  const void *frame, size_t stride,
+				  uint32_t avtp_time)
+{
+	if (!pkt || !frame || stride < pkt->line_len)
+		return -EINVAL;
+
+	pkt->frame = frame;
+	pkt->stride = stride;
+	pkt->avtp_time = avtp_time;
+	pkt->line = 0;
+	pkt->field = 0;
+
+	return 0;
+}
+
+int avtp_rvf_raw_packetizer_next(struct avtp_rvf_raw_packetizer *pkt,
+				 struct avtp_rvf_raw_packet *packet)
+{
+	const struct avtp_stream_pdu *tmpl;
+	const struct avtp_rvf_payload *tmpl_pay;
+	struct avtp_rvf_payload *pay;
+	struct avtp_stream_pdu *pdu;
+	uint64_t raw_header;
+	unsigned int n, i;
+	size_t iovcnt;
+	int res, last;
+
+	if (!pkt || !packet)
+		return -EINVAL;
+
+	if (!pkt->frame || pkt->field > pkt->interlaced)
+		return 0;
+
+	n = pkt->field_lines - pkt->line;
+	if (n > pkt->lines_per_pdu)
+		n = pkt->lines_per_pdu;
+
+	last = pkt->line + n == pkt->field_lines &&
+	       pkt->field == pkt->interlaced;
+
+	tmpl = (const struct avtp_stream_pdu *)pkt->tmpl;
+	pdu = (struct avtp_stream_pdu *)packet->hdr;
+	res = avtp_stream_pdu_emit(pdu, tmpl, pkt->seq_num, pkt->avtp_time,
+				   sizeof(*pay) + n * pkt->line_len);
+	if (res < 0)
+		return res;
+
+	avtp_rvf_set_f(pdu, pkt->field);
+	avtp_rvf_set_ef(pdu, last);
+
+	tmpl_pay = (const struct avtp_rvf_payload *)tmpl->avtp_payload;
+	raw_header = be64toh(tmpl_pay->raw_header) |
+		     (uint64_t)n << SHIFT_RAW_NUM_LINES |
+		     (uint64_t)pkt->i_seq_num << SHIFT_RAW_I_SEQ_NUM |
+		     (uint64_t)(pkt->line + 1);
+	pay = (struct avtp_rvf_payload *)pdu->avtp_payload;
+	pay->raw_header = htobe64(raw_header);
+
+	packet->iov[0].iov_base = packet->hdr;
+	packet->iov[0].iov_len = AVTP_RVF_RAW_HDR_LEN;
+	iovcnt = 1;
+
+	for (i = 0; i < n; i++) {
+		size_t row = pkt->line + i;
+		const uint8_t *line;
+		struct iovec *prev = &packet->iov[iovcnt - 1];
+
+		/* Fields are woven in the frame buffer. */
+		if (pkt->interlaced)
+			row = row * 2 + pkt->field;
+
+		line = pkt->frame + row * pkt->stride;
+
+		if (iovcnt > 1 &&
+		    (const uint8_t *)prev->iov_base + prev->iov_len == line) {
+			prev->iov_len += pkt->line_len;
+			continue;
+		}
+
+		packet->iov[iovcnt].iov_base = (void *)line;
+		packet->iov[iovcnt].iov_len = pkt->line_len;
+		iovcnt++;
+	}
+
+	packet->iovcnt = iovcnt;
+
+	pkt->seq_num++;
+	pkt->line += n;
+	if (pkt->line == pkt->field_lines) {
+		pkt->line = 0;
+		pkt->field++;
+	}
+	if (last)
+		pkt->i_seq_num++;
+
+	return 1;
+}
+
+int avtp_rvf_raw_depacketizer_init(struct avtp_rvf_raw_depacketizer *depkt)
+{
+	if (!depkt)
+		return -EINVAL;
+
+	memset(depkt, 0, sizeof(*depkt));
+
+	return 0;
+}
+
+int avtp_rvf_raw_depacketizer_set_frame(struct avtp_rvf_raw_depacketizer *depkt,
+					void *frame, size_t stride,
+					size_t size)
+{
+	if (!depkt || !frame || stride == 0)
+		return -EINVAL;
+
+	depkt->frame = frame;
+	depkt->stride = stride;
+	depkt->size = size;
+
+	return 0;
+}
+
+int avtp_rvf_raw_depacketizer_push(struct avtp_rvf_raw_depacketizer *depkt,
+				   const struct avtp_stream_pdu *pdu,
+				   size_t len,
+				   struct avtp_rvf_raw_frame *frame)
+{
+	const struct avtp_rvf_payload *pay;
+	struct avtp_rvf_hdr hdr;
+	size_t line_len, row, step, last_row;
+	const uint8_t *data;
+	unsigned int i;
+	int res;
+
+	if (!depkt || !pdu || !frame || !depkt->frame ||
+	    len < AVTP_RVF_RAW_HDR_LEN)
+		return -EINVAL;
+
+	if (avtp_common_get_subtype((const struct avtp_common_pdu *)pdu) !=
+	    AVTP_SUBTYPE_RVF)
+		return -EINVAL;
+
+	res = avtp_rvf_pdu_unpack(pdu, &hdr);
+	if (res < 0)
+		return res;
+
+	res = line_length(hdr.raw_pixel_format, hdr.raw_pixel_depth,
+			  hdr.active_pixels, &line_len);
+	if (res < 0)
+		return res;
+
+	if (hdr.raw_num_lines == 0 || hdr.raw_line_number == 0)
+		return -EINVAL;
+
+	if (hdr.stream.stream_data_len !=
+		    sizeof(*pay) + hdr.raw_num_lines * line_len ||
+	    hdr.stream.stream_data_len > len - sizeof(*pdu))
+		return -EINVAL;
+
+	/* Lines of a field go every other line of the frame buffer. */
+	row = hdr.raw_line_number - 1;
+	step = 1;
+	if (hdr.i) {
+		row = row * 2 + hdr.f;
+		step = 2;
+	}
+
+	last_row = row + (hdr.raw_num_lines - 1) * step;
+	if (line_len > depkt->stride ||
+	    last_row * depkt->stride + line_len > depkt->size)
+		return -EINVAL;
+
+	if (depkt->seq_valid && hdr.stream.seq_num != depkt->next_seq)
+		depkt->lost_pdus += (uint8_t)(hdr.stream.seq_num -
+					      depkt->next_seq);
+
+	depkt->next_seq = hdr.stream.seq_num + 1;
+	depkt->seq_valid = 1;
+
+	/* The end of the frame being gathered was lost. */
+	if (depkt->lines && hdr.raw_i_seq_num != depkt->i_seq_num) {
+		depkt->lines = 0;
+		depkt->dropped_frames++;
+	}
+
+	depkt->i_seq_num = hdr.raw_i_seq_num;
+
+	pay = (const struct avtp_rvf_payload *)pdu->avtp_payload;
+	data = pay->raw_data;
+	for (i = 0; i < hdr.raw_num_lines; i++) {
+		memcpy(depkt->frame + row * depkt->stride, data, line_len);
+		data += line_len;
+		row += step;
+	}
+
+	depkt->lines += hdr.raw_num_lines;
+
+	if (!hdr.ef)
+		return 0;
+
+	frame->avtp_time = hdr.stream.timestamp;
+	frame->i_seq_num = hdr.raw_i_seq_num;
+	frame->lines = depkt->lines;
+	frame->lost_pdus = depkt->lost_pdus;
+	frame->dropped_frames = depkt->dropped_frames;
+
+	depkt->lines = 0;
+	depkt->lost_pdus = 0;
+	depkt->dropped_frames = 0;
+
+	return 1;
+}
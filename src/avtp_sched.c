@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "avtp_sched.h"
+
+struct entry {
+	uint64_t time;
+	/* Insertion order, which breaks ties between equal times so payloads
+	 * with the same time are dispatched first in, first out.
+	 */
+	uint64_t order;
+	void *payload;
+};
+
+struct avtp_sched {
+	avtp_sched_fn fn;
+	void *arg;
+	uint64_t order;
+	unsigned int count;
+	unsigned int capacity;
+	/* Binary min-heap: children of entry i are entries 2i+1 and 2i+2. */
+	struct entry heap[];
+};
+
+static bool before(const struct entry *a, const struct entry *b)
+{
+	if (a->time != b->time)
+		return a->time < b->time;
+
+	return a->order < b->order;
+}
+
+static void sift_up(struct avtp_sched *sched, unsigned int i)
+{
+	struct entry e = sched->heap[i];
+
+	while (i > 0) {
+		unsigned int parent = (i - 1) / 2;
+
+		if (!before(&e, &sched->heap[parent]))
+			break;
+
+		sched->heap[i] = sched->heap[parent];
+		i = parent;
+	}
+
+	sched->heap[i] = e;
+}
+
+static void sift_down(struct avtp_sched *sched, unsigned int i)
+{
+	struct entry e = sched->heap[i];
+
+	while (1) {
+		unsigned int child = 2 * i + 1;
+
+		if (child >= sched->count)
+			break;
+
+		if (child + 1 < sched->count &&
+			before(&sched->heap[child + 1], &sched->heap[child]))
+			child++;
+
+		if (!before(&sched->heap[child], &e))
+			break;
+
+		sched->heap[i] = sched->heap[child];
+		i = child;
+	}
+
+	sched->heap[i] = e;
+}
+
+int avtp_sched_create(struct avtp_sched **sched, unsigned int capacity,
+						avtp_sched_fn fn, void *arg)
+{
+	struct avtp_sched *s;
+
+	if (!sched || capacity == 0 || !fn)
+		return -EINVAL;
+
+	s = calloc(1, sizeof(*s) + capacity * sizeof(struct entry));
+	if (!s)
+		return -ENOMEM;
+
+	s->fn = fn;
+	s->arg = arg;
+	s->capacity = capacity;
+
+	*sched = s;
+	return 0;
+}
+
+void avtp_sched_destroy(struct avtp_sched *sched)
+{
+	free(sched);
+}
+
+int avtp_sched_add(struct avtp_sched *sched, uint64_t time, void *payload)
+{
+	uint64_t order;
+	struct entry *e;
+
+	if (!sched)
+		return -EINVAL;
+
+	if (sched->count == sched->capacity)
+		return -ENOSPC;
+
+	order = sched->order++;
+
+	e = &sched->heap[sched->count];
+	e->time = time;
+	e->order = order;
+	e->payload = payload;
+
+	sift_up(sched, sched->count++);
+
+	return sched->heap[0].order == order ? 1 : 0;
+}
+
+int avtp_sched_next(const struct avtp_sched *sched, uint64_t *time)
+{
+	if (!sched || !time)
+		return -EINVAL;
+
+	if (sched->count == 0)
+		return -ENOENT;
+
+	*time = sched->heap[0].time;
+	return 0;
+}
+
+int avtp_sched_dispatch(struct avtp_sched *sched, uint64_t now,
+							uint64_t *next)
+{
+	void *payloads[AVTP_SCHED_BATCH];
+	uint64_t times[AVTP_SCHED_BATCH];
+	int total = 0;
+
+	if (!sched)
+		return -EINVAL;
+
+	/* The callback may add payloads, so the heap is checked again after
+	 * each batch.
+	 */
+	while (1) {
+		unsigned int n = 0;
+
+		while (n < AVTP_SCHED_BATCH && sched->count > 0 &&
+					sched->heap[0].time <= now) {
+			payloads[n] = sched->heap[0].payload;
+			times[n] = sched->heap[0].time;
+			n++;
+
+			sched->heap[0] = sched->heap[--sched->count];
+			if (sched->count > 0)
+				sift_down(sched, 0);
+		}
+
+		if (n == 0)
+			break;
+
+		sched->fn(payloads, times, n, sched->arg);
+		total += n;
+	}
+
+	if (next)
+		*next = sched->count > 0 ? sched->heap[0].time : UINT64_MAX;
+
+	return total;
+}
+
+int avtp_sched_get_count(const struct avtp_sched *sched)
+{
+	if (!sched)
+		return -EINVAL;
+
+	return sched->count;
+}
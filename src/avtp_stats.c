@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_inline.h"
+#include "avtp_stats.h"
+
+/* Sequence numbers up to SEQ_WINDOW behind the next expected one are late
+ * PDUs; any other is at or ahead of the expected one.
+ */
+#define SEQ_WINDOW		128
+#define SEQ_WORDS		(256 / 64)
+
+struct avtp_stats {
+	/* Only written by the thread updating the stats object, so they are
+	 * updated with plain relaxed stores instead of read-modify-write
+	 * atomic operations.
+	 */
+	atomic_uint_least64_t received;
+	atomic_uint_least64_t lost;
+	atomic_uint_least64_t duplicated;
+	atomic_uint_least64_t reordered;
+	atomic_uint_least64_t late;
+	atomic_uint_least64_t early;
+	atomic_uint_least64_t latency[AVTP_STATS_LATENCY_BUCKETS];
+
+	uint32_t max_transit_time;
+	uint8_t next_seq;
+	bool seq_valid;
+	/* Bitmap of received sequence numbers, indexed by sequence number.
+	 * Bits behind 'next_seq' are cleared for lost PDUs.
+	 */
+	uint64_t seen[SEQ_WORDS];
+};
+
+static void inc(atomic_uint_least64_t *counter, uint64_t n)
+{
+	uint64_t val = atomic_load_explicit(counter, memory_order_relaxed);
+
+	atomic_store_explicit(counter, val + n, memory_order_relaxed);
+}
+
+static void set_seen(struct avtp_stats *stats, uint8_t seq_num)
+{
+	stats->seen[seq_num / 64] |= 1ULL << (seq_num % 64);
+}
+
+static void clear_seen(struct avtp_stats *stats, uint8_t seq_num)
+{
+	stats->seen[seq_num / 64] &= ~(1ULL << (seq_num % 64));
+}
+
+static bool is_seen(const struct avtp_stats *stats, uint8_t seq_num)
+{
+	return stats->seen[seq_num / 64] & (1ULL << (seq_num % 64));
+}
+
+int avtp_stats_create(struct avtp_stats **stats, uint32_t max_transit_time)
+{
+	struct avtp_stats *s;
+	int i;
+
+	if (!stats)
+		return -EINVAL;
+
+	s = calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	atomic_init(&s->received, 0);
+	atomic_init(&s->lost, 0);
+	atomic_init(&s->duplicated, 0);
+	atomic_init(&s->reordered, 0);
+	atomic_init(&s->late, 0);
+	atomic_init(&s->early, 0);
+	for (i = 0; i < AVTP_STATS_LATENCY_BUCKETS; i++)
+		atomic_init(&s->latency[i], 0);
+
+	s->max_transit_time = max_transit_time;
+
+	*stats = s;
+	return 0;
+}
+
+void avtp_stats_destroy(struct avtp_stats *stats)
+{
+	free(stats);
+}
+
+int avtp_stats_track_seq(struct avtp_stats *stats, uint8_t seq_num)
+{
+	uint8_t diff, s;
+
+	if (!stats)
+		return -EINVAL;
+
+	inc(&stats->received, 1);
+
+	/* Sequence numbers before the first one received are taken as
+	 * received already, so they are never accounted as reordered.
+	 */
+	if (!stats->seq_valid) {
+		memset(stats->seen, 0xFF, sizeof(stats->seen));
+		stats->next_seq = seq_num + 1;
+		stats->seq_valid = true;
+		return AVTP_STATS_SEQ_IN_ORDER;
+	}
+
+	diff = seq_num - stats->next_seq;
+
+	if (diff < SEQ_WINDOW) {
+		for (s = stats->next_seq; s != seq_num; s++)
+			clear_seen(stats, s);
+		set_seen(stats, seq_num);
+
+		stats->next_seq = seq_num + 1;
+
+		if (diff == 0)
+			return AVTP_STATS_SEQ_IN_ORDER;
+
+		inc(&stats->lost, diff);
+		return AVTP_STATS_SEQ_GAP;
+	}
+
+	if (is_seen(stats, seq_num)) {
+		inc(&stats->duplicated, 1);
+		return AVTP_STATS_SEQ_DUPLICATE;
+	}
+
+	set_seen(stats, seq_num);
+	inc(&stats->lost, -1);
+	inc(&stats->reordered, 1);
+	return AVTP_STATS_SEQ_REORDERED;
+}
+
+int avtp_stats_track_time(struct avtp_stats *stats, uint32_t avtp_time,
+						uint64_t arrival_time)
+{
+	int32_t delta;
+	int bucket;
+
+	if (!stats)
+		return -EINVAL;
+
+	/* Presentation time only carries the 32 least significant bits of
+	 * the time, so it is assumed to be within 2^31 ns of the arrival
+	 * time.
+	 */
+	delta = (int32_t) (avtp_time - (uint32_t) arrival_time);
+	if (delta < 0) {
+		inc(&stats->late, 1);
+		return 0;
+	}
+
+	if ((uint32_t) delta > stats->max_transit_time)
+		inc(&stats->early, 1);
+
+	bucket = delta ? 32 - __builtin_clz(delta) : 0;
+	inc(&stats->latency[bucket], 1);
+
+	return 0;
+}
+
+int avtp_stats_update(struct avtp_stats *stats,
+				const struct avtp_stream_pdu *pdu,
+				uint64_t arrival_time)
+{
+	int res;
+
+	if (!stats || !pdu)
+		return -EINVAL;
+
+	res = avtp_stats_track_seq(stats, avtp_stream_get_seq_num(pdu));
+
+	if (avtp_stream_get_tv(pdu))
+		avtp_stats_track_time(stats, avtp_stream_get_timestamp(pdu),
+								arrival_time);
+
+	return res;
+}
+
+int avtp_stats_read(const struct avtp_stats *stats,
+				struct avtp_stats_snapshot *snap)
+{
+	int i;
+
+	if (!stats || !snap)
+		return -EINVAL;
+
+	snap->received = atomic_load_explicit(&stats->received,
+						memory_order_relaxed);
+	snap->lost = atomic_load_explicit(&stats->lost, memory_order_relaxed);
+	snap->duplicated = atomic_load_explicit(&stats->duplicated,
+						memory_order_relaxed);
+	snap->reordered = atomic_load_explicit(&stats->reordered,
+						memory_order_relaxed);
+	snap->late = atomic_load_explicit(&stats->late, memory_order_relaxed);
+	snap->early = atomic_load_explicit(&stats->early,
+						memory_order_relaxed);
+	for (i = 0; i < AVTP_STATS_LATENCY_BUCKETS; i++)
+		snap->latency[i] = atomic_load_explicit(&stats->latency[i],
+						memory_order_relaxed);
+
+	return 0;
+}
@@ -30,179 +30,109 @@
 #include <stddef.h>
 
 #include "avtp.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
 #include "avtp_stream.h"
 #include "util.h"
 
-#define SHIFT_SV			(31 - 8)
-#define SHIFT_MR			(31 - 12)
-#define SHIFT_TV			(31 - 15)
-#define SHIFT_SEQ_NUM			(31 - 23)
-#define SHIFT_STREAM_DATA_LEN		(31 - 15)
-
-#define MASK_SV				(BITMASK(1) << SHIFT_SV)
-#define MASK_MR				(BITMASK(1) << SHIFT_MR)
-#define MASK_TV				(BITMASK(1) << SHIFT_TV)
-#define MASK_SEQ_NUM			(BITMASK(8) << SHIFT_SEQ_NUM)
-#define MASK_TU				(BITMASK(1))
-#define MASK_STREAM_DATA_LEN		(BITMASK(16) << SHIFT_STREAM_DATA_LEN)
-
-static int get_field_value(const struct avtp_stream_pdu *pdu,
-				enum avtp_stream_field field, uint64_t *val)
-{
-	uint32_t bitmap, mask;
-	uint8_t shift;
-
-	switch (field) {
-	case AVTP_STREAM_FIELD_SV:
-		mask = MASK_SV;
-		shift = SHIFT_SV;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_STREAM_FIELD_MR:
-		mask = MASK_MR;
-		shift = SHIFT_MR;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_STREAM_FIELD_TV:
-		mask = MASK_TV;
-		shift = SHIFT_TV;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_STREAM_FIELD_SEQ_NUM:
-		mask = MASK_SEQ_NUM;
-		shift = SHIFT_SEQ_NUM;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_STREAM_FIELD_TU:
-		mask = MASK_TU;
-		shift = 0;
-		bitmap = ntohl(pdu->subtype_data);
-		break;
-	case AVTP_STREAM_FIELD_STREAM_DATA_LEN:
-		mask = MASK_STREAM_DATA_LEN;
-		shift = SHIFT_STREAM_DATA_LEN;
-		bitmap = ntohl(pdu->packet_info);
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	*val = BITMAP_GET_VALUE(bitmap, mask, shift);
-
-	return 0;
-}
+#define SHIFT_SUBTYPE			AVTP_COMMON_SHIFT_SUBTYPE
+#define SHIFT_SV			AVTP_STREAM_SHIFT_SV
+#define SHIFT_MR			AVTP_STREAM_SHIFT_MR
+#define SHIFT_TV			AVTP_STREAM_SHIFT_TV
+#define SHIFT_SEQ_NUM			AVTP_STREAM_SHIFT_SEQ_NUM
+#define SHIFT_STREAM_DATA_LEN		AVTP_STREAM_SHIFT_STREAM_DATA_LEN
+
+#define MASK_SUBTYPE			AVTP_COMMON_MASK_SUBTYPE
+#define MASK_SV				AVTP_STREAM_MASK_SV
+#define MASK_MR				AVTP_STREAM_MASK_MR
+#define MASK_TV				AVTP_STREAM_MASK_TV
+#define MASK_SEQ_NUM			AVTP_STREAM_MASK_SEQ_NUM
+#define MASK_TU				AVTP_STREAM_MASK_TU
+#define MASK_STREAM_DATA_LEN		AVTP_STREAM_MASK_STREAM_DATA_LEN
+
+static const struct avtp_field_desc fields[AVTP_STREAM_FIELD_MAX] = {
+	AVTP_STREAM_FIELD_DESCS,
+};
 
 int avtp_stream_pdu_get(const struct avtp_stream_pdu *pdu,
 				enum avtp_stream_field field, uint64_t *val)
 {
-	int res;
-
 	if (!pdu || !val)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_STREAM_FIELD_SV:
-	case AVTP_STREAM_FIELD_MR:
-	case AVTP_STREAM_FIELD_TV:
-	case AVTP_STREAM_FIELD_SEQ_NUM:
-	case AVTP_STREAM_FIELD_TU:
-	case AVTP_STREAM_FIELD_STREAM_DATA_LEN:
-		res = get_field_value(pdu, field, val);
-		break;
-	case AVTP_STREAM_FIELD_TIMESTAMP:
-		*val = ntohl(pdu->avtp_time);
-		res = 0;
-		break;
-	case AVTP_STREAM_FIELD_STREAM_ID:
-		*val = be64toh(pdu->stream_id);
-		res = 0;
-		break;
-	default:
-		return -EINVAL;
-	}
-
-	return res;
+	return avtp_field_get(fields, ARRAY_SIZE(fields), pdu, field, val);
 }
 
-static int set_field_value(struct avtp_stream_pdu *pdu,
-				enum avtp_stream_field field, uint64_t val)
+int avtp_stream_pdu_set(struct avtp_stream_pdu *pdu,
+				enum avtp_stream_field field, uint64_t value)
 {
-	uint32_t bitmap, mask;
-	uint8_t shift;
-	void *ptr;
-
-	switch (field) {
-	case AVTP_STREAM_FIELD_SV:
-		mask = MASK_SV;
-		shift = SHIFT_SV;
-		ptr = &pdu->subtype_data;
-		break;
-	case AVTP_STREAM_FIELD_MR:
-		mask = MASK_MR;
-		shift = SHIFT_MR;
-		ptr = &pdu->subtype_data;
-		break;
-	case AVTP_STREAM_FIELD_TV:
-		mask = MASK_TV;
-		shift = SHIFT_TV;
-		ptr = &pdu->subtype_data;
-		break;
-	case AVTP_STREAM_FIELD_SEQ_NUM:
-		mask = MASK_SEQ_NUM;
-		shift = SHIFT_SEQ_NUM;
-		ptr = &pdu->subtype_data;
-		break;
-	case AVTP_STREAM_FIELD_TU:
-		mask = MASK_TU;
-		shift = 0;
-		ptr = &pdu->subtype_data;
-		break;
-	case AVTP_STREAM_FIELD_STREAM_DATA_LEN:
-		mask = MASK_STREAM_DATA_LEN;
-		shift = SHIFT_STREAM_DATA_LEN;
-		ptr = &pdu->packet_info;
-		break;
-	default:
+	if (!pdu)
 		return -EINVAL;
-	}
-
-	bitmap = get_unaligned_be32(ptr);
 
-	BITMAP_SET_VALUE(bitmap, val, mask, shift);
+	return avtp_field_set(fields, ARRAY_SIZE(fields), pdu, field, value);
+}
 
-	put_unaligned_be32(bitmap, ptr);
+void avtp_stream_hdr_decode(struct avtp_stream_hdr *hdr,
+				const struct avtp_stream_pdu *pdu,
+				uint32_t subtype_data, uint32_t packet_info)
+{
+	hdr->sv = BITMAP_GET_VALUE(subtype_data, MASK_SV, SHIFT_SV);
+	hdr->mr = BITMAP_GET_VALUE(subtype_data, MASK_MR, SHIFT_MR);
+	hdr->tv = BITMAP_GET_VALUE(subtype_data, MASK_TV, SHIFT_TV);
+	hdr->seq_num = BITMAP_GET_VALUE(subtype_data, MASK_SEQ_NUM,
+								SHIFT_SEQ_NUM);
+	hdr->tu = BITMAP_GET_VALUE(subtype_data, MASK_TU, 0);
+	hdr->stream_id = be64toh(pdu->stream_id);
+	hdr->timestamp = ntohl(pdu->avtp_time);
+	hdr->stream_data_len = BITMAP_GET_VALUE(packet_info,
+					MASK_STREAM_DATA_LEN,
+					SHIFT_STREAM_DATA_LEN);
+}
 
-	return 0;
+void avtp_stream_hdr_encode(struct avtp_stream_pdu *pdu,
+				const struct avtp_stream_hdr *hdr,
+				uint8_t subtype, uint32_t subtype_data,
+				uint32_t packet_info)
+{
+	BITMAP_SET_VALUE(subtype_data, (uint32_t) subtype, MASK_SUBTYPE,
+								SHIFT_SUBTYPE);
+	BITMAP_SET_VALUE(subtype_data, hdr->sv, MASK_SV, SHIFT_SV);
+	BITMAP_SET_VALUE(subtype_data, hdr->mr, MASK_MR, SHIFT_MR);
+	BITMAP_SET_VALUE(subtype_data, hdr->tv, MASK_TV, SHIFT_TV);
+	BITMAP_SET_VALUE(subtype_data, hdr->seq_num, MASK_SEQ_NUM,
+								SHIFT_SEQ_NUM);
+	BITMAP_SET_VALUE(subtype_data, hdr->tu, MASK_TU, 0);
+	BITMAP_SET_VALUE(packet_info, (uint32_t) hdr->stream_data_len,
+				MASK_STREAM_DATA_LEN, SHIFT_STREAM_DATA_LEN);
+
+	pdu->subtype_data = htonl(subtype_data);
+	pdu->stream_id = htobe64(hdr->stream_id);
+	pdu->avtp_time = htonl(hdr->timestamp);
+	pdu->packet_info = htonl(packet_info);
 }
 
-int avtp_stream_pdu_set(struct avtp_stream_pdu *pdu,
-				enum avtp_stream_field field, uint64_t value)
+int avtp_stream_pdu_emit(struct avtp_stream_pdu *pdu,
+				const struct avtp_stream_pdu *tmpl,
+				uint8_t seq_num, uint32_t timestamp,
+				uint16_t data_len)
 {
-	int res;
+	uint32_t subtype_data, packet_info;
 
-	if (!pdu)
+	if (!pdu || !tmpl)
 		return -EINVAL;
 
-	switch (field) {
-	case AVTP_STREAM_FIELD_SV:
-	case AVTP_STREAM_FIELD_MR:
-	case AVTP_STREAM_FIELD_TV:
-	case AVTP_STREAM_FIELD_SEQ_NUM:
-	case AVTP_STREAM_FIELD_TU:
-	case AVTP_STREAM_FIELD_STREAM_DATA_LEN:
-		res = set_field_value(pdu, field, value);
-		break;
-	case AVTP_STREAM_FIELD_TIMESTAMP:
-		pdu->avtp_time = htonl(value);
-		res = 0;
-		break;
-	case AVTP_STREAM_FIELD_STREAM_ID:
-		pdu->stream_id = htobe64(value);
-		res = 0;
-		break;
-	default:
-		return -EINVAL;
-	}
+	subtype_data = ntohl(tmpl->subtype_data);
+	packet_info = ntohl(tmpl->packet_info);
 
-	return res;
+	BITMAP_SET_VALUE(subtype_data, seq_num, MASK_SEQ_NUM, SHIFT_SEQ_NUM);
+	BITMAP_SET_VALUE(packet_info, (uint32_t) data_len,
+				MASK_STREAM_DATA_LEN, SHIFT_STREAM_DATA_LEN);
+
+	pdu->subtype_data = htonl(subtype_data);
+	pdu->stream_id = tmpl->stream_id;
+	pdu->avtp_time = htonl(timestamp);
+	pdu->format_specific = tmpl->format_specific;
+	pdu->packet_info = htonl(packet_info);
+
+	return 0;
 }
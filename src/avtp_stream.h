@@ -30,6 +30,9 @@
 #include <errno.h>
 #include <stdint.h>
 
+#include "avtp_field.h"
+#include "avtp_inline.h"
+
 #pragma GCC visibility push(hidden)
 
 #ifdef __cplusplus
@@ -69,6 +72,43 @@ enum avtp_stream_field {
 	AVTP_STREAM_FIELD_MAX
 };
 
+/* Descriptors of Stream AVTPDU fields (see struct avtp_field_desc). Format
+ * descriptor tables start with this macro so stream fields don't need to be
+ * described again by every format:
+ *
+ * static const struct avtp_field_desc fields[AVTP_NEWFORMAT_FIELD_MAX] = {
+ *      AVTP_STREAM_FIELD_DESCS,
+ *      [AVTP_NEWFORMAT_FIELD_XYZ] = AVTP_FIELD(...),
+ * };
+ */
+#define AVTP_STREAM_FIELD_DESCS						\
+	[AVTP_STREAM_FIELD_SV] = AVTP_FIELD(struct avtp_stream_pdu,	\
+			subtype_data, AVTP_STREAM_MASK_SV),		\
+	[AVTP_STREAM_FIELD_MR] = AVTP_FIELD(struct avtp_stream_pdu,	\
+			subtype_data, AVTP_STREAM_MASK_MR),		\
+	[AVTP_STREAM_FIELD_TV] = AVTP_FIELD(struct avtp_stream_pdu,	\
+			subtype_data, AVTP_STREAM_MASK_TV),		\
+	[AVTP_STREAM_FIELD_SEQ_NUM] = AVTP_FIELD(struct avtp_stream_pdu, \
+			subtype_data, AVTP_STREAM_MASK_SEQ_NUM),	\
+	[AVTP_STREAM_FIELD_TU] = AVTP_FIELD(struct avtp_stream_pdu,	\
+			subtype_data, AVTP_STREAM_MASK_TU),		\
+	[AVTP_STREAM_FIELD_STREAM_ID] = AVTP_FIELD(struct avtp_stream_pdu, \
+			stream_id, UINT64_MAX),				\
+	[AVTP_STREAM_FIELD_TIMESTAMP] = AVTP_FIELD(struct avtp_stream_pdu, \
+			avtp_time, BITMASK(32)),			\
+	[AVTP_STREAM_FIELD_STREAM_DATA_LEN] =				\
+		AVTP_FIELD(struct avtp_stream_pdu, packet_info,		\
+			AVTP_STREAM_MASK_STREAM_DATA_LEN)
+
+/* Same as AVTP_FIELD() for a field from the 'word' member of 'type', a format
+ * specific header living at the beginning of the AVTPDU payload (e.g. struct
+ * avtp_cvf_h264_payload).
+ */
+#define AVTP_STREAM_PAYLOAD_FIELD(type, word, mask)			\
+	AVTP_FIELD_DESC(offsetof(struct avtp_stream_pdu, avtp_payload) + \
+			offsetof(type, word),				\
+			sizeof(((type *) 0)->word), (mask))
+
 /* Get value from Stream AVTPDU field.
  * @pdu: Pointer to PDU struct.
  * @field: PDU field to be retrieved.
@@ -93,6 +133,33 @@ int avtp_stream_pdu_get(const struct avtp_stream_pdu *pdu,
 int avtp_stream_pdu_set(struct avtp_stream_pdu *pdu,
 				enum avtp_stream_field field, uint64_t val);
 
+/* Decode all Stream AVTPDU fields at once. Words shared with format specific
+ * fields are passed already converted to host order so format unpack
+ * functions don't need to convert them twice.
+ * @hdr: Pointer to struct where decoded fields are saved.
+ * @pdu: Pointer to PDU struct.
+ * @subtype_data: 'subtype_data' word from 'pdu' in host order.
+ * @packet_info: 'packet_info' word from 'pdu' in host order.
+ */
+void avtp_stream_hdr_decode(struct avtp_stream_hdr *hdr,
+				const struct avtp_stream_pdu *pdu,
+				uint32_t subtype_data, uint32_t packet_info);
+
+/* Encode all Stream AVTPDU fields at once. Format specific bits from words
+ * shared with Stream AVTPDU fields are passed in host order and are merged
+ * with the stream fields before the words are written to 'pdu'. The 'version'
+ * field is always set to 0.
+ * @pdu: Pointer to PDU struct.
+ * @hdr: Pointer to struct with the fields to be encoded.
+ * @subtype: AVTP subtype of the PDU.
+ * @subtype_data: Format specific bits from 'subtype_data' word.
+ * @packet_info: Format specific bits from 'packet_info' word.
+ */
+void avtp_stream_hdr_encode(struct avtp_stream_pdu *pdu,
+				const struct avtp_stream_hdr *hdr,
+				uint8_t subtype, uint32_t subtype_data,
+				uint32_t packet_info);
+
 #ifdef __cplusplus
 }
 #endif
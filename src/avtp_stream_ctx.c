@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_clock.h"
+#include "avtp_inline.h"
+#include "avtp_stats.h"
+#include "avtp_stream_ctx.h"
+#include "util.h"
+
+#define SHIFT_SEQ_NUM			AVTP_STREAM_SHIFT_SEQ_NUM
+#define MASK_SEQ_NUM			AVTP_STREAM_MASK_SEQ_NUM
+#define MASK_TV				AVTP_STREAM_MASK_TV
+#define SHIFT_SUBTYPE			AVTP_COMMON_SHIFT_SUBTYPE
+
+#define FLAG_RX_SEQ			AVTP_STREAM_CTX_FLAG_RX_SEQ
+#define FLAG_RX_TIME			AVTP_STREAM_CTX_FLAG_RX_TIME
+#define FLAG_SPARSE			AVTP_STREAM_CTX_FLAG_SPARSE
+
+#define NSEC_PER_SEC			1000000000ULL
+#define FRAC_BITS			32
+/* Times start half a nanosecond in, so truncating them to the integer part
+ * rounds to the nearest nanosecond.
+ */
+#define FRAC_HALF			(1ULL << (FRAC_BITS - 1))
+
+/* Everything touched for each PDU must fit in a single cache line, and array
+ * elements must not share cache lines either.
+ */
+_Static_assert(sizeof(struct avtp_stream_ctx) == AVTP_STREAM_CTX_CACHE_LINE,
+			"struct avtp_stream_ctx doesn't fit in a cache line");
+
+static bool is_sparse(const struct avtp_stream_pdu *pdu)
+{
+	return ntohl(pdu->subtype_data) >> SHIFT_SUBTYPE == AVTP_SUBTYPE_AAF &&
+							avtp_aaf_get_sp(pdu);
+}
+
+/* Number of frames carried by an AAF PDU, from its stream data length. */
+static unsigned int aaf_frames(const struct avtp_stream_pdu *pdu)
+{
+	unsigned int width, chans;
+
+	switch (avtp_aaf_get_format(pdu)) {
+	case AVTP_AAF_FORMAT_INT_16BIT:
+		width = 2;
+		break;
+	case AVTP_AAF_FORMAT_INT_24BIT:
+		width = 3;
+		break;
+	case AVTP_AAF_FORMAT_INT_32BIT:
+	case AVTP_AAF_FORMAT_FLOAT_32BIT:
+	case AVTP_AAF_FORMAT_AES3_32BIT:
+		width = 4;
+		break;
+	default:
+		return 0;
+	}
+
+	chans = avtp_aaf_get_chan_per_frame(pdu);
+	if (!chans)
+		return 0;
+
+	return avtp_stream_get_stream_data_len(pdu) / (width * chans);
+}
+
+int avtp_stream_ctx_init(struct avtp_stream_ctx *ctx,
+				const struct avtp_stream_pdu *tmpl,
+				uint32_t sample_rate)
+{
+	uint32_t subtype_data;
+
+	if (!ctx || !tmpl || !sample_rate)
+		return -EINVAL;
+
+	subtype_data = ntohl(tmpl->subtype_data);
+
+	memset(ctx, 0, sizeof(*ctx));
+	memcpy(&ctx->tmpl, tmpl, sizeof(ctx->tmpl));
+	ctx->subtype_data = subtype_data & ~MASK_SEQ_NUM;
+	ctx->seq_num = BITMAP_GET_VALUE(subtype_data, MASK_SEQ_NUM,
+							SHIFT_SEQ_NUM);
+	ctx->time = ((uint64_t) ntohl(tmpl->avtp_time) << FRAC_BITS) |
+								FRAC_HALF;
+	ctx->period = (NSEC_PER_SEC << FRAC_BITS) / sample_rate;
+
+	if (is_sparse(tmpl))
+		ctx->flags |= FLAG_SPARSE;
+
+	return 0;
+}
+
+int avtp_stream_ctx_set_time(struct avtp_stream_ctx *ctx, uint64_t time)
+{
+	if (!ctx)
+		return -EINVAL;
+
+	ctx->time = (time << FRAC_BITS) | FRAC_HALF;
+
+	return 0;
+}
+
+int avtp_stream_ctx_sync(struct avtp_stream_ctx *ctx, uint64_t offset)
+{
+	uint64_t now;
+	int res;
+
+	if (!ctx || !ctx->clk)
+		return -EINVAL;
+
+	res = avtp_clock_now(ctx->clk, &now);
+	if (res < 0)
+		return res;
+
+	ctx->time = ((now + offset) << FRAC_BITS) | FRAC_HALF;
+
+	return 0;
+}
+
+/* Write the two words which change from PDU to PDU, then step to the next
+ * PDU. 'sequence_num' wraps on its own since it is an 8-bit counter, and so
+ * does 'avtp_timestamp' since it is the upper half of 'time'.
+ */
+static inline void ctx_patch(struct avtp_stream_ctx *ctx,
+				struct avtp_stream_pdu *pdu,
+				unsigned int samples)
+{
+	uint32_t subtype_data = ctx->subtype_data |
+				(uint32_t) ctx->seq_num << SHIFT_SEQ_NUM;
+	uint32_t avtp_time = ctx->time >> FRAC_BITS;
+
+	if ((ctx->flags & FLAG_SPARSE) &&
+				ctx->seq_num % AVTP_AAF_PCM_SPARSE_INTERVAL) {
+		subtype_data &= ~MASK_TV;
+		avtp_time = 0;
+	}
+
+	pdu->subtype_data = htonl(subtype_data);
+	pdu->avtp_time = htonl(avtp_time);
+
+	ctx->seq_num++;
+	ctx->time += ctx->period * samples;
+}
+
+static inline void ctx_emit(struct avtp_stream_ctx *ctx,
+				struct avtp_stream_pdu *pdu,
+				unsigned int samples)
+{
+	pdu->stream_id = ctx->tmpl.stream_id;
+	pdu->format_specific = ctx->tmpl.format_specific;
+	pdu->packet_info = ctx->tmpl.packet_info;
+
+	ctx_patch(ctx, pdu, samples);
+}
+
+int avtp_stream_ctx_emit(struct avtp_stream_ctx *ctx,
+				struct avtp_stream_pdu *pdu,
+				unsigned int samples)
+{
+	if (!ctx || !pdu)
+		return -EINVAL;
+
+	ctx_emit(ctx, pdu, samples);
+
+	return 0;
+}
+
+int avtp_stream_ctx_advance(struct avtp_stream_ctx *ctx,
+				struct avtp_stream_pdu *pdu,
+				unsigned int samples)
+{
+	if (!ctx || !pdu)
+		return -EINVAL;
+
+	ctx_patch(ctx, pdu, samples);
+
+	return 0;
+}
+
+int avtp_stream_ctx_emit_burst(struct avtp_stream_ctx *ctx, void *pdus[],
+				unsigned int count, unsigned int samples)
+{
+	unsigned int i;
+
+	if (!ctx || (!pdus && count))
+		return -EINVAL;
+
+	for (i = 0; i < count; i++) {
+		if (!pdus[i])
+			return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++)
+		ctx_emit(ctx, pdus[i], samples);
+
+	return 0;
+}
+
+int avtp_stream_ctx_advance_burst(struct avtp_stream_ctx *ctx, void *pdus[],
+				unsigned int count, unsigned int samples)
+{
+	unsigned int i;
+
+	if (!ctx || (!pdus && count))
+		return -EINVAL;
+
+	for (i = 0; i < count; i++) {
+		if (!pdus[i])
+			return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++)
+		ctx_patch(ctx, pdus[i], samples);
+
+	return 0;
+}
+
+int avtp_stream_ctx_receive(struct avtp_stream_ctx *ctx,
+				const struct avtp_stream_pdu *pdu,
+				uint64_t arrival_time, uint64_t *time)
+{
+	uint64_t ptime = 0;
+	uint8_t seq_num;
+	bool tv, sparse, in_order;
+	int res;
+
+	if (!ctx || !pdu)
+		return -EINVAL;
+
+	seq_num = avtp_stream_get_seq_num(pdu);
+	tv = avtp_stream_get_tv(pdu);
+	sparse = is_sparse(pdu);
+
+	/* The arrival time is only needed if there is a presentation time to
+	 * be judged against it or reconstructed from it.
+	 */
+	if (!arrival_time && ((tv && ctx->stats) || (time && (tv || sparse)))) {
+		if (!ctx->clk)
+			return -EINVAL;
+
+		res = avtp_clock_now(ctx->clk, &arrival_time);
+		if (res < 0)
+			return res;
+	}
+
+	in_order = !(ctx->flags & FLAG_RX_SEQ) || seq_num == ctx->rx_seq;
+	res = in_order ? AVTP_STATS_SEQ_IN_ORDER : AVTP_STATS_SEQ_GAP;
+
+	ctx->rx_seq = seq_num + 1;
+	ctx->flags |= FLAG_RX_SEQ;
+
+	/* PDUs without a timestamp from sparse streams are presented right
+	 * after the previous PDU. Once some PDU is lost, that can't be told
+	 * anymore until the next PDU with a timestamp.
+	 */
+	if (tv) {
+		avtp_clock_unwrap(arrival_time, avtp_stream_get_timestamp(pdu),
+								32, &ptime);
+		ctx->time = (ptime << FRAC_BITS) | FRAC_HALF;
+		ctx->flags |= FLAG_RX_TIME;
+	} else if (sparse && in_order && (ctx->flags & FLAG_RX_TIME)) {
+		avtp_clock_unwrap(arrival_time, ctx->time >> FRAC_BITS, 32,
+								&ptime);
+	} else {
+		ctx->flags &= ~FLAG_RX_TIME;
+	}
+
+	if (sparse)
+		ctx->time += ctx->period * aaf_frames(pdu);
+
+	/* The stats object tracks a window of sequence numbers so it tells
+	 * reordered and duplicated PDUs apart from lost ones.
+	 */
+	if (ctx->stats)
+		res = avtp_stats_update(ctx->stats, pdu, arrival_time);
+
+	if (time)
+		*time = ptime;
+
+	return res;
+}
+
+int avtp_stream_ctx_array_create(struct avtp_stream_ctx **ctxs,
+							unsigned int count)
+{
+	struct avtp_stream_ctx *c;
+
+	if (!ctxs || count == 0 || sizeof(*c) > SIZE_MAX / count)
+		return -EINVAL;
+
+	c = aligned_alloc(AVTP_STREAM_CTX_CACHE_LINE, count * sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	memset(c, 0, count * sizeof(*c));
+
+	*ctxs = c;
+	return 0;
+}
+
+void avtp_stream_ctx_array_destroy(struct avtp_stream_ctx *ctxs)
+{
+	free(ctxs);
+}
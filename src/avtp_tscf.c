@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <string.h>
+
+#include "avtp.h"
+#include "avtp_field.h"
+#include "avtp_inline.h"
+#include "avtp_stream.h"
+#include "avtp_tscf.h"
+#include "util.h"
+
+#define SHIFT_SUBTYPE			AVTP_COMMON_SHIFT_SUBTYPE
+#define SHIFT_SV			AVTP_NTSCF_SHIFT_SV
+#define SHIFT_DATA_LEN			AVTP_NTSCF_SHIFT_DATA_LEN
+
+#define MASK_SUBTYPE			AVTP_COMMON_MASK_SUBTYPE
+#define MASK_SV				AVTP_NTSCF_MASK_SV
+#define MASK_DATA_LEN			AVTP_NTSCF_MASK_DATA_LEN
+#define MASK_SEQ_NUM			AVTP_NTSCF_MASK_SEQ_NUM
+
+static const struct avtp_field_desc tscf_fields[AVTP_TSCF_FIELD_MAX] = {
+	AVTP_STREAM_FIELD_DESCS,
+};
+
+static const struct avtp_field_desc ntscf_fields[AVTP_NTSCF_FIELD_MAX] = {
+	[AVTP_NTSCF_FIELD_SV] = AVTP_FIELD(struct avtp_ntscf_pdu,
+					subtype_data, MASK_SV),
+	[AVTP_NTSCF_FIELD_DATA_LEN] = AVTP_FIELD(struct avtp_ntscf_pdu,
+					subtype_data, MASK_DATA_LEN),
+	[AVTP_NTSCF_FIELD_SEQ_NUM] = AVTP_FIELD(struct avtp_ntscf_pdu,
+					subtype_data, MASK_SEQ_NUM),
+	[AVTP_NTSCF_FIELD_STREAM_ID] = AVTP_FIELD(struct avtp_ntscf_pdu,
+					stream_id, UINT64_MAX),
+};
+
+int avtp_tscf_pdu_get(const struct avtp_stream_pdu *pdu,
+				enum avtp_tscf_field field, uint64_t *val)
+{
+	if (!pdu || !val)
+		return -EINVAL;
+
+	return avtp_field_get(tscf_fields, ARRAY_SIZE(tscf_fields), pdu,
+								field, val);
+}
+
+int avtp_tscf_pdu_set(struct avtp_stream_pdu *pdu, enum avtp_tscf_field field,
+								uint64_t val)
+{
+	if (!pdu)
+		return -EINVAL;
+
+	return avtp_field_set(tscf_fields, ARRAY_SIZE(tscf_fields), pdu,
+								field, val);
+}
+
+int avtp_tscf_pdu_init(struct avtp_stream_pdu *pdu)
+{
+	int res;
+
+	if (!pdu)
+		return -EINVAL;
+
+	memset(pdu, 0, sizeof(struct avtp_stream_pdu));
+
+	res = avtp_pdu_set((struct avtp_common_pdu *) pdu, AVTP_FIELD_SUBTYPE,
+							AVTP_SUBTYPE_TSCF);
+	if (res < 0)
+		return res;
+
+	res = avtp_tscf_pdu_set(pdu, AVTP_TSCF_FIELD_SV, 1);
+	if (res < 0)
+		return res;
+
+	return 0;
+}
+
+int avtp_tscf_pdu_unpack(const struct avtp_stream_pdu *pdu,
+						struct avtp_tscf_hdr *hdr)
+{
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	avtp_stream_hdr_decode(&hdr->stream, pdu, ntohl(pdu->subtype_data),
+						ntohl(pdu->packet_info));
+
+	return 0;
+}
+
+int avtp_tscf_pdu_pack(struct avtp_stream_pdu *pdu,
+					const struct avtp_tscf_hdr *hdr)
+{
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	avtp_stream_hdr_encode(pdu, &hdr->stream, AVTP_SUBTYPE_TSCF, 0, 0);
+	pdu->format_specific = 0;
+
+	return 0;
+}
+
+int avtp_ntscf_pdu_get(const struct avtp_ntscf_pdu *pdu,
+				enum avtp_ntscf_field field, uint64_t *val)
+{
+	if (!pdu || !val)
+		return -EINVAL;
+
+	return avtp_field_get(ntscf_fields, ARRAY_SIZE(ntscf_fields), pdu,
+								field, val);
+}
+
+int avtp_ntscf_pdu_set(struct avtp_ntscf_pdu *pdu,
+				enum avtp_ntscf_field field, uint64_t val)
+{
+	if (!pdu)
+		return -EINVAL;
+
+	return avtp_field_set(ntscf_fields, ARRAY_SIZE(ntscf_fields), pdu,
+								field, val);
+}
+
+int avtp_ntscf_pdu_init(struct avtp_ntscf_pdu *pdu)
+{
+	int res;
+
+	if (!pdu)
+		return -EINVAL;
+
+	memset(pdu, 0, sizeof(struct avtp_ntscf_pdu));
+
+	res = avtp_pdu_set((struct avtp_common_pdu *) pdu, AVTP_FIELD_SUBTYPE,
+							AVTP_SUBTYPE_NTSCF);
+	if (res < 0)
+		return res;
+
+	res = avtp_ntscf_pdu_set(pdu, AVTP_NTSCF_FIELD_SV, 1);
+	if (res < 0)
+		return res;
+
+	return 0;
+}
+
+int avtp_ntscf_pdu_unpack(const struct avtp_ntscf_pdu *pdu,
+						struct avtp_ntscf_hdr *hdr)
+{
+	uint32_t subtype_data;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	subtype_data = ntohl(pdu->subtype_data);
+
+	hdr->sv = BITMAP_GET_VALUE(subtype_data, MASK_SV, SHIFT_SV);
+	hdr->data_len = BITMAP_GET_VALUE(subtype_data, MASK_DATA_LEN,
+							SHIFT_DATA_LEN);
+	hdr->seq_num = BITMAP_GET_VALUE(subtype_data, MASK_SEQ_NUM, 0);
+	hdr->stream_id = be64toh(pdu->stream_id);
+
+	return 0;
+}
+
+int avtp_ntscf_pdu_pack(struct avtp_ntscf_pdu *pdu,
+					const struct avtp_ntscf_hdr *hdr)
+{
+	uint32_t subtype_data = 0;
+
+	if (!pdu || !hdr)
+		return -EINVAL;
+
+	BITMAP_SET_VALUE(subtype_data, (uint32_t) AVTP_SUBTYPE_NTSCF,
+						MASK_SUBTYPE, SHIFT_SUBTYPE);
+	BITMAP_SET_VALUE(subtype_data, hdr->sv, MASK_SV, SHIFT_SV);
+	BITMAP_SET_VALUE(subtype_data, (uint32_t) hdr->data_len,
+					MASK_DATA_LEN, SHIFT_DATA_LEN);
+	BITMAP_SET_VALUE(subtype_data, hdr->seq_num, MASK_SEQ_NUM, 0);
+
+	pdu->subtype_data = htonl(subtype_data);
+	pdu->stream_id = htobe64(hdr->stream_id);
+
+	return 0;
+}
@@ -27,10 +27,16 @@
 
 #pragma once
 
+#include <arpa/inet.h>
+#include <endian.h>
+#include <stdint.h>
+
 #define BIT(n)				(1ULL << n)
 
 #define BITMASK(len)			(BIT(len) - 1)
 
+#define ARRAY_SIZE(a)			(sizeof(a) / sizeof((a)[0]))
+
 /* Get value from the bits within 'bitmap' represented by 'mask'. The 'mask'
  * parameter must be a continuous bit mask (e.g. 0b00111000). This macro
  * doesn't work with non-continuous bit masks (e.g. 0b00101001).
@@ -44,7 +50,21 @@
 #define BITMAP_SET_VALUE(bitmap, val, mask, shift) \
 			(bitmap = (bitmap & ~mask) | ((val << shift) & mask))
 
+struct __una_u16 { uint16_t x; } __attribute__((packed));
 struct __una_u32 { uint32_t x; } __attribute__((packed));
+struct __una_u64 { uint64_t x; } __attribute__((packed));
+
+static inline uint16_t get_unaligned_be16(const void *p)
+{
+	const struct __una_u16 *ptr = (const struct __una_u16 *)p;
+	return ntohs(ptr->x);
+}
+
+static inline void put_unaligned_be16(uint16_t val, void *p)
+{
+	struct __una_u16 *ptr = (struct __una_u16 *)p;
+	ptr->x = htons(val);
+}
 
 static inline uint32_t get_unaligned_be32(const void *p)
 {
@@ -57,3 +77,15 @@ static inline void put_unaligned_be32(uint32_t val, void *p)
 	struct __una_u32 *ptr = (struct __una_u32 *)p;
 	ptr->x = htonl(val);
 }
+
+static inline uint64_t get_unaligned_be64(const void *p)
+{
+	const struct __una_u64 *ptr = (const struct __una_u64 *)p;
+	return be64toh(ptr->x);
+}
+
+static inline void put_unaligned_be64(uint64_t val, void *p)
+{
+	struct __una_u64 *ptr = (struct __una_u64 *)p;
+	ptr->x = htobe64(val);
+}
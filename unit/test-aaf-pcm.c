@@ -0,0 +1,711 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_inline.h"
+#include "avtp_stream_ctx.h"
+
+/* Odd sizes so vector kernels always have a scalar tail to handle. */
+#define CHANNELS		3
+#define FRAMES			37
+#define SAMPLES			(CHANNELS * FRAMES)
+
+/* More samples than internal conversion blocks hold. */
+#define LARGE_FRAMES		1001
+#define LARGE_SAMPLES		(CHANNELS * LARGE_FRAMES)
+
+static void init_hdr(struct avtp_aaf_hdr *hdr, uint8_t format,
+							uint8_t bit_depth)
+{
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->format = format;
+	hdr->bit_depth = bit_depth;
+	hdr->chan_per_frame = CHANNELS;
+}
+
+/* Stream context for an AAF stream carrying 'frames_per_pdu' 16-bit frames
+ * per PDU.
+ */
+static void init_ctx(struct avtp_stream_ctx *ctx, unsigned int frames_per_pdu,
+								uint8_t sp)
+{
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_data_len = frames_per_pdu * CHANNELS * 2,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = CHANNELS,
+		.bit_depth = 16,
+		.sp = sp,
+	};
+	struct avtp_stream_pdu tmpl;
+
+	assert_int_equal(avtp_aaf_pdu_pack(&tmpl, &hdr), 0);
+	assert_int_equal(avtp_stream_ctx_init(ctx, &tmpl, 48000), 0);
+}
+
+static void init_s32(int32_t *samples, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		samples[i] = (int32_t) (0x01234567u * (i + 1) + 0x89ABCDEFu);
+}
+
+static void init_s16(int16_t *samples, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		samples[i] = (int16_t) (0x1357u * (i + 1) + 0x9BDFu);
+}
+
+static void aaf_pcm_encode_null_hdr(void **state)
+{
+	int16_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 2];
+	int res;
+
+	res = avtp_aaf_pcm_encode(NULL, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_null_payload(void **state)
+{
+	int16_t samples[SAMPLES] = { 0 };
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_encode(&hdr, NULL, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_null_samples(void **state)
+{
+	uint8_t payload[SAMPLES * 2];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, NULL,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_invalid_format(void **state)
+{
+	int16_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 4];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_USER, 16);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_invalid_bit_depth(void **state)
+{
+	int16_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 4];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 24);
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+	assert_int_equal(res, -EINVAL);
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_24BIT, 0);
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+	assert_int_equal(res, -EINVAL);
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_FLOAT_32BIT, 24);
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_invalid_chan(void **state)
+{
+	int16_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 2];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+	hdr.chan_per_frame = 0;
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_invalid_type(void **state)
+{
+	int16_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 2];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+				AVTP_AAF_PCM_SAMPLE_FLOAT + 1, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_decode_null_payload(void **state)
+{
+	int16_t samples[SAMPLES];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_decode(&hdr, NULL, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_decode_null_samples(void **state)
+{
+	uint8_t payload[SAMPLES * 2] = { 0 };
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_decode(&hdr, payload, NULL,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_encode_s16_int16(void **state)
+{
+	int16_t samples[SAMPLES];
+	uint8_t payload[SAMPLES * 2 + 1];
+	struct avtp_aaf_hdr hdr;
+	size_t i;
+	int res;
+
+	init_s16(samples, SAMPLES);
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	/* Unaligned payload. */
+	res = avtp_aaf_pcm_encode(&hdr, payload + 1, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, SAMPLES * 2);
+	for (i = 0; i < SAMPLES; i++) {
+		uint16_t val = (uint16_t) samples[i];
+
+		assert_int_equal(payload[1 + i * 2], val >> 8);
+		assert_int_equal(payload[1 + i * 2 + 1], val & 0xFF);
+	}
+}
+
+static void aaf_pcm_encode_s32_int32(void **state)
+{
+	int32_t samples[SAMPLES];
+	uint8_t payload[SAMPLES * 4];
+	struct avtp_aaf_hdr hdr;
+	size_t i;
+	int res;
+
+	init_s32(samples, SAMPLES);
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_32BIT, 32);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S32, FRAMES);
+
+	assert_int_equal(res, SAMPLES * 4);
+	for (i = 0; i < SAMPLES; i++) {
+		uint32_t val = (uint32_t) samples[i];
+
+		assert_int_equal(payload[i * 4], val >> 24);
+		assert_int_equal(payload[i * 4 + 1], (val >> 16) & 0xFF);
+		assert_int_equal(payload[i * 4 + 2], (val >> 8) & 0xFF);
+		assert_int_equal(payload[i * 4 + 3], val & 0xFF);
+	}
+}
+
+static void aaf_pcm_encode_s32_int24(void **state)
+{
+	int32_t samples[LARGE_SAMPLES];
+	uint8_t payload[LARGE_SAMPLES * 3];
+	struct avtp_aaf_hdr hdr;
+	size_t i;
+	int res;
+
+	init_s32(samples, LARGE_SAMPLES);
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_24BIT, 24);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S32, LARGE_FRAMES);
+
+	assert_int_equal(res, LARGE_SAMPLES * 3);
+	for (i = 0; i < LARGE_SAMPLES; i++) {
+		uint32_t val = (uint32_t) samples[i];
+
+		assert_int_equal(payload[i * 3], val >> 24);
+		assert_int_equal(payload[i * 3 + 1], (val >> 16) & 0xFF);
+		assert_int_equal(payload[i * 3 + 2], (val >> 8) & 0xFF);
+	}
+}
+
+static void aaf_pcm_encode_s16_int24(void **state)
+{
+	int16_t samples[SAMPLES];
+	uint8_t payload[SAMPLES * 3];
+	struct avtp_aaf_hdr hdr;
+	size_t i;
+	int res;
+
+	init_s16(samples, SAMPLES);
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_24BIT, 24);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, SAMPLES * 3);
+	for (i = 0; i < SAMPLES; i++) {
+		uint16_t val = (uint16_t) samples[i];
+
+		assert_int_equal(payload[i * 3], val >> 8);
+		assert_int_equal(payload[i * 3 + 1], val & 0xFF);
+		assert_int_equal(payload[i * 3 + 2], 0);
+	}
+}
+
+static void aaf_pcm_encode_bit_depth(void **state)
+{
+	int32_t samples[SAMPLES];
+	uint8_t payload[SAMPLES * 4];
+	struct avtp_aaf_hdr hdr;
+	size_t i;
+	int res;
+
+	init_s32(samples, SAMPLES);
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_32BIT, 20);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S32, FRAMES);
+
+	/* Only the 20 most significant bits are meaningful, remaining ones
+	 * must be zero.
+	 */
+	assert_int_equal(res, SAMPLES * 4);
+	for (i = 0; i < SAMPLES; i++) {
+		uint32_t val = (uint32_t) samples[i] & 0xFFFFF000;
+
+		assert_int_equal(payload[i * 4], val >> 24);
+		assert_int_equal(payload[i * 4 + 1], (val >> 16) & 0xFF);
+		assert_int_equal(payload[i * 4 + 2], (val >> 8) & 0xFF);
+		assert_int_equal(payload[i * 4 + 3], 0);
+	}
+}
+
+static void aaf_pcm_encode_float_clip(void **state)
+{
+	const float samples[CHANNELS] = { 1.5f, -2.0f, 0.5f };
+	uint8_t payload[CHANNELS * 4];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_32BIT, 32);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_FLOAT, 1);
+
+	assert_int_equal(res, CHANNELS * 4);
+	assert_memory_equal(payload, "\x7F\xFF\xFF\xFF\x80\x00\x00\x00"
+					"\x40\x00\x00\x00", sizeof(payload));
+}
+
+static void aaf_pcm_encode_float_nan(void **state)
+{
+	float samples[SAMPLES];
+	uint8_t payload[SAMPLES * 4];
+	uint8_t zero[SAMPLES * 4] = { 0 };
+	struct avtp_aaf_hdr hdr;
+	size_t i;
+	int res;
+
+	for (i = 0; i < SAMPLES; i++)
+		samples[i] = NAN;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_32BIT, 32);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_FLOAT, FRAMES);
+
+	assert_int_equal(res, sizeof(payload));
+	assert_memory_equal(payload, zero, sizeof(payload));
+}
+
+static void aaf_pcm_encode_float_float(void **state)
+{
+	const float samples[CHANNELS] = { 1.0f, -0.5f, 0.25f };
+	uint8_t payload[CHANNELS * 4];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_FLOAT_32BIT, 32);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_FLOAT, 1);
+
+	assert_int_equal(res, CHANNELS * 4);
+	assert_memory_equal(payload, "\x3F\x80\x00\x00\xBF\x00\x00\x00"
+					"\x3E\x80\x00\x00", sizeof(payload));
+}
+
+static void aaf_pcm_round_trip(uint8_t format, uint8_t bit_depth)
+{
+	int32_t samples[LARGE_SAMPLES], decoded[LARGE_SAMPLES];
+	uint8_t payload[LARGE_SAMPLES * 4];
+	struct avtp_aaf_hdr hdr;
+	uint32_t mask;
+	size_t i;
+	int res;
+
+	init_s32(samples, LARGE_SAMPLES);
+	init_hdr(&hdr, format, bit_depth);
+
+	res = avtp_aaf_pcm_encode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S32, LARGE_FRAMES);
+	assert_true(res > 0);
+
+	res = avtp_aaf_pcm_decode(&hdr, payload, decoded,
+					AVTP_AAF_PCM_SAMPLE_S32, LARGE_FRAMES);
+	assert_true(res > 0);
+
+	mask = UINT32_MAX << (32 - bit_depth);
+	for (i = 0; i < LARGE_SAMPLES; i++)
+		assert_int_equal(decoded[i], (int32_t) (samples[i] & mask));
+}
+
+static void aaf_pcm_round_trip_int16(void **state)
+{
+	aaf_pcm_round_trip(AVTP_AAF_FORMAT_INT_16BIT, 16);
+}
+
+static void aaf_pcm_round_trip_int24(void **state)
+{
+	aaf_pcm_round_trip(AVTP_AAF_FORMAT_INT_24BIT, 24);
+}
+
+static void aaf_pcm_round_trip_int32(void **state)
+{
+	aaf_pcm_round_trip(AVTP_AAF_FORMAT_INT_32BIT, 32);
+}
+
+static void aaf_pcm_round_trip_int32_depth(void **state)
+{
+	aaf_pcm_round_trip(AVTP_AAF_FORMAT_INT_32BIT, 18);
+}
+
+static void aaf_pcm_decode_int24_s16(void **state)
+{
+	const uint8_t payload[CHANNELS * 3] = {
+		0x12, 0x34, 0x56, 0x80, 0x00, 0x01, 0xFF, 0xFF, 0xFF,
+	};
+	int16_t samples[CHANNELS];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_24BIT, 24);
+
+	res = avtp_aaf_pcm_decode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_S16, 1);
+
+	assert_int_equal(res, sizeof(payload));
+	assert_int_equal(samples[0], 0x1234);
+	assert_int_equal(samples[1], INT16_MIN);
+	assert_int_equal(samples[2], -1);
+}
+
+static void aaf_pcm_decode_int16_float(void **state)
+{
+	const uint8_t payload[CHANNELS * 2] = {
+		0x40, 0x00, 0x80, 0x00, 0x00, 0x00,
+	};
+	float samples[CHANNELS];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_decode(&hdr, payload, samples,
+					AVTP_AAF_PCM_SAMPLE_FLOAT, 1);
+
+	assert_int_equal(res, sizeof(payload));
+	assert_true(samples[0] == 0.5f);
+	assert_true(samples[1] == -1.0f);
+	assert_true(samples[2] == 0.0f);
+}
+
+static void aaf_pcm_planar_null_plane(void **state)
+{
+	int16_t plane[FRAMES] = { 0 };
+	const void *planes[CHANNELS] = { plane, NULL, plane };
+	uint8_t payload[SAMPLES * 2];
+	struct avtp_aaf_hdr hdr;
+	int res;
+
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_16BIT, 16);
+
+	res = avtp_aaf_pcm_encode_planar(&hdr, payload, planes,
+					AVTP_AAF_PCM_SAMPLE_S16, FRAMES);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pcm_planar(void **state)
+{
+	int16_t in[CHANNELS][LARGE_FRAMES], out[CHANNELS][LARGE_FRAMES];
+	const void *const in_planes[CHANNELS] = { in[0], in[1], in[2] };
+	void *const out_planes[CHANNELS] = { out[0], out[1], out[2] };
+	uint8_t payload[LARGE_SAMPLES * 3];
+	struct avtp_aaf_hdr hdr;
+	size_t f, ch;
+	int res;
+
+	init_s16(&in[0][0], LARGE_SAMPLES);
+	init_hdr(&hdr, AVTP_AAF_FORMAT_INT_24BIT, 24);
+
+	res = avtp_aaf_pcm_encode_planar(&hdr, payload, in_planes,
+					AVTP_AAF_PCM_SAMPLE_S16, LARGE_FRAMES);
+	assert_int_equal(res, LARGE_SAMPLES * 3);
+
+	/* Payload must hold interleaved samples. */
+	for (f = 0; f < LARGE_FRAMES; f++) {
+		for (ch = 0; ch < CHANNELS; ch++) {
+			uint16_t val = (uint16_t) in[ch][f];
+			size_t off = (f * CHANNELS + ch) * 3;
+
+			assert_int_equal(payload[off], val >> 8);
+			assert_int_equal(payload[off + 1], val & 0xFF);
+		}
+	}
+
+	res = avtp_aaf_pcm_decode_planar(&hdr, payload, out_planes,
+					AVTP_AAF_PCM_SAMPLE_S16, LARGE_FRAMES);
+	assert_int_equal(res, LARGE_SAMPLES * 3);
+	assert_memory_equal(in, out, sizeof(in));
+}
+
+static void aaf_aggregator_init_invalid(void **state)
+{
+	struct avtp_aaf_aggregator agg;
+	struct avtp_stream_ctx ctx;
+
+	init_ctx(&ctx, 6, AVTP_AAF_PCM_SP_NORMAL);
+
+	assert_int_equal(avtp_aaf_aggregator_init(NULL, &ctx,
+					AVTP_AAF_PCM_SAMPLE_S16), -EINVAL);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, NULL,
+					AVTP_AAF_PCM_SAMPLE_S16), -EINVAL);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, &ctx, -1), -EINVAL);
+
+	/* Stream data length must be a whole number of frames. */
+	avtp_stream_set_stream_data_len(&ctx.tmpl, 6 * CHANNELS * 2 + 1);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, &ctx,
+					AVTP_AAF_PCM_SAMPLE_S16), -EINVAL);
+
+	avtp_stream_set_stream_data_len(&ctx.tmpl, 0);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, &ctx,
+					AVTP_AAF_PCM_SAMPLE_S16), -EINVAL);
+}
+
+static void aaf_aggregator_next_null(void **state)
+{
+	struct avtp_aaf_aggregator agg;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu pdu;
+
+	init_ctx(&ctx, 6, AVTP_AAF_PCM_SP_NORMAL);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, &ctx,
+					AVTP_AAF_PCM_SAMPLE_S16), 0);
+
+	assert_int_equal(avtp_aaf_aggregator_start(NULL, NULL, 0), -EINVAL);
+	assert_int_equal(avtp_aaf_aggregator_start(&agg, NULL, 1), -EINVAL);
+	assert_int_equal(avtp_aaf_aggregator_next(NULL, &pdu), -EINVAL);
+	assert_int_equal(avtp_aaf_aggregator_next(&agg, NULL), -EINVAL);
+}
+
+static void aaf_aggregator(void **state)
+{
+	const unsigned int blocks[] = { 20, 10, 1, 5 };
+	uint8_t bufs[8][sizeof(struct avtp_stream_pdu) + 6 * CHANNELS * 2];
+	int16_t samples[SAMPLES], decoded[SAMPLES];
+	struct avtp_aaf_aggregator agg;
+	struct avtp_stream_ctx ctx;
+	struct avtp_aaf_hdr hdr;
+	unsigned int i, b, offset = 0, count = 0;
+	int res;
+
+	init_ctx(&ctx, 6, AVTP_AAF_PCM_SP_NORMAL);
+	assert_int_equal(avtp_stream_ctx_set_time(&ctx, 1000), 0);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, &ctx,
+					AVTP_AAF_PCM_SAMPLE_S16), 0);
+	init_s16(samples, SAMPLES);
+
+	/* 36 frames are handed over in blocks which don't match PDU size, so
+	 * 6 PDUs are emitted: 3 from the first block, 2 from the second, none
+	 * from the third and 1 from the last.
+	 */
+	for (b = 0; b < 4; b++) {
+		res = avtp_aaf_aggregator_start(&agg,
+					samples + offset * CHANNELS, blocks[b]);
+		assert_int_equal(res, 0);
+		offset += blocks[b];
+
+		while ((res = avtp_aaf_aggregator_next(&agg,
+				(struct avtp_stream_pdu *) bufs[count])) > 0)
+			count++;
+		assert_int_equal(res, 0);
+	}
+
+	assert_int_equal(count, 6);
+
+	for (i = 0; i < count; i++) {
+		struct avtp_stream_pdu *pdu;
+
+		pdu = (struct avtp_stream_pdu *) bufs[i];
+
+		assert_int_equal(avtp_aaf_pdu_unpack(pdu, &hdr), 0);
+		assert_int_equal(hdr.stream.seq_num, i);
+		assert_int_equal(hdr.stream.tv, 1);
+		/* 6 frames at 48 kHz are 125 us. */
+		assert_int_equal(hdr.stream.timestamp, 1000 + i * 125000);
+
+		res = avtp_aaf_pcm_decode(&hdr, pdu->avtp_payload,
+					decoded + i * 6 * CHANNELS,
+					AVTP_AAF_PCM_SAMPLE_S16, 6);
+		assert_int_equal(res, 6 * CHANNELS * 2);
+	}
+
+	assert_memory_equal(decoded, samples, 36 * CHANNELS * sizeof(int16_t));
+}
+
+static void aaf_aggregator_sparse(void **state)
+{
+	uint8_t buf[sizeof(struct avtp_stream_pdu) + CHANNELS * 2];
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) buf;
+	int16_t samples[SAMPLES];
+	struct avtp_aaf_aggregator agg;
+	struct avtp_stream_ctx ctx;
+	unsigned int i;
+
+	init_ctx(&ctx, 1, AVTP_AAF_PCM_SP_SPARSE);
+	assert_int_equal(avtp_aaf_aggregator_init(&agg, &ctx,
+					AVTP_AAF_PCM_SAMPLE_S16), 0);
+	init_s16(samples, SAMPLES);
+
+	assert_int_equal(avtp_aaf_aggregator_start(&agg, samples, FRAMES), 0);
+
+	/* Only one PDU out of every AVTP_AAF_PCM_SPARSE_INTERVAL carries a
+	 * timestamp.
+	 */
+	for (i = 0; i < FRAMES; i++) {
+		assert_int_equal(avtp_aaf_aggregator_next(&agg, pdu), 1);
+		assert_int_equal(avtp_stream_get_seq_num(pdu), i);
+		assert_int_equal(avtp_stream_get_tv(pdu),
+				i % AVTP_AAF_PCM_SPARSE_INTERVAL == 0);
+		assert_int_equal(avtp_aaf_get_sp(pdu), AVTP_AAF_PCM_SP_SPARSE);
+	}
+
+	assert_int_equal(avtp_aaf_aggregator_next(&agg, pdu), 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(aaf_pcm_encode_null_hdr),
+		cmocka_unit_test(aaf_pcm_encode_null_payload),
+		cmocka_unit_test(aaf_pcm_encode_null_samples),
+		cmocka_unit_test(aaf_pcm_encode_invalid_format),
+		cmocka_unit_test(aaf_pcm_encode_invalid_bit_depth),
+		cmocka_unit_test(aaf_pcm_encode_invalid_chan),
+		cmocka_unit_test(aaf_pcm_encode_invalid_type),
+		cmocka_unit_test(aaf_pcm_decode_null_payload),
+		cmocka_unit_test(aaf_pcm_decode_null_samples),
+		cmocka_unit_test(aaf_pcm_encode_s16_int16),
+		cmocka_unit_test(aaf_pcm_encode_s32_int32),
+		cmocka_unit_test(aaf_pcm_encode_s32_int24),
+		cmocka_unit_test(aaf_pcm_encode_s16_int24),
+		cmocka_unit_test(aaf_pcm_encode_bit_depth),
+		cmocka_unit_test(aaf_pcm_encode_float_clip),
+		cmocka_unit_test(aaf_pcm_encode_float_nan),
+		cmocka_unit_test(aaf_pcm_encode_float_float),
+		cmocka_unit_test(aaf_pcm_round_trip_int16),
+		cmocka_unit_test(aaf_pcm_round_trip_int24),
+		cmocka_unit_test(aaf_pcm_round_trip_int32),
+		cmocka_unit_test(aaf_pcm_round_trip_int32_depth),
+		cmocka_unit_test(aaf_pcm_decode_int24_s16),
+		cmocka_unit_test(aaf_pcm_decode_int16_float),
+		cmocka_unit_test(aaf_pcm_planar_null_plane),
+		cmocka_unit_test(aaf_pcm_planar),
+		cmocka_unit_test(aaf_aggregator_init_invalid),
+		cmocka_unit_test(aaf_aggregator_next_null),
+		cmocka_unit_test(aaf_aggregator),
+		cmocka_unit_test(aaf_aggregator_sparse),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
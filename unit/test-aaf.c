@@ -27,6 +27,7 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <string.h>
 #include <setjmp.h>
 #include <cmocka.h>
 #include <arpa/inet.h>
@@ -531,6 +532,153 @@ static void aaf_pdu_init(void **state)
 	assert_true(pdu.packet_info == 0);
 }
 
+static void aaf_pdu_unpack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_aaf_hdr hdr;
+
+	res = avtp_aaf_pdu_unpack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pdu_unpack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_aaf_pdu_unpack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pdu_unpack(void **state)
+{
+	int res;
+	struct avtp_aaf_hdr hdr;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	pdu.subtype_data = htonl(0x02895501);
+	pdu.stream_id = htobe64(0xAABBCCDDEEFF0001);
+	pdu.avtp_time = htonl(0x80C0FFEE);
+	pdu.format_specific = htonl(0x04500210);
+	pdu.packet_info = htonl(0x00041A00);
+
+	res = avtp_aaf_pdu_unpack(&pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.stream.sv == 1);
+	assert_true(hdr.stream.mr == 1);
+	assert_true(hdr.stream.tv == 1);
+	assert_true(hdr.stream.seq_num == 0x55);
+	assert_true(hdr.stream.tu == 1);
+	assert_true(hdr.stream.stream_id == 0xAABBCCDDEEFF0001);
+	assert_true(hdr.stream.timestamp == 0x80C0FFEE);
+	assert_true(hdr.stream.stream_data_len == 4);
+	assert_true(hdr.format == AVTP_AAF_FORMAT_INT_16BIT);
+	assert_true(hdr.nsr == AVTP_AAF_PCM_NSR_48KHZ);
+	assert_true(hdr.chan_per_frame == 2);
+	assert_true(hdr.bit_depth == 16);
+	assert_true(hdr.sp == AVTP_AAF_PCM_SP_SPARSE);
+	assert_true(hdr.evt == 0xA);
+}
+
+static void aaf_pdu_pack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_aaf_hdr hdr = { 0 };
+
+	res = avtp_aaf_pdu_pack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pdu_pack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_aaf_pdu_pack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void aaf_pdu_pack(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.mr = 1,
+			.tv = 1,
+			.seq_num = 0x55,
+			.tu = 1,
+			.stream_id = 0xAABBCCDDEEFF0001,
+			.timestamp = 0x80C0FFEE,
+			.stream_data_len = 4,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+		.sp = AVTP_AAF_PCM_SP_SPARSE,
+		.evt = 0xA,
+	};
+
+	memset(&pdu, 0xFF, sizeof(pdu));
+
+	res = avtp_aaf_pdu_pack(&pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x02895501);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0001);
+	assert_true(ntohl(pdu.avtp_time) == 0x80C0FFEE);
+	assert_true(ntohl(pdu.format_specific) == 0x04500210);
+	assert_true(ntohl(pdu.packet_info) == 0x00041A00);
+}
+
+static void aaf_pdu_pack_unpack(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+	struct avtp_aaf_hdr out, in = {
+		.stream = {
+			.sv = 1,
+			.seq_num = 0xFF,
+			.stream_id = 0x0123456789ABCDEF,
+			.timestamp = 0xFFFFFFFF,
+			.stream_data_len = 0xFFFF,
+		},
+		.format = AVTP_AAF_FORMAT_FLOAT_32BIT,
+		.nsr = AVTP_AAF_PCM_NSR_24KHZ,
+		.chan_per_frame = 0x3FF,
+		.bit_depth = 32,
+		.evt = 0xF,
+	};
+
+	res = avtp_aaf_pdu_pack(&pdu, &in);
+	assert_int_equal(res, 0);
+
+	res = avtp_aaf_pdu_unpack(&pdu, &out);
+	assert_int_equal(res, 0);
+
+	assert_true(out.stream.sv == in.stream.sv);
+	assert_true(out.stream.mr == in.stream.mr);
+	assert_true(out.stream.tv == in.stream.tv);
+	assert_true(out.stream.seq_num == in.stream.seq_num);
+	assert_true(out.stream.tu == in.stream.tu);
+	assert_true(out.stream.stream_id == in.stream.stream_id);
+	assert_true(out.stream.timestamp == in.stream.timestamp);
+	assert_true(out.stream.stream_data_len == in.stream.stream_data_len);
+	assert_true(out.format == in.format);
+	assert_true(out.nsr == in.nsr);
+	assert_true(out.chan_per_frame == in.chan_per_frame);
+	assert_true(out.bit_depth == in.bit_depth);
+	assert_true(out.sp == in.sp);
+	assert_true(out.evt == in.evt);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -569,6 +717,13 @@ int main(void)
 		cmocka_unit_test(aaf_set_field_evt),
 		cmocka_unit_test(aaf_pdu_init_null_pdu),
 		cmocka_unit_test(aaf_pdu_init),
+		cmocka_unit_test(aaf_pdu_unpack_null_pdu),
+		cmocka_unit_test(aaf_pdu_unpack_null_hdr),
+		cmocka_unit_test(aaf_pdu_unpack),
+		cmocka_unit_test(aaf_pdu_pack_null_pdu),
+		cmocka_unit_test(aaf_pdu_pack_null_hdr),
+		cmocka_unit_test(aaf_pdu_pack),
+		cmocka_unit_test(aaf_pdu_pack_unpack),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
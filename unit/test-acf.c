@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+#include <endian.h>
+
+#include "avtp.h"
+#include "avtp_acf.h"
+#include "avtp_tscf.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+
+static const uint8_t can_data[] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+static const struct avtp_acf_can_hdr can_hdr = {
+	.message_timestamp = 0x0102030405060708,
+	.can_identifier = 0x1BCDEF01,
+	.mtv = 1,
+	.eff = 1,
+	.can_bus_id = 0x11,
+};
+
+static void init_tscf_tmpl(struct avtp_stream_pdu *tmpl)
+{
+	struct avtp_tscf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = STREAM_ID,
+		},
+	};
+
+	assert_int_equal(avtp_tscf_pdu_pack(tmpl, &hdr), 0);
+}
+
+static void init_ntscf_tmpl(struct avtp_ntscf_pdu *tmpl)
+{
+	struct avtp_ntscf_hdr hdr = {
+		.sv = 1,
+		.stream_id = STREAM_ID,
+	};
+
+	assert_int_equal(avtp_ntscf_pdu_pack(tmpl, &hdr), 0);
+}
+
+static void acf_msg_get_field_null_msg(void **state)
+{
+	int res;
+	uint64_t val;
+
+	res = avtp_acf_msg_get(NULL, AVTP_ACF_FIELD_MSG_TYPE, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_msg_get_field_invalid_field(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_acf_msg msg = { 0 };
+
+	res = avtp_acf_msg_get(&msg, AVTP_ACF_FIELD_MAX, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_msg_get_field_msg_type(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_acf_msg msg = { 0 };
+
+	/* Set 'acf_msg_type' to AVTP_ACF_TYPE_LIN. */
+	msg.acf_msg_info = htonl(0x06000000);
+
+	res = avtp_acf_msg_get(&msg, AVTP_ACF_FIELD_MSG_TYPE, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == AVTP_ACF_TYPE_LIN);
+}
+
+static void acf_msg_set_field_msg_length(void **state)
+{
+	int res;
+	struct avtp_acf_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x0200FFFF);
+
+	res = avtp_acf_msg_set(&msg, AVTP_ACF_FIELD_MSG_LENGTH, 0x1FF);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(msg.acf_msg_info) == 0x03FFFFFF);
+}
+
+static void acf_can_get_field_not_can(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_acf_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x06000000);
+
+	res = avtp_acf_can_get(&msg, AVTP_ACF_CAN_FIELD_CAN_BUS_ID, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_can_get_field_can_identifier(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_acf_can_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x02000000);
+	msg.can_identifier = htonl(0xFFFFFFFF);
+
+	res = avtp_acf_can_get((struct avtp_acf_msg *) &msg,
+				AVTP_ACF_CAN_FIELD_CAN_IDENTIFIER, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 0x1FFFFFFF);
+}
+
+static void acf_can_brief_get_field_message_timestamp(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_acf_can_brief_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x04000000);
+
+	res = avtp_acf_can_get((struct avtp_acf_msg *) &msg,
+				AVTP_ACF_CAN_FIELD_MESSAGE_TIMESTAMP, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_can_brief_set_field_can_identifier(void **state)
+{
+	int res;
+	struct avtp_acf_can_brief_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x04000000);
+
+	res = avtp_acf_can_set((struct avtp_acf_msg *) &msg,
+				AVTP_ACF_CAN_FIELD_CAN_IDENTIFIER, 0x123);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(msg.can_identifier) == 0x123);
+}
+
+static void acf_can_set_field_fdf(void **state)
+{
+	int res;
+	struct avtp_acf_can_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x02000000);
+
+	res = avtp_acf_can_set((struct avtp_acf_msg *) &msg,
+				AVTP_ACF_CAN_FIELD_FDF, 1);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(msg.acf_msg_info) == 0x02000200);
+}
+
+static void acf_lin_get_field_lin_bus_id(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_acf_lin_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x06001500);
+
+	res = avtp_acf_lin_get((struct avtp_acf_msg *) &msg,
+				AVTP_ACF_LIN_FIELD_LIN_BUS_ID, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 0x15);
+}
+
+static void acf_lin_set_field_not_lin(void **state)
+{
+	int res;
+	struct avtp_acf_lin_msg msg = { 0 };
+
+	msg.acf_msg_info = htonl(0x02000000);
+
+	res = avtp_acf_lin_set((struct avtp_acf_msg *) &msg,
+				AVTP_ACF_LIN_FIELD_LIN_IDENTIFIER, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_can_pack_null_hdr(void **state)
+{
+	int res;
+	uint8_t buf[64];
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf), NULL,
+					can_data, sizeof(can_data));
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_can_pack_invalid_len(void **state)
+{
+	int res;
+	uint8_t buf[128], data[64] = { 0 };
+	struct avtp_acf_can_hdr hdr = can_hdr;
+
+	/* Classic CAN frames carry up to 8 bytes. */
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf), &hdr,
+								data, 12);
+	assert_int_equal(res, -EINVAL);
+
+	/* CAN FD frames carry only DLC defined lengths. */
+	hdr.fdf = 1;
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf), &hdr,
+								data, 13);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf), &hdr,
+								data, 64);
+	assert_int_equal(res, 16 + 64);
+}
+
+static void acf_can_pack_no_space(void **state)
+{
+	int res;
+	uint8_t buf[20];
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf),
+				&can_hdr, can_data, sizeof(can_data));
+
+	assert_int_equal(res, -ENOSPC);
+}
+
+static void acf_can_pack(void **state)
+{
+	int res;
+	uint8_t buf[32];
+	struct avtp_acf_can_msg *msg = (struct avtp_acf_can_msg *) buf;
+	static const uint8_t payload[] = {
+		0x11, 0x22, 0x33, 0x44, 0x55, 0x00, 0x00, 0x00,
+	};
+
+	memset(buf, 0xFF, sizeof(buf));
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf),
+				&can_hdr, can_data, sizeof(can_data));
+
+	/* 16-byte header plus 5 bytes of payload, padded to 24 bytes. */
+	assert_int_equal(res, 24);
+	assert_true(ntohl(msg->acf_msg_info) == 0x0206E811);
+	assert_true(be64toh(msg->message_timestamp) == 0x0102030405060708);
+	assert_true(ntohl(msg->can_identifier) == 0x1BCDEF01);
+	assert_memory_equal(msg->can_msg_payload, payload, sizeof(payload));
+}
+
+static void acf_can_pack_unpack_brief(void **state)
+{
+	int res;
+	uint8_t buf[16];
+	const uint8_t *data;
+	size_t data_len;
+	struct avtp_acf_can_hdr out;
+	struct avtp_acf_can_hdr hdr = can_hdr;
+
+	hdr.brief = 1;
+	hdr.message_timestamp = 0;
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf), &hdr,
+					can_data, sizeof(can_data));
+
+	assert_int_equal(res, 16);
+
+	res = avtp_acf_can_unpack((struct avtp_acf_msg *) buf, res, &out,
+							&data, &data_len);
+
+	assert_int_equal(res, 0);
+	assert_int_equal(out.brief, 1);
+	assert_true(out.message_timestamp == 0);
+	assert_true(out.can_identifier == 0x1BCDEF01);
+	assert_int_equal(out.mtv, 1);
+	assert_int_equal(out.rtr, 0);
+	assert_int_equal(out.eff, 1);
+	assert_int_equal(out.fdf, 0);
+	assert_int_equal(out.can_bus_id, 0x11);
+	assert_int_equal(data_len, sizeof(can_data));
+	assert_ptr_equal(data, buf + sizeof(struct avtp_acf_can_brief_msg));
+	assert_memory_equal(data, can_data, sizeof(can_data));
+}
+
+static void acf_can_unpack_truncated(void **state)
+{
+	int res;
+	uint8_t buf[24];
+	const uint8_t *data;
+	size_t data_len;
+	struct avtp_acf_can_hdr out;
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) buf, sizeof(buf),
+				&can_hdr, can_data, sizeof(can_data));
+	assert_int_equal(res, 24);
+
+	res = avtp_acf_can_unpack((struct avtp_acf_msg *) buf, 20, &out,
+							&data, &data_len);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_lin_pack_unpack(void **state)
+{
+	int res;
+	uint8_t buf[20];
+	const uint8_t *data;
+	size_t data_len;
+	struct avtp_acf_lin_hdr out;
+	struct avtp_acf_lin_hdr hdr = {
+		.message_timestamp = 0x0102030405060708,
+		.mtv = 1,
+		.lin_bus_id = 0x03,
+		.lin_identifier = 0x3C,
+	};
+	static const uint8_t lin_data[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x01 };
+
+	res = avtp_acf_lin_pack((struct avtp_acf_msg *) buf, sizeof(buf), &hdr,
+					lin_data, sizeof(lin_data));
+
+	/* 12-byte header plus 5 bytes of payload, padded to 20 bytes. */
+	assert_int_equal(res, 20);
+	assert_true(ntohl(*(uint32_t *) buf) == 0x0605E33C);
+
+	res = avtp_acf_lin_unpack((struct avtp_acf_msg *) buf, res, &out,
+							&data, &data_len);
+
+	assert_int_equal(res, 0);
+	assert_true(out.message_timestamp == 0x0102030405060708);
+	assert_int_equal(out.mtv, 1);
+	assert_int_equal(out.lin_bus_id, 0x03);
+	assert_int_equal(out.lin_identifier, 0x3C);
+	assert_int_equal(data_len, sizeof(lin_data));
+	assert_memory_equal(data, lin_data, sizeof(lin_data));
+}
+
+static void acf_lin_pack_invalid_len(void **state)
+{
+	int res;
+	uint8_t buf[32], data[9] = { 0 };
+	struct avtp_acf_lin_hdr hdr = { 0 };
+
+	res = avtp_acf_lin_pack((struct avtp_acf_msg *) buf, sizeof(buf), &hdr,
+							data, sizeof(data));
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_iter_init_invalid_subtype(void **state)
+{
+	int res;
+	struct avtp_acf_iter iter;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	avtp_pdu_set((struct avtp_common_pdu *) &pdu, AVTP_FIELD_SUBTYPE,
+							AVTP_SUBTYPE_AAF);
+
+	res = avtp_acf_iter_init(&iter, &pdu, sizeof(pdu));
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_iter_init_truncated(void **state)
+{
+	int res;
+	struct avtp_acf_iter iter;
+	uint8_t buf[sizeof(struct avtp_stream_pdu) + 16];
+
+	init_tscf_tmpl((struct avtp_stream_pdu *) buf);
+	avtp_tscf_pdu_set((struct avtp_stream_pdu *) buf,
+				AVTP_TSCF_FIELD_STREAM_DATA_LEN, 20);
+
+	res = avtp_acf_iter_init(&iter, buf, sizeof(buf));
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_iter_ntscf(void **state)
+{
+	int res, off;
+	size_t len;
+	struct avtp_acf_iter iter;
+	const struct avtp_acf_msg *msg;
+	struct avtp_acf_lin_hdr lin_hdr = { .lin_identifier = 0x10 };
+	uint8_t buf[sizeof(struct avtp_ntscf_pdu) + 64];
+
+	init_ntscf_tmpl((struct avtp_ntscf_pdu *) buf);
+
+	off = sizeof(struct avtp_ntscf_pdu);
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) (buf + off),
+					sizeof(buf) - off, &can_hdr,
+					can_data, sizeof(can_data));
+	assert_int_equal(res, 24);
+	off += res;
+	res = avtp_acf_lin_pack((struct avtp_acf_msg *) (buf + off),
+					sizeof(buf) - off, &lin_hdr, NULL, 0);
+	assert_int_equal(res, 12);
+	off += res;
+	avtp_ntscf_pdu_set((struct avtp_ntscf_pdu *) buf,
+				AVTP_NTSCF_FIELD_DATA_LEN, 24 + 12);
+
+	res = avtp_acf_iter_init(&iter, buf, off);
+	assert_int_equal(res, 0);
+
+	res = avtp_acf_iter_next(&iter, &msg, &len);
+	assert_int_equal(res, 1);
+	assert_ptr_equal(msg, buf + sizeof(struct avtp_ntscf_pdu));
+	assert_int_equal(len, 24);
+
+	res = avtp_acf_iter_next(&iter, &msg, &len);
+	assert_int_equal(res, 1);
+	assert_ptr_equal(msg, buf + sizeof(struct avtp_ntscf_pdu) + 24);
+	assert_int_equal(len, 12);
+
+	res = avtp_acf_iter_next(&iter, &msg, &len);
+	assert_int_equal(res, 0);
+}
+
+static void acf_iter_malformed(void **state)
+{
+	int res;
+	size_t len;
+	struct avtp_acf_iter iter;
+	const struct avtp_acf_msg *msg;
+	uint8_t buf[sizeof(struct avtp_ntscf_pdu) + 8] = { 0 };
+	struct avtp_acf_msg *bad = (struct avtp_acf_msg *)
+				(buf + sizeof(struct avtp_ntscf_pdu));
+
+	init_ntscf_tmpl((struct avtp_ntscf_pdu *) buf);
+	avtp_ntscf_pdu_set((struct avtp_ntscf_pdu *) buf,
+				AVTP_NTSCF_FIELD_DATA_LEN, 8);
+
+	/* Message claims 3 quadlets but only 2 are left in the PDU. */
+	bad->acf_msg_info = htonl(0x06030000);
+
+	res = avtp_acf_iter_init(&iter, buf, sizeof(buf));
+	assert_int_equal(res, 0);
+
+	res = avtp_acf_iter_next(&iter, &msg, &len);
+	assert_int_equal(res, -EINVAL);
+
+	/* Iteration stops after a malformed message. */
+	res = avtp_acf_iter_next(&iter, &msg, &len);
+	assert_int_equal(res, 0);
+}
+
+static void acf_agg_init_invalid_tmpl(void **state)
+{
+	int res;
+	struct avtp_acf_agg agg;
+	struct avtp_stream_pdu tmpl = { 0 };
+
+	res = avtp_acf_agg_init(&agg, &tmpl, 1500, 1000);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_agg_add_not_started(void **state)
+{
+	int res;
+	struct avtp_acf_agg agg;
+	struct avtp_stream_pdu tmpl;
+
+	init_tscf_tmpl(&tmpl);
+	res = avtp_acf_agg_init(&agg, &tmpl, 1500, 1000);
+	assert_int_equal(res, 0);
+
+	res = avtp_acf_agg_add_can(&agg, &can_hdr, can_data, sizeof(can_data),
+									0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_agg_tscf_full(void **state)
+{
+	int res, i;
+	struct avtp_acf_agg agg;
+	struct avtp_stream_pdu tmpl;
+	struct avtp_tscf_hdr hdr;
+	uint8_t buf[sizeof(struct avtp_stream_pdu) + 60];
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) buf;
+
+	init_tscf_tmpl(&tmpl);
+	res = avtp_acf_agg_init(&agg, &tmpl, sizeof(buf), 1000);
+	assert_int_equal(res, 0);
+
+	res = avtp_acf_agg_start(&agg, buf, sizeof(buf));
+	assert_int_equal(res, 0);
+
+	/* Room for two 24-byte messages out of 60 bytes. */
+	for (i = 0; i < 2; i++) {
+		res = avtp_acf_agg_add_can(&agg, &can_hdr, can_data,
+						sizeof(can_data), 100 + i);
+		assert_int_equal(res, 0);
+		assert_false(avtp_acf_agg_due(&agg, 100 + i));
+	}
+
+	res = avtp_acf_agg_add_can(&agg, &can_hdr, can_data, sizeof(can_data),
+									102);
+	assert_int_equal(res, -ENOSPC);
+	assert_true(avtp_acf_agg_due(&agg, 102));
+
+	res = avtp_acf_agg_finish(&agg, 0x80C0FFEE);
+	assert_int_equal(res, sizeof(struct avtp_stream_pdu) + 48);
+
+	res = avtp_tscf_pdu_unpack(pdu, &hdr);
+	assert_int_equal(res, 0);
+	assert_true(hdr.stream.stream_id == STREAM_ID);
+	assert_true(hdr.stream.timestamp == 0x80C0FFEE);
+	assert_int_equal(hdr.stream.stream_data_len, 48);
+	assert_int_equal(hdr.stream.seq_num, 0);
+	assert_int_equal(hdr.stream.tv, 1);
+
+	/* Nothing is due once PDU is finished. */
+	assert_false(avtp_acf_agg_due(&agg, 102));
+	res = avtp_acf_agg_finish(&agg, 0);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void acf_agg_ntscf_latency(void **state)
+{
+	int res;
+	struct avtp_acf_agg agg;
+	struct avtp_ntscf_pdu tmpl;
+	struct avtp_ntscf_hdr hdr;
+	struct avtp_acf_lin_hdr lin_hdr = { .lin_identifier = 0x10 };
+	uint8_t buf[256];
+	struct avtp_ntscf_pdu *pdu = (struct avtp_ntscf_pdu *) buf;
+
+	init_ntscf_tmpl(&tmpl);
+	res = avtp_acf_agg_init(&agg, &tmpl, sizeof(buf), 1000);
+	assert_int_equal(res, 0);
+
+	res = avtp_acf_agg_start(&agg, buf, sizeof(buf));
+	assert_int_equal(res, 0);
+
+	/* Empty PDUs are never due and emit nothing. */
+	assert_false(avtp_acf_agg_due(&agg, 5000));
+	assert_int_equal(avtp_acf_agg_finish(&agg, 0), 0);
+
+	res = avtp_acf_agg_add_lin(&agg, &lin_hdr, NULL, 0, 5000);
+	assert_int_equal(res, 0);
+	res = avtp_acf_agg_add_can(&agg, &can_hdr, can_data, sizeof(can_data),
+									5500);
+	assert_int_equal(res, 0);
+
+	/* Latency budget runs from the first message. */
+	assert_false(avtp_acf_agg_due(&agg, 5999));
+	assert_true(avtp_acf_agg_due(&agg, 6000));
+
+	res = avtp_acf_agg_finish(&agg, 0);
+	assert_int_equal(res, sizeof(struct avtp_ntscf_pdu) + 12 + 24);
+
+	res = avtp_ntscf_pdu_unpack(pdu, &hdr);
+	assert_int_equal(res, 0);
+	assert_true(hdr.stream_id == STREAM_ID);
+	assert_int_equal(hdr.data_len, 12 + 24);
+	assert_int_equal(hdr.seq_num, 0);
+
+	/* Sequence number is incremented on every PDU. */
+	res = avtp_acf_agg_start(&agg, buf, sizeof(buf));
+	assert_int_equal(res, 0);
+	res = avtp_acf_agg_add_lin(&agg, &lin_hdr, NULL, 0, 7000);
+	assert_int_equal(res, 0);
+	res = avtp_acf_agg_finish(&agg, 0);
+	assert_int_equal(res, sizeof(struct avtp_ntscf_pdu) + 12);
+	assert_int_equal(avtp_ntscf_pdu_unpack(pdu, &hdr), 0);
+	assert_int_equal(hdr.seq_num, 1);
+}
+
+static void acf_agg_add_forward(void **state)
+{
+	int res;
+	size_t len;
+	struct avtp_acf_agg agg;
+	struct avtp_acf_iter iter;
+	struct avtp_stream_pdu tmpl;
+	const struct avtp_acf_msg *msg;
+	uint8_t msg_buf[24], buf[128];
+
+	res = avtp_acf_can_pack((struct avtp_acf_msg *) msg_buf,
+					sizeof(msg_buf), &can_hdr, can_data,
+					sizeof(can_data));
+	assert_int_equal(res, 24);
+
+	init_tscf_tmpl(&tmpl);
+	res = avtp_acf_agg_init(&agg, &tmpl, sizeof(buf), 1000);
+	assert_int_equal(res, 0);
+	res = avtp_acf_agg_start(&agg, buf, sizeof(buf));
+	assert_int_equal(res, 0);
+
+	/* Length must match 'acf_msg_length'. */
+	res = avtp_acf_agg_add(&agg, (struct avtp_acf_msg *) msg_buf, 20, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_acf_agg_add(&agg, (struct avtp_acf_msg *) msg_buf, 24, 0);
+	assert_int_equal(res, 0);
+
+	res = avtp_acf_agg_finish(&agg, 0);
+	assert_int_equal(res, sizeof(struct avtp_stream_pdu) + 24);
+
+	res = avtp_acf_iter_init(&iter, buf, res);
+	assert_int_equal(res, 0);
+	res = avtp_acf_iter_next(&iter, &msg, &len);
+	assert_int_equal(res, 1);
+	assert_int_equal(len, 24);
+	assert_memory_equal(msg, msg_buf, sizeof(msg_buf));
+}
+
+static void acf_agg_add_too_big(void **state)
+{
+	int res;
+	struct avtp_acf_agg agg;
+	struct avtp_stream_pdu tmpl;
+	uint8_t buf[sizeof(struct avtp_stream_pdu) + 20];
+
+	init_tscf_tmpl(&tmpl);
+	res = avtp_acf_agg_init(&agg, &tmpl, sizeof(buf), 1000);
+	assert_int_equal(res, 0);
+	res = avtp_acf_agg_start(&agg, buf, sizeof(buf));
+	assert_int_equal(res, 0);
+
+	/* A message which doesn't fit in an empty PDU is rejected. */
+	res = avtp_acf_agg_add_can(&agg, &can_hdr, can_data, sizeof(can_data),
+									0);
+	assert_int_equal(res, -EINVAL);
+	assert_false(avtp_acf_agg_due(&agg, 0));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(acf_msg_get_field_null_msg),
+		cmocka_unit_test(acf_msg_get_field_invalid_field),
+		cmocka_unit_test(acf_msg_get_field_msg_type),
+		cmocka_unit_test(acf_msg_set_field_msg_length),
+		cmocka_unit_test(acf_can_get_field_not_can),
+		cmocka_unit_test(acf_can_get_field_can_identifier),
+		cmocka_unit_test(acf_can_brief_get_field_message_timestamp),
+		cmocka_unit_test(acf_can_brief_set_field_can_identifier),
+		cmocka_unit_test(acf_can_set_field_fdf),
+		cmocka_unit_test(acf_lin_get_field_lin_bus_id),
+		cmocka_unit_test(acf_lin_set_field_not_lin),
+		cmocka_unit_test(acf_can_pack_null_hdr),
+		cmocka_unit_test(acf_can_pack_invalid_len),
+		cmocka_unit_test(acf_can_pack_no_space),
+		cmocka_unit_test(acf_can_pack),
+		cmocka_unit_test(acf_can_pack_unpack_brief),
+		cmocka_unit_test(acf_can_unpack_truncated),
+		cmocka_unit_test(acf_lin_pack_unpack),
+		cmocka_unit_test(acf_lin_pack_invalid_len),
+		cmocka_unit_test(acf_iter_init_invalid_subtype),
+		cmocka_unit_test(acf_iter_init_truncated),
+		cmocka_unit_test(acf_iter_ntscf),
+		cmocka_unit_test(acf_iter_malformed),
+		cmocka_unit_test(acf_agg_init_invalid_tmpl),
+		cmocka_unit_test(acf_agg_add_not_started),
+		cmocka_unit_test(acf_agg_tscf_full),
+		cmocka_unit_test(acf_agg_ntscf_latency),
+		cmocka_unit_test(acf_agg_add_forward),
+		cmocka_unit_test(acf_agg_add_too_big),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <alloca.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_classifier.h"
+#include "avtp_inline.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define DATA_LEN		4
+#define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
+#define NUM_STREAMS		100
+
+static void init_expected(struct avtp_stream_pdu *pdu, uint64_t stream_id)
+{
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = stream_id,
+			.stream_data_len = DATA_LEN,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+	};
+
+	avtp_aaf_pdu_pack(pdu, &hdr);
+}
+
+static void init_mask(struct avtp_stream_pdu *mask)
+{
+	memset(mask, 0, sizeof(*mask));
+	avtp_common_set_subtype((struct avtp_common_pdu *) mask, 0xFF);
+	avtp_common_set_version((struct avtp_common_pdu *) mask, 0x7);
+	avtp_stream_set_sv(mask, 1);
+	avtp_stream_set_tv(mask, 1);
+	avtp_aaf_set_format(mask, 0xFF);
+	avtp_aaf_set_nsr(mask, 0xF);
+	avtp_aaf_set_chan_per_frame(mask, 0x3FF);
+	avtp_aaf_set_bit_depth(mask, 0xFF);
+}
+
+static void classifier_create_null(void **state)
+{
+	int res;
+
+	res = avtp_classifier_create(NULL, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void classifier_create_zero_streams(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+
+	res = avtp_classifier_create(&cls, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void classifier_add_null_cls(void **state)
+{
+	int res;
+	struct avtp_stream_pdu expected;
+
+	init_expected(&expected, STREAM_ID);
+
+	res = avtp_classifier_add(NULL, &expected, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void classifier_add_null_expected(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+
+	res = avtp_classifier_create(&cls, 1);
+	assert_int_equal(res, 0);
+
+	res = avtp_classifier_add(cls, NULL, NULL);
+
+	assert_int_equal(res, -EINVAL);
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_add_duplicated(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu expected;
+
+	init_expected(&expected, STREAM_ID);
+
+	res = avtp_classifier_create(&cls, 2);
+	assert_int_equal(res, 0);
+
+	res = avtp_classifier_add(cls, &expected, NULL);
+	assert_int_equal(res, 0);
+
+	res = avtp_classifier_add(cls, &expected, NULL);
+
+	assert_int_equal(res, -EEXIST);
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_add_full(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu expected;
+
+	res = avtp_classifier_create(&cls, 1);
+	assert_int_equal(res, 0);
+
+	init_expected(&expected, STREAM_ID);
+	res = avtp_classifier_add(cls, &expected, NULL);
+	assert_int_equal(res, 0);
+
+	init_expected(&expected, STREAM_ID + 1);
+	res = avtp_classifier_add(cls, &expected, NULL);
+
+	assert_int_equal(res, -ENOSPC);
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_classify_null_args(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu pdu;
+	const struct avtp_stream_pdu *pdus[] = { &pdu };
+	size_t lens[] = { sizeof(pdu) };
+	struct avtp_classifier_result results[1];
+
+	res = avtp_classifier_create(&cls, 1);
+	assert_int_equal(res, 0);
+
+	res = avtp_classifier_classify(NULL, pdus, lens, 1, results);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_classifier_classify(cls, NULL, lens, 1, results);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_classifier_classify(cls, pdus, NULL, 1, results);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 1, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_classify(void **state)
+{
+	int res, s1, s2;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu expected, mask;
+	struct avtp_stream_pdu *p[6];
+	const struct avtp_stream_pdu *pdus[6];
+	size_t lens[6];
+	struct avtp_classifier_result results[6];
+	int i;
+
+	res = avtp_classifier_create(&cls, 2);
+	assert_int_equal(res, 0);
+
+	init_mask(&mask);
+	init_expected(&expected, STREAM_ID);
+	s1 = avtp_classifier_add(cls, &expected, &mask);
+	assert_true(s1 >= 0);
+	init_expected(&expected, STREAM_ID + 1);
+	s2 = avtp_classifier_add(cls, &expected, &mask);
+	assert_true(s2 >= 0);
+	assert_true(s1 != s2);
+
+	for (i = 0; i < 6; i++) {
+		p[i] = alloca(PDU_SIZE);
+		pdus[i] = p[i];
+		lens[i] = PDU_SIZE;
+	}
+
+	/* In order packets from both streams. */
+	init_expected(p[0], STREAM_ID);
+	avtp_stream_set_seq_num(p[0], 10);
+	init_expected(p[1], STREAM_ID + 1);
+	avtp_stream_set_seq_num(p[1], 200);
+	init_expected(p[2], STREAM_ID);
+	avtp_stream_set_seq_num(p[2], 11);
+	/* Two packets lost from stream 2, which also wraps around. */
+	init_expected(p[3], STREAM_ID + 1);
+	avtp_stream_set_seq_num(p[3], 203);
+	/* Format mismatch. */
+	init_expected(p[4], STREAM_ID);
+	avtp_stream_set_seq_num(p[4], 12);
+	avtp_aaf_set_nsr(p[4], AVTP_AAF_PCM_NSR_44_1KHZ);
+	/* Unknown stream. */
+	init_expected(p[5], STREAM_ID + 2);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 6, results);
+
+	assert_int_equal(res, 4);
+	assert_int_equal(results[0].stream, s1);
+	assert_int_equal(results[0].verdict, AVTP_CLASSIFIER_PASS);
+	assert_int_equal(results[1].stream, s2);
+	assert_int_equal(results[1].verdict, AVTP_CLASSIFIER_PASS);
+	assert_int_equal(results[2].stream, s1);
+	assert_int_equal(results[2].verdict, AVTP_CLASSIFIER_PASS);
+	assert_int_equal(results[3].stream, s2);
+	assert_int_equal(results[3].verdict, AVTP_CLASSIFIER_SEQ_GAP);
+	assert_int_equal(results[3].lost, 2);
+	assert_int_equal(results[4].stream, s1);
+	assert_int_equal(results[4].verdict, AVTP_CLASSIFIER_FAIL);
+	assert_int_equal(results[5].stream, -1);
+	assert_int_equal(results[5].verdict, AVTP_CLASSIFIER_UNKNOWN);
+
+	/* Failed packet doesn't update sequence number tracking. */
+	init_expected(p[0], STREAM_ID);
+	avtp_stream_set_seq_num(p[0], 12);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 1, results);
+
+	assert_int_equal(res, 1);
+	assert_int_equal(results[0].verdict, AVTP_CLASSIFIER_PASS);
+
+	/* Duplicate and reordered packets neither report a gap nor move
+	 * tracking backwards.
+	 */
+	init_expected(p[0], STREAM_ID);
+	avtp_stream_set_seq_num(p[0], 12);
+	init_expected(p[1], STREAM_ID);
+	avtp_stream_set_seq_num(p[1], 10);
+	init_expected(p[2], STREAM_ID);
+	avtp_stream_set_seq_num(p[2], 13);
+	init_expected(p[3], STREAM_ID + 1);
+	avtp_stream_set_seq_num(p[3], 204);
+	init_expected(p[4], STREAM_ID + 1);
+	avtp_stream_set_seq_num(p[4], 150);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 5, results);
+
+	assert_int_equal(res, 5);
+	assert_int_equal(results[0].verdict, AVTP_CLASSIFIER_SEQ_OLD);
+	assert_int_equal(results[1].verdict, AVTP_CLASSIFIER_SEQ_OLD);
+	assert_int_equal(results[2].verdict, AVTP_CLASSIFIER_PASS);
+	assert_int_equal(results[3].verdict, AVTP_CLASSIFIER_PASS);
+	assert_int_equal(results[4].verdict, AVTP_CLASSIFIER_SEQ_OLD);
+
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_classify_truncated(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
+	const struct avtp_stream_pdu *pdus[] = { pdu, pdu, NULL };
+	size_t lens[] = { PDU_SIZE - 1, sizeof(*pdu) - 1, PDU_SIZE };
+	struct avtp_classifier_result results[3];
+
+	res = avtp_classifier_create(&cls, 1);
+	assert_int_equal(res, 0);
+
+	init_expected(pdu, STREAM_ID);
+	res = avtp_classifier_add(cls, pdu, NULL);
+	assert_int_equal(res, 0);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 3, results);
+
+	assert_int_equal(res, 0);
+	assert_int_equal(results[0].stream, 0);
+	assert_int_equal(results[0].verdict, AVTP_CLASSIFIER_FAIL);
+	assert_int_equal(results[1].stream, -1);
+	assert_int_equal(results[1].verdict, AVTP_CLASSIFIER_FAIL);
+	assert_int_equal(results[2].stream, -1);
+	assert_int_equal(results[2].verdict, AVTP_CLASSIFIER_FAIL);
+
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_classify_default_mask(void **state)
+{
+	int res;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu *pdu = alloca(PDU_SIZE);
+	const struct avtp_stream_pdu *pdus[] = { pdu };
+	size_t lens[] = { PDU_SIZE };
+	struct avtp_classifier_result results[1];
+
+	res = avtp_classifier_create(&cls, 1);
+	assert_int_equal(res, 0);
+
+	init_expected(pdu, STREAM_ID);
+	res = avtp_classifier_add(cls, pdu, NULL);
+	assert_int_equal(res, 0);
+
+	/* Format fields are not compared by default. */
+	avtp_aaf_set_nsr(pdu, AVTP_AAF_PCM_NSR_44_1KHZ);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 1, results);
+
+	assert_int_equal(res, 1);
+	assert_int_equal(results[0].verdict, AVTP_CLASSIFIER_PASS);
+
+	/* Subtype is. */
+	avtp_common_set_subtype((struct avtp_common_pdu *) pdu,
+							AVTP_SUBTYPE_CVF);
+
+	res = avtp_classifier_classify(cls, pdus, lens, 1, results);
+
+	assert_int_equal(res, 0);
+	assert_int_equal(results[0].verdict, AVTP_CLASSIFIER_FAIL);
+
+	avtp_classifier_destroy(cls);
+}
+
+static void classifier_classify_many_streams(void **state)
+{
+	int res, handles[NUM_STREAMS];
+	unsigned int i;
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu *p[NUM_STREAMS];
+	const struct avtp_stream_pdu *pdus[NUM_STREAMS];
+	size_t lens[NUM_STREAMS];
+	struct avtp_classifier_result results[NUM_STREAMS];
+
+	res = avtp_classifier_create(&cls, NUM_STREAMS);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < NUM_STREAMS; i++) {
+		p[i] = alloca(PDU_SIZE);
+		init_expected(p[i], STREAM_ID + (i << 16));
+		handles[i] = avtp_classifier_add(cls, p[i], NULL);
+		assert_true(handles[i] >= 0);
+
+		pdus[NUM_STREAMS - i - 1] = p[i];
+		lens[i] = PDU_SIZE;
+	}
+
+	res = avtp_classifier_classify(cls, pdus, lens, NUM_STREAMS,
+								results);
+
+	assert_int_equal(res, NUM_STREAMS);
+	for (i = 0; i < NUM_STREAMS; i++) {
+		unsigned int j = NUM_STREAMS - i - 1;
+
+		assert_int_equal(results[j].stream, handles[i]);
+		assert_int_equal(results[j].verdict, AVTP_CLASSIFIER_PASS);
+	}
+
+	avtp_classifier_destroy(cls);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(classifier_create_null),
+		cmocka_unit_test(classifier_create_zero_streams),
+		cmocka_unit_test(classifier_add_null_cls),
+		cmocka_unit_test(classifier_add_null_expected),
+		cmocka_unit_test(classifier_add_duplicated),
+		cmocka_unit_test(classifier_add_full),
+		cmocka_unit_test(classifier_classify_null_args),
+		cmocka_unit_test(classifier_classify),
+		cmocka_unit_test(classifier_classify_truncated),
+		cmocka_unit_test(classifier_classify_default_mask),
+		cmocka_unit_test(classifier_classify_many_streams),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
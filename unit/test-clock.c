@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <time.h>
+
+#include "avtp_clock.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+#define NSEC_PER_MSEC		1000000ULL
+
+static uint64_t read_clock(clockid_t clockid)
+{
+	struct timespec ts;
+
+	clock_gettime(clockid, &ts);
+
+	return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static void clock_create_null(void **state)
+{
+	int res;
+
+	res = avtp_clock_create(NULL, CLOCK_TAI, NSEC_PER_MSEC);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void clock_create_invalid_clockid(void **state)
+{
+	struct avtp_clock *clk;
+	int res;
+
+	/* No PHC is ever open as fd 1000. */
+	res = avtp_clock_create(&clk, AVTP_CLOCK_PHC(1000), NSEC_PER_MSEC);
+
+	assert_true(res < 0);
+}
+
+static void clock_now_null(void **state)
+{
+	struct avtp_clock *clk;
+	uint64_t now;
+	int res;
+
+	res = avtp_clock_create(&clk, CLOCK_TAI, NSEC_PER_MSEC);
+	assert_int_equal(res, 0);
+
+	res = avtp_clock_now(NULL, &now);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_clock_now(clk, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_clock_destroy(clk);
+}
+
+static void clock_now_no_resync_interval(void **state)
+{
+	struct avtp_clock *clk;
+	uint64_t before, now, after;
+	int res;
+
+	res = avtp_clock_create(&clk, CLOCK_TAI, 0);
+	assert_int_equal(res, 0);
+
+	before = read_clock(CLOCK_TAI);
+	res = avtp_clock_now(clk, &now);
+	after = read_clock(CLOCK_TAI);
+
+	assert_int_equal(res, 0);
+	assert_true(now >= before);
+	assert_true(now <= after);
+
+	avtp_clock_destroy(clk);
+}
+
+/* Extrapolated time should track the reference clock closely, across
+ * several resyncs.
+ */
+static void clock_now_extrapolated(void **state)
+{
+	struct avtp_clock *clk;
+	uint64_t before, now, after;
+	int i, res;
+
+	res = avtp_clock_create(&clk, CLOCK_TAI, 5 * NSEC_PER_MSEC);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < 50; i++) {
+		struct timespec sleep = { .tv_nsec = NSEC_PER_MSEC };
+
+		before = read_clock(CLOCK_TAI);
+		res = avtp_clock_now(clk, &now);
+		after = read_clock(CLOCK_TAI);
+
+		assert_int_equal(res, 0);
+		/* Allow for some extrapolation error, which can't be known
+		 * beforehand since CLOCK_TAI may be slewed.
+		 */
+		assert_true(now + 50000 >= before);
+		assert_true(now <= after + 50000);
+
+		nanosleep(&sleep, NULL);
+	}
+
+	avtp_clock_destroy(clk);
+}
+
+static void clock_unwrap_invalid(void **state)
+{
+	uint64_t full;
+	int res;
+
+	res = avtp_clock_unwrap(0, 0, 32, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_clock_unwrap(0, 0, 0, &full);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_clock_unwrap(0, 0, 64, &full);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void clock_unwrap_32bit(void **state)
+{
+	const uint64_t ref = 0x1234FFFFFF00ULL;
+	uint64_t full;
+	int res;
+
+	/* Future time, across a wraparound of the lower 32 bits. */
+	res = avtp_clock_unwrap(ref, 0x00000100, 32, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == 0x123500000100ULL);
+
+	/* Past time, e.g. a late PDU. */
+	res = avtp_clock_unwrap(ref, 0xFFFFF000, 32, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == 0x1234FFFFF000ULL);
+
+	/* Just below half the window ahead. */
+	res = avtp_clock_unwrap(ref, (uint32_t) (ref + 0x7FFFFFFF), 32, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == ref + 0x7FFFFFFF);
+
+	/* Half the window behind. */
+	res = avtp_clock_unwrap(ref, (uint32_t) (ref - 0x80000000), 32, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == ref - 0x80000000);
+
+	/* Upper bits of the truncated time are ignored. */
+	res = avtp_clock_unwrap(ref, 0xAB00000100ULL, 32, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == 0x123500000100ULL);
+}
+
+/* A 40-bit time reconstructs presentation times far beyond what 32 bits
+ * allow, e.g. with max transit times of several seconds.
+ */
+static void clock_unwrap_40bit(void **state)
+{
+	const uint64_t ref = 0x12FFFFFFFF00ULL;
+	uint64_t full;
+	int res;
+
+	res = avtp_clock_unwrap(ref, (ref + 5 * NSEC_PER_SEC) & 0xFFFFFFFFFF,
+								40, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == ref + 5 * NSEC_PER_SEC);
+
+	res = avtp_clock_unwrap(ref, (ref - 5 * NSEC_PER_SEC) & 0xFFFFFFFFFF,
+								40, &full);
+	assert_int_equal(res, 0);
+	assert_true(full == ref - 5 * NSEC_PER_SEC);
+}
+
+static void clock_unwrap_burst(void **state)
+{
+	struct avtp_clock *clk;
+	uint32_t avtp_times[4];
+	uint64_t times[4], now;
+	int i, res;
+
+	res = avtp_clock_create(&clk, CLOCK_TAI, NSEC_PER_SEC);
+	assert_int_equal(res, 0);
+
+	now = read_clock(CLOCK_TAI);
+	avtp_times[0] = now + 2 * NSEC_PER_MSEC;
+	avtp_times[1] = now - 2 * NSEC_PER_MSEC;
+	avtp_times[2] = now + NSEC_PER_SEC;
+	avtp_times[3] = now - NSEC_PER_SEC;
+
+	res = avtp_clock_unwrap_burst(clk, avtp_times, times, 4);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < 4; i++) {
+		int64_t expected = (int32_t) (avtp_times[i] - (uint32_t) now);
+		int64_t got = times[i] - now;
+
+		assert_int_equal((uint32_t) times[i], avtp_times[i]);
+		/* 'now' from the clock object is slightly later. */
+		assert_true(got - expected < 100 * NSEC_PER_MSEC);
+		assert_true(expected - got < 100 * NSEC_PER_MSEC);
+	}
+
+	res = avtp_clock_unwrap_burst(clk, NULL, times, 4);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_clock_unwrap_burst(clk, avtp_times, NULL, 4);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_clock_unwrap_burst(NULL, avtp_times, times, 4);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_clock_destroy(clk);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(clock_create_null),
+		cmocka_unit_test(clock_create_invalid_clockid),
+		cmocka_unit_test(clock_now_null),
+		cmocka_unit_test(clock_now_no_resync_interval),
+		cmocka_unit_test(clock_now_extrapolated),
+		cmocka_unit_test(clock_unwrap_invalid),
+		cmocka_unit_test(clock_unwrap_32bit),
+		cmocka_unit_test(clock_unwrap_40bit),
+		cmocka_unit_test(clock_unwrap_burst),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp_cpu.h"
+
+/* Kernel tables are opaque to the dispatcher, any distinct objects do. */
+static const int scalar_ops, low_ops, high_ops, above_ops;
+
+/* Variants whose self-test fails, variants checked and reference seen. */
+struct check_record {
+	const void *fail[2];
+	const void *checked[4];
+	unsigned int count;
+	const void *ref;
+};
+
+static struct check_record rec;
+
+static int record_check(const void *ops, const void *ref)
+{
+	assert_true(rec.count < 4);
+
+	rec.checked[rec.count++] = ops;
+	rec.ref = ref;
+
+	return ops == rec.fail[0] || ops == rec.fail[1];
+}
+
+static void cpu_get_level(void **state)
+{
+	enum avtp_cpu_level level = avtp_cpu_get_level();
+
+	assert_true(level <= AVTP_CPU_MAX_LEVEL);
+	assert_int_equal(avtp_cpu_get_level(), level);
+
+#if !defined(HAVE_X86_KERNELS) && !defined(HAVE_NEON_KERNELS)
+	assert_int_equal(level, AVTP_CPU_SCALAR);
+#endif
+}
+
+static void cpu_select_scalar_only(void **state)
+{
+	const struct avtp_cpu_variant variants[] = {
+		{ AVTP_CPU_SCALAR, &scalar_ops },
+	};
+
+	memset(&rec, 0, sizeof(rec));
+
+	assert_ptr_equal(avtp_cpu_select(variants, 1, record_check),
+								&scalar_ops);
+	assert_int_equal(rec.count, 0);
+}
+
+static void cpu_select_highest(void **state)
+{
+	enum avtp_cpu_level level = avtp_cpu_get_level();
+	const struct avtp_cpu_variant variants[] = {
+		{ AVTP_CPU_SCALAR, &scalar_ops },
+		{ level, &low_ops },
+		{ level, &high_ops },
+		{ level + 1, &above_ops },
+	};
+
+	if (level == AVTP_CPU_SCALAR)
+		skip();
+
+	memset(&rec, 0, sizeof(rec));
+
+	/* Variants above the CPU level are never checked. */
+	assert_ptr_equal(avtp_cpu_select(variants, 4, record_check),
+								&high_ops);
+	assert_int_equal(rec.count, 1);
+	assert_ptr_equal(rec.checked[0], &high_ops);
+	assert_ptr_equal(rec.ref, &scalar_ops);
+}
+
+static void cpu_select_check_fail(void **state)
+{
+	enum avtp_cpu_level level = avtp_cpu_get_level();
+	const struct avtp_cpu_variant variants[] = {
+		{ AVTP_CPU_SCALAR, &scalar_ops },
+		{ level, &low_ops },
+		{ level, &high_ops },
+	};
+
+	if (level == AVTP_CPU_SCALAR)
+		skip();
+
+	memset(&rec, 0, sizeof(rec));
+	rec.fail[0] = &high_ops;
+
+	assert_ptr_equal(avtp_cpu_select(variants, 3, record_check),
+								&low_ops);
+	assert_int_equal(rec.count, 2);
+
+	/* Scalar variant is the fallback, and it is not checked. */
+	memset(&rec, 0, sizeof(rec));
+	rec.fail[0] = &high_ops;
+	rec.fail[1] = &low_ops;
+
+	assert_ptr_equal(avtp_cpu_select(variants, 3, record_check),
+								&scalar_ops);
+	assert_int_equal(rec.count, 2);
+}
+
+static void cpu_fill_pattern(void **state)
+{
+	uint8_t buf[256];
+	unsigned int i, j;
+
+	avtp_cpu_fill_pattern(buf, sizeof(buf));
+
+	for (i = 0; i < sizeof(buf); i++) {
+		for (j = i + 1; j < sizeof(buf); j++)
+			assert_int_not_equal(buf[i], buf[j]);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(cpu_get_level),
+		cmocka_unit_test(cpu_select_scalar_only),
+		cmocka_unit_test(cpu_select_highest),
+		cmocka_unit_test(cpu_select_check_fail),
+		cmocka_unit_test(cpu_fill_pattern),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <endian.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+
+/* Values based on Spec 1722 Table 28 recommendation. */
+#define SAMPLE_RATE		48000
+#define TIMESTAMP_INTERVAL	160
+#define TIMESTAMPS_PER_PKT	6
+#define PDU_SIZE		(sizeof(struct avtp_crf_pdu) + \
+					TIMESTAMPS_PER_PKT * sizeof(uint64_t))
+
+#define NSEC_PER_SEC		1000000000ULL
+#define SAMPLE_PERIOD		((double) NSEC_PER_SEC / SAMPLE_RATE)
+#define TS_PERIOD		(SAMPLE_PERIOD * TIMESTAMP_INTERVAL)
+
+/* Build CRF PDU carrying timestamps of the media clock whose timestamp with
+ * index 0 is 'start', 'period' apart, starting from index 'index'.
+ */
+static void build_pdu(uint8_t *buf, uint8_t seq_num, uint8_t mr,
+				uint64_t start, double period, int64_t index)
+{
+	struct avtp_crf_pdu *pdu = (struct avtp_crf_pdu *) buf;
+	struct avtp_crf_hdr hdr = {
+		.sv = 1,
+		.mr = mr,
+		.seq_num = seq_num,
+		.type = AVTP_CRF_TYPE_AUDIO_SAMPLE,
+		.stream_id = 0xAABBCCDDEEFF0002,
+		.pull = AVTP_CRF_PULL_MULT_BY_1,
+		.base_freq = SAMPLE_RATE,
+		.timestamp_interval = TIMESTAMP_INTERVAL,
+		.crf_data_len = TIMESTAMPS_PER_PKT * sizeof(uint64_t),
+	};
+	int i, res;
+
+	res = avtp_crf_pdu_pack(pdu, &hdr);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < TIMESTAMPS_PER_PKT; i++)
+		pdu->crf_data[i] = htobe64(start +
+				(uint64_t) ((index + i) * period + 0.5));
+}
+
+/* Feed 'count' PDUs, starting from sequence number 'seq_num'. */
+static void feed(struct avtp_crf_clock *clk, uint8_t seq_num, int count,
+				uint64_t start, double period)
+{
+	uint8_t buf[PDU_SIZE];
+	int i, res;
+
+	for (i = 0; i < count; i++) {
+		build_pdu(buf, seq_num + i, 0, start, period,
+				(int64_t) (seq_num + i) * TIMESTAMPS_PER_PKT);
+
+		res = avtp_crf_clock_update(clk,
+				(struct avtp_crf_pdu *) buf, sizeof(buf));
+		assert_int_equal(res, 0);
+	}
+}
+
+static void crf_clock_create_invalid(void **state)
+{
+	struct avtp_crf_clock *clk;
+	int res;
+
+	res = avtp_crf_clock_create(NULL, 16);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_crf_clock_create(&clk, 1);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_clock_update_invalid(void **state)
+{
+	struct avtp_crf_clock *clk;
+	uint8_t buf[PDU_SIZE];
+	struct avtp_crf_pdu *pdu = (struct avtp_crf_pdu *) buf;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 16);
+	assert_int_equal(res, 0);
+
+	build_pdu(buf, 0, 0, 0, TS_PERIOD, 0);
+
+	res = avtp_crf_clock_update(NULL, pdu, sizeof(buf));
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_crf_clock_update(clk, NULL, sizeof(buf));
+	assert_int_equal(res, -EINVAL);
+
+	/* Shorter than 'crf_data_len' says. */
+	res = avtp_crf_clock_update(clk, pdu, sizeof(buf) - 1);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_CRF_DATA_LEN, 12);
+	res = avtp_crf_clock_update(clk, pdu, sizeof(buf));
+	assert_int_equal(res, -EINVAL);
+
+	build_pdu(buf, 0, 0, 0, TS_PERIOD, 0);
+	avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_BASE_FREQ, 0);
+	res = avtp_crf_clock_update(clk, pdu, sizeof(buf));
+	assert_int_equal(res, -EINVAL);
+
+	build_pdu(buf, 0, 0, 0, TS_PERIOD, 0);
+	avtp_crf_pdu_set(pdu, AVTP_CRF_FIELD_TIMESTAMP_INTERVAL, 0);
+	res = avtp_crf_clock_update(clk, pdu, sizeof(buf));
+	assert_int_equal(res, -EINVAL);
+
+	build_pdu(buf, 0, 0, 0, TS_PERIOD, 0);
+	buf[0] = AVTP_SUBTYPE_AAF;
+	res = avtp_crf_clock_update(clk, pdu, sizeof(buf));
+	assert_int_equal(res, -EINVAL);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_lookup_invalid(void **state)
+{
+	struct avtp_crf_clock *clk;
+	uint64_t ts;
+	double period;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 16);
+	assert_int_equal(res, 0);
+
+	res = avtp_crf_clock_lookup(NULL, 0, &ts);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_crf_clock_lookup(clk, 0, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_crf_clock_get_period(clk, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	/* Nothing to estimate from yet. */
+	res = avtp_crf_clock_lookup(clk, 0, &ts);
+	assert_int_equal(res, -EAGAIN);
+
+	res = avtp_crf_clock_get_period(clk, &period);
+	assert_int_equal(res, -EAGAIN);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_nominal(void **state)
+{
+	const uint64_t start = 5 * NSEC_PER_SEC;
+	struct avtp_crf_clock *clk;
+	uint64_t ts;
+	double period;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 64);
+	assert_int_equal(res, 0);
+
+	/* A single PDU is enough to start mapping timestamps. */
+	feed(clk, 0, 1, start, TS_PERIOD);
+
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 100, &ts);
+	assert_int_equal(res, 0);
+	assert_int_equal(ts, start);
+
+	feed(clk, 1, 20, start, TS_PERIOD);
+
+	res = avtp_crf_clock_get_period(clk, &period);
+	assert_int_equal(res, 0);
+	assert_true(period > SAMPLE_PERIOD - 0.001);
+	assert_true(period < SAMPLE_PERIOD + 0.001);
+
+	/* Nearest sample, either side, and beyond the last timestamp. */
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 20833 * 10 + 5000,
+									&ts);
+	assert_int_equal(res, 0);
+	assert_int_equal(ts, start + 208333);
+
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 500 * 20833 +
+								15000, &ts);
+	assert_int_equal(res, 0);
+	assert_int_equal(ts, start + 10437500);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_drift(void **state)
+{
+	/* Media clock 100 ppm fast. */
+	const double ts_period = TS_PERIOD / 1.0001;
+	const double sample_period = ts_period / TIMESTAMP_INTERVAL;
+	const uint64_t start = 5 * NSEC_PER_SEC;
+	struct avtp_crf_clock *clk;
+	uint64_t ts, k, expected;
+	double period;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 64);
+	assert_int_equal(res, 0);
+
+	feed(clk, 0, 50, start, ts_period);
+
+	res = avtp_crf_clock_get_period(clk, &period);
+	assert_int_equal(res, 0);
+	assert_true(period > sample_period - 0.001);
+	assert_true(period < sample_period + 0.001);
+
+	/* Nearest sample to one second later. */
+	k = (uint64_t) (NSEC_PER_SEC / sample_period + 0.5);
+	expected = start + (uint64_t) (k * sample_period + 0.5);
+
+	res = avtp_crf_clock_lookup(clk, (uint32_t) (start + NSEC_PER_SEC),
+									&ts);
+	assert_int_equal(res, 0);
+	assert_true(ts >= expected - 2);
+	assert_true(ts <= expected + 2);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_lost_pdus(void **state)
+{
+	const uint64_t start = 5 * NSEC_PER_SEC;
+	struct avtp_crf_clock *clk;
+	double period;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 64);
+	assert_int_equal(res, 0);
+
+	/* Sequence numbers 10 to 19 are lost. */
+	feed(clk, 0, 10, start, TS_PERIOD);
+	feed(clk, 20, 10, start, TS_PERIOD);
+
+	res = avtp_crf_clock_get_period(clk, &period);
+	assert_int_equal(res, 0);
+	assert_true(period > SAMPLE_PERIOD - 0.001);
+	assert_true(period < SAMPLE_PERIOD + 0.001);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_duplicate(void **state)
+{
+	const uint64_t start = 5 * NSEC_PER_SEC;
+	struct avtp_crf_clock *clk;
+	uint8_t buf[PDU_SIZE];
+	double period, dup_period;
+	uint64_t ts, dup_ts;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 64);
+	assert_int_equal(res, 0);
+
+	feed(clk, 0, 10, start, TS_PERIOD);
+
+	res = avtp_crf_clock_get_period(clk, &period);
+	assert_int_equal(res, 0);
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 20833 * 70, &ts);
+	assert_int_equal(res, 0);
+
+	/* Last PDU received again, and an older one received late, leave
+	 * the estimate as is.
+	 */
+	build_pdu(buf, 9, 0, start, TS_PERIOD, 9 * TIMESTAMPS_PER_PKT);
+	res = avtp_crf_clock_update(clk, (struct avtp_crf_pdu *) buf,
+								sizeof(buf));
+	assert_int_equal(res, 0);
+
+	build_pdu(buf, 5, 0, start, TS_PERIOD, 5 * TIMESTAMPS_PER_PKT);
+	res = avtp_crf_clock_update(clk, (struct avtp_crf_pdu *) buf,
+								sizeof(buf));
+	assert_int_equal(res, 0);
+
+	res = avtp_crf_clock_get_period(clk, &dup_period);
+	assert_int_equal(res, 0);
+	assert_true(dup_period == period);
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 20833 * 70,
+								&dup_ts);
+	assert_int_equal(res, 0);
+	assert_int_equal(dup_ts, ts);
+
+	/* Next PDU in sequence carries on from there. */
+	feed(clk, 10, 10, start, TS_PERIOD);
+
+	res = avtp_crf_clock_get_period(clk, &period);
+	assert_int_equal(res, 0);
+	assert_true(period > SAMPLE_PERIOD - 0.001);
+	assert_true(period < SAMPLE_PERIOD + 0.001);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_restart(void **state)
+{
+	const uint64_t start = 5 * NSEC_PER_SEC;
+	struct avtp_crf_clock *clk;
+	uint8_t buf[PDU_SIZE];
+	uint64_t ts;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 64);
+	assert_int_equal(res, 0);
+
+	feed(clk, 0, 10, start, TS_PERIOD);
+
+	/* Phase jumps by 50 us, with no sequence number gap. */
+	feed(clk, 10, 10, start + 50000, TS_PERIOD);
+
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 50000 + 20833 * 70,
+									&ts);
+	assert_int_equal(res, 0);
+	assert_int_equal(ts, start + 50000 + 1458333);
+
+	/* 'mr' toggled: media clock restarted with 3 us phase. */
+	build_pdu(buf, 20, 1, start + 3000, TS_PERIOD, 20 * TIMESTAMPS_PER_PKT);
+	res = avtp_crf_clock_update(clk, (struct avtp_crf_pdu *) buf,
+								sizeof(buf));
+	assert_int_equal(res, 0);
+
+	res = avtp_crf_clock_lookup(clk, (uint32_t) start + 3000 + 416666667 +
+							20833 * 10, &ts);
+	assert_int_equal(res, 0);
+	assert_int_equal(ts, start + 3000 + 416875000);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+static void crf_clock_wrap(void **state)
+{
+	/* 32-bit AVTP timestamps wrap right after the last CRF timestamp. */
+	const uint64_t start = (5ULL << 32) - 10 * (uint64_t) TS_PERIOD;
+	struct avtp_crf_clock *clk;
+	uint64_t ts, expected;
+	int res;
+
+	res = avtp_crf_clock_create(&clk, 16);
+	assert_int_equal(res, 0);
+
+	feed(clk, 0, 1, start, TS_PERIOD);
+
+	expected = start + (uint64_t) (2000 * SAMPLE_PERIOD + 0.5);
+
+	res = avtp_crf_clock_lookup(clk, (uint32_t) (expected + 2000), &ts);
+	assert_int_equal(res, 0);
+	assert_true(expected >= 5ULL << 32);
+	assert_int_equal(ts, expected);
+
+	avtp_crf_clock_destroy(clk);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(crf_clock_create_invalid),
+		cmocka_unit_test(crf_clock_update_invalid),
+		cmocka_unit_test(crf_clock_lookup_invalid),
+		cmocka_unit_test(crf_clock_nominal),
+		cmocka_unit_test(crf_clock_drift),
+		cmocka_unit_test(crf_clock_lost_pdus),
+		cmocka_unit_test(crf_clock_duplicate),
+		cmocka_unit_test(crf_clock_restart),
+		cmocka_unit_test(crf_clock_wrap),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
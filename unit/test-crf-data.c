@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <endian.h>
+
+#include "avtp.h"
+#include "avtp_crf.h"
+
+/* 48 kHz audio sample clock, one timestamp every 160 samples, i.e. every
+ * 3333333.33 ns.
+ */
+static const struct avtp_crf_hdr audio_hdr = {
+	.type = AVTP_CRF_TYPE_AUDIO_SAMPLE,
+	.pull = AVTP_CRF_PULL_MULT_BY_1,
+	.base_freq = 48000,
+	.timestamp_interval = 160,
+};
+
+/* 1080p59.94 video line clock: 1125 lines per frame at 60/1.001 Hz, one
+ * timestamp per line.
+ */
+static const struct avtp_crf_hdr video_hdr = {
+	.type = AVTP_CRF_TYPE_VIDEO_LINE,
+	.pull = AVTP_CRF_PULL_MULT_BY_1_OVER_1_001,
+	.base_freq = 67500,
+	.timestamp_interval = 1,
+};
+
+static void crf_data_encode_null_data(void **state)
+{
+	int res;
+
+	res = avtp_crf_data_encode(NULL, 6, 0, &audio_hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_data_encode_invalid_hdr(void **state)
+{
+	int res;
+	uint64_t data[6];
+	struct avtp_crf_hdr hdr = audio_hdr;
+
+	hdr.base_freq = 0;
+	res = avtp_crf_data_encode(data, 6, 0, &hdr);
+	assert_int_equal(res, -EINVAL);
+
+	hdr = audio_hdr;
+	hdr.pull = AVTP_CRF_PULL_MULT_BY_1_OVER_8 + 1;
+	res = avtp_crf_data_encode(data, 6, 0, &hdr);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_data_encode(void **state)
+{
+	int res, i;
+	uint64_t data[6];
+	const uint64_t expected[6] = {
+		1000000000, 1003333333, 1006666667, 1010000000, 1013333333,
+		1016666667,
+	};
+
+	res = avtp_crf_data_encode(data, 6, 1000000000, &audio_hdr);
+
+	assert_int_equal(res, 0);
+	for (i = 0; i < 6; i++)
+		assert_true(be64toh(data[i]) == expected[i]);
+}
+
+static void crf_data_encode_no_drift(void **state)
+{
+	int res;
+	static uint64_t data[67501];
+
+	/* One second worth of video lines, last one is exactly 1.001 s
+	 * after the first.
+	 */
+	res = avtp_crf_data_encode(data, 67501, 0, &video_hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(be64toh(data[67500]) == 1001000000);
+}
+
+static void crf_data_decode_null_ts(void **state)
+{
+	int res;
+	uint64_t data[6] = { 0 };
+
+	res = avtp_crf_data_decode(NULL, data, 6, &audio_hdr, NULL, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_data_decode_null_outliers(void **state)
+{
+	int res;
+	uint64_t data[6] = { 0 }, ts[6];
+
+	res = avtp_crf_data_decode(ts, data, 6, &audio_hdr, NULL, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_data_decode(void **state)
+{
+	int res, i;
+	uint64_t data[37], ts[37];
+
+	/* Odd count so every kernel tail is exercised. */
+	res = avtp_crf_data_encode(data, 37, 0xFFFFFFFF00000000ULL,
+							&audio_hdr);
+	assert_int_equal(res, 0);
+
+	res = avtp_crf_data_decode(ts, data, 37, &audio_hdr, NULL, 0);
+
+	assert_int_equal(res, 0);
+	for (i = 0; i < 37; i++)
+		assert_true(ts[i] == be64toh(data[i]));
+}
+
+static void crf_data_decode_in_place(void **state)
+{
+	int res, i;
+	uint64_t data[9], copy[9];
+
+	res = avtp_crf_data_encode(data, 9, 5000, &video_hdr);
+	assert_int_equal(res, 0);
+	memcpy(copy, data, sizeof(data));
+
+	res = avtp_crf_data_decode(data, data, 9, &video_hdr, NULL, 0);
+
+	assert_int_equal(res, 0);
+	for (i = 0; i < 9; i++)
+		assert_true(data[i] == be64toh(copy[i]));
+}
+
+static void crf_data_decode_outliers(void **state)
+{
+	int res;
+	unsigned int outliers[2];
+	uint64_t data[600], ts[600];
+
+	res = avtp_crf_data_encode(data, 600, 0, &audio_hdr);
+	assert_int_equal(res, 0);
+
+	/* Late timestamp on a block boundary, and one going backwards. Half
+	 * a media clock period at 48 kHz is 10416 ns, so a 10000 ns error is
+	 * still fine.
+	 */
+	data[256] = htobe64(be64toh(data[256]) + 20000);
+	data[400] = htobe64(be64toh(data[400]) - 10000);
+	data[500] = htobe64(be64toh(data[499]) - 1);
+
+	res = avtp_crf_data_decode(ts, data, 600, &audio_hdr, outliers, 2);
+
+	/* Both the error and the recovery from it are outliers. */
+	assert_int_equal(res, 4);
+	assert_int_equal(outliers[0], 256);
+	assert_int_equal(outliers[1], 257);
+	assert_true(ts[256] == be64toh(data[256]));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(crf_data_encode_null_data),
+		cmocka_unit_test(crf_data_encode_invalid_hdr),
+		cmocka_unit_test(crf_data_encode),
+		cmocka_unit_test(crf_data_encode_no_drift),
+		cmocka_unit_test(crf_data_decode_null_ts),
+		cmocka_unit_test(crf_data_decode_null_outliers),
+		cmocka_unit_test(crf_data_decode),
+		cmocka_unit_test(crf_data_decode_in_place),
+		cmocka_unit_test(crf_data_decode_outliers),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
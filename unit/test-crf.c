@@ -27,6 +27,7 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <string.h>
 #include <setjmp.h>
 #include <cmocka.h>
 #include <arpa/inet.h>
@@ -417,6 +418,138 @@ static void crf_pdu_init(void **state)
 	assert_true(pdu.packet_info == 0);
 }
 
+static void crf_pdu_unpack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_crf_hdr hdr;
+
+	res = avtp_crf_pdu_unpack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_pdu_unpack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_crf_pdu pdu = { 0 };
+
+	res = avtp_crf_pdu_unpack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_pdu_unpack(void **state)
+{
+	int res;
+	struct avtp_crf_hdr hdr;
+	struct avtp_crf_pdu pdu = { 0 };
+
+	pdu.subtype_data = htonl(0x048B5501);
+	pdu.stream_id = htobe64(0xAABBCCDDEEFF0002);
+	pdu.packet_info = htobe64(0x4000BB80ABCD0160);
+
+	res = avtp_crf_pdu_unpack(&pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.sv == 1);
+	assert_true(hdr.mr == 1);
+	assert_true(hdr.fs == 1);
+	assert_true(hdr.tu == 1);
+	assert_true(hdr.seq_num == 0x55);
+	assert_true(hdr.type == AVTP_CRF_TYPE_AUDIO_SAMPLE);
+	assert_true(hdr.stream_id == 0xAABBCCDDEEFF0002);
+	assert_true(hdr.pull == AVTP_CRF_PULL_MULT_BY_1_001);
+	assert_true(hdr.base_freq == 48000);
+	assert_true(hdr.crf_data_len == 0xABCD);
+	assert_true(hdr.timestamp_interval == 0x160);
+}
+
+static void crf_pdu_pack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_crf_hdr hdr = { 0 };
+
+	res = avtp_crf_pdu_pack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_pdu_pack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_crf_pdu pdu;
+
+	res = avtp_crf_pdu_pack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_pdu_pack(void **state)
+{
+	int res;
+	struct avtp_crf_pdu pdu;
+	struct avtp_crf_hdr hdr = {
+		.sv = 1,
+		.mr = 1,
+		.fs = 1,
+		.tu = 1,
+		.seq_num = 0x55,
+		.type = AVTP_CRF_TYPE_AUDIO_SAMPLE,
+		.stream_id = 0xAABBCCDDEEFF0002,
+		.pull = AVTP_CRF_PULL_MULT_BY_1_001,
+		.base_freq = 48000,
+		.crf_data_len = 0xABCD,
+		.timestamp_interval = 0x160,
+	};
+
+	memset(&pdu, 0xFF, sizeof(pdu));
+
+	res = avtp_crf_pdu_pack(&pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x048B5501);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0002);
+	assert_true(be64toh(pdu.packet_info) == 0x4000BB80ABCD0160);
+}
+
+static void crf_pdu_emit_null_pdu(void **state)
+{
+	int res;
+	struct avtp_crf_pdu tmpl = { 0 };
+
+	res = avtp_crf_pdu_emit(NULL, &tmpl, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_pdu_emit_null_tmpl(void **state)
+{
+	int res;
+	struct avtp_crf_pdu pdu;
+
+	res = avtp_crf_pdu_emit(&pdu, NULL, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void crf_pdu_emit(void **state)
+{
+	int res;
+	struct avtp_crf_pdu pdu, tmpl;
+
+	tmpl.subtype_data = htonl(0x048BFF01);
+	tmpl.stream_id = htobe64(0xAABBCCDDEEFF0002);
+	tmpl.packet_info = htobe64(0x4000BB80ABCD0160);
+
+	res = avtp_crf_pdu_emit(&pdu, &tmpl, 0x12);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x048B1201);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0002);
+	assert_true(be64toh(pdu.packet_info) == 0x4000BB80ABCD0160);
+	assert_true(ntohl(tmpl.subtype_data) == 0x048BFF01);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -449,6 +582,15 @@ int main(void)
 		cmocka_unit_test(crf_set_field_timestamp_interval),
 		cmocka_unit_test(crf_pdu_init_null_pdu),
 		cmocka_unit_test(crf_pdu_init),
+		cmocka_unit_test(crf_pdu_unpack_null_pdu),
+		cmocka_unit_test(crf_pdu_unpack_null_hdr),
+		cmocka_unit_test(crf_pdu_unpack),
+		cmocka_unit_test(crf_pdu_pack_null_pdu),
+		cmocka_unit_test(crf_pdu_pack_null_hdr),
+		cmocka_unit_test(crf_pdu_pack),
+		cmocka_unit_test(crf_pdu_emit_null_pdu),
+		cmocka_unit_test(crf_pdu_emit_null_tmpl),
+		cmocka_unit_test(crf_pdu_emit),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
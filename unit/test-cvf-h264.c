@@ -0,0 +1,774 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp.h"
+#include "avtp_cvf.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define TMPL_LEN		(sizeof(struct avtp_stream_pdu) + \
+					sizeof(struct avtp_cvf_h264_payload))
+#define MAX_PDU_SIZE		(TMPL_LEN + 100)
+
+/* Access unit with SPS (4-byte start code), PPS and a small IDR slice. */
+static const uint8_t small_au[] = {
+	0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1F,
+	0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C, 0x80,
+	0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00, 0x33,
+};
+
+static void init_tmpl(uint8_t *tmpl, uint8_t subtype)
+{
+	struct avtp_cvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = STREAM_ID,
+		},
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = subtype,
+		.h264_ptv = 1,
+		/* The packetizer is in charge of 'M'. */
+		.m = 1,
+	};
+	int res;
+
+	res = avtp_cvf_pdu_pack((struct avtp_stream_pdu *) tmpl, &hdr);
+	assert_int_equal(res, 0);
+}
+
+static void init_packetizer(struct avtp_cvf_h264_packetizer *pkt)
+{
+	uint8_t tmpl[TMPL_LEN];
+	int res;
+
+	init_tmpl(tmpl, AVTP_CVF_FORMAT_SUBTYPE_H264);
+
+	res = avtp_cvf_h264_packetizer_init(pkt,
+				(struct avtp_stream_pdu *) tmpl, MAX_PDU_SIZE);
+	assert_int_equal(res, 0);
+}
+
+static void check_pdu(struct avtp_cvf_h264_packet *packet, uint8_t seq_num,
+							uint8_t m)
+{
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) packet->hdr;
+	size_t len = packet->iov[0].iov_len + packet->iov[1].iov_len;
+	struct avtp_cvf_hdr hdr;
+	int res;
+
+	assert_ptr_equal(packet->iov[0].iov_base, packet->hdr);
+	assert_true(len <= MAX_PDU_SIZE);
+
+	res = avtp_cvf_pdu_unpack(pdu, &hdr);
+	assert_int_equal(res, 0);
+	assert_int_equal(hdr.stream.stream_id, STREAM_ID);
+	assert_int_equal(hdr.stream.seq_num, seq_num);
+	assert_int_equal(hdr.stream.timestamp, 0x80C0FFEE);
+	assert_int_equal(hdr.stream.stream_data_len,
+					len - sizeof(struct avtp_stream_pdu));
+	assert_int_equal(hdr.format_subtype, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	assert_int_equal(hdr.h264_timestamp, 0x12345678);
+	assert_int_equal(hdr.h264_ptv, 1);
+	assert_int_equal(hdr.m, m);
+}
+
+static void cvf_h264_packetizer_init_null(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	uint8_t tmpl[TMPL_LEN];
+	int res;
+
+	init_tmpl(tmpl, AVTP_CVF_FORMAT_SUBTYPE_H264);
+
+	res = avtp_cvf_h264_packetizer_init(NULL,
+				(struct avtp_stream_pdu *) tmpl, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_packetizer_init(&pkt, NULL, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_h264_packetizer_init_invalid_tmpl(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	uint8_t tmpl[TMPL_LEN];
+	int res;
+
+	init_tmpl(tmpl, AVTP_CVF_FORMAT_SUBTYPE_MJPEG);
+
+	res = avtp_cvf_h264_packetizer_init(&pkt,
+				(struct avtp_stream_pdu *) tmpl, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	init_tmpl(tmpl, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	tmpl[0] = AVTP_SUBTYPE_AAF;
+
+	res = avtp_cvf_h264_packetizer_init(&pkt,
+				(struct avtp_stream_pdu *) tmpl, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_h264_packetizer_init_small_pdu(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	uint8_t tmpl[TMPL_LEN];
+	int res;
+
+	init_tmpl(tmpl, AVTP_CVF_FORMAT_SUBTYPE_H264);
+
+	res = avtp_cvf_h264_packetizer_init(&pkt,
+				(struct avtp_stream_pdu *) tmpl, TMPL_LEN + 2);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_packetizer_init(&pkt,
+				(struct avtp_stream_pdu *) tmpl, TMPL_LEN + 3);
+	assert_int_equal(res, 0);
+}
+
+static void cvf_h264_packetizer_start_null(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	int res;
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_start(NULL, small_au, sizeof(small_au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, NULL, sizeof(small_au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_h264_packetizer_start_no_start_code(void **state)
+{
+	const uint8_t au[] = { 0x00, 0x00, 0x02, 0x65, 0x88, 0x00, 0x01 };
+	struct avtp_cvf_h264_packetizer pkt;
+	int res;
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, au, sizeof(au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_h264_packetizer_next_null(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	int res;
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_next(NULL, &packet);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, NULL);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_h264_packetizer_single_nal(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	int res;
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, small_au, sizeof(small_au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, 0);
+
+	/* NAL units are referenced from the access unit, without start
+	 * codes.
+	 */
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 0, 0);
+	assert_int_equal(packet.iov[0].iov_len, TMPL_LEN);
+	assert_ptr_equal(packet.iov[1].iov_base, &small_au[4]);
+	assert_int_equal(packet.iov[1].iov_len, 4);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 1, 0);
+	assert_ptr_equal(packet.iov[1].iov_base, &small_au[11]);
+	assert_int_equal(packet.iov[1].iov_len, 4);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 2, 1);
+	assert_ptr_equal(packet.iov[1].iov_base, &small_au[18]);
+	assert_int_equal(packet.iov[1].iov_len, 5);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+}
+
+static void cvf_h264_packetizer_trailing_zeros(void **state)
+{
+	const uint8_t au[] = {
+		0x00, 0x00, 0x01, 0x09, 0xF0, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x00, 0x00,
+	};
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	int res;
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, au, sizeof(au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, 0);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	assert_ptr_equal(packet.iov[1].iov_base, &au[3]);
+	assert_int_equal(packet.iov[1].iov_len, 2);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 1, 1);
+	assert_ptr_equal(packet.iov[1].iov_base, &au[11]);
+	assert_int_equal(packet.iov[1].iov_len, 2);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+}
+
+static void cvf_h264_packetizer_trailing_start_code(void **state)
+{
+	const uint8_t au[] = {
+		0x00, 0x00, 0x01, 0x65, 0x88, 0x84,
+		0x00, 0x00, 0x01, 0x00, 0x00,
+	};
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	int res;
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, au, sizeof(au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, 0);
+
+	/* Start code with no NAL unit after it doesn't hold back 'M'. */
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 0, 1);
+	assert_ptr_equal(packet.iov[1].iov_base, &au[3]);
+	assert_int_equal(packet.iov[1].iov_len, 3);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+}
+
+static void cvf_h264_packetizer_fu_a(void **state)
+{
+	uint8_t au[4 + 250], nal[250], *p = nal;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	uint8_t seq_num = 0;
+	size_t i;
+	int res;
+
+	au[0] = 0x00;
+	au[1] = 0x00;
+	au[2] = 0x00;
+	au[3] = 0x01;
+	/* nal_ref_idc 3, IDR slice. Payload never holds a start code. */
+	au[4] = 0x65;
+	for (i = 5; i < sizeof(au); i++)
+		au[i] = (uint8_t) (i | 0x80);
+
+	init_packetizer(&pkt);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, au, sizeof(au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, 0);
+
+	/* 249 bytes past the NAL unit header, 98 per fragment. */
+	while ((res = avtp_cvf_h264_packetizer_next(&pkt, &packet)) == 1) {
+		uint8_t *fu = packet.hdr + TMPL_LEN;
+		uint8_t s = seq_num == 0, e = seq_num == 2;
+
+		check_pdu(&packet, seq_num, e);
+		assert_int_equal(packet.iov[0].iov_len, TMPL_LEN + 2);
+		assert_int_equal(fu[0], 0x60 | 28);
+		assert_int_equal(fu[1], (s << 7) | (e << 6) | 0x05);
+		assert_int_equal(packet.iov[1].iov_len, e ? 53 : 98);
+
+		memcpy(p, packet.iov[1].iov_base, packet.iov[1].iov_len);
+		p += packet.iov[1].iov_len;
+		seq_num++;
+	}
+
+	assert_int_equal(res, 0);
+	assert_int_equal(seq_num, 3);
+	assert_int_equal(p - nal, sizeof(au) - 5);
+	assert_memory_equal(nal, &au[5], sizeof(au) - 5);
+}
+
+static void cvf_h264_packetizer_next_au(void **state)
+{
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	int res, i;
+
+	init_packetizer(&pkt);
+
+	/* Sequence numbers carry on across access units and wrap around. */
+	for (i = 0; i < 100; i++) {
+		res = avtp_cvf_h264_packetizer_start(&pkt, small_au,
+					sizeof(small_au), 0x80C0FFEE,
+					0x12345678);
+		assert_int_equal(res, 0);
+
+		while (avtp_cvf_h264_packetizer_next(&pkt, &packet) == 1)
+			;
+	}
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, small_au, sizeof(small_au),
+							0x80C0FFEE, 0x12345678);
+	assert_int_equal(res, 0);
+
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 300 % 256, 0);
+}
+
+/* Packetize 'au' and push every PDU into 'depkt'. Returns the first error
+ * from pushes, if any, or the result from the last push. If 'skip' is not negative, the PDU with that index is lost.
+ */
+static int push_au(struct avtp_cvf_h264_depacketizer *depkt,
+				struct avtp_cvf_h264_packetizer *pkt,
+				const uint8_t *au, size_t len, int skip,
+				struct avtp_cvf_h264_frame *frame)
+{
+	struct avtp_cvf_h264_packet packet;
+	uint8_t pdu[MAX_PDU_SIZE];
+	int res, ret = 0, i = 0;
+
+	res = avtp_cvf_h264_packetizer_start(pkt, au, len, 0x80C0FFEE,
+								0x12345678);
+	assert_int_equal(res, 0);
+
+	while (avtp_cvf_h264_packetizer_next(pkt, &packet) == 1) {
+		size_t hdr_len = packet.iov[0].iov_len;
+
+		memcpy(pdu, packet.hdr, hdr_len);
+		memcpy(pdu + hdr_len, packet.iov[1].iov_base,
+						packet.iov[1].iov_len);
+
+		if (i++ == skip)
+			continue;
+
+		res = avtp_cvf_h264_depacketizer_push(depkt,
+					(struct avtp_stream_pdu *) pdu,
+					hdr_len + packet.iov[1].iov_len, frame);
+		if (ret >= 0)
+			ret = res;
+	}
+
+	return ret;
+}
+
+/* Build an access unit with one 'len' bytes IDR slice, which needs FU-A. */
+static void init_large_au(uint8_t *au, size_t len)
+{
+	size_t i;
+
+	au[0] = 0x00;
+	au[1] = 0x00;
+	au[2] = 0x01;
+	au[3] = 0x65;
+	for (i = 4; i < len + 3; i++)
+		au[i] = (uint8_t) (i | 0x80);
+}
+
+static void cvf_h264_depacketizer_create_invalid(void **state)
+{
+	struct avtp_cvf_h264_depacketizer *depkt;
+	int res;
+
+	res = avtp_cvf_h264_depacketizer_create(NULL, 1024);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 0);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_h264_depacketizer_push_invalid(void **state)
+{
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_frame frame;
+	uint8_t pdu[TMPL_LEN + 8] = { 0 };
+	int res;
+
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 1024);
+	assert_int_equal(res, 0);
+
+	init_tmpl(pdu, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	avtp_cvf_pdu_set((struct avtp_stream_pdu *) pdu,
+				AVTP_CVF_FIELD_STREAM_DATA_LEN, 4 + 8);
+
+	res = avtp_cvf_h264_depacketizer_push(NULL,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu), &frame);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_depacketizer_push(depkt, NULL, sizeof(pdu),
+								&frame);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu), NULL);
+	assert_int_equal(res, -EINVAL);
+
+	/* Shorter than 'stream_data_length' says. */
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu) - 1,
+								&frame);
+	assert_int_equal(res, -EINVAL);
+
+	init_tmpl(pdu, AVTP_CVF_FORMAT_SUBTYPE_MJPEG);
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu), &frame);
+	assert_int_equal(res, -EINVAL);
+
+	init_tmpl(pdu, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	pdu[0] = AVTP_SUBTYPE_AAF;
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu), &frame);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_single_nal(void **state)
+{
+	/* Start codes are always rebuilt as 4-byte start codes. */
+	const uint8_t expected[] = {
+		0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1F,
+		0x00, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C, 0x80,
+		0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00, 0x33,
+	};
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_frame frame;
+	int res;
+
+	init_packetizer(&pkt);
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 1024);
+	assert_int_equal(res, 0);
+
+	res = push_au(depkt, &pkt, small_au, sizeof(small_au), -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.len, sizeof(expected));
+	assert_memory_equal(frame.data, expected, sizeof(expected));
+	assert_int_equal(frame.avtp_time, 0x80C0FFEE);
+	assert_int_equal(frame.h264_time, 0x12345678);
+	assert_int_equal(frame.h264_ptv, 1);
+	assert_int_equal(frame.lost_pdus, 0);
+	assert_int_equal(frame.dropped_frames, 0);
+
+	res = avtp_cvf_h264_depacketizer_release(depkt, &frame);
+	assert_int_equal(res, 0);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_fu_a(void **state)
+{
+	uint8_t au[3 + 1000];
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_frame frame;
+	int res;
+
+	init_large_au(au, 1000);
+	init_packetizer(&pkt);
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 4096);
+	assert_int_equal(res, 0);
+
+	res = push_au(depkt, &pkt, au, sizeof(au), -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.len, 4 + 1000);
+	assert_int_equal(frame.data[3], 0x01);
+	assert_memory_equal(frame.data + 4, au + 3, 1000);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_stap_a(void **state)
+{
+	const uint8_t expected[] = {
+		0x00, 0x00, 0x00, 0x01, 0x67, 0x42,
+		0x00, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C,
+	};
+	const uint8_t stap[] = {
+		0x78, 0x00, 0x02, 0x67, 0x42, 0x00, 0x03, 0x68, 0xCE, 0x3C,
+	};
+	uint8_t pdu[TMPL_LEN + sizeof(stap)];
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_frame frame;
+	int res;
+
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 1024);
+	assert_int_equal(res, 0);
+
+	init_tmpl(pdu, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	avtp_cvf_pdu_set((struct avtp_stream_pdu *) pdu,
+			AVTP_CVF_FIELD_STREAM_DATA_LEN, 4 + sizeof(stap));
+	memcpy(pdu + TMPL_LEN, stap, sizeof(stap));
+
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu), &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.len, sizeof(expected));
+	assert_memory_equal(frame.data, expected, sizeof(expected));
+
+	/* NAL unit sizes overflowing the packet make the frame be dropped. */
+	pdu[TMPL_LEN + 6] = 0x04;
+	avtp_cvf_pdu_set((struct avtp_stream_pdu *) pdu,
+					AVTP_CVF_FIELD_SEQ_NUM, 1);
+
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, sizeof(pdu), &frame);
+	assert_int_equal(res, 0);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_loss(void **state)
+{
+	uint8_t au[3 + 1000];
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_frame frame;
+	int res;
+
+	init_large_au(au, 1000);
+	init_packetizer(&pkt);
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 4096);
+	assert_int_equal(res, 0);
+
+	/* Losing a fragment drops the whole frame. */
+	res = push_au(depkt, &pkt, au, sizeof(au), 3, &frame);
+	assert_int_equal(res, 0);
+
+	/* Losing the first PDU of next frame is only noticed on the second
+	 * one, so that frame is dropped as well.
+	 */
+	res = push_au(depkt, &pkt, small_au, sizeof(small_au), 0, &frame);
+	assert_int_equal(res, 0);
+
+	res = push_au(depkt, &pkt, small_au, sizeof(small_au), -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.lost_pdus, 2);
+	assert_int_equal(frame.dropped_frames, 2);
+
+	res = push_au(depkt, &pkt, small_au, sizeof(small_au), -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.lost_pdus, 0);
+	assert_int_equal(frame.dropped_frames, 0);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_duplicate(void **state)
+{
+	uint8_t au[3 + 1000];
+	uint8_t pdu[MAX_PDU_SIZE], dup[MAX_PDU_SIZE];
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	struct avtp_cvf_h264_frame frame;
+	size_t len, dup_len = 0;
+	int res = 0, i = 0;
+
+	init_large_au(au, 1000);
+	init_packetizer(&pkt);
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 4096);
+	assert_int_equal(res, 0);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, au, sizeof(au), 0, 0);
+	assert_int_equal(res, 0);
+
+	/* First fragment received again after the second one. */
+	while (avtp_cvf_h264_packetizer_next(&pkt, &packet) == 1) {
+		len = packet.iov[0].iov_len;
+		memcpy(pdu, packet.hdr, len);
+		memcpy(pdu + len, packet.iov[1].iov_base,
+						packet.iov[1].iov_len);
+		len += packet.iov[1].iov_len;
+
+		res = avtp_cvf_h264_depacketizer_push(depkt,
+				(struct avtp_stream_pdu *) pdu, len, &frame);
+
+		if (i == 0) {
+			memcpy(dup, pdu, len);
+			dup_len = len;
+		} else if (i == 1) {
+			assert_int_equal(res, 0);
+			res = avtp_cvf_h264_depacketizer_push(depkt,
+				(struct avtp_stream_pdu *) dup, dup_len,
+				&frame);
+			assert_int_equal(res, 0);
+		}
+		i++;
+	}
+
+	assert_true(i > 2);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.len, 4 + 1000);
+	assert_memory_equal(frame.data + 4, au + 3, 1000);
+	assert_int_equal(frame.lost_pdus, 0);
+	assert_int_equal(frame.dropped_frames, 0);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_unterminated_fu(void **state)
+{
+	uint8_t au[3 + 1000];
+	uint8_t pdu[MAX_PDU_SIZE];
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_packet packet;
+	struct avtp_cvf_h264_frame frame;
+	size_t len;
+	int res;
+
+	init_large_au(au, 1000);
+	init_packetizer(&pkt);
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 4096);
+	assert_int_equal(res, 0);
+
+	res = avtp_cvf_h264_packetizer_start(&pkt, au, sizeof(au), 0, 0);
+	assert_int_equal(res, 0);
+	res = avtp_cvf_h264_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+
+	/* First fragment flagged as the end of the frame. */
+	len = packet.iov[0].iov_len;
+	memcpy(pdu, packet.hdr, len);
+	memcpy(pdu + len, packet.iov[1].iov_base, packet.iov[1].iov_len);
+	len += packet.iov[1].iov_len;
+	avtp_cvf_pdu_set((struct avtp_stream_pdu *) pdu, AVTP_CVF_FIELD_M, 1);
+
+	res = avtp_cvf_h264_depacketizer_push(depkt,
+			(struct avtp_stream_pdu *) pdu, len, &frame);
+	assert_int_equal(res, 0);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+static void cvf_h264_depacketizer_arena(void **state)
+{
+	struct avtp_cvf_h264_depacketizer *depkt;
+	struct avtp_cvf_h264_packetizer pkt;
+	struct avtp_cvf_h264_frame frames[3], frame;
+	int res, i;
+
+	init_packetizer(&pkt);
+
+	/* Room for two frames only. */
+	res = avtp_cvf_h264_depacketizer_create(&depkt, 50);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < 2; i++) {
+		res = push_au(depkt, &pkt, small_au, sizeof(small_au), -1,
+								&frames[i]);
+		assert_int_equal(res, 1);
+	}
+
+	res = push_au(depkt, &pkt, small_au, sizeof(small_au), -1, &frame);
+	assert_int_equal(res, -ENOSPC);
+
+	/* Frames are released in order. */
+	res = avtp_cvf_h264_depacketizer_release(depkt, &frames[1]);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_cvf_h264_depacketizer_release(depkt, &frames[0]);
+	assert_int_equal(res, 0);
+
+	/* Next frame wraps around to the start of the arena. */
+	res = push_au(depkt, &pkt, small_au, sizeof(small_au), -1,
+								&frames[2]);
+	assert_int_equal(res, 1);
+	assert_int_equal(frames[2].dropped_frames, 1);
+	assert_ptr_equal(frames[2].data, frames[0].data);
+	assert_memory_equal(frames[2].data, frames[1].data, frames[1].len);
+
+	res = avtp_cvf_h264_depacketizer_release(depkt, &frames[1]);
+	assert_int_equal(res, 0);
+	res = avtp_cvf_h264_depacketizer_release(depkt, &frames[2]);
+	assert_int_equal(res, 0);
+	res = avtp_cvf_h264_depacketizer_release(depkt, &frames[2]);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_cvf_h264_depacketizer_destroy(depkt);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(cvf_h264_packetizer_init_null),
+		cmocka_unit_test(cvf_h264_packetizer_init_invalid_tmpl),
+		cmocka_unit_test(cvf_h264_packetizer_init_small_pdu),
+		cmocka_unit_test(cvf_h264_packetizer_start_null),
+		cmocka_unit_test(cvf_h264_packetizer_start_no_start_code),
+		cmocka_unit_test(cvf_h264_packetizer_next_null),
+		cmocka_unit_test(cvf_h264_packetizer_single_nal),
+		cmocka_unit_test(cvf_h264_packetizer_trailing_zeros),
+		cmocka_unit_test(cvf_h264_packetizer_trailing_start_code),
+		cmocka_unit_test(cvf_h264_packetizer_fu_a),
+		cmocka_unit_test(cvf_h264_packetizer_next_au),
+		cmocka_unit_test(cvf_h264_depacketizer_create_invalid),
+		cmocka_unit_test(cvf_h264_depacketizer_push_invalid),
+		cmocka_unit_test(cvf_h264_depacketizer_single_nal),
+		cmocka_unit_test(cvf_h264_depacketizer_fu_a),
+		cmocka_unit_test(cvf_h264_depacketizer_stap_a),
+		cmocka_unit_test(cvf_h264_depacketizer_loss),
+		cmocka_unit_test(cvf_h264_depacketizer_duplicate),
+		cmocka_unit_test(cvf_h264_depacketizer_unterminated_fu),
+		cmocka_unit_test(cvf_h264_depacketizer_arena),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
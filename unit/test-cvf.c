@@ -552,6 +552,160 @@ static void cvf_set_field_h264_timestamp(void **state)
 	assert_true(ntohl(pay->h264_header) == 0x80C0FFEE);
 }
 
+static void cvf_pdu_unpack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_cvf_hdr hdr;
+
+	res = avtp_cvf_pdu_unpack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_pdu_unpack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_cvf_pdu_unpack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_pdu_unpack(void **state)
+{
+	int res;
+	struct avtp_cvf_hdr hdr;
+	struct avtp_stream_pdu *pdu =
+		alloca(sizeof(struct avtp_stream_pdu) + sizeof(uint32_t));
+	struct avtp_cvf_h264_payload *pay =
+			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
+
+	pdu->subtype_data = htonl(0x03812A00);
+	pdu->stream_id = htobe64(0xAABBCCDDEEFF0003);
+	pdu->avtp_time = htonl(0x80C0FFEE);
+	pdu->format_specific = htonl(0x02010000);
+	pdu->packet_info = htonl(0x05DC3F00);
+	pay->h264_header = htonl(0x12345678);
+
+	res = avtp_cvf_pdu_unpack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.stream.sv == 1);
+	assert_true(hdr.stream.mr == 0);
+	assert_true(hdr.stream.tv == 1);
+	assert_true(hdr.stream.seq_num == 0x2A);
+	assert_true(hdr.stream.tu == 0);
+	assert_true(hdr.stream.stream_id == 0xAABBCCDDEEFF0003);
+	assert_true(hdr.stream.timestamp == 0x80C0FFEE);
+	assert_true(hdr.stream.stream_data_len == 1500);
+	assert_true(hdr.format == AVTP_CVF_FORMAT_RFC);
+	assert_true(hdr.format_subtype == AVTP_CVF_FORMAT_SUBTYPE_H264);
+	assert_true(hdr.h264_ptv == 1);
+	assert_true(hdr.m == 1);
+	assert_true(hdr.evt == 0xF);
+	assert_true(hdr.h264_timestamp == 0x12345678);
+}
+
+static void cvf_pdu_unpack_mjpeg(void **state)
+{
+	int res;
+	struct avtp_cvf_hdr hdr;
+	struct avtp_stream_pdu *pdu =
+		alloca(sizeof(struct avtp_stream_pdu) + sizeof(uint32_t));
+	struct avtp_cvf_h264_payload *pay =
+			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
+
+	memset(pdu, 0, sizeof(struct avtp_stream_pdu));
+	pdu->format_specific = htonl(0x02000000);
+	pay->h264_header = htonl(0x12345678);
+
+	res = avtp_cvf_pdu_unpack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.format_subtype == AVTP_CVF_FORMAT_SUBTYPE_MJPEG);
+	assert_true(hdr.h264_timestamp == 0);
+}
+
+static void cvf_pdu_pack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_cvf_hdr hdr = { 0 };
+
+	res = avtp_cvf_pdu_pack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_pdu_pack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_cvf_pdu_pack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void cvf_pdu_pack(void **state)
+{
+	int res;
+	struct avtp_cvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.seq_num = 0x2A,
+			.stream_id = 0xAABBCCDDEEFF0003,
+			.timestamp = 0x80C0FFEE,
+			.stream_data_len = 1500,
+		},
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_H264,
+		.h264_ptv = 1,
+		.m = 1,
+		.evt = 0xF,
+		.h264_timestamp = 0x12345678,
+	};
+	struct avtp_stream_pdu *pdu =
+		alloca(sizeof(struct avtp_stream_pdu) + sizeof(uint32_t));
+	struct avtp_cvf_h264_payload *pay =
+			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
+
+	memset(pdu, 0xFF, sizeof(struct avtp_stream_pdu) + sizeof(uint32_t));
+
+	res = avtp_cvf_pdu_pack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu->subtype_data) == 0x03812A00);
+	assert_true(be64toh(pdu->stream_id) == 0xAABBCCDDEEFF0003);
+	assert_true(ntohl(pdu->avtp_time) == 0x80C0FFEE);
+	assert_true(ntohl(pdu->format_specific) == 0x02010000);
+	assert_true(ntohl(pdu->packet_info) == 0x05DC3F00);
+	assert_true(ntohl(pay->h264_header) == 0x12345678);
+}
+
+static void cvf_pdu_pack_mjpeg(void **state)
+{
+	int res;
+	struct avtp_cvf_hdr hdr = {
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = AVTP_CVF_FORMAT_SUBTYPE_MJPEG,
+		.h264_timestamp = 0x12345678,
+	};
+	struct avtp_stream_pdu *pdu =
+		alloca(sizeof(struct avtp_stream_pdu) + sizeof(uint32_t));
+	struct avtp_cvf_h264_payload *pay =
+			(struct avtp_cvf_h264_payload *)pdu->avtp_payload;
+
+	pay->h264_header = htonl(0xCAFEBABE);
+
+	res = avtp_cvf_pdu_pack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu->format_specific) == 0x02000000);
+	assert_true(ntohl(pay->h264_header) == 0xCAFEBABE);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -591,6 +745,14 @@ int main(void)
 		cmocka_unit_test(cvf_pdu_init_null_pdu),
 		cmocka_unit_test(cvf_pdu_init_invalid_subtype),
 		cmocka_unit_test(cvf_pdu_init),
+		cmocka_unit_test(cvf_pdu_unpack_null_pdu),
+		cmocka_unit_test(cvf_pdu_unpack_null_hdr),
+		cmocka_unit_test(cvf_pdu_unpack),
+		cmocka_unit_test(cvf_pdu_unpack_mjpeg),
+		cmocka_unit_test(cvf_pdu_pack_null_pdu),
+		cmocka_unit_test(cvf_pdu_pack_null_hdr),
+		cmocka_unit_test(cvf_pdu_pack),
+		cmocka_unit_test(cvf_pdu_pack_mjpeg),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
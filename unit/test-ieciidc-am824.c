@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp.h"
+#include "avtp_ieciidc.h"
+
+/* Odd sizes so vector kernels always have a scalar tail to handle. */
+#define CHANNELS		3
+#define FRAMES			37
+#define SAMPLES			(CHANNELS * FRAMES)
+#define CIP_HDR_LEN		sizeof(struct avtp_ieciidc_cip_payload)
+
+static void init_s32(int32_t *samples, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		samples[i] = (int32_t) (0x01234567u * (i + 1) + 0x89ABCDEFu);
+}
+
+static uint32_t get_quadlet(const uint8_t *payload, size_t idx)
+{
+	uint32_t val;
+
+	memcpy(&val, payload + idx * 4, sizeof(val));
+
+	return ntohl(val);
+}
+
+static void ieciidc_am824_init_invalid(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	int res;
+
+	res = avtp_ieciidc_am824_init(NULL, AVTP_IECIIDC_SFC_48KHZ, 2, 2);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_192KHZ + 1, 2, 2);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, 0, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, 2, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, 2, 3);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ieciidc_am824_encode_invalid(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { 0 };
+	int32_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 4];
+	int res;
+
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS,
+								CHANNELS);
+
+	res = avtp_ieciidc_am824_encode(NULL, &hdr, payload, samples, FRAMES,
+									0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_encode(&am, NULL, payload, samples, FRAMES,
+									0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_encode(&am, &hdr, NULL, samples, FRAMES, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, NULL, FRAMES, 0);
+	assert_int_equal(res, -EINVAL);
+
+	/* Data blocks wouldn't fit in 'stream_data_length'. */
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 5461, 0);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ieciidc_am824_encode(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { 0 };
+	int32_t samples[SAMPLES];
+	uint8_t payload[SAMPLES * 4];
+	size_t i;
+	int res;
+
+	init_s32(samples, SAMPLES);
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS,
+								CHANNELS);
+
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, FRAMES,
+									0);
+	assert_int_equal(res, SAMPLES * 4);
+
+	for (i = 0; i < SAMPLES; i++)
+		assert_int_equal(get_quadlet(payload, i),
+				((uint32_t) samples[i] >> 8) | 0x40000000);
+
+	assert_int_equal(hdr.stream.stream_data_len, CIP_HDR_LEN + SAMPLES * 4);
+	assert_int_equal(hdr.cip_fmt, AVTP_IECIIDC_CIP_FMT_AM824);
+	assert_int_equal(hdr.cip_dbs, CHANNELS);
+	assert_int_equal(hdr.cip_dbc, 0);
+	assert_int_equal(hdr.cip_sfc, AVTP_IECIIDC_SFC_48KHZ);
+	assert_int_equal(hdr.cip_evt, 0);
+	assert_int_equal(hdr.cip_no_data, 0);
+
+	/* DBC is advanced by the number of data blocks sent. */
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, FRAMES,
+									0);
+	assert_int_equal(res, SAMPLES * 4);
+	assert_int_equal(hdr.cip_dbc, FRAMES);
+}
+
+static void ieciidc_am824_encode_padding(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { 0 };
+	int32_t samples[SAMPLES];
+	uint8_t payload[FRAMES * (CHANNELS + 2) * 4];
+	size_t i, q;
+	int res;
+
+	init_s32(samples, SAMPLES);
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS + 2,
+								CHANNELS);
+
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, FRAMES,
+									0);
+	assert_int_equal(res, sizeof(payload));
+	assert_int_equal(hdr.cip_dbs, CHANNELS + 2);
+
+	for (i = 0; i < FRAMES; i++) {
+		for (q = 0; q < CHANNELS; q++)
+			assert_int_equal(
+				get_quadlet(payload, i * (CHANNELS + 2) + q),
+				((uint32_t) samples[i * CHANNELS + q] >> 8) |
+								0x40000000);
+
+		/* Quadlets past the audio channels carry silence. */
+		for (; q < CHANNELS + 2; q++)
+			assert_int_equal(
+				get_quadlet(payload, i * (CHANNELS + 2) + q),
+				0x40000000);
+	}
+}
+
+static void ieciidc_am824_encode_syt(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { 0 };
+	int32_t samples[8 * CHANNELS] = { 0 };
+	uint8_t payload[8 * CHANNELS * 4];
+	int res;
+
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS,
+								CHANNELS);
+
+	/* First data block has DBC 0, so SYT is the time of the packet: 1 ms
+	 * is cycle 8, offset 0.
+	 */
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 3,
+								1000000);
+	assert_int_equal(res, 3 * CHANNELS * 4);
+	assert_int_equal(hdr.cip_syt, 0x8000);
+
+	/* DBC goes from 3 to 7, none of them multiple of SYT_INTERVAL (8). */
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 5,
+								1000000);
+	assert_int_equal(res, 5 * CHANNELS * 4);
+	assert_int_equal(hdr.cip_dbc, 3);
+	assert_int_equal(hdr.cip_syt, AVTP_IECIIDC_SYT_NO_INFO);
+
+	/* Data block with DBC 8 is the 1st one, 1 ms + 0 ns. */
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 8,
+								1000000);
+	assert_int_equal(res, 8 * CHANNELS * 4);
+	assert_int_equal(hdr.cip_syt, 0x8000);
+
+	/* DBC 16 is the 1st one again. Reset DBC to start at 11, so DBC 16
+	 * is the 6th data block: 1 ms + 104166 ns.
+	 */
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS,
+								CHANNELS);
+	avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 8, 0);
+	avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 3, 0);
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 8,
+								1000000);
+	assert_int_equal(res, 8 * CHANNELS * 4);
+	assert_int_equal(hdr.cip_dbc, 11);
+	assert_int_equal(hdr.cip_syt, 0x89FF);
+
+	/* SYT wraps around every 16 cycles (2 ms). */
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS,
+								CHANNELS);
+	avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 3, 0);
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, 8,
+							4000000 + 1999000);
+	assert_int_equal(res, 8 * CHANNELS * 4);
+	assert_int_equal(hdr.cip_syt, 0x09E7);
+}
+
+static void ieciidc_am824_encode_no_data(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { 0 };
+	uint8_t payload[4];
+	int res;
+
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_96KHZ, CHANNELS,
+								CHANNELS);
+
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, NULL, 0, 0);
+	assert_int_equal(res, 0);
+	assert_int_equal(hdr.stream.stream_data_len, CIP_HDR_LEN);
+	assert_int_equal(hdr.cip_no_data, 0xFF);
+	assert_int_equal(hdr.cip_syt, AVTP_IECIIDC_SYT_NO_INFO);
+	assert_int_equal(hdr.cip_dbc, 0);
+}
+
+static void ieciidc_am824_round_trip(void **state)
+{
+	uint8_t pdu_buf[sizeof(struct avtp_stream_pdu) + CIP_HDR_LEN +
+							SAMPLES * 4];
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) pdu_buf;
+	struct avtp_ieciidc_cip_payload *pay;
+	struct avtp_ieciidc_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+		},
+		.tag = AVTP_IECIIDC_TAG_CIP,
+		.tcode = 0xA,
+		.cip_qi_2 = 2,
+	};
+	struct avtp_ieciidc_hdr rx_hdr;
+	struct avtp_ieciidc_am824 am;
+	int32_t samples[SAMPLES], decoded[SAMPLES];
+	size_t i;
+	int res;
+
+	init_s32(samples, SAMPLES);
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_192KHZ, CHANNELS,
+								CHANNELS);
+
+	pay = (struct avtp_ieciidc_cip_payload *) pdu->avtp_payload;
+	res = avtp_ieciidc_am824_encode(&am, &hdr, pay->cip_data_payload,
+						samples, FRAMES, 0);
+	assert_int_equal(res, SAMPLES * 4);
+
+	res = avtp_ieciidc_pdu_pack(pdu, &hdr);
+	assert_int_equal(res, 0);
+
+	res = avtp_ieciidc_pdu_unpack(pdu, &rx_hdr);
+	assert_int_equal(res, 0);
+	assert_int_equal(rx_hdr.cip_dbs, CHANNELS);
+	assert_int_equal(rx_hdr.cip_sfc, AVTP_IECIIDC_SFC_192KHZ);
+	assert_int_equal(rx_hdr.cip_syt, hdr.cip_syt);
+
+	res = avtp_ieciidc_am824_decode(&am, &rx_hdr, pay->cip_data_payload,
+							decoded, FRAMES);
+	assert_int_equal(res, FRAMES);
+
+	/* Only the 24 most significant bits make it through. */
+	for (i = 0; i < SAMPLES; i++)
+		assert_int_equal((uint32_t) decoded[i],
+				(uint32_t) samples[i] & 0xFFFFFF00);
+
+	/* Frames are bounded by the data blocks in the payload. */
+	res = avtp_ieciidc_am824_decode(&am, &rx_hdr, pay->cip_data_payload,
+							decoded, FRAMES + 1);
+	assert_int_equal(res, FRAMES);
+}
+
+static void ieciidc_am824_decode_padding(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { .tag = AVTP_IECIIDC_TAG_CIP };
+	int32_t samples[SAMPLES], decoded[SAMPLES];
+	uint8_t payload[FRAMES * (CHANNELS + 1) * 4];
+	size_t i;
+	int res;
+
+	init_s32(samples, SAMPLES);
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS + 1,
+								CHANNELS);
+
+	res = avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, FRAMES,
+									0);
+	assert_int_equal(res, sizeof(payload));
+
+	res = avtp_ieciidc_am824_decode(&am, &hdr, payload, decoded, FRAMES);
+	assert_int_equal(res, FRAMES);
+
+	for (i = 0; i < SAMPLES; i++)
+		assert_int_equal((uint32_t) decoded[i],
+				(uint32_t) samples[i] & 0xFFFFFF00);
+}
+
+static void ieciidc_am824_decode_invalid(void **state)
+{
+	struct avtp_ieciidc_am824 am;
+	struct avtp_ieciidc_hdr hdr = { .tag = AVTP_IECIIDC_TAG_CIP };
+	int32_t samples[SAMPLES] = { 0 };
+	uint8_t payload[SAMPLES * 4];
+	int res;
+
+	avtp_ieciidc_am824_init(&am, AVTP_IECIIDC_SFC_48KHZ, CHANNELS,
+								CHANNELS);
+	avtp_ieciidc_am824_encode(&am, &hdr, payload, samples, FRAMES, 0);
+
+	res = avtp_ieciidc_am824_decode(NULL, &hdr, payload, samples, FRAMES);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_decode(&am, NULL, payload, samples, FRAMES);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_decode(&am, &hdr, NULL, samples, FRAMES);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_ieciidc_am824_decode(&am, &hdr, payload, NULL, FRAMES);
+	assert_int_equal(res, -EINVAL);
+
+	/* Not AM824 data. */
+	hdr.cip_fmt = 0x20;
+	res = avtp_ieciidc_am824_decode(&am, &hdr, payload, samples, FRAMES);
+	assert_int_equal(res, -EINVAL);
+	hdr.cip_fmt = AVTP_IECIIDC_CIP_FMT_AM824;
+
+	/* Data block size not matching the converter. */
+	hdr.cip_dbs = CHANNELS + 1;
+	res = avtp_ieciidc_am824_decode(&am, &hdr, payload, samples, FRAMES);
+	assert_int_equal(res, -EINVAL);
+	hdr.cip_dbs = CHANNELS;
+
+	/* No CIP header. */
+	hdr.tag = AVTP_IECIIDC_TAG_NO_CIP;
+	res = avtp_ieciidc_am824_decode(&am, &hdr, payload, samples, FRAMES);
+	assert_int_equal(res, -EINVAL);
+	hdr.tag = AVTP_IECIIDC_TAG_CIP;
+
+	/* NO-DATA packets carry no frames. */
+	hdr.cip_no_data = 0xFF;
+	res = avtp_ieciidc_am824_decode(&am, &hdr, payload, samples, FRAMES);
+	assert_int_equal(res, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(ieciidc_am824_init_invalid),
+		cmocka_unit_test(ieciidc_am824_encode_invalid),
+		cmocka_unit_test(ieciidc_am824_encode),
+		cmocka_unit_test(ieciidc_am824_encode_padding),
+		cmocka_unit_test(ieciidc_am824_encode_syt),
+		cmocka_unit_test(ieciidc_am824_encode_no_data),
+		cmocka_unit_test(ieciidc_am824_round_trip),
+		cmocka_unit_test(ieciidc_am824_decode_padding),
+		cmocka_unit_test(ieciidc_am824_decode_invalid),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -1190,6 +1190,163 @@ static void ieciidc_pdu_init(void **state)
 	assert_true(ntohl(pdu.packet_info) == 0x000040A0);
 }
 
+static void ieciidc_pdu_unpack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_ieciidc_hdr hdr;
+
+	res = avtp_ieciidc_pdu_unpack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ieciidc_pdu_unpack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_ieciidc_pdu_unpack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ieciidc_pdu_unpack(void **state)
+{
+	int res;
+	struct avtp_ieciidc_hdr hdr;
+	struct avtp_stream_pdu *pdu = alloca(IECIIDC_PDU_HEADER_SIZE);
+	struct avtp_ieciidc_cip_payload *pay =
+			(struct avtp_ieciidc_cip_payload *) &pdu->avtp_payload;
+
+	pdu->subtype_data = htonl(0x0083AA00);
+	pdu->stream_id = htobe64(0xAABBCCDDEEFF0005);
+	pdu->avtp_time = htonl(0x80C0FFEE);
+	pdu->format_specific = htonl(0xCAFEBABE);
+	pdu->packet_info = htonl(0x00487FA5);
+	pay->cip_1 = htonl(0x3F06D4A5);
+	pay->cip_2 = htonl(0x90021234);
+
+	res = avtp_ieciidc_pdu_unpack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.stream.sv == 1);
+	assert_true(hdr.stream.tv == 1);
+	assert_true(hdr.stream.seq_num == 0xAA);
+	assert_true(hdr.stream.stream_id == 0xAABBCCDDEEFF0005);
+	assert_true(hdr.stream.timestamp == 0x80C0FFEE);
+	assert_true(hdr.stream.stream_data_len == 0x48);
+	assert_true(hdr.gv == 1);
+	assert_true(hdr.gateway_info == 0xCAFEBABE);
+	assert_true(hdr.tag == AVTP_IECIIDC_TAG_CIP);
+	assert_true(hdr.channel == 0x3F);
+	assert_true(hdr.tcode == 0xA);
+	assert_true(hdr.sy == 0x5);
+	assert_true(hdr.cip_qi_1 == 0);
+	assert_true(hdr.cip_sid == 0x3F);
+	assert_true(hdr.cip_dbs == 0x06);
+	assert_true(hdr.cip_fn == 0x3);
+	assert_true(hdr.cip_qpc == 0x2);
+	assert_true(hdr.cip_sph == 1);
+	assert_true(hdr.cip_dbc == 0xA5);
+	assert_true(hdr.cip_qi_2 == 2);
+	assert_true(hdr.cip_fmt == 0x10);
+	assert_true(hdr.cip_evt == 0);
+	assert_true(hdr.cip_sfc == 0x2);
+	assert_true(hdr.cip_n == 0);
+	assert_true(hdr.cip_no_data == 0x02);
+	assert_true(hdr.cip_syt == 0x1234);
+}
+
+static void ieciidc_pdu_unpack_no_cip(void **state)
+{
+	int res;
+	struct avtp_ieciidc_hdr hdr;
+	struct avtp_stream_pdu *pdu = alloca(IECIIDC_PDU_HEADER_SIZE);
+	struct avtp_ieciidc_cip_payload *pay =
+			(struct avtp_ieciidc_cip_payload *) &pdu->avtp_payload;
+
+	memset(pdu, 0, IECIIDC_PDU_HEADER_SIZE);
+	pdu->packet_info = htonl(0x000000A0);
+	pay->cip_1 = htonl(0x3F06D4A5);
+	pay->cip_2 = htonl(0x90021234);
+
+	res = avtp_ieciidc_pdu_unpack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.tag == AVTP_IECIIDC_TAG_NO_CIP);
+	assert_true(hdr.tcode == 0xA);
+	assert_true(hdr.cip_dbs == 0);
+	assert_true(hdr.cip_syt == 0);
+}
+
+static void ieciidc_pdu_pack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_ieciidc_hdr hdr = { 0 };
+
+	res = avtp_ieciidc_pdu_pack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ieciidc_pdu_pack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_ieciidc_pdu_pack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ieciidc_pdu_pack(void **state)
+{
+	int res;
+	struct avtp_ieciidc_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.seq_num = 0xAA,
+			.stream_id = 0xAABBCCDDEEFF0005,
+			.timestamp = 0x80C0FFEE,
+			.stream_data_len = 0x48,
+		},
+		.gv = 1,
+		.gateway_info = 0xCAFEBABE,
+		.tag = AVTP_IECIIDC_TAG_CIP,
+		.channel = 0x3F,
+		.tcode = 0xA,
+		.sy = 0x5,
+		.cip_sid = 0x3F,
+		.cip_dbs = 0x06,
+		.cip_fn = 0x3,
+		.cip_qpc = 0x2,
+		.cip_sph = 1,
+		.cip_dbc = 0xA5,
+		.cip_qi_2 = 2,
+		.cip_fmt = 0x10,
+		.cip_sfc = 0x2,
+		.cip_no_data = 0x02,
+		.cip_syt = 0x1234,
+	};
+	struct avtp_stream_pdu *pdu = alloca(IECIIDC_PDU_HEADER_SIZE);
+	struct avtp_ieciidc_cip_payload *pay =
+			(struct avtp_ieciidc_cip_payload *) &pdu->avtp_payload;
+
+	memset(pdu, 0xFF, IECIIDC_PDU_HEADER_SIZE);
+
+	res = avtp_ieciidc_pdu_pack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu->subtype_data) == 0x0083AA00);
+	assert_true(be64toh(pdu->stream_id) == 0xAABBCCDDEEFF0005);
+	assert_true(ntohl(pdu->avtp_time) == 0x80C0FFEE);
+	assert_true(ntohl(pdu->format_specific) == 0xCAFEBABE);
+	assert_true(ntohl(pdu->packet_info) == 0x00487FA5);
+	assert_true(ntohl(pay->cip_1) == 0x3F06D4A5);
+	assert_true(ntohl(pay->cip_2) == 0x90021234);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -1261,6 +1418,13 @@ int main(void)
 		cmocka_unit_test(ieciidc_pdu_init_null_pdu),
 		cmocka_unit_test(ieciidc_pdu_init_invalid_tag),
 		cmocka_unit_test(ieciidc_pdu_init),
+		cmocka_unit_test(ieciidc_pdu_unpack_null_pdu),
+		cmocka_unit_test(ieciidc_pdu_unpack_null_hdr),
+		cmocka_unit_test(ieciidc_pdu_unpack),
+		cmocka_unit_test(ieciidc_pdu_unpack_no_cip),
+		cmocka_unit_test(ieciidc_pdu_pack_null_pdu),
+		cmocka_unit_test(ieciidc_pdu_pack_null_hdr),
+		cmocka_unit_test(ieciidc_pdu_pack),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_ieciidc.h"
+#include "avtp_inline.h"
+#include "avtp_rvf.h"
+#include "avtp_tscf.h"
+
+static void inline_common_get(void **state)
+{
+	struct avtp_common_pdu pdu;
+
+	pdu.subtype_data = htonl(0x07A00000);
+
+	assert_true(avtp_common_get_subtype(&pdu) == AVTP_SUBTYPE_RVF);
+	assert_true(avtp_common_get_version(&pdu) == 0x2);
+}
+
+static void inline_common_set(void **state)
+{
+	struct avtp_common_pdu pdu;
+
+	pdu.subtype_data = htonl(0x00FFFFFF);
+
+	avtp_common_set_subtype(&pdu, AVTP_SUBTYPE_CRF);
+	avtp_common_set_version(&pdu, 0);
+
+	assert_true(ntohl(pdu.subtype_data) == 0x048FFFFF);
+}
+
+static void inline_stream_get(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	pdu.subtype_data = htonl(0x02895501);
+	pdu.stream_id = htobe64(0xAABBCCDDEEFF0001);
+	pdu.avtp_time = htonl(0x80C0FFEE);
+	pdu.packet_info = htonl(0xABCD1A00);
+
+	assert_true(avtp_stream_get_sv(&pdu) == 1);
+	assert_true(avtp_stream_get_mr(&pdu) == 1);
+	assert_true(avtp_stream_get_tv(&pdu) == 1);
+	assert_true(avtp_stream_get_seq_num(&pdu) == 0x55);
+	assert_true(avtp_stream_get_tu(&pdu) == 1);
+	assert_true(avtp_stream_get_stream_id(&pdu) == 0xAABBCCDDEEFF0001);
+	assert_true(avtp_stream_get_timestamp(&pdu) == 0x80C0FFEE);
+	assert_true(avtp_stream_get_stream_data_len(&pdu) == 0xABCD);
+}
+
+static void inline_stream_set(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	memset(&pdu, 0, sizeof(pdu));
+	pdu.subtype_data = htonl(0x02000000);
+	pdu.packet_info = htonl(0x00001A00);
+
+	avtp_stream_set_sv(&pdu, 1);
+	avtp_stream_set_mr(&pdu, 0);
+	avtp_stream_set_tv(&pdu, 1);
+	avtp_stream_set_seq_num(&pdu, 0x55);
+	avtp_stream_set_tu(&pdu, 1);
+	avtp_stream_set_stream_id(&pdu, 0xAABBCCDDEEFF0001);
+	avtp_stream_set_timestamp(&pdu, 0x80C0FFEE);
+	avtp_stream_set_stream_data_len(&pdu, 0xABCD);
+
+	assert_true(ntohl(pdu.subtype_data) == 0x02815501);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0001);
+	assert_true(ntohl(pdu.avtp_time) == 0x80C0FFEE);
+	assert_true(ntohl(pdu.packet_info) == 0xABCD1A00);
+}
+
+static void inline_stream_set_truncate(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	pdu.subtype_data = htonl(0xFFFFFFFF);
+
+	avtp_stream_set_seq_num(&pdu, 0x100);
+
+	assert_true(ntohl(pdu.subtype_data) == 0xFFFF00FF);
+}
+
+static void inline_aaf_get(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	pdu.format_specific = htonl(0x04500210);
+	pdu.packet_info = htonl(0x00041A00);
+
+	assert_true(avtp_aaf_get_format(&pdu) == AVTP_AAF_FORMAT_INT_16BIT);
+	assert_true(avtp_aaf_get_nsr(&pdu) == AVTP_AAF_PCM_NSR_48KHZ);
+	assert_true(avtp_aaf_get_chan_per_frame(&pdu) == 2);
+	assert_true(avtp_aaf_get_bit_depth(&pdu) == 16);
+	assert_true(avtp_aaf_get_sp(&pdu) == AVTP_AAF_PCM_SP_SPARSE);
+	assert_true(avtp_aaf_get_evt(&pdu) == 0xA);
+}
+
+static void inline_aaf_set(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_aaf_pdu_init(&pdu);
+	assert_int_equal(res, 0);
+
+	avtp_aaf_set_format(&pdu, AVTP_AAF_FORMAT_INT_16BIT);
+	avtp_aaf_set_nsr(&pdu, AVTP_AAF_PCM_NSR_48KHZ);
+	avtp_aaf_set_chan_per_frame(&pdu, 2);
+	avtp_aaf_set_bit_depth(&pdu, 16);
+	avtp_aaf_set_sp(&pdu, AVTP_AAF_PCM_SP_SPARSE);
+	avtp_aaf_set_evt(&pdu, 0xA);
+
+	assert_true(ntohl(pdu.format_specific) == 0x04500210);
+	assert_true(ntohl(pdu.packet_info) == 0x00001A00);
+
+	res = avtp_aaf_pdu_get(&pdu, AVTP_AAF_FIELD_CHAN_PER_FRAME, &val);
+	assert_int_equal(res, 0);
+	assert_true(val == 2);
+}
+
+static void inline_cvf_get(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	pdu.format_specific = htonl(0x02010000);
+	pdu.packet_info = htonl(0x05DC3F00);
+
+	assert_true(avtp_cvf_get_format(&pdu) == AVTP_CVF_FORMAT_RFC);
+	assert_true(avtp_cvf_get_format_subtype(&pdu) ==
+						AVTP_CVF_FORMAT_SUBTYPE_H264);
+	assert_true(avtp_cvf_get_h264_ptv(&pdu) == 1);
+	assert_true(avtp_cvf_get_m(&pdu) == 1);
+	assert_true(avtp_cvf_get_evt(&pdu) == 0xF);
+}
+
+static void inline_cvf_set(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	memset(&pdu, 0, sizeof(pdu));
+	pdu.packet_info = htonl(0x05DC0000);
+
+	avtp_cvf_set_format(&pdu, AVTP_CVF_FORMAT_RFC);
+	avtp_cvf_set_format_subtype(&pdu, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	avtp_cvf_set_h264_ptv(&pdu, 1);
+	avtp_cvf_set_m(&pdu, 1);
+	avtp_cvf_set_evt(&pdu, 0xF);
+
+	assert_true(ntohl(pdu.format_specific) == 0x02010000);
+	assert_true(ntohl(pdu.packet_info) == 0x05DC3F00);
+}
+
+static void inline_rvf_get(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	pdu.format_specific = htonl(0x07800438);
+	pdu.packet_info = htonl(0x1680BAC0);
+
+	assert_true(avtp_rvf_get_active_pixels(&pdu) == 1920);
+	assert_true(avtp_rvf_get_total_lines(&pdu) == 1080);
+	assert_true(avtp_rvf_get_ap(&pdu) == 1);
+	assert_true(avtp_rvf_get_f(&pdu) == 1);
+	assert_true(avtp_rvf_get_ef(&pdu) == 1);
+	assert_true(avtp_rvf_get_evt(&pdu) == 0xA);
+	assert_true(avtp_rvf_get_pd(&pdu) == 1);
+	assert_true(avtp_rvf_get_i(&pdu) == 1);
+}
+
+static void inline_rvf_set(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	memset(&pdu, 0, sizeof(pdu));
+	pdu.packet_info = htonl(0x16800000);
+
+	avtp_rvf_set_active_pixels(&pdu, 1920);
+	avtp_rvf_set_total_lines(&pdu, 1080);
+	avtp_rvf_set_ap(&pdu, 1);
+	avtp_rvf_set_f(&pdu, 1);
+	avtp_rvf_set_ef(&pdu, 1);
+	avtp_rvf_set_evt(&pdu, 0xA);
+	avtp_rvf_set_pd(&pdu, 1);
+	avtp_rvf_set_i(&pdu, 1);
+
+	assert_true(ntohl(pdu.format_specific) == 0x07800438);
+	assert_true(ntohl(pdu.packet_info) == 0x1680BAC0);
+}
+
+static void inline_ieciidc_get(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	pdu.subtype_data = htonl(0x0083AA00);
+	pdu.format_specific = htonl(0xCAFEBABE);
+	pdu.packet_info = htonl(0x00487FA5);
+
+	assert_true(avtp_ieciidc_get_gv(&pdu) == 1);
+	assert_true(avtp_ieciidc_get_gateway_info(&pdu) == 0xCAFEBABE);
+	assert_true(avtp_ieciidc_get_tag(&pdu) == AVTP_IECIIDC_TAG_CIP);
+	assert_true(avtp_ieciidc_get_channel(&pdu) == 0x3F);
+	assert_true(avtp_ieciidc_get_tcode(&pdu) == 0xA);
+	assert_true(avtp_ieciidc_get_sy(&pdu) == 0x5);
+}
+
+static void inline_ieciidc_set(void **state)
+{
+	struct avtp_stream_pdu pdu;
+
+	memset(&pdu, 0, sizeof(pdu));
+	pdu.subtype_data = htonl(0x0081AA00);
+	pdu.packet_info = htonl(0x00480000);
+
+	avtp_ieciidc_set_gv(&pdu, 1);
+	avtp_ieciidc_set_gateway_info(&pdu, 0xCAFEBABE);
+	avtp_ieciidc_set_tag(&pdu, AVTP_IECIIDC_TAG_CIP);
+	avtp_ieciidc_set_channel(&pdu, 0x3F);
+	avtp_ieciidc_set_tcode(&pdu, 0xA);
+	avtp_ieciidc_set_sy(&pdu, 0x5);
+
+	assert_true(ntohl(pdu.subtype_data) == 0x0083AA00);
+	assert_true(ntohl(pdu.format_specific) == 0xCAFEBABE);
+	assert_true(ntohl(pdu.packet_info) == 0x00487FA5);
+}
+
+static void inline_crf_get(void **state)
+{
+	struct avtp_crf_pdu pdu;
+
+	pdu.subtype_data = htonl(0x048B5501);
+	pdu.stream_id = htobe64(0xAABBCCDDEEFF0002);
+	pdu.packet_info = htobe64(0x4000BB80ABCD0160);
+
+	assert_true(avtp_crf_get_sv(&pdu) == 1);
+	assert_true(avtp_crf_get_mr(&pdu) == 1);
+	assert_true(avtp_crf_get_fs(&pdu) == 1);
+	assert_true(avtp_crf_get_tu(&pdu) == 1);
+	assert_true(avtp_crf_get_seq_num(&pdu) == 0x55);
+	assert_true(avtp_crf_get_type(&pdu) == AVTP_CRF_TYPE_AUDIO_SAMPLE);
+	assert_true(avtp_crf_get_stream_id(&pdu) == 0xAABBCCDDEEFF0002);
+	assert_true(avtp_crf_get_pull(&pdu) == AVTP_CRF_PULL_MULT_BY_1_001);
+	assert_true(avtp_crf_get_base_freq(&pdu) == 48000);
+	assert_true(avtp_crf_get_crf_data_len(&pdu) == 0xABCD);
+	assert_true(avtp_crf_get_timestamp_interval(&pdu) == 0x160);
+}
+
+static void inline_crf_set(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_crf_pdu pdu;
+
+	res = avtp_crf_pdu_init(&pdu);
+	assert_int_equal(res, 0);
+
+	avtp_crf_set_mr(&pdu, 1);
+	avtp_crf_set_fs(&pdu, 1);
+	avtp_crf_set_tu(&pdu, 1);
+	avtp_crf_set_seq_num(&pdu, 0x55);
+	avtp_crf_set_type(&pdu, AVTP_CRF_TYPE_AUDIO_SAMPLE);
+	avtp_crf_set_stream_id(&pdu, 0xAABBCCDDEEFF0002);
+	avtp_crf_set_pull(&pdu, AVTP_CRF_PULL_MULT_BY_1_001);
+	avtp_crf_set_base_freq(&pdu, 48000);
+	avtp_crf_set_crf_data_len(&pdu, 0xABCD);
+	avtp_crf_set_timestamp_interval(&pdu, 0x160);
+
+	assert_true(ntohl(pdu.subtype_data) == 0x048B5501);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0002);
+	assert_true(be64toh(pdu.packet_info) == 0x4000BB80ABCD0160);
+
+	res = avtp_crf_pdu_get(&pdu, AVTP_CRF_FIELD_BASE_FREQ, &val);
+	assert_int_equal(res, 0);
+	assert_true(val == 48000);
+}
+
+static void inline_ntscf_get(void **state)
+{
+	struct avtp_ntscf_pdu pdu;
+
+	pdu.subtype_data = htonl(0x828123AA);
+	pdu.stream_id = htobe64(0xAABBCCDDEEFF0003);
+
+	assert_true(avtp_ntscf_get_sv(&pdu) == 1);
+	assert_true(avtp_ntscf_get_data_len(&pdu) == 0x123);
+	assert_true(avtp_ntscf_get_seq_num(&pdu) == 0xAA);
+	assert_true(avtp_ntscf_get_stream_id(&pdu) == 0xAABBCCDDEEFF0003);
+}
+
+static void inline_ntscf_set(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu;
+
+	res = avtp_ntscf_pdu_init(&pdu);
+	assert_int_equal(res, 0);
+
+	avtp_ntscf_set_data_len(&pdu, 0x123);
+	avtp_ntscf_set_seq_num(&pdu, 0xAA);
+	avtp_ntscf_set_stream_id(&pdu, 0xAABBCCDDEEFF0003);
+
+	assert_true(ntohl(pdu.subtype_data) == 0x828123AA);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0003);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(inline_common_get),
+		cmocka_unit_test(inline_common_set),
+		cmocka_unit_test(inline_stream_get),
+		cmocka_unit_test(inline_stream_set),
+		cmocka_unit_test(inline_stream_set_truncate),
+		cmocka_unit_test(inline_aaf_get),
+		cmocka_unit_test(inline_aaf_set),
+		cmocka_unit_test(inline_cvf_get),
+		cmocka_unit_test(inline_cvf_set),
+		cmocka_unit_test(inline_rvf_get),
+		cmocka_unit_test(inline_rvf_set),
+		cmocka_unit_test(inline_ieciidc_get),
+		cmocka_unit_test(inline_ieciidc_set),
+		cmocka_unit_test(inline_crf_get),
+		cmocka_unit_test(inline_crf_set),
+		cmocka_unit_test(inline_ntscf_get),
+		cmocka_unit_test(inline_ntscf_set),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
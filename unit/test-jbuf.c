@@ -0,0 +1,552 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp_jbuf.h"
+#include "avtp_stats.h"
+
+#define NSEC_PER_SEC		1000000000ULL
+#define SAMPLE_RATE		48000
+#define BLOCK_FRAMES		6
+#define BLOCKS			8
+#define RING_FRAMES		(BLOCK_FRAMES * BLOCKS)
+/* Duration of a block, in ns. */
+#define STEP			125000
+#define MAX_DELAY		(4 * STEP)
+#define MTT			2000000
+/* Presentation time of the first frame. */
+#define BASE_TIME		1000000000ULL
+
+/* Frames are 32-bit words holding their frame number plus one, so missing
+ * frames, zero-filled, are told apart.
+ */
+typedef uint32_t frame_t;
+
+static uint64_t frame_time(unsigned int n)
+{
+	return BASE_TIME + ((uint64_t) n * NSEC_PER_SEC + SAMPLE_RATE / 2) /
+							SAMPLE_RATE;
+}
+
+static struct avtp_jbuf *create_jbuf(enum avtp_jbuf_conceal conceal)
+{
+	struct avtp_jbuf *jbuf;
+	struct avtp_jbuf_config cfg = {
+		.frame_size = sizeof(frame_t),
+		.block_frames = BLOCK_FRAMES,
+		.blocks = BLOCKS,
+		.sample_rate = SAMPLE_RATE,
+		.min_delay = 0,
+		.max_delay = MAX_DELAY,
+		.conceal = conceal,
+	};
+	int res;
+
+	res = avtp_jbuf_create(&jbuf, &cfg);
+	assert_int_equal(res, 0);
+
+	return jbuf;
+}
+
+/* Store frames [first, first + count) as a PDU with sequence number 'seq'.
+ * If 'timed' is not set, the PDU carries no presentation time.
+ */
+static int put_frames(struct avtp_jbuf *jbuf, unsigned int first,
+				unsigned int count, uint8_t seq, int timed)
+{
+	frame_t frames[RING_FRAMES * 2];
+	unsigned int i;
+
+	for (i = 0; i < count; i++)
+		frames[i] = first + i + 1;
+
+	return avtp_jbuf_put(jbuf, timed ? frame_time(first) : 0, seq,
+							frames, count);
+}
+
+static void get_block(struct avtp_jbuf *jbuf, frame_t block[BLOCK_FRAMES])
+{
+	int res;
+
+	res = avtp_jbuf_get(jbuf, UINT64_MAX, block);
+	assert_int_equal(res, 0);
+}
+
+static void jbuf_create_invalid(void **state)
+{
+	struct avtp_jbuf *jbuf;
+	struct avtp_jbuf_config cfg = {
+		.frame_size = sizeof(frame_t),
+		.block_frames = BLOCK_FRAMES,
+		.blocks = BLOCKS,
+		.sample_rate = SAMPLE_RATE,
+		.max_delay = MAX_DELAY,
+	};
+	struct avtp_jbuf_config bad;
+
+	assert_int_equal(avtp_jbuf_create(NULL, &cfg), -EINVAL);
+	assert_int_equal(avtp_jbuf_create(&jbuf, NULL), -EINVAL);
+
+	bad = cfg;
+	bad.frame_size = 0;
+	assert_int_equal(avtp_jbuf_create(&jbuf, &bad), -EINVAL);
+
+	bad = cfg;
+	bad.block_frames = 0;
+	assert_int_equal(avtp_jbuf_create(&jbuf, &bad), -EINVAL);
+
+	bad = cfg;
+	bad.sample_rate = 0;
+	assert_int_equal(avtp_jbuf_create(&jbuf, &bad), -EINVAL);
+
+	bad = cfg;
+	bad.min_delay = MAX_DELAY + 1;
+	assert_int_equal(avtp_jbuf_create(&jbuf, &bad), -EINVAL);
+
+	/* The ring only holds 1 ms worth of frames. */
+	bad = cfg;
+	bad.max_delay = 1000000;
+	assert_int_equal(avtp_jbuf_create(&jbuf, &bad), -EINVAL);
+
+	bad = cfg;
+	bad.conceal = AVTP_JBUF_CONCEAL_REPEAT + 1;
+	assert_int_equal(avtp_jbuf_create(&jbuf, &bad), -EINVAL);
+}
+
+static void jbuf_null_args(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	struct avtp_stats *stream_stats;
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+
+	assert_int_equal(avtp_stats_create(&stream_stats, MTT), 0);
+
+	assert_int_equal(avtp_jbuf_put(NULL, BASE_TIME, 0, block, 1),
+								-EINVAL);
+	assert_int_equal(avtp_jbuf_put(jbuf, BASE_TIME, 0, NULL, 1), -EINVAL);
+	assert_int_equal(avtp_jbuf_put(jbuf, BASE_TIME, 0, block, 0),
+								-EINVAL);
+	assert_int_equal(avtp_jbuf_next(NULL, &time), -EINVAL);
+	assert_int_equal(avtp_jbuf_next(jbuf, NULL), -EINVAL);
+	assert_int_equal(avtp_jbuf_get(NULL, 0, block), -EINVAL);
+	assert_int_equal(avtp_jbuf_get(jbuf, 0, NULL), -EINVAL);
+	assert_int_equal(avtp_jbuf_adapt(NULL, stream_stats), -EINVAL);
+	assert_int_equal(avtp_jbuf_adapt(jbuf, NULL), -EINVAL);
+	assert_int_equal(avtp_jbuf_get_stats(NULL, &stats), -EINVAL);
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, NULL), -EINVAL);
+
+	avtp_stats_destroy(stream_stats);
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_not_started(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), -ENOENT);
+	assert_int_equal(avtp_jbuf_get(jbuf, UINT64_MAX, block), -EAGAIN);
+
+	/* Without any PDU placed, there is nothing to place this one
+	 * relative to.
+	 */
+	assert_int_equal(put_frames(jbuf, 0, 6, 0, 0), 0);
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), -ENOENT);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_in_order(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+	unsigned int i, j;
+
+	for (i = 0; i < 4; i++)
+		assert_int_equal(put_frames(jbuf, i * 3, 3, i, 1), 3);
+
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), 0);
+	assert_int_equal(time, BASE_TIME);
+
+	/* Blocks are only played once due. */
+	assert_int_equal(avtp_jbuf_get(jbuf, BASE_TIME - 1, block), -EAGAIN);
+
+	for (i = 0; i < 2; i++) {
+		assert_int_equal(avtp_jbuf_get(jbuf, frame_time(i * 6),
+								block), 0);
+		for (j = 0; j < BLOCK_FRAMES; j++)
+			assert_int_equal(block[j], i * 6 + j + 1);
+	}
+
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), 0);
+	assert_int_equal(time, frame_time(12));
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.played, 12);
+	assert_int_equal(stats.concealed, 0);
+	assert_int_equal(stats.late, 0);
+	assert_int_equal(stats.overflows, 0);
+	assert_int_equal(stats.delay, 0);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_reorder(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	frame_t block[BLOCK_FRAMES];
+	unsigned int i;
+
+	assert_int_equal(put_frames(jbuf, 0, 2, 0, 1), 2);
+	assert_int_equal(put_frames(jbuf, 4, 2, 2, 1), 2);
+	assert_int_equal(put_frames(jbuf, 2, 2, 1, 1), 2);
+
+	get_block(jbuf, block);
+	for (i = 0; i < 4; i++)
+		assert_int_equal(block[i], i + 1);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_conceal_zero(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	frame_t block[BLOCK_FRAMES];
+
+	assert_int_equal(put_frames(jbuf, 0, 2, 0, 1), 2);
+	assert_int_equal(put_frames(jbuf, 4, 2, 2, 1), 2);
+
+	get_block(jbuf, block);
+	assert_int_equal(block[1], 2);
+	assert_int_equal(block[2], 0);
+	assert_int_equal(block[3], 0);
+	assert_int_equal(block[4], 5);
+
+	/* A block with no frame at all is played as silence too. */
+	get_block(jbuf, block);
+	assert_int_equal(block[0], 0);
+	assert_int_equal(block[5], 0);
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.played, 12);
+	assert_int_equal(stats.concealed, 8);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_conceal_repeat(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_REPEAT);
+	frame_t block[BLOCK_FRAMES];
+	unsigned int i;
+
+	assert_int_equal(put_frames(jbuf, 0, 6, 0, 1), 6);
+	assert_int_equal(put_frames(jbuf, 6, 3, 1, 1), 3);
+
+	get_block(jbuf, block);
+
+	get_block(jbuf, block);
+	assert_int_equal(block[0], 7);
+	assert_int_equal(block[2], 9);
+	assert_int_equal(block[3], 4);
+	assert_int_equal(block[5], 6);
+
+	/* Concealed frames are repeated again if need be. */
+	get_block(jbuf, block);
+	for (i = 0; i < 3; i++)
+		assert_int_equal(block[i], 7 + i);
+	assert_int_equal(block[3], 4);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_late(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	frame_t block[BLOCK_FRAMES];
+
+	assert_int_equal(put_frames(jbuf, 0, 2, 0, 1), 2);
+	get_block(jbuf, block);
+
+	/* PDU straddling the block already played. */
+	assert_int_equal(put_frames(jbuf, 4, 4, 1, 1), 2);
+	assert_int_equal(put_frames(jbuf, 2, 2, 2, 1), 0);
+
+	get_block(jbuf, block);
+	assert_int_equal(block[0], 7);
+	assert_int_equal(block[1], 8);
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.late, 4);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_late_before_base(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	frame_t block[BLOCK_FRAMES];
+	unsigned int i;
+
+	/* PDU reordered to start a frame before the first one stored, i.e.
+	 * before the time base, keeps the frames held.
+	 */
+	assert_int_equal(put_frames(jbuf, 6, 6, 1, 1), 6);
+	assert_int_equal(put_frames(jbuf, 5, 2, 0, 1), 1);
+
+	get_block(jbuf, block);
+	for (i = 0; i < BLOCK_FRAMES; i++)
+		assert_int_equal(block[i], 6 + i + 1);
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.late, 1);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_late_after_base(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+	unsigned int i, n;
+
+	/* Play a second worth of frames, so the time base moves ahead. */
+	for (n = 0; n < SAMPLE_RATE; n += BLOCK_FRAMES) {
+		assert_int_equal(put_frames(jbuf, n, BLOCK_FRAMES, n / 6, 1),
+								BLOCK_FRAMES);
+		get_block(jbuf, block);
+	}
+
+	assert_int_equal(put_frames(jbuf, n, BLOCK_FRAMES, n / 6, 1),
+								BLOCK_FRAMES);
+
+	/* PDU for the block just played is late, and neither moves the
+	 * playout position nor drops the block queued.
+	 */
+	assert_int_equal(put_frames(jbuf, n - BLOCK_FRAMES, BLOCK_FRAMES,
+						n / 6 - 1, 1), 0);
+
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), 0);
+	assert_int_equal(time, frame_time(n));
+
+	get_block(jbuf, block);
+	for (i = 0; i < BLOCK_FRAMES; i++)
+		assert_int_equal(block[i], n + i + 1);
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.late, BLOCK_FRAMES);
+	assert_int_equal(stats.concealed, 0);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_overflow(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+
+	assert_int_equal(put_frames(jbuf, 0, 1, 0, 1), 1);
+	assert_int_equal(put_frames(jbuf, RING_FRAMES - 2, 4, 1, 1), 2);
+	assert_int_equal(put_frames(jbuf, RING_FRAMES + 4, 4, 2, 1), 0);
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.overflows, 6);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_seq_placement(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	frame_t block[BLOCK_FRAMES];
+
+	/* Sequence numbers wrap around from 255 to 0. */
+	assert_int_equal(put_frames(jbuf, 0, 2, 254, 1), 2);
+	assert_int_equal(put_frames(jbuf, 4, 2, 0, 0), 2);
+	/* Reordered PDUs are placed before the last one. */
+	assert_int_equal(put_frames(jbuf, 2, 2, 255, 0), 2);
+
+	get_block(jbuf, block);
+	assert_int_equal(block[2], 3);
+	assert_int_equal(block[4], 5);
+	assert_int_equal(block[5], 6);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_wraparound(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+	unsigned int i, n;
+
+	/* Play 2 seconds worth of frames, so both the ring and the time base
+	 * wrap around, checking no frame drifts from its block.
+	 */
+	for (n = 0; n < 2 * SAMPLE_RATE; n += BLOCK_FRAMES) {
+		assert_int_equal(put_frames(jbuf, n, BLOCK_FRAMES, n / 6, 1),
+								BLOCK_FRAMES);
+
+		assert_int_equal(avtp_jbuf_next(jbuf, &time), 0);
+		assert_int_equal(time, frame_time(n));
+
+		get_block(jbuf, block);
+		for (i = 0; i < BLOCK_FRAMES; i++)
+			assert_int_equal(block[i], n + i + 1);
+	}
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_restart(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+
+	assert_int_equal(put_frames(jbuf, 0, 6, 0, 1), 6);
+
+	/* Presentation time jumping a second ahead restarts the buffer, so
+	 * frames held are dropped.
+	 */
+	assert_int_equal(put_frames(jbuf, SAMPLE_RATE, 6, 1, 1), 6);
+
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), 0);
+	assert_int_equal(time, frame_time(SAMPLE_RATE));
+
+	get_block(jbuf, block);
+	assert_int_equal(block[0], SAMPLE_RATE + 1);
+
+	avtp_jbuf_destroy(jbuf);
+}
+
+static void jbuf_adapt(void **state)
+{
+	struct avtp_jbuf *jbuf = create_jbuf(AVTP_JBUF_CONCEAL_ZERO);
+	struct avtp_jbuf_stats stats;
+	struct avtp_stats *stream_stats;
+	frame_t block[BLOCK_FRAMES];
+	uint64_t time;
+	unsigned int i;
+
+	assert_int_equal(avtp_stats_create(&stream_stats, MTT), 0);
+
+	/* Nothing seen yet, so there is nothing to adapt to. */
+	assert_int_equal(avtp_jbuf_adapt(jbuf, stream_stats), 0);
+
+	assert_int_equal(put_frames(jbuf, 0, 6, 0, 1), 6);
+	get_block(jbuf, block);
+
+	/* Late frames grow the delay a block at a time, up to the max. */
+	for (i = 1; i <= 5; i++) {
+		assert_int_equal(put_frames(jbuf, 0, 6, 0, 1), 0);
+		assert_int_equal(avtp_jbuf_adapt(jbuf, stream_stats),
+								i <= 4);
+	}
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.delay, MAX_DELAY);
+	assert_int_equal(avtp_jbuf_next(jbuf, &time), 0);
+	assert_int_equal(time, frame_time(6) + MAX_DELAY);
+
+	/* PDUs arriving right at their presentation time have no slack, so
+	 * a block worth of delay is still needed for the last frame of each
+	 * block to make it.
+	 */
+	for (i = 1; i <= 4; i++) {
+		unsigned int j;
+
+		for (j = 0; j < 100; j++)
+			avtp_stats_track_time(stream_stats, BASE_TIME,
+								BASE_TIME);
+		assert_int_equal(avtp_jbuf_adapt(jbuf, stream_stats),
+								i <= 3);
+	}
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.delay, STEP);
+
+	/* PDUs arriving 1 ms ahead can do without any delay, even with a
+	 * few stragglers.
+	 */
+	for (i = 0; i < 100; i++)
+		avtp_stats_track_time(stream_stats, BASE_TIME,
+							BASE_TIME - 1000000);
+	avtp_stats_track_time(stream_stats, BASE_TIME, BASE_TIME + 1);
+	assert_int_equal(avtp_jbuf_adapt(jbuf, stream_stats), 1);
+	for (i = 0; i < 100; i++)
+		avtp_stats_track_time(stream_stats, BASE_TIME,
+							BASE_TIME - 1000000);
+	assert_int_equal(avtp_jbuf_adapt(jbuf, stream_stats), 0);
+
+	assert_int_equal(avtp_jbuf_get_stats(jbuf, &stats), 0);
+	assert_int_equal(stats.delay, 0);
+
+	avtp_stats_destroy(stream_stats);
+	avtp_jbuf_destroy(jbuf);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(jbuf_create_invalid),
+		cmocka_unit_test(jbuf_null_args),
+		cmocka_unit_test(jbuf_not_started),
+		cmocka_unit_test(jbuf_in_order),
+		cmocka_unit_test(jbuf_reorder),
+		cmocka_unit_test(jbuf_conceal_zero),
+		cmocka_unit_test(jbuf_conceal_repeat),
+		cmocka_unit_test(jbuf_late),
+		cmocka_unit_test(jbuf_late_before_base),
+		cmocka_unit_test(jbuf_late_after_base),
+		cmocka_unit_test(jbuf_overflow),
+		cmocka_unit_test(jbuf_seq_placement),
+		cmocka_unit_test(jbuf_wraparound),
+		cmocka_unit_test(jbuf_restart),
+		cmocka_unit_test(jbuf_adapt),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,643 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+#include <endian.h>
+#include <linux/if_ether.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_classifier.h"
+#include "avtp_net.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define DATA_LEN		4
+#define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
+#define NUM_PDUS		10
+/* Capture times of PDUs: 1 ms apart, starting at 1 s. */
+#define TIME_START		1000000000ULL
+#define TIME_STEP		1000000ULL
+
+static const uint8_t macaddr[ETH_ALEN] = { 0x01, 0x1B, 0x19, 0x00, 0x00, 0x01 };
+
+static char path[] = "/tmp/test-net-pcap-XXXXXX";
+
+static int setup(void **state)
+{
+	int fd = mkstemp(path);
+
+	if (fd < 0)
+		return -1;
+
+	close(fd);
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	unlink(path);
+	return 0;
+}
+
+static void init_template(struct avtp_stream_pdu *tmpl)
+{
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = STREAM_ID,
+			.stream_data_len = DATA_LEN,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+	};
+
+	assert_int_equal(avtp_aaf_pdu_pack(tmpl, &hdr), 0);
+}
+
+/* Record NUM_PDUS PDUs from a single stream, with sequence numbers and
+ * timestamps counting from 0, into the test file.
+ */
+static void record_pdus(unsigned int snaplen)
+{
+	struct avtp_net_capture_config cfg = {
+		.path = path,
+		.snaplen = snaplen,
+	};
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	uint8_t bufs[NUM_PDUS][PDU_SIZE];
+	struct avtp_net_capture_stats stats;
+	struct avtp_stream_pdu tmpl;
+	struct avtp_net_capture *cap;
+	uint64_t times[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	int i, res;
+
+	memcpy(cfg.dst_addr, macaddr, ETH_ALEN);
+	init_template(&tmpl);
+
+	for (i = 0; i < NUM_PDUS; i++) {
+		struct avtp_stream_pdu *pdu;
+
+		pdu = (struct avtp_stream_pdu *) bufs[i];
+		res = avtp_stream_pdu_emit(pdu, &tmpl, i, i * 1000, DATA_LEN);
+		assert_int_equal(res, 0);
+		memset(pdu->avtp_payload, i, DATA_LEN);
+
+		pdus[i] = pdu;
+		lens[i] = PDU_SIZE;
+		times[i] = TIME_START + i * TIME_STEP;
+	}
+
+	res = avtp_net_capture_create(&cap, &cfg);
+	assert_int_equal(res, 0);
+
+	/* Record PDUs over two calls, flushing in between. */
+	res = avtp_net_capture_write(cap, pdus, lens, times, 4);
+	assert_int_equal(res, 4);
+	res = avtp_net_capture_flush(cap);
+	assert_int_equal(res, 0);
+	res = avtp_net_capture_write(cap, pdus + 4, lens + 4, times + 4,
+								NUM_PDUS - 4);
+	assert_int_equal(res, NUM_PDUS - 4);
+
+	res = avtp_net_capture_get_stats(cap, &stats);
+	assert_int_equal(res, 0);
+	assert_int_equal(stats.pdus, NUM_PDUS);
+	assert_int_equal(stats.dropped, 0);
+
+	avtp_net_capture_destroy(cap);
+}
+
+static struct avtp_net_replay *create_replay(double speed, bool loop)
+{
+	struct avtp_net_replay_config cfg = {
+		.path = path,
+		.speed = speed,
+		.loop = loop,
+	};
+	struct avtp_net_replay *rp;
+
+	assert_int_equal(avtp_net_replay_create(&rp, &cfg), 0);
+
+	return rp;
+}
+
+static void check_pdu(const struct avtp_stream_pdu *pdu, unsigned int seq)
+{
+	uint8_t data[DATA_LEN];
+
+	assert_int_equal((ntohl(pdu->subtype_data) >> 8) & 0xFF, seq);
+	assert_int_equal(ntohl(pdu->avtp_time), seq * 1000);
+
+	memset(data, seq, DATA_LEN);
+	assert_memory_equal(pdu->avtp_payload, data, DATA_LEN);
+}
+
+static void write_file(const void *data, size_t len)
+{
+	FILE *f = fopen(path, "w");
+
+	assert_non_null(f);
+	assert_int_equal(fwrite(data, 1, len, f), len);
+	fclose(f);
+}
+
+static void net_capture_create_null_cap(void **state)
+{
+	struct avtp_net_capture_config cfg = { .path = path };
+	int res;
+
+	res = avtp_net_capture_create(NULL, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_capture_create_null_cfg(void **state)
+{
+	struct avtp_net_capture *cap;
+	int res;
+
+	res = avtp_net_capture_create(&cap, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_capture_create_null_path(void **state)
+{
+	struct avtp_net_capture_config cfg = { 0 };
+	struct avtp_net_capture *cap;
+	int res;
+
+	res = avtp_net_capture_create(&cap, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_capture_create_invalid_snaplen(void **state)
+{
+	struct avtp_net_capture_config cfg = {
+		.path = path,
+		.snaplen = ETH_HLEN - 1,
+	};
+	struct avtp_net_capture *cap;
+	int res;
+
+	res = avtp_net_capture_create(&cap, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_capture_create_small_buffer(void **state)
+{
+	struct avtp_net_capture_config cfg = {
+		.path = path,
+		.buffer_size = 4096,
+	};
+	struct avtp_net_capture *cap;
+	int res;
+
+	/* Segments can't hold a full frame, but can with a snaplen. */
+	res = avtp_net_capture_create(&cap, &cfg);
+	assert_int_equal(res, -EINVAL);
+
+	cfg.snaplen = 128;
+	res = avtp_net_capture_create(&cap, &cfg);
+	assert_int_equal(res, 0);
+	avtp_net_capture_destroy(cap);
+}
+
+static void net_capture_create_invalid_path(void **state)
+{
+	struct avtp_net_capture_config cfg = {
+		.path = "/nonexistent/capture.pcapng",
+	};
+	struct avtp_net_capture *cap;
+	int res;
+
+	res = avtp_net_capture_create(&cap, &cfg);
+
+	assert_int_equal(res, -ENOENT);
+}
+
+static void net_capture_null_cap(void **state)
+{
+	const struct avtp_stream_pdu *pdus[1] = { NULL };
+	struct avtp_net_capture_stats stats;
+	uint64_t times[1] = { 0 };
+	size_t lens[1] = { 0 };
+
+	assert_int_equal(avtp_net_capture_write(NULL, pdus, lens, times, 1),
+								-EINVAL);
+	assert_int_equal(avtp_net_capture_flush(NULL), -EINVAL);
+	assert_int_equal(avtp_net_capture_get_stats(NULL, &stats), -EINVAL);
+}
+
+static void net_capture_write_null_times(void **state)
+{
+	struct avtp_net_capture_config cfg = { .path = path };
+	const struct avtp_stream_pdu *pdus[1];
+	struct avtp_net_capture *cap;
+	size_t lens[1];
+	int res;
+
+	res = avtp_net_capture_create(&cap, &cfg);
+	assert_int_equal(res, 0);
+
+	res = avtp_net_capture_write(cap, pdus, lens, NULL, 1);
+
+	assert_int_equal(res, -EINVAL);
+	avtp_net_capture_destroy(cap);
+}
+
+static void net_replay_create_null_rp(void **state)
+{
+	struct avtp_net_replay_config cfg = { .path = path };
+	int res;
+
+	res = avtp_net_replay_create(NULL, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_replay_create_invalid_speed(void **state)
+{
+	struct avtp_net_replay_config cfg = { .path = path, .speed = -1.0 };
+	struct avtp_net_replay *rp;
+	int res;
+
+	res = avtp_net_replay_create(&rp, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_replay_create_invalid_path(void **state)
+{
+	struct avtp_net_replay_config cfg = {
+		.path = "/nonexistent/capture.pcapng",
+	};
+	struct avtp_net_replay *rp;
+	int res;
+
+	res = avtp_net_replay_create(&rp, &cfg);
+
+	assert_int_equal(res, -ENOENT);
+}
+
+static void net_replay_create_not_pcapng(void **state)
+{
+	struct avtp_net_replay_config cfg = { .path = path };
+	struct avtp_net_replay *rp;
+	uint8_t data[64] = { 0xD4, 0xC3, 0xB2, 0xA1 };
+	int res;
+
+	/* Legacy pcap files are not supported, nor empty files. */
+	write_file(data, sizeof(data));
+	res = avtp_net_replay_create(&rp, &cfg);
+	assert_int_equal(res, -EBADMSG);
+
+	write_file(data, 0);
+	res = avtp_net_replay_create(&rp, &cfg);
+	assert_int_equal(res, -EBADMSG);
+}
+
+static void net_replay_null_rp(void **state)
+{
+	const struct avtp_stream_pdu *pdus[1];
+	struct avtp_classifier_result results[1];
+	struct avtp_classifier *cls = (struct avtp_classifier *) pdus;
+	uint64_t deadline;
+	size_t lens[1];
+
+	assert_int_equal(avtp_net_replay_recv(NULL, pdus, lens, NULL, 1),
+								-EINVAL);
+	assert_int_equal(avtp_net_replay_classify(NULL, cls, pdus, lens, NULL,
+							results, 1), -EINVAL);
+	assert_int_equal(avtp_net_replay_get_deadline(NULL, &deadline),
+								-EINVAL);
+	assert_int_equal(avtp_net_replay_rewind(NULL), -EINVAL);
+}
+
+static void net_replay_recv(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	uint64_t times[NUM_PDUS], deadline;
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	int i, res;
+
+	record_pdus(0);
+	rp = create_replay(0, false);
+
+	/* Unpaced PDUs are due right away. */
+	res = avtp_net_replay_get_deadline(rp, &deadline);
+	assert_int_equal(res, 0);
+	assert_int_equal(deadline, 0);
+
+	res = avtp_net_replay_recv(rp, pdus, lens, times, NUM_PDUS);
+	assert_int_equal(res, NUM_PDUS);
+
+	for (i = 0; i < NUM_PDUS; i++) {
+		assert_int_equal(lens[i], PDU_SIZE);
+		assert_int_equal(times[i], TIME_START + i * TIME_STEP);
+		check_pdu(pdus[i], i);
+	}
+
+	res = avtp_net_replay_recv(rp, pdus, lens, times, NUM_PDUS);
+	assert_int_equal(res, -ENODATA);
+	res = avtp_net_replay_get_deadline(rp, &deadline);
+	assert_int_equal(res, -ENODATA);
+
+	/* Once rewound, the same PDUs are returned again. */
+	res = avtp_net_replay_rewind(rp);
+	assert_int_equal(res, 0);
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, 3);
+	assert_int_equal(res, 3);
+	check_pdu(pdus[0], 0);
+
+	avtp_net_replay_destroy(rp);
+}
+
+static void net_replay_snaplen(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	int res;
+
+	/* Frames are truncated right after the PDU header. */
+	record_pdus(ETH_HLEN + sizeof(struct avtp_stream_pdu));
+	rp = create_replay(0, false);
+
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, NUM_PDUS);
+
+	assert_int_equal(res, NUM_PDUS);
+	assert_int_equal(lens[0], sizeof(struct avtp_stream_pdu));
+	assert_int_equal(ntohl(pdus[NUM_PDUS - 1]->avtp_time),
+						(NUM_PDUS - 1) * 1000);
+	avtp_net_replay_destroy(rp);
+}
+
+static void net_replay_loop(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	int res;
+
+	record_pdus(0);
+	rp = create_replay(0, true);
+
+	/* PDUs from both ends of the file are never returned together. */
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, NUM_PDUS - 1);
+	assert_int_equal(res, NUM_PDUS - 1);
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, NUM_PDUS);
+	assert_int_equal(res, 1);
+	check_pdu(pdus[0], NUM_PDUS - 1);
+
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, NUM_PDUS);
+	assert_int_equal(res, NUM_PDUS);
+	check_pdu(pdus[0], 0);
+
+	avtp_net_replay_destroy(rp);
+}
+
+static void net_replay_paced(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	uint64_t times[NUM_PDUS], deadline, start;
+	struct timespec ts;
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	int res;
+
+	record_pdus(0);
+	rp = create_replay(1.0, false);
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	start = ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+	/* The first PDU is due right away, the second one a TIME_STEP
+	 * later.
+	 */
+	res = avtp_net_replay_recv(rp, pdus, lens, times, NUM_PDUS);
+	assert_int_equal(res, 1);
+	assert_int_equal(times[0], TIME_START);
+
+	res = avtp_net_replay_get_deadline(rp, &deadline);
+	assert_int_equal(res, 0);
+	assert_true(deadline >= start + TIME_STEP);
+	assert_true(deadline < start + 2 * TIME_STEP);
+
+	ts.tv_sec = deadline / 1000000000ULL;
+	ts.tv_nsec = deadline % 1000000000ULL;
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+	res = avtp_net_replay_recv(rp, pdus, lens, times, NUM_PDUS);
+	assert_int_equal(res, 1);
+	assert_int_equal(times[0], TIME_START + TIME_STEP);
+	check_pdu(pdus[0], 1);
+
+	avtp_net_replay_destroy(rp);
+}
+
+static void net_replay_classify(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	struct avtp_classifier_result results[NUM_PDUS];
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu tmpl;
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	int i, res;
+
+	record_pdus(0);
+	rp = create_replay(0, false);
+	init_template(&tmpl);
+
+	res = avtp_classifier_create(&cls, 1);
+	assert_int_equal(res, 0);
+	res = avtp_classifier_add(cls, &tmpl, NULL);
+	assert_int_equal(res, 0);
+
+	res = avtp_net_replay_classify(rp, cls, pdus, lens, NULL, results,
+								NUM_PDUS);
+	assert_int_equal(res, NUM_PDUS);
+
+	for (i = 0; i < NUM_PDUS; i++) {
+		assert_int_equal(results[i].verdict, AVTP_CLASSIFIER_PASS);
+		assert_int_equal(results[i].stream, 0);
+	}
+
+	avtp_classifier_destroy(cls);
+	avtp_net_replay_destroy(rp);
+}
+
+/* Big endian section holding a VLAN tagged AVTP frame, an IPv4 frame and an
+ * untagged AVTP frame from an interface with microsecond timestamps (the
+ * default), and an AVTP frame from a non-Ethernet interface.
+ */
+static const uint8_t foreign_capture[] = {
+	/* SHB */
+	0x0A, 0x0D, 0x0D, 0x0A, 0x00, 0x00, 0x00, 0x1C,
+	0x1A, 0x2B, 0x3C, 0x4D, 0x00, 0x01, 0x00, 0x00,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x1C,
+	/* IDB: Ethernet, no options. */
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x14,
+	0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x14,
+	/* IDB: Raw IP. */
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x14,
+	0x00, 0x65, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x14,
+	/* EPB: VLAN tagged AVTP frame at 2 s, 4 bytes of PDU. */
+	0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x38,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1E, 0x84, 0x80, 0x00, 0x00, 0x00, 0x16,
+	0x00, 0x00, 0x00, 0x16,
+	0x01, 0x1B, 0x19, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x81, 0x00, 0x60, 0x02,
+	0x22, 0xF0, 0x02, 0x80, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x38,
+	/* EPB: IPv4 frame. */
+	0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x34,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1E, 0x84, 0x81, 0x00, 0x00, 0x00, 0x12,
+	0x00, 0x00, 0x00, 0x12,
+	0x01, 0x1B, 0x19, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x45, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34,
+	/* EPB: untagged AVTP frame at 3 s, 4 bytes of PDU. */
+	0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x34,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x2D, 0xC6, 0xC0, 0x00, 0x00, 0x00, 0x12,
+	0x00, 0x00, 0x00, 0x12,
+	0x01, 0x1B, 0x19, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x22, 0xF0, 0x02, 0x80,
+	0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34,
+	/* EPB: AVTP frame from the Raw IP interface. */
+	0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x34,
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x2D, 0xC6, 0xC1, 0x00, 0x00, 0x00, 0x12,
+	0x00, 0x00, 0x00, 0x12,
+	0x01, 0x1B, 0x19, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x22, 0xF0, 0x02, 0x80,
+	0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34,
+};
+
+static void net_replay_foreign(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	uint64_t times[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	const uint8_t *data;
+	int res;
+
+	write_file(foreign_capture, sizeof(foreign_capture));
+	rp = create_replay(0, false);
+
+	res = avtp_net_replay_recv(rp, pdus, lens, times, NUM_PDUS);
+	assert_int_equal(res, 2);
+
+	data = (const uint8_t *) pdus[0];
+	assert_int_equal(lens[0], 4);
+	assert_int_equal(times[0], 2000000000ULL);
+	assert_int_equal(data[0], AVTP_SUBTYPE_AAF);
+	assert_int_equal(data[3], 1);
+
+	data = (const uint8_t *) pdus[1];
+	assert_int_equal(lens[1], 4);
+	assert_int_equal(times[1], 3000000000ULL);
+	assert_int_equal(data[3], 2);
+
+	avtp_net_replay_destroy(rp);
+}
+
+static void net_replay_truncated(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_replay *rp;
+	int res;
+
+	/* The last block is cut short: PDUs before it are still returned. */
+	write_file(foreign_capture, sizeof(foreign_capture) - 8);
+	rp = create_replay(0, false);
+
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, NUM_PDUS);
+	assert_int_equal(res, -EBADMSG);
+	res = avtp_net_replay_rewind(rp);
+	assert_int_equal(res, 0);
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, 2);
+	assert_int_equal(res, 2);
+	res = avtp_net_replay_recv(rp, pdus, lens, NULL, NUM_PDUS);
+	assert_int_equal(res, -EBADMSG);
+
+	avtp_net_replay_destroy(rp);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(net_capture_create_null_cap),
+		cmocka_unit_test(net_capture_create_null_cfg),
+		cmocka_unit_test(net_capture_create_null_path),
+		cmocka_unit_test(net_capture_create_invalid_snaplen),
+		cmocka_unit_test(net_capture_create_small_buffer),
+		cmocka_unit_test(net_capture_create_invalid_path),
+		cmocka_unit_test(net_capture_null_cap),
+		cmocka_unit_test(net_capture_write_null_times),
+		cmocka_unit_test(net_replay_create_null_rp),
+		cmocka_unit_test(net_replay_create_invalid_speed),
+		cmocka_unit_test(net_replay_create_invalid_path),
+		cmocka_unit_test(net_replay_create_not_pcapng),
+		cmocka_unit_test(net_replay_null_rp),
+		cmocka_unit_test(net_replay_recv),
+		cmocka_unit_test(net_replay_snaplen),
+		cmocka_unit_test(net_replay_loop),
+		cmocka_unit_test(net_replay_paced),
+		cmocka_unit_test(net_replay_classify),
+		cmocka_unit_test(net_replay_foreign),
+		cmocka_unit_test(net_replay_truncated),
+	};
+
+	return cmocka_run_group_tests(tests, setup, teardown);
+}
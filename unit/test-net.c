@@ -0,0 +1,1494 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+#include <endian.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_classifier.h"
+#include "avtp_net.h"
+
+/* Loopback tests send PDUs to the loopback interface and receive them back
+ * through the ring. They are skipped if the process lacks CAP_NET_RAW.
+ */
+#define LOOPBACK		"lo"
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define DATA_LEN		4
+#define PDU_SIZE		(sizeof(struct avtp_stream_pdu) + DATA_LEN)
+#define NUM_PDUS		10
+#define POLL_TIMEOUT		1000
+
+static const uint8_t macaddr[ETH_ALEN] = { 0x01, 0x1B, 0x19, 0x00, 0x00, 0x01 };
+
+static void init_stream_template(struct avtp_stream_pdu *tmpl,
+							uint64_t stream_id)
+{
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = stream_id,
+			.stream_data_len = DATA_LEN,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+	};
+
+	assert_int_equal(avtp_aaf_pdu_pack(tmpl, &hdr), 0);
+}
+
+static void init_template(struct avtp_stream_pdu *tmpl)
+{
+	init_stream_template(tmpl, STREAM_ID);
+}
+
+static struct avtp_net_rx *create_loopback_rx(void)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.block_size = 4096,
+		.block_count = 4,
+		.block_timeout = 1,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+
+	assert_int_equal(res, 0);
+	return rx;
+}
+
+static void send_stream_pdus(uint64_t stream_id, unsigned int count)
+{
+	struct sockaddr_ll addr = { 0 };
+	struct avtp_stream_pdu tmpl;
+	uint8_t buf[PDU_SIZE] = { 0 };
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *) buf;
+	unsigned int i;
+	int fd;
+
+	init_stream_template(&tmpl, stream_id);
+
+	fd = socket(AF_PACKET, SOCK_DGRAM, htons(ETH_P_TSN));
+	assert_true(fd >= 0);
+
+	addr.sll_family = AF_PACKET;
+	addr.sll_protocol = htons(ETH_P_TSN);
+	addr.sll_ifindex = if_nametoindex(LOOPBACK);
+	addr.sll_halen = ETH_ALEN;
+	memcpy(addr.sll_addr, macaddr, ETH_ALEN);
+
+	for (i = 0; i < count; i++) {
+		ssize_t n;
+
+		avtp_stream_pdu_emit(pdu, &tmpl, i, i * 1000, DATA_LEN);
+
+		n = sendto(fd, buf, sizeof(buf), 0, (struct sockaddr *) &addr,
+								sizeof(addr));
+		assert_int_equal(n, sizeof(buf));
+	}
+
+	close(fd);
+}
+
+static void send_pdus(unsigned int count)
+{
+	send_stream_pdus(STREAM_ID, count);
+}
+
+/* Wait for PDUs and return whether some arrived before the timeout. */
+static int wait_pdus(struct avtp_net_rx *rx)
+{
+	struct pollfd pfd = {
+		.fd = avtp_net_rx_get_fd(rx),
+		.events = POLLIN,
+	};
+
+	return poll(&pfd, 1, POLL_TIMEOUT) > 0;
+}
+
+static void net_rx_create_null_rx(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+	};
+	int res;
+
+	res = avtp_net_rx_create(NULL, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_create_null_cfg(void **state)
+{
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_create_null_ifname(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.protocol = ETH_P_TSN,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_create_invalid_ifname(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = "invalid-ifname",
+		.protocol = ETH_P_TSN,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+
+	assert_int_equal(res, -ENODEV);
+}
+
+static void net_rx_get_fd_null_rx(void **state)
+{
+	int res;
+
+	res = avtp_net_rx_get_fd(NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_add_membership_null_rx(void **state)
+{
+	int res;
+
+	res = avtp_net_rx_add_membership(NULL, macaddr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_recv_null_rx(void **state)
+{
+	const struct avtp_stream_pdu *pdus[1];
+	size_t lens[1];
+	int res;
+
+	res = avtp_net_rx_recv(NULL, pdus, lens, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_classify_null_cls(void **state)
+{
+	const struct avtp_stream_pdu *pdus[1];
+	struct avtp_classifier_result results[1];
+	size_t lens[1];
+	int res;
+
+	res = avtp_net_rx_classify(NULL, NULL, pdus, lens, results, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_create_invalid_block_size(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.block_size = 1000,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_recv_empty(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_rx *rx;
+	int res;
+
+	rx = create_loopback_rx();
+
+	res = avtp_net_rx_recv(rx, pdus, lens, NUM_PDUS);
+
+	assert_int_equal(res, 0);
+	avtp_net_rx_destroy(rx);
+}
+
+static void net_rx_recv(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_rx *rx;
+	unsigned int count = 0;
+
+	rx = create_loopback_rx();
+	send_pdus(NUM_PDUS);
+
+	/* Retrieve PDUs two at a time so blocks are consumed over several
+	 * calls.
+	 */
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int i, n;
+
+		while ((n = avtp_net_rx_recv(rx, pdus, lens, 2)) > 0) {
+			for (i = 0; i < n; i++) {
+				struct avtp_stream_hdr hdr = { 0 };
+				uint32_t word;
+
+				assert_int_equal(lens[i], PDU_SIZE);
+
+				word = ntohl(pdus[i]->subtype_data);
+				hdr.seq_num = (word >> 8) & 0xFF;
+				assert_int_equal(hdr.seq_num, count);
+				assert_int_equal(ntohl(pdus[i]->avtp_time),
+								count * 1000);
+				count++;
+			}
+		}
+		assert_int_equal(n, 0);
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+	avtp_net_rx_destroy(rx);
+}
+
+static void net_rx_classify(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	struct avtp_classifier_result results[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_stream_pdu tmpl;
+	struct avtp_classifier *cls;
+	struct avtp_net_rx *rx;
+	unsigned int count = 0;
+	int stream;
+
+	rx = create_loopback_rx();
+
+	init_template(&tmpl);
+	assert_int_equal(avtp_classifier_create(&cls, 1), 0);
+	stream = avtp_classifier_add(cls, &tmpl, NULL);
+	assert_true(stream >= 0);
+
+	send_pdus(NUM_PDUS);
+
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int i, n;
+
+		n = avtp_net_rx_classify(rx, cls, pdus, lens, results,
+								NUM_PDUS);
+		assert_true(n >= 0);
+
+		for (i = 0; i < n; i++) {
+			assert_int_equal(results[i].stream, stream);
+			assert_int_equal(results[i].verdict,
+						AVTP_CLASSIFIER_PASS);
+		}
+		count += n;
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+	avtp_classifier_destroy(cls);
+	avtp_net_rx_destroy(rx);
+}
+
+#define ENGINE_WORKERS		4
+#define ENGINE_STREAMS		2
+
+struct engine_state {
+	uint64_t stream_ids[ENGINE_STREAMS];
+	int workers[ENGINE_STREAMS];
+	int handles[ENGINE_STREAMS];
+	unsigned int received[ENGINE_STREAMS];
+	/* PDUs handed over by the wrong worker or with unexpected results. */
+	unsigned int errors;
+};
+
+static void engine_fn(unsigned int worker,
+				const struct avtp_stream_pdu *const pdus[],
+				const size_t lens[],
+				const struct avtp_classifier_result results[],
+				unsigned int count, void *arg)
+{
+	struct engine_state *state = arg;
+	unsigned int i, j;
+
+	for (i = 0; i < count; i++) {
+		uint64_t stream_id = be64toh(pdus[i]->stream_id);
+
+		for (j = 0; j < ENGINE_STREAMS; j++)
+			if (state->stream_ids[j] == stream_id)
+				break;
+
+		if (j == ENGINE_STREAMS || state->workers[j] != worker ||
+				results[i].stream != state->handles[j] ||
+				results[i].verdict != AVTP_CLASSIFIER_PASS) {
+			__atomic_add_fetch(&state->errors, 1, __ATOMIC_RELAXED);
+			continue;
+		}
+
+		__atomic_add_fetch(&state->received[j], 1, __ATOMIC_RELAXED);
+	}
+}
+
+static void init_engine_config(struct avtp_net_engine_config *cfg,
+						struct engine_state *state)
+{
+	struct avtp_net_engine_config c = {
+		.rx = {
+			.ifname = LOOPBACK,
+			.protocol = ETH_P_TSN,
+			.block_size = 4096,
+			.block_count = 4,
+			.block_timeout = 1,
+		},
+		.workers = ENGINE_WORKERS,
+		.max_streams = ENGINE_STREAMS,
+		.fn = engine_fn,
+		.arg = state,
+	};
+
+	*cfg = c;
+}
+
+static struct avtp_net_engine *create_loopback_engine(
+						struct engine_state *state)
+{
+	struct avtp_net_engine_config cfg;
+	struct avtp_net_engine *engine;
+	int res;
+
+	init_engine_config(&cfg, state);
+
+	res = avtp_net_engine_create(&engine, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+
+	assert_int_equal(res, 0);
+	return engine;
+}
+
+static void net_engine_create_null_engine(void **state)
+{
+	struct avtp_net_engine_config cfg;
+	int res;
+
+	init_engine_config(&cfg, NULL);
+
+	res = avtp_net_engine_create(NULL, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_engine_create_null_cfg(void **state)
+{
+	struct avtp_net_engine *engine;
+	int res;
+
+	res = avtp_net_engine_create(&engine, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_engine_create_invalid_cfg(void **state)
+{
+	struct avtp_net_engine_config cfg;
+	struct avtp_net_engine *engine;
+	const int cpus[ENGINE_WORKERS] = { 0, 0, 0, -1 };
+	int res;
+
+	init_engine_config(&cfg, NULL);
+	cfg.workers = 0;
+	res = avtp_net_engine_create(&engine, &cfg);
+	assert_int_equal(res, -EINVAL);
+
+	init_engine_config(&cfg, NULL);
+	cfg.workers = AVTP_NET_ENGINE_MAX_WORKERS + 1;
+	res = avtp_net_engine_create(&engine, &cfg);
+	assert_int_equal(res, -EINVAL);
+
+	init_engine_config(&cfg, NULL);
+	cfg.fn = NULL;
+	res = avtp_net_engine_create(&engine, &cfg);
+	assert_int_equal(res, -EINVAL);
+
+	init_engine_config(&cfg, NULL);
+	cfg.cpus = cpus;
+	res = avtp_net_engine_create(&engine, &cfg);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_engine_null_engine(void **state)
+{
+	struct avtp_stream_pdu tmpl;
+	int res;
+
+	init_template(&tmpl);
+
+	res = avtp_net_engine_get_worker(NULL, STREAM_ID);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_net_engine_add_stream(NULL, &tmpl, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_net_engine_add_membership(NULL, macaddr);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_net_engine_start(NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_net_engine_stop(NULL);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_engine_running(void **state)
+{
+	struct engine_state s = { 0 };
+	struct avtp_net_engine *engine;
+	struct avtp_stream_pdu tmpl;
+	int res;
+
+	engine = create_loopback_engine(&s);
+	init_template(&tmpl);
+
+	assert_int_equal(avtp_net_engine_start(engine), 0);
+
+	res = avtp_net_engine_start(engine);
+	assert_int_equal(res, -EBUSY);
+
+	res = avtp_net_engine_add_stream(engine, &tmpl, NULL);
+	assert_int_equal(res, -EBUSY);
+
+	assert_int_equal(avtp_net_engine_stop(engine), 0);
+	assert_int_equal(avtp_net_engine_stop(engine), 0);
+
+	res = avtp_net_engine_add_stream(engine, &tmpl, NULL);
+	assert_true(res >= 0);
+
+	/* Engine is destroyed while running. */
+	assert_int_equal(avtp_net_engine_start(engine), 0);
+	avtp_net_engine_destroy(engine);
+}
+
+static void net_engine_steering(void **state)
+{
+	struct engine_state s = { 0 };
+	struct avtp_net_engine *engine;
+	struct timespec ts = { .tv_nsec = 1000000 };
+	uint64_t stream_id = STREAM_ID;
+	unsigned int i, wait;
+
+	engine = create_loopback_engine(&s);
+
+	/* Pick streams which are steered to different workers. */
+	for (i = 0; i < ENGINE_STREAMS; i++) {
+		struct avtp_stream_pdu tmpl;
+		int worker;
+
+		do {
+			worker = avtp_net_engine_get_worker(engine,
+								stream_id++);
+			assert_true(worker >= 0 && worker < ENGINE_WORKERS);
+		} while (i > 0 && worker == s.workers[i - 1]);
+
+		s.stream_ids[i] = stream_id - 1;
+		s.workers[i] = worker;
+
+		init_stream_template(&tmpl, s.stream_ids[i]);
+		s.handles[i] = avtp_net_engine_add_stream(engine, &tmpl, NULL);
+		assert_true(s.handles[i] >= 0);
+	}
+
+	assert_int_equal(avtp_net_engine_start(engine), 0);
+
+	for (i = 0; i < ENGINE_STREAMS; i++)
+		send_stream_pdus(s.stream_ids[i], NUM_PDUS);
+
+	for (wait = 0; wait < POLL_TIMEOUT; wait++) {
+		unsigned int done = 0;
+
+		for (i = 0; i < ENGINE_STREAMS; i++)
+			done += __atomic_load_n(&s.received[i],
+							__ATOMIC_RELAXED);
+		if (done == ENGINE_STREAMS * NUM_PDUS)
+			break;
+
+		nanosleep(&ts, NULL);
+	}
+
+	assert_int_equal(avtp_net_engine_stop(engine), 0);
+
+	for (i = 0; i < ENGINE_STREAMS; i++)
+		assert_int_equal(s.received[i], NUM_PDUS);
+	assert_int_equal(s.errors, 0);
+
+	avtp_net_engine_destroy(engine);
+}
+
+static struct avtp_net_tx *create_loopback_tx(bool txtime,
+						unsigned int queue_size)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.txtime = txtime,
+		.clockid = CLOCK_TAI,
+		.queue_size = queue_size,
+		.max_pdu_size = PDU_SIZE,
+	};
+	struct avtp_net_tx *tx;
+	int res;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+
+	assert_int_equal(res, 0);
+	return tx;
+}
+
+static void net_tx_create_null_tx(void **state)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+	};
+	int res;
+
+	res = avtp_net_tx_create(NULL, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_tx_create_null_cfg(void **state)
+{
+	struct avtp_net_tx *tx;
+	int res;
+
+	res = avtp_net_tx_create(&tx, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_tx_create_invalid_ifname(void **state)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = "invalid-ifname",
+		.protocol = ETH_P_TSN,
+	};
+	struct avtp_net_tx *tx;
+	int res;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+
+	assert_int_equal(res, -ENODEV);
+}
+
+static void net_tx_null_tx(void **state)
+{
+	uint8_t pdu[PDU_SIZE] = { 0 };
+	void *buf;
+
+	assert_int_equal(avtp_net_tx_get_fd(NULL), -EINVAL);
+	assert_int_equal(avtp_net_tx_reserve(NULL, &buf), -EINVAL);
+	assert_int_equal(avtp_net_tx_commit(NULL, macaddr, PDU_SIZE, 0),
+								-EINVAL);
+	assert_int_equal(avtp_net_tx_queue(NULL, macaddr, pdu, PDU_SIZE, 0),
+								-EINVAL);
+	assert_int_equal(avtp_net_tx_flush(NULL), -EINVAL);
+	assert_int_equal(avtp_net_tx_get_pending(NULL), -EINVAL);
+}
+
+static void net_tx_commit_not_reserved(void **state)
+{
+	struct avtp_net_tx *tx;
+	int res;
+
+	tx = create_loopback_tx(false, 1);
+
+	res = avtp_net_tx_commit(tx, macaddr, PDU_SIZE, 0);
+
+	assert_int_equal(res, -EINVAL);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_tx_queue_too_large(void **state)
+{
+	uint8_t pdu[PDU_SIZE + 1] = { 0 };
+	struct avtp_net_tx *tx;
+	int res;
+
+	tx = create_loopback_tx(false, 1);
+
+	res = avtp_net_tx_queue(tx, macaddr, pdu, sizeof(pdu), 0);
+
+	assert_int_equal(res, -EINVAL);
+	assert_int_equal(avtp_net_tx_get_pending(tx), 0);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_tx_queue_full(void **state)
+{
+	uint8_t pdu[PDU_SIZE] = { 0 };
+	struct avtp_net_tx *tx;
+	void *buf;
+	int res;
+
+	tx = create_loopback_tx(false, 2);
+
+	assert_int_equal(avtp_net_tx_queue(tx, macaddr, pdu, PDU_SIZE, 0), 0);
+	assert_int_equal(avtp_net_tx_queue(tx, macaddr, pdu, PDU_SIZE, 0), 0);
+
+	res = avtp_net_tx_reserve(tx, &buf);
+
+	assert_int_equal(res, -ENOSPC);
+	assert_int_equal(avtp_net_tx_get_pending(tx), 2);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_tx_flush_empty(void **state)
+{
+	struct avtp_net_tx *tx;
+	int res;
+
+	tx = create_loopback_tx(false, 1);
+
+	res = avtp_net_tx_flush(tx);
+
+	assert_int_equal(res, 0);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_tx_flush(void **state)
+{
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_stream_pdu tmpl;
+	struct avtp_net_rx *rx;
+	struct avtp_net_tx *tx;
+	unsigned int i, count = 0;
+	struct timespec now;
+	uint64_t base;
+
+	rx = create_loopback_rx();
+	tx = create_loopback_tx(true, NUM_PDUS);
+	init_template(&tmpl);
+
+	clock_gettime(CLOCK_TAI, &now);
+	base = now.tv_sec * 1000000000ULL + now.tv_nsec;
+
+	/* Emit PDUs straight into queue buffers. */
+	for (i = 0; i < NUM_PDUS; i++) {
+		void *buf;
+
+		assert_int_equal(avtp_net_tx_reserve(tx, &buf), 0);
+		assert_int_equal(avtp_stream_pdu_emit(buf, &tmpl, i, i * 1000,
+							DATA_LEN), 0);
+		assert_int_equal(avtp_net_tx_commit(tx, macaddr, PDU_SIZE,
+						base + i * 1000), 0);
+	}
+
+	assert_int_equal(avtp_net_tx_get_pending(tx), NUM_PDUS);
+	assert_int_equal(avtp_net_tx_flush(tx), NUM_PDUS);
+	assert_int_equal(avtp_net_tx_get_pending(tx), 0);
+
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int n;
+
+		while ((n = avtp_net_rx_recv(rx, pdus, lens, NUM_PDUS)) > 0) {
+			for (i = 0; i < n; i++) {
+				assert_int_equal(lens[i], PDU_SIZE);
+				assert_int_equal(ntohl(pdus[i]->avtp_time),
+								count * 1000);
+				count++;
+			}
+		}
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+	avtp_net_tx_destroy(tx);
+	avtp_net_rx_destroy(rx);
+}
+
+/* XDP backend tests are skipped as well if the kernel lacks AF_XDP or XDP
+ * support.
+ */
+static bool xdp_unavailable(int res)
+{
+	return res == -EPERM || res == -EACCES || res == -EOPNOTSUPP ||
+						res == -EAFNOSUPPORT;
+}
+
+/* The kernel releases the queue of an AF_XDP socket asynchronously once the
+ * socket is closed, so the queue may still be busy right after the previous
+ * test destroyed its socket.
+ */
+static int create_xdp_tx(struct avtp_net_tx **tx,
+				const struct avtp_net_tx_config *cfg)
+{
+	struct timespec ts = { .tv_nsec = 1000000 };
+	int wait, res;
+
+	for (wait = 0; wait < POLL_TIMEOUT; wait++) {
+		res = avtp_net_tx_create(tx, cfg);
+		if (res != -EBUSY)
+			break;
+
+		nanosleep(&ts, NULL);
+	}
+
+	return res;
+}
+
+static void net_rx_create_invalid_backend(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.backend = AVTP_NET_BACKEND_XDP + 1,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_xdp_create_invalid_frame_size(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.frame_size = 3000,
+		.backend = AVTP_NET_BACKEND_XDP,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (xdp_unavailable(res))
+		skip();
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void net_rx_xdp_recv(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.frame_count = 64,
+		.backend = AVTP_NET_BACKEND_XDP,
+	};
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_net_rx *rx;
+	unsigned int count = 0;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (xdp_unavailable(res))
+		skip();
+
+	assert_int_equal(res, 0);
+	assert_int_equal(avtp_net_rx_add_membership(rx, macaddr), 0);
+
+	send_pdus(NUM_PDUS);
+
+	/* Retrieve PDUs two at a time so frames are recycled over several
+	 * calls.
+	 */
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int i, n;
+
+		while ((n = avtp_net_rx_recv(rx, pdus, lens, 2)) > 0) {
+			for (i = 0; i < n; i++) {
+				assert_int_equal(lens[i], PDU_SIZE);
+				assert_int_equal(ntohl(pdus[i]->avtp_time),
+								count * 1000);
+				count++;
+			}
+		}
+		assert_int_equal(n, 0);
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+	avtp_net_rx_destroy(rx);
+}
+
+static void net_tx_xdp_create_txtime(void **state)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.txtime = true,
+		.clockid = CLOCK_TAI,
+		.backend = AVTP_NET_BACKEND_XDP,
+	};
+	struct avtp_net_tx *tx;
+	int res;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+
+	assert_int_equal(res, -EOPNOTSUPP);
+}
+
+static void net_tx_xdp_flush(void **state)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.queue_size = NUM_PDUS,
+		.max_pdu_size = PDU_SIZE,
+		.backend = AVTP_NET_BACKEND_XDP,
+	};
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	size_t lens[NUM_PDUS];
+	struct avtp_stream_pdu tmpl;
+	struct avtp_net_rx *rx;
+	struct avtp_net_tx *tx;
+	unsigned int i, count = 0, round;
+	int res;
+
+	rx = create_loopback_rx();
+
+	res = create_xdp_tx(&tx, &cfg);
+	if (xdp_unavailable(res)) {
+		avtp_net_rx_destroy(rx);
+		skip();
+	}
+
+	assert_int_equal(res, 0);
+	init_template(&tmpl);
+
+	/* Fill the queue twice so UMEM frames are reused once their
+	 * transmission is completed.
+	 */
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < NUM_PDUS / 2; i++) {
+			unsigned int seq = round * NUM_PDUS / 2 + i;
+			void *buf;
+
+			assert_int_equal(avtp_net_tx_reserve(tx, &buf), 0);
+			avtp_stream_pdu_emit(buf, &tmpl, seq, seq * 1000,
+								DATA_LEN);
+			assert_int_equal(avtp_net_tx_commit(tx, macaddr,
+							PDU_SIZE, 0), 0);
+		}
+
+		while (avtp_net_tx_get_pending(tx) > 0)
+			assert_true(avtp_net_tx_flush(tx) >= 0);
+	}
+
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int n;
+
+		while ((n = avtp_net_rx_recv(rx, pdus, lens, NUM_PDUS)) > 0) {
+			for (i = 0; i < n; i++) {
+				assert_int_equal(lens[i], PDU_SIZE);
+				assert_int_equal(ntohl(pdus[i]->avtp_time),
+								count * 1000);
+				count++;
+			}
+		}
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+	avtp_net_tx_destroy(tx);
+	avtp_net_rx_destroy(rx);
+}
+
+static uint64_t realtime_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void net_rx_create_tstamp_xdp(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.backend = AVTP_NET_BACKEND_XDP,
+		.tstamp = AVTP_NET_TSTAMP_SOFTWARE,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+
+	assert_int_equal(res, -EOPNOTSUPP);
+}
+
+static void net_rx_create_tstamp_hardware(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.tstamp = AVTP_NET_TSTAMP_HARDWARE,
+	};
+	struct avtp_net_rx *rx;
+	int res;
+
+	/* The loopback device can't timestamp frames. */
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+
+	assert_int_equal(res, -EOPNOTSUPP);
+}
+
+static void net_rx_recv_ts(void **state)
+{
+	struct avtp_net_rx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.block_size = 4096,
+		.block_count = 4,
+		.block_timeout = 1,
+		.tstamp = AVTP_NET_TSTAMP_SOFTWARE,
+	};
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	struct avtp_classifier_result results[NUM_PDUS];
+	struct avtp_classifier *cls;
+	struct avtp_stream_pdu tmpl;
+	uint64_t times[NUM_PDUS], start, end;
+	size_t lens[NUM_PDUS];
+	struct avtp_net_rx *rx;
+	unsigned int count = 0;
+	int res;
+
+	res = avtp_net_rx_create(&rx, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+	assert_int_equal(res, 0);
+
+	init_template(&tmpl);
+	assert_int_equal(avtp_classifier_create(&cls, 1), 0);
+	assert_int_equal(avtp_classifier_add(cls, &tmpl, NULL), 0);
+
+	start = realtime_now();
+	send_pdus(NUM_PDUS);
+	end = realtime_now();
+
+	/* PDUs are timestamped as they arrive, not as they are retrieved. */
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int i, n;
+
+		while ((n = avtp_net_rx_classify_ts(rx, cls, pdus, lens, times,
+						results, NUM_PDUS)) > 0) {
+			for (i = 0; i < n; i++) {
+				assert_int_equal(results[i].verdict,
+							AVTP_CLASSIFIER_PASS);
+				assert_true(times[i] >= start);
+				assert_true(times[i] <= end);
+				if (i > 0)
+					assert_true(times[i] >= times[i - 1]);
+				count++;
+			}
+		}
+		assert_int_equal(n, 0);
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+	avtp_classifier_destroy(cls);
+	avtp_net_rx_destroy(rx);
+}
+
+static void net_tx_create_tstamp_xdp(void **state)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.backend = AVTP_NET_BACKEND_XDP,
+		.tstamp = AVTP_NET_TSTAMP_SOFTWARE,
+	};
+	struct avtp_net_tx *tx;
+	int res;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+
+	assert_int_equal(res, -EOPNOTSUPP);
+}
+
+static void net_tx_get_reports_disabled(void **state)
+{
+	struct avtp_net_tx_report reports[1];
+	struct avtp_net_tx *tx;
+	int res;
+
+	assert_int_equal(avtp_net_tx_get_reports(NULL, reports, 1), -EINVAL);
+
+	tx = create_loopback_tx(false, 1);
+
+	res = avtp_net_tx_get_reports(tx, reports, 1);
+
+	assert_int_equal(res, -EOPNOTSUPP);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_tx_get_reports(void **state)
+{
+	struct avtp_net_tx_config cfg = {
+		.ifname = LOOPBACK,
+		.protocol = ETH_P_TSN,
+		.queue_size = NUM_PDUS,
+		.max_pdu_size = PDU_SIZE,
+		.tstamp = AVTP_NET_TSTAMP_SOFTWARE,
+	};
+	struct avtp_net_tx_report reports[NUM_PDUS];
+	uint8_t pdu[PDU_SIZE] = { 0 };
+	struct avtp_net_tx *tx;
+	unsigned int i, round, count = 0;
+	uint64_t start, end;
+	struct pollfd pfd;
+	int res;
+
+	res = avtp_net_tx_create(&tx, &cfg);
+	if (res == -EPERM || res == -EACCES)
+		skip();
+	assert_int_equal(res, 0);
+
+	pfd.fd = avtp_net_tx_get_fd(tx);
+	pfd.events = 0;
+
+	/* Transmit two rounds so PDU indexes keep counting across flushes.
+	 * Launch times aren't enabled, but they are reported anyway.
+	 */
+	start = realtime_now();
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < NUM_PDUS / 2; i++) {
+			uint64_t launch_time = 1000 + round * NUM_PDUS / 2 + i;
+
+			res = avtp_net_tx_queue(tx, macaddr, pdu, PDU_SIZE,
+								launch_time);
+			assert_int_equal(res, 0);
+		}
+		assert_int_equal(avtp_net_tx_flush(tx), NUM_PDUS / 2);
+	}
+
+	while (count < NUM_PDUS && poll(&pfd, 1, POLL_TIMEOUT) > 0) {
+		int n;
+
+		n = avtp_net_tx_get_reports(tx, reports + count,
+							NUM_PDUS - count);
+		assert_true(n >= 0);
+		count += n;
+	}
+	end = realtime_now();
+
+	assert_int_equal(count, NUM_PDUS);
+	for (i = 0; i < NUM_PDUS; i++) {
+		assert_int_equal(reports[i].id, i);
+		assert_int_equal(reports[i].launch_time, 1000 + i);
+		assert_true(reports[i].tx_time >= start);
+		assert_true(reports[i].tx_time <= end);
+	}
+
+	assert_int_equal(avtp_net_tx_get_reports(tx, reports, NUM_PDUS), 0);
+	avtp_net_tx_destroy(tx);
+}
+
+/* Mux streams emit PDUs carrying their launch time as timestamp. */
+struct mux_stream_arg {
+	struct avtp_stream_pdu tmpl;
+	uint64_t period;
+	uint8_t seq_num;
+};
+
+static int mux_fill(void *buf, size_t size, uint64_t *launch_time,
+								void *arg)
+{
+	struct mux_stream_arg *a = arg;
+
+	assert_true(size >= PDU_SIZE);
+	assert_int_equal(avtp_stream_pdu_emit(buf, &a->tmpl, a->seq_num++,
+						*launch_time, DATA_LEN), 0);
+
+	*launch_time += a->period;
+	return PDU_SIZE;
+}
+
+static int mux_fill_stuck(void *buf, size_t size, uint64_t *launch_time,
+								void *arg)
+{
+	return 0;
+}
+
+static int mux_fill_stuck_pdu(void *buf, size_t size, uint64_t *launch_time,
+								void *arg)
+{
+	struct mux_stream_arg *a = arg;
+
+	assert_int_equal(avtp_stream_pdu_emit(buf, &a->tmpl, a->seq_num++,
+						*launch_time, DATA_LEN), 0);
+	return PDU_SIZE;
+}
+
+static void init_mux_stream(struct avtp_net_mux_stream_config *cfg,
+				struct mux_stream_arg *arg, uint64_t stream_id,
+				enum avtp_net_mux_class sr_class,
+				uint64_t period)
+{
+	memset(arg, 0, sizeof(*arg));
+	init_stream_template(&arg->tmpl, stream_id);
+	arg->period = period;
+
+	memset(cfg, 0, sizeof(*cfg));
+	memcpy(cfg->macaddr, macaddr, ETH_ALEN);
+	cfg->sr_class = sr_class;
+	cfg->max_frame_size = PDU_SIZE;
+	cfg->max_interval_frames = 1;
+	cfg->fill = mux_fill;
+	cfg->arg = arg;
+}
+
+static void net_mux_null_mux(void **state)
+{
+	struct avtp_net_mux_stream_config cfg;
+	struct avtp_net_mux_stats stats;
+	struct mux_stream_arg arg;
+	struct avtp_net_mux *mux;
+	uint64_t val;
+
+	init_mux_stream(&cfg, &arg, STREAM_ID, AVTP_NET_MUX_CLASS_A, 1000);
+
+	assert_int_equal(avtp_net_mux_create(NULL, NULL, 1), -EINVAL);
+	assert_int_equal(avtp_net_mux_create(&mux, NULL, 1), -EINVAL);
+	assert_int_equal(avtp_net_mux_add_stream(NULL, &cfg), -EINVAL);
+	assert_int_equal(avtp_net_mux_run(NULL, 0), -EINVAL);
+	assert_int_equal(avtp_net_mux_get_deadline(NULL, &val), -EINVAL);
+	assert_int_equal(avtp_net_mux_get_idleslope(NULL,
+					AVTP_NET_MUX_CLASS_A, &val), -EINVAL);
+	assert_int_equal(avtp_net_mux_get_stats(NULL, 0, &stats), -EINVAL);
+}
+
+static void net_mux_add_stream_invalid(void **state)
+{
+	struct avtp_net_mux_stream_config cfg;
+	struct avtp_net_mux_stats stats;
+	struct mux_stream_arg arg;
+	struct avtp_net_mux *mux;
+	struct avtp_net_tx *tx;
+	uint64_t deadline;
+
+	tx = create_loopback_tx(false, 1);
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 0), -EINVAL);
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 1), 0);
+	assert_int_equal(avtp_net_mux_get_deadline(mux, &deadline), -ENOENT);
+
+	init_mux_stream(&cfg, &arg, STREAM_ID, AVTP_NET_MUX_CLASS_A, 1000);
+
+	assert_int_equal(avtp_net_mux_add_stream(mux, NULL), -EINVAL);
+	cfg.fill = NULL;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), -EINVAL);
+	cfg.fill = mux_fill;
+	cfg.max_frame_size = PDU_SIZE + 1;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), -EINVAL);
+	cfg.max_frame_size = PDU_SIZE;
+	cfg.max_interval_frames = 0;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), -EINVAL);
+	cfg.max_interval_frames = 1;
+	cfg.sr_class = AVTP_NET_MUX_CLASS_MAX;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), -EINVAL);
+	cfg.sr_class = AVTP_NET_MUX_CLASS_A;
+
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 0);
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), -ENOSPC);
+	assert_int_equal(avtp_net_mux_get_stats(mux, 1, &stats), -EINVAL);
+	assert_int_equal(avtp_net_mux_get_idleslope(mux,
+				AVTP_NET_MUX_CLASS_MAX, &deadline), -EINVAL);
+
+	avtp_net_mux_destroy(mux);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_mux_idleslope(void **state)
+{
+	struct avtp_net_mux_stream_config cfg;
+	struct mux_stream_arg arg;
+	struct avtp_net_mux *mux;
+	struct avtp_net_tx *tx;
+	uint64_t bps, deadline;
+
+	tx = create_loopback_tx(false, 1);
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 3), 0);
+
+	init_mux_stream(&cfg, &arg, STREAM_ID, AVTP_NET_MUX_CLASS_A, 1000);
+	cfg.start_time = 3000;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 0);
+	cfg.start_time = 1000;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 1);
+	cfg.sr_class = AVTP_NET_MUX_CLASS_B;
+	cfg.max_interval_frames = 2;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 2);
+
+	/* Each frame takes PDU_SIZE plus 42 bytes on the wire, and there are
+	 * 8000 class A and 4000 class B intervals per second.
+	 */
+	assert_int_equal(avtp_net_mux_get_idleslope(mux, AVTP_NET_MUX_CLASS_A,
+								&bps), 0);
+	assert_int_equal(bps, 2 * (PDU_SIZE + 42) * 8 * 8000);
+	assert_int_equal(avtp_net_mux_get_idleslope(mux, AVTP_NET_MUX_CLASS_B,
+								&bps), 0);
+	assert_int_equal(bps, 2 * (PDU_SIZE + 42) * 8 * 4000);
+
+	assert_int_equal(avtp_net_mux_get_deadline(mux, &deadline), 0);
+	assert_int_equal(deadline, 1000);
+
+	avtp_net_mux_destroy(mux);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_mux_run_stuck(void **state)
+{
+	struct avtp_net_mux_stream_config cfg;
+	struct mux_stream_arg arg;
+	struct avtp_net_mux *mux;
+	struct avtp_net_tx *tx;
+
+	tx = create_loopback_tx(false, 1);
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 1), 0);
+
+	init_mux_stream(&cfg, &arg, STREAM_ID, AVTP_NET_MUX_CLASS_A, 1000);
+	cfg.fill = mux_fill_stuck;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 0);
+
+	assert_int_equal(avtp_net_mux_run(mux, 0), -EINVAL);
+
+	avtp_net_mux_destroy(mux);
+
+	/* Same for a stream emitting PDUs, which isn't left to fill the
+	 * queue at a single launch time.
+	 */
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 1), 0);
+
+	cfg.fill = mux_fill_stuck_pdu;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 0);
+
+	assert_int_equal(avtp_net_mux_run(mux, 0), -EINVAL);
+	assert_int_equal(avtp_net_tx_get_pending(tx), 0);
+
+	avtp_net_mux_destroy(mux);
+	avtp_net_tx_destroy(tx);
+}
+
+static void net_mux_run(void **state)
+{
+	/* Launch times from both streams, in transmission order. At equal
+	 * launch times, the class A stream goes first.
+	 */
+	static const struct {
+		uint64_t stream_id;
+		uint32_t time;
+	} expected[NUM_PDUS] = {
+		{ STREAM_ID + 1, 0 }, { STREAM_ID, 0 },
+		{ STREAM_ID + 1, 2000 }, { STREAM_ID, 3000 },
+		{ STREAM_ID + 1, 4000 }, { STREAM_ID + 1, 6000 },
+		{ STREAM_ID, 6000 }, { STREAM_ID + 1, 8000 },
+		{ STREAM_ID, 9000 }, { STREAM_ID + 1, 10000 },
+	};
+	const struct avtp_stream_pdu *pdus[NUM_PDUS];
+	struct avtp_net_mux_stream_config cfg;
+	struct mux_stream_arg args[2];
+	struct avtp_net_mux_stats stats;
+	size_t lens[NUM_PDUS];
+	struct avtp_net_mux *mux;
+	struct avtp_net_rx *rx;
+	struct avtp_net_tx *tx;
+	unsigned int i, count = 0;
+	uint64_t deadline;
+
+	rx = create_loopback_rx();
+	/* A queue shorter than the PDUs due makes the scheduler flush it
+	 * halfway.
+	 */
+	tx = create_loopback_tx(false, 4);
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 2), 0);
+
+	/* All PDUs fall in the first class measurement interval, which both
+	 * streams reserve enough for.
+	 */
+	init_mux_stream(&cfg, &args[0], STREAM_ID, AVTP_NET_MUX_CLASS_B,
+									3000);
+	cfg.max_interval_frames = NUM_PDUS;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 0);
+	init_mux_stream(&cfg, &args[1], STREAM_ID + 1, AVTP_NET_MUX_CLASS_A,
+									2000);
+	cfg.max_interval_frames = NUM_PDUS;
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 1);
+
+	assert_int_equal(avtp_net_mux_run(mux, 10000), NUM_PDUS);
+	assert_int_equal(avtp_net_tx_get_pending(tx), 0);
+	assert_int_equal(avtp_net_mux_get_deadline(mux, &deadline), 0);
+	assert_int_equal(deadline, 12000);
+
+	while (count < NUM_PDUS && wait_pdus(rx)) {
+		int n;
+
+		while ((n = avtp_net_rx_recv(rx, pdus, lens, NUM_PDUS)) > 0) {
+			for (i = 0; i < n; i++) {
+				assert_true(count < NUM_PDUS);
+				assert_int_equal(be64toh(pdus[i]->stream_id),
+						expected[count].stream_id);
+				assert_int_equal(ntohl(pdus[i]->avtp_time),
+						expected[count].time);
+				count++;
+			}
+		}
+	}
+
+	assert_int_equal(count, NUM_PDUS);
+
+	assert_int_equal(avtp_net_mux_get_stats(mux, 0, &stats), 0);
+	assert_int_equal(stats.pdus, 4);
+	assert_int_equal(stats.bytes, 4 * PDU_SIZE);
+	assert_int_equal(stats.overruns, 0);
+
+	avtp_net_mux_destroy(mux);
+	avtp_net_tx_destroy(tx);
+	avtp_net_rx_destroy(rx);
+}
+
+static void net_mux_overrun(void **state)
+{
+	struct avtp_net_mux_stream_config cfg;
+	struct avtp_net_mux_stats stats;
+	struct mux_stream_arg arg;
+	struct avtp_net_mux *mux;
+	struct avtp_net_tx *tx;
+
+	tx = create_loopback_tx(false, NUM_PDUS);
+	assert_int_equal(avtp_net_mux_create(&mux, tx, 1), 0);
+
+	/* Two PDUs per class A interval while only one is reserved. */
+	init_mux_stream(&cfg, &arg, STREAM_ID, AVTP_NET_MUX_CLASS_A, 62500);
+	assert_int_equal(avtp_net_mux_add_stream(mux, &cfg), 0);
+
+	assert_int_equal(avtp_net_mux_run(mux, 4 * 125000 - 1), 8);
+
+	assert_int_equal(avtp_net_mux_get_stats(mux, 0, &stats), 0);
+	assert_int_equal(stats.pdus, 8);
+	assert_int_equal(stats.bytes, 8 * PDU_SIZE);
+	assert_int_equal(stats.overruns, 4);
+
+	avtp_net_mux_destroy(mux);
+	avtp_net_tx_destroy(tx);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(net_rx_create_null_rx),
+		cmocka_unit_test(net_rx_create_null_cfg),
+		cmocka_unit_test(net_rx_create_null_ifname),
+		cmocka_unit_test(net_rx_create_invalid_ifname),
+		cmocka_unit_test(net_rx_get_fd_null_rx),
+		cmocka_unit_test(net_rx_add_membership_null_rx),
+		cmocka_unit_test(net_rx_recv_null_rx),
+		cmocka_unit_test(net_rx_classify_null_cls),
+		cmocka_unit_test(net_rx_create_invalid_block_size),
+		cmocka_unit_test(net_rx_recv_empty),
+		cmocka_unit_test(net_rx_recv),
+		cmocka_unit_test(net_rx_classify),
+		cmocka_unit_test(net_engine_create_null_engine),
+		cmocka_unit_test(net_engine_create_null_cfg),
+		cmocka_unit_test(net_engine_create_invalid_cfg),
+		cmocka_unit_test(net_engine_null_engine),
+		cmocka_unit_test(net_engine_running),
+		cmocka_unit_test(net_engine_steering),
+		cmocka_unit_test(net_tx_create_null_tx),
+		cmocka_unit_test(net_tx_create_null_cfg),
+		cmocka_unit_test(net_tx_create_invalid_ifname),
+		cmocka_unit_test(net_tx_null_tx),
+		cmocka_unit_test(net_tx_commit_not_reserved),
+		cmocka_unit_test(net_tx_queue_too_large),
+		cmocka_unit_test(net_tx_queue_full),
+		cmocka_unit_test(net_tx_flush_empty),
+		cmocka_unit_test(net_tx_flush),
+		cmocka_unit_test(net_rx_create_invalid_backend),
+		cmocka_unit_test(net_rx_xdp_create_invalid_frame_size),
+		cmocka_unit_test(net_rx_xdp_recv),
+		cmocka_unit_test(net_tx_xdp_create_txtime),
+		cmocka_unit_test(net_tx_xdp_flush),
+		cmocka_unit_test(net_rx_create_tstamp_xdp),
+		cmocka_unit_test(net_rx_create_tstamp_hardware),
+		cmocka_unit_test(net_rx_recv_ts),
+		cmocka_unit_test(net_tx_create_tstamp_xdp),
+		cmocka_unit_test(net_tx_get_reports_disabled),
+		cmocka_unit_test(net_tx_get_reports),
+		cmocka_unit_test(net_mux_null_mux),
+		cmocka_unit_test(net_mux_add_stream_invalid),
+		cmocka_unit_test(net_mux_idleslope),
+		cmocka_unit_test(net_mux_run_stuck),
+		cmocka_unit_test(net_mux_run),
+		cmocka_unit_test(net_mux_overrun),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
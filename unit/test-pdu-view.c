@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_crf.h"
+#include "avtp_cvf.h"
+#include "avtp_ieciidc.h"
+#include "avtp_inline.h"
+#include "avtp_pdu_view.h"
+#include "avtp_rvf.h"
+#include "avtp_tscf.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define STREAM_HDR_LEN		sizeof(struct avtp_stream_pdu)
+#define BUF_LEN			256
+
+static void init_aaf(uint8_t *buf, uint16_t data_len)
+{
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.seq_num = 7,
+			.stream_id = STREAM_ID,
+			.stream_data_len = data_len,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+	};
+
+	assert_int_equal(avtp_aaf_pdu_pack((struct avtp_stream_pdu *) buf,
+								&hdr), 0);
+}
+
+static void init_cvf(uint8_t *buf, uint8_t format_subtype,
+							uint16_t data_len)
+{
+	struct avtp_cvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.stream_id = STREAM_ID,
+			.stream_data_len = data_len,
+		},
+		.format = AVTP_CVF_FORMAT_RFC,
+		.format_subtype = format_subtype,
+		.m = 1,
+		.h264_timestamp = 0x12345678,
+	};
+
+	assert_int_equal(avtp_cvf_pdu_pack((struct avtp_stream_pdu *) buf,
+								&hdr), 0);
+}
+
+static void init_ieciidc(uint8_t *buf, uint8_t tag, uint16_t data_len)
+{
+	struct avtp_ieciidc_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.stream_id = STREAM_ID,
+			.stream_data_len = data_len,
+		},
+		.tag = tag,
+		.channel = 31,
+		.tcode = 0xA,
+		.cip_sid = 63,
+		.cip_dbs = 6,
+	};
+
+	assert_int_equal(avtp_ieciidc_pdu_pack((struct avtp_stream_pdu *) buf,
+								&hdr), 0);
+}
+
+static void pdu_view_init_null(void **state)
+{
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+
+	init_aaf(buf, 0);
+
+	assert_int_equal(avtp_pdu_view_init(NULL, buf, sizeof(buf),
+						AVTP_SUBTYPE_AAF), -EINVAL);
+	assert_int_equal(avtp_pdu_view_init(&view, NULL, sizeof(buf),
+						AVTP_SUBTYPE_AAF), -EINVAL);
+}
+
+static void pdu_view_init_unsupported(void **state)
+{
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+
+	avtp_common_set_subtype((struct avtp_common_pdu *) buf,
+							AVTP_SUBTYPE_ADP);
+
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_ADP), -EINVAL);
+}
+
+static void pdu_view_init_subtype_mismatch(void **state)
+{
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+
+	init_aaf(buf, 0);
+
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_CVF), -EINVAL);
+}
+
+static void pdu_view_init_truncated(void **state)
+{
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+
+	init_aaf(buf, 8);
+
+	/* Too short for the header. */
+	assert_int_equal(avtp_pdu_view_init(&view, buf, STREAM_HDR_LEN - 1,
+						AVTP_SUBTYPE_AAF), -EINVAL);
+	/* Too short for 'stream_data_length'. */
+	assert_int_equal(avtp_pdu_view_init(&view, buf, STREAM_HDR_LEN + 7,
+						AVTP_SUBTYPE_AAF), -EINVAL);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, STREAM_HDR_LEN + 8,
+						AVTP_SUBTYPE_AAF), 0);
+}
+
+static void pdu_view_aaf(void **state)
+{
+	const struct avtp_stream_pdu *pdu;
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	const uint8_t *data;
+	size_t len;
+
+	init_aaf(buf, 24);
+
+	/* Trailing bytes (e.g. Ethernet padding) are fine. */
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_AAF), 0);
+	assert_ptr_equal(view.buf, buf);
+	assert_int_equal(view.len, sizeof(buf));
+
+	pdu = avtp_pdu_view_stream(&view);
+	assert_int_equal(avtp_stream_get_seq_num(pdu), 7);
+	assert_int_equal(avtp_aaf_get_chan_per_frame(pdu), 2);
+
+	data = avtp_pdu_view_data(&view, &len);
+	assert_ptr_equal(data, buf + STREAM_HDR_LEN);
+	assert_int_equal(len, 24);
+
+	/* Sub-headers from other formats aren't available. */
+	assert_null(avtp_pdu_view_cvf_hdr(&view));
+	assert_null(avtp_pdu_view_rvf_hdr(&view));
+	assert_null(avtp_pdu_view_ieciidc_hdr(&view));
+}
+
+static void pdu_view_cvf_h264(void **state)
+{
+	const struct avtp_cvf_hdr *hdr;
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	const uint8_t *data;
+	size_t len;
+
+	/* H.264 header doesn't fit in 'stream_data_length'. */
+	init_cvf(buf, AVTP_CVF_FORMAT_SUBTYPE_H264, 3);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_CVF), -EINVAL);
+
+	init_cvf(buf, AVTP_CVF_FORMAT_SUBTYPE_H264, 100);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_CVF), 0);
+
+	data = avtp_pdu_view_data(&view, &len);
+	assert_ptr_equal(data, buf + STREAM_HDR_LEN +
+				sizeof(struct avtp_cvf_h264_payload));
+	assert_int_equal(len, 100 - sizeof(struct avtp_cvf_h264_payload));
+
+	hdr = avtp_pdu_view_cvf_hdr(&view);
+	assert_non_null(hdr);
+	assert_int_equal(hdr->stream.stream_id, STREAM_ID);
+	assert_int_equal(hdr->format_subtype, AVTP_CVF_FORMAT_SUBTYPE_H264);
+	assert_int_equal(hdr->m, 1);
+	assert_int_equal(hdr->h264_timestamp, 0x12345678);
+
+	/* Fields are decoded once, so changes to the buffer after the first
+	 * call aren't seen.
+	 */
+	memset(buf, 0, sizeof(buf));
+	assert_ptr_equal(avtp_pdu_view_cvf_hdr(&view), hdr);
+	assert_int_equal(hdr->h264_timestamp, 0x12345678);
+}
+
+static void pdu_view_cvf_mjpeg(void **state)
+{
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	size_t len;
+
+	/* No H.264 header, so the whole payload is data. */
+	init_cvf(buf, AVTP_CVF_FORMAT_SUBTYPE_MJPEG, 3);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_CVF), 0);
+
+	avtp_pdu_view_data(&view, &len);
+	assert_int_equal(len, 3);
+	assert_int_equal(avtp_pdu_view_cvf_hdr(&view)->h264_timestamp, 0);
+}
+
+static void pdu_view_rvf(void **state)
+{
+	struct avtp_rvf_hdr rvf = {
+		.stream = {
+			.sv = 1,
+			.stream_id = STREAM_ID,
+			.stream_data_len = 4,
+		},
+		.active_pixels = 1920,
+		.total_lines = 1080,
+		.raw_num_lines = 1,
+		.raw_line_number = 42,
+	};
+	const struct avtp_rvf_hdr *hdr;
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	const uint8_t *data;
+	size_t len;
+
+	assert_int_equal(avtp_rvf_pdu_pack((struct avtp_stream_pdu *) buf,
+								&rvf), 0);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_RVF), -EINVAL);
+
+	rvf.stream.stream_data_len = sizeof(struct avtp_rvf_payload) + 64;
+	assert_int_equal(avtp_rvf_pdu_pack((struct avtp_stream_pdu *) buf,
+								&rvf), 0);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+						AVTP_SUBTYPE_RVF), 0);
+
+	data = avtp_pdu_view_data(&view, &len);
+	assert_ptr_equal(data, buf + AVTP_RVF_RAW_HDR_LEN);
+	assert_int_equal(len, 64);
+
+	hdr = avtp_pdu_view_rvf_hdr(&view);
+	assert_non_null(hdr);
+	assert_int_equal(hdr->active_pixels, 1920);
+	assert_int_equal(hdr->total_lines, 1080);
+	assert_int_equal(hdr->raw_line_number, 42);
+	assert_null(avtp_pdu_view_cvf_hdr(&view));
+}
+
+static void pdu_view_ieciidc(void **state)
+{
+	const struct avtp_ieciidc_hdr *hdr;
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	const uint8_t *data;
+	size_t len;
+
+	/* CIP header doesn't fit in 'stream_data_length'. */
+	init_ieciidc(buf, AVTP_IECIIDC_TAG_CIP, 4);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+					AVTP_SUBTYPE_61883_IIDC), -EINVAL);
+
+	/* Without CIP header, the whole payload is data. */
+	init_ieciidc(buf, AVTP_IECIIDC_TAG_NO_CIP, 4);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+					AVTP_SUBTYPE_61883_IIDC), 0);
+	avtp_pdu_view_data(&view, &len);
+	assert_int_equal(len, 4);
+
+	init_ieciidc(buf, AVTP_IECIIDC_TAG_CIP, 200);
+	assert_int_equal(avtp_pdu_view_init(&view, buf, sizeof(buf),
+					AVTP_SUBTYPE_61883_IIDC), 0);
+
+	data = avtp_pdu_view_data(&view, &len);
+	assert_ptr_equal(data, buf + STREAM_HDR_LEN +
+				sizeof(struct avtp_ieciidc_cip_payload));
+	assert_int_equal(len, 200 - sizeof(struct avtp_ieciidc_cip_payload));
+
+	hdr = avtp_pdu_view_ieciidc_hdr(&view);
+	assert_non_null(hdr);
+	assert_int_equal(hdr->tag, AVTP_IECIIDC_TAG_CIP);
+	assert_int_equal(hdr->channel, 31);
+	assert_int_equal(hdr->cip_sid, 63);
+	assert_int_equal(hdr->cip_dbs, 6);
+}
+
+static void pdu_view_crf(void **state)
+{
+	struct avtp_crf_hdr crf = {
+		.sv = 1,
+		.stream_id = STREAM_ID,
+		.type = AVTP_CRF_TYPE_AUDIO_SAMPLE,
+		.base_freq = 48000,
+		.timestamp_interval = 160,
+		.crf_data_len = 48,
+	};
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	const uint8_t *data;
+	size_t len;
+
+	assert_int_equal(avtp_crf_pdu_pack((struct avtp_crf_pdu *) buf,
+								&crf), 0);
+
+	assert_int_equal(avtp_pdu_view_init(&view, buf,
+					sizeof(struct avtp_crf_pdu) + 47,
+					AVTP_SUBTYPE_CRF), -EINVAL);
+	assert_int_equal(avtp_pdu_view_init(&view, buf,
+					sizeof(struct avtp_crf_pdu) + 48,
+					AVTP_SUBTYPE_CRF), 0);
+
+	assert_int_equal(avtp_crf_get_base_freq(avtp_pdu_view_crf(&view)),
+									48000);
+
+	data = avtp_pdu_view_data(&view, &len);
+	assert_ptr_equal(data, buf + sizeof(struct avtp_crf_pdu));
+	assert_int_equal(len, 48);
+}
+
+static void pdu_view_ntscf(void **state)
+{
+	struct avtp_ntscf_hdr ntscf = {
+		.sv = 1,
+		.stream_id = STREAM_ID,
+		.data_len = 32,
+	};
+	struct avtp_pdu_view view;
+	uint8_t buf[BUF_LEN] = { 0 };
+	const uint8_t *data;
+	size_t len;
+
+	assert_int_equal(avtp_ntscf_pdu_pack((struct avtp_ntscf_pdu *) buf,
+								&ntscf), 0);
+
+	assert_int_equal(avtp_pdu_view_init(&view, buf,
+					sizeof(struct avtp_ntscf_pdu) + 31,
+					AVTP_SUBTYPE_NTSCF), -EINVAL);
+	assert_int_equal(avtp_pdu_view_init(&view, buf,
+					sizeof(struct avtp_ntscf_pdu) + 32,
+					AVTP_SUBTYPE_NTSCF), 0);
+
+	assert_int_equal(avtp_ntscf_get_stream_id(avtp_pdu_view_ntscf(&view)),
+								STREAM_ID);
+
+	data = avtp_pdu_view_data(&view, &len);
+	assert_ptr_equal(data, buf + sizeof(struct avtp_ntscf_pdu));
+	assert_int_equal(len, 32);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(pdu_view_init_null),
+		cmocka_unit_test(pdu_view_init_unsupported),
+		cmocka_unit_test(pdu_view_init_subtype_mismatch),
+		cmocka_unit_test(pdu_view_init_truncated),
+		cmocka_unit_test(pdu_view_aaf),
+		cmocka_unit_test(pdu_view_cvf_h264),
+		cmocka_unit_test(pdu_view_cvf_mjpeg),
+		cmocka_unit_test(pdu_view_rvf),
+		cmocka_unit_test(pdu_view_ieciidc),
+		cmocka_unit_test(pdu_view_crf),
+		cmocka_unit_test(pdu_view_ntscf),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "avtp_pool.h"
+
+#define COUNT			8
+#define PDU_SIZE		100
+#define CACHE_LINE_SIZE		64
+
+/* Number of PDUs handed between threads in the concurrency test. */
+#define NUM_TRANSFERS		200000
+
+static void pool_create_null_pool(void **state)
+{
+	int res;
+
+	res = avtp_pool_create(NULL, COUNT, PDU_SIZE);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void pool_create_invalid_count(void **state)
+{
+	struct avtp_pool *pool;
+	int res;
+
+	res = avtp_pool_create(&pool, 0, PDU_SIZE);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void pool_create_invalid_size(void **state)
+{
+	struct avtp_pool *pool;
+	int res;
+
+	res = avtp_pool_create(&pool, COUNT, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void pool_null_args(void **state)
+{
+	struct avtp_pool *pool;
+	void *pdu, *pdus[1];
+	size_t len, lens[1];
+
+	assert_int_equal(avtp_pool_create(&pool, COUNT, PDU_SIZE), 0);
+
+	assert_int_equal(avtp_pool_alloc(NULL, &pdu), -EINVAL);
+	assert_int_equal(avtp_pool_alloc(pool, NULL), -EINVAL);
+	assert_int_equal(avtp_pool_submit(NULL, pool, 0), -EINVAL);
+	assert_int_equal(avtp_pool_submit(pool, NULL, 0), -EINVAL);
+	assert_int_equal(avtp_pool_receive(NULL, &pdu, &len), -EINVAL);
+	assert_int_equal(avtp_pool_receive(pool, NULL, &len), -EINVAL);
+	assert_int_equal(avtp_pool_receive(pool, &pdu, NULL), -EINVAL);
+	assert_int_equal(avtp_pool_receive_burst(NULL, pdus, lens, 1),
+								-EINVAL);
+	assert_int_equal(avtp_pool_release(NULL, pool), -EINVAL);
+	assert_int_equal(avtp_pool_release(pool, NULL), -EINVAL);
+
+	avtp_pool_destroy(pool);
+}
+
+static void pool_alloc(void **state)
+{
+	struct avtp_pool *pool;
+	void *pdus[COUNT], *pdu;
+	int i, j;
+
+	assert_int_equal(avtp_pool_create(&pool, COUNT, PDU_SIZE), 0);
+
+	for (i = 0; i < COUNT; i++) {
+		assert_int_equal(avtp_pool_alloc(pool, &pdus[i]), 0);
+
+		/* Buffers are cache line aligned and don't overlap. */
+		assert_int_equal((uintptr_t) pdus[i] % CACHE_LINE_SIZE, 0);
+		memset(pdus[i], i, PDU_SIZE);
+		for (j = 0; j < i; j++)
+			assert_ptr_not_equal(pdus[i], pdus[j]);
+	}
+
+	assert_int_equal(avtp_pool_alloc(pool, &pdu), -ENOBUFS);
+
+	for (i = 0; i < COUNT; i++) {
+		uint8_t expected[PDU_SIZE];
+
+		memset(expected, i, PDU_SIZE);
+		assert_memory_equal(pdus[i], expected, PDU_SIZE);
+	}
+
+	avtp_pool_destroy(pool);
+}
+
+static void pool_submit_invalid_buffer(void **state)
+{
+	struct avtp_pool *pool;
+	uint8_t *pdu;
+	int res;
+
+	assert_int_equal(avtp_pool_create(&pool, COUNT, PDU_SIZE), 0);
+	assert_int_equal(avtp_pool_alloc(pool, (void **) &pdu), 0);
+
+	res = avtp_pool_submit(pool, pdu + 1, PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_pool_submit(pool, pdu, PDU_SIZE + 1);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_pool_release(pool, &res);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_pool_destroy(pool);
+}
+
+static void pool_receive_empty(void **state)
+{
+	struct avtp_pool *pool;
+	void *pdu;
+	size_t len;
+	int res;
+
+	assert_int_equal(avtp_pool_create(&pool, COUNT, PDU_SIZE), 0);
+
+	res = avtp_pool_receive(pool, &pdu, &len);
+
+	assert_int_equal(res, -EAGAIN);
+	avtp_pool_destroy(pool);
+}
+
+static void pool_submit_receive(void **state)
+{
+	struct avtp_pool *pool;
+	void *pdus[COUNT], *rx[COUNT];
+	size_t lens[COUNT];
+	int i, n;
+
+	assert_int_equal(avtp_pool_create(&pool, COUNT, PDU_SIZE), 0);
+
+	for (i = 0; i < COUNT; i++) {
+		assert_int_equal(avtp_pool_alloc(pool, &pdus[i]), 0);
+		assert_int_equal(avtp_pool_submit(pool, pdus[i], i + 1), 0);
+	}
+
+	/* PDUs are received in submission order. */
+	n = avtp_pool_receive_burst(pool, rx, lens, 3);
+	assert_int_equal(n, 3);
+	n += avtp_pool_receive_burst(pool, rx + n, lens + n, COUNT);
+	assert_int_equal(n, COUNT);
+
+	for (i = 0; i < COUNT; i++) {
+		assert_ptr_equal(rx[i], pdus[i]);
+		assert_int_equal(lens[i], i + 1);
+		assert_int_equal(avtp_pool_release(pool, rx[i]), 0);
+	}
+
+	assert_int_equal(avtp_pool_receive_burst(pool, rx, lens, COUNT), 0);
+
+	/* Released buffers can be allocated again. */
+	for (i = 0; i < COUNT; i++)
+		assert_int_equal(avtp_pool_alloc(pool, &pdus[i]), 0);
+
+	avtp_pool_destroy(pool);
+}
+
+static void *producer(void *arg)
+{
+	struct avtp_pool *pool = arg;
+	uint32_t i = 0;
+
+	while (i < NUM_TRANSFERS) {
+		uint32_t *pdu;
+
+		/* Let the consumer run in case both threads share a CPU. */
+		if (avtp_pool_alloc(pool, (void **) &pdu) < 0) {
+			sched_yield();
+			continue;
+		}
+
+		pdu[0] = i;
+		pdu[PDU_SIZE / sizeof(uint32_t) - 1] = ~i;
+		avtp_pool_submit(pool, pdu, (i % PDU_SIZE) + 1);
+		i++;
+	}
+
+	return NULL;
+}
+
+static void pool_threads(void **state)
+{
+	struct avtp_pool *pool;
+	pthread_t thread;
+	uint32_t expected = 0;
+
+	assert_int_equal(avtp_pool_create(&pool, COUNT, PDU_SIZE), 0);
+	assert_int_equal(pthread_create(&thread, NULL, producer, pool), 0);
+
+	while (expected < NUM_TRANSFERS) {
+		void *pdus[COUNT];
+		size_t lens[COUNT];
+		int i, n;
+
+		n = avtp_pool_receive_burst(pool, pdus, lens, COUNT);
+		assert_true(n >= 0);
+		if (n == 0)
+			sched_yield();
+
+		for (i = 0; i < n; i++) {
+			uint32_t *pdu = pdus[i];
+
+			assert_int_equal(pdu[0], expected);
+			assert_int_equal(pdu[PDU_SIZE / sizeof(uint32_t) - 1],
+								~expected);
+			assert_int_equal(lens[i], (expected % PDU_SIZE) + 1);
+			avtp_pool_release(pool, pdu);
+			expected++;
+		}
+	}
+
+	pthread_join(thread, NULL);
+	avtp_pool_destroy(pool);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(pool_create_null_pool),
+		cmocka_unit_test(pool_create_invalid_count),
+		cmocka_unit_test(pool_create_invalid_size),
+		cmocka_unit_test(pool_null_args),
+		cmocka_unit_test(pool_alloc),
+		cmocka_unit_test(pool_submit_invalid_buffer),
+		cmocka_unit_test(pool_receive_empty),
+		cmocka_unit_test(pool_submit_receive),
+		cmocka_unit_test(pool_threads),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp.h"
+#include "avtp_inline.h"
+#include "avtp_rvf.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define WIDTH			4
+#define HEIGHT			6
+/* 4 pixels, 4:2:2 with 8-bit depth. */
+#define LINE_LEN		8
+#define STRIDE			12
+#define FRAME_SIZE		(HEIGHT * STRIDE)
+#define MAX_PDU_SIZE		(AVTP_RVF_RAW_HDR_LEN + 2 * LINE_LEN + 3)
+
+static void init_tmpl(uint8_t *tmpl, uint8_t interlaced)
+{
+	struct avtp_rvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.stream_id = STREAM_ID,
+		},
+		.active_pixels = WIDTH,
+		.total_lines = HEIGHT,
+		.i = interlaced,
+		.raw_pixel_depth = AVTP_RVF_PIXEL_DEPTH_8,
+		.raw_pixel_format = AVTP_RVF_PIXEL_FORMAT_422,
+		.raw_frame_rate = AVTP_RVF_FRAME_RATE_60,
+		.raw_colorspace = AVTP_RVF_COLORSPACE_YCbCr,
+		/* The packetizer is in charge of these. */
+		.ef = 1,
+		.raw_line_number = 7,
+	};
+	int res;
+
+	res = avtp_rvf_pdu_pack((struct avtp_stream_pdu *)tmpl, &hdr);
+	assert_int_equal(res, 0);
+}
+
+static void init_packetizer(struct avtp_rvf_raw_packetizer *pkt,
+			    uint8_t interlaced, size_t max_pdu_size)
+{
+	uint8_t tmpl[AVTP_RVF_RAW_HDR_LEN];
+	int res;
+
+	init_tmpl(tmpl, interlaced);
+
+	res = avtp_rvf_raw_packetizer_init(pkt, (struct avtp_stream_pdu *)tmpl,
+					   max_pdu_size);
+	assert_int_equal(res, 0);
+}
+
+/* Fill frame buffer so each line starts with its row number. Padding bytes
+ * past the end of lines are set to 0xFF.
+ */
+static void init_frame(uint8_t *frame)
+{
+	int row, i;
+
+	memset(frame, 0xFF, FRAME_SIZE);
+	for (row = 0; row < HEIGHT; row++)
+		for (i = 0; i < LINE_LEN; i++)
+			frame[row * STRIDE + i] = row * 16 + i;
+}
+
+/* Gather PDU scattered by the packetizer into 'buf'. */
+static size_t gather(const struct avtp_rvf_raw_packet *packet, uint8_t *buf)
+{
+	size_t i, len = 0;
+
+	for (i = 0; i < packet->iovcnt; i++) {
+		memcpy(buf + len, packet->iov[i].iov_base,
+		       packet->iov[i].iov_len);
+		len += packet->iov[i].iov_len;
+	}
+
+	return len;
+}
+
+static void check_pdu(const struct avtp_rvf_raw_packet *packet,
+		      uint8_t seq_num, uint8_t f, uint8_t ef,
+		      uint8_t i_seq_num, uint16_t line, uint8_t num_lines)
+{
+	const struct avtp_stream_pdu *pdu;
+	struct avtp_rvf_hdr hdr;
+	int res;
+
+	pdu = (const struct avtp_stream_pdu *)packet->hdr;
+	res = avtp_rvf_pdu_unpack(pdu, &hdr);
+	assert_int_equal(res, 0);
+
+	assert_int_equal(hdr.stream.seq_num, seq_num);
+	assert_int_equal(hdr.stream.timestamp, 0x11223344);
+	assert_int_equal(hdr.stream.stream_data_len,
+			 sizeof(struct avtp_rvf_payload) +
+			 num_lines * LINE_LEN);
+	assert_int_equal(hdr.stream.stream_id, STREAM_ID);
+	assert_int_equal(hdr.active_pixels, WIDTH);
+	assert_int_equal(hdr.total_lines, HEIGHT);
+	assert_int_equal(hdr.f, f);
+	assert_int_equal(hdr.ef, ef);
+	assert_int_equal(hdr.raw_pixel_format, AVTP_RVF_PIXEL_FORMAT_422);
+	assert_int_equal(hdr.raw_frame_rate, AVTP_RVF_FRAME_RATE_60);
+	assert_int_equal(hdr.raw_i_seq_num, i_seq_num);
+	assert_int_equal(hdr.raw_line_number, line);
+	assert_int_equal(hdr.raw_num_lines, num_lines);
+	assert_ptr_equal(packet->iov[0].iov_base, packet->hdr);
+	assert_int_equal(packet->iov[0].iov_len, AVTP_RVF_RAW_HDR_LEN);
+}
+
+static void rvf_raw_packetizer_init_null(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	uint8_t tmpl[AVTP_RVF_RAW_HDR_LEN];
+	int res;
+
+	init_tmpl(tmpl, 0);
+
+	res = avtp_rvf_raw_packetizer_init(NULL,
+				(struct avtp_stream_pdu *)tmpl, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_packetizer_init(&pkt, NULL, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_raw_packetizer_init_invalid_tmpl(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	uint8_t tmpl[AVTP_RVF_RAW_HDR_LEN];
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *)tmpl;
+	int res;
+
+	/* Not a RVF PDU. */
+	init_tmpl(tmpl, 0);
+	pdu->subtype_data = htonl(AVTP_SUBTYPE_CVF << 24);
+	res = avtp_rvf_raw_packetizer_init(&pkt, pdu, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	/* User defined pixel format. */
+	init_tmpl(tmpl, 0);
+	res = avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_PIXEL_FORMAT,
+			       AVTP_RVF_PIXEL_FORMAT_USER);
+	assert_int_equal(res, 0);
+	res = avtp_rvf_raw_packetizer_init(&pkt, pdu, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	/* User defined pixel depth. */
+	init_tmpl(tmpl, 0);
+	res = avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_PIXEL_DEPTH,
+			       AVTP_RVF_PIXEL_DEPTH_USER);
+	assert_int_equal(res, 0);
+	res = avtp_rvf_raw_packetizer_init(&pkt, pdu, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	/* 3 pixels 4:2:0 with 10-bit depth are 45 bits long. */
+	init_tmpl(tmpl, 0);
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_ACTIVE_PIXELS, 3);
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_PIXEL_FORMAT,
+			 AVTP_RVF_PIXEL_FORMAT_420);
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_PIXEL_DEPTH,
+			 AVTP_RVF_PIXEL_DEPTH_10);
+	res = avtp_rvf_raw_packetizer_init(&pkt, pdu, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+
+	/* Interlaced frame with an odd number of lines. */
+	init_tmpl(tmpl, 1);
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_TOTAL_LINES, HEIGHT + 1);
+	res = avtp_rvf_raw_packetizer_init(&pkt, pdu, MAX_PDU_SIZE);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_raw_packetizer_init_small_pdu(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	uint8_t tmpl[AVTP_RVF_RAW_HDR_LEN];
+	int res;
+
+	init_tmpl(tmpl, 0);
+
+	res = avtp_rvf_raw_packetizer_init(&pkt, (struct avtp_stream_pdu *)tmpl,
+					   AVTP_RVF_RAW_HDR_LEN + LINE_LEN - 1);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_packetizer_init(&pkt, (struct avtp_stream_pdu *)tmpl,
+					   AVTP_RVF_RAW_HDR_LEN + LINE_LEN);
+	assert_int_equal(res, 0);
+}
+
+static void rvf_raw_packetizer_start_invalid(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	uint8_t frame[FRAME_SIZE];
+	int res;
+
+	init_packetizer(&pkt, 0, MAX_PDU_SIZE);
+
+	res = avtp_rvf_raw_packetizer_start(NULL, frame, STRIDE, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_packetizer_start(&pkt, NULL, STRIDE, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_packetizer_start(&pkt, frame, LINE_LEN - 1, 0);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_raw_packetizer_next_null(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_packet packet;
+	int res;
+
+	init_packetizer(&pkt, 0, MAX_PDU_SIZE);
+
+	res = avtp_rvf_raw_packetizer_next(NULL, &packet);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	/* No frame started yet. */
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+}
+
+static void rvf_raw_packetizer_progressive(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_packet packet;
+	uint8_t frame[FRAME_SIZE];
+	int res, i;
+
+	init_packetizer(&pkt, 0, MAX_PDU_SIZE);
+	init_frame(frame);
+
+	res = avtp_rvf_raw_packetizer_start(&pkt, frame, STRIDE, 0x11223344);
+	assert_int_equal(res, 0);
+
+	/* Two lines per PDU, each one in its own iovec since lines are not
+	 * contiguous.
+	 */
+	for (i = 0; i < HEIGHT / 2; i++) {
+		res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+		assert_int_equal(res, 1);
+		check_pdu(&packet, i, 0, i == HEIGHT / 2 - 1, 0, i * 2 + 1, 2);
+		assert_int_equal(packet.iovcnt, 3);
+		assert_ptr_equal(packet.iov[1].iov_base,
+				 frame + i * 2 * STRIDE);
+		assert_int_equal(packet.iov[1].iov_len, LINE_LEN);
+		assert_ptr_equal(packet.iov[2].iov_base,
+				 frame + (i * 2 + 1) * STRIDE);
+		assert_int_equal(packet.iov[2].iov_len, LINE_LEN);
+	}
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+
+	/* Next frame carries the next 'i_seq_num'. */
+	res = avtp_rvf_raw_packetizer_start(&pkt, frame, STRIDE, 0x11223344);
+	assert_int_equal(res, 0);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 3, 0, 0, 1, 1, 2);
+}
+
+static void rvf_raw_packetizer_contiguous(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_packet packet;
+	uint8_t frame[FRAME_SIZE];
+	int res;
+
+	/* Up to 5 lines per PDU, so the last PDU carries a single line. */
+	init_packetizer(&pkt, 0, AVTP_RVF_RAW_HDR_LEN + 5 * LINE_LEN);
+
+	res = avtp_rvf_raw_packetizer_start(&pkt, frame, LINE_LEN, 0x11223344);
+	assert_int_equal(res, 0);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 0, 0, 0, 0, 1, 5);
+	assert_int_equal(packet.iovcnt, 2);
+	assert_ptr_equal(packet.iov[1].iov_base, frame);
+	assert_int_equal(packet.iov[1].iov_len, 5 * LINE_LEN);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 1, 0, 1, 0, 6, 1);
+	assert_int_equal(packet.iovcnt, 2);
+	assert_ptr_equal(packet.iov[1].iov_base, frame + 5 * LINE_LEN);
+	assert_int_equal(packet.iov[1].iov_len, LINE_LEN);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+}
+
+static void rvf_raw_packetizer_max_lines(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_packet packet;
+	uint8_t tmpl[AVTP_RVF_RAW_HDR_LEN];
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *)tmpl;
+	uint8_t frame[32 * LINE_LEN];
+	uint64_t val;
+	int res;
+
+	/* Many more lines than 'num_lines' can tell fit in a 1500 byte PDU. */
+	init_tmpl(tmpl, 0);
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_TOTAL_LINES, 32);
+
+	res = avtp_rvf_raw_packetizer_init(&pkt, pdu, 1500);
+	assert_int_equal(res, 0);
+
+	res = avtp_rvf_raw_packetizer_start(&pkt, frame, LINE_LEN, 0);
+	assert_int_equal(res, 0);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+
+	pdu = (struct avtp_stream_pdu *)packet.hdr;
+	avtp_rvf_pdu_get(pdu, AVTP_RVF_FIELD_RAW_NUM_LINES, &val);
+	assert_int_equal(val, AVTP_RVF_RAW_MAX_LINES);
+	avtp_rvf_pdu_get(pdu, AVTP_RVF_FIELD_RAW_LINE_NUMBER, &val);
+	assert_int_equal(val, AVTP_RVF_RAW_MAX_LINES + 1);
+	assert_int_equal(packet.iovcnt, 2);
+	assert_int_equal(packet.iov[1].iov_len,
+			 AVTP_RVF_RAW_MAX_LINES * LINE_LEN);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	avtp_rvf_pdu_get(pdu, AVTP_RVF_FIELD_RAW_NUM_LINES, &val);
+	assert_int_equal(val, 2);
+	avtp_rvf_pdu_get(pdu, AVTP_RVF_FIELD_EF, &val);
+	assert_int_equal(val, 1);
+}
+
+static void rvf_raw_packetizer_interlaced(void **state)
+{
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_packet packet;
+	uint8_t frame[FRAME_SIZE];
+	int res;
+
+	init_packetizer(&pkt, 1, MAX_PDU_SIZE);
+	init_frame(frame);
+
+	res = avtp_rvf_raw_packetizer_start(&pkt, frame, STRIDE, 0x11223344);
+	assert_int_equal(res, 0);
+
+	/* First field, made of the even lines. */
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 0, 0, 0, 0, 1, 2);
+	assert_int_equal(packet.iovcnt, 3);
+	assert_ptr_equal(packet.iov[1].iov_base, frame);
+	assert_ptr_equal(packet.iov[2].iov_base, frame + 2 * STRIDE);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 1, 0, 0, 0, 3, 1);
+	assert_int_equal(packet.iovcnt, 2);
+	assert_ptr_equal(packet.iov[1].iov_base, frame + 4 * STRIDE);
+
+	/* Second field, made of the odd lines. */
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 2, 1, 0, 0, 1, 2);
+	assert_ptr_equal(packet.iov[1].iov_base, frame + STRIDE);
+	assert_ptr_equal(packet.iov[2].iov_base, frame + 3 * STRIDE);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	check_pdu(&packet, 3, 1, 1, 0, 3, 1);
+	assert_ptr_equal(packet.iov[1].iov_base, frame + 5 * STRIDE);
+
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 0);
+}
+
+/* Packetize 'src' frame and push its PDUs into 'depkt', skipping the PDU
+ * with sequence number 'skip'. Returns the result of the last push.
+ */
+static int transfer_frame(struct avtp_rvf_raw_packetizer *pkt,
+			  struct avtp_rvf_raw_depacketizer *depkt,
+			  const uint8_t *src, int skip,
+			  struct avtp_rvf_raw_frame *frame)
+{
+	struct avtp_rvf_raw_packet packet;
+	uint8_t buf[MAX_PDU_SIZE];
+	int res, ret = 0;
+	size_t len;
+
+	res = avtp_rvf_raw_packetizer_start(pkt, src, STRIDE, 0x11223344);
+	assert_int_equal(res, 0);
+
+	while (avtp_rvf_raw_packetizer_next(pkt, &packet) == 1) {
+		const struct avtp_stream_pdu *pdu;
+
+		pdu = (const struct avtp_stream_pdu *)packet.hdr;
+		if (avtp_stream_get_seq_num(pdu) == skip)
+			continue;
+
+		len = gather(&packet, buf);
+		ret = avtp_rvf_raw_depacketizer_push(depkt,
+				(struct avtp_stream_pdu *)buf, len, frame);
+		assert_true(ret >= 0);
+	}
+
+	return ret;
+}
+
+static void rvf_raw_depacketizer_invalid(void **state)
+{
+	struct avtp_rvf_raw_depacketizer depkt;
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_packet packet;
+	struct avtp_rvf_raw_frame frame;
+	uint8_t src[FRAME_SIZE], dst[FRAME_SIZE];
+	uint8_t buf[MAX_PDU_SIZE];
+	struct avtp_stream_pdu *pdu = (struct avtp_stream_pdu *)buf;
+	size_t len;
+	int res;
+
+	res = avtp_rvf_raw_depacketizer_init(NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_depacketizer_init(&depkt);
+	assert_int_equal(res, 0);
+
+	res = avtp_rvf_raw_depacketizer_set_frame(NULL, dst, STRIDE,
+						  sizeof(dst));
+	assert_int_equal(res, -EINVAL);
+	res = avtp_rvf_raw_depacketizer_set_frame(&depkt, NULL, STRIDE,
+						  sizeof(dst));
+	assert_int_equal(res, -EINVAL);
+
+	init_packetizer(&pkt, 0, MAX_PDU_SIZE);
+	init_frame(src);
+	res = avtp_rvf_raw_packetizer_start(&pkt, src, STRIDE, 0);
+	assert_int_equal(res, 0);
+	res = avtp_rvf_raw_packetizer_next(&pkt, &packet);
+	assert_int_equal(res, 1);
+	len = gather(&packet, buf);
+
+	/* No frame buffer set. */
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_rvf_raw_depacketizer_set_frame(&depkt, dst, STRIDE,
+						  sizeof(dst));
+	assert_int_equal(res, 0);
+
+	res = avtp_rvf_raw_depacketizer_push(NULL, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, NULL, len, &frame);
+	assert_int_equal(res, -EINVAL);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	/* Truncated PDU. */
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len - 1, &frame);
+	assert_int_equal(res, -EINVAL);
+
+	/* 'stream_data_length' not matching the lines carried. */
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_STREAM_DATA_LEN,
+			 sizeof(struct avtp_rvf_payload) + LINE_LEN);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_STREAM_DATA_LEN,
+			 sizeof(struct avtp_rvf_payload) + 2 * LINE_LEN);
+
+	/* Line number 0. */
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_LINE_NUMBER, 0);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+
+	/* Last line past the end of the frame buffer. */
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_LINE_NUMBER, HEIGHT);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+
+	/* Lines longer than the stride. */
+	avtp_rvf_pdu_set(pdu, AVTP_RVF_FIELD_RAW_LINE_NUMBER, 1);
+	res = avtp_rvf_raw_depacketizer_set_frame(&depkt, dst, LINE_LEN - 1,
+						  sizeof(dst));
+	assert_int_equal(res, 0);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+
+	/* Not a RVF PDU. */
+	pdu->subtype_data = htonl(AVTP_SUBTYPE_CVF << 24);
+	res = avtp_rvf_raw_depacketizer_push(&depkt, pdu, len, &frame);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_raw_depacketizer_progressive(void **state)
+{
+	struct avtp_rvf_raw_depacketizer depkt;
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_frame frame;
+	uint8_t src[FRAME_SIZE], dst[FRAME_SIZE];
+	int res, row;
+
+	init_packetizer(&pkt, 0, MAX_PDU_SIZE);
+	init_frame(src);
+
+	avtp_rvf_raw_depacketizer_init(&depkt);
+	memset(dst, 0, sizeof(dst));
+	res = avtp_rvf_raw_depacketizer_set_frame(&depkt, dst, STRIDE,
+						  sizeof(dst));
+	assert_int_equal(res, 0);
+
+	res = transfer_frame(&pkt, &depkt, src, -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.avtp_time, 0x11223344);
+	assert_int_equal(frame.i_seq_num, 0);
+	assert_int_equal(frame.lines, HEIGHT);
+	assert_int_equal(frame.lost_pdus, 0);
+	assert_int_equal(frame.dropped_frames, 0);
+
+	/* Lines are written at the stride offset, padding is not touched. */
+	for (row = 0; row < HEIGHT; row++) {
+		assert_memory_equal(dst + row * STRIDE, src + row * STRIDE,
+				    LINE_LEN);
+		assert_int_equal(dst[row * STRIDE + LINE_LEN], 0);
+	}
+}
+
+static void rvf_raw_depacketizer_interlaced(void **state)
+{
+	struct avtp_rvf_raw_depacketizer depkt;
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_frame frame;
+	uint8_t src[FRAME_SIZE], dst[FRAME_SIZE];
+	int res, row;
+
+	init_packetizer(&pkt, 1, MAX_PDU_SIZE);
+	init_frame(src);
+
+	avtp_rvf_raw_depacketizer_init(&depkt);
+	memset(dst, 0, sizeof(dst));
+	avtp_rvf_raw_depacketizer_set_frame(&depkt, dst, STRIDE, sizeof(dst));
+
+	res = transfer_frame(&pkt, &depkt, src, -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.lines, HEIGHT);
+
+	for (row = 0; row < HEIGHT; row++)
+		assert_memory_equal(dst + row * STRIDE, src + row * STRIDE,
+				    LINE_LEN);
+
+	/* Second frame goes to another buffer. */
+	memset(dst, 0, sizeof(dst));
+	res = transfer_frame(&pkt, &depkt, src, -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.i_seq_num, 1);
+	assert_memory_equal(dst + 5 * STRIDE, src + 5 * STRIDE, LINE_LEN);
+}
+
+static void rvf_raw_depacketizer_loss(void **state)
+{
+	struct avtp_rvf_raw_depacketizer depkt;
+	struct avtp_rvf_raw_packetizer pkt;
+	struct avtp_rvf_raw_frame frame;
+	uint8_t src[FRAME_SIZE], dst[FRAME_SIZE];
+	uint8_t zero[LINE_LEN] = { 0 };
+	int res;
+
+	init_packetizer(&pkt, 0, MAX_PDU_SIZE);
+	init_frame(src);
+
+	avtp_rvf_raw_depacketizer_init(&depkt);
+	memset(dst, 0, sizeof(dst));
+	avtp_rvf_raw_depacketizer_set_frame(&depkt, dst, STRIDE, sizeof(dst));
+
+	/* Lines 3 and 4 are lost. */
+	res = transfer_frame(&pkt, &depkt, src, 1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.lines, HEIGHT - 2);
+	assert_int_equal(frame.lost_pdus, 1);
+	assert_int_equal(frame.dropped_frames, 0);
+	assert_memory_equal(dst + 2 * STRIDE, zero, LINE_LEN);
+	assert_memory_equal(dst + 4 * STRIDE, src + 4 * STRIDE, LINE_LEN);
+
+	/* The end of the second frame is lost, so it is dropped once the
+	 * first PDU of the third frame arrives.
+	 */
+	res = transfer_frame(&pkt, &depkt, src, 5, &frame);
+	assert_int_equal(res, 0);
+
+	res = transfer_frame(&pkt, &depkt, src, -1, &frame);
+	assert_int_equal(res, 1);
+	assert_int_equal(frame.i_seq_num, 2);
+	assert_int_equal(frame.lines, HEIGHT);
+	assert_int_equal(frame.lost_pdus, 1);
+	assert_int_equal(frame.dropped_frames, 1);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(rvf_raw_packetizer_init_null),
+		cmocka_unit_test(rvf_raw_packetizer_init_invalid_tmpl),
+		cmocka_unit_test(rvf_raw_packetizer_init_small_pdu),
+		cmocka_unit_test(rvf_raw_packetizer_start_invalid),
+		cmocka_unit_test(rvf_raw_packetizer_next_null),
+		cmocka_unit_test(rvf_raw_packetizer_progressive),
+		cmocka_unit_test(rvf_raw_packetizer_contiguous),
+		cmocka_unit_test(rvf_raw_packetizer_max_lines),
+		cmocka_unit_test(rvf_raw_packetizer_interlaced),
+		cmocka_unit_test(rvf_raw_depacketizer_invalid),
+		cmocka_unit_test(rvf_raw_depacketizer_progressive),
+		cmocka_unit_test(rvf_raw_depacketizer_interlaced),
+		cmocka_unit_test(rvf_raw_depacketizer_loss),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -864,6 +864,135 @@ static void rvf_set_field_raw_line_number(void **state)
 	assert_true(be64toh(pay->raw_header) == 0x0000000000000123);
 }
 
+static void rvf_pdu_unpack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_rvf_hdr hdr;
+
+	res = avtp_rvf_pdu_unpack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_pdu_unpack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_rvf_pdu_unpack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_pdu_unpack(void **state)
+{
+	int res;
+	struct avtp_rvf_hdr hdr;
+	struct avtp_stream_pdu *pdu =
+		alloca(sizeof(struct avtp_stream_pdu) + sizeof(uint64_t));
+	struct avtp_rvf_payload *pay =
+		(struct avtp_rvf_payload *)pdu->avtp_payload;
+
+	pdu->subtype_data = htonl(0x07810701);
+	pdu->stream_id = htobe64(0xAABBCCDDEEFF0004);
+	pdu->avtp_time = htonl(0x80C0FFEE);
+	pdu->format_specific = htonl(0x07800438);
+	pdu->packet_info = htonl(0x16803AC0);
+	pay->raw_header = htobe64(0x0014182820ab0123);
+
+	res = avtp_rvf_pdu_unpack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(hdr.stream.sv == 1);
+	assert_true(hdr.stream.tv == 1);
+	assert_true(hdr.stream.seq_num == 0x07);
+	assert_true(hdr.stream.tu == 1);
+	assert_true(hdr.stream.stream_id == 0xAABBCCDDEEFF0004);
+	assert_true(hdr.stream.timestamp == 0x80C0FFEE);
+	assert_true(hdr.stream.stream_data_len == 0x1680);
+	assert_true(hdr.active_pixels == 1920);
+	assert_true(hdr.total_lines == 1080);
+	assert_true(hdr.ap == 0);
+	assert_true(hdr.f == 1);
+	assert_true(hdr.ef == 1);
+	assert_true(hdr.evt == 0xA);
+	assert_true(hdr.pd == 1);
+	assert_true(hdr.i == 1);
+	assert_true(hdr.raw_pixel_depth == AVTP_RVF_PIXEL_DEPTH_8);
+	assert_true(hdr.raw_pixel_format == AVTP_RVF_PIXEL_FORMAT_444);
+	assert_true(hdr.raw_frame_rate == AVTP_RVF_FRAME_RATE_60);
+	assert_true(hdr.raw_colorspace == AVTP_RVF_COLORSPACE_SRGB);
+	assert_true(hdr.raw_num_lines == 8);
+	assert_true(hdr.raw_i_seq_num == 0xab);
+	assert_true(hdr.raw_line_number == 0x123);
+}
+
+static void rvf_pdu_pack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_rvf_hdr hdr = { 0 };
+
+	res = avtp_rvf_pdu_pack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_pdu_pack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_rvf_pdu_pack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void rvf_pdu_pack(void **state)
+{
+	int res;
+	struct avtp_rvf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.seq_num = 0x07,
+			.tu = 1,
+			.stream_id = 0xAABBCCDDEEFF0004,
+			.timestamp = 0x80C0FFEE,
+			.stream_data_len = 0x1680,
+		},
+		.active_pixels = 1920,
+		.total_lines = 1080,
+		.f = 1,
+		.ef = 1,
+		.evt = 0xA,
+		.pd = 1,
+		.i = 1,
+		.raw_pixel_depth = AVTP_RVF_PIXEL_DEPTH_8,
+		.raw_pixel_format = AVTP_RVF_PIXEL_FORMAT_444,
+		.raw_frame_rate = AVTP_RVF_FRAME_RATE_60,
+		.raw_colorspace = AVTP_RVF_COLORSPACE_SRGB,
+		.raw_num_lines = 8,
+		.raw_i_seq_num = 0xab,
+		.raw_line_number = 0x123,
+	};
+	struct avtp_stream_pdu *pdu =
+		alloca(sizeof(struct avtp_stream_pdu) + sizeof(uint64_t));
+	struct avtp_rvf_payload *pay =
+		(struct avtp_rvf_payload *)pdu->avtp_payload;
+
+	memset(pdu, 0xFF, sizeof(struct avtp_stream_pdu) + sizeof(uint64_t));
+
+	res = avtp_rvf_pdu_pack(pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu->subtype_data) == 0x07810701);
+	assert_true(be64toh(pdu->stream_id) == 0xAABBCCDDEEFF0004);
+	assert_true(ntohl(pdu->avtp_time) == 0x80C0FFEE);
+	assert_true(ntohl(pdu->format_specific) == 0x07800438);
+	assert_true(ntohl(pdu->packet_info) == 0x16803AC0);
+	assert_true(be64toh(pay->raw_header) == 0x0014182800ab0123);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -920,6 +1049,12 @@ int main(void)
 		cmocka_unit_test(rvf_set_field_raw_line_number),
 		cmocka_unit_test(rvf_pdu_init_null_pdu),
 		cmocka_unit_test(rvf_pdu_init),
+		cmocka_unit_test(rvf_pdu_unpack_null_pdu),
+		cmocka_unit_test(rvf_pdu_unpack_null_hdr),
+		cmocka_unit_test(rvf_pdu_unpack),
+		cmocka_unit_test(rvf_pdu_pack_null_pdu),
+		cmocka_unit_test(rvf_pdu_pack_null_hdr),
+		cmocka_unit_test(rvf_pdu_pack),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
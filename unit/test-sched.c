@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "avtp_sched.h"
+
+#define CAPACITY		1024
+
+/* Payloads and times seen by the dispatch callback. */
+struct record {
+	uintptr_t payloads[CAPACITY];
+	uint64_t times[CAPACITY];
+	unsigned int count;
+	unsigned int batches;
+	/* If set, the callback adds a payload due at 'readd_time' once. */
+	struct avtp_sched *sched;
+	uint64_t readd_time;
+};
+
+static void record_fn(void *const payloads[], const uint64_t times[],
+					unsigned int count, void *arg)
+{
+	struct record *rec = arg;
+	unsigned int i;
+
+	assert_true(count >= 1 && count <= AVTP_SCHED_BATCH);
+
+	for (i = 0; i < count; i++) {
+		rec->payloads[rec->count] = (uintptr_t) payloads[i];
+		rec->times[rec->count] = times[i];
+		rec->count++;
+	}
+	rec->batches++;
+
+	if (rec->sched) {
+		struct avtp_sched *sched = rec->sched;
+
+		rec->sched = NULL;
+		assert_true(avtp_sched_add(sched, rec->readd_time,
+						(void *) 0xbeef) >= 0);
+	}
+}
+
+static void sched_create_invalid(void **state)
+{
+	struct avtp_sched *sched;
+	int res;
+
+	res = avtp_sched_create(NULL, CAPACITY, record_fn, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_sched_create(&sched, 0, record_fn, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_sched_create(&sched, CAPACITY, NULL, NULL);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void sched_null_args(void **state)
+{
+	uint64_t time;
+	int res;
+
+	res = avtp_sched_add(NULL, 0, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_sched_next(NULL, &time);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_sched_dispatch(NULL, 0, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_sched_get_count(NULL);
+	assert_int_equal(res, -EINVAL);
+}
+
+static void sched_add_earliest(void **state)
+{
+	struct record rec = { 0 };
+	struct avtp_sched *sched;
+	uint64_t time;
+	int res;
+
+	res = avtp_sched_create(&sched, CAPACITY, record_fn, &rec);
+	assert_int_equal(res, 0);
+
+	res = avtp_sched_next(sched, &time);
+	assert_int_equal(res, -ENOENT);
+
+	/* Only deadlines earlier than all others need re-arming. */
+	assert_int_equal(avtp_sched_add(sched, 1000, NULL), 1);
+	assert_int_equal(avtp_sched_add(sched, 2000, NULL), 0);
+	assert_int_equal(avtp_sched_add(sched, 1000, NULL), 0);
+	assert_int_equal(avtp_sched_add(sched, 500, NULL), 1);
+	assert_int_equal(avtp_sched_get_count(sched), 4);
+
+	res = avtp_sched_next(sched, &time);
+	assert_int_equal(res, 0);
+	assert_true(time == 500);
+
+	avtp_sched_destroy(sched);
+}
+
+static void sched_full(void **state)
+{
+	struct record rec = { 0 };
+	struct avtp_sched *sched;
+	int res;
+
+	res = avtp_sched_create(&sched, 2, record_fn, &rec);
+	assert_int_equal(res, 0);
+
+	assert_true(avtp_sched_add(sched, 1, NULL) >= 0);
+	assert_true(avtp_sched_add(sched, 2, NULL) >= 0);
+	assert_int_equal(avtp_sched_add(sched, 3, NULL), -ENOSPC);
+
+	avtp_sched_destroy(sched);
+}
+
+static void sched_dispatch_due(void **state)
+{
+	struct record rec = { 0 };
+	struct avtp_sched *sched;
+	uint64_t next;
+	int res;
+
+	res = avtp_sched_create(&sched, CAPACITY, record_fn, &rec);
+	assert_int_equal(res, 0);
+
+	avtp_sched_add(sched, 300, (void *) 3);
+	avtp_sched_add(sched, 100, (void *) 1);
+	avtp_sched_add(sched, 400, (void *) 4);
+	avtp_sched_add(sched, 200, (void *) 2);
+
+	res = avtp_sched_dispatch(sched, 50, &next);
+	assert_int_equal(res, 0);
+	assert_int_equal(rec.count, 0);
+	assert_true(next == 100);
+
+	res = avtp_sched_dispatch(sched, 300, &next);
+	assert_int_equal(res, 3);
+	assert_int_equal(rec.batches, 1);
+	assert_int_equal(rec.payloads[0], 1);
+	assert_int_equal(rec.payloads[1], 2);
+	assert_int_equal(rec.payloads[2], 3);
+	assert_true(rec.times[2] == 300);
+	assert_true(next == 400);
+
+	res = avtp_sched_dispatch(sched, UINT64_MAX, &next);
+	assert_int_equal(res, 1);
+	assert_int_equal(rec.payloads[3], 4);
+	assert_true(next == UINT64_MAX);
+	assert_int_equal(avtp_sched_get_count(sched), 0);
+
+	avtp_sched_destroy(sched);
+}
+
+/* Payloads with equal times keep their insertion order. */
+static void sched_dispatch_fifo(void **state)
+{
+	struct record rec = { 0 };
+	struct avtp_sched *sched;
+	uintptr_t i;
+	int res;
+
+	res = avtp_sched_create(&sched, CAPACITY, record_fn, &rec);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < 100; i++)
+		avtp_sched_add(sched, 1000 + i % 2, (void *) i);
+
+	res = avtp_sched_dispatch(sched, 1001, NULL);
+	assert_int_equal(res, 100);
+
+	for (i = 0; i < 50; i++) {
+		assert_int_equal(rec.payloads[i], 2 * i);
+		assert_int_equal(rec.payloads[50 + i], 2 * i + 1);
+	}
+
+	avtp_sched_destroy(sched);
+}
+
+/* Random times, many streams worth of payloads, dispatched in batches. */
+static void sched_dispatch_ordered(void **state)
+{
+	struct record rec = { 0 };
+	struct avtp_sched *sched;
+	unsigned int i;
+	int res;
+
+	res = avtp_sched_create(&sched, CAPACITY, record_fn, &rec);
+	assert_int_equal(res, 0);
+
+	srand(1);
+	for (i = 0; i < CAPACITY; i++)
+		assert_true(avtp_sched_add(sched, rand() % 100000,
+						(void *) (uintptr_t) i) >= 0);
+
+	res = avtp_sched_dispatch(sched, 50000, NULL);
+	assert_true(res > 0);
+	res += avtp_sched_dispatch(sched, UINT64_MAX, NULL);
+	assert_int_equal(res, CAPACITY);
+	assert_true(rec.batches >= CAPACITY / AVTP_SCHED_BATCH);
+
+	for (i = 1; i < CAPACITY; i++)
+		assert_true(rec.times[i - 1] <= rec.times[i]);
+
+	avtp_sched_destroy(sched);
+}
+
+/* Payloads added by the callback which are already due are dispatched by
+ * the same call.
+ */
+static void sched_dispatch_reentrant(void **state)
+{
+	struct record rec = { 0 };
+	struct avtp_sched *sched;
+	int res;
+
+	res = avtp_sched_create(&sched, CAPACITY, record_fn, &rec);
+	assert_int_equal(res, 0);
+
+	rec.sched = sched;
+	rec.readd_time = 150;
+
+	avtp_sched_add(sched, 100, (void *) 1);
+
+	res = avtp_sched_dispatch(sched, 200, NULL);
+	assert_int_equal(res, 2);
+	assert_int_equal(rec.payloads[1], 0xbeef);
+	assert_int_equal(avtp_sched_get_count(sched), 0);
+
+	avtp_sched_destroy(sched);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(sched_create_invalid),
+		cmocka_unit_test(sched_null_args),
+		cmocka_unit_test(sched_add_earliest),
+		cmocka_unit_test(sched_full),
+		cmocka_unit_test(sched_dispatch_due),
+		cmocka_unit_test(sched_dispatch_fifo),
+		cmocka_unit_test(sched_dispatch_ordered),
+		cmocka_unit_test(sched_dispatch_reentrant),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "avtp.h"
+#include "avtp_inline.h"
+#include "avtp_stats.h"
+
+#define MTT			2000000
+/* Number of PDUs accounted in the concurrency test. */
+#define NUM_UPDATES		200000
+
+static struct avtp_stats *create_stats(void)
+{
+	struct avtp_stats *stats;
+	int res;
+
+	res = avtp_stats_create(&stats, MTT);
+	assert_int_equal(res, 0);
+
+	return stats;
+}
+
+static void read_stats(struct avtp_stats *stats,
+					struct avtp_stats_snapshot *snap)
+{
+	int res;
+
+	res = avtp_stats_read(stats, snap);
+	assert_int_equal(res, 0);
+}
+
+static void stats_null(void **state)
+{
+	struct avtp_stats_snapshot snap;
+	struct avtp_stream_pdu pdu = { 0 };
+	struct avtp_stats *stats = create_stats();
+	int res;
+
+	res = avtp_stats_create(NULL, MTT);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stats_track_seq(NULL, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stats_track_time(NULL, 0, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stats_update(NULL, &pdu, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stats_update(stats, NULL, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stats_read(NULL, &snap);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stats_read(stats, NULL);
+	assert_int_equal(res, -EINVAL);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stats_seq_in_order(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	int i, res;
+
+	/* Start close to the wraparound. */
+	for (i = 0; i < 600; i++) {
+		res = avtp_stats_track_seq(stats, (uint8_t) (i + 250));
+		assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+	}
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.received, 600);
+	assert_int_equal(snap.lost, 0);
+	assert_int_equal(snap.duplicated, 0);
+	assert_int_equal(snap.reordered, 0);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stats_seq_gap(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	int res;
+
+	avtp_stats_track_seq(stats, 253);
+	avtp_stats_track_seq(stats, 254);
+
+	/* 255, 0 and 1 are lost across the wraparound. */
+	res = avtp_stats_track_seq(stats, 2);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+
+	res = avtp_stats_track_seq(stats, 3);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+
+	/* Largest gap told apart from a late PDU. */
+	res = avtp_stats_track_seq(stats, 4 + 127);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.received, 5);
+	assert_int_equal(snap.lost, 3 + 127);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stats_seq_reordered(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	int res;
+
+	avtp_stats_track_seq(stats, 254);
+	avtp_stats_track_seq(stats, 255);
+	res = avtp_stats_track_seq(stats, 1);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.lost, 1);
+
+	/* 0 was only late. */
+	res = avtp_stats_track_seq(stats, 0);
+	assert_int_equal(res, AVTP_STATS_SEQ_REORDERED);
+
+	res = avtp_stats_track_seq(stats, 2);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.received, 5);
+	assert_int_equal(snap.lost, 0);
+	assert_int_equal(snap.reordered, 1);
+	assert_int_equal(snap.duplicated, 0);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stats_seq_duplicated(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	int res, i;
+
+	/* PDUs from before the first one received are not accounted as
+	 * reordered, since they were never accounted as lost.
+	 */
+	avtp_stats_track_seq(stats, 10);
+	res = avtp_stats_track_seq(stats, 9);
+	assert_int_equal(res, AVTP_STATS_SEQ_DUPLICATE);
+
+	res = avtp_stats_track_seq(stats, 10);
+	assert_int_equal(res, AVTP_STATS_SEQ_DUPLICATE);
+
+	res = avtp_stats_track_seq(stats, 12);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+	res = avtp_stats_track_seq(stats, 11);
+	assert_int_equal(res, AVTP_STATS_SEQ_REORDERED);
+	res = avtp_stats_track_seq(stats, 11);
+	assert_int_equal(res, AVTP_STATS_SEQ_DUPLICATE);
+
+	/* A whole wraparound later, 11 is in order again. */
+	for (i = 13; i < 256 + 11; i++)
+		avtp_stats_track_seq(stats, (uint8_t) i);
+	res = avtp_stats_track_seq(stats, 11);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.duplicated, 3);
+	assert_int_equal(snap.reordered, 1);
+	assert_int_equal(snap.lost, 0);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stats_time(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	uint64_t arrival = 0x100000000ULL - 1000;
+	int res;
+
+	/* Presentation time wraps around before the arrival time does. */
+	res = avtp_stats_track_time(stats, 0, arrival);
+	assert_int_equal(res, 0);
+
+	/* On time, 0 ns left. */
+	avtp_stats_track_time(stats, (uint32_t) arrival, arrival);
+
+	/* Late. */
+	avtp_stats_track_time(stats, (uint32_t) arrival - 1, arrival);
+	avtp_stats_track_time(stats, (uint32_t) arrival - 1000000, arrival);
+
+	/* Right at the maximum transit time and past it. */
+	avtp_stats_track_time(stats, (uint32_t) (arrival + MTT), arrival);
+	avtp_stats_track_time(stats, (uint32_t) (arrival + MTT + 1), arrival);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.late, 2);
+	assert_int_equal(snap.early, 1);
+	assert_int_equal(snap.latency[0], 1);
+	/* 1000 ns is in [512, 1024). */
+	assert_int_equal(snap.latency[10], 1);
+	/* 2 ms is in [2^20, 2^21). */
+	assert_int_equal(snap.latency[21], 2);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stats_update(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	struct avtp_stream_pdu pdu = { 0 };
+	int res;
+
+	avtp_stream_set_seq_num(&pdu, 7);
+	avtp_stream_set_tv(&pdu, 1);
+	avtp_stream_set_timestamp(&pdu, 5000);
+
+	res = avtp_stats_update(stats, &pdu, 6000);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+
+	/* Timestamp is ignored if not valid. */
+	avtp_stream_set_seq_num(&pdu, 9);
+	avtp_stream_set_tv(&pdu, 0);
+	res = avtp_stats_update(stats, &pdu, 6000);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.received, 2);
+	assert_int_equal(snap.lost, 1);
+	assert_int_equal(snap.late, 1);
+
+	avtp_stats_destroy(stats);
+}
+
+static atomic_bool done;
+
+static void *updater(void *arg)
+{
+	struct avtp_stats *stats = arg;
+	int i;
+
+	for (i = 0; i < NUM_UPDATES; i++)
+		avtp_stats_track_seq(stats, (uint8_t) (i * 2));
+
+	atomic_store(&done, true);
+	return NULL;
+}
+
+static void stats_concurrent_read(void **state)
+{
+	struct avtp_stats *stats = create_stats();
+	struct avtp_stats_snapshot snap;
+	uint64_t prev_received = 0, prev_lost = 0;
+	pthread_t thread;
+
+	atomic_store(&done, false);
+	assert_int_equal(pthread_create(&thread, NULL, updater, stats), 0);
+
+	/* Counters never go back while being updated. */
+	while (!atomic_load(&done)) {
+		read_stats(stats, &snap);
+		assert_true(snap.received >= prev_received);
+		assert_true(snap.lost >= prev_lost);
+		prev_received = snap.received;
+		prev_lost = snap.lost;
+		sched_yield();
+	}
+
+	pthread_join(thread, NULL);
+
+	read_stats(stats, &snap);
+	assert_int_equal(snap.received, NUM_UPDATES);
+	assert_int_equal(snap.lost, NUM_UPDATES - 1);
+
+	avtp_stats_destroy(stats);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(stats_null),
+		cmocka_unit_test(stats_seq_in_order),
+		cmocka_unit_test(stats_seq_gap),
+		cmocka_unit_test(stats_seq_reordered),
+		cmocka_unit_test(stats_seq_duplicated),
+		cmocka_unit_test(stats_time),
+		cmocka_unit_test(stats_update),
+		cmocka_unit_test(stats_concurrent_read),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
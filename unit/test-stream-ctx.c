@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+#include <endian.h>
+
+#include "avtp.h"
+#include "avtp_aaf.h"
+#include "avtp_clock.h"
+#include "avtp_inline.h"
+#include "avtp_stats.h"
+#include "avtp_stream_ctx.h"
+
+#define STREAM_ID		0xAABBCCDDEEFF0001
+#define SAMPLE_RATE		48000
+#define NUM_CTXS		256
+
+static void init_tmpl_sp(struct avtp_stream_pdu *tmpl, uint8_t seq_num,
+					uint32_t timestamp, uint8_t sp)
+{
+	struct avtp_aaf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.tv = 1,
+			.seq_num = seq_num,
+			.stream_id = STREAM_ID,
+			.timestamp = timestamp,
+			.stream_data_len = 24,
+		},
+		.format = AVTP_AAF_FORMAT_INT_16BIT,
+		.nsr = AVTP_AAF_PCM_NSR_48KHZ,
+		.chan_per_frame = 2,
+		.bit_depth = 16,
+		.sp = sp,
+	};
+
+	assert_int_equal(avtp_aaf_pdu_pack(tmpl, &hdr), 0);
+}
+
+static void init_tmpl(struct avtp_stream_pdu *tmpl, uint8_t seq_num,
+							uint32_t timestamp)
+{
+	init_tmpl_sp(tmpl, seq_num, timestamp, AVTP_AAF_PCM_SP_NORMAL);
+}
+
+static void stream_ctx_init_null_ctx(void **state)
+{
+	int res;
+	struct avtp_stream_pdu tmpl;
+
+	init_tmpl(&tmpl, 0, 0);
+
+	res = avtp_stream_ctx_init(NULL, &tmpl, SAMPLE_RATE);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_ctx_init_null_tmpl(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+
+	res = avtp_stream_ctx_init(&ctx, NULL, SAMPLE_RATE);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_ctx_init_zero_rate(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl;
+
+	init_tmpl(&tmpl, 0, 0);
+
+	res = avtp_stream_ctx_init(&ctx, &tmpl, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_ctx_emit_null_pdu(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	res = avtp_stream_ctx_emit(&ctx, NULL, 6);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_ctx_emit(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+	struct avtp_aaf_hdr hdr;
+
+	init_tmpl(&tmpl, 0x10, 1000);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	memset(&pdu, 0xFF, sizeof(pdu));
+
+	res = avtp_stream_ctx_emit(&ctx, &pdu, 6);
+	assert_int_equal(res, 0);
+	assert_memory_equal(&pdu, &tmpl, sizeof(pdu));
+
+	res = avtp_stream_ctx_emit(&ctx, &pdu, 6);
+	assert_int_equal(res, 0);
+
+	/* 6 samples at 48 kHz are 125 us. */
+	res = avtp_aaf_pdu_unpack(&pdu, &hdr);
+	assert_int_equal(res, 0);
+	assert_int_equal(hdr.stream.seq_num, 0x11);
+	assert_true(hdr.stream.timestamp == 1000 + 125000);
+	assert_true(hdr.stream.stream_id == STREAM_ID);
+	assert_int_equal(hdr.stream.stream_data_len, 24);
+	assert_int_equal(hdr.stream.tv, 1);
+	assert_int_equal(hdr.nsr, AVTP_AAF_PCM_NSR_48KHZ);
+}
+
+static void stream_ctx_advance_wrap(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+
+	init_tmpl(&tmpl, 0xFF, 0xFFFFFFFF);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	pdu = tmpl;
+
+	res = avtp_stream_ctx_advance(&ctx, &pdu, 1);
+	assert_int_equal(res, 0);
+	assert_memory_equal(&pdu, &tmpl, sizeof(pdu));
+
+	/* Both 'sequence_num' and 'avtp_timestamp' wrap. One sample at
+	 * 48 kHz is 20833.33 ns, so 2^32 - 1 is followed by 20832.
+	 */
+	res = avtp_stream_ctx_advance(&ctx, &pdu, 1);
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) ==
+			(ntohl(tmpl.subtype_data) & 0xFFFF00FF));
+	assert_true(ntohl(pdu.avtp_time) == 20832);
+	assert_true(pdu.stream_id == tmpl.stream_id);
+	assert_true(pdu.packet_info == tmpl.packet_info);
+}
+
+static void stream_ctx_advance_no_drift(void **state)
+{
+	int res, i;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	/* One second worth of 1-sample PDUs. */
+	for (i = 0; i < SAMPLE_RATE; i++) {
+		res = avtp_stream_ctx_advance(&ctx, &pdu, 1);
+		assert_int_equal(res, 0);
+	}
+
+	res = avtp_stream_ctx_advance(&ctx, &pdu, 1);
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.avtp_time) == 1000000000);
+	assert_int_equal((ntohl(pdu.subtype_data) >> 8) & 0xFF,
+						SAMPLE_RATE % 256);
+}
+
+static void stream_ctx_set_time(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	res = avtp_stream_ctx_set_time(NULL, 0);
+	assert_int_equal(res, -EINVAL);
+
+	res = avtp_stream_ctx_set_time(&ctx, 0x1234567890ULL);
+	assert_int_equal(res, 0);
+
+	res = avtp_stream_ctx_emit(&ctx, &pdu, 6);
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.avtp_time) == 0x34567890);
+}
+
+static void stream_ctx_emit_burst_null_pdu(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+	void *pdus[] = { &pdu, NULL };
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	res = avtp_stream_ctx_emit_burst(&ctx, pdus, 2, 6);
+	assert_int_equal(res, -EINVAL);
+
+	/* Nothing is emitted, so next PDU still gets the template values. */
+	res = avtp_stream_ctx_emit(&ctx, &pdu, 6);
+	assert_int_equal(res, 0);
+	assert_memory_equal(&pdu, &tmpl, sizeof(pdu));
+}
+
+static void stream_ctx_emit_burst(void **state)
+{
+	int res, i;
+	struct avtp_stream_ctx ctx, ref;
+	struct avtp_stream_pdu tmpl, ring[4], expected;
+	void *pdus[4];
+
+	init_tmpl(&tmpl, 0xFE, 5000);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+	ref = ctx;
+
+	for (i = 0; i < 4; i++)
+		pdus[i] = &ring[i];
+
+	res = avtp_stream_ctx_emit_burst(&ctx, pdus, 4, 6);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < 4; i++) {
+		assert_int_equal(avtp_stream_ctx_emit(&ref, &expected, 6), 0);
+		assert_memory_equal(&ring[i], &expected, sizeof(expected));
+	}
+
+	/* Reusing the ring only patches the per-PDU words. */
+	res = avtp_stream_ctx_advance_burst(&ctx, pdus, 4, 6);
+	assert_int_equal(res, 0);
+
+	for (i = 0; i < 4; i++) {
+		assert_int_equal(avtp_stream_ctx_emit(&ref, &expected, 6), 0);
+		assert_memory_equal(&ring[i], &expected, sizeof(expected));
+	}
+}
+
+static void stream_ctx_layout(void **state)
+{
+	struct avtp_stream_ctx ctxs[2];
+
+	assert_int_equal(sizeof(struct avtp_stream_ctx),
+					AVTP_STREAM_CTX_CACHE_LINE);
+	assert_int_equal((uintptr_t) &ctxs[1] % AVTP_STREAM_CTX_CACHE_LINE,
+									0);
+	assert_true(offsetof(struct avtp_stream_ctx, clk) +
+			sizeof(ctxs[0].clk) <= AVTP_STREAM_CTX_CACHE_LINE);
+}
+
+static void stream_ctx_sync_no_clock(void **state)
+{
+	int res;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	assert_int_equal(avtp_stream_ctx_sync(NULL, 0), -EINVAL);
+
+	res = avtp_stream_ctx_sync(&ctx, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_ctx_sync(void **state)
+{
+	int res;
+	uint32_t timestamp;
+	uint64_t before, after;
+	const uint64_t offset = 2000000;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+	struct avtp_clock *clk;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_clock_create(&clk, CLOCK_MONOTONIC, 0), 0);
+	ctx.clk = clk;
+
+	assert_int_equal(avtp_clock_now(clk, &before), 0);
+	res = avtp_stream_ctx_sync(&ctx, offset);
+	assert_int_equal(res, 0);
+	assert_int_equal(avtp_clock_now(clk, &after), 0);
+
+	assert_int_equal(avtp_stream_ctx_emit(&ctx, &pdu, 6), 0);
+
+	/* Compared modulo 2^32, as carried by 'avtp_timestamp'. */
+	timestamp = ntohl(pdu.avtp_time);
+	assert_true((uint32_t) (timestamp - (uint32_t) (before + offset)) <=
+							after - before);
+
+	avtp_clock_destroy(clk);
+}
+
+static void stream_ctx_receive_null(void **state)
+{
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl;
+	uint64_t time;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	assert_int_equal(avtp_stream_ctx_receive(NULL, &tmpl, 1, &time),
+								-EINVAL);
+	assert_int_equal(avtp_stream_ctx_receive(&ctx, NULL, 1, &time),
+								-EINVAL);
+}
+
+static void stream_ctx_receive_seq(void **state)
+{
+	int i, res;
+	struct avtp_stream_ctx tx, rx;
+	struct avtp_stream_pdu tmpl, pdus[6];
+
+	init_tmpl(&tmpl, 0xFE, 0);
+	assert_int_equal(avtp_stream_ctx_init(&tx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_stream_ctx_init(&rx, &tmpl, SAMPLE_RATE), 0);
+
+	for (i = 0; i < 6; i++)
+		assert_int_equal(avtp_stream_ctx_emit(&tx, &pdus[i], 6), 0);
+
+	/* Sequence numbers wrap from 0xFF to 0x00. */
+	for (i = 0; i < 3; i++) {
+		res = avtp_stream_ctx_receive(&rx, &pdus[i], 1, NULL);
+		assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+	}
+
+	res = avtp_stream_ctx_receive(&rx, &pdus[4], 1, NULL);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+	assert_int_equal(rx.rx_seq, 0x03);
+
+	res = avtp_stream_ctx_receive(&rx, &pdus[5], 1, NULL);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+}
+
+static void stream_ctx_receive_time(void **state)
+{
+	int res;
+	uint64_t time;
+	const uint64_t arrival = (5ULL << 32) + 0xFFFFF000;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	/* Presentation time is 0x2000 ns after arrival time, past the 32-bit
+	 * wraparound.
+	 */
+	assert_int_equal(avtp_stream_ctx_set_time(&ctx, arrival + 0x2000), 0);
+	assert_int_equal(avtp_stream_ctx_emit(&ctx, &pdu, 6), 0);
+
+	res = avtp_stream_ctx_receive(&ctx, &pdu, arrival, &time);
+
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+	assert_true(time == arrival + 0x2000);
+}
+
+static void stream_ctx_receive_no_arrival(void **state)
+{
+	int res;
+	uint64_t time;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+	struct avtp_clock *clk;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_stream_ctx_emit(&ctx, &pdu, 6), 0);
+
+	/* Without a reference clock, arrival time must be given... */
+	res = avtp_stream_ctx_receive(&ctx, &pdu, 0, &time);
+	assert_int_equal(res, -EINVAL);
+
+	/* ...unless it isn't needed, i.e. PDU has no presentation time. */
+	pdu.subtype_data &= ~htonl(AVTP_STREAM_MASK_TV);
+	time = 1;
+	res = avtp_stream_ctx_receive(&ctx, &pdu, 0, &time);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+	assert_true(time == 0);
+
+	/* Otherwise it is the current time from the reference clock. */
+	assert_int_equal(avtp_clock_create(&clk, CLOCK_MONOTONIC, 0), 0);
+	ctx.clk = clk;
+	assert_int_equal(avtp_stream_ctx_sync(&ctx, 1000), 0);
+	assert_int_equal(avtp_stream_ctx_emit(&ctx, &pdu, 6), 0);
+
+	res = avtp_stream_ctx_receive(&ctx, &pdu, 0, &time);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+	assert_true(time != 0);
+
+	avtp_clock_destroy(clk);
+}
+
+static void stream_ctx_receive_stats(void **state)
+{
+	int res;
+	struct avtp_stream_ctx tx, rx;
+	struct avtp_stream_pdu tmpl, pdus[3];
+	struct avtp_stats_snapshot snap;
+	struct avtp_stats *stats;
+
+	init_tmpl(&tmpl, 0, 0);
+	assert_int_equal(avtp_stream_ctx_init(&tx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_stream_ctx_init(&rx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_stats_create(&stats, 2000000), 0);
+	rx.stats = stats;
+
+	assert_int_equal(avtp_stream_ctx_set_time(&tx, 10000), 0);
+	assert_int_equal(avtp_stream_ctx_emit(&tx, &pdus[0], 6), 0);
+	assert_int_equal(avtp_stream_ctx_emit(&tx, &pdus[1], 6), 0);
+	assert_int_equal(avtp_stream_ctx_emit(&tx, &pdus[2], 6), 0);
+
+	/* Stats tell duplicated and reordered PDUs apart. */
+	res = avtp_stream_ctx_receive(&rx, &pdus[0], 5000, NULL);
+	assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+	res = avtp_stream_ctx_receive(&rx, &pdus[2], 5000, NULL);
+	assert_int_equal(res, AVTP_STATS_SEQ_GAP);
+	res = avtp_stream_ctx_receive(&rx, &pdus[1], 5000, NULL);
+	assert_int_equal(res, AVTP_STATS_SEQ_REORDERED);
+	res = avtp_stream_ctx_receive(&rx, &pdus[1], 5000, NULL);
+	assert_int_equal(res, AVTP_STATS_SEQ_DUPLICATE);
+
+	assert_int_equal(avtp_stats_read(stats, &snap), 0);
+	assert_int_equal(snap.received, 4);
+	assert_int_equal(snap.reordered, 1);
+	assert_int_equal(snap.duplicated, 1);
+	assert_int_equal(snap.late, 0);
+
+	avtp_stats_destroy(stats);
+}
+
+static void stream_ctx_array_create_invalid(void **state)
+{
+	struct avtp_stream_ctx *ctxs;
+
+	assert_int_equal(avtp_stream_ctx_array_create(NULL, 1), -EINVAL);
+	assert_int_equal(avtp_stream_ctx_array_create(&ctxs, 0), -EINVAL);
+}
+
+static void stream_ctx_array_create(void **state)
+{
+	int i, res;
+	struct avtp_stream_ctx *ctxs;
+	struct avtp_stream_pdu tmpl, pdu;
+
+	res = avtp_stream_ctx_array_create(&ctxs, NUM_CTXS);
+	assert_int_equal(res, 0);
+	assert_int_equal((uintptr_t) ctxs % AVTP_STREAM_CTX_CACHE_LINE, 0);
+	assert_null(ctxs[NUM_CTXS - 1].stats);
+
+	/* Contexts are independent from each other. */
+	for (i = 0; i < NUM_CTXS; i++) {
+		init_tmpl(&tmpl, i, i * 1000);
+		assert_int_equal(avtp_stream_ctx_init(&ctxs[i], &tmpl,
+							SAMPLE_RATE), 0);
+	}
+
+	for (i = 0; i < NUM_CTXS; i++) {
+		assert_int_equal(avtp_stream_ctx_emit(&ctxs[i], &pdu, 6), 0);
+		assert_int_equal(ntohl(pdu.subtype_data) >> 8 & 0xFF, i);
+		assert_int_equal(ntohl(pdu.avtp_time), i * 1000);
+	}
+
+	avtp_stream_ctx_array_destroy(ctxs);
+}
+
+static void stream_ctx_emit_sparse(void **state)
+{
+	int i;
+	struct avtp_stream_ctx ctx;
+	struct avtp_stream_pdu tmpl, pdu;
+
+	init_tmpl_sp(&tmpl, 0, 1000, AVTP_AAF_PCM_SP_SPARSE);
+	assert_int_equal(avtp_stream_ctx_init(&ctx, &tmpl, SAMPLE_RATE), 0);
+
+	for (i = 0; i < 2 * AVTP_AAF_PCM_SPARSE_INTERVAL; i++) {
+		assert_int_equal(avtp_stream_ctx_emit(&ctx, &pdu, 6), 0);
+
+		if (i % AVTP_AAF_PCM_SPARSE_INTERVAL) {
+			assert_int_equal(avtp_stream_get_tv(&pdu), 0);
+			assert_int_equal(avtp_stream_get_timestamp(&pdu), 0);
+		} else {
+			assert_int_equal(avtp_stream_get_tv(&pdu), 1);
+			assert_int_equal(avtp_stream_get_timestamp(&pdu),
+							1000 + i * 125000);
+		}
+	}
+}
+
+static void stream_ctx_receive_sparse(void **state)
+{
+	int i, res;
+	uint64_t time;
+	const uint64_t arrival = 3ULL << 32;
+	struct avtp_stream_ctx tx, rx;
+	struct avtp_stream_pdu tmpl, pdus[3 * AVTP_AAF_PCM_SPARSE_INTERVAL];
+
+	init_tmpl_sp(&tmpl, 0, 0, AVTP_AAF_PCM_SP_SPARSE);
+	assert_int_equal(avtp_stream_ctx_init(&tx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_stream_ctx_init(&rx, &tmpl, SAMPLE_RATE), 0);
+	assert_int_equal(avtp_stream_ctx_set_time(&tx, arrival + 1000), 0);
+
+	for (i = 0; i < 3 * AVTP_AAF_PCM_SPARSE_INTERVAL; i++)
+		assert_int_equal(avtp_stream_ctx_emit(&tx, &pdus[i], 6), 0);
+
+	/* PDUs without timestamp are presented 125 us after the previous
+	 * one.
+	 */
+	for (i = 0; i < AVTP_AAF_PCM_SPARSE_INTERVAL; i++) {
+		res = avtp_stream_ctx_receive(&rx, &pdus[i], arrival, &time);
+		assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+		assert_true(time == arrival + 1000 + i * 125000);
+	}
+
+	/* Once a PDU is lost, times can't be interpolated until the next PDU
+	 * with a timestamp.
+	 */
+	for (i++; i < 2 * AVTP_AAF_PCM_SPARSE_INTERVAL; i++) {
+		avtp_stream_ctx_receive(&rx, &pdus[i], arrival, &time);
+		assert_true(time == 0);
+	}
+
+	for (; i < 3 * AVTP_AAF_PCM_SPARSE_INTERVAL; i++) {
+		res = avtp_stream_ctx_receive(&rx, &pdus[i], arrival, &time);
+		assert_int_equal(res, AVTP_STATS_SEQ_IN_ORDER);
+		assert_true(time == arrival + 1000 + i * 125000);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(stream_ctx_init_null_ctx),
+		cmocka_unit_test(stream_ctx_init_null_tmpl),
+		cmocka_unit_test(stream_ctx_init_zero_rate),
+		cmocka_unit_test(stream_ctx_emit_null_pdu),
+		cmocka_unit_test(stream_ctx_emit),
+		cmocka_unit_test(stream_ctx_advance_wrap),
+		cmocka_unit_test(stream_ctx_advance_no_drift),
+		cmocka_unit_test(stream_ctx_set_time),
+		cmocka_unit_test(stream_ctx_emit_burst_null_pdu),
+		cmocka_unit_test(stream_ctx_emit_burst),
+		cmocka_unit_test(stream_ctx_layout),
+		cmocka_unit_test(stream_ctx_sync_no_clock),
+		cmocka_unit_test(stream_ctx_sync),
+		cmocka_unit_test(stream_ctx_receive_null),
+		cmocka_unit_test(stream_ctx_receive_seq),
+		cmocka_unit_test(stream_ctx_receive_time),
+		cmocka_unit_test(stream_ctx_receive_no_arrival),
+		cmocka_unit_test(stream_ctx_receive_stats),
+		cmocka_unit_test(stream_ctx_array_create_invalid),
+		cmocka_unit_test(stream_ctx_array_create),
+		cmocka_unit_test(stream_ctx_emit_sparse),
+		cmocka_unit_test(stream_ctx_receive_sparse),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -328,6 +328,48 @@ static void stream_set_field_data_len(void **state)
 	assert_true(pdu.format_specific == 0);
 }
 
+static void stream_pdu_emit_null_pdu(void **state)
+{
+	int res;
+	struct avtp_stream_pdu tmpl = { 0 };
+
+	res = avtp_stream_pdu_emit(NULL, &tmpl, 0, 0, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_pdu_emit_null_tmpl(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_stream_pdu_emit(&pdu, NULL, 0, 0, 0);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void stream_pdu_emit(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu, tmpl;
+
+	tmpl.subtype_data = htonl(0x02895501);
+	tmpl.stream_id = htobe64(0xAABBCCDDEEFF0001);
+	tmpl.avtp_time = htonl(0x80C0FFEE);
+	tmpl.format_specific = htonl(0x04500210);
+	tmpl.packet_info = htonl(0x00041A00);
+
+	res = avtp_stream_pdu_emit(&pdu, &tmpl, 0xAA, 0x12345678, 0xABCD);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x0289AA01);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0001);
+	assert_true(ntohl(pdu.avtp_time) == 0x12345678);
+	assert_true(ntohl(pdu.format_specific) == 0x04500210);
+	assert_true(ntohl(pdu.packet_info) == 0xABCD1A00);
+	assert_true(ntohl(tmpl.subtype_data) == 0x02895501);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -352,6 +394,9 @@ int main(void)
 		cmocka_unit_test(stream_set_field_stream_id),
 		cmocka_unit_test(stream_set_field_timestamp),
 		cmocka_unit_test(stream_set_field_data_len),
+		cmocka_unit_test(stream_pdu_emit_null_pdu),
+		cmocka_unit_test(stream_pdu_emit_null_tmpl),
+		cmocka_unit_test(stream_pdu_emit),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
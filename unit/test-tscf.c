@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *    * Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *    * Neither the name of Intel Corporation nor the names of its contributors
+ *      may be used to endorse or promote products derived from this software
+ *      without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <arpa/inet.h>
+#include <endian.h>
+
+#include "avtp.h"
+#include "avtp_tscf.h"
+
+static void tscf_get_field_null_pdu(void **state)
+{
+	int res;
+	uint64_t val;
+
+	res = avtp_tscf_pdu_get(NULL, AVTP_TSCF_FIELD_SV, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_get_field_null_val(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_tscf_pdu_get(&pdu, AVTP_TSCF_FIELD_SV, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_get_field_invalid_field(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_tscf_pdu_get(&pdu, AVTP_TSCF_FIELD_MAX, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_get_field_seq_num(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	/* Set 'sequence_num' field to 0x55. */
+	pdu.subtype_data = htonl(0x00005500);
+
+	res = avtp_tscf_pdu_get(&pdu, AVTP_TSCF_FIELD_SEQ_NUM, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 0x55);
+}
+
+static void tscf_get_field_stream_data_len(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	/* Set 'stream_data_length' field to 0x0123. */
+	pdu.packet_info = htonl(0x01230000);
+
+	res = avtp_tscf_pdu_get(&pdu, AVTP_TSCF_FIELD_STREAM_DATA_LEN, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 0x0123);
+}
+
+static void tscf_set_field_null_pdu(void **state)
+{
+	int res;
+
+	res = avtp_tscf_pdu_set(NULL, AVTP_TSCF_FIELD_SV, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_set_field_invalid_field(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_tscf_pdu_set(&pdu, AVTP_TSCF_FIELD_MAX, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_set_field_timestamp(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_tscf_pdu_set(&pdu, AVTP_TSCF_FIELD_TIMESTAMP, 0x80C0FFEE);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.avtp_time) == 0x80C0FFEE);
+}
+
+static void tscf_set_field_stream_id(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_tscf_pdu_set(&pdu, AVTP_TSCF_FIELD_STREAM_ID,
+							0xAABBCCDDEEFF0001);
+
+	assert_int_equal(res, 0);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0001);
+}
+
+static void tscf_pdu_init_null_pdu(void **state)
+{
+	int res;
+
+	res = avtp_tscf_pdu_init(NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_pdu_init(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+
+	res = avtp_tscf_pdu_init(&pdu);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x05800000);
+	assert_true(pdu.stream_id == 0);
+	assert_true(pdu.avtp_time == 0);
+	assert_true(pdu.format_specific == 0);
+	assert_true(pdu.packet_info == 0);
+}
+
+static void tscf_pdu_unpack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu = { 0 };
+
+	res = avtp_tscf_pdu_unpack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_pdu_pack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_tscf_hdr hdr = { 0 };
+
+	res = avtp_tscf_pdu_pack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void tscf_pdu_pack_unpack(void **state)
+{
+	int res;
+	struct avtp_stream_pdu pdu;
+	struct avtp_tscf_hdr out = { 0 };
+	struct avtp_tscf_hdr hdr = {
+		.stream = {
+			.sv = 1,
+			.mr = 1,
+			.tv = 1,
+			.seq_num = 0x42,
+			.tu = 1,
+			.stream_id = 0xAABBCCDDEEFF0001,
+			.timestamp = 0x80C0FFEE,
+			.stream_data_len = 0x0123,
+		},
+	};
+
+	memset(&pdu, 0xFF, sizeof(pdu));
+
+	res = avtp_tscf_pdu_pack(&pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x05894201);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0001);
+	assert_true(ntohl(pdu.avtp_time) == 0x80C0FFEE);
+	assert_true(pdu.format_specific == 0);
+	assert_true(ntohl(pdu.packet_info) == 0x01230000);
+
+	res = avtp_tscf_pdu_unpack(&pdu, &out);
+
+	assert_int_equal(res, 0);
+	assert_int_equal(out.stream.sv, 1);
+	assert_int_equal(out.stream.mr, 1);
+	assert_int_equal(out.stream.tv, 1);
+	assert_int_equal(out.stream.seq_num, 0x42);
+	assert_int_equal(out.stream.tu, 1);
+	assert_true(out.stream.stream_id == 0xAABBCCDDEEFF0001);
+	assert_true(out.stream.timestamp == 0x80C0FFEE);
+	assert_int_equal(out.stream.stream_data_len, 0x0123);
+}
+
+static void ntscf_get_field_null_pdu(void **state)
+{
+	int res;
+	uint64_t val;
+
+	res = avtp_ntscf_pdu_get(NULL, AVTP_NTSCF_FIELD_SV, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_get_field_null_val(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	res = avtp_ntscf_pdu_get(&pdu, AVTP_NTSCF_FIELD_SV, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_get_field_invalid_field(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	res = avtp_ntscf_pdu_get(&pdu, AVTP_NTSCF_FIELD_MAX, &val);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_get_field_sv(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	/* Set 'sv' field to 1. */
+	pdu.subtype_data = htonl(0x00800000);
+
+	res = avtp_ntscf_pdu_get(&pdu, AVTP_NTSCF_FIELD_SV, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 1);
+}
+
+static void ntscf_get_field_data_len(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	/* Set 'ntscf_data_length' field to 0x7FF. */
+	pdu.subtype_data = htonl(0x0007FF00);
+
+	res = avtp_ntscf_pdu_get(&pdu, AVTP_NTSCF_FIELD_DATA_LEN, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == AVTP_NTSCF_MAX_DATA_LEN);
+}
+
+static void ntscf_get_field_seq_num(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	/* Set 'sequence_num' field to 0xAA. */
+	pdu.subtype_data = htonl(0x000000AA);
+
+	res = avtp_ntscf_pdu_get(&pdu, AVTP_NTSCF_FIELD_SEQ_NUM, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 0xAA);
+}
+
+static void ntscf_get_field_stream_id(void **state)
+{
+	int res;
+	uint64_t val;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	pdu.stream_id = htobe64(0xAABBCCDDEEFF0001);
+
+	res = avtp_ntscf_pdu_get(&pdu, AVTP_NTSCF_FIELD_STREAM_ID, &val);
+
+	assert_int_equal(res, 0);
+	assert_true(val == 0xAABBCCDDEEFF0001);
+}
+
+static void ntscf_set_field_null_pdu(void **state)
+{
+	int res;
+
+	res = avtp_ntscf_pdu_set(NULL, AVTP_NTSCF_FIELD_SV, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_set_field_invalid_field(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	res = avtp_ntscf_pdu_set(&pdu, AVTP_NTSCF_FIELD_MAX, 1);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_set_field_data_len(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	/* Bits outside 'ntscf_data_length' must be preserved. */
+	pdu.subtype_data = htonl(0x828000AA);
+
+	res = avtp_ntscf_pdu_set(&pdu, AVTP_NTSCF_FIELD_DATA_LEN, 0x123);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x828123AA);
+}
+
+static void ntscf_set_field_seq_num(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu = { 0 };
+
+	res = avtp_ntscf_pdu_set(&pdu, AVTP_NTSCF_FIELD_SEQ_NUM, 0x55);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x00000055);
+}
+
+static void ntscf_pdu_init_null_pdu(void **state)
+{
+	int res;
+
+	res = avtp_ntscf_pdu_init(NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_pdu_init(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu;
+
+	res = avtp_ntscf_pdu_init(&pdu);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x82800000);
+	assert_true(pdu.stream_id == 0);
+}
+
+static void ntscf_pdu_unpack_null_pdu(void **state)
+{
+	int res;
+	struct avtp_ntscf_hdr hdr;
+
+	res = avtp_ntscf_pdu_unpack(NULL, &hdr);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_pdu_pack_null_hdr(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu;
+
+	res = avtp_ntscf_pdu_pack(&pdu, NULL);
+
+	assert_int_equal(res, -EINVAL);
+}
+
+static void ntscf_pdu_pack_unpack(void **state)
+{
+	int res;
+	struct avtp_ntscf_pdu pdu;
+	struct avtp_ntscf_hdr out = { 0 };
+	struct avtp_ntscf_hdr hdr = {
+		.sv = 1,
+		.data_len = 0x123,
+		.seq_num = 0xAA,
+		.stream_id = 0xAABBCCDDEEFF0001,
+	};
+
+	memset(&pdu, 0xFF, sizeof(pdu));
+
+	res = avtp_ntscf_pdu_pack(&pdu, &hdr);
+
+	assert_int_equal(res, 0);
+	assert_true(ntohl(pdu.subtype_data) == 0x828123AA);
+	assert_true(be64toh(pdu.stream_id) == 0xAABBCCDDEEFF0001);
+
+	res = avtp_ntscf_pdu_unpack(&pdu, &out);
+
+	assert_int_equal(res, 0);
+	assert_int_equal(out.sv, 1);
+	assert_int_equal(out.data_len, 0x123);
+	assert_int_equal(out.seq_num, 0xAA);
+	assert_true(out.stream_id == 0xAABBCCDDEEFF0001);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(tscf_get_field_null_pdu),
+		cmocka_unit_test(tscf_get_field_null_val),
+		cmocka_unit_test(tscf_get_field_invalid_field),
+		cmocka_unit_test(tscf_get_field_seq_num),
+		cmocka_unit_test(tscf_get_field_stream_data_len),
+		cmocka_unit_test(tscf_set_field_null_pdu),
+		cmocka_unit_test(tscf_set_field_invalid_field),
+		cmocka_unit_test(tscf_set_field_timestamp),
+		cmocka_unit_test(tscf_set_field_stream_id),
+		cmocka_unit_test(tscf_pdu_init_null_pdu),
+		cmocka_unit_test(tscf_pdu_init),
+		cmocka_unit_test(tscf_pdu_unpack_null_hdr),
+		cmocka_unit_test(tscf_pdu_pack_null_pdu),
+		cmocka_unit_test(tscf_pdu_pack_unpack),
+		cmocka_unit_test(ntscf_get_field_null_pdu),
+		cmocka_unit_test(ntscf_get_field_null_val),
+		cmocka_unit_test(ntscf_get_field_invalid_field),
+		cmocka_unit_test(ntscf_get_field_sv),
+		cmocka_unit_test(ntscf_get_field_data_len),
+		cmocka_unit_test(ntscf_get_field_seq_num),
+		cmocka_unit_test(ntscf_get_field_stream_id),
+		cmocka_unit_test(ntscf_set_field_null_pdu),
+		cmocka_unit_test(ntscf_set_field_invalid_field),
+		cmocka_unit_test(ntscf_set_field_data_len),
+		cmocka_unit_test(ntscf_set_field_seq_num),
+		cmocka_unit_test(ntscf_pdu_init_null_pdu),
+		cmocka_unit_test(ntscf_pdu_init),
+		cmocka_unit_test(ntscf_pdu_unpack_null_pdu),
+		cmocka_unit_test(ntscf_pdu_pack_null_hdr),
+		cmocka_unit_test(ntscf_pdu_pack_unpack),
+	};
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}